@@ -10,6 +10,7 @@
 #include "mercury_util.h"
 #include "na_test_getopt.h"
 
+#include <string.h>
 #ifdef _WIN32
 #    include <Windows.h>
 #else
@@ -20,6 +21,11 @@
 /* Local Macros */
 /****************/
 
+#ifdef _WIN32
+#    undef strdup
+#    define strdup _strdup
+#endif
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -64,10 +70,14 @@ hg_test_usage(const char *execname)
     printf("    HG OPTIONS\n");
     printf("    -x, --handle        Max number of handles\n");
     printf("    -m, --memory        Use shared-memory with local targets\n");
-    printf("    -t, --threads       Number of server threads\n");
+    printf("    -t, --threads       Number of server (or client) threads\n");
     printf("    -B, --bidirectional Bidirectional communication\n");
     printf("    -u, --mrecv-ops     Number of multi-recv ops (server only)\n");
     printf("    -i, --post-init     Number of handles posted (server only)\n");
+    printf("    -r, --rate          Max offered rate in RPC/s (load only)\n");
+    printf("    -D, --dist          Payload size distribution (load only)\n"
+           "                        Distributions: fixed, uniform, log2\n");
+    printf("    -E, --shared-context Client threads share one context\n");
 }
 
 /*---------------------------------------------------------------------------*/
@@ -110,6 +120,15 @@ hg_test_parse_options(int argc, char *argv[], struct hg_test_info *hg_test_info)
                 hg_test_info->request_post_init =
                     (unsigned int) atoi(na_test_opt_arg_g);
                 break;
+            case 'r': /* rate */
+                hg_test_info->rate = (unsigned int) atoi(na_test_opt_arg_g);
+                break;
+            case 'D': /* size distribution */
+                hg_test_info->size_dist = strdup(na_test_opt_arg_g);
+                break;
+            case 'E': /* shared context */
+                hg_test_info->shared_context = HG_TRUE;
+                break;
             default:
                 break;
         }
@@ -210,6 +229,8 @@ HG_Test_init(int argc, char *argv[], struct hg_test_info *hg_test_info)
         /* Set progress mode */
         if (hg_test_info->na_test_info.busy_wait)
             hg_init_info.na_init_info.progress_mode = NA_NO_BLOCK;
+        if (hg_test_info->na_test_info.io_uring)
+            hg_init_info.na_init_info.progress_mode |= NA_POLL_IO_URING;
 
         /* Set max contexts */
         if (hg_test_info->na_test_info.max_contexts)
@@ -286,6 +307,9 @@ HG_Test_finalize(struct hg_test_info *hg_test_info)
         hg_test_info->hg_class = NULL;
     }
 
+    free(hg_test_info->size_dist);
+    hg_test_info->size_dist = NULL;
+
     /* Finalize NA test interface */
     na_ret = NA_Test_finalize(&hg_test_info->na_test_info);
     HG_TEST_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
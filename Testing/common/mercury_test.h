@@ -24,8 +24,11 @@ struct hg_test_info {
     unsigned int thread_count;        /* Max number of threads */
     unsigned int multi_recv_op_max;   /* Max number of multi-recv ops */
     unsigned int request_post_init;   /* Init number of posted handles */
+    unsigned int rate;                /* Offered RPC rate (RPC/s) */
+    char *size_dist;                  /* Payload size distribution */
     hg_bool_t auto_sm;                /* Use shared-memory */
     hg_bool_t bidirectional;          /* Bidirectional tests */
+    hg_bool_t shared_context;         /* Threads share one context */
 };
 
 /*****************/
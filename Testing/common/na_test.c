@@ -113,6 +113,7 @@ na_test_usage(const char *execname)
     printf("    -T, --tclass         Traffic class to use\n");
     printf("    -l, --loop           Number of loops (default: 1)\n");
     printf("    -b, --busy           Busy wait\n");
+    printf("    -I, --io_uring       Wait with io_uring if supported\n");
     printf("    -y  --buf_size_min   Min buffer size (in bytes)\n");
     printf("    -z, --buf_size_max   Max buffer size (in bytes)\n");
     printf("    -w  --buf_count      Number of buffers used\n");
@@ -180,6 +181,9 @@ na_test_parse_options(int argc, char *argv[], struct na_test_info *na_test_info)
             case 'b': /* busy */
                 na_test_info->busy_wait = true;
                 break;
+            case 'I': /* io_uring */
+                na_test_info->io_uring = true;
+                break;
             case 'C': /* number of classes */
                 na_test_info->max_classes = (size_t) atol(na_test_opt_arg_g);
                 break;
@@ -627,6 +631,8 @@ NA_Test_init(int argc, char *argv[], struct na_test_info *na_test_info)
         if (na_test_info->mpi_info.rank == 0)
             printf("# Initializing NA in busy wait mode\n");
     }
+    if (na_test_info->io_uring)
+        na_init_info.progress_mode |= NA_POLL_IO_URING;
 #ifdef HG_TEST_HAS_CXI
     if (na_test_info->key != NULL)
         na_init_info.auth_key = auth_key;
@@ -43,6 +43,7 @@ struct na_test_info {
     char *tclass;            /* Traffic class */
     int loop;                /* Number of loops */
     bool busy_wait;          /* Busy wait */
+    bool io_uring;           /* Wait with io_uring */
     size_t max_classes;      /* Max classes */
     uint8_t max_contexts;    /* Max contexts */
     uint32_t max_targets;    /* Max targets */
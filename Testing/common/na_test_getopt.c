@@ -15,7 +15,7 @@
 int na_test_opt_ind_g = 1;            /* token pointer */
 const char *na_test_opt_arg_g = NULL; /* flag argument (or value) */
 const char *na_test_short_opt_g =
-    "hc:d:p:H:P:sSk:l:bC:X:VZ:y:z:w:x:mt:BRvMUf:T:u:i:";
+    "hc:d:p:H:P:sSk:l:bIC:X:VZ:y:z:w:x:mt:BRvMUf:T:u:i:r:D:E";
 /* clang-format off */
 const struct na_test_opt na_test_opt_g[] = {
     {"help", no_arg, 'h'},
@@ -29,6 +29,7 @@ const struct na_test_opt na_test_opt_g[] = {
     {"key", require_arg, 'k'},
     {"loop", require_arg, 'l'},
     {"busy", no_arg, 'b'},
+    {"io_uring", no_arg, 'I'},
     {"classes", require_arg, 'C'},
     {"contexts", require_arg, 'X'},
     {"verbose", no_arg, 'V'},
@@ -48,6 +49,9 @@ const struct na_test_opt na_test_opt_g[] = {
     {"tclass", require_arg, 'T'},
     {"mrecv-ops", require_arg, 'u'},
     {"post-init", require_arg, 'i'},
+    {"rate", require_arg, 'r'},
+    {"dist", require_arg, 'D'},
+    {"shared-context", no_arg, 'E'},
     {NULL, 0, '\0'} /* Must add this at the end */
 };
 /* clang-format on */
@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_perf.h"
+
+#ifndef _WIN32
+#    include <sys/uio.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+#define BENCHMARK_NAME "RPC latency distribution"
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+#ifdef _WIN32
+struct iovec {
+    void *iov_base; /* Pointer to data.  */
+    size_t iov_len; /* Length of data.  */
+};
+#endif
+
+/* Per-handle timing slot */
+struct hg_perf_lat_slot {
+    struct hg_perf_request *request; /* Request shared by all slots */
+    double *lat_p;                   /* Where to store latency sample */
+    hg_time_t t_start;               /* Time of HG_Forward() */
+    hg_return_t ret;                 /* Return status of RPC */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_perf_lat_complete(const struct hg_cb_info *hg_cb_info);
+
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, struct hg_perf_lat_slot *slots,
+    double *lat, size_t buf_size, size_t skip);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_lat_complete(const struct hg_cb_info *hg_cb_info)
+{
+    struct hg_perf_lat_slot *slot = (struct hg_perf_lat_slot *) hg_cb_info->arg;
+    hg_time_t t_end;
+
+    /* Failed RPCs do not produce a latency sample */
+    slot->ret = hg_cb_info->ret;
+    HG_TEST_CHECK_HG_ERROR(done, hg_cb_info->ret, "RPC failed (%s)",
+        HG_Error_to_string(hg_cb_info->ret));
+
+    hg_time_get_current(&t_end);
+    if (slot->lat_p != NULL)
+        *slot->lat_p =
+            hg_time_to_double(hg_time_subtract(t_end, slot->t_start)) * 1e6;
+
+done:
+    if ((++slot->request->complete_count) == slot->request->expected_count)
+        hg_atomic_set32(&slot->request->completed, (int32_t) true);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, struct hg_perf_lat_slot *slots,
+    double *lat, size_t buf_size, size_t skip)
+{
+    struct iovec in_struct = {.iov_base = info->rpc_buf, .iov_len = buf_size};
+    size_t loop = (size_t) hg_test_info->na_test_info.loop;
+    struct hg_perf_lat_stats stats;
+    hg_return_t ret;
+    size_t i;
+
+    for (i = 0; i < skip + loop; i++) {
+        struct hg_perf_request request = {
+            .expected_count = (int32_t) info->handle_max,
+            .complete_count = 0,
+            .completed = HG_ATOMIC_VAR_INIT(0)};
+        unsigned int j;
+
+        if (i == skip && hg_test_info->na_test_info.mpi_info.size > 1)
+            NA_Test_barrier(&hg_test_info->na_test_info);
+
+        for (j = 0; j < info->handle_max; j++) {
+            slots[j].request = &request;
+            /* Samples are only recorded once warm up is done */
+            slots[j].lat_p =
+                (i < skip) ? NULL : &lat[(i - skip) * info->handle_max + j];
+            hg_time_get_current(&slots[j].t_start);
+
+            ret = HG_Forward(
+                info->handles[j], hg_perf_lat_complete, &slots[j], &in_struct);
+            HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Forward() failed (%s)",
+                HG_Error_to_string(ret));
+        }
+
+        ret = hg_perf_request_wait(info, &request, HG_MAX_IDLE_TIME, NULL);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_request_wait() failed (%s)",
+            HG_Error_to_string(ret));
+
+        for (j = 0; j < info->handle_max; j++) {
+            ret = slots[j].ret;
+            HG_TEST_CHECK_HG_ERROR(error, ret, "RPC %u failed (%s)", j,
+                HG_Error_to_string(ret));
+        }
+
+        if (info->verify && info->bidir) {
+            for (j = 0; j < info->handle_max; j++) {
+                struct iovec out_iov = {
+                    .iov_base = info->rpc_verify_buf, .iov_len = buf_size};
+                memset(out_iov.iov_base, 0, out_iov.iov_len);
+
+                ret = HG_Get_output(info->handles[j], &out_iov);
+                HG_TEST_CHECK_HG_ERROR(error, ret,
+                    "HG_Get_output() failed (%s)", HG_Error_to_string(ret));
+
+                ret = hg_perf_verify_data(out_iov.iov_base, out_iov.iov_len);
+                (void) HG_Free_output(info->handles[j], &out_iov);
+                HG_TEST_CHECK_HG_ERROR(error, ret,
+                    "hg_perf_verify_data() failed (%s)",
+                    HG_Error_to_string(ret));
+            }
+        }
+    }
+
+    if (hg_test_info->na_test_info.mpi_info.size > 1)
+        NA_Test_barrier(&hg_test_info->na_test_info);
+
+    if (hg_test_info->na_test_info.mpi_info.rank == 0) {
+        hg_perf_lat_stats_compute(lat, loop * info->handle_max, &stats);
+        hg_perf_print_lat_dist(buf_size, &stats);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_perf_info perf_info;
+    struct hg_test_info *hg_test_info;
+    struct hg_perf_class_info *info;
+    struct hg_perf_lat_slot *slots = NULL;
+    double *lat = NULL;
+    size_t size;
+    hg_return_t hg_ret;
+
+    /* Initialize the interface */
+    hg_ret = hg_perf_init(argc, argv, false, &perf_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    hg_test_info = &perf_info.hg_test_info;
+    info = &perf_info.class_info[0];
+
+    /* Allocate RPC buffers */
+    hg_ret = hg_perf_rpc_buf_init(hg_test_info, info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init_rpc_buf() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Allocate timing slots and latency samples */
+    slots =
+        (struct hg_perf_lat_slot *) calloc(info->handle_max, sizeof(*slots));
+    HG_TEST_CHECK_ERROR_NORET(
+        slots == NULL, error, "Could not allocate timing slots");
+
+    lat = (double *) malloc((size_t) hg_test_info->na_test_info.loop *
+                            info->handle_max * sizeof(*lat));
+    HG_TEST_CHECK_ERROR_NORET(
+        lat == NULL, error, "Could not allocate latency samples");
+
+    /* Set HG handles */
+    hg_ret = hg_perf_set_handles(hg_test_info, info, HG_PERF_RATE);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_set_handles() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Header info */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_print_header_lat_dist(hg_test_info, info, BENCHMARK_NAME);
+
+    /* NULL RPC */
+    if (info->buf_size_min == 0) {
+        hg_ret = hg_perf_run(
+            hg_test_info, info, slots, lat, 0, HG_PERF_LAT_SKIP_SMALL);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
+            HG_Error_to_string(hg_ret));
+    }
+
+    /* RPC with different sizes */
+    for (size = MAX(1, info->buf_size_min); size <= info->buf_size_max;
+         size *= 2) {
+        hg_ret = hg_perf_run(hg_test_info, info, slots, lat, size,
+            (size > HG_PERF_LARGE_SIZE) ? HG_PERF_LAT_SKIP_LARGE
+                                        : HG_PERF_LAT_SKIP_SMALL);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_run() failed (%s)",
+            HG_Error_to_string(hg_ret));
+    }
+
+    /* Finalize interface */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_send_done(info);
+
+    hg_perf_cleanup(&perf_info);
+    free(slots);
+    free(lat);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_perf_cleanup(&perf_info);
+    free(slots);
+    free(lat);
+
+    return EXIT_FAILURE;
+}
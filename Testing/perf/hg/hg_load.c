@@ -0,0 +1,504 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_perf.h"
+
+#include <math.h>
+#ifndef _WIN32
+#    include <sys/uio.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+#define BENCHMARK_NAME "RPC open-loop load"
+
+/* Number of offered load steps in the sweep */
+#define HG_PERF_LOAD_STEPS (10)
+
+/* Max offered rate relative to calibrated closed-loop rate */
+#define HG_PERF_LOAD_CALIBRATE_FACTOR (1.5)
+
+/* Saturation knee thresholds */
+#define HG_PERF_LOAD_KNEE_RATIO (0.95) /* achieved / offered */
+#define HG_PERF_LOAD_KNEE_P99   (10.0) /* p99 / lowest load p99 */
+
+/* Below this number of samples, p99.9 is not meaningful */
+#define HG_PERF_LOAD_COUNT_MIN (1000)
+
+/* Max time blocked in progress when waiting for completions */
+#define HG_PERF_LOAD_WAIT_MAX (100)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+#ifdef _WIN32
+struct iovec {
+    void *iov_base; /* Pointer to data.  */
+    size_t iov_len; /* Length of data.  */
+};
+#endif
+
+/* Payload size distributions */
+enum hg_perf_load_dist {
+    HG_PERF_LOAD_FIXED,   /* Always max size */
+    HG_PERF_LOAD_UNIFORM, /* Uniform between min and max size */
+    HG_PERF_LOAD_LOG2     /* Uniform over powers of 2 between min and max */
+};
+
+struct hg_perf_load_info;
+
+/* Per-handle slot */
+struct hg_perf_load_slot {
+    struct hg_perf_load_info *load_info; /* Load info */
+    hg_handle_t handle;                  /* Handle */
+    double t_sched;                      /* Scheduled send time (s) */
+};
+
+/* Load generator state */
+struct hg_perf_load_info {
+    struct hg_perf_class_info *info;      /* Class info */
+    struct hg_perf_load_slot *slots;      /* Array of slots */
+    struct hg_perf_load_slot **free_list; /* Stack of free slots */
+    double *lat;                          /* Latency samples (us) */
+    hg_time_t t0;                         /* Start of current step */
+    double t_last;                        /* Last completion time (s) */
+    size_t free_count;                    /* Number of free slots */
+    size_t completed;                     /* Completed RPCs */
+    hg_return_t ret;                      /* First RPC error */
+    uint64_t rand_state;                  /* PRNG state */
+    enum hg_perf_load_dist dist;          /* Payload size distribution */
+    unsigned int log2_min;                /* Min size exponent */
+    unsigned int log2_max;                /* Max size exponent */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_perf_load_dist_parse(const char *str, enum hg_perf_load_dist *dist_p);
+
+static double
+hg_perf_load_rand(struct hg_perf_load_info *load_info);
+
+static size_t
+hg_perf_load_size(struct hg_perf_load_info *load_info);
+
+static double
+hg_perf_load_elapsed(const struct hg_perf_load_info *load_info);
+
+static hg_return_t
+hg_perf_load_complete(const struct hg_cb_info *hg_cb_info);
+
+static hg_return_t
+hg_perf_load_progress(struct hg_perf_class_info *info, unsigned int timeout_ms);
+
+static hg_return_t
+hg_perf_load_calibrate(const struct hg_test_info *hg_test_info,
+    struct hg_perf_load_info *load_info, double *rate_p);
+
+static hg_return_t
+hg_perf_load_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_load_info *load_info, double rate, size_t count,
+    double *achieved_p, size_t *stalls_p);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_load_dist_parse(const char *str, enum hg_perf_load_dist *dist_p)
+{
+    if (str == NULL || strcmp(str, "fixed") == 0)
+        *dist_p = HG_PERF_LOAD_FIXED;
+    else if (strcmp(str, "uniform") == 0)
+        *dist_p = HG_PERF_LOAD_UNIFORM;
+    else if (strcmp(str, "log2") == 0)
+        *dist_p = HG_PERF_LOAD_LOG2;
+    else
+        return HG_INVALID_ARG;
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static double
+hg_perf_load_rand(struct hg_perf_load_info *load_info)
+{
+    /* xorshift64*, returns a double in (0, 1] */
+    uint64_t x = load_info->rand_state;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    load_info->rand_state = x;
+
+    return ((double) ((x * UINT64_C(2685821657736338717)) >> 11) + 1.) /
+           9007199254740992.;
+}
+
+/*---------------------------------------------------------------------------*/
+static size_t
+hg_perf_load_size(struct hg_perf_load_info *load_info)
+{
+    const struct hg_perf_class_info *info = load_info->info;
+    size_t range;
+
+    switch (load_info->dist) {
+        case HG_PERF_LOAD_UNIFORM:
+            range = info->buf_size_max - info->buf_size_min + 1;
+            return info->buf_size_min +
+                   MIN((size_t) (hg_perf_load_rand(load_info) * (double) range),
+                       range - 1);
+        case HG_PERF_LOAD_LOG2:
+            range = load_info->log2_max - load_info->log2_min + 1;
+            return (size_t) 1
+                   << (load_info->log2_min +
+                          MIN((size_t) (hg_perf_load_rand(load_info) *
+                                        (double) range),
+                              range - 1));
+        case HG_PERF_LOAD_FIXED:
+        default:
+            return info->buf_size_max;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static double
+hg_perf_load_elapsed(const struct hg_perf_load_info *load_info)
+{
+    hg_time_t now;
+
+    hg_time_get_current(&now);
+
+    return hg_time_to_double(hg_time_subtract(now, load_info->t0));
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_load_complete(const struct hg_cb_info *hg_cb_info)
+{
+    struct hg_perf_load_slot *slot =
+        (struct hg_perf_load_slot *) hg_cb_info->arg;
+    struct hg_perf_load_info *load_info = slot->load_info;
+    double t_end = hg_perf_load_elapsed(load_info);
+
+    /* Failed RPCs do not produce a latency sample, the run is aborted */
+    if (hg_cb_info->ret != HG_SUCCESS) {
+        HG_TEST_LOG_ERROR(
+            "RPC failed (%s)", HG_Error_to_string(hg_cb_info->ret));
+        if (load_info->ret == HG_SUCCESS)
+            load_info->ret = hg_cb_info->ret;
+    } else
+        /* Latency includes time spent waiting for a free handle */
+        load_info->lat[load_info->completed] = (t_end - slot->t_sched) * 1e6;
+    load_info->completed++;
+    load_info->t_last = t_end;
+    load_info->free_list[load_info->free_count++] = slot;
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_load_progress(struct hg_perf_class_info *info, unsigned int timeout_ms)
+{
+    unsigned int count = 0, actual_count = 0;
+    hg_return_t ret;
+
+    if (info->poll_set && timeout_ms > 0 && !HG_Event_ready(info->context)) {
+        struct hg_poll_event poll_event = {.events = 0, .data.ptr = NULL};
+        unsigned int actual_events = 0;
+        int rc;
+
+        rc = hg_poll_wait(
+            info->poll_set, timeout_ms, 1, &poll_event, &actual_events);
+        HG_TEST_CHECK_ERROR(
+            rc != 0, error, ret, HG_PROTOCOL_ERROR, "hg_poll_wait() failed");
+    }
+
+    ret = HG_Event_progress(info->context, &count);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+
+    if (count == 0)
+        return HG_SUCCESS;
+
+    ret = HG_Event_trigger(info->context, count, &actual_count);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_load_calibrate(const struct hg_test_info *hg_test_info,
+    struct hg_perf_load_info *load_info, double *rate_p)
+{
+    struct hg_perf_class_info *info = load_info->info;
+    size_t count = (size_t) hg_test_info->na_test_info.loop, sent = 0;
+    hg_return_t ret;
+
+    /* Closed loop, keep all handles in-flight */
+    load_info->completed = 0;
+    hg_time_get_current(&load_info->t0);
+
+    while (load_info->completed < count) {
+        while (sent < count && load_info->free_count > 0) {
+            struct hg_perf_load_slot *slot =
+                load_info->free_list[--load_info->free_count];
+            struct iovec in_struct = {.iov_base = info->rpc_buf,
+                .iov_len = hg_perf_load_size(load_info)};
+
+            slot->t_sched = hg_perf_load_elapsed(load_info);
+            ret = HG_Forward(
+                slot->handle, hg_perf_load_complete, slot, &in_struct);
+            HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Forward() failed (%s)",
+                HG_Error_to_string(ret));
+            sent++;
+        }
+
+        ret = hg_perf_load_progress(info, HG_PERF_LOAD_WAIT_MAX);
+        HG_TEST_CHECK_HG_ERROR(error, ret,
+            "hg_perf_load_progress() failed (%s)", HG_Error_to_string(ret));
+
+        ret = load_info->ret;
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "RPC failed (%s)", HG_Error_to_string(ret));
+    }
+
+    *rate_p = (double) count / load_info->t_last;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_load_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_load_info *load_info, double rate, size_t count,
+    double *achieved_p, size_t *stalls_p)
+{
+    struct hg_perf_class_info *info = load_info->info;
+    double t_next = 0.;
+    size_t sent = 0, stalls = 0;
+    bool stalled = false;
+    hg_return_t ret;
+
+    load_info->completed = 0;
+    load_info->t_last = 0.;
+
+    if (hg_test_info->na_test_info.mpi_info.size > 1)
+        NA_Test_barrier(&hg_test_info->na_test_info);
+
+    hg_time_get_current(&load_info->t0);
+
+    while (load_info->completed < count) {
+        double now = hg_perf_load_elapsed(load_info);
+        unsigned int timeout_ms = HG_PERF_LOAD_WAIT_MAX;
+
+        /* Post every send that is due, independently of completions */
+        while (sent < count && now >= t_next) {
+            struct hg_perf_load_slot *slot;
+            struct iovec in_struct;
+
+            if (load_info->free_count == 0) {
+                /* Count each time the schedule is held back by handles */
+                if (!stalled)
+                    stalls++;
+                stalled = true;
+                break;
+            }
+            stalled = false;
+
+            slot = load_info->free_list[--load_info->free_count];
+            slot->t_sched = t_next;
+            in_struct = (struct iovec){.iov_base = info->rpc_buf,
+                .iov_len = hg_perf_load_size(load_info)};
+
+            ret = HG_Forward(
+                slot->handle, hg_perf_load_complete, slot, &in_struct);
+            HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Forward() failed (%s)",
+                HG_Error_to_string(ret));
+            sent++;
+
+            /* Poisson arrivals */
+            t_next += -log(hg_perf_load_rand(load_info)) / rate;
+        }
+
+        /* Only block until the next send is due */
+        if (sent < count && load_info->free_count > 0)
+            timeout_ms = (t_next > now)
+                             ? (unsigned int) ((t_next - now) * 1e3)
+                             : 0;
+
+        ret = hg_perf_load_progress(info, timeout_ms);
+        HG_TEST_CHECK_HG_ERROR(error, ret,
+            "hg_perf_load_progress() failed (%s)", HG_Error_to_string(ret));
+
+        ret = load_info->ret;
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "RPC failed (%s)", HG_Error_to_string(ret));
+    }
+
+    if (hg_test_info->na_test_info.mpi_info.size > 1)
+        NA_Test_barrier(&hg_test_info->na_test_info);
+
+    *achieved_p = (double) count / load_info->t_last;
+    *stalls_p = stalls;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_perf_info perf_info;
+    struct hg_test_info *hg_test_info;
+    struct hg_perf_class_info *info;
+    struct hg_perf_load_info load_info;
+    double rate_max, p99_min = 0.;
+    bool knee = false;
+    size_t count, i;
+    hg_return_t hg_ret;
+
+    memset(&load_info, 0, sizeof(load_info));
+
+    /* Initialize the interface */
+    hg_ret = hg_perf_init(argc, argv, false, &perf_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    hg_test_info = &perf_info.hg_test_info;
+    info = &perf_info.class_info[0];
+    count = (size_t) hg_test_info->na_test_info.loop;
+
+    hg_ret = hg_perf_load_dist_parse(hg_test_info->size_dist, &load_info.dist);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "Unknown size distribution (%s)",
+        hg_test_info->size_dist);
+
+    /* Allocate RPC buffers */
+    hg_ret = hg_perf_rpc_buf_init(hg_test_info, info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init_rpc_buf() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Set HG handles */
+    hg_ret = hg_perf_set_handles(hg_test_info, info, HG_PERF_RATE);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_set_handles() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Set up load generator */
+    load_info.info = info;
+    load_info.rand_state =
+        UINT64_C(0x9E3779B97F4A7C15) ^
+        (uint64_t) (hg_test_info->na_test_info.mpi_info.rank + 1);
+    while (((size_t) 1 << load_info.log2_min) < MAX(1, info->buf_size_min))
+        load_info.log2_min++;
+    while (((size_t) 1 << (load_info.log2_max + 1)) <= info->buf_size_max)
+        load_info.log2_max++;
+
+    load_info.slots = (struct hg_perf_load_slot *) calloc(
+        info->handle_max, sizeof(*load_info.slots));
+    HG_TEST_CHECK_ERROR_NORET(
+        load_info.slots == NULL, error, "Could not allocate slots");
+
+    load_info.free_list = (struct hg_perf_load_slot **) malloc(
+        info->handle_max * sizeof(*load_info.free_list));
+    HG_TEST_CHECK_ERROR_NORET(
+        load_info.free_list == NULL, error, "Could not allocate free list");
+
+    for (i = 0; i < info->handle_max; i++) {
+        load_info.slots[i].load_info = &load_info;
+        load_info.slots[i].handle = info->handles[i];
+        load_info.free_list[load_info.free_count++] = &load_info.slots[i];
+    }
+
+    load_info.lat = (double *) malloc(count * sizeof(*load_info.lat));
+    HG_TEST_CHECK_ERROR_NORET(
+        load_info.lat == NULL, error, "Could not allocate latency samples");
+
+    /* Warm up and find max offered rate if not specified */
+    hg_ret = hg_perf_load_calibrate(hg_test_info, &load_info, &rate_max);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+        "hg_perf_load_calibrate() failed (%s)", HG_Error_to_string(hg_ret));
+    if (hg_test_info->na_test_info.mpi_info.rank == 0 &&
+        hg_test_info->rate == 0)
+        printf("# Calibrated closed-loop rate: %.0f RPC/s\n", rate_max);
+    rate_max = (hg_test_info->rate > 0)
+                   ? (double) hg_test_info->rate
+                   : rate_max * HG_PERF_LOAD_CALIBRATE_FACTOR;
+
+    /* Header info */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0) {
+        hg_perf_print_header_load(hg_test_info, info, BENCHMARK_NAME,
+            (hg_test_info->size_dist) ? hg_test_info->size_dist : "fixed",
+            rate_max);
+        if (count < HG_PERF_LOAD_COUNT_MIN)
+            printf("# WARNING less than %d RPC(s) per step, use --loop to "
+                   "increase\n",
+                HG_PERF_LOAD_COUNT_MIN);
+    }
+
+    /* Sweep offered load */
+    for (i = 1; i <= HG_PERF_LOAD_STEPS; i++) {
+        double rate = rate_max * (double) i / HG_PERF_LOAD_STEPS, achieved;
+        struct hg_perf_lat_stats stats;
+        size_t stalls;
+
+        hg_ret = hg_perf_load_run(
+            hg_test_info, &load_info, rate, count, &achieved, &stalls);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_perf_load_run() failed (%s)", HG_Error_to_string(hg_ret));
+
+        if (hg_test_info->na_test_info.mpi_info.rank != 0)
+            continue;
+
+        hg_perf_lat_stats_compute(load_info.lat, count, &stats);
+        hg_perf_print_load(rate, achieved, stalls, &stats);
+
+        if (i == 1)
+            p99_min = stats.p99;
+        if (!knee && (achieved < rate * HG_PERF_LOAD_KNEE_RATIO ||
+                         stats.p99 > p99_min * HG_PERF_LOAD_KNEE_P99)) {
+            printf("# Saturation knee at %.0f RPC/s offered\n", rate);
+            knee = true;
+        }
+    }
+    if (hg_test_info->na_test_info.mpi_info.rank == 0 && !knee)
+        printf("# Saturation knee not reached, use --rate to increase\n");
+
+    /* Finalize interface */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_send_done(info);
+
+    hg_perf_cleanup(&perf_info);
+    free(load_info.slots);
+    free(load_info.free_list);
+    free(load_info.lat);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_perf_cleanup(&perf_info);
+    free(load_info.slots);
+    free(load_info.free_list);
+    free(load_info.lat);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,554 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_perf.h"
+
+#include "mercury_macros.h"
+#include "mercury_mem.h"
+#include "mercury_proc_bulk.h"
+#include "mercury_proc_string.h"
+
+/****************/
+/* Local Macros */
+/****************/
+#define BENCHMARK_NAME "Proc encode/decode"
+
+/* Min number of encode/decode operations per measurement */
+#define HG_PERF_PROC_ITER_MIN (10000)
+
+/* Number of warm up operations */
+#define HG_PERF_PROC_SKIP (100)
+
+/* Extra space reserved in proc buffer for headers and descriptors */
+#define HG_PERF_PROC_BUF_EXTRA (4096)
+
+#define NDIGITS 2
+#define NWIDTH  12
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+#ifdef HG_HAS_BOOST
+MERCURY_GEN_PROC(hg_perf_proc_scalar_t,
+    ((hg_uint64_t) (id))((hg_uint64_t) (offset))((hg_uint64_t) (size))(
+        (hg_uint32_t) (mode))((hg_uint32_t) (flags))((hg_int32_t) (ret)))
+MERCURY_GEN_PROC(
+    hg_perf_proc_string_t, ((hg_const_string_t) (path))((hg_uint64_t) (id)))
+MERCURY_GEN_PROC(hg_perf_proc_bulk_t,
+    ((hg_bulk_t) (bulk))((hg_uint64_t) (offset))((hg_uint64_t) (size)))
+#else
+typedef struct {
+    hg_uint64_t id;
+    hg_uint64_t offset;
+    hg_uint64_t size;
+    hg_uint32_t mode;
+    hg_uint32_t flags;
+    hg_int32_t ret;
+} hg_perf_proc_scalar_t;
+
+static HG_INLINE hg_return_t
+hg_proc_hg_perf_proc_scalar_t(hg_proc_t proc, void *data)
+{
+    hg_perf_proc_scalar_t *struct_data = (hg_perf_proc_scalar_t *) data;
+    hg_return_t ret;
+
+    ret = hg_proc_hg_uint64_t(proc, &struct_data->id);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint64_t(proc, &struct_data->offset);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint64_t(proc, &struct_data->size);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint32_t(proc, &struct_data->mode);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint32_t(proc, &struct_data->flags);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_int32_t(proc, &struct_data->ret);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
+
+typedef struct {
+    hg_const_string_t path;
+    hg_uint64_t id;
+} hg_perf_proc_string_t;
+
+static HG_INLINE hg_return_t
+hg_proc_hg_perf_proc_string_t(hg_proc_t proc, void *data)
+{
+    hg_perf_proc_string_t *struct_data = (hg_perf_proc_string_t *) data;
+    hg_return_t ret;
+
+    ret = hg_proc_hg_const_string_t(proc, &struct_data->path);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint64_t(proc, &struct_data->id);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
+
+typedef struct {
+    hg_bulk_t bulk;
+    hg_uint64_t offset;
+    hg_uint64_t size;
+} hg_perf_proc_bulk_t;
+
+static HG_INLINE hg_return_t
+hg_proc_hg_perf_proc_bulk_t(hg_proc_t proc, void *data)
+{
+    hg_perf_proc_bulk_t *struct_data = (hg_perf_proc_bulk_t *) data;
+    hg_return_t ret;
+
+    ret = hg_proc_hg_bulk_t(proc, &struct_data->bulk);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint64_t(proc, &struct_data->offset);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint64_t(proc, &struct_data->size);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
+#endif
+
+/* Benchmark info */
+struct hg_perf_proc_info {
+    hg_class_t *hg_class; /* HG class (required for bulk handles) */
+    void *buf;            /* Encoding buffer */
+    void *data_buf;       /* String / bulk data */
+    size_t buf_size;      /* Size of encoding buffer */
+    size_t size_min;      /* Min data size */
+    size_t size_max;      /* Max data size */
+    size_t iter;          /* Number of operations per measurement */
+    uint32_t bulk_count;  /* Number of bulk segments */
+};
+
+/* Measurement */
+struct hg_perf_proc_result {
+    double enc_time; /* Total encode time (s) */
+    double dec_time; /* Total decode + free time (s) */
+    size_t enc_size; /* Encoded size */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_perf_proc_encode(hg_proc_t proc, hg_proc_cb_t proc_cb, uint8_t flags,
+    void *buf, size_t buf_size, void *in);
+
+static hg_return_t
+hg_perf_proc_decode(hg_proc_t proc, hg_proc_cb_t proc_cb, void *buf,
+    size_t buf_size, void *out);
+
+static hg_return_t
+hg_perf_proc_run(const struct hg_perf_proc_info *info, hg_proc_hash_t hash,
+    uint8_t flags, hg_proc_cb_t proc_cb, void *in, void *out,
+    struct hg_perf_proc_result *result);
+
+static void
+hg_perf_proc_print(const struct hg_perf_proc_info *info, const char *type,
+    hg_proc_hash_t hash, size_t size,
+    const struct hg_perf_proc_result *result);
+
+static hg_return_t
+hg_perf_proc_scalar(const struct hg_perf_proc_info *info, hg_proc_hash_t hash);
+
+static hg_return_t
+hg_perf_proc_string(const struct hg_perf_proc_info *info, hg_proc_hash_t hash);
+
+static hg_return_t
+hg_perf_proc_bulk(
+    const struct hg_perf_proc_info *info, hg_proc_hash_t hash, bool eager);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+static const char *const hg_perf_proc_hash_name_g[] = {
+    "crc16", "crc32", "crc64", "none"};
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_proc_encode(hg_proc_t proc, hg_proc_cb_t proc_cb, uint8_t flags,
+    void *buf, size_t buf_size, void *in)
+{
+    hg_return_t ret;
+#ifdef HG_HAS_CHECKSUMS
+    uint64_t checksum = 0;
+#endif
+
+    ret = hg_proc_reset(proc, buf, buf_size, HG_ENCODE);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "hg_proc_reset() failed (%s)", HG_Error_to_string(ret));
+
+    /* Flags are cleared on reset */
+    hg_proc_set_flags(proc, flags);
+
+    ret = proc_cb(proc, in);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "Could not encode (%s)", HG_Error_to_string(ret));
+
+    ret = hg_proc_flush(proc);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "hg_proc_flush() failed (%s)", HG_Error_to_string(ret));
+
+#ifdef HG_HAS_CHECKSUMS
+    ret = hg_proc_checksum_get(proc, &checksum, sizeof(checksum));
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_proc_checksum_get() failed (%s)",
+        HG_Error_to_string(ret));
+#endif
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_proc_decode(
+    hg_proc_t proc, hg_proc_cb_t proc_cb, void *buf, size_t buf_size, void *out)
+{
+    hg_return_t ret;
+
+    ret = hg_proc_reset(proc, buf, buf_size, HG_DECODE);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "hg_proc_reset() failed (%s)", HG_Error_to_string(ret));
+
+    ret = proc_cb(proc, out);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "Could not decode (%s)", HG_Error_to_string(ret));
+
+    ret = hg_proc_flush(proc);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "hg_proc_flush() failed (%s)", HG_Error_to_string(ret));
+
+    /* Release what decoding allocated, as HG_Free_input() would */
+    ret = hg_proc_reset(proc, buf, buf_size, HG_FREE);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "hg_proc_reset() failed (%s)", HG_Error_to_string(ret));
+
+    ret = proc_cb(proc, out);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "Could not free (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_proc_run(const struct hg_perf_proc_info *info, hg_proc_hash_t hash,
+    uint8_t flags, hg_proc_cb_t proc_cb, void *in, void *out,
+    struct hg_perf_proc_result *result)
+{
+    hg_proc_t proc = HG_PROC_NULL;
+    hg_time_t t1, t2;
+    hg_return_t ret;
+    size_t i;
+
+    ret = hg_proc_create(info->hg_class, hash, &proc);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "hg_proc_create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Warm up */
+    for (i = 0; i < HG_PERF_PROC_SKIP; i++) {
+        ret = hg_perf_proc_encode(
+            proc, proc_cb, flags, info->buf, info->buf_size, in);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_proc_encode() failed");
+
+        ret =
+            hg_perf_proc_decode(proc, proc_cb, info->buf, info->buf_size, out);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_proc_decode() failed");
+    }
+
+    /* Encode */
+    hg_time_get_current(&t1);
+    for (i = 0; i < info->iter; i++) {
+        ret = hg_perf_proc_encode(
+            proc, proc_cb, flags, info->buf, info->buf_size, in);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_proc_encode() failed");
+    }
+    hg_time_get_current(&t2);
+    result->enc_time = hg_time_to_double(hg_time_subtract(t2, t1));
+
+    /* Encoded buffer is left as is by the last encode */
+    result->enc_size = (size_t) hg_proc_get_size_used(proc);
+    HG_TEST_CHECK_ERROR(result->enc_size > info->buf_size, error, ret,
+        HG_OVERFLOW, "Encoded size (%zu) exceeds buffer size (%zu)",
+        result->enc_size, info->buf_size);
+
+    /* Decode */
+    hg_time_get_current(&t1);
+    for (i = 0; i < info->iter; i++) {
+        ret =
+            hg_perf_proc_decode(proc, proc_cb, info->buf, info->buf_size, out);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_proc_decode() failed");
+    }
+    hg_time_get_current(&t2);
+    result->dec_time = hg_time_to_double(hg_time_subtract(t2, t1));
+
+    hg_proc_free(proc);
+
+    return HG_SUCCESS;
+
+error:
+    if (proc != HG_PROC_NULL)
+        hg_proc_free(proc);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_perf_proc_print(const struct hg_perf_proc_info *info, const char *type,
+    hg_proc_hash_t hash, size_t size, const struct hg_perf_proc_result *result)
+{
+    double iter = (double) info->iter, enc_size = (double) result->enc_size;
+
+    printf("%-*s%*s%*zu%*zu%*.*f%*.*f%*.*f%*.*f\n", 14, type, 8,
+        hg_perf_proc_hash_name_g[hash], 10, size, NWIDTH, result->enc_size,
+        NWIDTH, NDIGITS, result->enc_time * 1e9 / iter, NWIDTH, NDIGITS,
+        enc_size * iter / result->enc_time / 1e9, NWIDTH, NDIGITS,
+        result->dec_time * 1e9 / iter, NWIDTH, NDIGITS,
+        enc_size * iter / result->dec_time / 1e9);
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_proc_scalar(const struct hg_perf_proc_info *info, hg_proc_hash_t hash)
+{
+    hg_perf_proc_scalar_t in = {.id = 1,
+                              .offset = 4096,
+                              .size = 1048576,
+                              .mode = 0644,
+                              .flags = 2,
+                              .ret = 0},
+                          out;
+    struct hg_perf_proc_result result;
+    hg_return_t ret;
+
+    ret = hg_perf_proc_run(info, hash, 0, hg_proc_hg_perf_proc_scalar_t, &in,
+        &out, &result);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "hg_perf_proc_run() failed (%s)", HG_Error_to_string(ret));
+
+    hg_perf_proc_print(info, "scalar", hash, sizeof(in), &result);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_proc_string(const struct hg_perf_proc_info *info, hg_proc_hash_t hash)
+{
+    char *str = (char *) info->data_buf;
+    hg_return_t ret;
+    size_t size;
+
+    for (size = MAX(1, info->size_min); size <= info->size_max; size *= 2) {
+        hg_perf_proc_string_t in = {.path = str, .id = 1}, out;
+        struct hg_perf_proc_result result;
+
+        /* String of size bytes, including terminator */
+        memset(str, 'a', size - 1);
+        str[size - 1] = '\0';
+
+        ret = hg_perf_proc_run(info, hash, 0, hg_proc_hg_perf_proc_string_t,
+            &in, &out, &result);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_proc_run() failed (%s)",
+            HG_Error_to_string(ret));
+
+        hg_perf_proc_print(info, "string", hash, size, &result);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_proc_bulk(
+    const struct hg_perf_proc_info *info, hg_proc_hash_t hash, bool eager)
+{
+    void **buf_ptrs = NULL;
+    hg_size_t *buf_sizes = NULL;
+    hg_return_t ret;
+    size_t size;
+
+    buf_ptrs = (void **) malloc(info->bulk_count * sizeof(*buf_ptrs));
+    HG_TEST_CHECK_ERROR(buf_ptrs == NULL, error, ret, HG_NOMEM,
+        "Could not allocate segment pointers");
+
+    buf_sizes = (hg_size_t *) malloc(info->bulk_count * sizeof(*buf_sizes));
+    HG_TEST_CHECK_ERROR(buf_sizes == NULL, error, ret, HG_NOMEM,
+        "Could not allocate segment sizes");
+
+    for (size = MAX(1, info->size_min); size <= info->size_max; size *= 2) {
+        uint32_t count = (uint32_t) MIN(info->bulk_count, size), i;
+        hg_perf_proc_bulk_t in = {.bulk = HG_BULK_NULL, .size = size}, out;
+        struct hg_perf_proc_result result;
+
+        /* Split data evenly across segments */
+        for (i = 0; i < count; i++) {
+            buf_ptrs[i] = (char *) info->data_buf + i * (size / count);
+            buf_sizes[i] = (i == count - 1) ? size - i * (size / count)
+                                            : size / count;
+        }
+
+        /* Eager transfers only apply to read-only handles */
+        ret = HG_Bulk_create(info->hg_class, count, buf_ptrs, buf_sizes,
+            HG_BULK_READ_ONLY, &in.bulk);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Bulk_create() failed (%s)",
+            HG_Error_to_string(ret));
+
+        ret = hg_perf_proc_run(info, hash, eager ? HG_PROC_BULK_EAGER : 0,
+            hg_proc_hg_perf_proc_bulk_t, &in, &out, &result);
+        (void) HG_Bulk_free(in.bulk);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_proc_run() failed (%s)",
+            HG_Error_to_string(ret));
+
+        hg_perf_proc_print(
+            info, eager ? "bulk_eager" : "bulk", hash, size, &result);
+    }
+
+    free(buf_ptrs);
+    free(buf_sizes);
+
+    return HG_SUCCESS;
+
+error:
+    free(buf_ptrs);
+    free(buf_sizes);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_test_info hg_test_info;
+    struct hg_perf_proc_info info;
+    size_t page_size = (size_t) hg_mem_get_page_size();
+#ifdef HG_HAS_CHECKSUMS
+    hg_proc_hash_t hash_min = HG_CRC16;
+#else
+    hg_proc_hash_t hash_min = HG_NOHASH;
+#endif
+    int hash;
+    hg_return_t hg_ret;
+
+    memset(&hg_test_info, 0, sizeof(hg_test_info));
+    memset(&info, 0, sizeof(info));
+
+    /* No target is needed, proc operations are purely local */
+    hg_test_info.na_test_info.self_send = true;
+    hg_ret = HG_Test_init(argc, argv, &hg_test_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "HG_Test_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    info.hg_class = hg_test_info.hg_class;
+    info.size_min = hg_test_info.na_test_info.buf_size_min;
+    info.size_max = hg_test_info.na_test_info.buf_size_max;
+    if (info.size_max == 0)
+        info.size_max = page_size;
+    HG_TEST_CHECK_ERROR_NORET(!powerof2(info.size_max), error,
+        "Max buffer size must be a power of 2 (%zu)", info.size_max);
+    info.bulk_count = (uint32_t) hg_test_info.na_test_info.buf_count;
+    if (info.bulk_count == 0)
+        info.bulk_count = 1;
+    info.iter = MAX((size_t) hg_test_info.na_test_info.loop,
+        (size_t) HG_PERF_PROC_ITER_MIN);
+    info.buf_size = info.size_max + HG_PERF_PROC_BUF_EXTRA +
+                    info.bulk_count * 2 * sizeof(hg_uint64_t);
+
+    info.buf = hg_mem_aligned_alloc(page_size, info.buf_size);
+    HG_TEST_CHECK_ERROR_NORET(
+        info.buf == NULL, error, "Could not allocate encoding buffer");
+
+    info.data_buf = hg_mem_aligned_alloc(page_size, info.size_max);
+    HG_TEST_CHECK_ERROR_NORET(
+        info.data_buf == NULL, error, "Could not allocate data buffer");
+    memset(info.data_buf, 0, info.size_max);
+
+    /* Header info */
+    printf("# %s\n", BENCHMARK_NAME);
+    printf("# %zu operation(s) from size %zu to %zu byte(s), %" PRIu32
+           " bulk segment(s)\n",
+        info.iter, info.size_min, info.size_max, info.bulk_count);
+#ifdef HG_HAS_XDR
+    printf("# Encoding: XDR\n");
+#else
+    printf("# Encoding: native\n");
+#endif
+#ifdef HG_HAS_CHECKSUMS
+    printf("# Checksums: enabled\n");
+#else
+    printf("# Checksums: disabled\n");
+#endif
+    printf("%-*s%*s%*s%*s%*s%*s%*s%*s\n", 14, "# Type", 8, "Hash", 10, "Size",
+        NWIDTH, "Encoded", NWIDTH, "Enc ns/op", NWIDTH, "Enc GB/s", NWIDTH,
+        "Dec ns/op", NWIDTH, "Dec GB/s");
+    fflush(stdout);
+
+    for (hash = (int) hash_min; hash <= (int) HG_NOHASH; hash++) {
+        hg_ret = hg_perf_proc_scalar(&info, (hg_proc_hash_t) hash);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_proc_scalar() failed");
+
+        hg_ret = hg_perf_proc_string(&info, (hg_proc_hash_t) hash);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_proc_string() failed");
+
+        hg_ret = hg_perf_proc_bulk(&info, (hg_proc_hash_t) hash, false);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_proc_bulk() failed");
+
+        hg_ret = hg_perf_proc_bulk(&info, (hg_proc_hash_t) hash, true);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_proc_bulk() failed");
+    }
+
+    hg_mem_aligned_free(info.buf);
+    hg_mem_aligned_free(info.data_buf);
+    (void) HG_Test_finalize(&hg_test_info);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_mem_aligned_free(info.buf);
+    hg_mem_aligned_free(info.data_buf);
+    (void) HG_Test_finalize(&hg_test_info);
+
+    return EXIT_FAILURE;
+}
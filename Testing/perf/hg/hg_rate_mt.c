@@ -0,0 +1,534 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_perf.h"
+
+#include "mercury_thread.h"
+
+#ifndef _WIN32
+#    include <sys/uio.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    include <x86intrin.h>
+#    define HG_PERF_HAS_TSC
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+#define BENCHMARK_NAME "RPC rate (multi-threaded)"
+
+/* Max time blocked in progress */
+#define HG_PERF_MT_WAIT_MAX (100)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+#ifdef _WIN32
+struct iovec {
+    void *iov_base; /* Pointer to data.  */
+    size_t iov_len; /* Length of data.  */
+};
+#endif
+
+/* Request that may be completed from any thread */
+struct hg_perf_mt_request {
+    hg_atomic_int32_t complete_count; /* Completed count */
+    int32_t expected_count;           /* Expected count */
+};
+
+/* Start barrier shared by all threads of a step */
+struct hg_perf_mt_barrier {
+    hg_atomic_int32_t count;          /* Number of threads arrived */
+    hg_atomic_int32_t expected_count; /* Number of threads started */
+};
+
+/* Per-thread info */
+struct hg_perf_thread_info {
+    struct hg_perf_class_info class_info;    /* Per-thread class info */
+    const struct hg_test_info *hg_test_info; /* Test info */
+    struct hg_perf_mt_barrier *barrier;      /* Start barrier */
+    hg_thread_t thread;                      /* Thread */
+    size_t buf_size;                         /* RPC size */
+    size_t skip;                             /* Warm up iterations */
+    double elapsed;                          /* Elapsed time (s) */
+    double cpu_time;                         /* Thread CPU time (s) */
+    hg_return_t ret;                         /* Return code */
+    unsigned int thread_id;                  /* Thread ID */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static double
+hg_perf_thread_cpu_time(void);
+
+static hg_return_t
+hg_perf_mt_request_complete(const struct hg_cb_info *hg_cb_info);
+
+static hg_return_t
+hg_perf_mt_request_wait(
+    struct hg_perf_class_info *info, struct hg_perf_mt_request *request);
+
+static hg_return_t
+hg_perf_mt_forward(struct hg_perf_class_info *info, size_t buf_size);
+
+static HG_THREAD_RETURN_TYPE
+hg_perf_mt_thread(void *arg);
+
+static hg_return_t
+hg_perf_mt_thread_init(struct hg_perf_thread_info *thread_info,
+    const struct hg_test_info *hg_test_info, struct hg_perf_class_info *info,
+    unsigned int thread_id);
+
+static void
+hg_perf_mt_thread_cleanup(struct hg_perf_thread_info *thread_info);
+
+static hg_return_t
+hg_perf_mt_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, struct hg_perf_thread_info *thread_infos,
+    unsigned int thread_count, size_t buf_size, size_t skip);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static double
+hg_perf_thread_cpu_time(void)
+{
+#if defined(HG_UTIL_HAS_CLOCK_GETTIME) && defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0.;
+
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#else
+    return 0.;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_mt_request_complete(const struct hg_cb_info *hg_cb_info)
+{
+    struct hg_perf_mt_request *request =
+        (struct hg_perf_mt_request *) hg_cb_info->arg;
+
+    /* Callback may be triggered by another thread if context is shared */
+    hg_atomic_incr32(&request->complete_count);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_mt_request_wait(
+    struct hg_perf_class_info *info, struct hg_perf_mt_request *request)
+{
+    hg_return_t ret;
+
+    while (hg_atomic_get32(&request->complete_count) !=
+           request->expected_count) {
+        unsigned int count = 0, actual_count = 0;
+
+        if (info->poll_set && !HG_Event_ready(info->context)) {
+            struct hg_poll_event poll_event = {.events = 0, .data.ptr = NULL};
+            unsigned int actual_events = 0;
+            int rc;
+
+            rc = hg_poll_wait(info->poll_set, HG_PERF_MT_WAIT_MAX, 1,
+                &poll_event, &actual_events);
+            HG_TEST_CHECK_ERROR(rc != 0, error, ret, HG_PROTOCOL_ERROR,
+                "hg_poll_wait() failed");
+        }
+
+        ret = HG_Event_progress(info->context, &count);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+
+        if (count == 0)
+            continue;
+
+        ret = HG_Event_trigger(info->context, count, &actual_count);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_mt_forward(struct hg_perf_class_info *info, size_t buf_size)
+{
+    struct iovec in_struct = {.iov_base = info->rpc_buf, .iov_len = buf_size};
+    struct hg_perf_mt_request request = {
+        .complete_count = HG_ATOMIC_VAR_INIT(0),
+        .expected_count = (int32_t) info->handle_max};
+    hg_return_t ret;
+    size_t i;
+
+    for (i = 0; i < info->handle_max; i++) {
+        ret = HG_Forward(info->handles[i], hg_perf_mt_request_complete,
+            &request, &in_struct);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    return hg_perf_mt_request_wait(info, &request);
+
+error:
+    /* Make sure that posted operations complete before returning */
+    request.expected_count = (int32_t) i;
+    (void) hg_perf_mt_request_wait(info, &request);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_perf_mt_thread(void *arg)
+{
+    struct hg_perf_thread_info *thread_info =
+        (struct hg_perf_thread_info *) arg;
+    struct hg_perf_class_info *info = &thread_info->class_info;
+    size_t loop = (size_t) thread_info->hg_test_info->na_test_info.loop, i;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+    hg_time_t t1, t2;
+    double cpu_time;
+    bool ready = false;
+    hg_return_t ret;
+
+    /* Warm up */
+    for (i = 0; i < thread_info->skip; i++) {
+        ret = hg_perf_mt_forward(info, thread_info->buf_size);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_mt_forward() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    /* Wait for all threads to be ready */
+    hg_atomic_incr32(&thread_info->barrier->count);
+    ready = true;
+    while (hg_atomic_get32(&thread_info->barrier->count) !=
+           hg_atomic_get32(&thread_info->barrier->expected_count))
+        hg_thread_yield();
+
+    hg_time_get_current(&t1);
+    cpu_time = hg_perf_thread_cpu_time();
+
+    for (i = 0; i < loop; i++) {
+        ret = hg_perf_mt_forward(info, thread_info->buf_size);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "hg_perf_mt_forward() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    hg_time_get_current(&t2);
+    thread_info->cpu_time = hg_perf_thread_cpu_time() - cpu_time;
+    thread_info->elapsed = hg_time_to_double(hg_time_subtract(t2, t1));
+    thread_info->ret = HG_SUCCESS;
+
+    hg_thread_exit(tret);
+    return tret;
+
+error:
+    thread_info->ret = ret;
+    /* Do not block other threads */
+    if (!ready)
+        hg_atomic_incr32(&thread_info->barrier->count);
+
+    hg_thread_exit(tret);
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_mt_thread_init(struct hg_perf_thread_info *thread_info,
+    const struct hg_test_info *hg_test_info, struct hg_perf_class_info *info,
+    unsigned int thread_id)
+{
+    struct hg_perf_class_info *thread_class_info = &thread_info->class_info;
+    hg_return_t ret;
+    size_t i;
+
+    thread_info->hg_test_info = hg_test_info;
+    thread_info->thread_id = thread_id;
+
+    /* First thread uses default context and handles */
+    *thread_class_info = *info;
+    if (thread_id == 0)
+        return HG_SUCCESS;
+
+    thread_class_info->handles = NULL;
+    thread_class_info->poll_set = NULL;
+
+    if (!hg_test_info->shared_context) {
+        thread_class_info->context =
+            HG_Context_create_id(info->hg_class, (hg_uint8_t) thread_id);
+        HG_TEST_CHECK_ERROR(thread_class_info->context == NULL, error, ret,
+            HG_NOMEM, "HG_Context_create_id() failed");
+        thread_class_info->wait_fd =
+            HG_Event_get_wait_fd(thread_class_info->context);
+    }
+
+    /* Each thread needs its own poll set, even on a shared context */
+    if (thread_class_info->wait_fd > 0) {
+        struct hg_poll_event poll_event = {
+            .events = HG_POLLIN, .data.ptr = NULL};
+        int rc;
+
+        thread_class_info->poll_set = hg_poll_create();
+        HG_TEST_CHECK_ERROR(thread_class_info->poll_set == NULL, error, ret,
+            HG_NOMEM, "hg_poll_create() failed");
+
+        rc = hg_poll_add(thread_class_info->poll_set,
+            thread_class_info->wait_fd, &poll_event);
+        HG_TEST_CHECK_ERROR(
+            rc != 0, error, ret, HG_PROTOCOL_ERROR, "hg_poll_add() failed");
+    }
+
+    thread_class_info->handles =
+        (hg_handle_t *) calloc(info->handle_max, sizeof(hg_handle_t));
+    HG_TEST_CHECK_ERROR(thread_class_info->handles == NULL, error, ret,
+        HG_NOMEM, "Could not allocate array of %zu handles", info->handle_max);
+
+    for (i = 0; i < info->handle_max; i++) {
+        /* Round-robin to targets depending on thread */
+        size_t target_rank = (thread_id + i * hg_test_info->thread_count) %
+                             info->target_addr_max;
+
+        ret = HG_Create(thread_class_info->context,
+            info->target_addrs[target_rank], (hg_id_t) HG_PERF_RATE,
+            &thread_class_info->handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    hg_perf_mt_thread_cleanup(thread_info);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_perf_mt_thread_cleanup(struct hg_perf_thread_info *thread_info)
+{
+    struct hg_perf_class_info *info = &thread_info->class_info;
+    size_t i;
+
+    if (thread_info->thread_id == 0)
+        return;
+
+    if (info->handles != NULL) {
+        for (i = 0; i < info->handle_max; i++)
+            if (info->handles[i] != HG_HANDLE_NULL)
+                (void) HG_Destroy(info->handles[i]);
+        free(info->handles);
+        info->handles = NULL;
+    }
+
+    if (info->poll_set != NULL) {
+        hg_poll_remove(info->poll_set, info->wait_fd);
+        hg_poll_destroy(info->poll_set);
+        info->poll_set = NULL;
+    }
+
+    if (!thread_info->hg_test_info->shared_context && info->context) {
+        (void) HG_Context_destroy(info->context);
+        info->context = NULL;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_perf_mt_run(const struct hg_test_info *hg_test_info,
+    struct hg_perf_class_info *info, struct hg_perf_thread_info *thread_infos,
+    unsigned int thread_count, size_t buf_size, size_t skip)
+{
+    struct hg_perf_mt_barrier barrier = {.count = HG_ATOMIC_VAR_INIT(0),
+        .expected_count = HG_ATOMIC_VAR_INIT((int32_t) thread_count)};
+    double elapsed_max = 0., cpu_time = 0., rate_min = 0., rate_sum = 0.,
+           tsc_hz = 0.;
+    size_t rpc_count = (size_t) hg_test_info->na_test_info.loop *
+                       info->handle_max,
+           dir = (size_t) (hg_test_info->bidirectional ? 2 : 1);
+    hg_return_t ret = HG_SUCCESS;
+#ifdef HG_PERF_HAS_TSC
+    unsigned long long tsc1, tsc2;
+    hg_time_t t1, t2;
+#endif
+    unsigned int i;
+
+    if (hg_test_info->na_test_info.mpi_info.size > 1)
+        NA_Test_barrier(&hg_test_info->na_test_info);
+
+#ifdef HG_PERF_HAS_TSC
+    hg_time_get_current(&t1);
+    tsc1 = __rdtsc();
+#endif
+
+    for (i = 0; i < thread_count; i++) {
+        int rc;
+
+        thread_infos[i].barrier = &barrier;
+        thread_infos[i].buf_size = buf_size;
+        thread_infos[i].skip = skip;
+        thread_infos[i].ret = HG_SUCCESS;
+
+        rc = hg_thread_create(
+            &thread_infos[i].thread, hg_perf_mt_thread, &thread_infos[i]);
+        HG_TEST_CHECK_ERROR(rc != 0, error, ret, HG_PROTOCOL_ERROR,
+            "hg_thread_create() failed");
+    }
+
+    for (i = 0; i < thread_count; i++)
+        hg_thread_join(thread_infos[i].thread);
+
+#ifdef HG_PERF_HAS_TSC
+    tsc2 = __rdtsc();
+    hg_time_get_current(&t2);
+    tsc_hz = (double) (tsc2 - tsc1) /
+             hg_time_to_double(hg_time_subtract(t2, t1));
+#endif
+
+    for (i = 0; i < thread_count; i++) {
+        double rate;
+
+        HG_TEST_CHECK_ERROR(thread_infos[i].ret != HG_SUCCESS, done, ret,
+            thread_infos[i].ret, "Thread %u failed (%s)", i,
+            HG_Error_to_string(thread_infos[i].ret));
+
+        rate = (double) (rpc_count * dir) / thread_infos[i].elapsed;
+        rate_sum += rate;
+        if (i == 0 || rate < rate_min)
+            rate_min = rate;
+        elapsed_max = MAX(elapsed_max, thread_infos[i].elapsed);
+        cpu_time += thread_infos[i].cpu_time;
+    }
+
+    if (hg_test_info->na_test_info.mpi_info.size > 1)
+        NA_Test_barrier(&hg_test_info->na_test_info);
+
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_print_mt(thread_count, buf_size,
+            (double) (rpc_count * dir * thread_count) / elapsed_max,
+            rate_sum / (double) thread_count, rate_min,
+            cpu_time * 1e9 / (double) (rpc_count * thread_count),
+            cpu_time * tsc_hz / (double) (rpc_count * thread_count));
+
+    return HG_SUCCESS;
+
+error:
+    /* Release threads that were already started and wait for them */
+    hg_atomic_set32(&barrier.expected_count, (int32_t) i);
+    while (i-- > 0)
+        hg_thread_join(thread_infos[i].thread);
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_perf_info perf_info;
+    struct hg_test_info *hg_test_info;
+    struct hg_perf_class_info *info;
+    struct hg_perf_thread_info *thread_infos = NULL;
+    unsigned int thread_count, thread_max = 0, i;
+    size_t size;
+    hg_return_t hg_ret;
+
+    /* Initialize the interface */
+    hg_ret = hg_perf_init(argc, argv, false, &perf_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    hg_test_info = &perf_info.hg_test_info;
+    info = &perf_info.class_info[0];
+
+#ifndef HG_HAS_MULTI_PROGRESS
+    HG_TEST_CHECK_ERROR_NORET(hg_test_info->shared_context, error,
+        "Sharing a context between threads requires HG_HAS_MULTI_PROGRESS");
+#endif
+    HG_TEST_CHECK_ERROR_NORET(hg_test_info->thread_count > UINT8_MAX, error,
+        "Thread count (%u) exceeds max number of contexts",
+        hg_test_info->thread_count);
+
+    /* Allocate RPC buffers */
+    hg_ret = hg_perf_rpc_buf_init(hg_test_info, info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_init_rpc_buf() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Set HG handles */
+    hg_ret = hg_perf_set_handles(hg_test_info, info, HG_PERF_RATE);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_perf_set_handles() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Per-thread contexts and handles */
+    thread_infos = (struct hg_perf_thread_info *) calloc(
+        hg_test_info->thread_count, sizeof(*thread_infos));
+    HG_TEST_CHECK_ERROR_NORET(
+        thread_infos == NULL, error, "Could not allocate thread infos");
+
+    for (thread_max = 0; thread_max < hg_test_info->thread_count;
+         thread_max++) {
+        hg_ret = hg_perf_mt_thread_init(
+            &thread_infos[thread_max], hg_test_info, info, thread_max);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_perf_mt_thread_init() failed (%s)", HG_Error_to_string(hg_ret));
+    }
+
+    /* Header info */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_print_header_mt(hg_test_info, info, BENCHMARK_NAME);
+
+    /* RPC with different sizes and number of threads */
+    for (size = info->buf_size_min; size <= info->buf_size_max;
+         size = (size == 0) ? 1 : size * 2) {
+        for (thread_count = 1; thread_count <= thread_max;
+             thread_count = (thread_count == thread_max)
+                                ? thread_count + 1
+                                : MIN(thread_count * 2, thread_max)) {
+            hg_ret = hg_perf_mt_run(hg_test_info, info, thread_infos,
+                thread_count, size,
+                (size > HG_PERF_LARGE_SIZE) ? HG_PERF_LAT_SKIP_LARGE
+                                            : HG_PERF_LAT_SKIP_SMALL);
+            HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+                "hg_perf_mt_run() failed (%s)", HG_Error_to_string(hg_ret));
+        }
+    }
+
+    /* Finalize interface */
+    if (hg_test_info->na_test_info.mpi_info.rank == 0)
+        hg_perf_send_done(info);
+
+    for (i = 0; i < thread_max; i++)
+        hg_perf_mt_thread_cleanup(&thread_infos[i]);
+    free(thread_infos);
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_SUCCESS;
+
+error:
+    if (thread_infos != NULL) {
+        for (i = 0; i < thread_max; i++)
+            hg_perf_mt_thread_cleanup(&thread_infos[i]);
+        free(thread_infos);
+    }
+    hg_perf_cleanup(&perf_info);
+
+    return EXIT_FAILURE;
+}
@@ -34,8 +34,9 @@
     XSTRING(HG_VERSION_MAJOR)                                                  \
     "." XSTRING(HG_VERSION_MINOR) "." XSTRING(HG_VERSION_PATCH)
 
-#define NDIGITS 2
-#define NWIDTH  24
+#define NDIGITS    2
+#define NWIDTH     24
+#define NWIDTH_LAT 14
 
 /************************************/
 /* Local Type and Struct Definition */
@@ -69,6 +70,12 @@ hg_perf_bulk_buf_free(struct hg_perf_class_info *info);
 static void
 hg_perf_init_data(void *buf, size_t buf_size);
 
+static int
+hg_perf_lat_cmp(const void *a, const void *b);
+
+static double
+hg_perf_lat_percentile(const double *lat, size_t count, double p);
+
 static hg_return_t
 hg_perf_handle_create_cb(hg_handle_t handle, void *arg);
 
@@ -795,6 +802,158 @@ hg_perf_print_lat(const struct hg_test_info *hg_test_info,
         (long unsigned int) (1e6 / rpc_time));
 }
 
+/*---------------------------------------------------------------------------*/
+static int
+hg_perf_lat_cmp(const void *a, const void *b)
+{
+    double lat_a = *(const double *) a, lat_b = *(const double *) b;
+
+    return (lat_a > lat_b) - (lat_a < lat_b);
+}
+
+/*---------------------------------------------------------------------------*/
+static double
+hg_perf_lat_percentile(const double *lat, size_t count, double p)
+{
+    /* Nearest-rank on sorted samples */
+    size_t rank = (size_t) (p * (double) count + 0.5);
+
+    if (rank == 0)
+        rank = 1;
+    if (rank > count)
+        rank = count;
+
+    return lat[rank - 1];
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_lat_stats_compute(
+    double *lat, size_t count, struct hg_perf_lat_stats *stats)
+{
+    double sum = 0.;
+    size_t i;
+
+    memset(stats, 0, sizeof(*stats));
+    if (count == 0)
+        return;
+
+    /* Samples are sorted in place */
+    qsort(lat, count, sizeof(*lat), hg_perf_lat_cmp);
+
+    for (i = 0; i < count; i++)
+        sum += lat[i];
+
+    stats->avg = sum / (double) count;
+    stats->p50 = hg_perf_lat_percentile(lat, count, 0.5);
+    stats->p99 = hg_perf_lat_percentile(lat, count, 0.99);
+    stats->p999 = hg_perf_lat_percentile(lat, count, 0.999);
+    stats->max = lat[count - 1];
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_header_lat_dist(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark)
+{
+    printf("# %s v%s\n", benchmark, VERSION_NAME);
+    printf(
+        "# %d client process(es)\n", hg_test_info->na_test_info.mpi_info.size);
+    printf("# Loop %d times from size %zu to %zu byte(s) with %zu handle(s) "
+           "in-flight\n",
+        hg_test_info->na_test_info.loop, info->buf_size_min, info->buf_size_max,
+        info->handle_max);
+    if (hg_test_info->na_test_info.mpi_info.size > 1)
+        printf("# WARNING latency distribution is reported for rank 0 only\n");
+    if (info->verify)
+        printf("# WARNING verifying data, output will be slower\n");
+    printf("%-*s%*s%*s%*s%*s%*s\n", 10, "# Size", NWIDTH_LAT, "Avg (us)",
+        NWIDTH_LAT, "p50 (us)", NWIDTH_LAT, "p99 (us)", NWIDTH_LAT,
+        "p99.9 (us)", NWIDTH_LAT, "Max (us)");
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_lat_dist(size_t buf_size, const struct hg_perf_lat_stats *stats)
+{
+    printf("%-*zu%*.*f%*.*f%*.*f%*.*f%*.*f\n", 10, buf_size, NWIDTH_LAT,
+        NDIGITS, stats->avg, NWIDTH_LAT, NDIGITS, stats->p50, NWIDTH_LAT,
+        NDIGITS, stats->p99, NWIDTH_LAT, NDIGITS, stats->p999, NWIDTH_LAT,
+        NDIGITS, stats->max);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_header_load(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark,
+    const char *dist, double rate_max)
+{
+    printf("# %s v%s\n", benchmark, VERSION_NAME);
+    printf(
+        "# %d client process(es)\n", hg_test_info->na_test_info.mpi_info.size);
+    printf("# %d RPC(s) per step up to %.0f RPC/s offered with at most %zu "
+           "handle(s) in-flight\n",
+        hg_test_info->na_test_info.loop, rate_max, info->handle_max);
+    printf("# Payload size distribution: %s from %zu to %zu byte(s)\n", dist,
+        info->buf_size_min, info->buf_size_max);
+    printf("# Latency is measured from scheduled send time (Poisson "
+           "arrivals)\n");
+    if (hg_test_info->na_test_info.mpi_info.size > 1)
+        printf("# WARNING latency distribution is reported for rank 0 only\n");
+    printf("%-*s%*s%*s%*s%*s%*s%*s%*s\n", NWIDTH_LAT, "# Offered",
+        NWIDTH_LAT, "Achieved", NWIDTH_LAT, "Avg (us)", NWIDTH_LAT,
+        "p50 (us)", NWIDTH_LAT, "p99 (us)", NWIDTH_LAT, "p99.9 (us)",
+        NWIDTH_LAT, "Max (us)", NWIDTH_LAT, "Stalls");
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_load(double offered, double achieved, size_t stalls,
+    const struct hg_perf_lat_stats *stats)
+{
+    printf("%-*.0f%*.0f%*.*f%*.*f%*.*f%*.*f%*.*f%*zu\n", NWIDTH_LAT, offered,
+        NWIDTH_LAT, achieved, NWIDTH_LAT, NDIGITS, stats->avg, NWIDTH_LAT,
+        NDIGITS, stats->p50, NWIDTH_LAT, NDIGITS, stats->p99, NWIDTH_LAT,
+        NDIGITS, stats->p999, NWIDTH_LAT, NDIGITS, stats->max, NWIDTH_LAT,
+        stalls);
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_header_mt(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark)
+{
+    printf("# %s v%s\n", benchmark, VERSION_NAME);
+    printf(
+        "# %d client process(es)\n", hg_test_info->na_test_info.mpi_info.size);
+    printf("# Loop %d times from size %zu to %zu byte(s) with %zu handle(s) "
+           "in-flight per thread\n",
+        hg_test_info->na_test_info.loop, info->buf_size_min, info->buf_size_max,
+        info->handle_max);
+    printf("# Up to %u thread(s), %s\n", hg_test_info->thread_count,
+        (hg_test_info->shared_context) ? "sharing one context"
+                                       : "one context per thread");
+    printf("%-*s%*s%*s%*s%*s%*s%*s\n", 10, "# Threads", 10, "Size",
+        NWIDTH_LAT, "Agg (RPC/s)", NWIDTH_LAT, "Thr avg", NWIDTH_LAT,
+        "Thr min", NWIDTH_LAT, "CPU ns/RPC", NWIDTH_LAT, "Cycles/RPC");
+    fflush(stdout);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_perf_print_mt(unsigned int thread_count, size_t buf_size, double rate,
+    double thread_rate_avg, double thread_rate_min, double cpu_ns,
+    double cycles)
+{
+    printf("%-*u%*zu%*.0f%*.0f%*.0f%*.*f%*.0f\n", 10, thread_count, 10,
+        buf_size, NWIDTH_LAT, rate, NWIDTH_LAT, thread_rate_avg, NWIDTH_LAT,
+        thread_rate_min, NWIDTH_LAT, NDIGITS, cpu_ns, NWIDTH_LAT, cycles);
+    fflush(stdout);
+}
+
 /*---------------------------------------------------------------------------*/
 void
 hg_perf_print_header_time(const struct hg_test_info *hg_test_info,
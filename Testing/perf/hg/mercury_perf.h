@@ -80,6 +80,14 @@ struct hg_perf_bulk_init_info {
     uint32_t target_addr_max;
 };
 
+struct hg_perf_lat_stats {
+    double avg;  /* Average latency (us) */
+    double p50;  /* Median latency (us) */
+    double p99;  /* 99th percentile latency (us) */
+    double p999; /* 99.9th percentile latency (us) */
+    double max;  /* Max latency (us) */
+};
+
 struct hg_perf_bulk_info {
     hg_bulk_t bulk;     /* Bulk handle */
     uint32_t handle_id; /* Source handle ID */
@@ -139,6 +147,35 @@ void
 hg_perf_print_lat(const struct hg_test_info *hg_test_info,
     const struct hg_perf_class_info *info, size_t buf_size, hg_time_t t);
 
+void
+hg_perf_lat_stats_compute(
+    double *lat, size_t count, struct hg_perf_lat_stats *stats);
+
+void
+hg_perf_print_header_lat_dist(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark);
+
+void
+hg_perf_print_lat_dist(size_t buf_size, const struct hg_perf_lat_stats *stats);
+
+void
+hg_perf_print_header_load(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark,
+    const char *dist, double rate_max);
+
+void
+hg_perf_print_load(double offered, double achieved, size_t stalls,
+    const struct hg_perf_lat_stats *stats);
+
+void
+hg_perf_print_header_mt(const struct hg_test_info *hg_test_info,
+    const struct hg_perf_class_info *info, const char *benchmark);
+
+void
+hg_perf_print_mt(unsigned int thread_count, size_t buf_size, double rate,
+    double thread_rate_avg, double thread_rate_min, double cpu_ns,
+    double cycles);
+
 void
 hg_perf_print_header_time(const struct hg_test_info *hg_test_info,
     const struct hg_perf_class_info *info, const char *benchmark);
@@ -59,6 +59,7 @@ hg_test_register(hg_class_t *hg_class);
 
 /* test_rpc */
 hg_id_t hg_test_rpc_null_id_g = 0;
+hg_id_t hg_test_rpc_null_high_id_g = 0;
 hg_id_t hg_test_rpc_open_id_g = 0;
 hg_id_t hg_test_rpc_open_id_no_resp_g = 0;
 hg_id_t hg_test_overflow_id_g = 0;
@@ -205,6 +206,12 @@ hg_test_register(hg_class_t *hg_class)
     /* test_rpc */
     hg_test_rpc_null_id_g = MERCURY_REGISTER(
         hg_class, "hg_test_rpc_null", void, void, hg_test_rpc_null_cb);
+    hg_test_rpc_null_high_id_g = MERCURY_REGISTER(
+        hg_class, "hg_test_rpc_null_high", void, void, hg_test_rpc_null_cb);
+
+    /* High priority variant of NULL RPC */
+    HG_Registered_set_priority(
+        hg_class, hg_test_rpc_null_high_id_g, HG_PRIORITY_HIGH);
     hg_test_rpc_open_id_g = MERCURY_REGISTER(hg_class, "hg_test_rpc_open",
         rpc_open_in_t, rpc_open_out_t, hg_test_rpc_open_cb);
     hg_test_rpc_open_id_no_resp_g =
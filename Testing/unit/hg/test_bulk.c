@@ -451,6 +451,39 @@ main(int argc, char *argv[])
         HG_Error_to_string(hg_ret));
     HG_PASSED();
 
+    /* Destroy bulk info */
+    hg_ret = hg_test_bulk_destroy(&bulk_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_bulk_destroy() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /**************************************************************************
+     * Few-segment RPC bulk tests (vectored RMA without IOV allocation).
+     *************************************************************************/
+
+    /* Create bulk info */
+    hg_ret = hg_test_bulk_create(info.hg_class, 4, buf_size / 4, &bulk_info);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_bulk_create() failed (%s)",
+        HG_Error_to_string(hg_ret));
+
+    /* Few-segment bulk test (size BUFSIZE, offsets 0, 0) */
+    HG_TEST("4-segment RPC bulk (size BUFSIZE, offsets 0, 0)");
+    hg_ret = hg_test_bulk_forward(info.handles[0], info.target_addr,
+        hg_test_bulk_write_id_g, hg_test_bulk_forward_cb, bulk_info.bulk_handle,
+        buf_size, 0, 0, info.request);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_bulk_forward() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
+    /* Few-segment bulk test with partial first and last segments (size
+     * BUFSIZE - 3, offsets 1, 2) */
+    HG_TEST("4-segment RPC bulk (size BUFSIZE - 3, offsets 1, 2)");
+    hg_ret = hg_test_bulk_forward(info.handles[0], info.target_addr,
+        hg_test_bulk_write_id_g, hg_test_bulk_forward_cb, bulk_info.bulk_handle,
+        buf_size - 3, 1, 2, info.request);
+    HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_bulk_forward() failed (%s)",
+        HG_Error_to_string(hg_ret));
+    HG_PASSED();
+
     /* Destroy bulk info */
     hg_ret = hg_test_bulk_destroy(&bulk_info);
     HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_bulk_destroy() failed (%s)",
@@ -0,0 +1,345 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_unit.h"
+
+#include "mercury_bulk_proc.h"
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define HG_TEST_BIND_INFO_STRING "na+sm"
+
+#define HG_TEST_BIND_BUF_SIZE (64 * 1024)
+
+#define HG_TEST_BIND_PROGRESS_MAX  (1000)
+#define HG_TEST_BIND_PROGRESS_WAIT (10)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* In-process peer with a local buffer */
+struct hg_test_bind_peer {
+    hg_class_t *hg_class;
+    hg_context_t *context;
+    hg_bulk_t bulk;
+    char *buf;
+};
+
+/* Bulk transfer completion */
+struct hg_test_bind_request {
+    hg_return_t ret;
+    bool completed;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_test_bind_peer_init(struct hg_test_bind_peer *peer, bool auto_sm);
+
+static void
+hg_test_bind_peer_finalize(struct hg_test_bind_peer *peer);
+
+static hg_return_t
+hg_test_bind_bulk_create(struct hg_test_bind_peer *peer, char pattern);
+
+static hg_return_t
+hg_test_bind_serialize(
+    hg_bulk_t bulk, unsigned long flags, void **desc_p, hg_size_t *size_p);
+
+static hg_return_t
+hg_test_bind_transfer_cb(const struct hg_cb_info *callback_info);
+
+static hg_return_t
+hg_test_bind_forward(struct hg_test_bind_peer *origin,
+    struct hg_test_bind_peer *sm_peer, struct hg_test_bind_peer *local,
+    unsigned long flags);
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bind_peer_init(struct hg_test_bind_peer *peer, bool auto_sm)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    hg_return_t ret;
+
+    hg_init_info.auto_sm = auto_sm;
+    /* Transfers must go through NA */
+    hg_init_info.no_bulk_eager = true;
+
+    peer->hg_class = HG_Init_opt2(HG_TEST_BIND_INFO_STRING, HG_TRUE,
+        HG_VERSION(HG_VERSION_MAJOR, HG_VERSION_MINOR), &hg_init_info);
+    HG_TEST_CHECK_ERROR(peer->hg_class == NULL, error, ret, HG_FAULT,
+        "HG_Init_opt2() failed");
+
+    peer->context = HG_Context_create(peer->hg_class);
+    HG_TEST_CHECK_ERROR(peer->context == NULL, error, ret, HG_FAULT,
+        "HG_Context_create() failed");
+
+    peer->buf = (char *) malloc(HG_TEST_BIND_BUF_SIZE);
+    HG_TEST_CHECK_ERROR(
+        peer->buf == NULL, error, ret, HG_NOMEM, "Could not allocate buffer");
+
+    ret = hg_test_bind_bulk_create(peer, 0);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "Could not create bulk handle (%s)",
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    hg_test_bind_peer_finalize(peer);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_bind_peer_finalize(struct hg_test_bind_peer *peer)
+{
+    if (peer->bulk != HG_BULK_NULL) {
+        (void) HG_Bulk_free(peer->bulk);
+        peer->bulk = HG_BULK_NULL;
+    }
+    if (peer->context != NULL) {
+        (void) HG_Context_destroy(peer->context);
+        peer->context = NULL;
+    }
+    if (peer->hg_class != NULL) {
+        (void) HG_Finalize(peer->hg_class);
+        peer->hg_class = NULL;
+    }
+    free(peer->buf);
+    peer->buf = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bind_bulk_create(struct hg_test_bind_peer *peer, char pattern)
+{
+    hg_size_t buf_size = HG_TEST_BIND_BUF_SIZE;
+    void *buf_ptr = peer->buf;
+    hg_return_t ret;
+
+    memset(peer->buf, pattern, HG_TEST_BIND_BUF_SIZE);
+
+    ret = HG_Bulk_create(
+        peer->hg_class, 1, &buf_ptr, &buf_size, HG_BULK_READWRITE, &peer->bulk);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Bulk_bind(peer->bulk, peer->context);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Bulk_bind() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    if (peer->bulk != HG_BULK_NULL) {
+        (void) HG_Bulk_free(peer->bulk);
+        peer->bulk = HG_BULK_NULL;
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bind_serialize(
+    hg_bulk_t bulk, unsigned long flags, void **desc_p, hg_size_t *size_p)
+{
+    void *desc = NULL;
+    hg_size_t desc_size;
+    hg_return_t ret;
+
+    desc_size = HG_Bulk_get_serialize_size(bulk, flags);
+    HG_TEST_CHECK_ERROR(desc_size == 0, error, ret, HG_FAULT,
+        "HG_Bulk_get_serialize_size() failed");
+    desc = malloc(desc_size);
+    HG_TEST_CHECK_ERROR(
+        desc == NULL, error, ret, HG_NOMEM, "Could not allocate descriptor");
+    ret = HG_Bulk_serialize(desc, desc_size, flags, bulk);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Bulk_serialize() failed (%s)", HG_Error_to_string(ret));
+
+    *desc_p = desc;
+    *size_p = desc_size;
+
+    return HG_SUCCESS;
+
+error:
+    free(desc);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bind_transfer_cb(const struct hg_cb_info *callback_info)
+{
+    struct hg_test_bind_request *request =
+        (struct hg_test_bind_request *) callback_info->arg;
+
+    request->ret = callback_info->ret;
+    request->completed = true;
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bind_forward(struct hg_test_bind_peer *origin,
+    struct hg_test_bind_peer *sm_peer, struct hg_test_bind_peer *local,
+    unsigned long flags)
+{
+    struct hg_test_bind_request request = {
+        .ret = HG_SUCCESS, .completed = false};
+    hg_bulk_t sm_bulk = HG_BULK_NULL, origin_bulk = HG_BULK_NULL;
+    void *desc = NULL, *fwd_desc = NULL;
+    hg_size_t desc_size, fwd_desc_size;
+    unsigned int i;
+    hg_return_t ret;
+
+    /* Origin sends its bound handle to a peer with the given flags */
+    ret = hg_test_bind_serialize(origin->bulk, flags, &desc, &desc_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not serialize origin handle");
+    ret = HG_Bulk_deserialize(sm_peer->hg_class, &sm_bulk, desc, desc_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_deserialize() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* That peer forwards it to a peer that is not local */
+    ret = hg_test_bind_serialize(sm_bulk, 0, &fwd_desc, &fwd_desc_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not serialize forwarded handle");
+    ret = HG_Bulk_deserialize(
+        local->hg_class, &origin_bulk, fwd_desc, fwd_desc_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_deserialize() failed (%s)",
+        HG_Error_to_string(ret));
+
+    memset(local->buf, 0, HG_TEST_BIND_BUF_SIZE);
+    ret = HG_Bulk_bind_transfer(local->context, hg_test_bind_transfer_cb,
+        &request, HG_BULK_PULL, origin_bulk, 0, local->bulk, 0,
+        HG_TEST_BIND_BUF_SIZE, HG_OP_ID_IGNORE);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_bind_transfer() failed (%s)",
+        HG_Error_to_string(ret));
+
+    for (i = 0; i < HG_TEST_BIND_PROGRESS_MAX && !request.completed; i++) {
+        unsigned int count = 0;
+
+        ret = HG_Progress(local->context, HG_TEST_BIND_PROGRESS_WAIT);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+        ret = HG_Trigger(local->context, 0, 1, &count);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+    }
+    HG_TEST_CHECK_ERROR(!request.completed, done, ret, HG_TIMEOUT,
+        "Bulk transfer did not complete");
+    ret = request.ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Bulk transfer failed (%s)", HG_Error_to_string(ret));
+
+    HG_TEST_CHECK_ERROR(
+        memcmp(origin->buf, local->buf, HG_TEST_BIND_BUF_SIZE) != 0, done, ret,
+        HG_FAULT, "Data mismatch");
+
+done:
+    if (origin_bulk != HG_BULK_NULL)
+        (void) HG_Bulk_free(origin_bulk);
+    if (sm_bulk != HG_BULK_NULL)
+        (void) HG_Bulk_free(sm_bulk);
+    free(fwd_desc);
+    free(desc);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    /* Origin and SM peer share a node, local peer only reaches them over NA */
+    struct hg_test_bind_peer origin = {.hg_class = NULL,
+                                 .context = NULL,
+                                 .bulk = HG_BULK_NULL,
+                                 .buf = NULL},
+                             sm_peer = origin, local = origin;
+    unsigned long sm_flags = 0;
+    hg_bulk_t prev_bulk;
+    hg_return_t hg_ret;
+    int ret = EXIT_SUCCESS;
+
+    hg_ret = hg_test_bind_peer_init(&origin, true);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not initialize origin peer");
+    hg_ret = hg_test_bind_peer_init(&sm_peer, true);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not initialize SM peer");
+    hg_ret = hg_test_bind_peer_init(&local, false);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not initialize local peer");
+
+    /* Auto SM is disabled when the main class is already SM, handles are
+     * then only serialized for NA */
+#ifdef NA_HAS_SM
+    if (HG_Core_class_get_na_sm(origin.hg_class->core_class) != NULL)
+        sm_flags = HG_BULK_SM;
+#endif
+    if (sm_flags == 0)
+        printf("No SM class, bound handles are only serialized for NA\n");
+
+    /* Same handle serialized for SM only first, then NA, then both */
+    memset(origin.buf, 1, HG_TEST_BIND_BUF_SIZE);
+    if (sm_flags != 0) {
+        HG_TEST("forward bound bulk handle (SM)");
+        hg_ret = hg_test_bind_forward(&origin, &sm_peer, &local, sm_flags);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "bound bulk handle SM test failed");
+        HG_PASSED();
+    }
+
+    HG_TEST("forward bound bulk handle (NA)");
+    hg_ret = hg_test_bind_forward(&origin, &sm_peer, &local, 0);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bound bulk handle NA test failed");
+    HG_PASSED();
+
+    /* Handle is now registered with both transports */
+    if (sm_flags != 0) {
+        HG_TEST("forward bound bulk handle (NA and SM)");
+        hg_ret = hg_test_bind_forward(&origin, &sm_peer, &local, sm_flags);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "bound bulk handle NA and SM test failed");
+        HG_PASSED();
+    }
+
+    /* Handle recycled from the pool must not keep previous registrations */
+    HG_TEST("forward bound bulk handle reused after free");
+    prev_bulk = origin.bulk;
+    (void) HG_Bulk_free(origin.bulk);
+    origin.bulk = HG_BULK_NULL;
+    hg_ret = hg_test_bind_bulk_create(&origin, 2);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not create origin bulk handle");
+    HG_TEST_CHECK_ERROR(origin.bulk != prev_bulk, done, ret, EXIT_FAILURE,
+        "Bulk handle was not reused");
+    hg_ret = hg_test_bind_forward(&origin, &sm_peer, &local, sm_flags);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bound bulk handle reuse test failed");
+    HG_PASSED();
+
+done:
+    if (ret != EXIT_SUCCESS)
+        HG_FAILED();
+
+    hg_test_bind_peer_finalize(&local);
+    hg_test_bind_peer_finalize(&sm_peer);
+    hg_test_bind_peer_finalize(&origin);
+
+    return ret;
+}
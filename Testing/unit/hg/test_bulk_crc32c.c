@@ -0,0 +1,412 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_unit.h"
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Peers are in the same process and communicate over SM */
+#define HG_TEST_CRC_INFO_STRING "na+sm"
+
+/* More segments than SM can describe with a single memory handle, so that
+ * transfers are split into one NA operation per segment and checksums of
+ * each operation are merged. Segment boundaries differ on both sides and odd
+ * sizes keep segments unaligned. */
+#define HG_TEST_CRC_SEG_COUNT       (1500)
+#define HG_TEST_CRC_SEG_SIZE        (37)
+#define HG_TEST_CRC_LOCAL_SEG_COUNT (1100)
+
+#define HG_TEST_CRC_BUF_SIZE (HG_TEST_CRC_SEG_COUNT * HG_TEST_CRC_SEG_SIZE)
+
+#define HG_TEST_CRC_CASE_COUNT                                                 \
+    (sizeof(hg_test_crc_cases_g) / sizeof(hg_test_crc_cases_g[0]))
+
+#define HG_TEST_CRC_ADDR_MAX      (256)
+#define HG_TEST_CRC_PROGRESS_MAX  (1000)
+#define HG_TEST_CRC_PROGRESS_WAIT (10)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* In-process peer */
+struct hg_test_crc_peer {
+    hg_class_t *hg_class;
+    hg_context_t *context;
+    hg_addr_t self_addr;
+};
+
+/* Buffer described by one or more segments */
+struct hg_test_crc_buf {
+    char *buf;
+    hg_bulk_t bulk;
+};
+
+/* Bulk transfer completion */
+struct hg_test_crc_request {
+    hg_return_t ret;
+    uint32_t crc32c;
+    bool completed;
+};
+
+/* Transfer case */
+struct hg_test_crc_case {
+    const char *name;
+    hg_bulk_op_t op;
+    bool self;             /* Origin is local peer */
+    uint32_t origin_count; /* Origin segment count */
+    uint32_t local_count;  /* Local segment count */
+    hg_size_t origin_offset;
+    hg_size_t local_offset;
+    hg_size_t size;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Bitwise reference implementation, independent from mercury_crc32c */
+static uint32_t
+hg_test_crc_ref(const char *buf, size_t len);
+
+static hg_return_t
+hg_test_crc_peer_init(struct hg_test_crc_peer *peer);
+
+static void
+hg_test_crc_peer_finalize(struct hg_test_crc_peer *peer);
+
+static hg_return_t
+hg_test_crc_buf_init(struct hg_test_crc_buf *buf, hg_class_t *hg_class,
+    uint32_t count, char pattern);
+
+static void
+hg_test_crc_buf_finalize(struct hg_test_crc_buf *buf);
+
+static hg_return_t
+hg_test_crc_transfer_cb(const struct hg_cb_info *callback_info);
+
+static hg_return_t
+hg_test_crc_transfer(struct hg_test_crc_peer *local,
+    struct hg_test_crc_peer *origin, const struct hg_test_crc_case *test_case);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+static const struct hg_test_crc_case hg_test_crc_cases_g[] = {
+    /* Checksum fused into local copy */
+    {"self pull", HG_BULK_PULL, true, 1, 1, 5, 3, HG_TEST_CRC_BUF_SIZE - 16},
+    {"self push", HG_BULK_PUSH, true, HG_TEST_CRC_SEG_COUNT, 3, 11, 0,
+        HG_TEST_CRC_BUF_SIZE - 11},
+    /* Single NA operation */
+    {"NA pull", HG_BULK_PULL, false, 1, 1, 0, 0, HG_TEST_CRC_BUF_SIZE},
+    {"NA pull with offsets", HG_BULK_PULL, false, 1, 1, 7, 1,
+        HG_TEST_CRC_BUF_SIZE - 9},
+    {"NA push with offsets", HG_BULK_PUSH, false, 1, 1, 1, 7,
+        HG_TEST_CRC_BUF_SIZE - 9},
+    /* One NA operation per segment, checksums merged in order */
+    {"NA pull segments", HG_BULK_PULL, false, HG_TEST_CRC_SEG_COUNT, 1, 0, 0,
+        HG_TEST_CRC_BUF_SIZE},
+    {"NA pull segments with offsets", HG_BULK_PULL, false,
+        HG_TEST_CRC_SEG_COUNT, HG_TEST_CRC_LOCAL_SEG_COUNT, 50, 13,
+        HG_TEST_CRC_BUF_SIZE - 100},
+    {"NA push segments with offsets", HG_BULK_PUSH, false,
+        HG_TEST_CRC_SEG_COUNT, HG_TEST_CRC_LOCAL_SEG_COUNT, 13, 50,
+        HG_TEST_CRC_BUF_SIZE - 100}};
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+hg_test_crc_ref(const char *buf, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    size_t i;
+    int k;
+
+    for (i = 0; i < len; i++) {
+        crc ^= (unsigned char) buf[i];
+        for (k = 0; k < 8; k++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+    }
+
+    return ~crc;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_crc_peer_init(struct hg_test_crc_peer *peer)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    hg_return_t ret;
+
+    /* Transfers must go through NA */
+    hg_init_info.no_bulk_eager = true;
+
+    peer->hg_class = HG_Init_opt2(HG_TEST_CRC_INFO_STRING, HG_TRUE,
+        HG_VERSION(HG_VERSION_MAJOR, HG_VERSION_MINOR), &hg_init_info);
+    HG_TEST_CHECK_ERROR(peer->hg_class == NULL, error, ret, HG_FAULT,
+        "HG_Init_opt2() failed");
+
+    peer->context = HG_Context_create(peer->hg_class);
+    HG_TEST_CHECK_ERROR(peer->context == NULL, error, ret, HG_FAULT,
+        "HG_Context_create() failed");
+
+    ret = HG_Addr_self(peer->hg_class, &peer->self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_self() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    hg_test_crc_peer_finalize(peer);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_crc_peer_finalize(struct hg_test_crc_peer *peer)
+{
+    if (peer->self_addr != HG_ADDR_NULL) {
+        (void) HG_Addr_free(peer->hg_class, peer->self_addr);
+        peer->self_addr = HG_ADDR_NULL;
+    }
+    if (peer->context != NULL) {
+        (void) HG_Context_destroy(peer->context);
+        peer->context = NULL;
+    }
+    if (peer->hg_class != NULL) {
+        (void) HG_Finalize(peer->hg_class);
+        peer->hg_class = NULL;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_crc_buf_init(struct hg_test_crc_buf *buf, hg_class_t *hg_class,
+    uint32_t count, char pattern)
+{
+    void **buf_ptrs = NULL;
+    hg_size_t *buf_sizes = NULL;
+    hg_size_t seg_size = HG_TEST_CRC_BUF_SIZE / count;
+    hg_size_t i;
+    hg_return_t ret;
+
+    buf->bulk = HG_BULK_NULL;
+    buf->buf = (char *) malloc(HG_TEST_CRC_BUF_SIZE);
+    HG_TEST_CHECK_ERROR(
+        buf->buf == NULL, error, ret, HG_NOMEM, "Could not allocate buffer");
+    for (i = 0; i < HG_TEST_CRC_BUF_SIZE; i++)
+        buf->buf[i] = (char) (pattern + (char) (i * 7));
+
+    /* Segments are consecutive slices of the buffer, last one takes the
+     * remainder */
+    buf_ptrs = (void **) malloc(count * sizeof(*buf_ptrs));
+    buf_sizes = (hg_size_t *) malloc(count * sizeof(*buf_sizes));
+    HG_TEST_CHECK_ERROR(buf_ptrs == NULL || buf_sizes == NULL, error, ret,
+        HG_NOMEM, "Could not allocate segments");
+    for (i = 0; i < count; i++) {
+        buf_ptrs[i] = buf->buf + i * seg_size;
+        buf_sizes[i] = seg_size;
+    }
+    buf_sizes[count - 1] += HG_TEST_CRC_BUF_SIZE % count;
+
+    ret = HG_Bulk_create(hg_class, count, buf_ptrs, buf_sizes,
+        HG_BULK_READWRITE, &buf->bulk);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+
+    free(buf_ptrs);
+    free(buf_sizes);
+
+    return HG_SUCCESS;
+
+error:
+    free(buf_ptrs);
+    free(buf_sizes);
+    hg_test_crc_buf_finalize(buf);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_crc_buf_finalize(struct hg_test_crc_buf *buf)
+{
+    if (buf->bulk != HG_BULK_NULL) {
+        (void) HG_Bulk_free(buf->bulk);
+        buf->bulk = HG_BULK_NULL;
+    }
+    free(buf->buf);
+    buf->buf = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_crc_transfer_cb(const struct hg_cb_info *callback_info)
+{
+    struct hg_test_crc_request *request =
+        (struct hg_test_crc_request *) callback_info->arg;
+
+    request->ret = callback_info->ret;
+    request->crc32c = callback_info->info.bulk.crc32c;
+    request->completed = true;
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_crc_transfer(struct hg_test_crc_peer *local,
+    struct hg_test_crc_peer *origin, const struct hg_test_crc_case *test_case)
+{
+    struct hg_test_crc_request request = {
+        .ret = HG_SUCCESS, .crc32c = 0, .completed = false};
+    struct hg_test_crc_buf origin_buf = {.buf = NULL, .bulk = HG_BULK_NULL},
+                           local_buf = {.buf = NULL, .bulk = HG_BULK_NULL};
+    char addr_string[HG_TEST_CRC_ADDR_MAX];
+    hg_size_t addr_string_size = sizeof(addr_string);
+    hg_bulk_t origin_bulk = HG_BULK_NULL;
+    hg_addr_t origin_addr = HG_ADDR_NULL;
+    void *desc = NULL;
+    const char *src, *dst;
+    uint32_t crc32c;
+    unsigned int i;
+    hg_return_t ret;
+
+    ret = hg_test_crc_buf_init(
+        &origin_buf, origin->hg_class, test_case->origin_count, 1);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_crc_buf_init() failed (%s)",
+        HG_Error_to_string(ret));
+    ret = hg_test_crc_buf_init(
+        &local_buf, local->hg_class, test_case->local_count, 2);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_crc_buf_init() failed (%s)",
+        HG_Error_to_string(ret));
+
+    if (origin == local) {
+        origin_bulk = origin_buf.bulk;
+        origin_addr = local->self_addr;
+    } else {
+        hg_size_t desc_size = HG_Bulk_get_serialize_size(origin_buf.bulk, 0);
+
+        HG_TEST_CHECK_ERROR(desc_size == 0, done, ret, HG_FAULT,
+            "HG_Bulk_get_serialize_size() failed");
+        desc = malloc(desc_size);
+        HG_TEST_CHECK_ERROR(
+            desc == NULL, done, ret, HG_NOMEM, "Could not allocate descriptor");
+        ret = HG_Bulk_serialize(desc, desc_size, 0, origin_buf.bulk);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_serialize() failed (%s)",
+            HG_Error_to_string(ret));
+        ret = HG_Bulk_deserialize(
+            local->hg_class, &origin_bulk, desc, desc_size);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_deserialize() failed (%s)",
+            HG_Error_to_string(ret));
+
+        ret = HG_Addr_to_string(origin->hg_class, addr_string,
+            &addr_string_size, origin->self_addr);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Addr_to_string() failed (%s)",
+            HG_Error_to_string(ret));
+        ret = HG_Addr_lookup2(local->hg_class, addr_string, &origin_addr);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Addr_lookup2() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    ret = HG_Bulk_transfer(local->context, hg_test_crc_transfer_cb, &request,
+        test_case->op | HG_BULK_CRC32C, origin_addr, origin_bulk,
+        test_case->origin_offset, local_buf.bulk, test_case->local_offset,
+        test_case->size, HG_OP_ID_IGNORE);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_transfer() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 0; i < HG_TEST_CRC_PROGRESS_MAX && !request.completed; i++) {
+        unsigned int count = 0;
+
+        ret = HG_Progress(local->context, HG_TEST_CRC_PROGRESS_WAIT);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+        ret = HG_Trigger(local->context, 0, 1, &count);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+    }
+    HG_TEST_CHECK_ERROR(!request.completed, done, ret, HG_TIMEOUT,
+        "Bulk transfer did not complete");
+    ret = request.ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Bulk transfer failed (%s)", HG_Error_to_string(ret));
+
+    /* Checksum covers the transferred range of local memory */
+    src = (test_case->op == HG_BULK_PULL) ? origin_buf.buf : local_buf.buf;
+    dst = (test_case->op == HG_BULK_PULL) ? local_buf.buf : origin_buf.buf;
+    src += (test_case->op == HG_BULK_PULL) ? test_case->origin_offset
+                                           : test_case->local_offset;
+    dst += (test_case->op == HG_BULK_PULL) ? test_case->local_offset
+                                           : test_case->origin_offset;
+    HG_TEST_CHECK_ERROR(memcmp(src, dst, test_case->size) != 0, done, ret,
+        HG_FAULT, "Data mismatch");
+    crc32c = hg_test_crc_ref(
+        local_buf.buf + test_case->local_offset, test_case->size);
+    HG_TEST_CHECK_ERROR(request.crc32c != crc32c, done, ret, HG_FAULT,
+        "Checksum mismatch (%" PRIx32 " != %" PRIx32 ")", request.crc32c,
+        crc32c);
+
+done:
+    if (origin != local) {
+        if (origin_addr != HG_ADDR_NULL)
+            (void) HG_Addr_free(local->hg_class, origin_addr);
+        if (origin_bulk != HG_BULK_NULL)
+            (void) HG_Bulk_free(origin_bulk);
+    }
+    free(desc);
+    hg_test_crc_buf_finalize(&local_buf);
+    hg_test_crc_buf_finalize(&origin_buf);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    struct hg_test_crc_peer local = {.hg_class = NULL,
+                                .context = NULL,
+                                .self_addr = HG_ADDR_NULL},
+                            origin = local;
+    hg_return_t hg_ret;
+    size_t i;
+    int ret = EXIT_SUCCESS;
+
+    hg_ret = hg_test_crc_peer_init(&local);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not initialize local peer");
+    hg_ret = hg_test_crc_peer_init(&origin);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not initialize origin peer");
+
+    for (i = 0; i < HG_TEST_CRC_CASE_COUNT; i++) {
+        const struct hg_test_crc_case *test_case = &hg_test_crc_cases_g[i];
+        char test_name[64];
+
+        snprintf(test_name, sizeof(test_name), "bulk CRC32C %s",
+            test_case->name);
+        HG_TEST(test_name);
+        hg_ret = hg_test_crc_transfer(
+            &local, test_case->self ? &local : &origin, test_case);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "%s test failed", test_name);
+        HG_PASSED();
+    }
+
+done:
+    if (ret != EXIT_SUCCESS)
+        HG_FAILED();
+
+    hg_test_crc_peer_finalize(&origin);
+    hg_test_crc_peer_finalize(&local);
+
+    return ret;
+}
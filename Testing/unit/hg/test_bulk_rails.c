@@ -0,0 +1,306 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_unit.h"
+
+#include "mercury_crc32c.h"
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Peers use SM for both their main class and their bulk rails */
+#define HG_TEST_RAILS_INFO_STRING "na+sm"
+
+/* Stripe small enough that the buffer spans all rails */
+#define HG_TEST_RAILS_BUF_SIZE    (1024 * 1024)
+#define HG_TEST_RAILS_STRIPE_SIZE (4096)
+
+#define HG_TEST_RAILS_ADDR_MAX      (256)
+#define HG_TEST_RAILS_PROGRESS_MAX  (1000)
+#define HG_TEST_RAILS_PROGRESS_WAIT (10)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* In-process peer with its own set of bulk rails */
+struct hg_test_rails_peer {
+    hg_class_t *hg_class;
+    hg_context_t *context;
+    hg_bulk_t bulk;
+    hg_addr_t self_addr;
+    char *buf;
+};
+
+/* Bulk transfer completion */
+struct hg_test_rails_request {
+    hg_return_t ret;
+    uint32_t crc32c;
+    bool completed;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_test_rails_peer_init(
+    struct hg_test_rails_peer *peer, const char *bulk_rails, char pattern);
+
+static void
+hg_test_rails_peer_finalize(struct hg_test_rails_peer *peer);
+
+static hg_return_t
+hg_test_rails_transfer_cb(const struct hg_cb_info *callback_info);
+
+static hg_return_t
+hg_test_rails_transfer(struct hg_test_rails_peer *origin,
+    struct hg_test_rails_peer *local, hg_bulk_op_t op);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rails_peer_init(
+    struct hg_test_rails_peer *peer, const char *bulk_rails, char pattern)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    hg_size_t buf_size = HG_TEST_RAILS_BUF_SIZE;
+    void *buf_ptr;
+    hg_return_t ret;
+
+    hg_init_info.bulk_rails = bulk_rails;
+    hg_init_info.bulk_stripe_size = HG_TEST_RAILS_STRIPE_SIZE;
+    /* Transfers must go through NA */
+    hg_init_info.no_bulk_eager = true;
+
+    peer->hg_class = HG_Init_opt2(HG_TEST_RAILS_INFO_STRING, HG_TRUE,
+        HG_VERSION(HG_VERSION_MAJOR, HG_VERSION_MINOR), &hg_init_info);
+    HG_TEST_CHECK_ERROR(peer->hg_class == NULL, error, ret, HG_FAULT,
+        "HG_Init_opt2() failed");
+
+    peer->context = HG_Context_create(peer->hg_class);
+    HG_TEST_CHECK_ERROR(peer->context == NULL, error, ret, HG_FAULT,
+        "HG_Context_create() failed");
+
+    ret = HG_Addr_self(peer->hg_class, &peer->self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_self() failed (%s)", HG_Error_to_string(ret));
+
+    peer->buf = (char *) malloc(HG_TEST_RAILS_BUF_SIZE);
+    HG_TEST_CHECK_ERROR(
+        peer->buf == NULL, error, ret, HG_NOMEM, "Could not allocate buffer");
+    memset(peer->buf, pattern, HG_TEST_RAILS_BUF_SIZE);
+
+    buf_ptr = peer->buf;
+    ret = HG_Bulk_create(
+        peer->hg_class, 1, &buf_ptr, &buf_size, HG_BULK_READWRITE, &peer->bulk);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    hg_test_rails_peer_finalize(peer);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_rails_peer_finalize(struct hg_test_rails_peer *peer)
+{
+    if (peer->bulk != HG_BULK_NULL) {
+        (void) HG_Bulk_free(peer->bulk);
+        peer->bulk = HG_BULK_NULL;
+    }
+    if (peer->self_addr != HG_ADDR_NULL) {
+        (void) HG_Addr_free(peer->hg_class, peer->self_addr);
+        peer->self_addr = HG_ADDR_NULL;
+    }
+    if (peer->context != NULL) {
+        (void) HG_Context_destroy(peer->context);
+        peer->context = NULL;
+    }
+    if (peer->hg_class != NULL) {
+        (void) HG_Finalize(peer->hg_class);
+        peer->hg_class = NULL;
+    }
+    free(peer->buf);
+    peer->buf = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rails_transfer_cb(const struct hg_cb_info *callback_info)
+{
+    struct hg_test_rails_request *request =
+        (struct hg_test_rails_request *) callback_info->arg;
+
+    request->ret = callback_info->ret;
+    request->crc32c = callback_info->info.bulk.crc32c;
+    request->completed = true;
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rails_transfer(struct hg_test_rails_peer *origin,
+    struct hg_test_rails_peer *local, hg_bulk_op_t op)
+{
+    struct hg_test_rails_request request = {
+        .ret = HG_SUCCESS, .crc32c = 0, .completed = false};
+    char addr_string[HG_TEST_RAILS_ADDR_MAX];
+    hg_size_t addr_string_size = sizeof(addr_string);
+    hg_bulk_t origin_bulk = HG_BULK_NULL;
+    hg_addr_t origin_addr = HG_ADDR_NULL;
+    void *desc = NULL;
+    hg_size_t desc_size;
+    const char *src, *dst;
+    uint32_t crc32c;
+    unsigned int i;
+    hg_return_t ret;
+
+    /* Origin descriptor carries all of its rails, local peer only uses the
+     * ones it knows */
+    desc_size = HG_Bulk_get_serialize_size(origin->bulk, 0);
+    HG_TEST_CHECK_ERROR(desc_size == 0, done, ret, HG_FAULT,
+        "HG_Bulk_get_serialize_size() failed");
+    desc = malloc(desc_size);
+    HG_TEST_CHECK_ERROR(
+        desc == NULL, done, ret, HG_NOMEM, "Could not allocate descriptor");
+    ret = HG_Bulk_serialize(desc, desc_size, 0, origin->bulk);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_serialize() failed (%s)", HG_Error_to_string(ret));
+    ret = HG_Bulk_deserialize(local->hg_class, &origin_bulk, desc, desc_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_deserialize() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Addr_to_string(
+        origin->hg_class, addr_string, &addr_string_size, origin->self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_to_string() failed (%s)", HG_Error_to_string(ret));
+    ret = HG_Addr_lookup2(local->hg_class, addr_string, &origin_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_lookup2() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Bulk_transfer(local->context, hg_test_rails_transfer_cb, &request,
+        op | HG_BULK_CRC32C, origin_addr, origin_bulk, 0, local->bulk, 0,
+        HG_TEST_RAILS_BUF_SIZE, HG_OP_ID_IGNORE);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_transfer() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 0; i < HG_TEST_RAILS_PROGRESS_MAX && !request.completed; i++) {
+        unsigned int count = 0;
+
+        ret = HG_Progress(local->context, HG_TEST_RAILS_PROGRESS_WAIT);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+        ret = HG_Trigger(local->context, 0, 1, &count);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+    }
+    HG_TEST_CHECK_ERROR(!request.completed, done, ret, HG_TIMEOUT,
+        "Bulk transfer did not complete");
+    ret = request.ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Bulk transfer failed (%s)", HG_Error_to_string(ret));
+
+    /* Data and checksum must match whatever rail each stripe went through */
+    src = (op == HG_BULK_PULL) ? origin->buf : local->buf;
+    dst = (op == HG_BULK_PULL) ? local->buf : origin->buf;
+    HG_TEST_CHECK_ERROR(memcmp(src, dst, HG_TEST_RAILS_BUF_SIZE) != 0, done,
+        ret, HG_FAULT, "Data mismatch");
+    crc32c = hg_crc32c(HG_CRC32C_INIT, local->buf, HG_TEST_RAILS_BUF_SIZE);
+    HG_TEST_CHECK_ERROR(request.crc32c != crc32c, done, ret, HG_FAULT,
+        "Checksum mismatch (%" PRIx32 " != %" PRIx32 ")", request.crc32c,
+        crc32c);
+
+done:
+    if (origin_addr != HG_ADDR_NULL)
+        (void) HG_Addr_free(local->hg_class, origin_addr);
+    if (origin_bulk != HG_BULK_NULL)
+        (void) HG_Bulk_free(origin_bulk);
+    free(desc);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    /* Peers list a different number of rails, including the main class */
+    struct hg_test_rails_peer peer1 = {.hg_class = NULL,
+                                  .context = NULL,
+                                  .bulk = HG_BULK_NULL,
+                                  .self_addr = HG_ADDR_NULL,
+                                  .buf = NULL},
+                              peer2 = peer1, peer3 = peer1;
+    hg_return_t hg_ret;
+    int ret = EXIT_SUCCESS;
+
+    hg_ret = hg_test_rails_peer_init(&peer1, "na+sm,na+sm", 1);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not initialize peer with 2 rails");
+    hg_ret = hg_test_rails_peer_init(&peer2, "na+sm", 2);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not initialize peer with 1 rail");
+    hg_ret = hg_test_rails_peer_init(&peer3, "na+sm,na+sm", 6);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "Could not initialize peer with 2 rails");
+
+    /* Origin describes more rails than the local peer has */
+    HG_TEST("bulk rails pull (3 origin rails, 2 local rails)");
+    hg_ret = hg_test_rails_transfer(&peer1, &peer2, HG_BULK_PULL);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bulk rails pull test failed");
+    HG_PASSED();
+
+    /* Origin describes fewer rails than the local peer has */
+    memset(peer1.buf, 3, HG_TEST_RAILS_BUF_SIZE);
+    HG_TEST("bulk rails pull (2 origin rails, 3 local rails)");
+    hg_ret = hg_test_rails_transfer(&peer2, &peer1, HG_BULK_PULL);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bulk rails pull test failed");
+    HG_PASSED();
+
+    memset(peer1.buf, 4, HG_TEST_RAILS_BUF_SIZE);
+    HG_TEST("bulk rails push (2 origin rails, 3 local rails)");
+    hg_ret = hg_test_rails_transfer(&peer2, &peer1, HG_BULK_PUSH);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bulk rails push test failed");
+    HG_PASSED();
+
+    memset(peer2.buf, 5, HG_TEST_RAILS_BUF_SIZE);
+    HG_TEST("bulk rails push (3 origin rails, 2 local rails)");
+    hg_ret = hg_test_rails_transfer(&peer1, &peer2, HG_BULK_PUSH);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bulk rails push test failed");
+    HG_PASSED();
+
+    /* Both peers stripe across all of their rails */
+    HG_TEST("bulk rails pull (3 origin rails, 3 local rails)");
+    hg_ret = hg_test_rails_transfer(&peer3, &peer1, HG_BULK_PULL);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bulk rails pull test failed");
+    HG_PASSED();
+
+done:
+    if (ret != EXIT_SUCCESS)
+        HG_FAILED();
+
+    hg_test_rails_peer_finalize(&peer3);
+    hg_test_rails_peer_finalize(&peer2);
+    hg_test_rails_peer_finalize(&peer1);
+
+    return ret;
+}
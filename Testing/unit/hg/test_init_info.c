@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_unit.h"
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define HG_TEST_INIT_INFO_STRING "na+sm"
+
+/* Pattern of the bytes that follow an older init info struct */
+#define HG_TEST_INIT_INFO_GARBAGE (0xff)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Init info as laid out by applications built against v2.4 headers */
+struct hg_test_init_info_2_4 {
+    struct na_init_info_4_0 na_init_info;
+    na_class_t *na_class;
+    uint32_t request_post_init;
+    int32_t request_post_incr;
+    uint8_t auto_sm;
+    const char *sm_info_string;
+    hg_checksum_level_t checksum_level;
+    uint8_t no_bulk_eager;
+    uint8_t no_loopback;
+    uint8_t stats;
+    uint8_t no_multi_recv;
+    uint8_t release_input_early;
+    enum na_traffic_class traffic_class;
+    bool no_overflow;
+    unsigned int multi_recv_op_max;
+    unsigned int multi_recv_copy_threshold;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_test_init_info(unsigned int version, const struct hg_init_info *info);
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_init_info(unsigned int version, const struct hg_init_info *info)
+{
+    hg_class_t *hg_class;
+    hg_context_t *context = NULL;
+    hg_return_t ret;
+
+    hg_class = HG_Init_opt2(HG_TEST_INIT_INFO_STRING, HG_TRUE, version, info);
+    HG_TEST_CHECK_ERROR(
+        hg_class == NULL, error, ret, HG_FAULT, "HG_Init_opt2() failed");
+
+    context = HG_Context_create(hg_class);
+    HG_TEST_CHECK_ERROR(context == NULL, error, ret, HG_FAULT,
+        "HG_Context_create() failed");
+
+    ret = HG_Context_destroy(context);
+    context = NULL;
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Context_destroy() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Finalize(hg_class);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Finalize() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    if (context != NULL)
+        (void) HG_Context_destroy(context);
+    if (hg_class != NULL)
+        (void) HG_Finalize(hg_class);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_test_init_info_2_4 *hg_init_info_2_4;
+    char *buf;
+    hg_return_t hg_ret;
+    int ret = EXIT_SUCCESS;
+
+    /* Fields that were appended after v2.4 are garbage, they must be left to
+     * their default values */
+    buf = (char *) malloc(sizeof(struct hg_init_info));
+    HG_TEST_CHECK_ERROR(buf == NULL, done, ret, EXIT_FAILURE,
+        "Could not allocate init info");
+    memset(buf, HG_TEST_INIT_INFO_GARBAGE, sizeof(struct hg_init_info));
+    hg_init_info_2_4 = (struct hg_test_init_info_2_4 *) buf;
+    *hg_init_info_2_4 = (struct hg_test_init_info_2_4){
+        .na_init_info = NA_INIT_INFO_INITIALIZER_4_0,
+        .na_class = NULL,
+        .request_post_init = 0,
+        .request_post_incr = 0,
+        .auto_sm = false,
+        .sm_info_string = NULL,
+        .checksum_level = HG_CHECKSUM_NONE,
+        .no_bulk_eager = false,
+        .no_loopback = false,
+        .stats = false,
+        .no_multi_recv = false,
+        .release_input_early = false,
+        .traffic_class = NA_TC_UNSPEC,
+        .no_overflow = false,
+        .multi_recv_op_max = 0,
+        .multi_recv_copy_threshold = 0};
+
+    HG_TEST("init info v2.4");
+    hg_ret = hg_test_init_info(
+        HG_VERSION(2, 4), (const struct hg_init_info *) hg_init_info_2_4);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "v2.4 init info test failed");
+    HG_PASSED();
+
+    /* Current version reads every field */
+    hg_init_info.rpc_credit_max = 4;
+    hg_init_info.rpc_coalesce_size = 256;
+    HG_TEST("init info current version");
+    hg_ret = hg_test_init_info(
+        HG_VERSION(HG_VERSION_MAJOR, HG_VERSION_MINOR), &hg_init_info);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "current init info test failed");
+    HG_PASSED();
+
+done:
+    if (ret != EXIT_SUCCESS)
+        HG_FAILED();
+    free(buf);
+
+    return ret;
+}
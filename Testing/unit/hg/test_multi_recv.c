@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_unit.h"
+
+#include "mercury_private.h"
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Defaults of posted requests and unexpected message size */
+#define HG_TEST_MULTI_RECV_REQUEST_COUNT (512)
+#define HG_TEST_MULTI_RECV_MSG_SIZE_MAX  (4096)
+#define HG_TEST_MULTI_RECV_MSG_SIZE_INIT (1024)
+
+/* Samples after which the moving average has settled */
+#define HG_TEST_MULTI_RECV_SAMPLES (256)
+
+#define HG_TEST_MULTI_RECV_PACK_SIZE (100)
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_test_multi_recv_bounds(void);
+
+static hg_return_t
+hg_test_multi_recv_resize(void);
+
+static hg_return_t
+hg_test_multi_recv_pack(void);
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_multi_recv_bounds(void)
+{
+    size_t request_count = HG_TEST_MULTI_RECV_REQUEST_COUNT,
+           max_size = HG_TEST_MULTI_RECV_MSG_SIZE_MAX, buf_size;
+    hg_return_t ret;
+
+    /* Never less than two max size messages */
+    buf_size = hg_core_multi_recv_buf_size(request_count, 0, max_size);
+    HG_TEST_CHECK_ERROR(buf_size != 2 * max_size, error, ret, HG_FAULT,
+        "Buffer size is %zu, expected %zu", buf_size, 2 * max_size);
+    buf_size = hg_core_multi_recv_buf_size(request_count, 8, max_size);
+    HG_TEST_CHECK_ERROR(buf_size != 2 * max_size, error, ret, HG_FAULT,
+        "Buffer size is %zu, expected %zu", buf_size, 2 * max_size);
+
+    /* Sized from average message size in between */
+    buf_size = hg_core_multi_recv_buf_size(request_count, 64, max_size);
+    HG_TEST_CHECK_ERROR(buf_size != request_count * 64, error, ret, HG_FAULT,
+        "Buffer size is %zu, expected %zu", buf_size, request_count * 64);
+
+    /* Never more than request_count max size messages */
+    buf_size =
+        hg_core_multi_recv_buf_size(request_count, 2 * max_size, max_size);
+    HG_TEST_CHECK_ERROR(buf_size != request_count * max_size, error, ret,
+        HG_FAULT, "Buffer size is %zu, expected %zu", buf_size,
+        request_count * max_size);
+
+    /* Upper bound wins over lower bound */
+    buf_size = hg_core_multi_recv_buf_size(1, 0, max_size);
+    HG_TEST_CHECK_ERROR(buf_size != max_size, error, ret, HG_FAULT,
+        "Buffer size is %zu, expected %zu", buf_size, max_size);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_multi_recv_resize(void)
+{
+    size_t request_count = HG_TEST_MULTI_RECV_REQUEST_COUNT,
+           max_size = HG_TEST_MULTI_RECV_MSG_SIZE_MAX,
+           msg_size = HG_TEST_MULTI_RECV_MSG_SIZE_INIT, buf_size, new_buf_size;
+    unsigned int i;
+    hg_return_t ret;
+
+    buf_size = hg_core_multi_recv_buf_size(request_count, msg_size, max_size);
+
+    /* A few small messages are not enough to resize on repost */
+    for (i = 0; i < 4; i++)
+        msg_size = hg_core_multi_recv_msg_size_avg(msg_size, 64);
+    new_buf_size =
+        hg_core_multi_recv_buf_size(request_count, msg_size, max_size);
+    HG_TEST_CHECK_ERROR(hg_core_multi_recv_buf_resize(buf_size, new_buf_size),
+        error, ret, HG_FAULT, "Buffer of %zu resized to %zu too early",
+        buf_size, new_buf_size);
+
+    /* Buffer shrinks once small messages dominate */
+    for (i = 0; i < HG_TEST_MULTI_RECV_SAMPLES; i++)
+        msg_size = hg_core_multi_recv_msg_size_avg(msg_size, 64);
+    HG_TEST_CHECK_ERROR(msg_size < 64 || msg_size >= 2 * 64, error, ret,
+        HG_FAULT, "Average message size is %zu, expected 64", msg_size);
+    new_buf_size =
+        hg_core_multi_recv_buf_size(request_count, msg_size, max_size);
+    HG_TEST_CHECK_ERROR(!hg_core_multi_recv_buf_resize(buf_size, new_buf_size),
+        error, ret, HG_FAULT, "Buffer of %zu not resized to %zu", buf_size,
+        new_buf_size);
+    buf_size = new_buf_size;
+
+    /* Resized buffer is stable */
+    for (i = 0; i < HG_TEST_MULTI_RECV_SAMPLES; i++)
+        msg_size = hg_core_multi_recv_msg_size_avg(msg_size, 64);
+    new_buf_size =
+        hg_core_multi_recv_buf_size(request_count, msg_size, max_size);
+    HG_TEST_CHECK_ERROR(hg_core_multi_recv_buf_resize(buf_size, new_buf_size),
+        error, ret, HG_FAULT, "Buffer of %zu resized again to %zu", buf_size,
+        new_buf_size);
+
+    /* Buffer grows back up to its upper bound once messages are max size */
+    for (i = 0; i < HG_TEST_MULTI_RECV_SAMPLES; i++)
+        msg_size = hg_core_multi_recv_msg_size_avg(msg_size, max_size);
+    new_buf_size =
+        hg_core_multi_recv_buf_size(request_count, msg_size, max_size);
+    HG_TEST_CHECK_ERROR(!hg_core_multi_recv_buf_resize(buf_size, new_buf_size),
+        error, ret, HG_FAULT, "Buffer of %zu not resized to %zu", buf_size,
+        new_buf_size);
+    HG_TEST_CHECK_ERROR(new_buf_size > request_count * max_size, error, ret,
+        HG_FAULT, "Buffer of %zu exceeds %zu", new_buf_size,
+        request_count * max_size);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_multi_recv_pack(void)
+{
+    struct hg_core_multi_recv_pack *pack;
+    char *bufs[4] = {NULL, NULL, NULL, NULL};
+    hg_return_t ret;
+    unsigned int i;
+
+    pack = hg_core_multi_recv_pack_create(HG_TEST_MULTI_RECV_PACK_SIZE);
+    HG_TEST_CHECK_ERROR(pack == NULL, error, ret, HG_NOMEM,
+        "hg_core_multi_recv_pack_create() failed");
+
+    /* Payloads are packed back to back at 8-byte boundaries */
+    bufs[0] = (char *) hg_core_multi_recv_pack_get(pack, 10);
+    bufs[1] = (char *) hg_core_multi_recv_pack_get(pack, 10);
+    HG_TEST_CHECK_ERROR(bufs[0] == NULL || bufs[1] != bufs[0] + 16, free, ret,
+        HG_FAULT, "Payloads are not packed");
+
+    /* Payload larger than what is left does not fit */
+    bufs[2] = (char *) hg_core_multi_recv_pack_get(
+        pack, HG_TEST_MULTI_RECV_PACK_SIZE - 32 + 1);
+    HG_TEST_CHECK_ERROR(
+        bufs[2] != NULL, free, ret, HG_FAULT, "Payload exceeds pack buffer");
+
+    /* Payload that fills up what is left */
+    bufs[2] = (char *) hg_core_multi_recv_pack_get(
+        pack, HG_TEST_MULTI_RECV_PACK_SIZE - 32);
+    HG_TEST_CHECK_ERROR(
+        bufs[2] != bufs[0] + 32, free, ret, HG_FAULT, "Payload is not packed");
+    bufs[3] = (char *) hg_core_multi_recv_pack_get(pack, 1);
+    HG_TEST_CHECK_ERROR(
+        bufs[3] != NULL, free, ret, HG_FAULT, "Payload exceeds pack buffer");
+
+    /* Payloads do not overlap */
+    memset(bufs[0], 1, 10);
+    memset(bufs[1], 2, 10);
+    memset(bufs[2], 3, HG_TEST_MULTI_RECV_PACK_SIZE - 32);
+    for (i = 0; i < 10; i++)
+        HG_TEST_CHECK_ERROR(bufs[0][i] != 1 || bufs[1][i] != 2, free, ret,
+            HG_FAULT, "Payloads overlap");
+
+    /* Buffer remains until both the pack and its payloads are released */
+    hg_core_multi_recv_pack_release(pack);
+    for (i = 0; i < 2; i++)
+        hg_core_multi_recv_pack_release(pack);
+    HG_TEST_CHECK_ERROR(bufs[2][0] != 3, error, ret, HG_FAULT,
+        "Pack buffer released with payloads in use");
+    hg_core_multi_recv_pack_release(pack);
+
+    return HG_SUCCESS;
+
+free:
+    hg_core_multi_recv_pack_release(pack);
+    for (i = 0; i < 3; i++)
+        if (bufs[i] != NULL)
+            hg_core_multi_recv_pack_release(pack);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    hg_return_t hg_ret;
+    int ret = EXIT_SUCCESS;
+
+    HG_TEST("multi-recv buffer size bounds");
+    hg_ret = hg_test_multi_recv_bounds();
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "multi-recv buffer size bounds test failed");
+    HG_PASSED();
+
+    HG_TEST("multi-recv buffer resize on repost");
+    hg_ret = hg_test_multi_recv_resize();
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "multi-recv buffer resize test failed");
+    HG_PASSED();
+
+    HG_TEST("multi-recv payload packing");
+    hg_ret = hg_test_multi_recv_pack();
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "multi-recv payload packing test failed");
+    HG_PASSED();
+
+done:
+    if (ret != EXIT_SUCCESS)
+        HG_FAILED();
+
+    return ret;
+}
@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE
+#endif
+#include "mercury_unit.h"
+
+#include "mercury_thread.h"
+
+#include <unistd.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define HG_TEST_NUMA_INFO_STRING "na+sm"
+
+/* NUMA node that does not exist */
+#define HG_TEST_NUMA_NODE_INVALID (4096)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct hg_test_numa_bind_args {
+    const hg_context_t *context;
+    hg_cpu_set_t cpu_mask;
+    hg_return_t ret;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static HG_THREAD_RETURN_TYPE
+hg_test_numa_bind_thread(void *arg);
+
+static hg_return_t
+hg_test_numa_bind(const hg_context_t *context, hg_cpu_set_t *cpu_mask);
+
+static hg_return_t
+hg_test_numa_create(hg_class_t *hg_class, int numa_node, int expected_node,
+    hg_context_t **context_p);
+
+static hg_return_t
+hg_test_numa_node(hg_class_t *hg_class, int numa_node);
+
+static hg_return_t
+hg_test_numa_invalid(hg_class_t *hg_class);
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_numa_bind_thread(void *arg)
+{
+    struct hg_test_numa_bind_args *args =
+        (struct hg_test_numa_bind_args *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+
+    args->ret = HG_Context_bind_thread(args->context);
+    if (args->ret == HG_SUCCESS &&
+        hg_thread_getaffinity(hg_thread_self(), &args->cpu_mask) !=
+            HG_UTIL_SUCCESS)
+        args->ret = HG_PROTOCOL_ERROR;
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_numa_bind(const hg_context_t *context, hg_cpu_set_t *cpu_mask)
+{
+    struct hg_test_numa_bind_args args = {.context = context};
+    hg_thread_t thread;
+    int rc;
+
+    /* Bind a separate thread so that the affinity of this one is kept */
+    rc = hg_thread_create(&thread, hg_test_numa_bind_thread, &args);
+    if (rc != HG_UTIL_SUCCESS)
+        return HG_NOMEM;
+    hg_thread_join(thread);
+
+    if (args.ret == HG_SUCCESS)
+        *cpu_mask = args.cpu_mask;
+
+    return args.ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_numa_create(hg_class_t *hg_class, int numa_node, int expected_node,
+    hg_context_t **context_p)
+{
+    hg_cpu_set_t prev_cpu_mask, cpu_mask, new_cpu_mask;
+    hg_context_t *context;
+    hg_return_t ret;
+    int cpu, rc;
+
+    /* Narrow affinity to one CPU so that binding to a node is visible */
+    rc = hg_thread_getaffinity(hg_thread_self(), &prev_cpu_mask);
+    HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_PROTOCOL_ERROR,
+        "hg_thread_getaffinity() failed");
+    CPU_ZERO(&cpu_mask);
+    for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &prev_cpu_mask)) {
+            CPU_SET(cpu, &cpu_mask);
+            break;
+        }
+    }
+    rc = hg_thread_setaffinity(hg_thread_self(), &cpu_mask);
+    HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_PROTOCOL_ERROR,
+        "hg_thread_setaffinity() failed");
+
+    context = HG_Context_create_id_numa(hg_class, 0, numa_node);
+
+    /* Affinity is restored once resources are allocated */
+    rc = hg_thread_getaffinity(hg_thread_self(), &new_cpu_mask);
+    (void) hg_thread_setaffinity(hg_thread_self(), &prev_cpu_mask);
+    HG_TEST_CHECK_ERROR(context == NULL, error, ret, HG_FAULT,
+        "HG_Context_create_id_numa() failed");
+    HG_TEST_CHECK_ERROR(
+        rc != HG_UTIL_SUCCESS || !CPU_EQUAL(&cpu_mask, &new_cpu_mask), destroy,
+        ret, HG_FAULT, "Affinity was not restored");
+
+    HG_TEST_CHECK_ERROR(context->numa_node != expected_node, destroy, ret,
+        HG_FAULT, "Context NUMA node is %d, expected %d", context->numa_node,
+        expected_node);
+
+    *context_p = context;
+
+    return HG_SUCCESS;
+
+destroy:
+    (void) HG_Context_destroy(context);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_numa_node(hg_class_t *hg_class, int numa_node)
+{
+    hg_cpu_set_t node_cpu_mask, cpu_mask, and_cpu_mask;
+    hg_context_t *context = NULL;
+    hg_return_t ret;
+    int rc;
+
+    rc = hg_thread_numa_node_cpus(numa_node, &node_cpu_mask);
+    HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_NOENTRY,
+        "hg_thread_numa_node_cpus() failed");
+
+    ret = hg_test_numa_create(hg_class, numa_node, numa_node, &context);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_numa_create() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Bound thread only runs on CPUs of that node */
+    ret = hg_test_numa_bind(context, &cpu_mask);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Context_bind_thread() failed (%s)",
+        HG_Error_to_string(ret));
+    CPU_AND(&and_cpu_mask, &cpu_mask, &node_cpu_mask);
+    HG_TEST_CHECK_ERROR(CPU_COUNT(&cpu_mask) == 0 ||
+                            !CPU_EQUAL(&and_cpu_mask, &cpu_mask),
+        error, ret, HG_FAULT, "Thread is not bound to NUMA node %d",
+        numa_node);
+
+    ret = HG_Context_destroy(context);
+    context = NULL;
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Context_destroy() failed (%s)",
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    if (context != NULL)
+        (void) HG_Context_destroy(context);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_numa_invalid(hg_class_t *hg_class)
+{
+    hg_cpu_set_t cpu_mask;
+    hg_context_t *context = NULL;
+    hg_return_t ret;
+
+    /* Context is created without placement on a node that does not exist */
+    ret = hg_test_numa_create(hg_class, HG_TEST_NUMA_NODE_INVALID,
+        HG_TEST_NUMA_NODE_INVALID, &context);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_numa_create() failed (%s)",
+        HG_Error_to_string(ret));
+    ret = hg_test_numa_bind(context, &cpu_mask);
+    HG_TEST_CHECK_ERROR(ret == HG_SUCCESS, error, ret, HG_FAULT,
+        "Thread bound to NUMA node %d", HG_TEST_NUMA_NODE_INVALID);
+    ret = HG_Context_destroy(context);
+    context = NULL;
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Context_destroy() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* SM does not know the node of a NIC */
+    ret = hg_test_numa_create(
+        hg_class, HG_NUMA_NODE_NIC, HG_NUMA_NODE_ANY, &context);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "hg_test_numa_create() failed (%s)",
+        HG_Error_to_string(ret));
+    ret = hg_test_numa_bind(context, &cpu_mask);
+    HG_TEST_CHECK_ERROR(ret != HG_NOENTRY, error, ret, HG_FAULT,
+        "HG_Context_bind_thread() returned %s, expected %s",
+        HG_Error_to_string(ret), HG_Error_to_string(HG_NOENTRY));
+    ret = HG_Context_destroy(context);
+    context = NULL;
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Context_destroy() failed (%s)",
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    if (context != NULL)
+        (void) HG_Context_destroy(context);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    hg_class_t *hg_class;
+    hg_return_t hg_ret;
+    int ret = EXIT_SUCCESS;
+
+    hg_class = HG_Init(HG_TEST_NUMA_INFO_STRING, HG_TRUE);
+    HG_TEST_CHECK_ERROR(
+        hg_class == NULL, done, ret, EXIT_FAILURE, "HG_Init() failed");
+
+    /* Node 0 has CPUs on systems that expose NUMA nodes */
+    if (access("/sys/devices/system/node/node0", F_OK) == 0) {
+        HG_TEST("context placed on NUMA node 0");
+        hg_ret = hg_test_numa_node(hg_class, 0);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "NUMA node 0 test failed");
+        HG_PASSED();
+    } else
+        printf("No NUMA node information, skipping NUMA node 0 test\n");
+
+    HG_TEST("context placed on unknown NUMA node");
+    hg_ret = hg_test_numa_invalid(hg_class);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "unknown NUMA node test failed");
+    HG_PASSED();
+
+done:
+    if (ret != EXIT_SUCCESS)
+        HG_FAILED();
+    if (hg_class != NULL)
+        (void) HG_Finalize(hg_class);
+
+    return ret;
+}
@@ -14,6 +14,36 @@
 /* Wait timeout in ms */
 #define HG_TEST_WAIT_TIMEOUT (HG_TEST_TIMEOUT * 1000)
 
+/* Retry-after hint returned by busy target */
+#define HG_TEST_BUSY_RETRY_MS (10)
+
+/* Max length of in-process target info and address strings */
+#define HG_TEST_LOCAL_STRING_MAX (256)
+
+/* Time during which an RPC is expected not to make progress */
+#define HG_TEST_IDLE_WAIT_MS (100)
+
+/* Deadline of RPCs that are expected to expire */
+#define HG_TEST_DEADLINE_MS (50)
+
+/* Forwards needed before the hedging delay is known */
+#define HG_TEST_HEDGE_SAMPLES (32)
+
+/* Origins that successively send to the same target, enough for the target
+ * to recycle source addresses of previous origins */
+#define HG_TEST_SRC_ADDR_ORIGINS (8)
+
+/* Number of forwards packed into a single batch */
+#define HG_TEST_COALESCE_COUNT (4)
+
+/* Time during which coalesced forwards wait for the batch to fill up */
+#define HG_TEST_COALESCE_MS (HG_TEST_IDLE_WAIT_MS * 5)
+
+/* Unexpected messages needed to go through every multi-recv buffer of the
+ * target several times (default of 512 posted requests per buffer, 4 buffers)
+ */
+#define HG_TEST_MULTI_RECV_COUNT (512 * 4 * 4)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -40,6 +70,35 @@ struct forward_no_req_cb_args {
     hg_return_t ret;
 };
 
+struct forward_priority_cb_args {
+    hg_id_t *rpc_ids;     /* RPC IDs in trigger order */
+    size_t trigger_count; /* Triggered count */
+    hg_return_t ret;      /* First error */
+};
+
+struct forward_hold_cb_args {
+    hg_atomic_int32_t done; /* Forward completed */
+    hg_return_t ret;        /* Forward return code */
+    unsigned int retry_ms;  /* Retry-after hint */
+};
+
+struct hg_test_hold_target {
+    hg_atomic_int32_t received; /* Requests that reached the handler */
+    hg_handle_t held_handle;    /* Request held without response */
+    bool hold;                  /* Hold next request */
+};
+
+/* In-process target and origin classes that use the same plugin */
+struct hg_test_local_pair {
+    hg_class_t *target_class;      /* Target class */
+    hg_context_t *target_context;  /* Target context */
+    hg_class_t *origin_class;      /* Origin class */
+    hg_context_t *origin_context;  /* Origin context */
+    hg_addr_t self_addr;           /* Target self address */
+    hg_addr_t target_addr;         /* Target address looked up by origin */
+    hg_id_t rpc_id;                /* Held RPC registered on both classes */
+};
+
 struct hg_test_multi_thread {
     struct hg_unit_info *info;
     hg_thread_t thread;
@@ -86,6 +145,63 @@ hg_test_rpc_multi(hg_handle_t *handles, size_t handle_max, hg_addr_t addr,
 static hg_return_t
 hg_test_rpc_multi_cb(const struct hg_cb_info *callback_info);
 
+static hg_return_t
+hg_test_rpc_priority(hg_context_t *context, hg_handle_t *handles,
+    size_t handle_max, hg_addr_t addr);
+
+static hg_return_t
+hg_test_rpc_priority_cb(const struct hg_cb_info *callback_info);
+
+static hg_class_t *
+hg_test_rpc_local_init(hg_class_t *hg_class, bool listen, bool busy_wait,
+    struct hg_init_info *hg_init_info);
+
+static hg_return_t
+hg_test_rpc_local_pair_init(hg_class_t *hg_class, bool busy_wait,
+    const char *rpc_name, struct hg_test_hold_target *hold_target,
+    struct hg_init_info *target_init_info,
+    struct hg_init_info *origin_init_info, struct hg_test_local_pair *pair);
+
+static void
+hg_test_rpc_local_pair_finalize(struct hg_test_local_pair *pair);
+
+static hg_return_t
+hg_test_rpc_local_origin_init(hg_class_t *hg_class, bool busy_wait,
+    const char *rpc_name, struct hg_init_info *origin_init_info,
+    struct hg_test_local_pair *pair);
+
+static void
+hg_test_rpc_local_origin_finalize(struct hg_test_local_pair *pair);
+
+static hg_return_t
+hg_test_rpc_busy(hg_class_t *hg_class, bool busy_wait);
+
+static hg_return_t
+hg_test_rpc_credit(hg_class_t *hg_class, bool busy_wait);
+
+static hg_return_t
+hg_test_rpc_coalesce(
+    hg_class_t *hg_class, bool busy_wait, bool coalesce_responses);
+
+static hg_return_t
+hg_test_rpc_deadline(hg_class_t *hg_class, bool busy_wait);
+
+static hg_return_t
+hg_test_rpc_src_addr(hg_class_t *hg_class, bool busy_wait);
+
+static hg_return_t
+hg_test_rpc_hold_forward(hg_handle_t handle, struct forward_hold_cb_args *args);
+
+static hg_return_t
+hg_test_rpc_hold_wait(hg_context_t *context, hg_context_t *target_context,
+    hg_atomic_int32_t *counter, int32_t value, unsigned int timeout_ms);
+
+static hg_return_t
+hg_test_rpc_hold_cb(const struct hg_cb_info *callback_info);
+
+static hg_return_t
+hg_test_rpc_hold_target_cb(hg_handle_t handle);
+
 static hg_return_t
 hg_test_rpc_launch_threads(struct hg_unit_info *info, hg_thread_func_t func);
 
@@ -116,6 +232,7 @@ hg_test_rpc_no_req_create_cb(const struct hg_cb_info *callback_info);
 /*******************/
 
 extern hg_id_t hg_test_rpc_null_id_g;
+extern hg_id_t hg_test_rpc_null_high_id_g;
 extern hg_id_t hg_test_rpc_open_id_g;
 extern hg_id_t hg_test_rpc_open_id_no_resp_g;
 extern hg_id_t hg_test_overflow_id_g;
@@ -559,6 +676,950 @@ done:
     return HG_SUCCESS;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_priority(hg_context_t *context, hg_handle_t *handles,
+    size_t handle_max, hg_addr_t addr)
+{
+    struct forward_priority_cb_args forward_cb_args = {
+        .rpc_ids = NULL, .trigger_count = 0, .ret = HG_SUCCESS};
+    hg_time_t deadline, now;
+    unsigned int count = 0;
+    hg_return_t ret;
+    size_t i;
+
+    HG_TEST_CHECK_ERROR(handle_max < 2, error, ret, HG_INVALID_PARAM,
+        "Handle max must be at least 2");
+
+    forward_cb_args.rpc_ids = (hg_id_t *) calloc(handle_max, sizeof(hg_id_t));
+    HG_TEST_CHECK_ERROR(forward_cb_args.rpc_ids == NULL, error, ret, HG_NOMEM,
+        "Could not allocate array of RPC IDs");
+
+    /* Forward default priority RPCs first and the high priority one last */
+    for (i = 0; i < handle_max; i++) {
+        hg_id_t rpc_id = (i < handle_max - 1) ? hg_test_rpc_null_id_g
+                                              : hg_test_rpc_null_high_id_g;
+
+        ret = HG_Reset(handles[i], addr, rpc_id);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Reset() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Forward(
+            handles[i], hg_test_rpc_priority_cb, &forward_cb_args, NULL);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Wait for all completions to be queued before triggering any */
+    hg_time_get_current_ms(&deadline);
+    deadline = hg_time_add(deadline, hg_time_from_ms(HG_TEST_WAIT_TIMEOUT));
+    do {
+        ret = HG_Event_progress(context, &count);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Event_progress() failed (%s)",
+            HG_Error_to_string(ret));
+
+        hg_time_get_current_ms(&now);
+        HG_TEST_CHECK_ERROR(count < handle_max && hg_time_less(deadline, now),
+            error, ret, HG_TIMEOUT, "Timed out waiting for completions");
+    } while (count < handle_max);
+
+    /* Trigger one callback at a time */
+    while (forward_cb_args.trigger_count < handle_max) {
+        unsigned int actual_count = 0;
+
+        ret = HG_Trigger(context, 0, 1, &actual_count);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    ret = forward_cb_args.ret;
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+    HG_TEST_CHECK_ERROR(
+        forward_cb_args.rpc_ids[0] != hg_test_rpc_null_high_id_g, error, ret,
+        HG_FAULT, "High priority RPC was not triggered first");
+    for (i = 1; i < handle_max; i++)
+        HG_TEST_CHECK_ERROR(forward_cb_args.rpc_ids[i] != hg_test_rpc_null_id_g,
+            error, ret, HG_FAULT,
+            "Default priority RPC was not triggered in order (%zu)", i);
+
+    free(forward_cb_args.rpc_ids);
+
+    return HG_SUCCESS;
+
+error:
+    free(forward_cb_args.rpc_ids);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_priority_cb(const struct hg_cb_info *callback_info)
+{
+    struct forward_priority_cb_args *args =
+        (struct forward_priority_cb_args *) callback_info->arg;
+    const struct hg_info *hg_info =
+        HG_Get_info(callback_info->info.forward.handle);
+
+    if (callback_info->ret != HG_SUCCESS && args->ret == HG_SUCCESS)
+        args->ret = callback_info->ret;
+    args->rpc_ids[args->trigger_count++] = hg_info->id;
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_class_t *
+hg_test_rpc_local_init(hg_class_t *hg_class, bool listen, bool busy_wait,
+    struct hg_init_info *hg_init_info)
+{
+    char info_string[HG_TEST_LOCAL_STRING_MAX];
+    hg_class_t *local_class;
+    int rc;
+
+    /* In-process class that uses the same plugin as hg_class */
+    rc = snprintf(info_string, sizeof(info_string), "%s+%s",
+        HG_Class_get_name(hg_class), HG_Class_get_protocol(hg_class));
+    HG_TEST_CHECK_ERROR_NORET(rc < 0 || rc >= (int) sizeof(info_string),
+        error, "snprintf() failed, rc: %d", rc);
+
+    /* Origin does not signal targets that do not use the same mode */
+    if (busy_wait)
+        hg_init_info->na_init_info.progress_mode = NA_NO_BLOCK;
+    local_class = HG_Init_opt2(info_string, listen,
+        HG_VERSION(HG_VERSION_MAJOR, HG_VERSION_MINOR), hg_init_info);
+    HG_TEST_CHECK_ERROR_NORET(
+        local_class == NULL, error, "HG_Init_opt2() failed");
+
+    return local_class;
+
+error:
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_local_pair_init(hg_class_t *hg_class, bool busy_wait,
+    const char *rpc_name, struct hg_test_hold_target *hold_target,
+    struct hg_init_info *target_init_info,
+    struct hg_init_info *origin_init_info, struct hg_test_local_pair *pair)
+{
+    hg_id_t rpc_id;
+    hg_return_t ret;
+
+    *pair = (struct hg_test_local_pair){.target_class = NULL,
+        .target_context = NULL,
+        .origin_class = NULL,
+        .origin_context = NULL,
+        .self_addr = HG_ADDR_NULL,
+        .target_addr = HG_ADDR_NULL,
+        .rpc_id = 0};
+
+    pair->target_class =
+        hg_test_rpc_local_init(hg_class, true, busy_wait, target_init_info);
+    HG_TEST_CHECK_ERROR(pair->target_class == NULL, error, ret, HG_FAULT,
+        "hg_test_rpc_local_init() failed");
+
+    pair->target_context = HG_Context_create(pair->target_class);
+    HG_TEST_CHECK_ERROR(pair->target_context == NULL, error, ret, HG_FAULT,
+        "HG_Context_create() failed");
+
+    rpc_id = MERCURY_REGISTER(
+        pair->target_class, rpc_name, void, void, hg_test_rpc_hold_target_cb);
+    HG_TEST_CHECK_ERROR(
+        rpc_id == 0, error, ret, HG_FAULT, "HG_Register() failed");
+
+    ret = HG_Register_data(pair->target_class, rpc_id, hold_target, NULL);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Register_data() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Addr_self(pair->target_class, &pair->self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_self() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_local_origin_init(
+        hg_class, busy_wait, rpc_name, origin_init_info, pair);
+    HG_TEST_CHECK_HG_ERROR(error, ret,
+        "hg_test_rpc_local_origin_init() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    hg_test_rpc_local_pair_finalize(pair);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_rpc_local_pair_finalize(struct hg_test_local_pair *pair)
+{
+    hg_test_rpc_local_origin_finalize(pair);
+    if (pair->self_addr != HG_ADDR_NULL) {
+        (void) HG_Addr_free(pair->target_class, pair->self_addr);
+        pair->self_addr = HG_ADDR_NULL;
+    }
+    if (pair->target_context != NULL) {
+        (void) HG_Context_destroy(pair->target_context);
+        pair->target_context = NULL;
+    }
+    if (pair->target_class != NULL) {
+        (void) HG_Finalize(pair->target_class);
+        pair->target_class = NULL;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_local_origin_init(hg_class_t *hg_class, bool busy_wait,
+    const char *rpc_name, struct hg_init_info *origin_init_info,
+    struct hg_test_local_pair *pair)
+{
+    char addr_string[HG_TEST_LOCAL_STRING_MAX];
+    hg_size_t addr_string_len = sizeof(addr_string);
+    hg_return_t ret;
+
+    pair->origin_class =
+        hg_test_rpc_local_init(hg_class, false, busy_wait, origin_init_info);
+    HG_TEST_CHECK_ERROR(pair->origin_class == NULL, error, ret, HG_FAULT,
+        "hg_test_rpc_local_init() failed");
+
+    pair->origin_context = HG_Context_create(pair->origin_class);
+    HG_TEST_CHECK_ERROR(pair->origin_context == NULL, error, ret, HG_FAULT,
+        "HG_Context_create() failed");
+
+    pair->rpc_id =
+        MERCURY_REGISTER(pair->origin_class, rpc_name, void, void, NULL);
+    HG_TEST_CHECK_ERROR(
+        pair->rpc_id == 0, error, ret, HG_FAULT, "HG_Register() failed");
+
+    ret = HG_Addr_to_string(
+        pair->target_class, addr_string, &addr_string_len, pair->self_addr);
+    HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Addr_to_string() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Addr_lookup2(pair->origin_class, addr_string, &pair->target_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Addr_lookup2() failed (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    hg_test_rpc_local_origin_finalize(pair);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_rpc_local_origin_finalize(struct hg_test_local_pair *pair)
+{
+    if (pair->target_addr != HG_ADDR_NULL) {
+        (void) HG_Addr_free(pair->origin_class, pair->target_addr);
+        pair->target_addr = HG_ADDR_NULL;
+    }
+    if (pair->origin_context != NULL) {
+        (void) HG_Context_destroy(pair->origin_context);
+        pair->origin_context = NULL;
+    }
+    if (pair->origin_class != NULL) {
+        (void) HG_Finalize(pair->origin_class);
+        pair->origin_class = NULL;
+    }
+    pair->rpc_id = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_busy(hg_class_t *hg_class, bool busy_wait)
+{
+    struct hg_init_info target_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_init_info origin_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_test_hold_target busy_target = {.received =
+                                                  HG_ATOMIC_VAR_INIT(0),
+        .held_handle = HG_HANDLE_NULL,
+        .hold = true};
+    struct forward_hold_cb_args forward_cb_args[2];
+    struct hg_test_local_pair pair;
+    hg_context_t *context, *target_context;
+    hg_handle_t handles[2] = {HG_HANDLE_NULL, HG_HANDLE_NULL};
+    hg_return_t ret;
+    int i;
+
+    /* Target that admits a single RPC at a time */
+    target_init_info.rpc_active_max = 1;
+    target_init_info.busy_retry_ms = HG_TEST_BUSY_RETRY_MS;
+    ret = hg_test_rpc_local_pair_init(hg_class, busy_wait, "hg_test_rpc_busy",
+        &busy_target, &target_init_info, &origin_init_info, &pair);
+    HG_TEST_CHECK_HG_ERROR(error, ret,
+        "hg_test_rpc_local_pair_init() failed (%s)", HG_Error_to_string(ret));
+    context = pair.origin_context;
+    target_context = pair.target_context;
+
+    for (i = 0; i < 2; i++) {
+        ret = HG_Create(context, pair.target_addr, pair.rpc_id, &handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* First RPC is admitted and held by the target */
+    ret = hg_test_rpc_hold_forward(handles[0], &forward_cb_args[0]);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(context, target_context,
+        &busy_target.received, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Second RPC is turned away while the first one is active */
+    ret = hg_test_rpc_hold_forward(handles[1], &forward_cb_args[1]);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(context, target_context,
+        &forward_cb_args[1].done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    HG_TEST_CHECK_ERROR(forward_cb_args[1].ret != HG_BUSY, done, ret,
+        HG_FAULT, "RPC was not rejected (%s)",
+        HG_Error_to_string(forward_cb_args[1].ret));
+    HG_TEST_CHECK_ERROR(forward_cb_args[1].retry_ms != HG_TEST_BUSY_RETRY_MS,
+        done, ret, HG_FAULT, "Unexpected retry-after hint (%u)",
+        forward_cb_args[1].retry_ms);
+    HG_TEST_CHECK_ERROR(hg_atomic_get32(&busy_target.received) != 1, done,
+        ret, HG_FAULT, "Rejected RPC reached its handler");
+
+    /* Completing the first RPC releases its slot */
+    ret = HG_Respond(busy_target.held_handle, NULL, NULL, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Destroy(busy_target.held_handle);
+    busy_target.held_handle = HG_HANDLE_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(context, target_context,
+        &forward_cb_args[0].done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = forward_cb_args[0].ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+    /* Retry is now admitted */
+    ret = hg_test_rpc_hold_forward(handles[1], &forward_cb_args[1]);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(context, target_context,
+        &forward_cb_args[1].done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = forward_cb_args[1].ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(hg_atomic_get32(&busy_target.received) != 2, done,
+        ret, HG_FAULT, "Retried RPC did not reach its handler");
+
+done:
+    if (busy_target.held_handle != HG_HANDLE_NULL)
+        (void) HG_Destroy(busy_target.held_handle);
+    for (i = 0; i < 2; i++)
+        if (handles[i] != HG_HANDLE_NULL)
+            (void) HG_Destroy(handles[i]);
+    hg_test_rpc_local_pair_finalize(&pair);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_credit(hg_class_t *hg_class, bool busy_wait)
+{
+    struct hg_init_info target_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_init_info origin_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_test_hold_target hold_target = {.received =
+                                                  HG_ATOMIC_VAR_INIT(0),
+        .held_handle = HG_HANDLE_NULL,
+        .hold = true};
+    struct forward_hold_cb_args forward_cb_args[3];
+    struct hg_test_local_pair pair;
+    hg_context_t *origin_context, *target_context;
+    hg_handle_t handles[3] = {HG_HANDLE_NULL, HG_HANDLE_NULL, HG_HANDLE_NULL};
+    hg_return_t ret;
+    int i;
+
+    /* Target without admission limit, origin that keeps a single forward in
+     * flight per target */
+    origin_init_info.rpc_credit_max = 1;
+    ret = hg_test_rpc_local_pair_init(hg_class, busy_wait,
+        "hg_test_rpc_credit", &hold_target, &target_init_info,
+        &origin_init_info, &pair);
+    HG_TEST_CHECK_HG_ERROR(error, ret,
+        "hg_test_rpc_local_pair_init() failed (%s)", HG_Error_to_string(ret));
+    origin_context = pair.origin_context;
+    target_context = pair.target_context;
+
+    for (i = 0; i < 3; i++) {
+        ret = HG_Create(
+            origin_context, pair.target_addr, pair.rpc_id, &handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* First RPC takes the only credit and is held by the target */
+    ret = hg_test_rpc_hold_forward(handles[0], &forward_cb_args[0]);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &hold_target.received, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Next RPCs stay queued on the origin until a credit is released */
+    for (i = 1; i < 3; i++) {
+        ret = hg_test_rpc_hold_forward(handles[i], &forward_cb_args[i]);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &hold_target.received, 2, HG_TEST_IDLE_WAIT_MS);
+    HG_TEST_CHECK_ERROR(ret != HG_TIMEOUT, done, ret, HG_FAULT,
+        "RPC beyond credit limit was not queued");
+    HG_TEST_CHECK_ERROR(hg_atomic_get32(&forward_cb_args[1].done) != 0, done,
+        ret, HG_FAULT, "RPC beyond credit limit completed");
+
+    /* Canceling a queued RPC completes it without sending it */
+    ret = HG_Cancel(handles[2]);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Cancel() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &forward_cb_args[2].done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(forward_cb_args[2].ret != HG_CANCELED, done, ret,
+        HG_FAULT, "Queued RPC was not canceled (%s)",
+        HG_Error_to_string(forward_cb_args[2].ret));
+
+    /* Completing the first RPC releases its credit to the queued one */
+    ret = HG_Respond(hold_target.held_handle, NULL, NULL, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Destroy(hold_target.held_handle);
+    hold_target.held_handle = HG_HANDLE_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 0; i < 2; i++) {
+        ret = hg_test_rpc_hold_wait(origin_context, target_context,
+            &forward_cb_args[i].done, 1, HG_TEST_WAIT_TIMEOUT);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_wait() failed (%s)", HG_Error_to_string(ret));
+
+        ret = forward_cb_args[i].ret;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+    }
+    HG_TEST_CHECK_ERROR(hg_atomic_get32(&hold_target.received) != 2, done,
+        ret, HG_FAULT, "Unexpected number of RPCs reached their handler");
+
+done:
+    if (hold_target.held_handle != HG_HANDLE_NULL)
+        (void) HG_Destroy(hold_target.held_handle);
+    for (i = 0; i < 3; i++)
+        if (handles[i] != HG_HANDLE_NULL)
+            (void) HG_Destroy(handles[i]);
+    hg_test_rpc_local_pair_finalize(&pair);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_coalesce(
+    hg_class_t *hg_class, bool busy_wait, bool coalesce_responses)
+{
+    struct hg_init_info target_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_init_info origin_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_test_hold_target hold_target = {.received =
+                                                  HG_ATOMIC_VAR_INIT(0),
+        .held_handle = HG_HANDLE_NULL,
+        .hold = true};
+    struct forward_hold_cb_args forward_cb_args[HG_TEST_COALESCE_COUNT];
+    struct hg_test_local_pair pair;
+    hg_context_t *origin_context, *target_context;
+    hg_handle_t handles[HG_TEST_COALESCE_COUNT];
+    hg_return_t ret;
+    int i;
+
+    for (i = 0; i < HG_TEST_COALESCE_COUNT; i++)
+        handles[i] = HG_HANDLE_NULL;
+
+    /* Origin that packs small forwards to the same target together */
+    origin_init_info.rpc_coalesce_size = HG_TEST_LOCAL_STRING_MAX;
+    origin_init_info.rpc_coalesce_ms = HG_TEST_COALESCE_MS;
+    origin_init_info.rpc_coalesce_responses = coalesce_responses;
+    ret = hg_test_rpc_local_pair_init(hg_class, busy_wait,
+        "hg_test_rpc_coalesce", &hold_target, &target_init_info,
+        &origin_init_info, &pair);
+    HG_TEST_CHECK_HG_ERROR(error, ret,
+        "hg_test_rpc_local_pair_init() failed (%s)", HG_Error_to_string(ret));
+    origin_context = pair.origin_context;
+    target_context = pair.target_context;
+
+    for (i = 0; i < HG_TEST_COALESCE_COUNT; i++) {
+        ret = HG_Create(
+            origin_context, pair.target_addr, pair.rpc_id, &handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+        ret = hg_test_rpc_hold_forward(handles[i], &forward_cb_args[i]);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Forwards wait on the origin for the batch window to close */
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &hold_target.received, 1, HG_TEST_IDLE_WAIT_MS);
+    HG_TEST_CHECK_ERROR(ret != HG_TIMEOUT, done, ret, HG_FAULT,
+        "Forward was sent before batch window closed");
+
+    /* Batch is split on the target and each request reaches its handler */
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &hold_target.received, HG_TEST_COALESCE_COUNT, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Held request does not prevent the others from being answered */
+    for (i = 1; i < HG_TEST_COALESCE_COUNT; i++) {
+        ret = hg_test_rpc_hold_wait(origin_context, target_context,
+            &forward_cb_args[i].done, 1, HG_TEST_WAIT_TIMEOUT);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_wait() failed (%s)", HG_Error_to_string(ret));
+
+        ret = forward_cb_args[i].ret;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+    }
+    HG_TEST_CHECK_ERROR(hg_atomic_get32(&forward_cb_args[0].done) != 0, done,
+        ret, HG_FAULT, "Held RPC completed");
+
+    ret = HG_Respond(hold_target.held_handle, NULL, NULL, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Destroy(hold_target.held_handle);
+    hold_target.held_handle = HG_HANDLE_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &forward_cb_args[0].done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = forward_cb_args[0].ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+done:
+    if (hold_target.held_handle != HG_HANDLE_NULL)
+        (void) HG_Destroy(hold_target.held_handle);
+    for (i = 0; i < HG_TEST_COALESCE_COUNT; i++)
+        if (handles[i] != HG_HANDLE_NULL)
+            (void) HG_Destroy(handles[i]);
+    hg_test_rpc_local_pair_finalize(&pair);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_deadline(hg_class_t *hg_class, bool busy_wait)
+{
+    struct hg_init_info target_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_init_info origin_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_test_hold_target hold_target = {.received =
+                                                  HG_ATOMIC_VAR_INIT(0),
+        .held_handle = HG_HANDLE_NULL,
+        .hold = false};
+    struct forward_hold_cb_args forward_cb_args;
+    struct hg_test_local_pair pair;
+    hg_context_t *origin_context, *target_context;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_time_t deadline, now;
+    hg_return_t ret;
+    int i;
+
+    ret = hg_test_rpc_local_pair_init(hg_class, busy_wait,
+        "hg_test_rpc_deadline", &hold_target, &target_init_info,
+        &origin_init_info, &pair);
+    HG_TEST_CHECK_HG_ERROR(error, ret,
+        "hg_test_rpc_local_pair_init() failed (%s)", HG_Error_to_string(ret));
+    origin_context = pair.origin_context;
+    target_context = pair.target_context;
+
+    ret = HG_Create(origin_context, pair.target_addr, pair.rpc_id, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Set_timeout(handle, HG_TEST_DEADLINE_MS);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Set_timeout() failed (%s)", HG_Error_to_string(ret));
+
+    /* RPC that gets no response completes with a timeout */
+    hold_target.hold = true;
+    ret = hg_test_rpc_hold_forward(handle, &forward_cb_args);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &forward_cb_args.done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(forward_cb_args.ret != HG_TIMEOUT, done, ret,
+        HG_FAULT, "RPC did not time out (%s)",
+        HG_Error_to_string(forward_cb_args.ret));
+
+    ret = HG_Respond(hold_target.held_handle, NULL, NULL, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Destroy(hold_target.held_handle);
+    hold_target.held_handle = HG_HANDLE_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    /* RPC that expires after it was received by the target, but before it
+     * was triggered, does not reach its handler */
+    ret = hg_test_rpc_hold_forward(handle, &forward_cb_args);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+    hg_time_get_current_ms(&deadline);
+    deadline = hg_time_add(deadline, hg_time_from_ms(2 * HG_TEST_DEADLINE_MS));
+    do {
+        ret = HG_Progress(target_context, 0);
+        HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+            done, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+        hg_time_get_current_ms(&now);
+    } while (hg_time_less(now, deadline));
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &forward_cb_args.done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(forward_cb_args.ret != HG_TIMEOUT, done, ret,
+        HG_FAULT, "RPC did not time out (%s)",
+        HG_Error_to_string(forward_cb_args.ret));
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &hold_target.received, 2, HG_TEST_IDLE_WAIT_MS);
+    HG_TEST_CHECK_ERROR(ret != HG_TIMEOUT, done, ret, HG_FAULT,
+        "Expired RPC reached its handler");
+
+    /* Hedged RPCs record latencies until the hedging delay is known */
+    ret = HG_Set_timeout(handle, 0);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Set_timeout() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Set_hedge(handle, pair.target_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Set_hedge() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 0; i < HG_TEST_HEDGE_SAMPLES; i++) {
+        ret = hg_test_rpc_hold_forward(handle, &forward_cb_args);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+        ret = hg_test_rpc_hold_wait(origin_context, target_context,
+            &forward_cb_args.done, 1, HG_TEST_WAIT_TIMEOUT);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_wait() failed (%s)", HG_Error_to_string(ret));
+
+        ret = forward_cb_args.ret;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+    }
+    HG_TEST_CHECK_ERROR(
+        hg_atomic_get32(&hold_target.received) != 1 + HG_TEST_HEDGE_SAMPLES,
+        done, ret, HG_FAULT, "Unexpected number of RPCs reached their handler");
+
+    /* Slow RPC is duplicated and completes with the response of the
+     * duplicate */
+    hold_target.hold = true;
+    ret = hg_test_rpc_hold_forward(handle, &forward_cb_args);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &forward_cb_args.done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = forward_cb_args.ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(
+        hg_atomic_get32(&hold_target.received) != 3 + HG_TEST_HEDGE_SAMPLES,
+        done, ret, HG_FAULT, "Slow RPC was not duplicated");
+
+    ret = HG_Respond(hold_target.held_handle, NULL, NULL, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Destroy(hold_target.held_handle);
+    hold_target.held_handle = HG_HANDLE_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    /* Handle can be forwarded again once duplicate has completed */
+    ret = HG_Set_hedge(handle, HG_ADDR_NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Set_hedge() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_forward(handle, &forward_cb_args);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = hg_test_rpc_hold_wait(origin_context, target_context,
+        &forward_cb_args.done, 1, HG_TEST_WAIT_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_rpc_hold_wait() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = forward_cb_args.ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+done:
+    if (hold_target.held_handle != HG_HANDLE_NULL)
+        (void) HG_Destroy(hold_target.held_handle);
+    if (handle != HG_HANDLE_NULL)
+        (void) HG_Destroy(handle);
+    hg_test_rpc_local_pair_finalize(&pair);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_src_addr(hg_class_t *hg_class, bool busy_wait)
+{
+    struct hg_init_info target_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_init_info origin_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_test_hold_target hold_target = {.received =
+                                                  HG_ATOMIC_VAR_INIT(0),
+        .held_handle = HG_HANDLE_NULL,
+        .hold = false};
+    struct forward_hold_cb_args forward_cb_args;
+    struct hg_test_local_pair pair;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_addr_t origin_addr = HG_ADDR_NULL;
+    hg_return_t ret;
+    int i;
+
+    ret = hg_test_rpc_local_pair_init(hg_class, busy_wait,
+        "hg_test_rpc_src_addr", &hold_target, &target_init_info,
+        &origin_init_info, &pair);
+    HG_TEST_CHECK_HG_ERROR(error, ret,
+        "hg_test_rpc_local_pair_init() failed (%s)", HG_Error_to_string(ret));
+
+    /* Each origin goes away once it got its response, the target must not
+     * report the source address of a previous origin for the next one */
+    for (i = 0; i < HG_TEST_SRC_ADDR_ORIGINS; i++) {
+        char origin_string[HG_TEST_LOCAL_STRING_MAX],
+            src_string[HG_TEST_LOCAL_STRING_MAX];
+        hg_size_t origin_string_len = sizeof(origin_string),
+                  src_string_len = sizeof(src_string);
+
+        if (i > 0) {
+            hg_test_rpc_local_origin_finalize(&pair);
+            ret = hg_test_rpc_local_origin_init(hg_class, busy_wait,
+                "hg_test_rpc_src_addr", &origin_init_info, &pair);
+            HG_TEST_CHECK_HG_ERROR(done, ret,
+                "hg_test_rpc_local_origin_init() failed (%s)",
+                HG_Error_to_string(ret));
+        }
+
+        ret = HG_Addr_self(pair.origin_class, &origin_addr);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Addr_self() failed (%s)", HG_Error_to_string(ret));
+        ret = HG_Addr_to_string(pair.origin_class, origin_string,
+            &origin_string_len, origin_addr);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Addr_to_string() failed (%s)",
+            HG_Error_to_string(ret));
+
+        ret = HG_Create(
+            pair.origin_context, pair.target_addr, pair.rpc_id, &handle);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+        hold_target.hold = true;
+        ret = hg_test_rpc_hold_forward(handle, &forward_cb_args);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_forward() failed (%s)", HG_Error_to_string(ret));
+
+        ret = hg_test_rpc_hold_wait(pair.origin_context, pair.target_context,
+            &hold_target.received, i + 1, HG_TEST_WAIT_TIMEOUT);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_wait() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Addr_to_string(pair.target_class, src_string, &src_string_len,
+            HG_Get_info(hold_target.held_handle)->addr);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Addr_to_string() failed (%s)",
+            HG_Error_to_string(ret));
+        HG_TEST_CHECK_ERROR(strcmp(src_string, origin_string) != 0, done, ret,
+            HG_FAULT, "Source address is %s, expected %s", src_string,
+            origin_string);
+
+        ret = HG_Respond(hold_target.held_handle, NULL, NULL, NULL);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+        /* Release source address on the target */
+        ret = HG_Destroy(hold_target.held_handle);
+        hold_target.held_handle = HG_HANDLE_NULL;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+        ret = hg_test_rpc_hold_wait(pair.origin_context, pair.target_context,
+            &forward_cb_args.done, 1, HG_TEST_WAIT_TIMEOUT);
+        HG_TEST_CHECK_HG_ERROR(done, ret,
+            "hg_test_rpc_hold_wait() failed (%s)", HG_Error_to_string(ret));
+        ret = forward_cb_args.ret;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Destroy(handle);
+        handle = HG_HANDLE_NULL;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Addr_free(pair.origin_class, origin_addr);
+        origin_addr = HG_ADDR_NULL;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Addr_free() failed (%s)", HG_Error_to_string(ret));
+    }
+
+done:
+    if (hold_target.held_handle != HG_HANDLE_NULL)
+        (void) HG_Destroy(hold_target.held_handle);
+    if (handle != HG_HANDLE_NULL)
+        (void) HG_Destroy(handle);
+    if (origin_addr != HG_ADDR_NULL)
+        (void) HG_Addr_free(pair.origin_class, origin_addr);
+    hg_test_rpc_local_pair_finalize(&pair);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_hold_forward(hg_handle_t handle, struct forward_hold_cb_args *args)
+{
+    hg_atomic_init32(&args->done, 0);
+    args->ret = HG_SUCCESS;
+    args->retry_ms = 0;
+
+    return HG_Forward(handle, hg_test_rpc_hold_cb, args, NULL);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_hold_wait(hg_context_t *context, hg_context_t *target_context,
+    hg_atomic_int32_t *counter, int32_t value, unsigned int timeout_ms)
+{
+    hg_context_t *contexts[2] = {target_context, context};
+    hg_time_t deadline, now;
+    hg_return_t ret;
+
+    hg_time_get_current_ms(&deadline);
+    deadline = hg_time_add(deadline, hg_time_from_ms(timeout_ms));
+
+    /* Origin and target are both progressed from this thread */
+    while (hg_atomic_get32(counter) < value) {
+        int i;
+
+        for (i = 0; i < 2; i++) {
+            unsigned int actual_count = 0;
+
+            ret = HG_Progress(contexts[i], 0);
+            HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+                error, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+
+            do {
+                ret = HG_Trigger(contexts[i], 0, 1, &actual_count);
+            } while ((ret == HG_SUCCESS) && actual_count);
+            HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+                error, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+        }
+
+        /* Timeout is left to the caller, which may expect it */
+        hg_time_get_current_ms(&now);
+        if (hg_time_less(deadline, now))
+            return HG_TIMEOUT;
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_hold_cb(const struct hg_cb_info *callback_info)
+{
+    struct forward_hold_cb_args *args =
+        (struct forward_hold_cb_args *) callback_info->arg;
+
+    args->ret = callback_info->ret;
+    (void) HG_Get_retry_after(
+        callback_info->info.forward.handle, &args->retry_ms);
+    hg_atomic_set32(&args->done, 1);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_hold_target_cb(hg_handle_t handle)
+{
+    const struct hg_info *hg_info = HG_Get_info(handle);
+    struct hg_test_hold_target *hold_target =
+        (struct hg_test_hold_target *) HG_Registered_data(
+            hg_info->hg_class, hg_info->id);
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Keep next RPC active, and its admission slot taken, until released */
+    if (hold_target->hold) {
+        hold_target->held_handle = handle;
+        hold_target->hold = false;
+    } else {
+        ret = HG_Respond(handle, NULL, NULL, NULL);
+        (void) HG_Destroy(handle);
+    }
+    hg_atomic_incr32(&hold_target->received);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_launch_threads(struct hg_unit_info *info, hg_thread_func_t func)
@@ -1042,6 +2103,82 @@ main(int argc, char *argv[])
         HG_Error_to_string(hg_ret));
     HG_PASSED();
 
+    /* RPC test that consumes and reposts every multi-recv buffer of the
+     * target, plugins without multi-recv go through regular posted recvs */
+    {
+        size_t i;
+
+        HG_TEST("multi RPCs (multi-recv repost)");
+        for (i = 0; i < HG_TEST_MULTI_RECV_COUNT / info.handle_max; i++) {
+            hg_ret = hg_test_rpc_multi(info.handles, info.handle_max,
+                info.target_addr, 0, hg_test_rpc_open_id_g,
+                hg_test_rpc_multi_cb, info.request);
+            HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+                "hg_test_rpc_multiple() failed (%s)",
+                HG_Error_to_string(hg_ret));
+        }
+        HG_PASSED();
+    }
+
+    /* RPC test with mixed priorities, self completions are interleaved with
+     * target handler completions on the same context */
+    if (!info.hg_test_info.na_test_info.self_send) {
+        HG_TEST("RPC priorities");
+        hg_ret = hg_test_rpc_priority(
+            info.context, info.handles, info.handle_max, info.target_addr);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_priority() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_PASSED();
+    }
+
+    /* RPC test against a target at capacity */
+    if (strcmp(HG_Class_get_name(info.hg_class), "mpi") &&
+        strcmp(HG_Class_get_name(info.hg_class), "bmi")) {
+        HG_TEST("RPC admission control");
+        hg_ret = hg_test_rpc_busy(
+            info.hg_class, info.hg_test_info.na_test_info.busy_wait);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret, "hg_test_rpc_busy() failed (%s)",
+            HG_Error_to_string(hg_ret));
+        HG_PASSED();
+
+        HG_TEST("RPC credit flow control");
+        hg_ret = hg_test_rpc_credit(
+            info.hg_class, info.hg_test_info.na_test_info.busy_wait);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_credit() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_PASSED();
+
+        HG_TEST("RPC coalescing");
+        hg_ret = hg_test_rpc_coalesce(
+            info.hg_class, info.hg_test_info.na_test_info.busy_wait, false);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_coalesce() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_PASSED();
+
+        /* Responses ready in the same pass come back together, held one
+         * comes back on its own */
+        HG_TEST("RPC coalescing (responses)");
+        hg_ret = hg_test_rpc_coalesce(
+            info.hg_class, info.hg_test_info.na_test_info.busy_wait, true);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_coalesce() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_PASSED();
+
+        HG_TEST("RPC deadlines and hedging");
+        hg_ret = hg_test_rpc_deadline(
+            info.hg_class, info.hg_test_info.na_test_info.busy_wait);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_deadline() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_PASSED();
+
+        HG_TEST("RPC source address of successive origins");
+        hg_ret = hg_test_rpc_src_addr(
+            info.hg_class, info.hg_test_info.na_test_info.busy_wait);
+        HG_TEST_CHECK_HG_ERROR(error, hg_ret,
+            "hg_test_rpc_src_addr() failed (%s)", HG_Error_to_string(hg_ret));
+        HG_PASSED();
+    }
+
     /* RPC test with multiple handles in flight from multiple threads */
     HG_TEST("concurrent multi RPCs");
     hg_ret = hg_test_rpc_launch_threads(&info, hg_test_rpc_multi_thread);
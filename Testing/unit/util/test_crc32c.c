@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_crc32c.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define BUF_SIZE   (4096)
+#define OFFSET_MAX (8)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Known answer (RFC 3720, B.4) */
+struct crc32c_vector {
+    const char *name;
+    unsigned char data[32];
+    size_t len;
+    uint32_t crc;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Bitwise reference implementation, independent from the library table */
+static uint32_t
+hg_test_crc32c_ref(const unsigned char *buf, size_t len);
+
+static int
+hg_test_crc32c_vectors(void);
+
+static int
+hg_test_crc32c_update(const unsigned char *buf);
+
+static int
+hg_test_crc32c_combine(const unsigned char *buf);
+
+static int
+hg_test_crc32c_copy(const unsigned char *buf);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Lengths around the 8-byte word size used by hardware implementations */
+static const size_t hg_test_crc32c_lens_g[] = {
+    0, 1, 3, 7, 8, 9, 15, 16, 17, 63, 64, 65, 1000, BUF_SIZE - OFFSET_MAX};
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+hg_test_crc32c_ref(const unsigned char *buf, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    size_t i;
+    int k;
+
+    for (i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (k = 0; k < 8; k++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+    }
+
+    return ~crc;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_crc32c_vectors(void)
+{
+    struct crc32c_vector vectors[4] = {
+        {"123456789", "123456789", 9, 0xE3069283},
+        {"32 bytes of zeros", {0}, 32, 0x8A9136AA},
+        {"32 bytes of ones", {0}, 32, 0x62A8AB43},
+        {"32 incrementing bytes", {0}, 32, 0x46DD794E}};
+    unsigned int i;
+
+    memset(vectors[2].data, 0xff, sizeof(vectors[2].data));
+    for (i = 0; i < 32; i++)
+        vectors[3].data[i] = (unsigned char) i;
+
+    for (i = 0; i < 4; i++) {
+        uint32_t crc =
+            hg_crc32c(HG_CRC32C_INIT, vectors[i].data, vectors[i].len);
+
+        if (crc != vectors[i].crc ||
+            hg_test_crc32c_ref(vectors[i].data, vectors[i].len) != crc) {
+            fprintf(stderr, "Error: CRC32C of %s is 0x%08x, expected 0x%08x\n",
+                vectors[i].name, crc, vectors[i].crc);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_crc32c_update(const unsigned char *buf)
+{
+    size_t i, off;
+
+    /* Unaligned starts and tails */
+    for (off = 0; off < OFFSET_MAX; off++) {
+        for (i = 0; i < sizeof(hg_test_crc32c_lens_g) / sizeof(size_t); i++) {
+            size_t len = hg_test_crc32c_lens_g[i];
+            uint32_t crc = hg_crc32c(HG_CRC32C_INIT, buf + off, len),
+                     ref = hg_test_crc32c_ref(buf + off, len);
+
+            if (crc != ref) {
+                fprintf(stderr,
+                    "Error: CRC32C at offset %zu of %zu bytes is 0x%08x, "
+                    "expected 0x%08x\n",
+                    off, len, crc, ref);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    /* Chained calls */
+    for (i = 0; i < sizeof(hg_test_crc32c_lens_g) / sizeof(size_t); i++) {
+        size_t len = hg_test_crc32c_lens_g[i];
+        uint32_t crc = hg_crc32c(HG_CRC32C_INIT, buf, len);
+
+        crc = hg_crc32c(crc, buf + len, BUF_SIZE - len);
+        if (crc != hg_test_crc32c_ref(buf, BUF_SIZE)) {
+            fprintf(stderr, "Error: CRC32C chained after %zu bytes is 0x%08x\n",
+                len, crc);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_crc32c_combine(const unsigned char *buf)
+{
+    uint32_t ref = hg_test_crc32c_ref(buf, BUF_SIZE);
+    size_t i;
+
+    /* Blocks checksummed separately and merged in order */
+    for (i = 0; i < sizeof(hg_test_crc32c_lens_g) / sizeof(size_t); i++) {
+        size_t len1 = hg_test_crc32c_lens_g[i], len2 = BUF_SIZE - len1;
+        uint32_t crc1 = hg_crc32c(HG_CRC32C_INIT, buf, len1),
+                 crc2 = hg_crc32c(HG_CRC32C_INIT, buf + len1, len2),
+                 crc = hg_crc32c_combine(crc1, crc2, len2);
+
+        if (crc != ref) {
+            fprintf(stderr,
+                "Error: CRC32C combined at %zu bytes is 0x%08x, "
+                "expected 0x%08x\n",
+                len1, crc, ref);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Empty second block */
+    if (hg_crc32c_combine(ref, HG_CRC32C_INIT, 0) != ref) {
+        fprintf(stderr, "Error: CRC32C combined with empty block changed\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_crc32c_copy(const unsigned char *buf)
+{
+    unsigned char *dst;
+    size_t i, off;
+    int ret = EXIT_SUCCESS;
+
+    dst = (unsigned char *) malloc(BUF_SIZE);
+    if (dst == NULL) {
+        fprintf(stderr, "Error: could not allocate %d bytes\n", BUF_SIZE);
+        return EXIT_FAILURE;
+    }
+
+    /* Source and destination offsets differ so that both are unaligned */
+    for (off = 0; off < OFFSET_MAX; off++) {
+        for (i = 0; i < sizeof(hg_test_crc32c_lens_g) / sizeof(size_t); i++) {
+            size_t len = hg_test_crc32c_lens_g[i];
+            const unsigned char *src = buf + (OFFSET_MAX - 1 - off);
+            uint32_t crc, ref = hg_test_crc32c_ref(src, len);
+
+            memset(dst, 0, BUF_SIZE);
+            crc = hg_crc32c_copy(HG_CRC32C_INIT, dst + off, src, len);
+            if (crc != ref || memcmp(dst + off, src, len) != 0) {
+                fprintf(stderr,
+                    "Error: CRC32C copy at offset %zu of %zu bytes is 0x%08x, "
+                    "expected 0x%08x\n",
+                    off, len, crc, ref);
+                ret = EXIT_FAILURE;
+                goto done;
+            }
+        }
+    }
+
+done:
+    free(dst);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    unsigned char *buf;
+    uint32_t seed = 1;
+    int ret = EXIT_SUCCESS;
+    size_t i;
+
+    /* Table-based implementation is forced through the environment */
+    if (getenv("HG_CRC32C_NO_ACCEL") != NULL && hg_crc32c_is_accelerated()) {
+        fprintf(stderr, "Error: HG_CRC32C_NO_ACCEL set but accelerated\n");
+        return EXIT_FAILURE;
+    }
+    printf("Using %s CRC32C\n",
+        hg_crc32c_is_accelerated() ? "hardware" : "table-based");
+
+    buf = (unsigned char *) malloc(BUF_SIZE);
+    if (buf == NULL) {
+        fprintf(stderr, "Error: could not allocate %d bytes\n", BUF_SIZE);
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < BUF_SIZE; i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (unsigned char) (seed >> 16);
+    }
+
+    ret = hg_test_crc32c_vectors();
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    ret = hg_test_crc32c_update(buf);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    ret = hg_test_crc32c_combine(buf);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    ret = hg_test_crc32c_copy(buf);
+
+done:
+    free(buf);
+
+    return ret;
+}
@@ -6,6 +6,7 @@
  */
 
 #include "mercury_atomic.h"
+#include "mercury_mem.h"
 #include "mercury_mem_pool.h"
 #include "mercury_thread.h"
 #include "mercury_thread_condition.h"
@@ -22,6 +23,21 @@
 #define CHUNK_COUNT1 (2)
 #define BLOCK_COUNT1 (1)
 
+/* Allocate more chunks than a block and a thread cache can hold so that
+ * thread caches are refilled and flushed, and the pool is extended */
+#define CHUNK_SIZE2  (64)
+#define CHUNK_COUNT2 (16)
+#define BLOCK_COUNT2 (1)
+#define ALLOC_COUNT2 (CHUNK_COUNT2 * 4)
+
+/* Pools destroyed while the threads that used them are exiting */
+#define EXIT_COUNT (16)
+
+/* Blocks rounded up to whole huge pages when HG_MEM_HUGEPAGES is set, blocks
+ * of three huge pages are aligned on four huge pages */
+#define CHUNK_SIZE3 (4096)
+#define HUGE_PAGES3 (3)
+
 #ifndef HG_TEST_NUM_THREADS_DEFAULT
 #    define HG_TEST_NUM_THREADS_DEFAULT (8)
 #endif
@@ -39,6 +55,18 @@ struct thread_args {
     int mr;
 };
 
+struct exit_thread_args {
+    struct hg_mem_pool *mem_pool;
+    hg_atomic_int32_t n_done;
+};
+
+struct cross_thread_args {
+    struct hg_mem_pool *mem_pool;
+    void *chunks[ALLOC_COUNT2];
+    void *mr_handles[ALLOC_COUNT2];
+    int ret;
+};
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -53,6 +81,19 @@ hg_test_mem_pool_deregister(void *handle, void *arg);
 static void
 hg_test_mem_pool_alloc(struct hg_mem_pool *hg_mem_pool, int mr);
 
+static int
+hg_test_mem_pool_alloc_all(struct hg_mem_pool *hg_mem_pool, void **chunks,
+    void **mr_handles, unsigned int count);
+
+static int
+hg_test_mem_pool_cross_thread(void);
+
+static int
+hg_test_mem_pool_destroy_exit(void);
+
+static int
+hg_test_mem_pool_huge(size_t n_pages);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -137,6 +178,248 @@ hg_test_mem_pool_alloc(struct hg_mem_pool *hg_mem_pool, int mr)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_alloc_all(struct hg_mem_pool *hg_mem_pool, void **chunks,
+    void **mr_handles, unsigned int count)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        chunks[i] = hg_mem_pool_alloc(hg_mem_pool, CHUNK_SIZE2, &mr_handles[i]);
+        if (chunks[i] == NULL || mr_handles[i] == NULL) {
+            fprintf(stderr, "Error: could not allocate chunk %u\n", i);
+            return EXIT_FAILURE;
+        }
+        memset(chunks[i], 0, CHUNK_SIZE2);
+        *(unsigned int *) chunks[i] = i;
+    }
+
+    /* Chunks must not be handed out twice */
+    for (i = 0; i < count; i++) {
+        if (*(unsigned int *) chunks[i] != i) {
+            fprintf(stderr, "Error: chunk %u was allocated twice\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_alloc_all_thread(void *arg)
+{
+    struct cross_thread_args *args = (struct cross_thread_args *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+
+    args->ret = hg_test_mem_pool_alloc_all(
+        args->mem_pool, args->chunks, args->mr_handles, ALLOC_COUNT2);
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_free_all_thread(void *arg)
+{
+    struct cross_thread_args *args = (struct cross_thread_args *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    unsigned int i;
+
+    /* Remaining cached chunks are flushed when the thread exits */
+    for (i = 0; i < ALLOC_COUNT2; i++)
+        hg_mem_pool_free(args->mem_pool, args->chunks[i], args->mr_handles[i]);
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_cross_thread(void)
+{
+    struct cross_thread_args args;
+    hg_atomic_int32_t n_mr;
+    hg_thread_t thread;
+    int32_t n_mr_alloc;
+    unsigned int i;
+    int ret = EXIT_SUCCESS;
+
+    hg_atomic_init32(&n_mr, 0);
+    args.mem_pool = hg_mem_pool_create(CHUNK_SIZE2, CHUNK_COUNT2, BLOCK_COUNT2,
+        hg_test_mem_pool_register, 0, hg_test_mem_pool_deregister, &n_mr);
+    if (args.mem_pool == NULL)
+        return EXIT_FAILURE;
+
+    /* Allocate from one thread, pool is extended through cache refills */
+    hg_thread_create(&thread, hg_test_alloc_all_thread, &args);
+    hg_thread_join(thread);
+    if (args.ret != EXIT_SUCCESS) {
+        ret = args.ret;
+        goto done;
+    }
+    n_mr_alloc = hg_atomic_get32(&n_mr);
+
+    /* Free from another thread, its cache is flushed back to the blocks */
+    hg_thread_create(&thread, hg_test_free_all_thread, &args);
+    hg_thread_join(thread);
+
+    /* All chunks must be available again */
+    ret = hg_test_mem_pool_alloc_all(
+        args.mem_pool, args.chunks, args.mr_handles, ALLOC_COUNT2);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+#ifndef _WIN32
+    if (hg_atomic_get32(&n_mr) != n_mr_alloc) {
+        fprintf(stderr, "Error: chunks were not returned to the pool\n");
+        ret = EXIT_FAILURE;
+    }
+#else
+    (void) n_mr_alloc;
+#endif
+    for (i = 0; i < ALLOC_COUNT2; i++)
+        hg_mem_pool_free(args.mem_pool, args.chunks[i], args.mr_handles[i]);
+
+done:
+    hg_mem_pool_destroy(args.mem_pool);
+    if (hg_atomic_get32(&n_mr) != 0) {
+        fprintf(stderr, "Error: memory still registered (%d)\n",
+            (int) hg_atomic_get32(&n_mr));
+        ret = EXIT_FAILURE;
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_exit_thread(void *arg)
+{
+    struct exit_thread_args *args = (struct exit_thread_args *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+
+    hg_test_mem_pool_alloc(args->mem_pool, 0);
+
+    /* Thread cache is released after this point, as the thread exits */
+    hg_atomic_incr32(&args->n_done);
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_destroy_exit(void)
+{
+    struct exit_thread_args args;
+    hg_thread_t threads[HG_TEST_NUM_THREADS_DEFAULT];
+    int i, j;
+
+    for (i = 0; i < EXIT_COUNT; i++) {
+        args.mem_pool = hg_mem_pool_create(
+            CHUNK_SIZE1, CHUNK_COUNT1, BLOCK_COUNT1, NULL, 0, NULL, NULL);
+        if (args.mem_pool == NULL)
+            return EXIT_FAILURE;
+        hg_atomic_init32(&args.n_done, 0);
+
+        for (j = 0; j < HG_TEST_NUM_THREADS_DEFAULT; j++)
+            hg_thread_create(&threads[j], hg_test_exit_thread, &args);
+
+        /* Pool is no longer used, destroy it while threads are exiting */
+        while (hg_atomic_get32(&args.n_done) < HG_TEST_NUM_THREADS_DEFAULT)
+            hg_thread_yield();
+        hg_mem_pool_destroy(args.mem_pool);
+
+        for (j = 0; j < HG_TEST_NUM_THREADS_DEFAULT; j++)
+            hg_thread_join(threads[j]);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_huge(size_t n_pages)
+{
+    struct hg_mem_pool *hg_mem_pool;
+    size_t reg_page_size = (size_t) hg_mem_get_reg_page_size();
+    size_t block_size = n_pages * reg_page_size, chunk_count, i;
+    void **chunks = NULL, **mr_handles = NULL;
+    char *block = NULL;
+    hg_atomic_int32_t n_mr;
+    int ret = EXIT_SUCCESS;
+
+    if (reg_page_size <= (size_t) hg_mem_get_page_size()) {
+        printf("Huge pages not enabled, skipping huge page test\n");
+        return EXIT_SUCCESS;
+    }
+
+    hg_atomic_init32(&n_mr, 0);
+    chunk_count = (block_size - reg_page_size / 2) / CHUNK_SIZE3;
+    hg_mem_pool = hg_mem_pool_create(CHUNK_SIZE3, chunk_count, 1,
+        hg_test_mem_pool_register, 0, hg_test_mem_pool_deregister, &n_mr);
+    if (hg_mem_pool == NULL)
+        return EXIT_FAILURE;
+
+    chunks = (void **) calloc(chunk_count, sizeof(void *));
+    mr_handles = (void **) calloc(chunk_count, sizeof(void *));
+    if (chunks == NULL || mr_handles == NULL) {
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Block is made of n_pages huge pages aligned on the huge page size and
+     * holds every chunk */
+    for (i = 0; i < chunk_count; i++) {
+        size_t offset;
+
+        chunks[i] =
+            hg_mem_pool_alloc(hg_mem_pool, CHUNK_SIZE3, &mr_handles[i]);
+        if (chunks[i] == NULL || mr_handles[i] == NULL) {
+            fprintf(stderr, "Error: could not allocate chunk %zu\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+        memset(chunks[i], 1, CHUNK_SIZE3);
+
+        offset =
+            hg_mem_pool_chunk_offset(hg_mem_pool, chunks[i], mr_handles[i]);
+        if (offset + CHUNK_SIZE3 > block_size) {
+            fprintf(stderr, "Error: chunk %zu at offset %zu exceeds %zu\n", i,
+                offset, block_size);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+        if (block == NULL)
+            block = (char *) chunks[i] - offset;
+        if ((char *) chunks[i] - offset != block ||
+            ((uintptr_t) block & (reg_page_size - 1)) != 0) {
+            fprintf(stderr,
+                "Error: chunk %zu block %p is not the huge page aligned "
+                "block %p\n",
+                i, (void *) ((char *) chunks[i] - offset), (void *) block);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+done:
+    for (i = 0; chunks != NULL && i < chunk_count && chunks[i] != NULL; i++)
+        hg_mem_pool_free(hg_mem_pool, chunks[i], mr_handles[i]);
+    free(chunks);
+    free(mr_handles);
+    hg_mem_pool_destroy(hg_mem_pool);
+    if (hg_atomic_get32(&n_mr) != 0) {
+        fprintf(stderr, "Error: memory still registered (%d)\n",
+            (int) hg_atomic_get32(&n_mr));
+        ret = EXIT_FAILURE;
+    }
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 int
 main(void)
@@ -154,6 +437,10 @@ main(void)
     /* Create memory pool without registration */
     thread_args.mem_pool = hg_mem_pool_create(
         CHUNK_SIZE1, CHUNK_COUNT1, BLOCK_COUNT1, NULL, 0, NULL, NULL);
+    if (thread_args.mem_pool == NULL) {
+        ret = EXIT_FAILURE;
+        goto done;
+    }
     thread_args.mr = 0;
 
     for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT; i++)
@@ -187,6 +474,22 @@ main(void)
             (int) hg_atomic_get32(&thread_args.n_mr));
     }
 
+    /* Allocate and free chunks from different threads */
+    ret = hg_test_mem_pool_cross_thread();
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    ret = hg_test_mem_pool_destroy_exit();
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    /* Pool backed by huge pages when HG_MEM_HUGEPAGES is set */
+    ret = hg_test_mem_pool_huge(1);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    ret = hg_test_mem_pool_huge(HUGE_PAGES3);
+
 done:
     hg_thread_mutex_destroy(&thread_args.mutex);
     hg_thread_cond_destroy(&thread_args.cond);
@@ -11,22 +11,24 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-int
-main(void)
+static int
+test_poll(unsigned int flags)
 {
     hg_poll_set_t *poll_set;
     struct hg_poll_event events[2];
     unsigned int nevents = 0;
     bool signaled = false;
-    int event_fd1, event_fd2, ret = EXIT_SUCCESS;
+    int event_fd1, event_fd2, first_fd, ret = EXIT_SUCCESS;
 
-    poll_set = hg_poll_create();
+    poll_set = hg_poll_create_opt(flags);
     event_fd1 = hg_event_create();
     event_fd2 = hg_event_create();
 
     /* Add event descriptor */
     events[0].events = HG_POLLIN;
+    events[0].data.fd = event_fd1;
     events[1].events = HG_POLLIN;
+    events[1].data.fd = event_fd2;
 
     hg_poll_add(poll_set, event_fd1, &events[0]);
     hg_poll_add(poll_set, event_fd2, &events[1]);
@@ -42,6 +44,18 @@ main(void)
         ret = EXIT_FAILURE;
         goto done;
     }
+
+    /* Reset progressed */
+    nevents = 0;
+
+    /* Wait with timeout 0 (event was not consumed) */
+    hg_poll_wait(poll_set, 0, 1, events, &nevents);
+    if (nevents != 1) {
+        /* We expect success */
+        fprintf(stderr, "Error: should have progressed again\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
     hg_event_get(event_fd1, &signaled);
     if (!signaled) {
         /* We expect success */
@@ -111,7 +125,9 @@ main(void)
         ret = EXIT_FAILURE;
         goto done;
     }
-    hg_event_get(event_fd1, &signaled);
+    /* Order of events is not specified, consume the one reported */
+    first_fd = events[0].data.fd;
+    hg_event_get(first_fd, &signaled);
     if (!signaled) {
         /* We expect success */
         fprintf(stderr, "Error: should have been signaled\n");
@@ -124,13 +140,13 @@ main(void)
 
     /* Wait with timeout */
     hg_poll_wait(poll_set, 1000, 2, events, &nevents);
-    if (nevents != 1) {
+    if (nevents != 1 || events[0].data.fd == first_fd) {
         /* We expect success */
         fprintf(stderr, "Error: did not progress second time\n");
         ret = EXIT_FAILURE;
         goto done;
     }
-    hg_event_get(event_fd2, &signaled);
+    hg_event_get(events[0].data.fd, &signaled);
     if (!signaled) {
         /* We expect success */
         fprintf(stderr, "Error: should have been signaled\n");
@@ -147,3 +163,16 @@ done:
 
     return ret;
 }
+
+int
+main(void)
+{
+    int ret;
+
+    ret = test_poll(0);
+    if (ret != EXIT_SUCCESS)
+        return ret;
+
+    /* Falls back to default poll set if io_uring is not supported */
+    return test_poll(HG_POLL_IO_URING);
+}
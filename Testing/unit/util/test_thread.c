@@ -10,6 +10,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#if !defined(_WIN32) && !defined(__APPLE__)
+#    include <unistd.h>
+#endif
 
 static HG_THREAD_RETURN_TYPE
 thread_cb_incr(void *arg)
@@ -77,6 +80,55 @@ thread_cb_equal(void *arg)
     return thread_ret;
 }
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+static int
+test_cpulist(void)
+{
+    const char *invalid[] = {
+        "", "\n", "a", "1-", "-1", "3-1", "1,", "1 2", "0-1\n2"};
+    const int cpus[] = {0, 1, 2, 5, 8, 9};
+    hg_cpu_set_t cpu_mask;
+    size_t i;
+
+    if (hg_thread_cpulist_parse("0-2,5,8-9\n", &cpu_mask) != HG_UTIL_SUCCESS) {
+        fprintf(stderr, "Error: could not parse cpulist\n");
+        return EXIT_FAILURE;
+    }
+    if (CPU_COUNT(&cpu_mask) != (int) (sizeof(cpus) / sizeof(cpus[0]))) {
+        fprintf(stderr, "Error: cpulist has %d CPUs\n", CPU_COUNT(&cpu_mask));
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < sizeof(cpus) / sizeof(cpus[0]); i++) {
+        if (!CPU_ISSET(cpus[i], &cpu_mask)) {
+            fprintf(stderr, "Error: CPU %d is not set\n", cpus[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        if (hg_thread_cpulist_parse(invalid[i], &cpu_mask) == HG_UTIL_SUCCESS) {
+            fprintf(stderr, "Error: parsed invalid cpulist \"%s\"\n",
+                invalid[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Node 0 has CPUs on systems that expose NUMA nodes */
+    if (access("/sys/devices/system/node/node0", F_OK) == 0 &&
+        (hg_thread_numa_node_cpus(0, &cpu_mask) != HG_UTIL_SUCCESS ||
+            CPU_COUNT(&cpu_mask) == 0)) {
+        fprintf(stderr, "Error: could not get CPUs of NUMA node 0\n");
+        return EXIT_FAILURE;
+    }
+    if (hg_thread_numa_node_cpus(-1, &cpu_mask) == HG_UTIL_SUCCESS) {
+        fprintf(stderr, "Error: got CPUs of invalid NUMA node\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+#endif
+
 int
 main(int argc, char *argv[])
 {
@@ -114,6 +166,10 @@ main(int argc, char *argv[])
     hg_thread_create(&thread, thread_cb_equal, &thread);
     hg_thread_join(thread);
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+    ret = test_cpulist();
+#endif
+
 done:
     return ret;
 }
@@ -15,6 +15,7 @@
 
 #include "mercury_hash_string.h"
 #include "mercury_mem.h"
+#include "mercury_thread.h"
 #include "mercury_thread_spin.h"
 
 #include <assert.h>
@@ -1091,8 +1092,14 @@ HG_Init_opt2(const char *na_info_string, uint8_t na_listen,
             HG_MAJOR(version), HG_MINOR(version));
 
         /* Get init info and overwrite defaults */
-        if (HG_VERSION_GE(version, HG_VERSION(2, 3)))
+        if (HG_VERSION_GE(version, HG_VERSION(2, 5)))
             hg_init_info = *hg_init_info_p;
+        else if (HG_VERSION_GE(version, HG_VERSION(2, 4)))
+            hg_init_info_dup_2_4(&hg_init_info,
+                (const struct hg_init_info_2_4 *) hg_init_info_p);
+        else if (HG_VERSION_GE(version, HG_VERSION(2, 3)))
+            hg_init_info_dup_2_3(&hg_init_info,
+                (const struct hg_init_info_2_3 *) hg_init_info_p);
         else
             hg_init_info_dup_2_2(&hg_init_info,
                 (const struct hg_init_info_2_2 *) hg_init_info_p);
@@ -1269,6 +1276,7 @@ HG_Context_create_id(hg_class_t *hg_class, uint8_t id)
         ctx, hg_context == NULL, error, "Could not allocate HG context");
 
     hg_context->hg_class = hg_class;
+    hg_context->numa_node = HG_NUMA_NODE_ANY;
     hg_context->core_context =
         HG_Core_context_create_id(hg_class->core_class, id);
     HG_CHECK_SUBSYS_ERROR_NORET(ctx, hg_context->core_context == NULL, error,
@@ -1296,6 +1304,90 @@ error:
     return NULL;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_context_t *
+HG_Context_create_id_numa(hg_class_t *hg_class, uint8_t id, int numa_node)
+{
+    hg_context_t *hg_context;
+    hg_cpu_set_t cpu_mask, prev_cpu_mask;
+    bool rebind = false;
+
+    HG_CHECK_SUBSYS_ERROR_NORET(ctx, hg_class == NULL, error, "NULL HG class");
+
+    if (numa_node == HG_NUMA_NODE_NIC)
+        numa_node =
+            NA_Get_numa_node(HG_Core_class_get_na(hg_class->core_class));
+
+    /* Bind to node while resources are allocated so that they are first
+     * touched there */
+    if (numa_node >= 0) {
+        if (hg_thread_getaffinity(hg_thread_self(), &prev_cpu_mask) ==
+                HG_UTIL_SUCCESS &&
+            NA_Get_numa_node_cpus(numa_node, &cpu_mask) == NA_SUCCESS &&
+            hg_thread_setaffinity(hg_thread_self(), &cpu_mask) ==
+                HG_UTIL_SUCCESS)
+            rebind = true;
+        else
+            HG_LOG_SUBSYS_WARNING(ctx,
+                "Could not bind to NUMA node %d, context resources will not "
+                "be placed",
+                numa_node);
+    }
+
+    hg_context = HG_Context_create_id(hg_class, id);
+
+    if (rebind)
+        (void) hg_thread_setaffinity(hg_thread_self(), &prev_cpu_mask);
+    HG_CHECK_SUBSYS_ERROR_NORET(ctx, hg_context == NULL, error,
+        "Could not create context for ID %u", id);
+
+    hg_context->numa_node = (numa_node >= 0) ? numa_node : HG_NUMA_NODE_ANY;
+
+    /* Small bulk transfers go through a rail that is local to that node */
+    hg_core_context_set_numa_node(hg_context->core_context, numa_node);
+
+    return hg_context;
+
+error:
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Context_bind_thread(const hg_context_t *context)
+{
+    hg_cpu_set_t cpu_mask;
+    int numa_node, rc;
+    na_return_t na_ret;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        ctx, context == NULL, error, ret, HG_INVALID_ARG, "NULL HG context");
+
+    numa_node = (context->numa_node >= 0)
+                    ? context->numa_node
+                    : NA_Get_numa_node(
+                          HG_Core_class_get_na(context->hg_class->core_class));
+    HG_CHECK_SUBSYS_ERROR(ctx, numa_node < 0, error, ret, HG_NOENTRY,
+        "No NUMA node is associated to context");
+
+    na_ret = NA_Get_numa_node_cpus(numa_node, &cpu_mask);
+    HG_CHECK_SUBSYS_ERROR(ctx, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not get CPUs of NUMA node %d (%s)",
+        numa_node, NA_Error_to_string(na_ret));
+
+    rc = hg_thread_setaffinity(hg_thread_self(), &cpu_mask);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+        HG_PROTOCOL_ERROR, "Could not bind thread to NUMA node %d", numa_node);
+
+    HG_LOG_SUBSYS_DEBUG(ctx, "Bound thread to NUMA node %d", numa_node);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Context_destroy(hg_context_t *context)
@@ -1595,6 +1687,39 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_set_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t priority)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    return HG_Core_registered_set_priority(hg_class->core_class, id, priority);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_get_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t *priority_p)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    return HG_Core_registered_get_priority(
+        hg_class->core_class, id, priority_p);
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Addr_lookup1(hg_context_t *context, hg_cb_t callback, void *arg,
@@ -2257,6 +2382,63 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Get_retry_after(hg_handle_t handle, unsigned int *retry_ms_p)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG handle");
+
+    ret = HG_Core_get_retry_after(handle->core_handle, retry_ms_p);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret,
+        "Could not get retry-after hint (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Set_timeout(hg_handle_t handle, unsigned int timeout_ms)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG handle");
+
+    ret = HG_Core_set_timeout(handle->core_handle, timeout_ms);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not set timeout (%s)",
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Set_hedge(hg_handle_t handle, hg_addr_t addr)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG handle");
+
+    ret = HG_Core_set_hedge(handle->core_handle, (hg_core_addr_t) addr);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret,
+        "Could not set alternate address (%s)", HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Progress(hg_context_t *context, unsigned int timeout)
@@ -367,6 +367,41 @@ HG_Context_create(hg_class_t *hg_class) HG_WARN_UNUSED_RESULT;
 HG_PUBLIC hg_context_t *
 HG_Context_create_id(hg_class_t *hg_class, uint8_t id) HG_WARN_UNUSED_RESULT;
 
+/**
+ * Create a new context with a user-defined context identifier (see
+ * HG_Context_create_id()) and place its resources on NUMA node \numa_node.
+ * The calling thread is temporarily bound to the CPUs of that node while
+ * handle pools and receive buffers are allocated and posted, so that their
+ * memory is first touched on that node.
+ * HG_NUMA_NODE_NIC selects the node closest to the network interface when the
+ * NA plugin knows it, HG_NUMA_NODE_ANY does not place resources.
+ * When bulk rails are configured (see hg_init_info), bulk transfers that are
+ * too small to be striped go through a rail that is local to that node.
+ * Context must be destroyed by calling HG_Context_destroy().
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               user-defined context ID
+ * \param numa_node [IN]        NUMA node index
+ *
+ * \return Pointer to HG context or NULL in case of failure
+ */
+HG_PUBLIC hg_context_t *
+HG_Context_create_id_numa(hg_class_t *hg_class, uint8_t id,
+    int numa_node) HG_WARN_UNUSED_RESULT;
+
+/**
+ * Bind the calling thread to the CPUs of the NUMA node that the context
+ * resources were placed on, or of the node closest to the network interface
+ * if none was specified. This is intended to be called by threads that make
+ * progress on \context.
+ *
+ * \param context [IN]          pointer to HG context
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Context_bind_thread(const hg_context_t *context);
+
 /**
  * Destroy a context created by HG_Context_create(). If listening and
  * HG_Context_unpost() has not already been called, also cancels previously
@@ -587,6 +622,39 @@ HG_PUBLIC hg_return_t
 HG_Registered_disabled_response(
     hg_class_t *hg_class, hg_id_t id, uint8_t *disabled_p);
 
+/**
+ * Set priority for a given RPC ID. Completions of RPCs that have a high
+ * priority (both the execution of the RPC callback on the target and the
+ * forward callback on the origin) are triggered by HG_Trigger() ahead of
+ * completions of default priority, which are otherwise triggered in order.
+ * This can be used to prevent control RPCs (e.g., heartbeats) from being
+ * delayed by other RPCs under load. To prevent starvation, default priority
+ * completions are still regularly triggered when high priority completions
+ * remain. By default, all RPCs have a default priority.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param priority [IN]         RPC priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_set_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t priority);
+
+/**
+ * Get priority for a given RPC ID.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param priority_p [OUT]      pointer to RPC priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_get_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t *priority_p);
+
 /**
  * Lookup an addr from a peer address/name. Addresses need to be
  * freed by calling HG_Addr_free(). After completion, user callback is
@@ -1050,6 +1118,47 @@ HG_Respond(hg_handle_t handle, hg_cb_t callback, void *arg, void *out_struct);
 HG_PUBLIC hg_return_t
 HG_Cancel(hg_handle_t handle);
 
+/**
+ * Get the retry-after hint returned by the target when the forward callback
+ * completed with HG_BUSY, i.e., the target was at capacity and did not run the
+ * RPC. Callers may wait that long before forwarding the request again.
+ *
+ * \param handle [IN]           HG handle
+ * \param retry_ms_p [OUT]      pointer to hint in ms (0 if none)
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Get_retry_after(hg_handle_t handle, unsigned int *retry_ms_p);
+
+/**
+ * Set a deadline of timeout_ms relative to each subsequent call to
+ * HG_Forward() on that handle. Past that deadline, the forward is canceled and
+ * its callback completes with HG_TIMEOUT. The target also answers the request
+ * with HG_TIMEOUT instead of running it if it has expired by then.
+ *
+ * \param handle [IN]           HG handle
+ * \param timeout_ms [IN]       timeout in ms (0 to disable)
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Set_timeout(hg_handle_t handle, unsigned int timeout_ms);
+
+/**
+ * Set an alternate target to which a duplicate of the request is sent when
+ * the response is slower than usual (tail latency), the first successful
+ * response being returned to the forward callback. The RPC must be safe to
+ * execute twice. See HG_Core_set_hedge() for details.
+ *
+ * \param handle [IN]           HG handle
+ * \param addr [IN]             alternate address (HG_ADDR_NULL to disable)
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Set_hedge(hg_handle_t handle, hg_addr_t addr);
+
 /**
  * (Deprecated in favor of HG_Event_progress())
  * Try to progress RPC execution for at most timeout until timeout is reached or
@@ -1149,6 +1258,7 @@ struct hg_class {
 struct hg_context {
     hg_core_context_t *core_context; /* Core context */
     hg_class_t *hg_class;            /* HG class */
+    int numa_node;                   /* NUMA node of resources */
 };
 
 /* HG handle */
@@ -12,6 +12,7 @@
 #include "mercury_private.h"
 
 #include "mercury_atomic.h"
+#include "mercury_crc32c.h"
 #include "mercury_thread_condition.h"
 #include "mercury_thread_spin.h"
 
@@ -36,6 +37,11 @@
 #define HG_BULK_OP_CANCELED  (1 << 1)
 #define HG_BULK_OP_ERRORED   (1 << 2)
 
+/* NA registration status bits */
+#define HG_BULK_NA_REG            (1 << 0)
+#define HG_BULK_NA_SM_REG         (1 << 1)
+#define HG_BULK_NA_RAIL_REG(rail) (1 << (2 + (rail)))
+
 /* Encode type */
 #define HG_BULK_TYPE_ENCODE(label, ret, buf_ptr, buf_size_left, data, size)    \
     do {                                                                       \
@@ -87,16 +93,21 @@
                                                             : (x)->handles.s
 
 #define HG_BULK_NA_OP_IDS(x)                                                   \
-    ((x)->op_count > HG_BULK_STATIC_MAX) ? (x)->na_op_ids.d : (x)->na_op_ids.s
+    ((x)->na_op_count > HG_BULK_STATIC_MAX) ? (x)->na_op_ids.d                 \
+                                            : (x)->na_op_ids.s
 
 #define HG_BULK_NA_SM_OP_IDS(x)                                                \
-    ((x)->op_count > HG_BULK_STATIC_MAX) ? (x)->na_sm_op_ids.d                 \
-                                         : (x)->na_sm_op_ids.s
+    ((x)->na_op_count > HG_BULK_STATIC_MAX) ? (x)->na_sm_op_ids.d              \
+                                            : (x)->na_sm_op_ids.s
+
+#define HG_BULK_RAIL_OP_IDS(x)                                                 \
+    ((x)->op_count > HG_BULK_STATIC_MAX) ? (x)->na_op_ids.d : (x)->na_op_ids.s
 
 /* Check permission flags */
 #define HG_BULK_CHECK_FLAGS(op, origin_flags, local_flags, label, ret)         \
     do {                                                                       \
-        HG_CHECK_SUBSYS_ERROR(bulk, op > HG_BULK_PULL, label, ret,             \
+        HG_CHECK_SUBSYS_ERROR(bulk,                                            \
+            (op & ~HG_BULK_CRC32C) > HG_BULK_PULL, label, ret,                 \
             HG_INVALID_ARG, "Unknown bulk operation");                         \
         if (op & HG_BULK_PULL)                                                 \
             HG_CHECK_SUBSYS_ERROR(bulk,                                        \
@@ -158,6 +169,12 @@ struct hg_bulk_na_mem_desc {
     } handles;                                  /* NA mem handles */
 };
 
+/* Memory handles on a bulk rail */
+struct hg_bulk_rail {
+    struct hg_bulk_na_mem_desc na_mem_descs; /* NA memory handles */
+    na_addr_t *na_addr;                      /* Owner addr (if deserialized) */
+};
+
 /* HG bulk handle */
 struct hg_bulk {
     struct hg_bulk_desc desc;                /* Bulk descriptor   */
@@ -170,11 +187,15 @@ struct hg_bulk {
 #ifdef NA_HAS_SM
     na_class_t *na_sm_class; /* NA SM class */
 #endif
+    struct hg_bulk_rail *rails;  /* Bulk rails (NULL if none) */
     struct hg_bulk_attr attrs;   /* Memory attributes */
     hg_core_addr_t addr;         /* Addr (valid if bound to handle) */
     void *serialize_ptr;         /* Cached serialization buffer */
     hg_size_t serialize_size;    /* Cached serialization size */
+    LIST_ENTRY(hg_bulk) entry;   /* Entry in pool */
     hg_atomic_int32_t ref_count; /* Reference count */
+    hg_atomic_int32_t na_reg;    /* NA registration status */
+    hg_thread_mutex_t reg_mutex; /* To register with a given transport */
     uint8_t context_id;          /* Context ID (valid if bound to handle) */
     bool registered;             /* Handle was registered */
 };
@@ -185,6 +206,21 @@ typedef struct {
     na_op_id_t **d;                    /* Dynamic array */
 } hg_bulk_na_op_id_t;
 
+/* NA operations issued on a bulk rail */
+struct hg_bulk_rail_op {
+    hg_bulk_na_op_id_t na_op_ids; /* NA operations IDs */
+    uint32_t op_count;            /* Number of operations issued */
+};
+
+/* Checksum of data transferred by a single NA operation */
+struct hg_bulk_crc_chunk {
+    struct hg_bulk_op_id *hg_bulk_op_id; /* Parent op ID */
+    hg_size_t local_index;               /* Local segment index */
+    hg_size_t local_offset;              /* Offset within local segment */
+    hg_size_t size;                      /* Size of data transferred */
+    uint32_t crc;                        /* CRC32C of data transferred */
+};
+
 /* HG Bulk op ID */
 struct hg_bulk_op_id {
     struct hg_completion_entry
@@ -197,6 +233,8 @@ struct hg_bulk_op_id {
 #ifdef NA_HAS_SM
     hg_bulk_na_op_id_t na_sm_op_ids; /* NA SM operations IDs */
 #endif
+    struct hg_bulk_rail_op rail_ops[HG_CORE_RAIL_MAX]; /* Rail operations */
+    struct hg_bulk_crc_chunk *crc_chunks; /* Per-operation checksums */
     hg_core_context_t *core_context;      /* Context */
     na_class_t *na_class;                 /* NA class */
     na_context_t *na_context;             /* NA context */
@@ -205,6 +243,7 @@ struct hg_bulk_op_id {
     hg_atomic_int32_t op_completed_count; /* Number of operations completed */
     hg_atomic_int32_t ref_count;          /* Refcount */
     uint32_t op_count;                    /* Number of ongoing operations */
+    uint32_t na_op_count;                 /* Operations issued on NA class */
     bool reuse;                           /* Re-use op ID once ref_count is 0 */
 };
 
@@ -219,9 +258,18 @@ struct hg_bulk_op_pool {
     bool extending;                          /* When extending the pool */
 };
 
-/* Wrapper on top of memcpy */
+/* Pool of bulk handles */
+struct hg_bulk_pool {
+    LIST_HEAD(, hg_bulk) free_list;  /* Free handles */
+    hg_thread_spin_t free_list_lock; /* Free list lock */
+    unsigned int count;              /* Number of free handles */
+    unsigned int max_count;          /* Max number of free handles */
+};
+
+/* Wrapper on top of memcpy (checksum is updated if crc_p is not NULL) */
 typedef void (*hg_bulk_copy_op_t)(void *local_address, hg_size_t local_offset,
-    void *remote_address, hg_size_t remote_offset, hg_size_t data_size);
+    void *remote_address, hg_size_t remote_offset, hg_size_t data_size,
+    uint32_t *crc_p);
 
 /* Wrapper on top of NA layer */
 typedef na_return_t (*na_bulk_op_t)(na_class_t *na_class, na_context_t *context,
@@ -248,6 +296,43 @@ hg_bulk_create(hg_core_class_t *core_class, uint32_t count, void **bufs,
 static hg_return_t
 hg_bulk_free(struct hg_bulk *hg_bulk);
 
+/**
+ * Get handle from pool (allocated if pool is empty).
+ */
+static struct hg_bulk *
+hg_bulk_pool_get(struct hg_bulk_pool *hg_bulk_pool);
+
+/**
+ * Return handle to pool (freed if pool is full).
+ */
+static void
+hg_bulk_pool_put(struct hg_bulk_pool *hg_bulk_pool, struct hg_bulk *hg_bulk);
+
+/**
+ * Register handle with NA (or NA SM) class if not already registered.
+ */
+static hg_return_t
+hg_bulk_register_na(struct hg_bulk *hg_bulk, bool sm);
+
+/**
+ * Register handle with bulk rail if not already registered.
+ */
+static hg_return_t
+hg_bulk_register_na_rail(struct hg_bulk *hg_bulk, unsigned int rail);
+
+/**
+ * Register handle segments with NA class if not already registered.
+ */
+static hg_return_t
+hg_bulk_register_na_descs(struct hg_bulk *hg_bulk, na_class_t *na_class,
+    struct hg_bulk_na_mem_desc *na_mem_descs, int32_t reg_bit);
+
+/**
+ * Free memory handles and addresses of bulk rails.
+ */
+static hg_return_t
+hg_bulk_free_rails(struct hg_bulk *hg_bulk);
+
 /**
  * Create NA memory descriptors.
  */
@@ -315,6 +400,26 @@ hg_bulk_serialize_mem_descs(na_class_t *na_class, char **buf_p,
     hg_size_t *buf_size_left_p, struct hg_bulk_na_mem_desc *na_mem_descs,
     const struct hg_bulk_segment *segments, uint32_t count);
 
+/**
+ * Get number of bulk rails that are serialized along handle.
+ */
+static unsigned int
+hg_bulk_get_serialize_rail_count(struct hg_bulk *hg_bulk, uint8_t flags);
+
+/**
+ * Get serialize size of bulk rails (excluding size prefix).
+ */
+static hg_size_t
+hg_bulk_get_serialize_size_rails(
+    struct hg_bulk *hg_bulk, unsigned int rail_count);
+
+/**
+ * Serialize memory handles and addresses of bulk rails.
+ */
+static hg_return_t
+hg_bulk_serialize_rails(struct hg_bulk *hg_bulk, char **buf_p,
+    hg_size_t *buf_size_left_p, unsigned int rail_count);
+
 /**
  * Deserialize bulk handle.
  */
@@ -330,6 +435,13 @@ hg_bulk_deserialize_mem_descs(na_class_t *na_class, const char **buf_p,
     hg_size_t *buf_size_left_p, struct hg_bulk_na_mem_desc *na_mem_descs,
     const struct hg_bulk_segment *segments, uint32_t count);
 
+/**
+ * Deserialize memory handles and addresses of bulk rails.
+ */
+static hg_return_t
+hg_bulk_deserialize_rails(struct hg_bulk *hg_bulk, const char **buf_p,
+    hg_size_t *buf_size_left_p);
+
 /**
  * Access bulk handle and get segment addresses/sizes.
  */
@@ -380,7 +492,7 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
  * Bulk transfer to self.
  */
 static void
-hg_bulk_transfer_self(hg_bulk_op_t op,
+hg_bulk_transfer_self(hg_bulk_op_t op, bool checksum,
     const struct hg_bulk_segment *origin_segments, uint32_t origin_count,
     hg_size_t origin_offset, const struct hg_bulk_segment *local_segments,
     uint32_t local_count, hg_size_t local_offset, hg_size_t size,
@@ -395,17 +507,22 @@ hg_bulk_transfer_segments_self(hg_bulk_copy_op_t copy_op,
     hg_size_t origin_segment_start_index, hg_size_t origin_segment_start_offset,
     const struct hg_bulk_segment *local_segments, uint32_t local_count,
     hg_size_t local_segment_start_index, hg_size_t local_segment_start_offset,
-    hg_size_t size);
+    hg_size_t size, uint32_t *crc_p);
 
 /**
  * Memcpy.
  */
 static HG_INLINE void
 hg_bulk_memcpy_put(void *local_address, hg_size_t local_offset,
-    void *remote_address, hg_size_t remote_offset, hg_size_t data_size)
+    void *remote_address, hg_size_t remote_offset, hg_size_t data_size,
+    uint32_t *crc_p)
 {
-    memcpy((char *) remote_address + remote_offset,
-        (const char *) local_address + local_offset, data_size);
+    if (crc_p)
+        *crc_p = hg_crc32c_copy(*crc_p, (char *) remote_address + remote_offset,
+            (const char *) local_address + local_offset, (size_t) data_size);
+    else
+        memcpy((char *) remote_address + remote_offset,
+            (const char *) local_address + local_offset, data_size);
 }
 
 /**
@@ -413,12 +530,25 @@ hg_bulk_memcpy_put(void *local_address, hg_size_t local_offset,
  */
 static HG_INLINE void
 hg_bulk_memcpy_get(void *local_address, hg_size_t local_offset,
-    void *remote_address, hg_size_t remote_offset, hg_size_t data_size)
+    void *remote_address, hg_size_t remote_offset, hg_size_t data_size,
+    uint32_t *crc_p)
 {
-    memcpy((char *) local_address + local_offset,
-        (const char *) remote_address + remote_offset, data_size);
+    if (crc_p)
+        *crc_p = hg_crc32c_copy(*crc_p, (char *) local_address + local_offset,
+            (const char *) remote_address + remote_offset, (size_t) data_size);
+    else
+        memcpy((char *) local_address + local_offset,
+            (const char *) remote_address + remote_offset, data_size);
 }
 
+/**
+ * Compute CRC32C of data described by segments.
+ */
+static uint32_t
+hg_bulk_crc32c_segments(const struct hg_bulk_segment *segments,
+    uint32_t count, hg_size_t segment_start_index,
+    hg_size_t segment_start_offset, hg_size_t size);
+
 /**
  * Bulk transfer over NA.
  */
@@ -429,9 +559,51 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
     uint8_t origin_flags, hg_size_t origin_offset,
     const struct hg_bulk_segment *local_segments, uint32_t local_count,
     na_mem_handle_t **local_mem_handles, uint8_t local_flags,
-    hg_size_t local_offset, hg_size_t size,
+    hg_size_t local_offset, hg_size_t size, bool checksum,
     struct hg_bulk_op_id *hg_bulk_op_id);
 
+/**
+ * Bulk transfer striped across bulk rails.
+ */
+static hg_return_t
+hg_bulk_transfer_rails(hg_bulk_op_t op, struct hg_core_addr *origin_addr,
+    uint8_t origin_id, struct hg_bulk *hg_bulk_origin, hg_size_t origin_offset,
+    struct hg_bulk *hg_bulk_local, hg_size_t local_offset, hg_size_t size,
+    bool checksum, struct hg_bulk_op_id *hg_bulk_op_id);
+
+/**
+ * Get number of NA operations required to transfer data.
+ */
+static uint32_t
+hg_bulk_transfer_na_get_op_count(const struct hg_bulk_segment *origin_segments,
+    uint32_t origin_count, uint8_t origin_flags, hg_size_t origin_offset,
+    const struct hg_bulk_segment *local_segments, uint32_t local_count,
+    uint8_t local_flags, hg_size_t local_offset, hg_size_t size);
+
+/**
+ * Issue NA operations to transfer data through a given NA class.
+ */
+static hg_return_t
+hg_bulk_transfer_na_ops(hg_bulk_op_t op, na_class_t *na_class,
+    na_context_t *na_context, na_addr_t *na_origin_addr, uint8_t origin_id,
+    const struct hg_bulk_segment *origin_segments, uint32_t origin_count,
+    na_mem_handle_t **origin_mem_handles, uint8_t origin_flags,
+    hg_size_t origin_offset, const struct hg_bulk_segment *local_segments,
+    uint32_t local_count, na_mem_handle_t **local_mem_handles,
+    uint8_t local_flags, hg_size_t local_offset, hg_size_t size,
+    hg_bulk_na_op_id_t *hg_bulk_na_op_ids, uint32_t na_op_count,
+    struct hg_bulk_crc_chunk *crc_chunks, struct hg_bulk_op_id *hg_bulk_op_id,
+    uint32_t *posted_count_p);
+
+/**
+ * Abort transfer that was only partially posted. Operations already posted
+ * are canceled and the ones that were not are accounted for, so that the
+ * bulk operation completes with ret once posted operations complete.
+ */
+static void
+hg_bulk_transfer_abort(struct hg_bulk_op_id *hg_bulk_op_id, hg_return_t ret,
+    const uint32_t *posted_counts, unsigned int rail_count);
+
 /**
  * Get number of required operations to transfer data.
  */
@@ -456,7 +628,8 @@ hg_bulk_transfer_segments_na(na_class_t *na_class, na_context_t *na_context,
     const struct hg_bulk_segment *local_segments, uint32_t local_count,
     na_mem_handle_t **local_mem_handles, hg_size_t local_segment_start_index,
     hg_size_t local_segment_start_offset, hg_size_t size,
-    na_op_id_t *na_op_ids[], uint32_t na_op_count);
+    na_op_id_t *na_op_ids[], struct hg_bulk_crc_chunk *crc_chunks,
+    uint32_t na_op_count, uint32_t *posted_count_p);
 
 /**
  * NA_Put wrapper
@@ -494,6 +667,19 @@ hg_bulk_na_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
 static void
 hg_bulk_transfer_cb(const struct na_cb_info *callback_info);
 
+/**
+ * Transfer callback (checksum requested).
+ */
+static void
+hg_bulk_transfer_crc_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Complete one NA operation of a bulk operation.
+ */
+static void
+hg_bulk_transfer_op_complete(
+    struct hg_bulk_op_id *hg_bulk_op_id, na_return_t na_ret);
+
 /**
  * Complete operation ID.
  */
@@ -523,9 +709,10 @@ hg_bulk_create(hg_core_class_t *core_class, uint32_t count, void **bufs,
 #ifdef NA_HAS_SM
     na_class_t *na_sm_class = HG_Core_class_get_na_sm(core_class);
 #endif
+    const struct hg_core_rails *rails = hg_core_class_get_rails(core_class);
     hg_return_t ret;
 
-    hg_bulk = (struct hg_bulk *) calloc(1, sizeof(*hg_bulk));
+    hg_bulk = hg_bulk_pool_get(hg_core_class_get_bulk_pool(core_class));
     HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk == NULL, error, ret, HG_NOMEM,
         "Could not allocate handle");
 
@@ -540,6 +727,14 @@ hg_bulk_create(hg_core_class_t *core_class, uint32_t count, void **bufs,
     hg_atomic_init32(&hg_bulk->ref_count, 1);
     hg_core_bulk_incr(core_class);
 
+    if (rails->count > 0) {
+        /* Memory handles of bulk rails */
+        hg_bulk->rails = (struct hg_bulk_rail *) calloc(
+            rails->count, sizeof(struct hg_bulk_rail));
+        HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk->rails == NULL, error, ret,
+            HG_NOMEM, "Could not allocate bulk rails");
+    }
+
     if (count > HG_BULK_STATIC_MAX) {
         /* Allocate segments */
         hg_bulk->desc.segments.d = (struct hg_bulk_segment *) calloc(
@@ -606,49 +801,27 @@ hg_bulk_create(hg_core_class_t *core_class, uint32_t count, void **bufs,
                 "SM class cannot register %" PRIu32 " segments", count);
         }
 #endif
-    }
 
-    /* Register using one single descriptor if supported */
-    if (hg_bulk->desc.info.flags & HG_BULK_REGV) {
-        /* Register segments */
-        ret =
-            hg_bulk_register_segments(na_class, (struct na_segment *) segments,
-                count, flags, (enum na_mem_type) attrs->mem_type, attrs->device,
-                &hg_bulk->na_mem_descs.handles.s[0],
-                &hg_bulk->na_mem_descs.serialize_sizes.s[0]);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            bulk, error, ret, "Could not register segments");
+        /* Make sure bulk rails can register as many segments */
+        if (hg_bulk->desc.info.flags & HG_BULK_REGV) {
+            unsigned int i;
 
-#ifdef NA_HAS_SM
-        if (na_sm_class) {
-            /* Register segments */
-            ret = hg_bulk_register_segments(na_sm_class,
-                (struct na_segment *) segments, count, flags,
-                (enum na_mem_type) attrs->mem_type, attrs->device,
-                &hg_bulk->na_sm_mem_descs.handles.s[0],
-                &hg_bulk->na_sm_mem_descs.serialize_sizes.s[0]);
-            HG_CHECK_SUBSYS_HG_ERROR(
-                bulk, error, ret, "Could not register segments with SM");
-        }
-#endif
-    } else {
-        /* Register segments individually */
-        ret = hg_bulk_create_na_mem_descs(&hg_bulk->na_mem_descs, na_class,
-            segments, count, flags, (enum na_mem_type) attrs->mem_type,
-            attrs->device);
-        HG_CHECK_SUBSYS_HG_ERROR(
-            bulk, error, ret, "Could not create NA mem descriptors");
+            for (i = 0; i < rails->count; i++) {
+                na_class_t *na_rail_class = rails->rails[i].na_class;
 
-#ifdef NA_HAS_SM
-        if (na_sm_class) {
-            ret = hg_bulk_create_na_mem_descs(&hg_bulk->na_sm_mem_descs,
-                na_sm_class, segments, count, flags,
-                (enum na_mem_type) attrs->mem_type, attrs->device);
-            HG_CHECK_SUBSYS_HG_ERROR(
-                bulk, error, ret, "Could not create NA SM mem descriptors");
+                HG_CHECK_SUBSYS_ERROR(bulk,
+                    !na_rail_class->ops->mem_handle_create_segments ||
+                        count > na_rail_class->ops->mem_handle_get_max_segments(
+                                    na_rail_class),
+                    error, ret, HG_OPNOTSUPPORTED,
+                    "Bulk rail %u cannot register %" PRIu32 " segments", i,
+                    count);
+            }
         }
-#endif
     }
+
+    /* Registration is deferred until the handle is first serialized for, or
+     * transferred through, a given transport */
     hg_bulk->registered = true;
 
     *hg_bulk_p = hg_bulk;
@@ -712,6 +885,11 @@ hg_bulk_free(struct hg_bulk *hg_bulk)
 #endif
     }
 
+    if (hg_bulk->rails != NULL) {
+        ret = hg_bulk_free_rails(hg_bulk);
+        HG_CHECK_SUBSYS_HG_ERROR(bulk, error, ret, "Could not free bulk rails");
+    }
+
     /* Free addr if any was attached to handle */
     if (hg_bulk->desc.info.flags & HG_BULK_BIND) {
         ret = HG_Core_addr_free(hg_bulk->addr);
@@ -734,7 +912,224 @@ hg_bulk_free(struct hg_bulk *hg_bulk)
         free(segments);
 
     hg_core_bulk_decr(hg_bulk->core_class);
+    hg_bulk_pool_put(hg_core_class_get_bulk_pool(hg_bulk->core_class), hg_bulk);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_bulk_pool_create(
+    unsigned int max_count, struct hg_bulk_pool **hg_bulk_pool_p)
+{
+    struct hg_bulk_pool *hg_bulk_pool = NULL;
+    hg_return_t ret;
+
+    hg_bulk_pool = (struct hg_bulk_pool *) calloc(1, sizeof(*hg_bulk_pool));
+    HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk_pool == NULL, error, ret, HG_NOMEM,
+        "Could not allocate bulk pool");
+
+    LIST_INIT(&hg_bulk_pool->free_list);
+    hg_thread_spin_init(&hg_bulk_pool->free_list_lock);
+    hg_bulk_pool->max_count = max_count;
+
+    HG_LOG_SUBSYS_DEBUG(bulk, "Created bulk pool (%p), max %u handles",
+        (void *) hg_bulk_pool, max_count);
+
+    *hg_bulk_pool_p = hg_bulk_pool;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_bulk_pool_destroy(struct hg_bulk_pool *hg_bulk_pool)
+{
+    struct hg_bulk *hg_bulk;
+
+    HG_LOG_SUBSYS_DEBUG(bulk, "Free bulk pool (%p)", (void *) hg_bulk_pool);
+
+    hg_thread_spin_lock(&hg_bulk_pool->free_list_lock);
+    while ((hg_bulk = LIST_FIRST(&hg_bulk_pool->free_list)) != NULL) {
+        LIST_REMOVE(hg_bulk, entry);
+        free(hg_bulk);
+    }
+    hg_thread_spin_unlock(&hg_bulk_pool->free_list_lock);
+
+    hg_thread_spin_destroy(&hg_bulk_pool->free_list_lock);
+
+    free(hg_bulk_pool);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_bulk *
+hg_bulk_pool_get(struct hg_bulk_pool *hg_bulk_pool)
+{
+    struct hg_bulk *hg_bulk;
+
+    hg_thread_spin_lock(&hg_bulk_pool->free_list_lock);
+    if ((hg_bulk = LIST_FIRST(&hg_bulk_pool->free_list)) != NULL) {
+        LIST_REMOVE(hg_bulk, entry);
+        hg_bulk_pool->count--;
+    }
+    hg_thread_spin_unlock(&hg_bulk_pool->free_list_lock);
+
+    if (hg_bulk == NULL) {
+        hg_bulk = (struct hg_bulk *) calloc(1, sizeof(*hg_bulk));
+        if (hg_bulk == NULL)
+            return NULL;
+    } else
+        memset(hg_bulk, 0, sizeof(*hg_bulk));
+    hg_thread_mutex_init(&hg_bulk->reg_mutex);
+
+    return hg_bulk;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_pool_put(struct hg_bulk_pool *hg_bulk_pool, struct hg_bulk *hg_bulk)
+{
+    hg_thread_mutex_destroy(&hg_bulk->reg_mutex);
+
+    hg_thread_spin_lock(&hg_bulk_pool->free_list_lock);
+    if (hg_bulk_pool->count < hg_bulk_pool->max_count) {
+        LIST_INSERT_HEAD(&hg_bulk_pool->free_list, hg_bulk, entry);
+        hg_bulk_pool->count++;
+        hg_bulk = NULL;
+    }
+    hg_thread_spin_unlock(&hg_bulk_pool->free_list_lock);
+
     free(hg_bulk);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_register_na(struct hg_bulk *hg_bulk, bool sm)
+{
+#ifdef NA_HAS_SM
+    /* Fall back to NA class if there is no SM class */
+    if (sm && hg_bulk->na_sm_class != NULL)
+        return hg_bulk_register_na_descs(hg_bulk, hg_bulk->na_sm_class,
+            &hg_bulk->na_sm_mem_descs, HG_BULK_NA_SM_REG);
+#else
+    (void) sm;
+#endif
+
+    return hg_bulk_register_na_descs(
+        hg_bulk, hg_bulk->na_class, &hg_bulk->na_mem_descs, HG_BULK_NA_REG);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_register_na_rail(struct hg_bulk *hg_bulk, unsigned int rail)
+{
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk->core_class);
+
+    return hg_bulk_register_na_descs(hg_bulk, rails->rails[rail].na_class,
+        &hg_bulk->rails[rail].na_mem_descs, HG_BULK_NA_RAIL_REG(rail));
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_register_na_descs(struct hg_bulk *hg_bulk, na_class_t *na_class,
+    struct hg_bulk_na_mem_desc *na_mem_descs, int32_t reg_bit)
+{
+    struct hg_bulk_segment *segments = HG_BULK_SEGMENTS(hg_bulk);
+    uint32_t count = hg_bulk->desc.info.segment_count;
+    uint8_t flags = hg_bulk->desc.info.flags & HG_BULK_READWRITE;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Deserialized handles carry remote memory handles */
+    if (!hg_bulk->registered)
+        return HG_SUCCESS;
+
+    if (hg_atomic_get32(&hg_bulk->na_reg) & reg_bit)
+        return HG_SUCCESS;
+
+    hg_thread_mutex_lock(&hg_bulk->reg_mutex);
+
+    /* Another thread may have registered it in the meantime */
+    if (hg_atomic_get32(&hg_bulk->na_reg) & reg_bit)
+        goto unlock;
+
+    HG_LOG_SUBSYS_DEBUG(bulk, "Registering %u segment(s) with %s class",
+        count, NA_Get_class_name(na_class));
+
+    if (hg_bulk->desc.info.flags & HG_BULK_REGV) {
+        /* Register using one single descriptor */
+        ret = hg_bulk_register_segments(na_class,
+            (struct na_segment *) segments, count, flags,
+            (enum na_mem_type) hg_bulk->attrs.mem_type, hg_bulk->attrs.device,
+            &na_mem_descs->handles.s[0], &na_mem_descs->serialize_sizes.s[0]);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, unlock, ret, "Could not register segments");
+    } else {
+        /* Register segments individually */
+        ret = hg_bulk_create_na_mem_descs(na_mem_descs, na_class, segments,
+            count, flags, (enum na_mem_type) hg_bulk->attrs.mem_type,
+            hg_bulk->attrs.device);
+        if (ret != HG_SUCCESS) {
+            HG_LOG_SUBSYS_ERROR(bulk, "Could not create NA mem descriptors");
+            /* Release partial registration so that it can be retried */
+            (void) hg_bulk_free_na_mem_descs(na_mem_descs, na_class, count,
+                hg_bulk->registered);
+            memset(na_mem_descs, 0, sizeof(*na_mem_descs));
+            goto unlock;
+        }
+    }
+
+    hg_atomic_or32(&hg_bulk->na_reg, reg_bit);
+
+unlock:
+    hg_thread_mutex_unlock(&hg_bulk->reg_mutex);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_free_rails(struct hg_bulk *hg_bulk)
+{
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk->core_class);
+    /* Deserialized handles only carry rails that the peer described */
+    unsigned int rail_count =
+        hg_bulk->registered ? rails->count : hg_bulk->desc.info.rail_count;
+    hg_return_t ret;
+    unsigned int i;
+
+    for (i = 0; i < rail_count; i++) {
+        struct hg_bulk_rail *rail = &hg_bulk->rails[i];
+        na_class_t *na_class = rails->rails[i].na_class;
+
+        if ((hg_bulk->desc.info.flags & HG_BULK_REGV) ||
+            (hg_bulk->desc.info.segment_count == 1)) {
+            if (rail->na_mem_descs.handles.s[0] != NULL) {
+                ret = hg_bulk_deregister(na_class,
+                    rail->na_mem_descs.handles.s[0], hg_bulk->registered);
+                HG_CHECK_SUBSYS_HG_ERROR(
+                    bulk, error, ret, "Could not deregister rail segment");
+            }
+        } else {
+            ret = hg_bulk_free_na_mem_descs(&rail->na_mem_descs, na_class,
+                hg_bulk->desc.info.segment_count, hg_bulk->registered);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                bulk, error, ret, "Could not free rail mem descriptors");
+        }
+
+        if (rail->na_addr != NULL)
+            NA_Addr_free(na_class, rail->na_addr);
+    }
+
+    free(hg_bulk->rails);
+    hg_bulk->rails = NULL;
 
     return HG_SUCCESS;
 
@@ -975,6 +1370,8 @@ static hg_size_t
 hg_bulk_get_serialize_size(struct hg_bulk *hg_bulk, uint8_t flags)
 {
     struct hg_bulk_desc_info *desc_info = &hg_bulk->desc.info;
+    const struct hg_bulk_segment *segments = HG_BULK_SEGMENTS(hg_bulk);
+    unsigned int rail_count;
     hg_size_t ret = 0;
 
     /* Descriptor info + segments */
@@ -983,9 +1380,13 @@ hg_bulk_get_serialize_size(struct hg_bulk *hg_bulk, uint8_t flags)
 
     /* Memory handles */
     if ((desc_info->flags & HG_BULK_REGV) || (desc_info->segment_count == 1)) {
-        /* Only one single memory handle in that case */
+        /* Only one single memory handle in that case (size is still encoded
+         * if handle was not registered with NA) */
         if (hg_bulk->na_mem_descs.handles.s[0] != NULL)
             ret += hg_bulk->na_mem_descs.serialize_sizes.s[0] + sizeof(size_t);
+        else if ((segments[0].base != NULL) ||
+                 (desc_info->flags & HG_BULK_REGV))
+            ret += sizeof(size_t);
 
 #ifdef NA_HAS_SM
         /* Only add SM serialized handles if we're sending over SM, otherwise
@@ -1008,6 +1409,12 @@ hg_bulk_get_serialize_size(struct hg_bulk *hg_bulk, uint8_t flags)
 #endif
     }
 
+    /* Bulk rails (size prefix + memory handles and addresses) */
+    rail_count = hg_bulk_get_serialize_rail_count(hg_bulk, flags);
+    if (rail_count > 0)
+        ret += sizeof(hg_size_t) +
+               hg_bulk_get_serialize_size_rails(hg_bulk, rail_count);
+
     /* Address information (context ID + serialize size + address) */
     if (desc_info->flags & HG_BULK_BIND) {
         unsigned long addr_flags = 0;
@@ -1050,6 +1457,10 @@ hg_bulk_get_serialize_size_mem_descs(
     /* Serialize sizes */
     ret += count * sizeof(size_t);
 
+    /* Handles may not have been registered yet */
+    if (na_mem_handles == NULL)
+        return ret;
+
     for (i = 0; i < count; i++)
         if (na_mem_handles[i] != NULL)
             ret += na_mem_serialize_sizes[i];
@@ -1068,6 +1479,11 @@ hg_bulk_serialize(
     struct hg_bulk_desc_info desc_info = hg_bulk->desc.info; /* Copy info */
     hg_return_t ret;
 
+    /* Register with the transports that the handle is serialized for */
+    ret = hg_bulk_register_serialize(hg_bulk, flags);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        bulk, error, ret, "Could not register bulk handle");
+
     /* Always reset bulk alloc flag (only local) */
     desc_info.flags &= (~HG_BULK_ALLOC & 0xff);
 
@@ -1091,6 +1507,10 @@ hg_bulk_serialize(
         desc_info.flags &= (~HG_BULK_SM & 0xff);
 #endif
 
+    /* Describe bulk rails if any can be used by the peer */
+    desc_info.rail_count =
+        (uint8_t) hg_bulk_get_serialize_rail_count(hg_bulk, desc_info.flags);
+
     HG_LOG_SUBSYS_DEBUG(bulk,
         "Serializing bulk handle with %u segment(s), len is %" PRIu64 " bytes",
         desc_info.segment_count, desc_info.len);
@@ -1123,6 +1543,13 @@ hg_bulk_serialize(
                 NA_Error_to_string(na_ret));
             buf_ptr += hg_bulk->na_mem_descs.serialize_sizes.s[0];
             buf_size_left -= hg_bulk->na_mem_descs.serialize_sizes.s[0];
+        } else if ((segments[0].base != NULL) ||
+                   (desc_info.flags & HG_BULK_REGV)) {
+            size_t serialize_size = 0;
+
+            /* Not registered with NA, only encode an empty size */
+            HG_BULK_ENCODE(error, ret, buf_ptr, buf_size_left, &serialize_size,
+                size_t);
         }
 
 #ifdef NA_HAS_SM
@@ -1168,6 +1595,17 @@ hg_bulk_serialize(
 #endif
     }
 
+    /* Bulk rails */
+    if (desc_info.rail_count > 0) {
+        HG_LOG_SUBSYS_DEBUG(
+            bulk, "Serializing %u bulk rail(s)", desc_info.rail_count);
+
+        ret = hg_bulk_serialize_rails(
+            hg_bulk, &buf_ptr, &buf_size_left, desc_info.rail_count);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, error, ret, "Could not serialize bulk rails");
+    }
+
     /* Address information */
     if (desc_info.flags & HG_BULK_BIND) {
         hg_size_t serialize_size;
@@ -1239,15 +1677,24 @@ hg_bulk_serialize_mem_descs(na_class_t *na_class, char **buf_p,
         na_mem_serialize_sizes = na_mem_descs->serialize_sizes.s;
     }
 
-    /* Encode serialize sizes */
+    /* Encode serialize sizes (empty if handles were not registered) */
+    if (na_mem_handles == NULL) {
+        size_t serialize_size = 0;
+
+        for (i = 0; i < count; i++)
+            HG_BULK_ENCODE(error, ret, *buf_p, *buf_size_left_p,
+                &serialize_size, size_t);
+
+        return HG_SUCCESS;
+    }
     HG_BULK_ENCODE_ARRAY(error, ret, *buf_p, *buf_size_left_p,
         na_mem_serialize_sizes, size_t, count);
 
     for (i = 0; i < count; i++) {
         na_return_t na_ret;
 
-        /* Skip null segments */
-        if (segments[i].base == NULL)
+        /* Skip null segments and handles that were not registered */
+        if (segments[i].base == NULL || na_mem_handles[i] == NULL)
             continue;
 
         na_ret = NA_Mem_handle_serialize(
@@ -1266,6 +1713,121 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static unsigned int
+hg_bulk_get_serialize_rail_count(struct hg_bulk *hg_bulk, uint8_t flags)
+{
+    /* Only the owner of the memory can describe rails, SM and eager
+     * transfers do not go through them */
+    if (!hg_bulk->registered || hg_bulk->rails == NULL || (flags & HG_BULK_SM))
+        return 0;
+    if ((flags & HG_BULK_EAGER) &&
+        (hg_bulk->desc.info.flags & HG_BULK_READ_ONLY) &&
+        !(hg_bulk->desc.info.flags & HG_BULK_VIRT) &&
+        (hg_bulk->attrs.mem_type == HG_MEM_TYPE_HOST))
+        return 0;
+
+    return hg_core_class_get_rails(hg_bulk->core_class)->count;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_size_t
+hg_bulk_get_serialize_size_rails(
+    struct hg_bulk *hg_bulk, unsigned int rail_count)
+{
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk->core_class);
+    const struct hg_bulk_desc_info *desc_info = &hg_bulk->desc.info;
+    hg_size_t ret = 0;
+    unsigned int i;
+
+    for (i = 0; i < rail_count; i++) {
+        struct hg_bulk_na_mem_desc *na_mem_descs =
+            &hg_bulk->rails[i].na_mem_descs;
+
+        /* Memory handles (size is always encoded for single handles) */
+        if ((desc_info->flags & HG_BULK_REGV) ||
+            (desc_info->segment_count == 1)) {
+            ret += sizeof(size_t);
+            if (na_mem_descs->handles.s[0] != NULL)
+                ret += na_mem_descs->serialize_sizes.s[0];
+        } else
+            ret += hg_bulk_get_serialize_size_mem_descs(
+                na_mem_descs, desc_info->segment_count);
+
+        /* Address of owner on that rail */
+        ret += sizeof(size_t) + rails->rails[i].self_addr_size;
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_serialize_rails(struct hg_bulk *hg_bulk, char **buf_p,
+    hg_size_t *buf_size_left_p, unsigned int rail_count)
+{
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk->core_class);
+    const struct hg_bulk_desc_info *desc_info = &hg_bulk->desc.info;
+    hg_size_t rails_size;
+    hg_return_t ret;
+    unsigned int i;
+
+    /* Size of rail info first so that peers with fewer rails can skip it */
+    rails_size = hg_bulk_get_serialize_size_rails(hg_bulk, rail_count);
+    HG_BULK_ENCODE(
+        error, ret, *buf_p, *buf_size_left_p, &rails_size, hg_size_t);
+
+    for (i = 0; i < rail_count; i++) {
+        struct hg_bulk_na_mem_desc *na_mem_descs =
+            &hg_bulk->rails[i].na_mem_descs;
+        na_class_t *na_class = rails->rails[i].na_class;
+        na_return_t na_ret;
+
+        if ((desc_info->flags & HG_BULK_REGV) ||
+            (desc_info->segment_count == 1)) {
+            size_t serialize_size = (na_mem_descs->handles.s[0] != NULL)
+                                        ? na_mem_descs->serialize_sizes.s[0]
+                                        : 0;
+
+            HG_BULK_ENCODE(error, ret, *buf_p, *buf_size_left_p,
+                &serialize_size, size_t);
+            if (serialize_size > 0) {
+                na_ret = NA_Mem_handle_serialize(na_class, *buf_p,
+                    *buf_size_left_p, na_mem_descs->handles.s[0]);
+                HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
+                    (hg_return_t) na_ret,
+                    "Could not serialize rail memory handle (%s)",
+                    NA_Error_to_string(na_ret));
+                *buf_p += serialize_size;
+                *buf_size_left_p -= serialize_size;
+            }
+        } else {
+            ret = hg_bulk_serialize_mem_descs(na_class, buf_p,
+                buf_size_left_p, na_mem_descs, HG_BULK_SEGMENTS(hg_bulk),
+                desc_info->segment_count);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                bulk, error, ret, "Could not serialize rail mem descriptors");
+        }
+
+        HG_BULK_ENCODE(error, ret, *buf_p, *buf_size_left_p,
+            &rails->rails[i].self_addr_size, size_t);
+        na_ret = NA_Addr_serialize(na_class, *buf_p, *buf_size_left_p,
+            rails->rails[i].self_addr);
+        HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not serialize rail address (%s)",
+            NA_Error_to_string(na_ret));
+        *buf_p += rails->rails[i].self_addr_size;
+        *buf_size_left_p -= rails->rails[i].self_addr_size;
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_bulk_deserialize(hg_core_class_t *core_class, struct hg_bulk **hg_bulk_p,
@@ -1277,7 +1839,7 @@ hg_bulk_deserialize(hg_core_class_t *core_class, struct hg_bulk **hg_bulk_p,
     hg_size_t buf_size_left = buf_size;
     hg_return_t ret;
 
-    hg_bulk = (struct hg_bulk *) calloc(1, sizeof(*hg_bulk));
+    hg_bulk = hg_bulk_pool_get(hg_core_class_get_bulk_pool(core_class));
     HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk == NULL, error, ret, HG_NOMEM,
         "Could not allocate handle");
 
@@ -1333,14 +1895,18 @@ hg_bulk_deserialize(hg_core_class_t *core_class, struct hg_bulk **hg_bulk_p,
             HG_BULK_DECODE(error, ret, buf_ptr, buf_size_left,
                 &hg_bulk->na_mem_descs.serialize_sizes.s[0], size_t);
 
-            na_ret = NA_Mem_handle_deserialize(hg_bulk->na_class,
-                &hg_bulk->na_mem_descs.handles.s[0], buf_ptr, buf_size_left);
-            HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
-                (hg_return_t) na_ret,
-                "Could not deserialize memory handle (%s)",
-                NA_Error_to_string(na_ret));
-            buf_ptr += hg_bulk->na_mem_descs.serialize_sizes.s[0];
-            buf_size_left -= hg_bulk->na_mem_descs.serialize_sizes.s[0];
+            /* Empty size if handle was not registered with NA */
+            if (hg_bulk->na_mem_descs.serialize_sizes.s[0] > 0) {
+                na_ret = NA_Mem_handle_deserialize(hg_bulk->na_class,
+                    &hg_bulk->na_mem_descs.handles.s[0], buf_ptr,
+                    buf_size_left);
+                HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
+                    (hg_return_t) na_ret,
+                    "Could not deserialize memory handle (%s)",
+                    NA_Error_to_string(na_ret));
+                buf_ptr += hg_bulk->na_mem_descs.serialize_sizes.s[0];
+                buf_size_left -= hg_bulk->na_mem_descs.serialize_sizes.s[0];
+            }
 
 #ifdef NA_HAS_SM
             /* Only deserialize handles if we were sending over SM */
@@ -1382,6 +1948,16 @@ hg_bulk_deserialize(hg_core_class_t *core_class, struct hg_bulk **hg_bulk_p,
 #endif
     }
 
+    /* Bulk rails */
+    if (hg_bulk->desc.info.rail_count > 0) {
+        HG_LOG_SUBSYS_DEBUG(bulk, "Deserializing %u bulk rail(s)",
+            hg_bulk->desc.info.rail_count);
+
+        ret = hg_bulk_deserialize_rails(hg_bulk, &buf_ptr, &buf_size_left);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, error, ret, "Could not deserialize bulk rails");
+    }
+
     /* Address information */
     if (hg_bulk->desc.info.flags & HG_BULK_BIND) {
         hg_size_t serialize_size;
@@ -1480,8 +2056,8 @@ hg_bulk_deserialize_mem_descs(na_class_t *na_class, const char **buf_p,
     for (i = 0; i < count; i++) {
         na_return_t na_ret;
 
-        /* Skip null segments */
-        if (segments[i].base == NULL)
+        /* Skip null segments and handles that were not registered */
+        if (segments[i].base == NULL || na_mem_serialize_sizes[i] == 0)
             continue;
 
         na_ret = NA_Mem_handle_deserialize(
@@ -1500,6 +2076,121 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_deserialize_rails(struct hg_bulk *hg_bulk, const char **buf_p,
+    hg_size_t *buf_size_left_p)
+{
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk->core_class);
+    struct hg_bulk_desc_info *desc_info = &hg_bulk->desc.info;
+    unsigned int rail_count = desc_info->rail_count, i;
+    const char *rails_end;
+    hg_size_t rails_size;
+    hg_return_t ret;
+
+    /* Only use rails that were also configured locally */
+    desc_info->rail_count = 0;
+    if (rail_count > rails->count)
+        rail_count = rails->count;
+
+    HG_BULK_DECODE(
+        error, ret, *buf_p, *buf_size_left_p, &rails_size, hg_size_t);
+    HG_CHECK_SUBSYS_ERROR(bulk, rails_size > *buf_size_left_p, error, ret,
+        HG_OVERFLOW, "Rail info size (%" PRIu64 ") exceeds buffer size",
+        rails_size);
+    rails_end = *buf_p + rails_size;
+
+    if (rail_count > 0) {
+        hg_bulk->rails = (struct hg_bulk_rail *) calloc(
+            rail_count, sizeof(struct hg_bulk_rail));
+        HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk->rails == NULL, error, ret,
+            HG_NOMEM, "Could not allocate bulk rails");
+        desc_info->rail_count = (uint8_t) rail_count;
+    }
+
+    for (i = 0; i < rail_count; i++) {
+        struct hg_bulk_rail *rail = &hg_bulk->rails[i];
+        na_class_t *na_class = rails->rails[i].na_class;
+        size_t addr_size;
+        na_return_t na_ret;
+
+        if ((desc_info->flags & HG_BULK_REGV) ||
+            (desc_info->segment_count == 1)) {
+            HG_BULK_DECODE(error, ret, *buf_p, *buf_size_left_p,
+                &rail->na_mem_descs.serialize_sizes.s[0], size_t);
+            if (rail->na_mem_descs.serialize_sizes.s[0] > 0) {
+                na_ret = NA_Mem_handle_deserialize(na_class,
+                    &rail->na_mem_descs.handles.s[0], *buf_p,
+                    *buf_size_left_p);
+                HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
+                    (hg_return_t) na_ret,
+                    "Could not deserialize rail memory handle (%s)",
+                    NA_Error_to_string(na_ret));
+                *buf_p += rail->na_mem_descs.serialize_sizes.s[0];
+                *buf_size_left_p -= rail->na_mem_descs.serialize_sizes.s[0];
+            }
+        } else {
+            ret = hg_bulk_deserialize_mem_descs(na_class, buf_p,
+                buf_size_left_p, &rail->na_mem_descs,
+                HG_BULK_SEGMENTS(hg_bulk), desc_info->segment_count);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                bulk, error, ret, "Could not deserialize rail mem descriptors");
+        }
+
+        HG_BULK_DECODE(
+            error, ret, *buf_p, *buf_size_left_p, &addr_size, size_t);
+        na_ret =
+            NA_Addr_deserialize(na_class, &rail->na_addr, *buf_p, addr_size);
+        HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not deserialize rail address (%s)",
+            NA_Error_to_string(na_ret));
+        *buf_p += addr_size;
+        *buf_size_left_p -= addr_size;
+    }
+
+    /* Skip rails that are not configured locally */
+    *buf_size_left_p -= (hg_size_t) (rails_end - *buf_p);
+    *buf_p = rails_end;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_bulk_register_serialize(struct hg_bulk *hg_bulk, uint8_t flags)
+{
+    unsigned int rail_count, i;
+    hg_return_t ret;
+
+    ret = hg_bulk_register_na(hg_bulk, (flags & HG_BULK_SM) != 0);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        bulk, error, ret, "Could not register bulk handle");
+
+    /* Bound handles may be forwarded by the SM peer to peers that are not
+     * local, they must always carry an NA memory handle */
+    if ((flags & HG_BULK_SM) && (hg_bulk->desc.info.flags & HG_BULK_BIND)) {
+        ret = hg_bulk_register_na(hg_bulk, false);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, error, ret, "Could not register bound bulk handle with NA");
+    }
+
+    rail_count = hg_bulk_get_serialize_rail_count(hg_bulk, flags);
+    for (i = 0; i < rail_count; i++) {
+        ret = hg_bulk_register_na_rail(hg_bulk, i);
+        HG_CHECK_SUBSYS_HG_ERROR(bulk, error, ret,
+            "Could not register bulk handle with rail %u", i);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 void *
 hg_bulk_get_serialize_cached_ptr(struct hg_bulk *hg_bulk)
@@ -1604,7 +2295,10 @@ hg_bulk_op_create(
     hg_core_context_t *core_context, struct hg_bulk_op_id **hg_bulk_op_id_p)
 {
     struct hg_bulk_op_id *hg_bulk_op_id = NULL;
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(core_context->core_class);
     hg_return_t ret;
+    unsigned int r;
     int i;
 
     hg_bulk_op_id = (struct hg_bulk_op_id *) calloc(1, sizeof(*hg_bulk_op_id));
@@ -1640,6 +2334,15 @@ hg_bulk_op_create(
         }
     }
 #endif
+    for (r = 0; r < rails->count; r++) {
+        for (i = 0; i < HG_BULK_STATIC_MAX; i++) {
+            hg_bulk_op_id->rail_ops[r].na_op_ids.s[i] =
+                NA_Op_create(rails->rails[r].na_class, 0);
+            HG_CHECK_SUBSYS_ERROR(bulk,
+                hg_bulk_op_id->rail_ops[r].na_op_ids.s[i] == NULL, error, ret,
+                HG_NA_ERROR, "NA_Op_create() failed");
+        }
+    }
 
     HG_LOG_SUBSYS_DEBUG(
         bulk, "Created new bulk op ID (%p)", (void *) hg_bulk_op_id);
@@ -1666,6 +2369,15 @@ error:
                 hg_bulk_op_id->na_sm_op_ids.s[i]);
         }
 #endif
+        for (r = 0; r < rails->count; r++) {
+            for (i = 0; i < HG_BULK_STATIC_MAX; i++) {
+                if (hg_bulk_op_id->rail_ops[r].na_op_ids.s[i] == NULL)
+                    continue;
+
+                NA_Op_destroy(rails->rails[r].na_class,
+                    hg_bulk_op_id->rail_ops[r].na_op_ids.s[i]);
+            }
+        }
         free(hg_bulk_op_id);
     }
     return ret;
@@ -1675,14 +2387,20 @@ error:
 static void
 hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
 {
-    uint32_t i;
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk_op_id->core_context->core_class);
+    uint32_t i, r;
 
     if (hg_atomic_decr32(&hg_bulk_op_id->ref_count))
         return; /* Cannot free yet */
 
+    /* Checksums are only allocated when requested */
+    free(hg_bulk_op_id->crc_chunks);
+    hg_bulk_op_id->crc_chunks = NULL;
+
     /* We may have used extra op IDs if this NA class was used */
     if (hg_bulk_op_id->na_class &&
-        hg_bulk_op_id->op_count > HG_BULK_STATIC_MAX) {
+        hg_bulk_op_id->na_op_count > HG_BULK_STATIC_MAX) {
         na_op_id_t **na_op_ids = NULL;
 #ifdef NA_HAS_SM
         if (hg_bulk_op_id->na_class ==
@@ -1693,7 +2411,7 @@ hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
             na_op_ids = hg_bulk_op_id->na_op_ids.d;
 
         if (na_op_ids) {
-            for (i = 0; i < hg_bulk_op_id->op_count; i++) {
+            for (i = 0; i < hg_bulk_op_id->na_op_count; i++) {
                 if (na_op_ids[i] == NULL)
                     continue;
 
@@ -1707,6 +2425,25 @@ hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
         }
     }
 
+    /* Same for operations issued on bulk rails */
+    for (r = 0; r < rails->count; r++) {
+        struct hg_bulk_rail_op *rail_op = &hg_bulk_op_id->rail_ops[r];
+
+        if (rail_op->op_count > HG_BULK_STATIC_MAX &&
+            rail_op->na_op_ids.d != NULL) {
+            for (i = 0; i < rail_op->op_count; i++) {
+                if (rail_op->na_op_ids.d[i] == NULL)
+                    continue;
+
+                NA_Op_destroy(
+                    rails->rails[r].na_class, rail_op->na_op_ids.d[i]);
+            }
+            free(rail_op->na_op_ids.d);
+            rail_op->na_op_ids.d = NULL;
+        }
+        rail_op->op_count = 0;
+    }
+
     /* Repost handle if we were listening, otherwise destroy it */
     if (hg_bulk_op_id->reuse) {
         HG_LOG_SUBSYS_DEBUG(
@@ -1744,6 +2481,16 @@ hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
         }
 #endif
 
+        for (r = 0; r < rails->count; r++) {
+            for (i = 0; i < HG_BULK_STATIC_MAX; i++) {
+                if (hg_bulk_op_id->rail_ops[r].na_op_ids.s[i] == NULL)
+                    continue;
+
+                NA_Op_destroy(rails->rails[r].na_class,
+                    hg_bulk_op_id->rail_ops[r].na_op_ids.s[i]);
+            }
+        }
+
         free(hg_bulk_op_id);
     }
 }
@@ -1922,8 +2669,11 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
     struct hg_bulk_op_id *hg_bulk_op_id = NULL;
     struct hg_bulk_op_pool *hg_bulk_op_pool =
         hg_core_context_get_bulk_op_pool(core_context);
+    bool checksum = (op & HG_BULK_CRC32C) != 0;
     hg_return_t ret;
 
+    op = (hg_bulk_op_t) (op & ~HG_BULK_CRC32C);
+
     HG_CHECK_SUBSYS_ERROR(bulk,
         origin_addr->core_class != core_context->core_class, error, ret,
         HG_INVALID_ARG,
@@ -1936,6 +2686,9 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
         hg_bulk_local->core_class != core_context->core_class, error, ret,
         HG_INVALID_ARG,
         "Context and local handle passed belong to different classes");
+    HG_CHECK_SUBSYS_ERROR(bulk,
+        checksum && hg_bulk_local->attrs.mem_type != HG_MEM_TYPE_HOST, error,
+        ret, HG_INVALID_ARG, "Checksum of non-host memory is not supported");
 
     /* Get a new OP ID from context */
     if (hg_bulk_op_pool) {
@@ -1955,6 +2708,7 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
     hg_atomic_incr32(&hg_bulk_local->ref_count);
     hg_bulk_op_id->callback_info.info.bulk.op = op;
     hg_bulk_op_id->callback_info.info.bulk.size = size;
+    hg_bulk_op_id->callback_info.info.bulk.crc32c = HG_CRC32C_INIT;
 
     /* Reset status */
     hg_atomic_set32(&hg_bulk_op_id->status, 0);
@@ -1962,6 +2716,7 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
 
     /* Expected op count */
     hg_bulk_op_id->op_count = (size > 0) ? 1 : 0; /* Default */
+    hg_bulk_op_id->na_op_count = 0;
     hg_atomic_set32(&hg_bulk_op_id->op_completed_count, 0);
 
     if (size == 0) {
@@ -1973,8 +2728,19 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
         hg_bulk_op_id->na_context = NULL;
 
         /* For eager transfers, use self code path to copy data locally */
-        hg_bulk_transfer_self(op, origin_segments, origin_count, origin_offset,
-            local_segments, local_count, local_offset, size, hg_bulk_op_id);
+        hg_bulk_transfer_self(op, checksum, origin_segments, origin_count,
+            origin_offset, local_segments, local_count, local_offset, size,
+            hg_bulk_op_id);
+    } else if (hg_bulk_origin->desc.info.rail_count > 0) {
+        /* Origin described rails (never set along with SM) */
+        hg_bulk_op_id->na_class = hg_bulk_origin->na_class;
+        hg_bulk_op_id->na_context = HG_Core_context_get_na(core_context);
+
+        ret = hg_bulk_transfer_rails(op, origin_addr, origin_id,
+            hg_bulk_origin, origin_offset, hg_bulk_local, local_offset, size,
+            checksum, hg_bulk_op_id);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, error, ret, "Could not transfer data across rails");
     } else {
         struct hg_bulk_na_mem_desc *origin_mem_descs, *local_mem_descs;
         na_mem_handle_t **origin_mem_handles, **local_mem_handles;
@@ -2004,15 +2770,26 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
         }
 #endif
 
+        /* Register local handle with the transport used */
+        ret = hg_bulk_register_na(
+            hg_bulk_local, (origin_flags & HG_BULK_SM) != 0);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, error, ret, "Could not register local bulk handle");
+
         origin_mem_handles =
             HG_BULK_MEM_HANDLES(origin_mem_descs, origin_count, origin_flags);
         local_mem_handles =
             HG_BULK_MEM_HANDLES(local_mem_descs, local_count, local_flags);
+        HG_CHECK_SUBSYS_ERROR(bulk,
+            ((origin_flags & HG_BULK_REGV) || (origin_count == 1)) &&
+                origin_mem_handles[0] == NULL && origin_segments[0].base,
+            error, ret, HG_PROTOCOL_ERROR,
+            "Origin handle was not serialized for this transport");
 
         ret = hg_bulk_transfer_na(op, na_origin_addr, origin_id,
             origin_segments, origin_count, origin_mem_handles, origin_flags,
             origin_offset, local_segments, local_count, local_mem_handles,
-            local_flags, local_offset, size, hg_bulk_op_id);
+            local_flags, local_offset, size, checksum, hg_bulk_op_id);
         HG_CHECK_SUBSYS_HG_ERROR(bulk, error, ret, "Could not transfer data");
     }
 
@@ -2035,7 +2812,7 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static void
-hg_bulk_transfer_self(hg_bulk_op_t op,
+hg_bulk_transfer_self(hg_bulk_op_t op, bool checksum,
     const struct hg_bulk_segment *origin_segments, uint32_t origin_count,
     hg_size_t origin_offset, const struct hg_bulk_segment *local_segments,
     uint32_t local_count, hg_size_t local_offset, hg_size_t size,
@@ -2058,11 +2835,12 @@ hg_bulk_transfer_self(hg_bulk_op_t op,
         hg_bulk_offset_translate(local_segments, local_count, local_offset,
             &local_segment_start_index, &local_segment_start_offset);
 
-    /* Do actual transfer */
+    /* Do actual transfer, checksum is computed while copying */
     hg_bulk_transfer_segments_self(copy_op, origin_segments, origin_count,
         origin_segment_start_index, origin_segment_start_offset, local_segments,
         local_count, local_segment_start_index, local_segment_start_offset,
-        size);
+        size,
+        checksum ? &hg_bulk_op_id->callback_info.info.bulk.crc32c : NULL);
 
     /* Complete immediately */
     hg_bulk_complete(hg_bulk_op_id, HG_SUCCESS, true);
@@ -2075,7 +2853,7 @@ hg_bulk_transfer_segments_self(hg_bulk_copy_op_t copy_op,
     hg_size_t origin_segment_start_index, hg_size_t origin_segment_start_offset,
     const struct hg_bulk_segment *local_segments, uint32_t local_count,
     hg_size_t local_segment_start_index, hg_size_t local_segment_start_offset,
-    hg_size_t size)
+    hg_size_t size, uint32_t *crc_p)
 {
     hg_size_t origin_segment_index = origin_segment_start_index;
     hg_size_t local_segment_index = local_segment_start_index;
@@ -2096,7 +2874,7 @@ hg_bulk_transfer_segments_self(hg_bulk_copy_op_t copy_op,
         /* Copy segment */
         copy_op(local_segments[local_segment_index].base, local_segment_offset,
             origin_segments[origin_segment_index].base, origin_segment_offset,
-            transfer_size);
+            transfer_size, crc_p);
 
         /* Decrease remaining size from the size of data we transferred
          * and exit if everything has been transferred */
@@ -2121,6 +2899,32 @@ hg_bulk_transfer_segments_self(hg_bulk_copy_op_t copy_op,
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static uint32_t
+hg_bulk_crc32c_segments(const struct hg_bulk_segment *segments,
+    uint32_t count, hg_size_t segment_start_index,
+    hg_size_t segment_start_offset, hg_size_t size)
+{
+    hg_size_t segment_index = segment_start_index;
+    hg_size_t segment_offset = segment_start_offset;
+    hg_size_t remaining_size = size;
+    uint32_t crc = HG_CRC32C_INIT;
+
+    while (remaining_size > 0 && segment_index < count) {
+        hg_size_t len = HG_BULK_MIN(
+            remaining_size, segments[segment_index].len - segment_offset);
+
+        crc = hg_crc32c(crc,
+            (const char *) segments[segment_index].base + segment_offset,
+            (size_t) len);
+        remaining_size -= len;
+        segment_index++;
+        segment_offset = 0;
+    }
+
+    return crc;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
@@ -2129,11 +2933,12 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
     uint8_t origin_flags, hg_size_t origin_offset,
     const struct hg_bulk_segment *local_segments, uint32_t local_count,
     na_mem_handle_t **local_mem_handles, uint8_t local_flags,
-    hg_size_t local_offset, hg_size_t size, struct hg_bulk_op_id *hg_bulk_op_id)
+    hg_size_t local_offset, hg_size_t size, bool checksum,
+    struct hg_bulk_op_id *hg_bulk_op_id)
 {
     hg_bulk_na_op_id_t *hg_bulk_na_op_ids;
-    na_bulk_op_t na_bulk_op =
-        (op & HG_BULK_PULL) ? hg_bulk_na_get : hg_bulk_na_put;
+    struct hg_bulk_crc_chunk *crc_chunks = NULL;
+    uint32_t posted_count = 0;
     hg_return_t ret;
 
 #ifdef NA_HAS_SM
@@ -2144,20 +2949,293 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
 #endif
         hg_bulk_na_op_ids = &hg_bulk_op_id->na_op_ids;
 
+    /* Determine number of NA operations that will be needed */
+    hg_bulk_op_id->op_count = hg_bulk_transfer_na_get_op_count(origin_segments,
+        origin_count, origin_flags, origin_offset, local_segments, local_count,
+        local_flags, local_offset, size);
+    HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk_op_id->op_count == 0, error, ret,
+        HG_INVALID_ARG, "Could not get bulk op_count");
+    hg_bulk_op_id->na_op_count = hg_bulk_op_id->op_count;
+
+    HG_LOG_SUBSYS_DEBUG(bulk, "Transferring data through NA in %u operation(s)",
+        hg_bulk_op_id->op_count);
+
+    /* Each operation is checksummed separately as it completes */
+    if (checksum) {
+        crc_chunks = (struct hg_bulk_crc_chunk *) malloc(
+            sizeof(*crc_chunks) * hg_bulk_op_id->op_count);
+        HG_CHECK_SUBSYS_ERROR(bulk, crc_chunks == NULL, error, ret, HG_NOMEM,
+            "Could not allocate checksum chunks");
+        hg_bulk_op_id->crc_chunks = crc_chunks;
+    }
+
+    ret = hg_bulk_transfer_na_ops(op, hg_bulk_op_id->na_class,
+        hg_bulk_op_id->na_context, na_origin_addr, origin_id, origin_segments,
+        origin_count, origin_mem_handles, origin_flags, origin_offset,
+        local_segments, local_count, local_mem_handles, local_flags,
+        local_offset, size, hg_bulk_na_op_ids, hg_bulk_op_id->na_op_count,
+        crc_chunks, hg_bulk_op_id, &posted_count);
+    if (ret != HG_SUCCESS && posted_count > 0) {
+        /* Operations are in flight, complete with error through callback */
+        HG_LOG_SUBSYS_ERROR(bulk,
+            "Could only post %" PRIu32 " of %" PRIu32 " operations",
+            posted_count, hg_bulk_op_id->op_count);
+        hg_bulk_transfer_abort(hg_bulk_op_id, ret, &posted_count, 1);
+        return HG_SUCCESS;
+    }
+    HG_CHECK_SUBSYS_HG_ERROR(bulk, error, ret, "Could not transfer data");
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_transfer_rails(hg_bulk_op_t op, struct hg_core_addr *origin_addr,
+    uint8_t origin_id, struct hg_bulk *hg_bulk_origin, hg_size_t origin_offset,
+    struct hg_bulk *hg_bulk_local, hg_size_t local_offset, hg_size_t size,
+    bool checksum, struct hg_bulk_op_id *hg_bulk_op_id)
+{
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk_origin->core_class);
+    const struct hg_bulk_segment *origin_segments =
+        HG_BULK_SEGMENTS(hg_bulk_origin);
+    const struct hg_bulk_segment *local_segments =
+        HG_BULK_SEGMENTS(hg_bulk_local);
+    uint32_t origin_count = hg_bulk_origin->desc.info.segment_count,
+             local_count = hg_bulk_local->desc.info.segment_count;
+    uint8_t origin_flags = hg_bulk_origin->desc.info.flags;
+    uint8_t local_flags = hg_bulk_local->desc.info.flags;
+    /* Rail 0 is the main NA class, rail r > 0 is bulk rail r - 1 */
+    na_mem_handle_t **origin_mem_handles[HG_CORE_RAIL_MAX + 1],
+        **local_mem_handles[HG_CORE_RAIL_MAX + 1];
+    hg_size_t stripe_sizes[HG_CORE_RAIL_MAX + 1] = {0};
+    uint32_t op_counts[HG_CORE_RAIL_MAX + 1] = {0},
+             posted_counts[HG_CORE_RAIL_MAX + 1] = {0};
+    unsigned int rail_count = hg_bulk_origin->desc.info.rail_count + 1u,
+                 stripe_count, r;
+    struct hg_bulk_crc_chunk *crc_chunks = NULL;
+    hg_size_t stripe_offset;
+    uint32_t op_index;
+    hg_return_t ret;
+
+    /* Local handle can only be registered with rails if we own it */
+    if (hg_bulk_local->rails == NULL)
+        rail_count = 1;
+
+    /* Stripe large transfers evenly across rails, small transfers go
+     * through a single rail picked by the context */
+    stripe_count = rail_count;
+    if (size / rails->stripe_size < stripe_count)
+        stripe_count = (unsigned int) (size / rails->stripe_size);
+    if (stripe_count <= 1) {
+        r = hg_core_context_get_rail(hg_bulk_op_id->core_context);
+        /* Peer may have fewer rails than we do */
+        stripe_sizes[(r < rail_count) ? r : 0] = size;
+    } else {
+        for (r = 0; r < stripe_count; r++)
+            stripe_sizes[r] = size / stripe_count;
+        stripe_sizes[stripe_count - 1] += size % stripe_count;
+    }
+
+    /* Register local handle and count operations before issuing any of
+     * them, completion is only accounted for once all are known */
+    hg_bulk_op_id->op_count = 0;
+    for (r = 0, stripe_offset = 0; r < rail_count; r++) {
+        struct hg_bulk_na_mem_desc *origin_mem_descs, *local_mem_descs;
+
+        if (stripe_sizes[r] == 0)
+            continue;
+
+        if (r == 0) {
+            ret = hg_bulk_register_na(hg_bulk_local, false);
+            origin_mem_descs = &hg_bulk_origin->na_mem_descs;
+            local_mem_descs = &hg_bulk_local->na_mem_descs;
+        } else {
+            ret = hg_bulk_register_na_rail(hg_bulk_local, r - 1);
+            origin_mem_descs = &hg_bulk_origin->rails[r - 1].na_mem_descs;
+            local_mem_descs = &hg_bulk_local->rails[r - 1].na_mem_descs;
+        }
+        HG_CHECK_SUBSYS_HG_ERROR(bulk, error, ret,
+            "Could not register local bulk handle with rail %u", r);
+
+        origin_mem_handles[r] =
+            HG_BULK_MEM_HANDLES(origin_mem_descs, origin_count, origin_flags);
+        local_mem_handles[r] =
+            HG_BULK_MEM_HANDLES(local_mem_descs, local_count, local_flags);
+        HG_CHECK_SUBSYS_ERROR(bulk,
+            ((origin_flags & HG_BULK_REGV) || (origin_count == 1)) &&
+                origin_mem_handles[r][0] == NULL && origin_segments[0].base,
+            error, ret, HG_PROTOCOL_ERROR,
+            "Origin handle was not serialized for rail %u", r);
+
+        op_counts[r] = hg_bulk_transfer_na_get_op_count(origin_segments,
+            origin_count, origin_flags, origin_offset + stripe_offset,
+            local_segments, local_count, local_flags,
+            local_offset + stripe_offset, stripe_sizes[r]);
+        HG_CHECK_SUBSYS_ERROR(bulk, op_counts[r] == 0, error, ret,
+            HG_INVALID_ARG, "Could not get bulk op_count for rail %u", r);
+
+        hg_bulk_op_id->op_count += op_counts[r];
+        stripe_offset += stripe_sizes[r];
+    }
+    hg_bulk_op_id->na_op_count = op_counts[0];
+    for (r = 1; r < rail_count; r++)
+        hg_bulk_op_id->rail_ops[r - 1].op_count = op_counts[r];
+
+    HG_LOG_SUBSYS_DEBUG(bulk,
+        "Transferring %" PRIu64 " bytes across %u rail(s) in %u operation(s)",
+        size, (stripe_count > 1) ? stripe_count : 1, hg_bulk_op_id->op_count);
+
+    /* Checksums are merged in transfer order, stripes are contiguous */
+    if (checksum) {
+        crc_chunks = (struct hg_bulk_crc_chunk *) calloc(
+            hg_bulk_op_id->op_count, sizeof(*crc_chunks));
+        HG_CHECK_SUBSYS_ERROR(bulk, crc_chunks == NULL, error, ret, HG_NOMEM,
+            "Could not allocate checksum chunks");
+        hg_bulk_op_id->crc_chunks = crc_chunks;
+    }
+
+    for (r = 0, stripe_offset = 0, op_index = 0; r < rail_count; r++) {
+        na_class_t *na_class;
+        na_context_t *na_context;
+        na_addr_t *na_origin_addr;
+        hg_bulk_na_op_id_t *hg_bulk_na_op_ids;
+
+        if (stripe_sizes[r] == 0)
+            continue;
+
+        if (r == 0) {
+            na_class = hg_bulk_op_id->na_class;
+            na_context = hg_bulk_op_id->na_context;
+            na_origin_addr = HG_Core_addr_get_na(origin_addr);
+            hg_bulk_na_op_ids = &hg_bulk_op_id->na_op_ids;
+        } else {
+            na_class = rails->rails[r - 1].na_class;
+            na_context =
+                hg_core_context_get_na_rail(hg_bulk_op_id->core_context, r - 1);
+            na_origin_addr = hg_bulk_origin->rails[r - 1].na_addr;
+            hg_bulk_na_op_ids = &hg_bulk_op_id->rail_ops[r - 1].na_op_ids;
+        }
+
+        ret = hg_bulk_transfer_na_ops(op, na_class, na_context,
+            na_origin_addr, origin_id, origin_segments, origin_count,
+            origin_mem_handles[r], origin_flags, origin_offset + stripe_offset,
+            local_segments, local_count, local_mem_handles[r], local_flags,
+            local_offset + stripe_offset, stripe_sizes[r], hg_bulk_na_op_ids,
+            op_counts[r], crc_chunks ? &crc_chunks[op_index] : NULL,
+            hg_bulk_op_id, &posted_counts[r]);
+        if (ret != HG_SUCCESS && op_index + posted_counts[r] > 0) {
+            /* Operations are in flight, complete with error through
+             * callback */
+            HG_LOG_SUBSYS_ERROR(bulk,
+                "Could not transfer data through rail %u (%" PRIu32
+                " of %" PRIu32 " operations posted)",
+                r, op_index + posted_counts[r], hg_bulk_op_id->op_count);
+            hg_bulk_transfer_abort(
+                hg_bulk_op_id, ret, posted_counts, rail_count);
+            return HG_SUCCESS;
+        }
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, error, ret, "Could not transfer data through rail %u", r);
+
+        op_index += op_counts[r];
+        stripe_offset += stripe_sizes[r];
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+hg_bulk_transfer_na_get_op_count(const struct hg_bulk_segment *origin_segments,
+    uint32_t origin_count, uint8_t origin_flags, hg_size_t origin_offset,
+    const struct hg_bulk_segment *local_segments, uint32_t local_count,
+    uint8_t local_flags, hg_size_t local_offset, hg_size_t size)
+{
+    uint32_t origin_segment_start_index = 0, local_segment_start_index = 0;
+    hg_size_t origin_segment_start_offset = 0, local_segment_start_offset = 0;
+
+    /* Single operation if both sides have one single handle */
+    if (((origin_flags & HG_BULK_REGV) || origin_count == 1) &&
+        ((local_flags & HG_BULK_REGV) || local_count == 1))
+        return 1;
+
+    /* Translate bulk_offset */
+    if (origin_offset > 0)
+        hg_bulk_offset_translate(origin_segments, origin_count, origin_offset,
+            &origin_segment_start_index, &origin_segment_start_offset);
+
+    /* Translate block offset */
+    if (local_offset > 0)
+        hg_bulk_offset_translate(local_segments, local_count, local_offset,
+            &local_segment_start_index, &local_segment_start_offset);
+
+    return hg_bulk_transfer_get_op_count(origin_segments, origin_count,
+        origin_segment_start_index, origin_segment_start_offset,
+        local_segments, local_count, local_segment_start_index,
+        local_segment_start_offset, size);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_transfer_na_ops(hg_bulk_op_t op, na_class_t *na_class,
+    na_context_t *na_context, na_addr_t *na_origin_addr, uint8_t origin_id,
+    const struct hg_bulk_segment *origin_segments, uint32_t origin_count,
+    na_mem_handle_t **origin_mem_handles, uint8_t origin_flags,
+    hg_size_t origin_offset, const struct hg_bulk_segment *local_segments,
+    uint32_t local_count, na_mem_handle_t **local_mem_handles,
+    uint8_t local_flags, hg_size_t local_offset, hg_size_t size,
+    hg_bulk_na_op_id_t *hg_bulk_na_op_ids, uint32_t na_op_count,
+    struct hg_bulk_crc_chunk *crc_chunks, struct hg_bulk_op_id *hg_bulk_op_id,
+    uint32_t *posted_count_p)
+{
+    na_bulk_op_t na_bulk_op =
+        (op & HG_BULK_PULL) ? hg_bulk_na_get : hg_bulk_na_put;
+    na_cb_t callback =
+        crc_chunks ? hg_bulk_transfer_crc_cb : hg_bulk_transfer_cb;
+    hg_return_t ret;
+
+    *posted_count_p = 0;
+
     if (((origin_flags & HG_BULK_REGV) || origin_count == 1) &&
         ((local_flags & HG_BULK_REGV) || local_count == 1)) {
+        void *arg = hg_bulk_op_id;
         na_return_t na_ret;
 
         HG_LOG_SUBSYS_DEBUG(
             bulk, "Transferring data through NA in single operation");
 
-        na_ret = na_bulk_op(hg_bulk_op_id->na_class, hg_bulk_op_id->na_context,
-            hg_bulk_transfer_cb, hg_bulk_op_id, local_mem_handles[0],
-            local_offset, origin_mem_handles[0], origin_offset, size,
-            na_origin_addr, origin_id, hg_bulk_na_op_ids->s[0]);
+        if (crc_chunks) {
+            uint32_t local_segment_start_index = 0;
+            hg_size_t local_segment_start_offset = 0;
+
+            if (local_offset > 0)
+                hg_bulk_offset_translate(local_segments, local_count,
+                    local_offset, &local_segment_start_index,
+                    &local_segment_start_offset);
+
+            crc_chunks[0].hg_bulk_op_id = hg_bulk_op_id;
+            crc_chunks[0].local_index = local_segment_start_index;
+            crc_chunks[0].local_offset = local_segment_start_offset;
+            crc_chunks[0].size = size;
+            crc_chunks[0].crc = HG_CRC32C_INIT;
+            arg = &crc_chunks[0];
+        }
+
+        na_ret = na_bulk_op(na_class, na_context, callback, arg,
+            local_mem_handles[0], local_offset, origin_mem_handles[0],
+            origin_offset, size, na_origin_addr, origin_id,
+            hg_bulk_na_op_ids->s[0]);
         HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
             (hg_return_t) na_ret, "Could not transfer data (%s)",
             NA_Error_to_string(na_ret));
+        *posted_count_p = 1;
     } else {
         uint32_t origin_segment_start_index = 0, local_segment_start_index = 0;
         hg_size_t origin_segment_start_offset = 0,
@@ -2175,32 +3253,19 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
             hg_bulk_offset_translate(local_segments, local_count, local_offset,
                 &local_segment_start_index, &local_segment_start_offset);
 
-        /* Determine number of NA operations that will be needed */
-        hg_bulk_op_id->op_count = hg_bulk_transfer_get_op_count(origin_segments,
-            origin_count, origin_segment_start_index,
-            origin_segment_start_offset, local_segments, local_count,
-            local_segment_start_index, local_segment_start_offset, size);
-        HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk_op_id->op_count == 0, error, ret,
-            HG_INVALID_ARG, "Could not get bulk op_count");
-
-        HG_LOG_SUBSYS_DEBUG(bulk,
-            "Transferring data through NA in %u operation(s)",
-            hg_bulk_op_id->op_count);
-
         /* Create extra operation IDs if the number of operations exceeds
          * the number of pre-allocated op IDs */
-        if (hg_bulk_op_id->op_count > HG_BULK_STATIC_MAX) {
+        if (na_op_count > HG_BULK_STATIC_MAX) {
             unsigned int i;
 
             /* Allocate memory for NA operation IDs */
             hg_bulk_na_op_ids->d =
-                malloc(sizeof(na_op_id_t *) * hg_bulk_op_id->op_count);
+                (na_op_id_t **) calloc(na_op_count, sizeof(na_op_id_t *));
             HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk_na_op_ids->d == NULL, error,
                 ret, HG_NOMEM, "Could not allocate memory for op_ids");
 
-            for (i = 0; i < hg_bulk_op_id->op_count; i++) {
-                hg_bulk_na_op_ids->d[i] =
-                    NA_Op_create(hg_bulk_op_id->na_class, 0);
+            for (i = 0; i < na_op_count; i++) {
+                hg_bulk_na_op_ids->d[i] = NA_Op_create(na_class, 0);
                 HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk_na_op_ids->d[i] == NULL,
                     error, ret, HG_NA_ERROR, "Could not create NA op ID");
             }
@@ -2210,14 +3275,13 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
             na_op_ids = hg_bulk_na_op_ids->s;
 
         /* Do actual transfer */
-        ret = hg_bulk_transfer_segments_na(hg_bulk_op_id->na_class,
-            hg_bulk_op_id->na_context, na_bulk_op, hg_bulk_transfer_cb,
-            hg_bulk_op_id, na_origin_addr, origin_id, origin_segments,
-            origin_count, origin_mem_handles, origin_segment_start_index,
-            origin_segment_start_offset, local_segments, local_count,
-            local_mem_handles, local_segment_start_index,
-            local_segment_start_offset, size, na_op_ids,
-            hg_bulk_op_id->op_count);
+        ret = hg_bulk_transfer_segments_na(na_class, na_context, na_bulk_op,
+            callback, hg_bulk_op_id, na_origin_addr, origin_id,
+            origin_segments, origin_count, origin_mem_handles,
+            origin_segment_start_index, origin_segment_start_offset,
+            local_segments, local_count, local_mem_handles,
+            local_segment_start_index, local_segment_start_offset, size,
+            na_op_ids, crc_chunks, na_op_count, posted_count_p);
         HG_CHECK_SUBSYS_HG_ERROR(
             bulk, error, ret, "Could not transfer data segments");
     }
@@ -2228,6 +3292,61 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_transfer_abort(struct hg_bulk_op_id *hg_bulk_op_id, hg_return_t ret,
+    const uint32_t *posted_counts, unsigned int rail_count)
+{
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk_op_id->core_context->core_class);
+    uint32_t unposted_count = hg_bulk_op_id->op_count, i;
+    na_op_id_t **na_op_ids;
+    unsigned int r;
+
+    /* Report post error instead of NA_CANCELED */
+    hg_atomic_cas32(&hg_bulk_op_id->ret_status, (int32_t) HG_SUCCESS,
+        (int32_t) ret);
+
+    /* Operations that were not posted must not be canceled again */
+    hg_atomic_or32(&hg_bulk_op_id->status, HG_BULK_OP_CANCELED);
+
+    /* Rail 0 is the NA class of the operation */
+#ifdef NA_HAS_SM
+    if (hg_bulk_op_id->na_class ==
+        hg_bulk_op_id->core_context->core_class->na_sm_class)
+        na_op_ids = HG_BULK_NA_SM_OP_IDS(hg_bulk_op_id);
+    else
+#endif
+        na_op_ids = HG_BULK_NA_OP_IDS(hg_bulk_op_id);
+    for (i = 0; i < posted_counts[0]; i++) {
+        na_return_t na_ret = NA_Cancel(
+            hg_bulk_op_id->na_class, hg_bulk_op_id->na_context, na_op_ids[i]);
+        HG_CHECK_SUBSYS_ERROR_DONE(bulk, na_ret != NA_SUCCESS,
+            "Could not cancel NA op ID (%s)", NA_Error_to_string(na_ret));
+    }
+    unposted_count -= posted_counts[0];
+
+    for (r = 1; r < rail_count; r++) {
+        struct hg_bulk_rail_op *rail_op = &hg_bulk_op_id->rail_ops[r - 1];
+        na_context_t *na_context =
+            hg_core_context_get_na_rail(hg_bulk_op_id->core_context, r - 1);
+
+        na_op_ids = HG_BULK_RAIL_OP_IDS(rail_op);
+        for (i = 0; i < posted_counts[r]; i++) {
+            na_return_t na_ret = NA_Cancel(
+                rails->rails[r - 1].na_class, na_context, na_op_ids[i]);
+            HG_CHECK_SUBSYS_ERROR_DONE(bulk, na_ret != NA_SUCCESS,
+                "Could not cancel NA op ID (%s)", NA_Error_to_string(na_ret));
+        }
+        unposted_count -= posted_counts[r];
+    }
+
+    /* Operations that were not posted complete now, op ID must not be
+     * accessed past the last one as it may be released */
+    for (i = 0; i < unposted_count; i++)
+        hg_bulk_transfer_op_complete(hg_bulk_op_id, NA_CANCELED);
+}
+
 /*---------------------------------------------------------------------------*/
 static uint32_t
 hg_bulk_transfer_get_op_count(const struct hg_bulk_segment *origin_segments,
@@ -2293,7 +3412,8 @@ hg_bulk_transfer_segments_na(na_class_t *na_class, na_context_t *na_context,
     const struct hg_bulk_segment *local_segments, uint32_t local_count,
     na_mem_handle_t **local_mem_handles, hg_size_t local_segment_start_index,
     hg_size_t local_segment_start_offset, hg_size_t size,
-    na_op_id_t *na_op_ids[], uint32_t na_op_count)
+    na_op_id_t *na_op_ids[], struct hg_bulk_crc_chunk *crc_chunks,
+    uint32_t na_op_count, uint32_t *posted_count_p)
 {
     hg_size_t origin_segment_index = origin_segment_start_index;
     hg_size_t local_segment_index = local_segment_start_index;
@@ -2309,12 +3429,23 @@ hg_bulk_transfer_segments_na(na_class_t *na_class, na_context_t *na_context,
         hg_size_t transfer_size = HG_BULK_MIN(
             (origin_segments[origin_segment_index].len - origin_segment_offset),
             (local_segments[local_segment_index].len - local_segment_offset));
+        void *op_arg = arg;
         na_return_t na_ret;
 
         /* Remaining size may be smaller */
         transfer_size = HG_BULK_MIN(remaining_size, transfer_size);
 
-        na_ret = na_bulk_op(na_class, na_context, callback, arg,
+        /* Record local range so that it can be checksummed on completion */
+        if (crc_chunks) {
+            crc_chunks[count].hg_bulk_op_id = (struct hg_bulk_op_id *) arg;
+            crc_chunks[count].local_index = local_segment_index;
+            crc_chunks[count].local_offset = local_segment_offset;
+            crc_chunks[count].size = transfer_size;
+            crc_chunks[count].crc = HG_CRC32C_INIT;
+            op_arg = &crc_chunks[count];
+        }
+
+        na_ret = na_bulk_op(na_class, na_context, callback, op_arg,
             local_mem_handles[local_segment_index], local_segment_offset,
             origin_mem_handles[origin_segment_index], origin_segment_offset,
             transfer_size, origin_addr, origin_id, na_op_ids[count]);
@@ -2322,7 +3453,7 @@ hg_bulk_transfer_segments_na(na_class_t *na_class, na_context_t *na_context,
             (hg_return_t) na_ret, "Could not transfer data (%s)",
             NA_Error_to_string(na_ret));
 
-        count++;
+        *posted_count_p = ++count;
 
         /* Decrease remaining size from the size of data we transferred
          * and exit if everything has been transferred */
@@ -2360,12 +3491,39 @@ error:
 static void
 hg_bulk_transfer_cb(const struct na_cb_info *callback_info)
 {
-    struct hg_bulk_op_id *hg_bulk_op_id =
-        (struct hg_bulk_op_id *) callback_info->arg;
+    hg_bulk_transfer_op_complete(
+        (struct hg_bulk_op_id *) callback_info->arg, callback_info->ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_transfer_crc_cb(const struct na_cb_info *callback_info)
+{
+    struct hg_bulk_crc_chunk *crc_chunk =
+        (struct hg_bulk_crc_chunk *) callback_info->arg;
 
+    /* Data is in place in local memory once the operation has completed */
     if (callback_info->ret == NA_SUCCESS) {
+        struct hg_bulk *hg_bulk_local =
+            crc_chunk->hg_bulk_op_id->callback_info.info.bulk.local_handle;
+
+        crc_chunk->crc = hg_bulk_crc32c_segments(
+            HG_BULK_SEGMENTS(hg_bulk_local),
+            hg_bulk_local->desc.info.segment_count, crc_chunk->local_index,
+            crc_chunk->local_offset, crc_chunk->size);
+    }
+
+    hg_bulk_transfer_op_complete(crc_chunk->hg_bulk_op_id, callback_info->ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_transfer_op_complete(
+    struct hg_bulk_op_id *hg_bulk_op_id, na_return_t na_ret)
+{
+    if (na_ret == NA_SUCCESS) {
         /* Nothing */
-    } else if (callback_info->ret == NA_CANCELED) {
+    } else if (na_ret == NA_CANCELED) {
         HG_CHECK_SUBSYS_WARNING(bulk,
             hg_atomic_get32(&hg_bulk_op_id->status) & HG_BULK_OP_COMPLETED,
             "Operation was completed");
@@ -2380,15 +3538,25 @@ hg_bulk_transfer_cb(const struct na_cb_info *callback_info)
 
         /* Keep first non-success ret status */
         hg_atomic_cas32(&hg_bulk_op_id->ret_status, (int32_t) HG_SUCCESS,
-            (int32_t) callback_info->ret);
-        HG_LOG_ERROR("NA callback returned error (%s)",
-            NA_Error_to_string(callback_info->ret));
+            (int32_t) na_ret);
+        HG_LOG_ERROR(
+            "NA callback returned error (%s)", NA_Error_to_string(na_ret));
     }
 
     /* When all NA transfers that correspond to the bulk operation complete,
      * complete the bulk operation. */
     if ((uint32_t) hg_atomic_incr32(&hg_bulk_op_id->op_completed_count) ==
         hg_bulk_op_id->op_count) {
+        /* Merge checksums in transfer order */
+        if (hg_bulk_op_id->crc_chunks) {
+            uint32_t crc = hg_bulk_op_id->crc_chunks[0].crc, i;
+
+            for (i = 1; i < hg_bulk_op_id->op_count; i++)
+                crc = hg_crc32c_combine(crc, hg_bulk_op_id->crc_chunks[i].crc,
+                    (size_t) hg_bulk_op_id->crc_chunks[i].size);
+            hg_bulk_op_id->callback_info.info.bulk.crc32c = crc;
+        }
+
         hg_bulk_complete(hg_bulk_op_id,
             (hg_return_t) hg_atomic_get32(&hg_bulk_op_id->ret_status), false);
     }
@@ -2416,10 +3584,12 @@ hg_bulk_complete(
 static hg_return_t
 hg_bulk_cancel(struct hg_bulk_op_id *hg_bulk_op_id)
 {
+    const struct hg_core_rails *rails =
+        hg_core_class_get_rails(hg_bulk_op_id->core_context->core_class);
     na_op_id_t **na_op_ids;
     hg_return_t ret;
     int32_t status;
-    unsigned int i;
+    unsigned int i, r;
 
     /* Exit if op has already completed */
     status = hg_atomic_get32(&hg_bulk_op_id->status);
@@ -2441,7 +3611,7 @@ hg_bulk_cancel(struct hg_bulk_op_id *hg_bulk_op_id)
         na_op_ids = HG_BULK_NA_OP_IDS(hg_bulk_op_id);
 
     /* Cancel all NA operations issued */
-    for (i = 0; i < hg_bulk_op_id->op_count; i++) {
+    for (i = 0; i < hg_bulk_op_id->na_op_count; i++) {
         na_return_t na_ret = NA_Cancel(
             hg_bulk_op_id->na_class, hg_bulk_op_id->na_context, na_op_ids[i]);
         HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
@@ -2449,6 +3619,22 @@ hg_bulk_cancel(struct hg_bulk_op_id *hg_bulk_op_id)
             NA_Error_to_string(na_ret));
     }
 
+    /* Cancel operations issued on bulk rails */
+    for (r = 0; r < rails->count; r++) {
+        struct hg_bulk_rail_op *rail_op = &hg_bulk_op_id->rail_ops[r];
+        na_context_t *na_context =
+            hg_core_context_get_na_rail(hg_bulk_op_id->core_context, r);
+
+        na_op_ids = HG_BULK_RAIL_OP_IDS(rail_op);
+        for (i = 0; i < rail_op->op_count; i++) {
+            na_return_t na_ret = NA_Cancel(
+                rails->rails[r].na_class, na_context, na_op_ids[i]);
+            HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
+                (hg_return_t) na_ret, "Could not cancel NA op ID (%s)",
+                NA_Error_to_string(na_ret));
+        }
+    }
+
     return HG_SUCCESS;
 
 error:
@@ -2673,11 +3859,18 @@ error:
 hg_size_t
 HG_Bulk_get_serialize_size(hg_bulk_t handle, unsigned long flags)
 {
+    hg_return_t reg_ret;
     hg_size_t ret;
 
     HG_CHECK_ERROR_NORET(
         handle == HG_BULK_NULL, error, "NULL bulk handle passed");
 
+    /* Size of memory handles is only known once registered */
+    reg_ret =
+        hg_bulk_register_serialize((struct hg_bulk *) handle, flags & 0xff);
+    HG_CHECK_SUBSYS_ERROR_NORET(bulk, reg_ret != HG_SUCCESS, error,
+        "Could not register bulk handle");
+
     ret = hg_bulk_get_serialize_size((struct hg_bulk *) handle, flags & 0xff);
 
     HG_LOG_SUBSYS_DEBUG(bulk,
@@ -204,13 +204,16 @@ static HG_INLINE uint8_t
 HG_Bulk_get_flags(hg_bulk_t handle);
 
 /**
- * Get size required to serialize bulk handle.
+ * Get size required to serialize bulk handle. Memory is registered with the
+ * transport that the handle is serialized for if it was not yet. Handles bound
+ * with HG_Bulk_bind() are always registered with NA so that they can be
+ * forwarded past the SM peer.
  *
  * \param handle [IN]           abstract bulk handle
  * \param flags [IN]            option flags, valid flags are:
  *                                HG_BULK_SM, HG_BULK_EAGER
  *
- * \return Non-negative value
+ * \return Non-negative value, 0 if memory could not be registered
  */
 HG_PUBLIC hg_size_t
 HG_Bulk_get_serialize_size(hg_bulk_t handle, unsigned long flags);
@@ -255,6 +258,9 @@ HG_Bulk_deserialize(hg_class_t *hg_class, hg_bulk_t *handle, const void *buf,
  * \param op [IN]               transfer operation:
  *                                  - HG_BULK_PUSH
  *                                  - HG_BULK_PULL
+ *                              optionally OR'ed with HG_BULK_CRC32C to
+ *                              compute a checksum of the transferred range,
+ *                              returned in the callback info
  * \param origin_addr [IN]      abstract address of origin
  * \param origin_handle [IN]    abstract bulk handle
  * \param origin_offset [IN]    offset
@@ -282,6 +288,9 @@ HG_Bulk_transfer(hg_context_t *context, hg_cb_t callback, void *arg,
  * \param op [IN]               transfer operation:
  *                                  - HG_BULK_PUSH
  *                                  - HG_BULK_PULL
+ *                              optionally OR'ed with HG_BULK_CRC32C to
+ *                              compute a checksum of the transferred range,
+ *                              returned in the callback info
  * \param origin_handle [IN]    abstract bulk handle
  * \param origin_offset [IN]    offset
  * \param local_handle [IN]     abstract bulk handle
@@ -309,6 +318,9 @@ HG_Bulk_bind_transfer(hg_context_t *context, hg_cb_t callback, void *arg,
  * \param op [IN]               transfer operation:
  *                                  - HG_BULK_PUSH
  *                                  - HG_BULK_PULL
+ *                              optionally OR'ed with HG_BULK_CRC32C to
+ *                              compute a checksum of the transferred range,
+ *                              returned in the callback info
  * \param origin_addr [IN]      abstract address of origin
  * \param origin_id [IN]        context ID of origin
  * \param origin_handle [IN]    abstract bulk handle
@@ -345,6 +357,7 @@ struct hg_bulk_desc_info {
     hg_size_t len;          /* Size of region */
     uint32_t segment_count; /* Segment count */
     uint8_t flags;          /* Flags of operation access */
+    uint8_t rail_count;     /* Number of bulk rails described */
 };
 
 /*---------------------------------------------------------------------------*/
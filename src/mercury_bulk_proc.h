@@ -30,6 +30,13 @@
 extern "C" {
 #endif
 
+/**
+ * Register handle with the transports that it is serialized for with flags,
+ * if not already registered.
+ */
+HG_PRIVATE hg_return_t
+hg_bulk_register_serialize(hg_bulk_t handle, uint8_t flags);
+
 /**
  * Get pointer to cached serialized buffer if any was priorly set.
  */
@@ -36,18 +36,69 @@
 /* Private flags */
 #define HG_CORE_NO_RESPONSE  (1 << 1) /* No response required */
 #define HG_CORE_SELF_FORWARD (1 << 2) /* Forward to self */
+#define HG_CORE_BATCH        (1 << 3) /* Coalesced requests */
+#define HG_CORE_BATCH_REPLY  (1 << 4) /* Responses of batch may be coalesced */
+
+/* Max number of forwards coalesced into a single message */
+#define HG_CORE_COALESCE_MAX (32)
 
 /* Size of comletion queue used for holding completed requests */
 #define HG_CORE_ATOMIC_QUEUE_SIZE (1024)
 
+/* Max number of high priority completions triggered in a row while default
+ * priority completions are pending */
+#define HG_CORE_PRIORITY_WEIGHT (8)
+
 /* Pre-posted requests and op IDs */
 #define HG_CORE_POST_INIT          (512)
 #define HG_CORE_POST_INCR          (512)
 #define HG_CORE_BULK_OP_INIT_COUNT (256)
 
+/* Max number of freed bulk handles kept for re-use */
+#define HG_CORE_BULK_POOL_MAX (256)
+
+/* Default min size of bulk stripes when bulk rails are used */
+#define HG_CORE_BULK_STRIPE_SIZE (64 * 1024)
+
 /* Number of multi-recv buffer pre-posted */
 #define HG_CORE_MULTI_RECV_OP_COUNT (4)
 
+/* Initial estimate of unexpected message size used to size multi-recv
+ * buffers, refined from the sizes of messages that are received */
+#define HG_CORE_MULTI_RECV_MSG_SIZE_INIT (1024)
+
+/* Weight of new samples in message size moving average (1/N) */
+#define HG_CORE_MULTI_RECV_MSG_SIZE_WEIGHT (16)
+
+/* Only resize multi-recv buffers that are off by more than that factor */
+#define HG_CORE_MULTI_RECV_RESIZE_FACTOR (2)
+
+/* Number of average size payloads that fit in a buffer of packed copies */
+#define HG_CORE_MULTI_RECV_PACK_COUNT (64)
+
+/* Alignment of payloads packed into copy buffers */
+#define HG_CORE_MULTI_RECV_PACK_ALIGN (8)
+
+/* Number of 1 ms slots in timer wheel used for deadlines and hedging */
+#define HG_CORE_TIMER_WHEEL_SIZE (256)
+
+/* Log2 histogram of forward latencies (us) used to derive hedging delay */
+#define HG_CORE_LATENCY_BUCKETS (32)
+
+/* Hedging percentile and number of samples needed before hedging, samples
+ * are halved once max is reached so that old latencies fade out */
+#define HG_CORE_HEDGE_PERCENTILE  (95)
+#define HG_CORE_HEDGE_MIN_SAMPLES (32)
+#define HG_CORE_HEDGE_MAX_SAMPLES (4096)
+
+/* Hedge states */
+#define HG_CORE_HEDGE_NONE    (0) /* No duplicate for this forward */
+#define HG_CORE_HEDGE_ARMED   (1) /* Duplicate will be sent after delay */
+#define HG_CORE_HEDGE_SENDING (2) /* Duplicate is being sent */
+#define HG_CORE_HEDGE_SENT    (3) /* Duplicate is in flight */
+#define HG_CORE_HEDGE_WON     (4) /* Duplicate completed first */
+#define HG_CORE_HEDGE_DONE    (5) /* Forward completed */
+
 /* Timeout on finalize */
 #define HG_CORE_CLEANUP_TIMEOUT (5000)
 
@@ -57,6 +108,10 @@
 /* 32-bit lock value for serial progress */
 #define HG_CORE_PROGRESS_LOCK (0x80000000)
 
+#ifdef _WIN32
+#    define strtok_r strtok_s
+#endif
+
 #ifdef NA_HAS_SM
 /* Addr string format */
 #    define HG_CORE_ADDR_MAX_SIZE      (256)
@@ -69,15 +124,18 @@
 #define HG_CORE_HANDLE_LISTEN          (1 << 1) /* Listener handle */
 #define HG_CORE_HANDLE_MULTI_RECV      (1 << 2) /* Handle used for multi-recv */
 #define HG_CORE_HANDLE_USER            (1 << 3) /* User-created handle */
-#define HG_CORE_HANDLE_MULTI_RECV_COPY (1 << 4) /* Copy on multi-recv */
 
 /* Op status bits */
-#define HG_CORE_OP_COMPLETED  (1 << 0) /* Operation completed */
-#define HG_CORE_OP_CANCELED   (1 << 1) /* Operation canceled */
-#define HG_CORE_OP_POSTED     (1 << 2) /* Operation posted (forward/respond) */
-#define HG_CORE_OP_ERRORED    (1 << 3) /* Operation encountered error */
-#define HG_CORE_OP_QUEUED     (1 << 4) /* Operation queued into CQ */
-#define HG_CORE_OP_MULTI_RECV (1 << 5) /* Operation uses multi-recv */
+#define HG_CORE_OP_COMPLETED   (1 << 0) /* Operation completed */
+#define HG_CORE_OP_CANCELED    (1 << 1) /* Operation canceled */
+#define HG_CORE_OP_POSTED      (1 << 2) /* Operation posted (forward/respond) */
+#define HG_CORE_OP_ERRORED     (1 << 3) /* Operation encountered error */
+#define HG_CORE_OP_QUEUED      (1 << 4) /* Operation queued into CQ */
+#define HG_CORE_OP_MULTI_RECV  (1 << 5) /* Operation uses multi-recv */
+#define HG_CORE_OP_CREDIT_WAIT (1 << 6) /* Forward waiting for a credit */
+#define HG_CORE_OP_COALESCED   (1 << 7) /* Forward coalesced into a batch */
+#define HG_CORE_OP_BATCH_REPLY (1 << 8) /* Response may come with others */
+#define HG_CORE_OP_REPLIED     (1 << 9) /* Response came with others */
 
 /* Encode type */
 #define HG_CORE_TYPE_ENCODE(                                                   \
@@ -138,8 +196,16 @@ struct hg_core_init_info {
     uint32_t request_post_incr;         /* Increment request count */
     uint32_t multi_recv_op_max;         /* Multi-recv op max */
     uint32_t multi_recv_copy_threshold; /* Copy threshold */
+    size_t multi_recv_copy_watermark;   /* Copy watermark (bytes held) */
+    uint32_t rpc_active_max;            /* Max active RPCs per context */
+    uint32_t busy_retry_ms;             /* Retry-after hint sent with busy */
+    uint32_t rpc_credit_max;            /* Max in-flight forwards per addr */
+    uint32_t hedge_percentile;          /* Latency percentile for hedging */
+    uint32_t rpc_coalesce_size;         /* Max size of coalesced requests */
+    uint32_t rpc_coalesce_ms;           /* Max wait of coalesced requests */
     hg_checksum_level_t checksum_level; /* Checksum level */
     uint8_t progress_mode;              /* Progress mode */
+    bool rpc_coalesce_responses;        /* Coalesce responses of batches */
     bool loopback;                      /* Use loopback capability */
     bool na_ext_init;                   /* NA externally initialized */
     bool multi_recv;                    /* Use multi-recv capability */
@@ -182,6 +248,8 @@ struct hg_core_private_class {
 #endif
     struct hg_core_map rpc_map;               /* RPC Map */
     struct hg_core_more_data_cb more_data_cb; /* More data callbacks */
+    struct hg_bulk_pool *hg_bulk_pool;        /* Pool of bulk handles */
+    struct hg_core_rails rails;               /* Bulk rails */
     na_tag_t request_max_tag;                 /* Max value for tag */
 #if defined(HG_HAS_DEBUG) && !defined(_WIN32)
     struct hg_core_counters counters; /* Diag counters */
@@ -198,7 +266,8 @@ enum hg_core_poll_type {
 #ifdef NA_HAS_SM
     HG_CORE_POLL_SM,
 #endif
-    HG_CORE_POLL_NA
+    HG_CORE_POLL_NA,
+    HG_CORE_POLL_RAIL /* First rail, other rails follow */
 };
 
 /* Completion queue */
@@ -242,6 +311,14 @@ struct hg_core_multi_recv_op {
     hg_atomic_int32_t op_count;  /* Total number of ops completed */
 };
 
+/* Buffer that payloads copied out of multi-recv buffers are packed into */
+struct hg_core_multi_recv_pack {
+    char *buf;                   /* Packed payloads */
+    size_t size;                 /* Buffer size */
+    size_t offset;               /* Offset of next payload */
+    hg_atomic_int32_t ref_count; /* Payloads in use, +1 while being filled */
+};
+
 /* Pool of handles */
 struct hg_core_handle_pool {
     hg_thread_mutex_t extend_mutex;          /* To extend pool */
@@ -265,6 +342,49 @@ struct hg_core_progress_multi {
 };
 #endif
 
+/* Timer wheel */
+struct hg_core_timer_wheel {
+    LIST_HEAD(, hg_core_private_handle)
+    slots[HG_CORE_TIMER_WHEEL_SIZE]; /* Handles hashed by expiration (ms) */
+    hg_thread_spin_t lock;           /* Lock */
+    hg_atomic_int64_t next_ms;       /* Earliest expiration (0 if none) */
+    uint64_t tick;                   /* Last tick processed (ms) */
+    unsigned int count;              /* Number of armed timers */
+};
+
+/* Forwards coalesced into a single message */
+struct hg_core_batch {
+    LIST_ENTRY(hg_core_batch) entry; /* Open batch list entry */
+    struct hg_core_private_handle
+        *handles[HG_CORE_COALESCE_MAX]; /* Forwards in batch order */
+    struct hg_core_private_addr *addr;  /* Target addr */
+    uint64_t flush_ms;                  /* Time at which batch is sent */
+    size_t size;                        /* Encoded size of forwards */
+    unsigned int count;                 /* Number of forwards */
+    uint8_t context_id;                 /* Target context ID */
+};
+
+/* Batches that are open on a context */
+struct hg_core_batch_list {
+    LIST_HEAD(, hg_core_batch) list; /* Open batches */
+    hg_thread_spin_t lock;           /* Lock */
+    hg_atomic_int64_t next_ms;       /* Earliest flush time (0 if none) */
+};
+
+/* Forwards given a credit that are waiting to be posted from progress */
+struct hg_core_credit_list {
+    STAILQ_HEAD(, hg_core_private_handle) queue; /* Forwards to post */
+    hg_thread_spin_t lock;                       /* Lock */
+    hg_atomic_int32_t count;                     /* Number of forwards */
+};
+
+/* Responses to batched requests that are waiting to be sent from progress */
+struct hg_core_reply_list {
+    STAILQ_HEAD(, hg_core_private_handle) queue; /* Responses to send */
+    hg_thread_spin_t lock;                       /* Lock */
+    hg_atomic_int32_t count;                     /* Number of responses */
+};
+
 /* HG context */
 struct hg_core_private_context {
     struct hg_core_context core_context; /* Must remain as first field */
@@ -273,6 +393,7 @@ struct hg_core_private_context {
 #endif
     struct hg_core_completion_queue backfill_queue; /* Backfill queue */
     struct hg_atomic_queue *completion_queue;       /* Default queue */
+    struct hg_atomic_queue *priority_queue;         /* High priority queue */
     struct hg_core_loopback_notify loopback_notify; /* Loopback notification */
     struct hg_core_handle_list user_list;           /* Created handle list */
     struct hg_core_handle_list internal_list;       /* Created handle list */
@@ -281,6 +402,12 @@ struct hg_core_private_context {
     struct hg_core_handle_pool *sm_handle_pool; /* Pool of SM handles */
 #endif
     struct hg_core_multi_recv_op *multi_recv_ops;     /* Multi-recv ops */
+    struct hg_core_multi_recv_pack *multi_recv_pack;  /* Copies being packed */
+    hg_thread_spin_t multi_recv_pack_lock;            /* Pack lock */
+    struct hg_core_timer_wheel timer_wheel;           /* Deadline timers */
+    struct hg_core_batch_list coalesce;               /* Open batches */
+    struct hg_core_credit_list credit_ready;          /* Forwards to post */
+    struct hg_core_reply_list reply_ready;            /* Responses to send */
     struct hg_core_handle_create_cb handle_create_cb; /* Handle create cb */
     struct hg_bulk_op_pool *hg_bulk_op_pool;          /* Pool of op IDs */
     struct hg_poll_set *poll_set;                     /* Poll set */
@@ -288,16 +415,34 @@ struct hg_core_private_context {
 #ifdef NA_HAS_SM
     int na_sm_event; /* NA SM event */
 #endif
-    hg_atomic_int32_t multi_recv_op_count; /* Number of multi-recv posted */
-    hg_atomic_int32_t n_handles;           /* Number of handles */
-    hg_atomic_int32_t unposting;           /* Prevent re-posting handles */
-    bool posted;                           /* Posted receives on context */
+    na_context_t *na_rail_contexts[HG_CORE_RAIL_MAX]; /* Bulk rail contexts */
+    int na_rail_events[HG_CORE_RAIL_MAX];             /* Bulk rail events */
+    unsigned int rail; /* Rail used by small bulk transfers */
+    hg_atomic_int64_t multi_recv_held_size; /* Consumed buffer bytes held */
+    hg_atomic_int64_t multi_recv_msg_size;  /* Avg unexpected message size */
+    hg_atomic_int64_t latency_hist[HG_CORE_LATENCY_BUCKETS]; /* Forwards */
+    hg_atomic_int64_t latency_count;        /* Latency samples */
+    hg_atomic_int32_t multi_recv_op_count;  /* Number of multi-recv posted */
+    hg_atomic_int32_t priority_count;       /* High priority entries in a row */
+    hg_atomic_int32_t rpc_active_count;     /* Admitted RPCs being processed */
+    hg_atomic_int32_t n_handles;            /* Number of handles */
+    hg_atomic_int32_t unposting;            /* Prevent re-posting handles */
+    bool posted;                            /* Posted receives on context */
+};
+
+/* Credit window of forwards to a target addr */
+struct hg_core_credits {
+    STAILQ_HEAD(, hg_core_private_handle) queue; /* Forwards waiting */
+    hg_thread_spin_t lock;                       /* Lock */
+    int32_t inflight;                            /* Forwards posted */
+    int32_t window;                              /* Max forwards posted */
 };
 
 /* HG addr */
 struct hg_core_private_addr {
-    struct hg_core_addr core_addr; /* Must remain as first field */
-    size_t na_addr_serialize_size; /* Cached serialization size */
+    struct hg_core_addr core_addr;  /* Must remain as first field */
+    struct hg_core_credits credits; /* Credit window */
+    size_t na_addr_serialize_size;  /* Cached serialization size */
 #ifdef NA_HAS_SM
     size_t na_sm_addr_serialize_size; /* Cached serialization size */
     na_sm_id_t host_id;               /* NA SM Host ID */
@@ -330,6 +475,20 @@ struct hg_core_private_handle {
     struct hg_completion_entry hg_completion_entry; /* Completion queue entry */
     LIST_ENTRY(hg_core_private_handle) created;     /* Created list entry */
     LIST_ENTRY(hg_core_private_handle) pending;     /* Pending list entry */
+    STAILQ_ENTRY(hg_core_private_handle) waiting;   /* Credit wait entry */
+    STAILQ_ENTRY(hg_core_private_handle) replying;  /* Reply list entry */
+    LIST_ENTRY(hg_core_private_handle) timer;       /* Timer wheel entry */
+    struct hg_core_private_addr *hedge_addr;        /* Alternate addr */
+    struct hg_core_private_handle *hedge;           /* Hedged duplicate */
+    struct hg_core_private_handle *hedge_parent;    /* Hedged original */
+    hg_time_t forward_time;                         /* Time of forward */
+    uint64_t deadline_ms;                           /* Deadline (0 if none) */
+    uint64_t hedge_ms;                              /* Duplicate send time */
+    uint64_t timer_ms;                              /* Timer expiration */
+    unsigned int timeout_ms;                        /* Timeout of forwards */
+    hg_atomic_int32_t hedge_state;                  /* Hedge state */
+    struct hg_core_batch *batch;                    /* Batch of forward */
+    struct hg_core_private_handle *batch_parent;    /* Batch of request */
     struct hg_core_header in_header;                /* Input header */
     struct hg_core_header out_header;               /* Output header */
     struct hg_core_handle_list *created_list;       /* Created list */
@@ -349,6 +508,7 @@ struct hg_core_private_handle {
     na_op_id_t *na_recv_op_id;      /* Operation ID for recv */
     na_op_id_t *na_ack_op_id;       /* Operation ID for ack */
     struct hg_core_multi_recv_op *multi_recv_op; /* Multi-recv operation */
+    struct hg_core_multi_recv_pack *multi_recv_pack; /* Packed input copy */
     void *in_buf_storage;                        /* Storage input buffer */
     size_t in_buf_storage_size;                  /* Storage input buffer size */
     na_tag_t tag;                       /* Tag used for request and response */
@@ -362,9 +522,13 @@ struct hg_core_private_handle {
     hg_atomic_int32_t flags;      /* Flags */
     enum hg_core_op_type op_type; /* Core operation type */
     hg_return_t ret;              /* Return code associated to handle */
+    uint32_t retry_ms;            /* Retry-after hint received with response */
     uint8_t cookie;               /* Cookie */
     bool multi_recv_copy;         /* Copy on multi-recv */
     bool reuse;                   /* Re-use handle once ref_count is 0 */
+    bool admitted;                /* Counted as active RPC on context */
+    bool credit;                  /* Holds a credit on target addr */
+    bool timer_armed;             /* Timer is armed in timer wheel */
 #if defined(HG_HAS_DEBUG) && !defined(_WIN32)
     bool active;
 #endif
@@ -440,6 +604,20 @@ hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
 static hg_return_t
 hg_core_finalize(struct hg_core_private_class *hg_core_class);
 
+/**
+ * Initialize bulk rails.
+ */
+static hg_return_t
+hg_core_rails_init(struct hg_core_private_class *hg_core_class,
+    const char *bulk_rails, unsigned int na_version,
+    const struct na_init_info *na_init_info);
+
+/**
+ * Finalize bulk rails.
+ */
+static hg_return_t
+hg_core_rails_finalize(struct hg_core_rails *hg_core_rails);
+
 /**
  * Get counters.
  */
@@ -479,8 +657,8 @@ hg_core_context_unpost(
  * Allocate multi-recv resources.
  */
 static hg_return_t
-hg_core_context_multi_recv_alloc(struct hg_core_private_context *context,
-    na_class_t *na_class, unsigned int request_count);
+hg_core_context_multi_recv_alloc(
+    struct hg_core_private_context *context, na_class_t *na_class);
 
 /**
  * Free multi-recv resources.
@@ -503,6 +681,13 @@ static hg_return_t
 hg_core_context_multi_recv_unpost(struct hg_core_private_context *context,
     na_class_t *na_class, na_context_t *na_context);
 
+/**
+ * Get multi-recv buffer size from observed message sizes.
+ */
+static size_t
+hg_core_context_multi_recv_buf_size(
+    struct hg_core_private_context *context, na_class_t *na_class);
+
 /**
  * Check list of handles not freed.
  */
@@ -764,6 +949,40 @@ static hg_return_t
 hg_core_post_multi(struct hg_core_multi_recv_op *multi_recv_op,
     na_class_t *na_class, na_context_t *na_context);
 
+/**
+ * Repost consumed multi-recv operation, resizing its buffer if needed.
+ */
+static hg_return_t
+hg_core_repost_multi(struct hg_core_multi_recv_op *multi_recv_op,
+    na_class_t *na_class, na_context_t *na_context);
+
+/**
+ * Account for size of multi-recv buffers held by handles.
+ */
+static HG_INLINE void
+hg_core_multi_recv_held_add(
+    struct hg_core_private_context *context, int64_t size);
+
+/**
+ * Update moving average of multi-recv message sizes.
+ */
+static HG_INLINE void
+hg_core_multi_recv_msg_size_update(
+    struct hg_core_private_context *context, size_t size);
+
+/**
+ * Check whether payload should be copied out of multi-recv buffer.
+ */
+static HG_INLINE bool
+hg_core_multi_recv_copy_needed(struct hg_core_private_context *context);
+
+/**
+ * Copy payload out of multi-recv buffer into the context pack buffer.
+ */
+static void *
+hg_core_multi_recv_pack_copy(struct hg_core_private_context *context,
+    const void *buf, size_t size, struct hg_core_multi_recv_pack **pack_p);
+
 /**
  * Release hold on input buffer so that it can be re-used early.
  */
@@ -789,6 +1008,246 @@ hg_core_forward_self(struct hg_core_private_handle *hg_core_handle);
 static hg_return_t
 hg_core_forward_na(struct hg_core_private_handle *hg_core_handle);
 
+/**
+ * Post recv (output) and send (input) of encoded forward.
+ */
+static hg_return_t
+hg_core_forward_na_post(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Pre-post recv (output) of forward.
+ */
+static hg_return_t
+hg_core_forward_na_recv(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Take a credit on target addr or queue forward until one is released.
+ */
+static bool
+hg_core_credit_acquire(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Release credit and queue forwards that were waiting for one to the context
+ * of their handle, they are posted on next progress.
+ */
+static void
+hg_core_credit_release(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Post forwards that were given a credit.
+ */
+static void
+hg_core_credit_process(struct hg_core_private_context *context);
+
+/**
+ * Remove forward from credit wait queue (or from the queue of forwards to post)
+ * and complete it as canceled.
+ */
+static bool
+hg_core_credit_cancel(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Update credit window of target addr from credits granted by target.
+ */
+static void
+hg_core_credit_update(
+    struct hg_core_private_handle *hg_core_handle, uint16_t credits);
+
+/**
+ * Credits that can be granted to origins by target context.
+ */
+static HG_INLINE uint16_t
+hg_core_credit_grant(struct hg_core_private_context *context);
+
+/**
+ * Get current time in ms.
+ */
+static HG_INLINE uint64_t
+hg_core_time_ms(void);
+
+/**
+ * Arm deadline and hedging timers of handle that is being forwarded.
+ */
+static void
+hg_core_timer_forward(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Insert handle into timer wheel.
+ */
+static void
+hg_core_timer_arm(
+    struct hg_core_private_handle *hg_core_handle, uint64_t expire_ms);
+
+/**
+ * Remove handle from timer wheel.
+ */
+static void
+hg_core_timer_disarm(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Fire expired timers.
+ */
+static void
+hg_core_timer_process(struct hg_core_private_context *context);
+
+/**
+ * Bound progress timeout by earliest timer expiration or batch flush.
+ */
+static HG_INLINE unsigned int
+hg_core_timer_timeout(
+    struct hg_core_private_context *context, unsigned int timeout_ms);
+
+/**
+ * Send duplicate or expire handle once its timer fires.
+ */
+static void
+hg_core_timer_fire(struct hg_core_private_handle *hg_core_handle, uint64_t now);
+
+/**
+ * Get hedging delay from observed forward latencies.
+ */
+static bool
+hg_core_hedge_delay(
+    struct hg_core_private_context *context, uint64_t *delay_ms_p);
+
+/**
+ * Send duplicate of forwarded handle to its alternate addr.
+ */
+static hg_return_t
+hg_core_hedge_send(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Duplicate forward callback.
+ */
+static hg_return_t
+hg_core_hedge_cb(const struct hg_core_cb_info *callback_info);
+
+/**
+ * Settle hedged forward on completion of original handle.
+ */
+static void
+hg_core_hedge_complete(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Record forward latency.
+ */
+static void
+hg_core_latency_record(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Check whether forward can be coalesced with other forwards.
+ */
+static HG_INLINE bool
+hg_core_coalesce_eligible(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Add forward to open batch of its target, sending batches that are full.
+ */
+static hg_return_t
+hg_core_coalesce_add(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Remove batch from list of open batches.
+ */
+static void
+hg_core_coalesce_detach(
+    struct hg_core_batch_list *batch_list, struct hg_core_batch *hg_core_batch);
+
+/**
+ * Send batch of forwards.
+ */
+static void
+hg_core_coalesce_flush(struct hg_core_batch *hg_core_batch);
+
+/**
+ * Send batches that are due (or all batches).
+ */
+static void
+hg_core_coalesce_process(struct hg_core_private_context *context, bool all);
+
+/**
+ * Batch forward callback.
+ */
+static hg_return_t
+hg_core_coalesce_cb(const struct hg_core_cb_info *callback_info);
+
+/**
+ * Complete send of coalesced forward.
+ */
+static void
+hg_core_coalesce_complete(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret);
+
+/**
+ * Complete send of coalesced forward whose response recv was already posted.
+ */
+static void
+hg_core_coalesce_abort(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret);
+
+/**
+ * Remove forward from open batch and complete it as canceled.
+ */
+static bool
+hg_core_coalesce_cancel(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Unpack requests of batch and process them.
+ */
+static hg_return_t
+hg_core_batch_process(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Check whether response can be sent along with other responses.
+ */
+static HG_INLINE bool
+hg_core_reply_eligible(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Queue response until the next progress pass.
+ */
+static void
+hg_core_reply_add(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Send queued responses, packing responses to a same batch together.
+ */
+static void
+hg_core_reply_process(struct hg_core_private_context *context);
+
+/**
+ * Send response along with the given responses to the same batch.
+ */
+static void
+hg_core_reply_send(struct hg_core_private_handle *hg_core_handle,
+    struct hg_core_private_handle **entries, unsigned int count);
+
+/**
+ * Post send of queued response.
+ */
+static void
+hg_core_reply_post(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Complete send of queued response.
+ */
+static void
+hg_core_reply_complete(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret);
+
+/**
+ * Unpack responses that came back together and keep own response only.
+ */
+static hg_return_t
+hg_core_reply_unpack(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Pass response to the coalesced forward it belongs to.
+ */
+static void
+hg_core_reply_deliver(struct hg_core_private_handle *hg_core_handle,
+    na_tag_t tag, const void *buf, size_t buf_size);
+
 /**
  * Send response.
  */
@@ -835,6 +1294,24 @@ hg_core_recv_input_cb(const struct na_cb_info *callback_info);
 static void
 hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info);
 
+/**
+ * Check whether context has reached its cap on active RPCs.
+ */
+static HG_INLINE bool
+hg_core_context_overloaded(struct hg_core_private_context *context);
+
+/**
+ * Try to take an admission slot for an incoming RPC.
+ */
+static HG_INLINE bool
+hg_core_admit(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Turn away an incoming RPC that was not admitted.
+ */
+static hg_return_t
+hg_core_reject(struct hg_core_private_handle *hg_core_handle);
+
 /**
  * Process input.
  */
@@ -1233,6 +1710,11 @@ hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
     hg_hash_table_register_free_functions(
         hg_core_class->rpc_map.map, NULL, hg_core_map_value_free);
 
+    /* Create pool of bulk handles */
+    ret = hg_bulk_pool_create(
+        HG_CORE_BULK_POOL_MAX, &hg_core_class->hg_bulk_pool);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret, "Could not create bulk pool");
+
     /* Ensure init info is API compatible */
     if (hg_init_info_p) {
         HG_CHECK_SUBSYS_ERROR(cls, version == 0, error, ret, HG_INVALID_ARG,
@@ -1243,18 +1725,23 @@ hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
         na_init_info_dup_4_0(&na_init_info, &hg_init_info_p->na_init_info);
 
         /* Get init info and overwrite defaults */
-        if (HG_VERSION_GE(version, HG_VERSION(2, 4))) {
+        if (HG_VERSION_GE(version, HG_VERSION(2, 5)))
             hg_init_info = *hg_init_info_p;
-            /* Duplicate traffic class field for now, this will be fixed in
-             * a later major version. */
-            na_init_info.traffic_class = hg_init_info.traffic_class;
-        } else if (HG_VERSION_GE(version, HG_VERSION(2, 3)))
+        else if (HG_VERSION_GE(version, HG_VERSION(2, 4)))
+            hg_init_info_dup_2_4(&hg_init_info,
+                (const struct hg_init_info_2_4 *) hg_init_info_p);
+        else if (HG_VERSION_GE(version, HG_VERSION(2, 3)))
             hg_init_info_dup_2_3(&hg_init_info,
                 (const struct hg_init_info_2_3 *) hg_init_info_p);
         else
             hg_init_info_dup_2_2(&hg_init_info,
                 (const struct hg_init_info_2_2 *) hg_init_info_p);
 
+        /* Duplicate traffic class field for now, this will be fixed in
+         * a later major version. */
+        if (HG_VERSION_GE(version, HG_VERSION(2, 4)))
+            na_init_info.traffic_class = hg_init_info.traffic_class;
+
         HG_LOG_SUBSYS_DEBUG(cls,
             "HG Init info: na_class=%p, request_post_init=%" PRIu32
             ", request_post_incr=%" PRId32 ", auto_sm=%" PRIu8
@@ -1262,7 +1749,10 @@ hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
             ", no_loopback=%" PRIu8 ", stats=%" PRIu8 ", no_multi_recv=%" PRIu8
             ", release_input_early=%" PRIu8
             ", traffic_class=%d, no_overflow=%d, multi_recv_op_max=%u, "
-            "multi_recv_copy_threshold=%u",
+            "multi_recv_copy_threshold=%u, multi_recv_copy_watermark=%zu, "
+            "rpc_active_max=%u, busy_retry_ms=%u, rpc_credit_max=%u, "
+            "hedge_percentile=%u, rpc_coalesce_size=%u, rpc_coalesce_ms=%u, "
+            "rpc_coalesce_responses=%d, bulk_rails=%s, bulk_stripe_size=%zu",
             (void *) hg_init_info.na_class, hg_init_info.request_post_init,
             hg_init_info.request_post_incr, hg_init_info.auto_sm,
             hg_init_info.sm_info_string, hg_init_info.checksum_level,
@@ -1270,7 +1760,13 @@ hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
             hg_init_info.stats, hg_init_info.no_multi_recv,
             hg_init_info.release_input_early, hg_init_info.traffic_class,
             hg_init_info.no_overflow, hg_init_info.multi_recv_op_max,
-            hg_init_info.multi_recv_copy_threshold);
+            hg_init_info.multi_recv_copy_threshold,
+            hg_init_info.multi_recv_copy_watermark,
+            hg_init_info.rpc_active_max, hg_init_info.busy_retry_ms,
+            hg_init_info.rpc_credit_max, hg_init_info.hedge_percentile,
+            hg_init_info.rpc_coalesce_size, hg_init_info.rpc_coalesce_ms,
+            hg_init_info.rpc_coalesce_responses, hg_init_info.bulk_rails,
+            hg_init_info.bulk_stripe_size);
     }
 
     /* Set post init / incr / multi-recv values  */
@@ -1298,6 +1794,30 @@ hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
         (unsigned int) hg_core_class->init_info.multi_recv_op_max);
     hg_core_class->init_info.multi_recv_copy_threshold =
         hg_init_info.multi_recv_copy_threshold;
+    hg_core_class->init_info.multi_recv_copy_watermark =
+        hg_init_info.multi_recv_copy_watermark;
+
+    /* Set admission control values */
+    hg_core_class->init_info.rpc_active_max = hg_init_info.rpc_active_max;
+    hg_core_class->init_info.busy_retry_ms = hg_init_info.busy_retry_ms;
+
+    /* Set flow control values */
+    hg_core_class->init_info.rpc_credit_max =
+        MIN(hg_init_info.rpc_credit_max, (unsigned int) INT32_MAX);
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_init_info.hedge_percentile > 100, error, ret,
+        HG_INVALID_ARG, "hedge_percentile (%u) cannot exceed 100",
+        hg_init_info.hedge_percentile);
+    hg_core_class->init_info.hedge_percentile =
+        (hg_init_info.hedge_percentile == 0) ? HG_CORE_HEDGE_PERCENTILE
+                                             : hg_init_info.hedge_percentile;
+
+    /* Set coalescing values */
+    hg_core_class->init_info.rpc_coalesce_size =
+        MIN(hg_init_info.rpc_coalesce_size, UINT16_MAX);
+    hg_core_class->init_info.rpc_coalesce_ms = hg_init_info.rpc_coalesce_ms;
+    hg_core_class->init_info.rpc_coalesce_responses =
+        hg_init_info.rpc_coalesce_responses;
 
 #ifdef HG_HAS_CHECKSUMS
     /* Save checksum level */
@@ -1422,6 +1942,17 @@ hg_core_init(const char *na_info_string, bool na_listen, unsigned int version,
         "please turn ON NA_USE_SM in CMake options");
 #endif
 
+    /* Initialize bulk rails */
+    hg_core_class->rails.stripe_size = (hg_init_info.bulk_stripe_size == 0)
+                                           ? HG_CORE_BULK_STRIPE_SIZE
+                                           : hg_init_info.bulk_stripe_size;
+    if (hg_init_info.bulk_rails != NULL) {
+        ret = hg_core_rails_init(hg_core_class, hg_init_info.bulk_rails,
+            na_version, na_init_info_p);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            cls, error, ret, "Could not initialize bulk rails");
+    }
+
     *class_p = hg_core_class;
 
     return HG_SUCCESS;
@@ -1440,9 +1971,12 @@ error:
             "Could not finalize NA SM class (%s)", NA_Error_to_string(na_ret));
     }
 #endif
+    (void) hg_core_rails_finalize(&hg_core_class->rails);
     if (hg_core_class->rpc_map.map)
         hg_hash_table_free(hg_core_class->rpc_map.map);
     (void) hg_thread_rwlock_destroy(&hg_core_class->rpc_map.lock);
+    if (hg_core_class->hg_bulk_pool != NULL)
+        hg_bulk_pool_destroy(hg_core_class->hg_bulk_pool);
 
 error_free:
     free(hg_core_class);
@@ -1496,6 +2030,10 @@ hg_core_finalize(struct hg_core_private_class *hg_core_class)
     }
 #endif
 
+    /* Finalize bulk rails */
+    ret = hg_core_rails_finalize(&hg_core_class->rails);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret, "Could not finalize bulk rails");
+
     /* Free user data */
     if (hg_core_class->core_class.data_free_callback)
         hg_core_class->core_class.data_free_callback(
@@ -1507,6 +2045,12 @@ hg_core_finalize(struct hg_core_private_class *hg_core_class)
         hg_core_class->rpc_map.map = NULL;
     }
     (void) hg_thread_rwlock_destroy(&hg_core_class->rpc_map.lock);
+
+    /* Destroy pool of bulk handles */
+    if (hg_core_class->hg_bulk_pool != NULL) {
+        hg_bulk_pool_destroy(hg_core_class->hg_bulk_pool);
+        hg_core_class->hg_bulk_pool = NULL;
+    }
     free(hg_core_class);
 
     return HG_SUCCESS;
@@ -1516,24 +2060,113 @@ error:
 }
 
 /*---------------------------------------------------------------------------*/
-#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
-static void
-hg_core_class_get_counters(const struct hg_core_counters *counters,
-    struct hg_diag_counters *diag_counters)
+static hg_return_t
+hg_core_rails_init(struct hg_core_private_class *hg_core_class,
+    const char *bulk_rails, unsigned int na_version,
+    const struct na_init_info *na_init_info)
 {
-    *diag_counters = (struct hg_diag_counters){
-        .rpc_req_sent_count =
-            (uint64_t) hg_atomic_get64(counters->rpc_req_sent_count),
-        .rpc_req_recv_count =
-            (uint64_t) hg_atomic_get64(counters->rpc_req_recv_count),
-        .rpc_resp_sent_count =
-            (uint64_t) hg_atomic_get64(counters->rpc_resp_sent_count),
-        .rpc_resp_recv_count =
-            (uint64_t) hg_atomic_get64(counters->rpc_resp_recv_count),
-        .rpc_req_extra_count =
-            (uint64_t) hg_atomic_get64(counters->rpc_req_extra_count),
-        .rpc_resp_extra_count =
-            (uint64_t) hg_atomic_get64(counters->rpc_resp_extra_count),
+    struct hg_core_rails *hg_core_rails = &hg_core_class->rails;
+    char *rails_string, *info_string, *next = NULL;
+    hg_return_t ret;
+
+    rails_string = strdup(bulk_rails);
+    HG_CHECK_SUBSYS_ERROR(cls, rails_string == NULL, error, ret, HG_NOMEM,
+        "Could not duplicate bulk rails string");
+
+    for (info_string = strtok_r(rails_string, ",", &next); info_string != NULL;
+         info_string = strtok_r(NULL, ",", &next)) {
+        struct hg_core_rail *rail;
+        na_return_t na_ret;
+
+        HG_CHECK_SUBSYS_ERROR(cls, hg_core_rails->count == HG_CORE_RAIL_MAX,
+            error, ret, HG_INVALID_ARG, "Cannot use more than %d bulk rails",
+            HG_CORE_RAIL_MAX);
+        rail = &hg_core_rails->rails[hg_core_rails->count];
+
+        rail->na_class = NA_Initialize_opt2(info_string,
+            hg_core_class->init_info.listen, na_version, na_init_info);
+        HG_CHECK_SUBSYS_ERROR(cls, rail->na_class == NULL, error, ret,
+            HG_NA_ERROR,
+            "Could not initialize NA rail class (info_string=%s, listen=%d)",
+            info_string, hg_core_class->init_info.listen);
+        hg_core_rails->count++;
+
+        /* Self address is sent along with bulk descriptors */
+        na_ret = NA_Addr_self(rail->na_class, &rail->self_addr);
+        HG_CHECK_SUBSYS_ERROR(cls, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not get rail self address (%s)",
+            NA_Error_to_string(na_ret));
+        rail->self_addr_size =
+            NA_Addr_get_serialize_size(rail->na_class, rail->self_addr);
+        HG_CHECK_SUBSYS_ERROR(cls, rail->self_addr_size == 0, error, ret,
+            HG_PROTOCOL_ERROR, "Rail address cannot be serialized");
+
+        rail->numa_node = NA_Get_numa_node(rail->na_class);
+
+        HG_LOG_SUBSYS_DEBUG(cls,
+            "Initialized bulk rail %u (info_string=%s, numa_node=%d)",
+            hg_core_rails->count, info_string, rail->numa_node);
+    }
+
+    free(rails_string);
+
+    return HG_SUCCESS;
+
+error:
+    free(rails_string);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_rails_finalize(struct hg_core_rails *hg_core_rails)
+{
+    hg_return_t ret;
+
+    while (hg_core_rails->count > 0) {
+        struct hg_core_rail *rail =
+            &hg_core_rails->rails[hg_core_rails->count - 1];
+        na_return_t na_ret;
+
+        if (rail->self_addr != NULL) {
+            NA_Addr_free(rail->na_class, rail->self_addr);
+            rail->self_addr = NULL;
+        }
+
+        na_ret = NA_Finalize(rail->na_class);
+        HG_CHECK_SUBSYS_ERROR(cls, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not finalize NA rail class (%s)",
+            NA_Error_to_string(na_ret));
+        rail->na_class = NULL;
+        hg_core_rails->count--;
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+#if defined(HG_HAS_DEBUG) && !defined(_WIN32)
+static void
+hg_core_class_get_counters(const struct hg_core_counters *counters,
+    struct hg_diag_counters *diag_counters)
+{
+    *diag_counters = (struct hg_diag_counters){
+        .rpc_req_sent_count =
+            (uint64_t) hg_atomic_get64(counters->rpc_req_sent_count),
+        .rpc_req_recv_count =
+            (uint64_t) hg_atomic_get64(counters->rpc_req_recv_count),
+        .rpc_resp_sent_count =
+            (uint64_t) hg_atomic_get64(counters->rpc_resp_sent_count),
+        .rpc_resp_recv_count =
+            (uint64_t) hg_atomic_get64(counters->rpc_resp_recv_count),
+        .rpc_req_extra_count =
+            (uint64_t) hg_atomic_get64(counters->rpc_req_extra_count),
+        .rpc_resp_extra_count =
+            (uint64_t) hg_atomic_get64(counters->rpc_resp_extra_count),
         .rpc_req_recv_active_count =
             (uint64_t) hg_atomic_get64(counters->rpc_req_recv_active_count),
         .rpc_multi_recv_copy_count =
@@ -1558,6 +2191,20 @@ hg_core_bulk_decr(hg_core_class_t *hg_core_class)
         &((struct hg_core_private_class *) hg_core_class)->n_bulks);
 }
 
+/*---------------------------------------------------------------------------*/
+struct hg_bulk_pool *
+hg_core_class_get_bulk_pool(hg_core_class_t *hg_core_class)
+{
+    return ((struct hg_core_private_class *) hg_core_class)->hg_bulk_pool;
+}
+
+/*---------------------------------------------------------------------------*/
+const struct hg_core_rails *
+hg_core_class_get_rails(hg_core_class_t *hg_core_class)
+{
+    return &((struct hg_core_private_class *) hg_core_class)->rails;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
@@ -1569,7 +2216,10 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
     int na_poll_fd, loopback_event = 0, rc;
     bool backfill_queue_mutex_init = false, backfill_queue_cond_init = false,
          loopback_notify_mutex_init = false, user_list_lock_init = false,
-         internal_list_lock_init = false;
+         internal_list_lock_init = false, timer_wheel_lock_init = false,
+         coalesce_lock_init = false, credit_ready_lock_init = false,
+         reply_ready_lock_init = false;
+    unsigned int i;
 #ifdef HG_HAS_MULTI_PROGRESS
     struct hg_core_progress_multi *progress_multi = NULL;
     bool progress_multi_mutex_init = false, progress_multi_cond_init = false;
@@ -1578,6 +2228,7 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
     context = (struct hg_core_private_context *) calloc(1, sizeof(*context));
     HG_CHECK_SUBSYS_ERROR(ctx, context == NULL, error, ret, HG_NOMEM,
         "Could not allocate HG context");
+    hg_atomic_init32(&context->rpc_active_count, 0);
     hg_atomic_init32(&context->n_handles, 0);
     hg_atomic_init32(&context->unposting, 0);
 
@@ -1600,6 +2251,11 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
     HG_CHECK_SUBSYS_ERROR(ctx, context->completion_queue == NULL, error, ret,
         HG_NOMEM, "Could not allocate queue");
 
+    context->priority_queue = hg_atomic_queue_alloc(HG_CORE_ATOMIC_QUEUE_SIZE);
+    HG_CHECK_SUBSYS_ERROR(ctx, context->priority_queue == NULL, error, ret,
+        HG_NOMEM, "Could not allocate priority queue");
+    hg_atomic_init32(&context->priority_count, 0);
+
     /* Notifications of completion queue events */
     hg_atomic_init32(&context->loopback_notify.must_notify, 0);
     hg_atomic_init32(&context->loopback_notify.nevents, 0);
@@ -1620,6 +2276,43 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
         "hg_thread_spin_init() failed");
     internal_list_lock_init = true;
 
+    /* Deadline timers and forward latency samples */
+    for (i = 0; i < HG_CORE_TIMER_WHEEL_SIZE; i++)
+        LIST_INIT(&context->timer_wheel.slots[i]);
+    hg_atomic_init64(&context->timer_wheel.next_ms, 0);
+    context->timer_wheel.tick = hg_core_time_ms();
+    rc = hg_thread_spin_init(&context->timer_wheel.lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
+    timer_wheel_lock_init = true;
+    for (i = 0; i < HG_CORE_LATENCY_BUCKETS; i++)
+        hg_atomic_init64(&context->latency_hist[i], 0);
+    hg_atomic_init64(&context->latency_count, 0);
+
+    /* Batches of coalesced forwards */
+    LIST_INIT(&context->coalesce.list);
+    hg_atomic_init64(&context->coalesce.next_ms, 0);
+    rc = hg_thread_spin_init(&context->coalesce.lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
+    coalesce_lock_init = true;
+
+    /* Forwards released by credits */
+    STAILQ_INIT(&context->credit_ready.queue);
+    hg_atomic_init32(&context->credit_ready.count, 0);
+    rc = hg_thread_spin_init(&context->credit_ready.lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
+    credit_ready_lock_init = true;
+
+    /* Responses to batched requests */
+    STAILQ_INIT(&context->reply_ready.queue);
+    hg_atomic_init32(&context->reply_ready.count, 0);
+    rc = hg_thread_spin_init(&context->reply_ready.lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
+    reply_ready_lock_init = true;
+
 #ifdef HG_HAS_MULTI_PROGRESS
     /* Initialize multi-progress lock */
     progress_multi = &context->progress_multi;
@@ -1650,6 +2343,14 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
     }
 #endif
 
+    /* Rail contexts use the same ID so that remote ones can be targeted */
+    for (i = 0; i < hg_core_class->rails.count; i++) {
+        context->na_rail_contexts[i] =
+            NA_Context_create_id(hg_core_class->rails.rails[i].na_class, id);
+        HG_CHECK_SUBSYS_ERROR(ctx, context->na_rail_contexts[i] == NULL, error,
+            ret, HG_NOMEM, "Could not create NA rail context");
+    }
+
     /* If NA plugin exposes fd, we will use poll set and use appropriate
      * progress function */
     na_poll_fd = NA_Poll_get_fd(
@@ -1659,7 +2360,8 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
         (na_poll_fd > 0)) {
         struct hg_poll_event event = {.events = HG_POLLIN, .data.u64 = 0};
 
-        /* Create poll set */
+        /* Create poll set (NA_POLL_IO_URING is left to the plugin, waiting
+         * on a ring fd from another ring delays wake-ups) */
         context->poll_set = hg_poll_create();
         HG_CHECK_SUBSYS_ERROR(ctx, context->poll_set == NULL, error, ret,
             HG_NOMEM, "Could not create poll set");
@@ -1686,6 +2388,19 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
         }
 #endif
 
+        for (i = 0; i < hg_core_class->rails.count; i++) {
+            na_poll_fd = NA_Poll_get_fd(hg_core_class->rails.rails[i].na_class,
+                context->na_rail_contexts[i]);
+            HG_CHECK_SUBSYS_ERROR(ctx, na_poll_fd < 0, error, ret,
+                HG_PROTOCOL_ERROR, "Could not get NA rail poll fd");
+
+            event.data.u32 = (uint32_t) HG_CORE_POLL_RAIL + i;
+            rc = hg_poll_add(context->poll_set, na_poll_fd, &event);
+            HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+                HG_NOMEM, "hg_poll_add() failed (na_poll_fd=%d)", na_poll_fd);
+            context->na_rail_events[i] = na_poll_fd;
+        }
+
         if (hg_core_class->init_info.loopback) {
             /* Create event for completion queue notification */
             loopback_event = hg_event_create();
@@ -1705,6 +2420,9 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class, uint8_t id,
     /* Assign context ID */
     context->core_context.id = id;
 
+    /* Spread small bulk transfers of contexts across rails by default */
+    context->rail = id % (hg_core_class->rails.count + 1);
+
     /* Create pool of bulk op IDs */
     ret = hg_bulk_op_pool_create((hg_core_context_t *) context,
         HG_CORE_BULK_OP_INIT_COUNT, &context->hg_bulk_op_pool);
@@ -1732,6 +2450,14 @@ error:
                     "Could not remove NA SM poll descriptor from poll set");
             }
 #endif
+            for (i = 0; i < hg_core_class->rails.count; i++) {
+                if (context->na_rail_events[i] <= 0)
+                    continue;
+                rc = hg_poll_remove(
+                    context->poll_set, context->na_rail_events[i]);
+                HG_CHECK_SUBSYS_ERROR_DONE(ctx, rc != HG_UTIL_SUCCESS,
+                    "Could not remove NA rail poll descriptor from poll set");
+            }
             if (context->loopback_notify.event > 0) {
                 rc = hg_poll_remove(
                     context->poll_set, context->loopback_notify.event);
@@ -1767,6 +2493,17 @@ error:
                 NA_Error_to_string(na_ret));
         }
 #endif
+        for (i = 0; i < hg_core_class->rails.count; i++) {
+            na_return_t na_ret;
+
+            if (context->na_rail_contexts[i] == NULL)
+                continue;
+            na_ret = NA_Context_destroy(hg_core_class->rails.rails[i].na_class,
+                context->na_rail_contexts[i]);
+            HG_CHECK_SUBSYS_ERROR_DONE(ctx, na_ret != NA_SUCCESS,
+                "Could not destroy NA rail context (%s)",
+                NA_Error_to_string(na_ret));
+        }
 
         if (backfill_queue_mutex_init)
             (void) hg_thread_mutex_destroy(&backfill_queue->mutex);
@@ -1778,6 +2515,14 @@ error:
             (void) hg_thread_spin_destroy(&context->user_list.lock);
         if (internal_list_lock_init)
             (void) hg_thread_spin_destroy(&context->internal_list.lock);
+        if (timer_wheel_lock_init)
+            (void) hg_thread_spin_destroy(&context->timer_wheel.lock);
+        if (coalesce_lock_init)
+            (void) hg_thread_spin_destroy(&context->coalesce.lock);
+        if (credit_ready_lock_init)
+            (void) hg_thread_spin_destroy(&context->credit_ready.lock);
+        if (reply_ready_lock_init)
+            (void) hg_thread_spin_destroy(&context->reply_ready.lock);
 #ifdef HG_HAS_MULTI_PROGRESS
         if (progress_multi_mutex_init)
             (void) hg_thread_mutex_destroy(&progress_multi->mutex);
@@ -1785,6 +2530,7 @@ error:
             (void) hg_thread_cond_destroy(&progress_multi->cond);
 #endif
         hg_atomic_queue_free(context->completion_queue);
+        hg_atomic_queue_free(context->priority_queue);
         free(context);
     }
 
@@ -1802,6 +2548,7 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     struct hg_core_completion_queue *backfill_queue = NULL;
     bool empty;
     hg_return_t ret;
+    unsigned int i;
     int rc;
 
     if (context == NULL)
@@ -1816,6 +2563,12 @@ hg_core_context_destroy(struct hg_core_private_context *context)
         error, ret, HG_BUSY, "Still progressing on context");
 #endif
 
+    /* Send forwards that are still waiting to be coalesced or posted, and
+     * responses that are still waiting to be sent */
+    hg_core_coalesce_process(context, true);
+    hg_core_credit_process(context);
+    hg_core_reply_process(context);
+
     if (context->posted) {
         /* Unpost requests */
         ret = hg_core_context_unpost(context, HG_CORE_CLEANUP_TIMEOUT);
@@ -1851,8 +2604,9 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     HG_CHECK_SUBSYS_ERROR(ctx, empty == false, error, ret, HG_BUSY,
         "Completion queue should be empty");
 
-    /* Check that atomic completion queue is empty now */
-    empty = hg_atomic_queue_is_empty(context->completion_queue);
+    /* Check that atomic completion queues are empty now */
+    empty = hg_atomic_queue_is_empty(context->completion_queue) &&
+            hg_atomic_queue_is_empty(context->priority_queue);
     HG_CHECK_SUBSYS_ERROR(ctx, empty == false, error, ret, HG_BUSY,
         "Completion queue should be empty");
 
@@ -1890,6 +2644,15 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     }
 #endif
 
+    for (i = 0; i < hg_core_class->rails.count; i++) {
+        if (context->na_rail_events[i] <= 0)
+            continue;
+        rc = hg_poll_remove(context->poll_set, context->na_rail_events[i]);
+        HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret,
+            HG_NOENTRY, "Could not remove NA rail event from poll set");
+        context->na_rail_events[i] = 0;
+    }
+
     /* Destroy poll set */
     if (context->poll_set != NULL) {
         rc = hg_poll_destroy(context->poll_set);
@@ -1922,6 +2685,20 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     }
 #endif
 
+    /* Destroy NA rail contexts */
+    for (i = 0; i < hg_core_class->rails.count; i++) {
+        na_return_t na_ret;
+
+        if (context->na_rail_contexts[i] == NULL)
+            continue;
+        na_ret = NA_Context_destroy(hg_core_class->rails.rails[i].na_class,
+            context->na_rail_contexts[i]);
+        HG_CHECK_SUBSYS_ERROR(ctx, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not destroy NA rail context (%s)",
+            NA_Error_to_string(na_ret));
+        context->na_rail_contexts[i] = NULL;
+    }
+
     /* Free user data */
     if (context->core_context.data_free_callback)
         context->core_context.data_free_callback(context->core_context.data);
@@ -1932,12 +2709,17 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     (void) hg_thread_mutex_destroy(&context->loopback_notify.mutex);
     (void) hg_thread_spin_destroy(&context->user_list.lock);
     (void) hg_thread_spin_destroy(&context->internal_list.lock);
+    (void) hg_thread_spin_destroy(&context->timer_wheel.lock);
+    (void) hg_thread_spin_destroy(&context->coalesce.lock);
+    (void) hg_thread_spin_destroy(&context->credit_ready.lock);
+    (void) hg_thread_spin_destroy(&context->reply_ready.lock);
 #ifdef HG_HAS_MULTI_PROGRESS
     (void) hg_thread_mutex_destroy(&progress_multi->mutex);
     (void) hg_thread_cond_destroy(&progress_multi->cond);
 #endif
 
     hg_atomic_queue_free(context->completion_queue);
+    hg_atomic_queue_free(context->priority_queue);
     free(context);
 
     /* Decrement context count of parent class */
@@ -1964,14 +2746,11 @@ hg_core_context_post(struct hg_core_private_context *context)
 
     /* Allocate multi-recv operations */
     if (hg_core_class->init_info.multi_recv) {
-        ret = hg_core_context_multi_recv_alloc(context,
-            hg_core_class->core_class.na_class,
-            hg_core_class->init_info.request_post_init);
+        ret = hg_core_context_multi_recv_alloc(
+            context, hg_core_class->core_class.na_class);
         HG_CHECK_SUBSYS_HG_ERROR(
             ctx, error, ret, "Could not allocate multi-recv resources");
         flags |= HG_CORE_HANDLE_MULTI_RECV;
-        if (hg_core_class->init_info.multi_recv_copy_threshold > 0)
-            flags |= HG_CORE_HANDLE_MULTI_RECV_COPY;
     }
 
     /* Create pool of handles */
@@ -2089,8 +2868,8 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_multi_recv_alloc(struct hg_core_private_context *context,
-    na_class_t *na_class, unsigned int request_count)
+hg_core_context_multi_recv_alloc(
+    struct hg_core_private_context *context, na_class_t *na_class)
 {
     unsigned int multi_recv_op_max =
         HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_op_max;
@@ -2101,11 +2880,17 @@ hg_core_context_multi_recv_alloc(struct hg_core_private_context *context,
     unexpected_msg_size = NA_Msg_get_max_unexpected_size(na_class);
     HG_CHECK_SUBSYS_ERROR(ctx, unexpected_msg_size == 0, error, ret,
         HG_INVALID_PARAM, "Invalid unexpected message size");
+    hg_atomic_init64(&context->multi_recv_held_size, 0);
+    hg_atomic_init64(&context->multi_recv_msg_size,
+        (int64_t) MIN(unexpected_msg_size, HG_CORE_MULTI_RECV_MSG_SIZE_INIT));
+
     context->multi_recv_ops =
         calloc(multi_recv_op_max, sizeof(*context->multi_recv_ops));
     HG_CHECK_SUBSYS_ERROR(ctx, context->multi_recv_ops == NULL, error, ret,
         HG_NOMEM, "Could not allocate %u multi-recv op entries",
         multi_recv_op_max);
+    context->multi_recv_pack = NULL;
+    (void) hg_thread_spin_init(&context->multi_recv_pack_lock);
 
     for (i = 0; i < multi_recv_op_max; i++) {
         struct hg_core_multi_recv_op *multi_recv_op =
@@ -2116,9 +2901,10 @@ hg_core_context_multi_recv_alloc(struct hg_core_private_context *context,
         HG_CHECK_SUBSYS_ERROR(ctx, multi_recv_op->op_id == NULL, error, ret,
             HG_NOMEM, "Could not create new OP ID");
 
-        /* Keep total buffer size as max of unexpected msg size x number of
-         * "pre-posted" operations. */
-        multi_recv_op->buf_size = request_count * unexpected_msg_size;
+        /* Size buffers for request_count messages of expected size rather
+         * than of max unexpected size, buffers get resized on repost */
+        multi_recv_op->buf_size =
+            hg_core_context_multi_recv_buf_size(context, na_class);
 
         multi_recv_op->buf = NA_Msg_buf_alloc(na_class, multi_recv_op->buf_size,
             NA_MULTI_RECV, &multi_recv_op->plugin_data);
@@ -2184,6 +2970,13 @@ hg_core_context_multi_recv_free(
         multi_recv_op->buf_size = 0;
     }
     free(context->multi_recv_ops);
+
+    /* Pack buffer is freed once handles release their copies */
+    if (context->multi_recv_pack != NULL) {
+        hg_core_multi_recv_pack_release(context->multi_recv_pack);
+        context->multi_recv_pack = NULL;
+    }
+    (void) hg_thread_spin_destroy(&context->multi_recv_pack_lock);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2251,6 +3044,20 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static size_t
+hg_core_context_multi_recv_buf_size(
+    struct hg_core_private_context *context, na_class_t *na_class)
+{
+    size_t request_count =
+        (size_t) HG_CORE_CONTEXT_CLASS(context)->init_info.request_post_init;
+    size_t unexpected_msg_size = NA_Msg_get_max_unexpected_size(na_class);
+    size_t msg_size = (size_t) hg_atomic_get64(&context->multi_recv_msg_size);
+
+    return hg_core_multi_recv_buf_size(
+        request_count, msg_size, unexpected_msg_size);
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_context_check_handle_list(struct hg_core_handle_list *handle_list)
@@ -2335,6 +3142,53 @@ hg_core_context_get_bulk_op_pool(struct hg_core_context *core_context)
     return ((struct hg_core_private_context *) core_context)->hg_bulk_op_pool;
 }
 
+/*---------------------------------------------------------------------------*/
+na_context_t *
+hg_core_context_get_na_rail(
+    struct hg_core_context *core_context, unsigned int rail)
+{
+    return ((struct hg_core_private_context *) core_context)
+        ->na_rail_contexts[rail];
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_core_context_get_rail(struct hg_core_context *core_context)
+{
+    return ((struct hg_core_private_context *) core_context)->rail;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_core_context_set_numa_node(
+    struct hg_core_context *core_context, int numa_node)
+{
+    struct hg_core_private_context *context =
+        (struct hg_core_private_context *) core_context;
+    const struct hg_core_rails *hg_core_rails =
+        &HG_CORE_CONTEXT_CLASS(context)->rails;
+    unsigned int local_rails[HG_CORE_RAIL_MAX + 1], count = 0, i;
+
+    if (numa_node < 0)
+        return;
+
+    /* Rail 0 is the main NA class */
+    if (NA_Get_numa_node(core_context->core_class->na_class) == numa_node)
+        local_rails[count++] = 0;
+    for (i = 0; i < hg_core_rails->count; i++)
+        if (hg_core_rails->rails[i].numa_node == numa_node)
+            local_rails[count++] = i + 1;
+
+    /* Keep default if no rail is local, otherwise spread contexts across
+     * local rails */
+    if (count > 0)
+        context->rail = local_rails[core_context->id % count];
+
+    HG_LOG_SUBSYS_DEBUG(ctx,
+        "Context %" PRIu8 " on NUMA node %d uses bulk rail %u",
+        core_context->id, numa_node, context->rail);
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_handle_pool_create(struct hg_core_private_context *context,
@@ -2844,6 +3698,12 @@ hg_core_addr_create(struct hg_core_private_class *hg_core_class,
 #endif
     hg_core_addr->core_addr.is_self = false;
 
+    STAILQ_INIT(&hg_core_addr->credits.queue);
+    hg_thread_spin_init(&hg_core_addr->credits.lock);
+    hg_core_addr->credits.inflight = 0;
+    hg_core_addr->credits.window =
+        (int32_t) hg_core_class->init_info.rpc_credit_max;
+
     hg_atomic_init32(&hg_core_addr->ref_count, 1);
 
     /* Increment N addrs from HG class */
@@ -2876,6 +3736,7 @@ hg_core_addr_free(struct hg_core_private_addr *hg_core_addr)
     /* Free NA addresses */
     hg_core_addr_free_na(hg_core_addr);
 
+    hg_thread_spin_destroy(&hg_core_addr->credits.lock);
     free(hg_core_addr);
 
     /* Decrement N addrs from HG class */
@@ -3408,6 +4269,7 @@ error:
 static hg_return_t
 hg_core_destroy(struct hg_core_private_handle *hg_core_handle)
 {
+    struct hg_core_private_handle *hg_core_batch_handle;
     int32_t ref_count, flags, no_response_done = 0;
     hg_return_t ret;
 
@@ -3443,6 +4305,15 @@ hg_core_destroy(struct hg_core_private_handle *hg_core_handle)
     }
 #endif
 
+    /* Release admission slot */
+    if (hg_core_handle->admitted) {
+        hg_atomic_decr32(
+            &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->rpc_active_count);
+        hg_core_handle->admitted = false;
+    }
+
+    hg_core_batch_handle = hg_core_handle->batch_parent;
+
     /* Re-use handle if we were listening, otherwise destroy it */
     if (hg_core_handle->reuse &&
         !hg_atomic_get32(&HG_CORE_HANDLE_CONTEXT(hg_core_handle)->unposting)) {
@@ -3480,6 +4351,10 @@ hg_core_destroy(struct hg_core_private_handle *hg_core_handle)
         hg_core_free(hg_core_handle);
     }
 
+    /* Input was read from batch buffer, release batch only now */
+    if (hg_core_batch_handle != NULL)
+        (void) hg_core_destroy(hg_core_batch_handle);
+
     return HG_SUCCESS;
 
 error:
@@ -3555,6 +4430,7 @@ hg_core_free(struct hg_core_private_handle *hg_core_handle)
     /* Remove reference to HG addr */
     hg_core_addr_free(
         (struct hg_core_private_addr *) hg_core_handle->core_handle.info.addr);
+    hg_core_addr_free(hg_core_handle->hedge_addr);
 
     /* Remove handle from list */
     hg_thread_spin_lock(&hg_core_handle->created_list->lock);
@@ -3583,18 +4459,9 @@ hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
     hg_core_handle->na_context = na_context;
 
     /* When using multi-recv, only allocate resources per handle for expected
-     * messages. */
+     * messages. Payloads that are copied out of multi-recv buffers are packed
+     * into buffers shared by the context. */
     if (flags & HG_CORE_HANDLE_MULTI_RECV) {
-        if (flags & HG_CORE_HANDLE_MULTI_RECV_COPY) {
-            hg_core_handle->in_buf_storage_size =
-                NA_Msg_get_max_unexpected_size(na_class);
-
-            hg_core_handle->in_buf_storage =
-                NA_Msg_buf_alloc(na_class, hg_core_handle->in_buf_storage_size,
-                    NA_RECV, &hg_core_handle->in_buf_plugin_data);
-            HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->in_buf_storage == NULL,
-                error, ret, HG_NOMEM, "Could not allocate buffer for input");
-        }
         hg_core_handle->core_handle.in_buf = NULL;
         hg_core_handle->core_handle.in_buf_size = 0;
     } else {
@@ -3689,6 +4556,10 @@ hg_core_free_na(struct hg_core_private_handle *hg_core_handle)
         hg_atomic_decr32(&hg_core_handle->multi_recv_op->ref_count);
         hg_core_handle->multi_recv_op = NULL;
     }
+    if (hg_core_handle->multi_recv_pack != NULL) {
+        hg_core_multi_recv_pack_release(hg_core_handle->multi_recv_pack);
+        hg_core_handle->multi_recv_pack = NULL;
+    }
     NA_Msg_buf_free(hg_core_handle->na_class, hg_core_handle->in_buf_storage,
         hg_core_handle->in_buf_plugin_data);
     hg_core_handle->in_buf_storage = NULL;
@@ -3731,6 +4602,11 @@ hg_core_reset(struct hg_core_private_handle *hg_core_handle)
     hg_core_handle->tag = 0;
     hg_core_handle->cookie = 0;
     hg_core_handle->ret = HG_SUCCESS;
+    hg_core_handle->retry_ms = 0;
+    hg_core_handle->deadline_ms = 0;
+    hg_core_handle->timeout_ms = 0;
+    hg_core_addr_free(hg_core_handle->hedge_addr);
+    hg_core_handle->hedge_addr = NULL;
     hg_core_handle->core_handle.in_buf_used = 0;
     hg_core_handle->core_handle.out_buf_used = 0;
     hg_atomic_init32(
@@ -3784,6 +4660,10 @@ hg_core_reset_post(struct hg_core_private_handle *hg_core_handle)
         hg_core_handle->core_handle.in_buf = NULL;
         hg_core_handle->core_handle.in_buf_size = 0;
         hg_core_handle->multi_recv_op = NULL;
+        if (hg_core_handle->multi_recv_pack != NULL) {
+            hg_core_multi_recv_pack_release(hg_core_handle->multi_recv_pack);
+            hg_core_handle->multi_recv_pack = NULL;
+        }
     }
 
 #ifdef NA_HAS_SM
@@ -3805,15 +4685,10 @@ hg_core_reset_post(struct hg_core_private_handle *hg_core_handle)
         if (multi_recv_op != NULL &&
             hg_atomic_decr32(&multi_recv_op->ref_count) == 0 &&
             hg_atomic_get32(&multi_recv_op->last)) {
-            HG_LOG_SUBSYS_DEBUG(
-                ctx, "Reposting multi-recv buffer %d", multi_recv_op->id);
-
-            /* Repost multi recv */
-            ret = hg_core_post_multi(multi_recv_op,
+            ret = hg_core_repost_multi(multi_recv_op,
                 hg_core_handle_pool->na_class, hg_core_handle_pool->na_context);
             HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
-                "Cannot repost multi-recv operation (%d)", multi_recv_op->id);
-            hg_atomic_incr32(&context->multi_recv_op_count);
+                "Could not repost multi-recv operation");
         }
     } else {
         /* Repost single recv */
@@ -3943,6 +4818,219 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_repost_multi(struct hg_core_multi_recv_op *multi_recv_op,
+    na_class_t *na_class, na_context_t *na_context)
+{
+    struct hg_core_private_context *context = multi_recv_op->context;
+    size_t buf_size;
+    hg_return_t ret;
+
+    /* Buffer is no longer held by handles */
+    hg_core_multi_recv_held_add(context, -(int64_t) multi_recv_op->buf_size);
+
+    /* Resize buffer if observed message sizes no longer match */
+    buf_size = hg_core_context_multi_recv_buf_size(context, na_class);
+    if (hg_core_multi_recv_buf_resize(multi_recv_op->buf_size, buf_size)) {
+        void *plugin_data = NULL;
+        void *buf =
+            NA_Msg_buf_alloc(na_class, buf_size, NA_MULTI_RECV, &plugin_data);
+
+        /* Not fatal, keep using previous buffer */
+        if (buf == NULL)
+            HG_LOG_SUBSYS_WARNING(ctx,
+                "Could not resize multi-recv buffer %u from %zu to %zu",
+                multi_recv_op->id, multi_recv_op->buf_size, buf_size);
+        else {
+            HG_LOG_SUBSYS_DEBUG(ctx,
+                "Resizing multi-recv buffer %u from %zu to %zu",
+                multi_recv_op->id, multi_recv_op->buf_size, buf_size);
+            NA_Msg_buf_free(
+                na_class, multi_recv_op->buf, multi_recv_op->plugin_data);
+            multi_recv_op->buf = buf;
+            multi_recv_op->buf_size = buf_size;
+            multi_recv_op->plugin_data = plugin_data;
+        }
+    }
+
+    HG_LOG_SUBSYS_DEBUG(
+        ctx, "Reposting multi-recv buffer %u", multi_recv_op->id);
+
+    /* Repost multi recv */
+    ret = hg_core_post_multi(multi_recv_op, na_class, na_context);
+    HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
+        "Cannot repost multi-recv operation (%u)", multi_recv_op->id);
+    hg_atomic_incr32(&context->multi_recv_op_count);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_multi_recv_held_add(struct hg_core_private_context *context, int64_t size)
+{
+    int64_t held_size;
+
+    do {
+        held_size = hg_atomic_get64(&context->multi_recv_held_size);
+    } while (!hg_atomic_cas64(
+        &context->multi_recv_held_size, held_size, held_size + size));
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_multi_recv_msg_size_update(
+    struct hg_core_private_context *context, size_t size)
+{
+    size_t msg_size = (size_t) hg_atomic_get64(&context->multi_recv_msg_size);
+
+    /* Approximate, concurrent updates may be lost */
+    hg_atomic_set64(&context->multi_recv_msg_size,
+        (int64_t) hg_core_multi_recv_msg_size_avg(msg_size, size));
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE bool
+hg_core_multi_recv_copy_needed(struct hg_core_private_context *context)
+{
+    const struct hg_core_init_info *init_info =
+        &HG_CORE_CONTEXT_CLASS(context)->init_info;
+
+    /* Copy once consumed buffers that are still held pin too much memory */
+    if (init_info->multi_recv_copy_watermark > 0)
+        return (size_t) hg_atomic_get64(&context->multi_recv_held_size) >
+               init_info->multi_recv_copy_watermark;
+
+    return init_info->multi_recv_copy_threshold > 0 &&
+           (unsigned int) hg_atomic_get32(&context->multi_recv_op_count) <=
+               init_info->multi_recv_copy_threshold;
+}
+
+/*---------------------------------------------------------------------------*/
+static void *
+hg_core_multi_recv_pack_copy(struct hg_core_private_context *context,
+    const void *buf, size_t size, struct hg_core_multi_recv_pack **pack_p)
+{
+    struct hg_core_multi_recv_pack *pack;
+    void *copy_buf;
+
+    hg_thread_spin_lock(&context->multi_recv_pack_lock);
+    pack = context->multi_recv_pack;
+    copy_buf = (pack != NULL) ? hg_core_multi_recv_pack_get(pack, size) : NULL;
+    if (copy_buf == NULL) {
+        /* Current buffer is full, it is freed once its payloads are released */
+        size_t msg_size =
+            (size_t) hg_atomic_get64(&context->multi_recv_msg_size);
+
+        pack = hg_core_multi_recv_pack_create(
+            MAX(HG_CORE_MULTI_RECV_PACK_COUNT * msg_size, size));
+        if (pack != NULL) {
+            if (context->multi_recv_pack != NULL)
+                hg_core_multi_recv_pack_release(context->multi_recv_pack);
+            context->multi_recv_pack = pack;
+            copy_buf = hg_core_multi_recv_pack_get(pack, size);
+        }
+    }
+    hg_thread_spin_unlock(&context->multi_recv_pack_lock);
+
+    if (copy_buf == NULL)
+        return NULL;
+
+    memcpy(copy_buf, buf, size);
+    *pack_p = pack;
+
+    return copy_buf;
+}
+
+/*---------------------------------------------------------------------------*/
+size_t
+hg_core_multi_recv_buf_size(
+    size_t request_count, size_t msg_size, size_t unexpected_msg_size)
+{
+    /* Room for request_count messages of average size, always leave room for
+     * a couple of max size messages but never exceed what would be needed if
+     * all messages were of max size */
+    return MIN(MAX(request_count * msg_size, 2 * unexpected_msg_size),
+        request_count * unexpected_msg_size);
+}
+
+/*---------------------------------------------------------------------------*/
+bool
+hg_core_multi_recv_buf_resize(size_t buf_size, size_t new_buf_size)
+{
+    return new_buf_size * HG_CORE_MULTI_RECV_RESIZE_FACTOR < buf_size ||
+           new_buf_size > buf_size * HG_CORE_MULTI_RECV_RESIZE_FACTOR;
+}
+
+/*---------------------------------------------------------------------------*/
+size_t
+hg_core_multi_recv_msg_size_avg(size_t msg_size_avg, size_t msg_size)
+{
+    return (size_t) ((int64_t) msg_size_avg +
+                     ((int64_t) msg_size - (int64_t) msg_size_avg) /
+                         HG_CORE_MULTI_RECV_MSG_SIZE_WEIGHT);
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_core_multi_recv_pack *
+hg_core_multi_recv_pack_create(size_t size)
+{
+    struct hg_core_multi_recv_pack *pack;
+
+    pack = (struct hg_core_multi_recv_pack *) malloc(sizeof(*pack));
+    HG_CHECK_SUBSYS_ERROR_NORET(
+        ctx, pack == NULL, error, "Could not allocate multi-recv pack");
+
+    pack->buf = (char *) malloc(size);
+    HG_CHECK_SUBSYS_ERROR_NORET(ctx, pack->buf == NULL, error_free,
+        "Could not allocate multi-recv pack buffer of size %zu", size);
+    pack->size = size;
+    pack->offset = 0;
+    hg_atomic_init32(&pack->ref_count, 1);
+
+    return pack;
+
+error_free:
+    free(pack);
+error:
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+void *
+hg_core_multi_recv_pack_get(struct hg_core_multi_recv_pack *pack, size_t size)
+{
+    void *buf;
+
+    if (size > pack->size - pack->offset)
+        return NULL;
+
+    buf = pack->buf + pack->offset;
+    pack->offset = MIN(HG_CORE_MULTI_RECV_PACK_ALIGN *
+                           ((pack->offset + size +
+                                HG_CORE_MULTI_RECV_PACK_ALIGN - 1) /
+                               HG_CORE_MULTI_RECV_PACK_ALIGN),
+        pack->size);
+    hg_atomic_incr32(&pack->ref_count);
+
+    return buf;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_core_multi_recv_pack_release(struct hg_core_multi_recv_pack *pack)
+{
+    if (hg_atomic_decr32(&pack->ref_count) > 0)
+        return;
+
+    free(pack->buf);
+    free(pack);
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_release_input(struct hg_core_private_handle *hg_core_handle)
@@ -3975,15 +5063,10 @@ hg_core_release_input(struct hg_core_private_handle *hg_core_handle)
 
         if (hg_atomic_decr32(&multi_recv_op->ref_count) == 0 &&
             hg_atomic_get32(&multi_recv_op->last)) {
-            HG_LOG_SUBSYS_DEBUG(
-                ctx, "Reposting multi-recv buffer %d", multi_recv_op->id);
-
-            /* Repost multi recv */
-            ret = hg_core_post_multi(multi_recv_op,
+            ret = hg_core_repost_multi(multi_recv_op,
                 hg_core_handle_pool->na_class, hg_core_handle_pool->na_context);
             HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret,
-                "Cannot repost multi-recv operation (%d)", multi_recv_op->id);
-            hg_atomic_incr32(&context->multi_recv_op_count);
+                "Could not repost multi-recv operation");
         }
     }
 
@@ -4056,15 +5139,29 @@ hg_core_forward(struct hg_core_private_handle *hg_core_handle,
         HG_CORE_HANDLE_CLASS(hg_core_handle)->counters.rpc_req_sent_count);
 #endif
 
+    /* Arm deadline and duplicate timers */
+    hg_core_timer_forward(hg_core_handle);
+
+    /* Queue forward locally if target addr has no credit left, it will be
+     * posted once a previous forward to that addr completes (forwards of a
+     * batch already hold their own credit) */
+    if (!(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_BATCH) &&
+        !hg_core_credit_acquire(hg_core_handle))
+        return HG_SUCCESS;
+
     /* If addr is self, forward locally, otherwise send the encoded buffer
      * through NA and pre-post response */
     ret = hg_core_handle->ops.forward(hg_core_handle);
+    if (ret != HG_SUCCESS && hg_core_handle->credit)
+        hg_core_credit_release(hg_core_handle);
     HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward buffer");
 
 done:
     return ret;
 
 error:
+    hg_core_timer_disarm(hg_core_handle);
+
     /* Handle is no longer in use */
     hg_atomic_set32(&hg_core_handle->status, HG_CORE_OP_COMPLETED);
 
@@ -4073,7 +5170,1481 @@ error:
     HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) ref_count decr to %" PRId32,
         (void *) hg_core_handle, ref_count);
 
-    return ret;
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_credit_acquire(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_credits *credits;
+    bool acquired;
+
+    if (HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.rpc_credit_max == 0 ||
+        (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_SELF_FORWARD))
+        return true;
+
+    credits = &((struct hg_core_private_addr *)
+                    hg_core_handle->core_handle.info.addr)
+                   ->credits;
+
+    /* Preserve ordering, do not overtake forwards that are already waiting */
+    hg_thread_spin_lock(&credits->lock);
+    if (STAILQ_EMPTY(&credits->queue) &&
+        credits->inflight < credits->window) {
+        credits->inflight++;
+        hg_core_handle->credit = true;
+        acquired = true;
+    } else {
+        /* Set operation type for trigger, forward may complete unposted */
+        hg_core_handle->op_type = HG_CORE_FORWARD;
+        hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_CREDIT_WAIT);
+        STAILQ_INSERT_TAIL(&credits->queue, hg_core_handle, waiting);
+        acquired = false;
+    }
+    hg_thread_spin_unlock(&credits->lock);
+
+    if (!acquired)
+        HG_LOG_SUBSYS_DEBUG(perf,
+            "No credit left on target addr, queuing forward of handle (%p)",
+            (void *) hg_core_handle);
+
+    return acquired;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_credit_release(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_credits *credits =
+        &((struct hg_core_private_addr *) hg_core_handle->core_handle.info.addr)
+             ->credits;
+
+    hg_core_handle->credit = false;
+
+    /* This is usually called from NA callbacks, forwards are therefore not
+     * posted from here but from the progress of the context of their handle.
+     * They remain marked as waiting for a credit until then so that they can
+     * still be canceled. */
+    hg_thread_spin_lock(&credits->lock);
+    credits->inflight--;
+    while (credits->inflight < credits->window &&
+           !STAILQ_EMPTY(&credits->queue)) {
+        struct hg_core_private_handle *next = STAILQ_FIRST(&credits->queue);
+        struct hg_core_private_context *context = HG_CORE_HANDLE_CONTEXT(next);
+
+        STAILQ_REMOVE_HEAD(&credits->queue, waiting);
+        credits->inflight++;
+        next->credit = true;
+
+        hg_thread_spin_lock(&context->credit_ready.lock);
+        STAILQ_INSERT_TAIL(&context->credit_ready.queue, next, waiting);
+        hg_atomic_incr32(&context->credit_ready.count);
+        hg_thread_spin_unlock(&context->credit_ready.lock);
+
+        HG_LOG_SUBSYS_DEBUG(rpc, "Queuing forward of handle (%p) for posting",
+            (void *) next);
+
+        /* Wake up context if it is waiting */
+        if ((context->loopback_notify.event > 0) &&
+            hg_atomic_get32(&context->loopback_notify.must_notify))
+            (void) hg_core_loopback_event_set(context);
+    }
+    hg_thread_spin_unlock(&credits->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_credit_process(struct hg_core_private_context *context)
+{
+    struct hg_core_credit_list *credit_ready = &context->credit_ready;
+
+    while (hg_atomic_get32(&credit_ready->count) > 0) {
+        struct hg_core_private_handle *hg_core_handle;
+        hg_return_t ret;
+
+        hg_thread_spin_lock(&credit_ready->lock);
+        hg_core_handle = STAILQ_FIRST(&credit_ready->queue);
+        if (hg_core_handle != NULL) {
+            STAILQ_REMOVE_HEAD(&credit_ready->queue, waiting);
+            hg_atomic_decr32(&credit_ready->count);
+            hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_CREDIT_WAIT);
+        }
+        hg_thread_spin_unlock(&credit_ready->lock);
+
+        if (hg_core_handle == NULL)
+            break;
+
+        HG_LOG_SUBSYS_DEBUG(rpc, "Posting queued forward of handle (%p)",
+            (void *) hg_core_handle);
+
+        /* Submission already succeeded for the caller, report errors through
+         * the forward callback, completion releases the credit */
+        ret = hg_core_handle->ops.forward(hg_core_handle);
+        if (ret != HG_SUCCESS) {
+            HG_LOG_SUBSYS_ERROR(rpc,
+                "Could not forward buffer of queued handle (%p)",
+                (void *) hg_core_handle);
+            hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
+            hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) ret);
+            hg_core_complete_op(hg_core_handle);
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_credit_cancel(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_credits *credits =
+        &((struct hg_core_private_addr *) hg_core_handle->core_handle.info.addr)
+             ->credits;
+    bool removed = false;
+
+    hg_thread_spin_lock(&credits->lock);
+    if (!hg_core_handle->credit) {
+        /* Still waiting for a credit */
+        if (hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_CREDIT_WAIT) {
+            STAILQ_REMOVE(&credits->queue, hg_core_handle,
+                hg_core_private_handle, waiting);
+            hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_CREDIT_WAIT);
+            removed = true;
+        }
+    } else {
+        /* Credit was given, remove it unless it is already being posted */
+        struct hg_core_credit_list *credit_ready =
+            &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->credit_ready;
+
+        hg_thread_spin_lock(&credit_ready->lock);
+        if (hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_CREDIT_WAIT) {
+            STAILQ_REMOVE(&credit_ready->queue, hg_core_handle,
+                hg_core_private_handle, waiting);
+            hg_atomic_decr32(&credit_ready->count);
+            hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_CREDIT_WAIT);
+            removed = true;
+        }
+        hg_thread_spin_unlock(&credit_ready->lock);
+    }
+    hg_thread_spin_unlock(&credits->lock);
+
+    if (removed) {
+        /* Keep timeout status if deadline expired while waiting */
+        hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
+            (int32_t) HG_CANCELED);
+        hg_core_complete_op(hg_core_handle);
+    }
+
+    return removed;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_credit_update(
+    struct hg_core_private_handle *hg_core_handle, uint16_t credits_granted)
+{
+    uint32_t rpc_credit_max =
+        HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.rpc_credit_max;
+    struct hg_core_credits *credits;
+    int32_t window;
+
+    /* Target does not enforce any limit */
+    if (credits_granted == 0 || !hg_core_handle->credit)
+        return;
+
+    credits = &((struct hg_core_private_addr *)
+                    hg_core_handle->core_handle.info.addr)
+                   ->credits;
+    window = (int32_t) MIN((uint32_t) credits_granted, rpc_credit_max);
+
+    hg_thread_spin_lock(&credits->lock);
+    if (credits->window != window) {
+        HG_LOG_SUBSYS_DEBUG(
+            perf, "Credit window of target addr set to %" PRId32, window);
+        credits->window = window;
+    }
+    hg_thread_spin_unlock(&credits->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE uint16_t
+hg_core_credit_grant(struct hg_core_private_context *context)
+{
+    uint32_t rpc_active_max =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.rpc_active_max;
+    int32_t rpc_active_count;
+
+    if (rpc_active_max == 0)
+        return 0;
+
+    /* Always grant at least one credit so that origins make progress */
+    rpc_active_count = hg_atomic_get32(&context->rpc_active_count);
+    if (rpc_active_count < 0 || (uint32_t) rpc_active_count >= rpc_active_max)
+        return 1;
+
+    return (uint16_t) MIN(rpc_active_max - (uint32_t) rpc_active_count,
+        (uint32_t) UINT16_MAX);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE uint64_t
+hg_core_time_ms(void)
+{
+    hg_time_t now;
+
+    hg_time_get_current_ms(&now);
+
+    return (uint64_t) (hg_time_to_double(now) * 1000.0);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_timer_forward(struct hg_core_private_handle *hg_core_handle)
+{
+    int32_t flags = hg_atomic_get32(&hg_core_handle->flags);
+    uint64_t now, delay_ms, expire_ms = 0;
+
+    hg_core_handle->deadline_ms = 0;
+    hg_core_handle->hedge_ms = 0;
+    hg_atomic_set32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_NONE);
+
+    /* Local forwards cannot be canceled */
+    if ((hg_core_handle->timeout_ms == 0 &&
+            hg_core_handle->hedge_addr == NULL) ||
+        (flags & HG_CORE_SELF_FORWARD))
+        return;
+
+    now = hg_core_time_ms();
+    if (hg_core_handle->timeout_ms > 0) {
+        hg_core_handle->deadline_ms = now + hg_core_handle->timeout_ms;
+        expire_ms = hg_core_handle->deadline_ms;
+    }
+
+    /* Duplicates require a response and a self-contained input */
+    if (hg_core_handle->hedge_addr != NULL) {
+        hg_time_get_current(&hg_core_handle->forward_time);
+        if (!(flags & (HG_CORE_NO_RESPONSE | HG_CORE_MORE_DATA)) &&
+            hg_core_hedge_delay(
+                HG_CORE_HANDLE_CONTEXT(hg_core_handle), &delay_ms)) {
+            hg_core_handle->hedge_ms = now + delay_ms;
+            hg_atomic_set32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_ARMED);
+            if (expire_ms == 0 || hg_core_handle->hedge_ms < expire_ms)
+                expire_ms = hg_core_handle->hedge_ms;
+        } else /* Not enough samples yet, only record latency */
+            hg_atomic_set32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_DONE);
+    }
+
+    if (expire_ms > 0)
+        hg_core_timer_arm(hg_core_handle, expire_ms);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_timer_arm(
+    struct hg_core_private_handle *hg_core_handle, uint64_t expire_ms)
+{
+    struct hg_core_timer_wheel *timer_wheel =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->timer_wheel;
+    int64_t next_ms;
+
+    /* Handles that have completed must not be re-armed */
+    hg_thread_spin_lock(&timer_wheel->lock);
+    if (!hg_core_handle->timer_armed &&
+        !(hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_COMPLETED)) {
+        /* Timers that are already due go into the next slot processed */
+        uint64_t tick = MAX(expire_ms, timer_wheel->tick + 1);
+
+        hg_core_handle->timer_ms = expire_ms;
+        hg_core_handle->timer_armed = true;
+        LIST_INSERT_HEAD(
+            &timer_wheel->slots[tick % HG_CORE_TIMER_WHEEL_SIZE],
+            hg_core_handle, timer);
+        timer_wheel->count++;
+
+        next_ms = hg_atomic_get64(&timer_wheel->next_ms);
+        if (next_ms == 0 || expire_ms < (uint64_t) next_ms)
+            hg_atomic_set64(&timer_wheel->next_ms, (int64_t) expire_ms);
+    }
+    hg_thread_spin_unlock(&timer_wheel->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_timer_disarm(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_timer_wheel *timer_wheel =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->timer_wheel;
+
+    if (hg_core_handle->deadline_ms == 0 && hg_core_handle->hedge_ms == 0)
+        return;
+
+    /* Earliest expiration is left as is, it is refreshed on next expiry */
+    hg_thread_spin_lock(&timer_wheel->lock);
+    if (hg_core_handle->timer_armed) {
+        LIST_REMOVE(hg_core_handle, timer);
+        hg_core_handle->timer_armed = false;
+        timer_wheel->count--;
+    }
+    hg_thread_spin_unlock(&timer_wheel->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_timer_process(struct hg_core_private_context *context)
+{
+    struct hg_core_timer_wheel *timer_wheel = &context->timer_wheel;
+    LIST_HEAD(, hg_core_private_handle) expired;
+    struct hg_core_private_handle *hg_core_handle;
+    int64_t next_ms = hg_atomic_get64(&timer_wheel->next_ms);
+    uint64_t now, tick;
+    unsigned int i;
+
+    if (next_ms == 0)
+        return;
+    now = hg_core_time_ms();
+    if (now < (uint64_t) next_ms)
+        return;
+
+    LIST_INIT(&expired);
+
+    hg_thread_spin_lock(&timer_wheel->lock);
+    /* Only walk slots that elapsed since last tick, at most one full turn of
+     * the wheel, handles due in a later turn are left in their slot */
+    for (tick = timer_wheel->tick + 1, i = 0;
+         tick <= now && i < HG_CORE_TIMER_WHEEL_SIZE; tick++, i++) {
+        struct hg_core_private_handle *next;
+
+        hg_core_handle =
+            LIST_FIRST(&timer_wheel->slots[tick % HG_CORE_TIMER_WHEEL_SIZE]);
+        for (; hg_core_handle != NULL; hg_core_handle = next) {
+            next = LIST_NEXT(hg_core_handle, timer);
+            if (hg_core_handle->timer_ms > now)
+                continue;
+
+            LIST_REMOVE(hg_core_handle, timer);
+            hg_core_handle->timer_armed = false;
+            timer_wheel->count--;
+
+            /* Keep handle alive until timer has fired */
+            hg_atomic_incr32(&hg_core_handle->ref_count);
+            LIST_INSERT_HEAD(&expired, hg_core_handle, timer);
+        }
+    }
+    timer_wheel->tick = now;
+
+    /* Next expiration is that of the next slot that is not empty, handles
+     * are not visited (handles due in a later turn may wake us up early) */
+    next_ms = 0;
+    for (tick = now + 1, i = 0;
+         i < HG_CORE_TIMER_WHEEL_SIZE && timer_wheel->count > 0; tick++, i++)
+        if (!LIST_EMPTY(
+                &timer_wheel->slots[tick % HG_CORE_TIMER_WHEEL_SIZE])) {
+            next_ms = (int64_t) tick;
+            break;
+        }
+    hg_atomic_set64(&timer_wheel->next_ms, next_ms);
+    hg_thread_spin_unlock(&timer_wheel->lock);
+
+    while ((hg_core_handle = LIST_FIRST(&expired)) != NULL) {
+        LIST_REMOVE(hg_core_handle, timer);
+        hg_core_timer_fire(hg_core_handle, now);
+        (void) hg_core_destroy(hg_core_handle);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE unsigned int
+hg_core_timer_timeout(
+    struct hg_core_private_context *context, unsigned int timeout_ms)
+{
+    int64_t next_ms = hg_atomic_get64(&context->timer_wheel.next_ms),
+            flush_ms = hg_atomic_get64(&context->coalesce.next_ms);
+    uint64_t now;
+
+    /* Open batches must also be sent in time */
+    if (flush_ms != 0 && (next_ms == 0 || flush_ms < next_ms))
+        next_ms = flush_ms;
+
+    if (next_ms == 0 || timeout_ms == 0)
+        return timeout_ms;
+
+    now = hg_core_time_ms();
+
+    return ((uint64_t) next_ms <= now)
+               ? 0
+               : (unsigned int) MIN((uint64_t) next_ms - now, timeout_ms);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_timer_fire(struct hg_core_private_handle *hg_core_handle, uint64_t now)
+{
+    int32_t status = hg_atomic_get32(&hg_core_handle->status);
+
+    if (status & HG_CORE_OP_COMPLETED)
+        return;
+
+    if (hg_core_handle->hedge_ms != 0 && now >= hg_core_handle->hedge_ms) {
+        hg_core_handle->hedge_ms = 0;
+        if (hg_atomic_cas32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_ARMED,
+                HG_CORE_HEDGE_SENDING) &&
+            hg_core_hedge_send(hg_core_handle) != HG_SUCCESS)
+            hg_atomic_cas32(&hg_core_handle->hedge_state,
+                HG_CORE_HEDGE_SENDING, HG_CORE_HEDGE_DONE);
+    }
+
+    if (hg_core_handle->deadline_ms == 0)
+        return;
+
+    if (now >= hg_core_handle->deadline_ms) {
+        HG_LOG_SUBSYS_DEBUG(rpc, "Deadline of handle (%p) has expired",
+            (void *) hg_core_handle);
+
+        /* Report timeout rather than cancelation */
+        hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
+            (int32_t) HG_TIMEOUT);
+        (void) hg_core_cancel(hg_core_handle);
+    } else
+        hg_core_timer_arm(hg_core_handle, hg_core_handle->deadline_ms);
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_hedge_delay(
+    struct hg_core_private_context *context, uint64_t *delay_ms_p)
+{
+    uint32_t percentile =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.hedge_percentile;
+    int64_t counts[HG_CORE_LATENCY_BUCKETS], total = 0, sum = 0, threshold;
+    unsigned int i;
+
+    for (i = 0; i < HG_CORE_LATENCY_BUCKETS; i++) {
+        counts[i] = hg_atomic_get64(&context->latency_hist[i]);
+        total += counts[i];
+    }
+    if (total < HG_CORE_HEDGE_MIN_SAMPLES)
+        return false;
+
+    threshold = (total * (int64_t) percentile + 99) / 100;
+    for (i = 0; i < HG_CORE_LATENCY_BUCKETS - 1; i++) {
+        sum += counts[i];
+        if (sum >= threshold)
+            break;
+    }
+
+    /* Upper bound of bucket */
+    *delay_ms_p = MAX(((uint64_t) 1 << (i + 1)) / 1000, 1);
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_hedge_send(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_private_handle *hg_core_hedge = NULL;
+    na_class_t *na_class = NULL;
+    na_context_t *na_context = NULL;
+    na_addr_t *na_addr = NULL;
+    size_t header_size, hedge_header_size, payload_size;
+    hg_return_t ret;
+
+    HG_LOG_SUBSYS_DEBUG(rpc, "Sending duplicate of handle (%p)",
+        (void *) hg_core_handle);
+
+    ret = hg_core_resolve_na(
+        context, hg_core_handle->hedge_addr, &na_class, &na_context, &na_addr);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not resolve NA components");
+
+    ret = hg_core_create(context, na_class, na_context, 0, &hg_core_hedge);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not create HG core handle");
+
+    ret = hg_core_set_rpc(hg_core_hedge, hg_core_handle->hedge_addr, na_addr,
+        hg_core_handle->core_handle.info.id);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret,
+        "Could not set new RPC info to handle %p", (void *) hg_core_hedge);
+    hg_core_hedge->core_handle.info.context_id =
+        hg_core_handle->core_handle.info.context_id;
+
+    /* Copy encoded input, header is encoded again on forward */
+    header_size = hg_core_header_request_get_size() +
+                  hg_core_handle->core_handle.na_in_header_offset;
+    hedge_header_size = hg_core_header_request_get_size() +
+                        hg_core_hedge->core_handle.na_in_header_offset;
+    payload_size = hg_core_handle->core_handle.in_buf_used - header_size;
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        hedge_header_size + payload_size >
+            hg_core_hedge->core_handle.in_buf_size,
+        error, ret, HG_MSGSIZE, "Exceeding input buffer size");
+    memcpy((char *) hg_core_hedge->core_handle.in_buf + hedge_header_size,
+        (const char *) hg_core_handle->core_handle.in_buf + header_size,
+        payload_size);
+
+    /* Duplicate does not outlive original deadline */
+    if (hg_core_handle->deadline_ms > 0) {
+        uint64_t now = hg_core_time_ms();
+
+        hg_core_hedge->timeout_ms =
+            (hg_core_handle->deadline_ms > now)
+                ? (unsigned int) (hg_core_handle->deadline_ms - now)
+                : 1;
+    }
+
+    /* Duplicate keeps a reference to original until its callback */
+    hg_atomic_incr32(&hg_core_handle->ref_count);
+    hg_core_hedge->hedge_parent = hg_core_handle;
+    hg_core_handle->hedge = hg_core_hedge;
+
+    ret = hg_core_forward(hg_core_hedge, hg_core_hedge_cb, NULL, 0,
+        (hg_size_t) payload_size);
+    if (ret != HG_SUCCESS) {
+        hg_core_handle->hedge = NULL;
+        hg_core_hedge->hedge_parent = NULL;
+        hg_atomic_decr32(&hg_core_handle->ref_count);
+    }
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward duplicate");
+
+    /* Original may have completed in the meantime, in which case duplicate is
+     * not needed anymore */
+    if (!hg_atomic_cas32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_SENDING,
+            HG_CORE_HEDGE_SENT)) {
+        hg_core_handle->hedge = NULL;
+        (void) hg_core_cancel(hg_core_hedge);
+        (void) hg_core_destroy(hg_core_hedge);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    if (hg_core_hedge != NULL)
+        (void) hg_core_destroy(hg_core_hedge);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_hedge_cb(const struct hg_core_cb_info *callback_info)
+{
+    struct hg_core_private_handle *hg_core_hedge =
+        (struct hg_core_private_handle *) callback_info->info.forward.handle;
+    struct hg_core_private_handle *hg_core_handle = hg_core_hedge->hedge_parent;
+
+    if (hg_core_handle == NULL)
+        return HG_SUCCESS;
+    hg_core_hedge->hedge_parent = NULL;
+
+    /* First response wins, original is canceled and takes its output from
+     * the duplicate when it completes */
+    if (callback_info->ret == HG_SUCCESS &&
+        !(hg_atomic_get32(&hg_core_hedge->flags) & HG_CORE_MORE_DATA) &&
+        hg_core_handle->hedge == hg_core_hedge &&
+        hg_atomic_cas32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_SENT,
+            HG_CORE_HEDGE_WON)) {
+        HG_LOG_SUBSYS_DEBUG(rpc, "Duplicate of handle (%p) completed first",
+            (void *) hg_core_handle);
+        (void) hg_core_cancel(hg_core_handle);
+    }
+
+    (void) hg_core_destroy(hg_core_handle);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_hedge_complete(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_handle *hg_core_hedge = hg_core_handle->hedge;
+    bool adopted = false;
+
+    /* Duplicate is not sent past that point */
+    if (hg_atomic_cas32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_ARMED,
+            HG_CORE_HEDGE_DONE) ||
+        hg_atomic_cas32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_SENDING,
+            HG_CORE_HEDGE_DONE) ||
+        hg_core_hedge == NULL)
+        goto done;
+    hg_core_handle->hedge = NULL;
+
+    if (hg_atomic_cas32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_SENT,
+            HG_CORE_HEDGE_DONE)) {
+        /* Original completed first */
+        (void) hg_core_cancel(hg_core_hedge);
+    } else if (hg_core_handle->ret != HG_SUCCESS) {
+        size_t header_size = hg_core_header_response_get_size() +
+                             hg_core_handle->core_handle.na_out_header_offset,
+               hedge_header_size =
+                   hg_core_header_response_get_size() +
+                   hg_core_hedge->core_handle.na_out_header_offset,
+               payload_size =
+                   hg_core_hedge->core_handle.out_buf_used - hedge_header_size;
+
+        /* Take output from duplicate, recv of original is no longer posted */
+        if (header_size + payload_size <=
+            hg_core_handle->core_handle.out_buf_size) {
+            memcpy((char *) hg_core_handle->core_handle.out_buf + header_size,
+                (const char *) hg_core_hedge->core_handle.out_buf +
+                    hedge_header_size,
+                payload_size);
+            hg_core_handle->core_handle.out_buf_used =
+                header_size + payload_size;
+            hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_MORE_DATA);
+            hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS);
+            hg_core_handle->ret = HG_SUCCESS;
+            adopted = true;
+        } else
+            HG_LOG_SUBSYS_ERROR(rpc,
+                "Output of duplicate (%zu) exceeds output buffer size",
+                payload_size);
+    }
+    hg_atomic_set32(&hg_core_handle->hedge_state, HG_CORE_HEDGE_DONE);
+
+    (void) hg_core_destroy(hg_core_hedge);
+
+done:
+    /* Only sample latencies of targets that answered by themselves */
+    if (hg_core_handle->hedge_addr != NULL &&
+        hg_core_handle->ret == HG_SUCCESS && !adopted)
+        hg_core_latency_record(hg_core_handle);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_latency_record(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    hg_time_t now;
+    uint64_t latency_us;
+    unsigned int i = 0;
+
+    hg_time_get_current(&now);
+    latency_us = (uint64_t) (hg_time_diff(now, hg_core_handle->forward_time) *
+                             1000000.0);
+    while (i < HG_CORE_LATENCY_BUCKETS - 1 && (latency_us >> (i + 1)) > 0)
+        i++;
+    hg_atomic_incr64(&context->latency_hist[i]);
+
+    /* Halve samples so that histogram follows latency changes */
+    if (hg_atomic_incr64(&context->latency_count) >=
+        HG_CORE_HEDGE_MAX_SAMPLES) {
+        hg_atomic_set64(&context->latency_count, HG_CORE_HEDGE_MAX_SAMPLES / 2);
+        for (i = 0; i < HG_CORE_LATENCY_BUCKETS; i++)
+            hg_atomic_set64(&context->latency_hist[i],
+                hg_atomic_get64(&context->latency_hist[i]) / 2);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE bool
+hg_core_coalesce_eligible(struct hg_core_private_handle *hg_core_handle)
+{
+    uint32_t rpc_coalesce_size =
+        HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.rpc_coalesce_size;
+
+    /* Forwards that have a deadline or a duplicate must leave immediately */
+    return rpc_coalesce_size > 0 &&
+           !(hg_atomic_get32(&hg_core_handle->flags) &
+               (HG_CORE_MORE_DATA | HG_CORE_BATCH)) &&
+           hg_core_handle->deadline_ms == 0 &&
+           hg_core_handle->hedge_addr == NULL &&
+           hg_core_handle->hedge_parent == NULL &&
+           hg_core_handle->core_handle.in_buf_used -
+                   hg_core_handle->core_handle.na_in_header_offset <=
+               rpc_coalesce_size;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_coalesce_add(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_batch_list *batch_list = &context->coalesce;
+    struct hg_core_private_addr *hg_core_addr =
+        (struct hg_core_private_addr *) hg_core_handle->core_handle.info.addr;
+    uint8_t context_id = hg_core_handle->core_handle.info.context_id;
+    /* Batch is sent from an input buffer of the same size */
+    size_t capacity = hg_core_handle->core_handle.in_buf_size -
+                      hg_core_handle->core_handle.na_in_header_offset -
+                      hg_core_header_request_get_size();
+    size_t size = hg_core_header_batch_get_size() +
+                  hg_core_handle->core_handle.in_buf_used -
+                  hg_core_handle->core_handle.na_in_header_offset;
+    struct hg_core_batch *hg_core_batch, *hg_core_batch_full = NULL,
+                                         *hg_core_batch_ready = NULL,
+                                         *hg_core_batch_new = NULL;
+    bool opened = false;
+
+retry:
+    hg_thread_spin_lock(&batch_list->lock);
+    LIST_FOREACH (hg_core_batch, &batch_list->list, entry)
+        if (hg_core_batch->addr == hg_core_addr &&
+            hg_core_batch->context_id == context_id)
+            break;
+
+    /* Send current batch first if request does not fit into it */
+    if (hg_core_batch != NULL && hg_core_batch->size + size > capacity) {
+        hg_core_coalesce_detach(batch_list, hg_core_batch);
+        hg_core_batch_full = hg_core_batch;
+        hg_core_batch = NULL;
+    }
+
+    if (hg_core_batch == NULL) {
+        int64_t next_ms = hg_atomic_get64(&batch_list->next_ms);
+
+        /* Allocate outside of lock and look for an open batch again */
+        if (hg_core_batch_new == NULL) {
+            hg_thread_spin_unlock(&batch_list->lock);
+            hg_core_batch_new =
+                (struct hg_core_batch *) malloc(sizeof(*hg_core_batch_new));
+            HG_CHECK_SUBSYS_ERROR_NORET(rpc, hg_core_batch_new == NULL, error,
+                "Could not allocate batch");
+            goto retry;
+        }
+        hg_core_batch = hg_core_batch_new;
+        hg_core_batch_new = NULL;
+        hg_atomic_incr32(&hg_core_addr->ref_count);
+        hg_core_batch->addr = hg_core_addr;
+        hg_core_batch->flush_ms =
+            hg_core_time_ms() +
+            HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.rpc_coalesce_ms;
+        hg_core_batch->size = 0;
+        hg_core_batch->count = 0;
+        hg_core_batch->context_id = context_id;
+        LIST_INSERT_HEAD(&batch_list->list, hg_core_batch, entry);
+        if (next_ms == 0 || hg_core_batch->flush_ms < (uint64_t) next_ms)
+            hg_atomic_set64(
+                &batch_list->next_ms, (int64_t) hg_core_batch->flush_ms);
+        opened = true;
+    }
+
+    hg_core_batch->handles[hg_core_batch->count++] = hg_core_handle;
+    hg_core_batch->size += size;
+    hg_core_handle->batch = hg_core_batch;
+    hg_atomic_or32(
+        &hg_core_handle->status, HG_CORE_OP_POSTED | HG_CORE_OP_COALESCED);
+
+    if (hg_core_batch->count == HG_CORE_COALESCE_MAX) {
+        hg_core_coalesce_detach(batch_list, hg_core_batch);
+        hg_core_batch_ready = hg_core_batch;
+    }
+    hg_thread_spin_unlock(&batch_list->lock);
+
+    /* Another forward opened a batch in the meantime */
+    free(hg_core_batch_new);
+
+    if (hg_core_batch_full != NULL)
+        hg_core_coalesce_flush(hg_core_batch_full);
+
+    if (hg_core_batch_ready != NULL)
+        hg_core_coalesce_flush(hg_core_batch_ready);
+    else if (opened && (context->loopback_notify.event > 0) &&
+             hg_atomic_get32(&context->loopback_notify.must_notify))
+        /* Wake up progress so that it waits no longer than batch window */
+        (void) hg_core_loopback_event_set(context);
+
+    return HG_SUCCESS;
+
+error:
+    if (hg_core_batch_full != NULL)
+        hg_core_coalesce_flush(hg_core_batch_full);
+
+    return HG_NOMEM;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_coalesce_detach(
+    struct hg_core_batch_list *batch_list, struct hg_core_batch *hg_core_batch)
+{
+    unsigned int i;
+
+    (void) batch_list;
+    LIST_REMOVE(hg_core_batch, entry);
+
+    /* Forwards can no longer be removed from batch */
+    for (i = 0; i < hg_core_batch->count; i++)
+        hg_core_batch->handles[i]->batch = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_coalesce_flush(struct hg_core_batch *hg_core_batch)
+{
+    struct hg_core_private_handle *hg_core_handle = hg_core_batch->handles[0],
+                                  *hg_core_batch_handle = NULL;
+    size_t header_size;
+    char *buf_ptr;
+    size_t buf_size_left;
+    unsigned int count = 0, i;
+    hg_return_t ret;
+
+    /* Nothing to gain from a batch of one */
+    if (hg_core_batch->count == 1) {
+        hg_core_addr_free(hg_core_batch->addr);
+        free(hg_core_batch);
+
+        if (hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_CANCELED) {
+            hg_core_coalesce_complete(hg_core_handle, HG_CANCELED);
+            return;
+        }
+        hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_COALESCED);
+
+        ret = hg_core_forward_na_post(hg_core_handle);
+        if (ret != HG_SUCCESS)
+            hg_core_coalesce_complete(hg_core_handle, ret);
+        return;
+    }
+
+    /* Responses are not batched, each forward receives its own response so
+     * that a slow request does not hold back the other responses. Recvs are
+     * therefore pre-posted before the batch is sent. */
+    for (i = 0; i < hg_core_batch->count; i++) {
+        struct hg_core_private_handle *hg_core_entry =
+            hg_core_batch->handles[i];
+        bool no_response = hg_atomic_get32(&hg_core_entry->flags) &
+                           HG_CORE_NO_RESPONSE;
+
+        if (!no_response) {
+            ret = hg_core_forward_na_recv(hg_core_entry);
+            if (ret != HG_SUCCESS) {
+                hg_core_coalesce_complete(hg_core_entry, ret);
+                continue;
+            }
+            if (HG_CORE_HANDLE_CLASS(hg_core_entry)
+                    ->init_info.rpc_coalesce_responses)
+                hg_atomic_or32(
+                    &hg_core_entry->status, HG_CORE_OP_BATCH_REPLY);
+        }
+
+        /* Forward may have been canceled while batch was being sent, its
+         * recv may not have been posted at the time */
+        if (hg_atomic_get32(&hg_core_entry->status) & HG_CORE_OP_CANCELED) {
+            hg_core_coalesce_abort(hg_core_entry, HG_CANCELED);
+            continue;
+        }
+
+        hg_core_batch->handles[count++] = hg_core_entry;
+    }
+    hg_core_batch->count = count;
+    if (count == 0) {
+        hg_core_addr_free(hg_core_batch->addr);
+        free(hg_core_batch);
+        return;
+    }
+
+    HG_LOG_SUBSYS_DEBUG(perf, "Sending batch of %u forwards (%zu bytes)",
+        hg_core_batch->count, hg_core_batch->size);
+
+    ret = hg_core_create(HG_CORE_HANDLE_CONTEXT(hg_core_handle),
+        hg_core_handle->na_class, hg_core_handle->na_context, 0,
+        &hg_core_batch_handle);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not create batch handle");
+
+    /* Reference to target addr moves to batch handle */
+    hg_core_batch_handle->core_handle.info.addr =
+        (hg_core_addr_t) hg_core_batch->addr;
+    hg_core_batch->addr = NULL;
+    hg_core_batch_handle->na_addr = hg_core_handle->na_addr;
+    hg_core_batch_handle->core_handle.info.context_id =
+        hg_core_batch->context_id;
+    hg_atomic_or32(
+        &hg_core_batch_handle->flags, HG_CORE_BATCH | HG_CORE_NO_RESPONSE);
+    if (HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.rpc_coalesce_responses)
+        hg_atomic_or32(&hg_core_batch_handle->flags, HG_CORE_BATCH_REPLY);
+
+    /* Pack forwards (request header and payload) after batch header */
+    header_size = hg_core_header_request_get_size() +
+                  hg_core_batch_handle->core_handle.na_in_header_offset;
+    buf_ptr = (char *) hg_core_batch_handle->core_handle.in_buf + header_size;
+    buf_size_left =
+        hg_core_batch_handle->core_handle.in_buf_size - header_size;
+    for (i = 0; i < hg_core_batch->count; i++) {
+        struct hg_core_private_handle *hg_core_entry =
+            hg_core_batch->handles[i];
+        size_t size = hg_core_entry->core_handle.in_buf_used -
+                      hg_core_entry->core_handle.na_in_header_offset;
+        struct hg_core_header_batch batch_header = {
+            .tag = (uint32_t) hg_core_entry->tag, .size = (uint16_t) size};
+
+        ret = hg_core_header_batch_proc(
+            HG_ENCODE, buf_ptr, buf_size_left, &batch_header);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not encode header");
+        buf_ptr += hg_core_header_batch_get_size();
+        buf_size_left -= hg_core_header_batch_get_size();
+
+        HG_CHECK_SUBSYS_ERROR(rpc, batch_header.size > buf_size_left, error,
+            ret, HG_OVERFLOW, "Exceeding input buffer size");
+        memcpy(buf_ptr,
+            (const char *) hg_core_entry->core_handle.in_buf +
+                hg_core_entry->core_handle.na_in_header_offset,
+            batch_header.size);
+        buf_ptr += batch_header.size;
+        buf_size_left -= batch_header.size;
+    }
+
+    hg_core_batch_handle->batch = hg_core_batch;
+    ret = hg_core_forward(hg_core_batch_handle, hg_core_coalesce_cb, NULL, 0,
+        (hg_size_t) (hg_core_batch_handle->core_handle.in_buf_size -
+                     header_size - buf_size_left));
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward batch");
+
+    /* Batch handle is freed once it completes */
+    (void) hg_core_destroy(hg_core_batch_handle);
+
+    return;
+
+error:
+    if (hg_core_batch_handle != NULL) {
+        hg_core_batch_handle->batch = NULL;
+        (void) hg_core_destroy(hg_core_batch_handle);
+    }
+    for (i = 0; i < hg_core_batch->count; i++)
+        hg_core_coalesce_abort(hg_core_batch->handles[i], ret);
+    hg_core_addr_free(hg_core_batch->addr);
+    free(hg_core_batch);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_coalesce_process(struct hg_core_private_context *context, bool all)
+{
+    struct hg_core_batch_list *batch_list = &context->coalesce;
+    LIST_HEAD(, hg_core_batch) ready_list = LIST_HEAD_INITIALIZER(ready_list);
+    struct hg_core_batch *hg_core_batch;
+    int64_t next_ms = hg_atomic_get64(&batch_list->next_ms);
+    uint64_t now;
+
+    if (next_ms == 0)
+        return;
+
+    now = hg_core_time_ms();
+    if (!all && now < (uint64_t) next_ms)
+        return;
+
+    hg_thread_spin_lock(&batch_list->lock);
+    next_ms = 0;
+    hg_core_batch = LIST_FIRST(&batch_list->list);
+    while (hg_core_batch != NULL) {
+        struct hg_core_batch *next = LIST_NEXT(hg_core_batch, entry);
+
+        if (all || hg_core_batch->flush_ms <= now) {
+            hg_core_coalesce_detach(batch_list, hg_core_batch);
+            LIST_INSERT_HEAD(&ready_list, hg_core_batch, entry);
+        } else if (next_ms == 0 || hg_core_batch->flush_ms < (uint64_t) next_ms)
+            next_ms = (int64_t) hg_core_batch->flush_ms;
+        hg_core_batch = next;
+    }
+    hg_atomic_set64(&batch_list->next_ms, next_ms);
+    hg_thread_spin_unlock(&batch_list->lock);
+
+    while ((hg_core_batch = LIST_FIRST(&ready_list)) != NULL) {
+        LIST_REMOVE(hg_core_batch, entry);
+        hg_core_coalesce_flush(hg_core_batch);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_coalesce_cb(const struct hg_core_cb_info *callback_info)
+{
+    struct hg_core_private_handle *hg_core_batch_handle =
+        (struct hg_core_private_handle *) callback_info->info.forward.handle;
+    struct hg_core_batch *hg_core_batch = hg_core_batch_handle->batch;
+    unsigned int i;
+
+    hg_core_batch_handle->batch = NULL;
+
+    /* Batch was sent, forwards now only wait for their own response */
+    for (i = 0; i < hg_core_batch->count; i++)
+        hg_core_coalesce_abort(hg_core_batch->handles[i], callback_info->ret);
+    free(hg_core_batch);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_coalesce_complete(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret)
+{
+    int32_t status =
+        hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_COALESCED);
+
+    if (ret != HG_SUCCESS) {
+        /* Canceled forwards report cancelation over any other error */
+        if (status & HG_CORE_OP_CANCELED)
+            ret = HG_CANCELED;
+        else
+            hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
+
+        /* Keep first non-success ret status */
+        hg_atomic_cas32(
+            &hg_core_handle->ret_status, (int32_t) HG_SUCCESS, (int32_t) ret);
+    }
+
+    hg_core_complete_op(hg_core_handle);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_coalesce_abort(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret)
+{
+    /* Response can no longer be expected if batch was not sent */
+    if (ret != HG_SUCCESS &&
+        !(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE))
+        (void) NA_Cancel(hg_core_handle->na_class, hg_core_handle->na_context,
+            hg_core_handle->na_recv_op_id);
+
+    hg_core_coalesce_complete(hg_core_handle, ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_core_coalesce_cancel(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_batch_list *batch_list =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->coalesce;
+    struct hg_core_batch *hg_core_batch, *hg_core_batch_empty = NULL;
+    bool removed = false;
+
+    hg_thread_spin_lock(&batch_list->lock);
+    hg_core_batch = hg_core_handle->batch;
+    if (hg_core_batch != NULL) {
+        unsigned int i = 0;
+
+        while (hg_core_batch->handles[i] != hg_core_handle)
+            i++;
+        memmove(&hg_core_batch->handles[i], &hg_core_batch->handles[i + 1],
+            (hg_core_batch->count - i - 1) * sizeof(hg_core_batch->handles[0]));
+        hg_core_batch->count--;
+        hg_core_batch->size -= hg_core_header_batch_get_size() +
+                               hg_core_handle->core_handle.in_buf_used -
+                               hg_core_handle->core_handle.na_in_header_offset;
+        hg_core_handle->batch = NULL;
+        if (hg_core_batch->count == 0) {
+            LIST_REMOVE(hg_core_batch, entry);
+            hg_core_batch_empty = hg_core_batch;
+        }
+        removed = true;
+    }
+    hg_thread_spin_unlock(&batch_list->lock);
+
+    if (hg_core_batch_empty != NULL) {
+        hg_core_addr_free(hg_core_batch_empty->addr);
+        free(hg_core_batch_empty);
+    }
+
+    if (removed)
+        hg_core_coalesce_complete(hg_core_handle, HG_CANCELED);
+
+    return removed;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_batch_process(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    size_t header_size = hg_core_header_request_get_size() +
+                         hg_core_handle->core_handle.na_in_header_offset;
+    struct hg_core_header_batch batch_header;
+    char *buf_ptr;
+    size_t buf_size_left;
+    hg_return_t ret;
+
+    HG_LOG_SUBSYS_DEBUG(
+        rpc, "Processing batch for handle %p", (void *) hg_core_handle);
+
+    /* Each request is processed, and responds, independently of the other
+     * requests of the batch */
+    buf_ptr = (char *) hg_core_handle->core_handle.in_buf + header_size;
+    buf_size_left = hg_core_handle->core_handle.in_buf_used - header_size;
+    HG_CHECK_SUBSYS_ERROR(rpc, buf_size_left == 0, error, ret,
+        HG_PROTOCOL_ERROR, "Empty batch request");
+    while (buf_size_left > 0) {
+        struct hg_core_private_handle *hg_core_entry = NULL;
+
+        ret = hg_core_header_batch_proc(
+            HG_DECODE, buf_ptr, buf_size_left, &batch_header);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not decode batch header");
+        buf_ptr += hg_core_header_batch_get_size();
+        buf_size_left -= hg_core_header_batch_get_size();
+
+        HG_CHECK_SUBSYS_ERROR(rpc, batch_header.size > buf_size_left, error,
+            ret, HG_PROTOCOL_ERROR, "Invalid batch request");
+
+        /* Requests are processed in place, from input buffer of batch */
+        ret = hg_core_create(context, hg_core_handle->na_class,
+            hg_core_handle->na_context, HG_CORE_HANDLE_MULTI_RECV,
+            &hg_core_entry);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not create handle for request");
+        hg_atomic_incr32(&((struct hg_core_private_addr *)
+                               hg_core_handle->core_handle.info.addr)
+                              ->ref_count);
+        hg_core_entry->core_handle.info.addr =
+            hg_core_handle->core_handle.info.addr;
+        hg_core_entry->na_addr = hg_core_handle->na_addr;
+        hg_core_entry->tag = (na_tag_t) batch_header.tag;
+        hg_core_entry->core_handle.in_buf =
+            buf_ptr - hg_core_entry->core_handle.na_in_header_offset;
+        hg_core_entry->core_handle.in_buf_size =
+            hg_core_entry->core_handle.na_in_header_offset + batch_header.size;
+        hg_core_entry->core_handle.in_buf_used =
+            hg_core_entry->core_handle.in_buf_size;
+
+        /* Batch handle is kept until the request is done with it */
+        hg_atomic_incr32(&hg_core_handle->ref_count);
+        hg_core_entry->batch_parent = hg_core_handle;
+        hg_atomic_set32(&hg_core_entry->status, 0);
+
+        ret = hg_core_process_input(hg_core_entry);
+        if (ret != HG_SUCCESS) {
+            HG_LOG_SUBSYS_ERROR(rpc, "Could not process input");
+            hg_atomic_or32(&hg_core_entry->status, HG_CORE_OP_ERRORED);
+            hg_atomic_set32(&hg_core_entry->ret_status, (int32_t) ret);
+        }
+        hg_core_complete_op(hg_core_entry);
+
+        buf_ptr += batch_header.size;
+        buf_size_left -= batch_header.size;
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE bool
+hg_core_reply_eligible(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_handle *hg_core_batch_handle =
+        hg_core_handle->batch_parent;
+
+    /* Responses that require an ack are sent on their own */
+    return hg_core_batch_handle != NULL &&
+           (hg_atomic_get32(&hg_core_batch_handle->flags) &
+               HG_CORE_BATCH_REPLY) &&
+           !(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_MORE_DATA);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_reply_add(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+
+    hg_thread_spin_lock(&context->reply_ready.lock);
+    STAILQ_INSERT_TAIL(&context->reply_ready.queue, hg_core_handle, replying);
+    hg_atomic_incr32(&context->reply_ready.count);
+    hg_thread_spin_unlock(&context->reply_ready.lock);
+
+    /* Wake up context if response was not made from its progress loop */
+    if ((context->loopback_notify.event > 0) &&
+        hg_atomic_get32(&context->loopback_notify.must_notify))
+        (void) hg_core_loopback_event_set(context);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_reply_process(struct hg_core_private_context *context)
+{
+    STAILQ_HEAD(, hg_core_private_handle)
+    queue = STAILQ_HEAD_INITIALIZER(queue);
+    struct hg_core_private_handle *hg_core_handle;
+
+    if (hg_atomic_get32(&context->reply_ready.count) == 0)
+        return;
+
+    /* Responses that are ready by now are sent together */
+    hg_thread_spin_lock(&context->reply_ready.lock);
+    STAILQ_CONCAT(&queue, &context->reply_ready.queue);
+    hg_atomic_set32(&context->reply_ready.count, 0);
+    hg_thread_spin_unlock(&context->reply_ready.lock);
+
+    while ((hg_core_handle = STAILQ_FIRST(&queue)) != NULL) {
+        struct hg_core_private_handle *entries[HG_CORE_COALESCE_MAX],
+            *hg_core_entry;
+        unsigned int count = 0;
+
+        STAILQ_REMOVE_HEAD(&queue, replying);
+
+        /* Gather the other responses to requests of the same batch */
+        hg_core_entry = STAILQ_FIRST(&queue);
+        while (hg_core_entry != NULL && count < HG_CORE_COALESCE_MAX - 1) {
+            struct hg_core_private_handle *next =
+                STAILQ_NEXT(hg_core_entry, replying);
+
+            if (hg_core_entry->batch_parent == hg_core_handle->batch_parent) {
+                STAILQ_REMOVE(
+                    &queue, hg_core_entry, hg_core_private_handle, replying);
+                entries[count++] = hg_core_entry;
+            }
+            hg_core_entry = next;
+        }
+
+        hg_core_reply_send(hg_core_handle, entries, count);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_reply_send(struct hg_core_private_handle *hg_core_handle,
+    struct hg_core_private_handle **entries, unsigned int count)
+{
+    size_t header_offset = hg_core_handle->core_handle.na_out_header_offset,
+           header_size = hg_core_header_response_get_size() + header_offset,
+           entry_header_size = hg_core_header_batch_get_size(),
+           size = hg_core_handle->core_handle.out_buf_used - header_offset,
+           buf_size = header_size + entry_header_size + size;
+    struct hg_core_header_batch batch_header;
+    unsigned int packed = 0, i;
+    char *buf_ptr;
+    hg_return_t ret;
+    na_return_t na_ret;
+
+    /* Responses that do not fit into the message are sent on their own */
+    for (i = 0; i < count; i++) {
+        struct hg_core_private_handle *hg_core_entry = entries[i];
+        size_t entry_size = hg_core_entry->core_handle.out_buf_used -
+                            hg_core_entry->core_handle.na_out_header_offset;
+
+        if (size <= UINT16_MAX && entry_size <= UINT16_MAX &&
+            buf_size + entry_header_size + entry_size <=
+                hg_core_handle->core_handle.out_buf_size) {
+            buf_size += entry_header_size + entry_size;
+            entries[packed++] = hg_core_entry;
+        } else
+            hg_core_reply_post(hg_core_entry);
+    }
+    if (packed == 0) {
+        hg_core_reply_post(hg_core_handle);
+        return;
+    }
+
+    HG_LOG_SUBSYS_DEBUG(perf,
+        "Sending %u responses of batch together (%zu bytes)", packed + 1,
+        buf_size);
+
+    /* Own response becomes the first entry after the batch response header,
+     * responses are packed in their encoded form (header and payload) */
+    buf_ptr = (char *) hg_core_handle->core_handle.out_buf + header_size;
+    memmove(buf_ptr + entry_header_size,
+        (char *) hg_core_handle->core_handle.out_buf + header_offset, size);
+    batch_header = (struct hg_core_header_batch){
+        .tag = (uint32_t) hg_core_handle->tag, .size = (uint16_t) size};
+    ret = hg_core_header_batch_proc(
+        HG_ENCODE, buf_ptr, entry_header_size, &batch_header);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not encode batch header");
+    buf_ptr += entry_header_size + size;
+
+    for (i = 0; i < packed; i++) {
+        struct hg_core_private_handle *hg_core_entry = entries[i];
+        size_t entry_size = hg_core_entry->core_handle.out_buf_used -
+                            hg_core_entry->core_handle.na_out_header_offset;
+
+        batch_header =
+            (struct hg_core_header_batch){.tag = (uint32_t) hg_core_entry->tag,
+                .size = (uint16_t) entry_size};
+        ret = hg_core_header_batch_proc(
+            HG_ENCODE, buf_ptr, entry_header_size, &batch_header);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not encode batch header");
+        buf_ptr += entry_header_size;
+        memcpy(buf_ptr,
+            (const char *) hg_core_entry->core_handle.out_buf +
+                hg_core_entry->core_handle.na_out_header_offset,
+            entry_size);
+        buf_ptr += entry_size;
+    }
+    hg_core_handle->core_handle.out_buf_used = buf_size;
+
+    /* Batch response header only tells origin to unpack responses, each
+     * response carries its own return code and credits */
+    hg_core_handle->out_header.msg.response = (struct hg_core_header_response){
+        .ret_code = (int8_t) HG_SUCCESS,
+        .flags = (uint8_t) HG_CORE_BATCH,
+        .cookie = hg_core_handle->cookie,
+        .retry_ms = 0,
+        .credits = 0,
+        .pad = 0};
+    ret = hg_core_proc_header_response(
+        &hg_core_handle->core_handle, &hg_core_handle->out_header, HG_ENCODE);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not encode header");
+
+    na_ret = NA_Msg_send_expected(hg_core_handle->na_class,
+        hg_core_handle->na_context, hg_core_send_output_cb, hg_core_handle,
+        hg_core_handle->core_handle.out_buf,
+        hg_core_handle->core_handle.out_buf_used,
+        hg_core_handle->out_buf_plugin_data, hg_core_handle->na_addr,
+        hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
+        hg_core_handle->na_send_op_id);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not post send for output buffer (%s)",
+        NA_Error_to_string(na_ret));
+
+    /* Packed responses were copied and are therefore already sent */
+    for (i = 0; i < packed; i++)
+        hg_core_reply_complete(entries[i], HG_SUCCESS);
+
+    return;
+
+error:
+    hg_core_reply_complete(hg_core_handle, ret);
+    for (i = 0; i < packed; i++)
+        hg_core_reply_complete(entries[i], ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_reply_post(struct hg_core_private_handle *hg_core_handle)
+{
+    na_return_t na_ret;
+
+    na_ret = NA_Msg_send_expected(hg_core_handle->na_class,
+        hg_core_handle->na_context, hg_core_send_output_cb, hg_core_handle,
+        hg_core_handle->core_handle.out_buf,
+        hg_core_handle->core_handle.out_buf_used,
+        hg_core_handle->out_buf_plugin_data, hg_core_handle->na_addr,
+        hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
+        hg_core_handle->na_send_op_id);
+    if (na_ret != NA_SUCCESS) {
+        HG_LOG_SUBSYS_ERROR(rpc, "Could not post send for output buffer (%s)",
+            NA_Error_to_string(na_ret));
+        hg_core_reply_complete(hg_core_handle, (hg_return_t) na_ret);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_reply_complete(
+    struct hg_core_private_handle *hg_core_handle, hg_return_t ret)
+{
+    /* Respond already succeeded for the caller, report errors through the
+     * response callback */
+    if (ret != HG_SUCCESS) {
+        hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
+        hg_atomic_cas32(
+            &hg_core_handle->ret_status, (int32_t) HG_SUCCESS, (int32_t) ret);
+    }
+
+    hg_core_complete_op(hg_core_handle);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_reply_unpack(struct hg_core_private_handle *hg_core_handle)
+{
+    size_t header_offset = hg_core_handle->core_handle.na_out_header_offset,
+           header_size = hg_core_header_response_get_size() + header_offset;
+    struct hg_core_header_batch batch_header;
+    const char *own_buf = NULL;
+    size_t own_size = 0, buf_size_left;
+    char *buf_ptr;
+    hg_return_t ret;
+
+    ret = hg_core_proc_header_response(
+        &hg_core_handle->core_handle, &hg_core_handle->out_header, HG_DECODE);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not decode header");
+
+    /* Response was sent on its own */
+    if (!(hg_core_handle->out_header.msg.response.flags & HG_CORE_BATCH))
+        return HG_SUCCESS;
+
+    buf_ptr = (char *) hg_core_handle->core_handle.out_buf + header_size;
+    buf_size_left = hg_core_handle->core_handle.out_buf_used - header_size;
+    while (buf_size_left > 0) {
+        ret = hg_core_header_batch_proc(
+            HG_DECODE, buf_ptr, buf_size_left, &batch_header);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not decode batch header");
+        buf_ptr += hg_core_header_batch_get_size();
+        buf_size_left -= hg_core_header_batch_get_size();
+
+        HG_CHECK_SUBSYS_ERROR(rpc, batch_header.size > buf_size_left, error,
+            ret, HG_PROTOCOL_ERROR, "Invalid batch response");
+
+        if ((na_tag_t) batch_header.tag == hg_core_handle->tag) {
+            own_buf = buf_ptr;
+            own_size = batch_header.size;
+        } else
+            hg_core_reply_deliver(
+                hg_core_handle, batch_header.tag, buf_ptr, batch_header.size);
+
+        buf_ptr += batch_header.size;
+        buf_size_left -= batch_header.size;
+    }
+    HG_CHECK_SUBSYS_ERROR(rpc, own_buf == NULL, error, ret, HG_PROTOCOL_ERROR,
+        "No response for handle %p in batch response", (void *) hg_core_handle);
+
+    /* Own response is moved in place once the others were passed on */
+    memmove((char *) hg_core_handle->core_handle.out_buf + header_offset,
+        own_buf, own_size);
+    hg_core_handle->core_handle.out_buf_used = header_offset + own_size;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_reply_deliver(struct hg_core_private_handle *hg_core_handle,
+    na_tag_t tag, const void *buf, size_t buf_size)
+{
+    struct hg_core_handle_list *created_list = hg_core_handle->created_list;
+    struct hg_core_private_handle *hg_core_entry;
+
+    /* Forwards of a batch were all created on the same context and sent to
+     * the same addr. Lookup is linear in the number of handles created on
+     * that context, which is only paid by forwards that asked for their
+     * responses to be coalesced. The recv of the forward is then canceled,
+     * its callback picks up the response. */
+    hg_thread_spin_lock(&created_list->lock);
+    LIST_FOREACH (hg_core_entry, &created_list->list, created) {
+        int32_t status = hg_atomic_get32(&hg_core_entry->status);
+
+        if (hg_core_entry->tag != tag ||
+            hg_core_entry->na_addr != hg_core_handle->na_addr ||
+            !(status & HG_CORE_OP_BATCH_REPLY) || (status & HG_CORE_OP_REPLIED))
+            continue;
+
+        if (hg_core_entry->core_handle.na_out_header_offset + buf_size >
+            hg_core_entry->core_handle.out_buf_size) {
+            HG_LOG_SUBSYS_ERROR(rpc,
+                "Response of %zu bytes exceeds output buffer of handle %p",
+                buf_size, (void *) hg_core_entry);
+            (void) NA_Cancel(hg_core_entry->na_class,
+                hg_core_entry->na_context, hg_core_entry->na_recv_op_id);
+            break;
+        }
+        memcpy((char *) hg_core_entry->core_handle.out_buf +
+                   hg_core_entry->core_handle.na_out_header_offset,
+            buf, buf_size);
+        hg_core_entry->core_handle.out_buf_used =
+            hg_core_entry->core_handle.na_out_header_offset + buf_size;
+        hg_atomic_or32(&hg_core_entry->status, HG_CORE_OP_REPLIED);
+        (void) NA_Cancel(hg_core_entry->na_class, hg_core_entry->na_context,
+            hg_core_entry->na_recv_op_id);
+        break;
+    }
+    hg_thread_spin_unlock(&created_list->lock);
+
+    HG_CHECK_SUBSYS_WARNING(rpc, hg_core_entry == NULL,
+        "No forward with tag %u waiting for a response, dropping it", tag);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4112,7 +6683,6 @@ static hg_return_t
 hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
 {
     hg_return_t ret;
-    na_return_t na_ret;
 
     /* Set operation type for trigger */
     hg_core_handle->op_type = HG_CORE_FORWARD;
@@ -4127,6 +6697,16 @@ hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
      * layer knows which context ID it needs to send the response to. */
     hg_core_handle->in_header.msg.request.cookie =
         hg_core_handle->core_handle.info.context->id;
+    /* Pass remaining time so that target can drop expired requests */
+    if (hg_core_handle->deadline_ms > 0) {
+        uint64_t now = hg_core_time_ms();
+
+        hg_core_handle->in_header.msg.request.timeout_ms =
+            (hg_core_handle->deadline_ms > now)
+                ? (uint32_t) (hg_core_handle->deadline_ms - now)
+                : 1;
+    } else
+        hg_core_handle->in_header.msg.request.timeout_ms = 0;
 
     /* Encode request header */
     ret = hg_core_proc_header_request(
@@ -4137,26 +6717,28 @@ hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
     hg_core_handle->tag =
         hg_core_gen_request_tag(HG_CORE_HANDLE_CLASS(hg_core_handle));
 
-    /* Pre-post recv (output) if response is expected */
-    if (!(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE)) {
-        int32_t HG_DEBUG_LOG_USED expected_count;
+    /* Small requests are packed with other requests to the same target */
+    if (hg_core_coalesce_eligible(hg_core_handle))
+        return hg_core_coalesce_add(hg_core_handle);
 
-        na_ret = NA_Msg_recv_expected(hg_core_handle->na_class,
-            hg_core_handle->na_context, hg_core_recv_output_cb, hg_core_handle,
-            hg_core_handle->core_handle.out_buf,
-            hg_core_handle->core_handle.out_buf_size,
-            hg_core_handle->out_buf_plugin_data, hg_core_handle->na_addr,
-            hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
-            hg_core_handle->na_recv_op_id);
-        HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not post recv for output buffer (%s)",
-            NA_Error_to_string(na_ret));
+    return hg_core_forward_na_post(hg_core_handle);
 
-        /* Increment number of expected completions */
-        expected_count = hg_atomic_incr32(&hg_core_handle->op_expected_count);
-        HG_LOG_SUBSYS_DEBUG(rpc_ref,
-            "Handle (%p) expected_count incr to %" PRId32,
-            (void *) hg_core_handle, expected_count);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_forward_na_post(struct hg_core_private_handle *hg_core_handle)
+{
+    hg_return_t ret;
+    na_return_t na_ret;
+
+    /* Pre-post recv (output) if response is expected */
+    if (!(hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE)) {
+        ret = hg_core_forward_na_recv(hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not post recv for output buffer");
     }
 
     /* Mark handle as posted */
@@ -4210,6 +6792,36 @@ error_send:
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_forward_na_recv(struct hg_core_private_handle *hg_core_handle)
+{
+    int32_t HG_DEBUG_LOG_USED expected_count;
+    hg_return_t ret;
+    na_return_t na_ret;
+
+    na_ret = NA_Msg_recv_expected(hg_core_handle->na_class,
+        hg_core_handle->na_context, hg_core_recv_output_cb, hg_core_handle,
+        hg_core_handle->core_handle.out_buf,
+        hg_core_handle->core_handle.out_buf_size,
+        hg_core_handle->out_buf_plugin_data, hg_core_handle->na_addr,
+        hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
+        hg_core_handle->na_recv_op_id);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not post recv for output buffer (%s)",
+        NA_Error_to_string(na_ret));
+
+    /* Increment number of expected completions */
+    expected_count = hg_atomic_incr32(&hg_core_handle->op_expected_count);
+    HG_LOG_SUBSYS_DEBUG(rpc_ref, "Handle (%p) expected_count incr to %" PRId32,
+        (void *) hg_core_handle, expected_count);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_respond(struct hg_core_private_handle *hg_core_handle,
@@ -4340,6 +6952,12 @@ hg_core_respond_na(
     hg_core_handle->out_header.msg.response.flags =
         (uint8_t) (hg_atomic_get32(&hg_core_handle->flags) & 0xff);
     hg_core_handle->out_header.msg.response.cookie = hg_core_handle->cookie;
+    hg_core_handle->out_header.msg.response.retry_ms =
+        (ret_code == HG_BUSY)
+            ? HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.busy_retry_ms
+            : 0;
+    hg_core_handle->out_header.msg.response.credits =
+        hg_core_credit_grant(HG_CORE_HANDLE_CONTEXT(hg_core_handle));
 
     /* Encode response header */
     ret = hg_core_proc_header_response(
@@ -4399,6 +7017,12 @@ hg_core_respond_na(
     /* Mark handle as posted */
     hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_POSTED);
 
+    /* Response may be sent along with other responses to the same batch */
+    if (hg_core_reply_eligible(hg_core_handle)) {
+        hg_core_reply_add(hg_core_handle);
+        return HG_SUCCESS;
+    }
+
     /* Post expected send (output) */
     na_ret = NA_Msg_send_expected(hg_core_handle->na_class,
         hg_core_handle->na_context, hg_core_send_output_cb, hg_core_handle,
@@ -4528,9 +7152,11 @@ hg_core_recv_input_cb(const struct na_cb_info *callback_info)
 #endif
 
     if (callback_info->ret == NA_SUCCESS) {
-        /* Extend pool if all handles are being utilized */
+        /* Extend pool if all handles are being utilized, unless we are
+         * already at capacity and new requests would only be turned away */
         if (hg_core_handle_pool->incr_count > 0 &&
             !hg_atomic_get32(&context->unposting) &&
+            !hg_core_context_overloaded(context) &&
             hg_core_handle_pool_empty(hg_core_handle_pool)) {
             HG_LOG_SUBSYS_WARNING(perf,
                 "Pre-posted handles have all been consumed / are being "
@@ -4639,15 +7265,17 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
         hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_MULTI_RECV);
         /* Prevent from reposting multi-recv buffer until done with handle */
         hg_atomic_incr32(&multi_recv_op->ref_count);
-        hg_core_handle->multi_recv_copy =
-            (unsigned int) hg_atomic_get32(&context->multi_recv_op_count) <=
-            HG_CORE_CONTEXT_CLASS(context)->init_info.multi_recv_copy_threshold;
+        hg_core_multi_recv_msg_size_update(
+            context, na_cb_info_multi_recv_unexpected->actual_buf_size);
 
         if (na_cb_info_multi_recv_unexpected->last) {
             HG_LOG_SUBSYS_DEBUG(rpc,
                 "Multi-recv buffer %d has been consumed (%" PRId32
                 " operations completed)",
                 multi_recv_op->id, hg_atomic_get32(&multi_recv_op->op_count));
+            /* Buffer is held until all handles release it */
+            hg_core_multi_recv_held_add(
+                context, (int64_t) multi_recv_op->buf_size);
             hg_atomic_set32(&multi_recv_op->last, true);
             if (hg_atomic_decr32(&context->multi_recv_op_count) == 0) {
                 unsigned int multi_recv_op_max =
@@ -4664,6 +7292,9 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
             }
         }
 
+        hg_core_handle->multi_recv_copy =
+            hg_core_multi_recv_copy_needed(context);
+
         /* Fill unexpected info */
         hg_core_handle->na_addr = na_cb_info_multi_recv_unexpected->source;
         hg_core_handle->core_handle.info.addr->na_addr =
@@ -4675,12 +7306,8 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
         /* Either copy the buffer to release early or point to the actual
          * multi-recv buffer space to save a memcpy */
         if (hg_core_handle->multi_recv_copy) {
-            HG_CHECK_SUBSYS_ERROR(rpc,
-                hg_core_handle->core_handle.in_buf_used >
-                    hg_core_handle->in_buf_storage_size,
-                error, ret, HG_OVERFLOW,
-                "Actual transfer size (%zu) is too large for unexpected recv",
-                hg_core_handle->core_handle.in_buf_used);
+            void *copy_buf;
+
             HG_LOG_SUBSYS_DEBUG(rpc,
                 "Copying multi-recv payload of size %zu for handle (%p)",
                 hg_core_handle->core_handle.in_buf_used,
@@ -4691,12 +7318,18 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
                                  ->counters.rpc_multi_recv_copy_count);
 #endif
 
-            memcpy(hg_core_handle->in_buf_storage,
+            /* Payloads are packed back to back so that copies only take
+             * the space that they need */
+            copy_buf = hg_core_multi_recv_pack_copy(context,
                 na_cb_info_multi_recv_unexpected->actual_buf,
+                hg_core_handle->core_handle.in_buf_used,
+                &hg_core_handle->multi_recv_pack);
+            HG_CHECK_SUBSYS_ERROR(rpc, copy_buf == NULL, error, ret, HG_NOMEM,
+                "Could not copy multi-recv payload of size %zu",
                 hg_core_handle->core_handle.in_buf_used);
             hg_core_handle->core_handle.in_buf_size =
-                hg_core_handle->in_buf_storage_size;
-            hg_core_handle->core_handle.in_buf = hg_core_handle->in_buf_storage;
+                hg_core_handle->core_handle.in_buf_used;
+            hg_core_handle->core_handle.in_buf = copy_buf;
 
             ret = hg_core_release_input(hg_core_handle);
             HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret,
@@ -4750,6 +7383,77 @@ error:
     hg_core_complete_op(hg_core_handle);
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE bool
+hg_core_context_overloaded(struct hg_core_private_context *context)
+{
+    uint32_t rpc_active_max =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.rpc_active_max;
+
+    return rpc_active_max > 0 &&
+           (uint32_t) hg_atomic_get32(&context->rpc_active_count) >=
+               rpc_active_max;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE bool
+hg_core_admit(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    uint32_t rpc_active_max =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.rpc_active_max;
+
+    if (rpc_active_max == 0)
+        return true;
+
+    if ((uint32_t) hg_atomic_incr32(&context->rpc_active_count) >
+        rpc_active_max) {
+        hg_atomic_decr32(&context->rpc_active_count);
+        return false;
+    }
+    hg_core_handle->admitted = true;
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_reject(struct hg_core_private_handle *hg_core_handle)
+{
+    hg_return_t ret;
+
+    HG_LOG_SUBSYS_DEBUG(perf,
+        "Context is at capacity (%" PRIu32
+        " active RPCs), rejecting handle %p, ID=%" PRIu64,
+        HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.rpc_active_max,
+        (void *) hg_core_handle, hg_core_handle->core_handle.info.id);
+
+    /* Nobody to tell, drop request and let handle be reposted on trigger */
+    if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_NO_RESPONSE) {
+        hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) HG_BUSY);
+        return HG_SUCCESS;
+    }
+
+    /* Extra input data is never acquired */
+    hg_atomic_and32(&hg_core_handle->flags, ~HG_CORE_MORE_DATA);
+
+    /* Send header only, the completion of the send is combined with the
+     * completion of the recv so that the handle goes through the completion
+     * queue only once, as a respond operation, and skips the RPC callback */
+    hg_core_handle->core_handle.out_buf_used =
+        hg_core_header_response_get_size() +
+        hg_core_handle->core_handle.na_out_header_offset;
+
+    ret = hg_core_handle->ops.respond(hg_core_handle, HG_BUSY);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not send busy response");
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
@@ -4781,6 +7485,21 @@ hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
         /* Parse flags */
         hg_atomic_set32(&hg_core_handle->flags,
             hg_core_handle->in_header.msg.request.flags);
+
+        /* Origin gives up after that point, no need to run it past that */
+        hg_core_handle->deadline_ms =
+            (hg_core_handle->in_header.msg.request.timeout_ms > 0)
+                ? hg_core_time_ms() +
+                      hg_core_handle->in_header.msg.request.timeout_ms
+                : 0;
+
+        /* Requests packed together are unpacked into handles of their own */
+        if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_BATCH)
+            return hg_core_batch_process(hg_core_handle);
+
+        /* Turn request away before decoding anything else if over capacity */
+        if (!hg_core_admit(hg_core_handle))
+            return hg_core_reject(hg_core_handle);
     }
 
     HG_LOG_SUBSYS_DEBUG(rpc,
@@ -4866,8 +7585,18 @@ hg_core_recv_output_cb(const struct na_cb_info *callback_info)
 {
     struct hg_core_private_handle *hg_core_handle =
         (struct hg_core_private_handle *) callback_info->arg;
+    int32_t status = hg_atomic_get32(&hg_core_handle->status);
     hg_return_t ret;
 
+    /* Response can no longer be delivered along with another response once
+     * the recv has completed */
+    if (status & HG_CORE_OP_BATCH_REPLY) {
+        hg_thread_spin_lock(&hg_core_handle->created_list->lock);
+        status = hg_atomic_and32(&hg_core_handle->status,
+            ~(HG_CORE_OP_BATCH_REPLY | HG_CORE_OP_REPLIED));
+        hg_thread_spin_unlock(&hg_core_handle->created_list->lock);
+    }
+
     if (callback_info->ret == NA_SUCCESS) {
         hg_core_handle->core_handle.out_buf_used =
             callback_info->info.recv_expected.actual_buf_size;
@@ -4883,10 +7612,24 @@ hg_core_recv_output_cb(const struct na_cb_info *callback_info)
             (void *) hg_core_handle, hg_core_handle->tag,
             hg_core_handle->core_handle.out_buf_used);
 
+        /* Responses to other forwards of the batch may have come along */
+        if (status & HG_CORE_OP_BATCH_REPLY) {
+            ret = hg_core_reply_unpack(hg_core_handle);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not unpack responses");
+        }
+
         /* Process output information */
         ret = hg_core_process_output(hg_core_handle, hg_core_send_ack);
         HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process output");
 
+    } else if (callback_info->ret == NA_CANCELED &&
+               (status & HG_CORE_OP_REPLIED) &&
+               !(status & HG_CORE_OP_CANCELED)) {
+        /* Recv was canceled because the response came with another one */
+        ret = hg_core_process_output(hg_core_handle, hg_core_send_ack);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process output");
+
     } else if (callback_info->ret == NA_CANCELED) {
         HG_CHECK_SUBSYS_WARNING(rpc,
             hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_COMPLETED,
@@ -4939,6 +7682,12 @@ hg_core_process_output(struct hg_core_private_handle *hg_core_handle,
         /* Get return code from header */
         hg_atomic_set32(&hg_core_handle->ret_status,
             (int32_t) hg_core_handle->out_header.msg.response.ret_code);
+        hg_core_handle->retry_ms =
+            hg_core_handle->out_header.msg.response.retry_ms;
+
+        /* Adjust window to the credits granted by target */
+        hg_core_credit_update(
+            hg_core_handle, hg_core_handle->out_header.msg.response.credits);
 
         /* Parse flags */
         hg_atomic_set32(&hg_core_handle->flags,
@@ -5178,6 +7927,12 @@ hg_core_complete(struct hg_core_private_handle *hg_core_handle, hg_return_t ret)
     /* Forward status to callback */
     hg_core_handle->ret = ret;
 
+    /* Let next forward to that target go */
+    if (hg_core_handle->credit)
+        hg_core_credit_release(hg_core_handle);
+
+    hg_core_timer_disarm(hg_core_handle);
+
     hg_core_handle->hg_completion_entry.op_type = HG_RPC;
     hg_core_handle->hg_completion_entry.op_id.hg_core_handle =
         (hg_core_handle_t) hg_core_handle;
@@ -5240,6 +7995,7 @@ hg_core_completion_add(struct hg_core_context *core_context,
     struct hg_core_private_context *context =
         (struct hg_core_private_context *) core_context;
     struct hg_core_completion_queue *backfill_queue = &context->backfill_queue;
+    struct hg_atomic_queue *completion_queue = context->completion_queue;
     int rc;
 
 #if defined(HG_HAS_DEBUG) && !defined(_WIN32)
@@ -5248,7 +8004,18 @@ hg_core_completion_add(struct hg_core_context *core_context,
         hg_atomic_incr64(HG_CORE_CONTEXT_CLASS(context)->counters.bulk_count);
 #endif
 
-    rc = hg_atomic_queue_push(context->completion_queue, hg_completion_entry);
+    /* Only RPCs can have a priority */
+    if (hg_completion_entry->op_type == HG_RPC) {
+        const struct hg_core_rpc_info *hg_core_rpc_info =
+            hg_completion_entry->op_id.hg_core_handle->rpc_info;
+
+        if (hg_core_rpc_info != NULL &&
+            hg_core_rpc_info->priority == HG_PRIORITY_HIGH)
+            completion_queue = context->priority_queue;
+    }
+
+    /* NB. backfill queue is shared by all priorities */
+    rc = hg_atomic_queue_push(completion_queue, hg_completion_entry);
     if (rc != HG_UTIL_SUCCESS) {
         HG_LOG_SUBSYS_WARNING(perf, "Atomic completion queue is full, pushing "
                                     "completion data to backfill queue");
@@ -5279,6 +8046,17 @@ hg_core_completion_get(struct hg_core_private_context *context)
 {
     struct hg_completion_entry *hg_completion_entry = NULL;
 
+    /* Favor high priority entries but let default priority entries through
+     * every HG_CORE_PRIORITY_WEIGHT entries to prevent starvation */
+    if (hg_atomic_get32(&context->priority_count) < HG_CORE_PRIORITY_WEIGHT) {
+        hg_completion_entry = hg_atomic_queue_pop_mc(context->priority_queue);
+        if (hg_completion_entry != NULL) {
+            hg_atomic_incr32(&context->priority_count);
+            return hg_completion_entry;
+        }
+    }
+    hg_atomic_set32(&context->priority_count, 0);
+
     hg_completion_entry = hg_atomic_queue_pop_mc(context->completion_queue);
     if (hg_completion_entry == NULL) { /* Check backfill queue */
         struct hg_core_completion_queue *backfill_queue =
@@ -5295,6 +8073,10 @@ hg_core_completion_get(struct hg_core_private_context *context)
         }
     }
 
+    /* Nothing else pending, check high priority entries again */
+    if (hg_completion_entry == NULL)
+        hg_completion_entry = hg_atomic_queue_pop_mc(context->priority_queue);
+
     return hg_completion_entry;
 }
 
@@ -5321,6 +8103,7 @@ static HG_INLINE unsigned int
 hg_core_completion_count(const struct hg_core_private_context *context)
 {
     return hg_atomic_queue_count(context->completion_queue) +
+           hg_atomic_queue_count(context->priority_queue) +
            (unsigned int) hg_atomic_get32(&context->backfill_queue.count);
 }
 
@@ -5381,6 +8164,13 @@ hg_core_progress_wait(
         bool safe_wait = false, progressed = false;
         unsigned int poll_timeout = 0;
 
+        /* Expire deadlines, send duplicates and batches that are due,
+         * forwards that were given a credit and queued responses */
+        hg_core_timer_process(context);
+        hg_core_coalesce_process(context, false);
+        hg_core_credit_process(context);
+        hg_core_reply_process(context);
+
         /* Bypass notifications if timeout_ms is 0 to prevent system calls */
         if (timeout_ms == 0) {
             ; // nothing to do
@@ -5395,6 +8185,9 @@ hg_core_progress_wait(
             poll_timeout = hg_time_to_ms(hg_time_subtract(deadline, now));
         }
 
+        /* Do not block past next timer expiration or batch flush */
+        poll_timeout = hg_core_timer_timeout(context, poll_timeout);
+
         /* Only enter blocking wait if it is safe to */
         if (safe_wait) {
             ret = hg_core_poll_wait(context, poll_timeout, &progressed);
@@ -5448,10 +8241,17 @@ hg_core_poll_wait(struct hg_core_private_context *context,
 
     /* Process events */
     for (i = 0; i < nevents; i++) {
+        uint32_t type = poll_events[i].data.u32, rail = 0;
         bool progressed_event = false;
         unsigned int count = 0;
 
-        switch (poll_events[i].data.u32) {
+        /* Rail events are offset by rail index */
+        if (type >= (uint32_t) HG_CORE_POLL_RAIL) {
+            rail = type - (uint32_t) HG_CORE_POLL_RAIL;
+            type = (uint32_t) HG_CORE_POLL_RAIL;
+        }
+
+        switch (type) {
             case HG_CORE_POLL_LOOPBACK:
                 HG_LOG_SUBSYS_DEBUG(poll_loop, "HG_CORE_POLL_LOOPBACK event");
                 ret = hg_core_loopback_event_get(context, &progressed_event);
@@ -5478,6 +8278,17 @@ hg_core_poll_wait(struct hg_core_private_context *context,
                 HG_CHECK_SUBSYS_HG_ERROR(
                     poll, error, ret, "hg_core_progress_na() failed");
                 break;
+            case HG_CORE_POLL_RAIL:
+                HG_LOG_SUBSYS_DEBUG(
+                    poll_loop, "HG_CORE_POLL_RAIL event (rail %" PRIu32 ")",
+                    rail);
+
+                ret = hg_core_progress_na(
+                    HG_CORE_CONTEXT_CLASS(context)->rails.rails[rail].na_class,
+                    context->na_rail_contexts[rail], &count);
+                HG_CHECK_SUBSYS_HG_ERROR(
+                    poll, error, ret, "hg_core_progress_na() failed");
+                break;
             default:
                 HG_GOTO_SUBSYS_ERROR(poll, error, ret, HG_INVALID_ARG,
                     "Invalid type of poll event (%d)",
@@ -5501,6 +8312,7 @@ hg_core_progress(struct hg_core_private_context *context, unsigned int *count_p)
     struct hg_core_private_class *hg_core_class =
         HG_CORE_CONTEXT_CLASS(context);
     hg_return_t ret;
+    unsigned int i;
 
     /* Read loopback events if any */
     if (context->loopback_notify.event > 0) {
@@ -5524,6 +8336,14 @@ hg_core_progress(struct hg_core_private_context *context, unsigned int *count_p)
     }
 #endif
 
+    /* Read NA rail events */
+    for (i = 0; i < hg_core_class->rails.count; i++) {
+        ret = hg_core_progress_na(hg_core_class->rails.rails[i].na_class,
+            context->na_rail_contexts[i], NULL);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            poll, error, ret, "hg_core_progress_na() failed");
+    }
+
     /* Read NA events */
     ret = hg_core_progress_na(hg_core_class->core_class.na_class,
         context->core_context.na_context, NULL);
@@ -5546,7 +8366,7 @@ hg_core_progress_legacy(struct hg_core_private_context *context,
     struct hg_core_private_class *hg_core_class =
         HG_CORE_CONTEXT_CLASS(context);
     bool progressed = false;
-    unsigned int count = 0;
+    unsigned int count = 0, i;
     unsigned int timeout;
     hg_return_t ret;
 
@@ -5568,6 +8388,18 @@ hg_core_progress_legacy(struct hg_core_private_context *context,
     }
 #endif
 
+    /* Poll over rails, NA can then no longer be waited on */
+    for (i = 0; i < hg_core_class->rails.count; i++) {
+        ret = hg_core_progress_na(hg_core_class->rails.rails[i].na_class,
+            context->na_rail_contexts[i], &count);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            poll, error, ret, "hg_core_progress_na() failed");
+
+        progressed |= (count > 0);
+        count = 0;
+        timeout = 0;
+    }
+
     /* Poll over defaut NA */
     if (timeout == 0) {
         ret = hg_core_progress_na(hg_core_class->core_class.na_class,
@@ -5844,6 +8676,10 @@ hg_core_trigger_process(struct hg_core_private_handle *hg_core_handle)
     hg_return_t ret;
     int32_t flags;
 
+    /* Batch has no RPC of its own, its requests were already dispatched */
+    if (hg_atomic_get32(&hg_core_handle->flags) & HG_CORE_BATCH)
+        return;
+
     /* Silently exit if error occurred */
     if (hg_core_handle->ret != HG_SUCCESS)
         return;
@@ -5859,8 +8695,15 @@ hg_core_trigger_process(struct hg_core_private_handle *hg_core_handle)
             (void *) hg_core_handle, ref_count);
     }
 
-    /* Run RPC callback */
-    ret = hg_core_process(hg_core_handle);
+    /* Run RPC callback unless origin has already given up on that request,
+     * in which case it only gets an error response */
+    if (hg_core_handle->deadline_ms > 0 &&
+        hg_core_time_ms() >= hg_core_handle->deadline_ms) {
+        HG_LOG_SUBSYS_DEBUG(rpc, "Request of handle %p has expired",
+            (void *) hg_core_handle);
+        ret = HG_TIMEOUT;
+    } else
+        ret = hg_core_process(hg_core_handle);
     if (ret != HG_SUCCESS && !(flags & HG_CORE_NO_RESPONSE)) {
         hg_size_t header_size =
             hg_core_header_response_get_size() +
@@ -5875,6 +8718,10 @@ hg_core_trigger_process(struct hg_core_private_handle *hg_core_handle)
 static HG_INLINE void
 hg_core_trigger_forward_cb(struct hg_core_private_handle *hg_core_handle)
 {
+    /* Resolve race with duplicate before reporting completion */
+    if (hg_atomic_get32(&hg_core_handle->hedge_state) != HG_CORE_HEDGE_NONE)
+        hg_core_hedge_complete(hg_core_handle);
+
     if (hg_core_handle->request_callback) {
         struct hg_core_cb_info hg_core_cb_info = {
             .arg = hg_core_handle->request_arg,
@@ -5965,6 +8812,17 @@ hg_core_cancel(struct hg_core_private_handle *hg_core_handle)
         HG_CORE_OP_CANCELED)
         return HG_SUCCESS;
 
+    /* Forward was never posted if it is still waiting for a credit */
+    if ((status & HG_CORE_OP_CREDIT_WAIT) &&
+        hg_core_credit_cancel(hg_core_handle))
+        return HG_SUCCESS;
+
+    /* Coalesced forward is removed from its open batch if it was not sent
+     * yet, otherwise only its response recv is canceled */
+    if ((status & HG_CORE_OP_COALESCED) &&
+        hg_core_coalesce_cancel(hg_core_handle))
+        return HG_SUCCESS;
+
     /* Cancel all NA operations issued */
     if (hg_core_handle->na_recv_op_id != NULL) {
         na_return_t na_ret = NA_Cancel(hg_core_handle->na_class,
@@ -6486,6 +9344,61 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_registered_set_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t priority)
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(cls,
+        priority != HG_PRIORITY_DEFAULT && priority != HG_PRIORITY_HIGH, error,
+        ret, HG_INVALID_ARG, "Invalid priority (%d)", (int) priority);
+
+    hg_core_rpc_info = hg_core_map_lookup(&private_class->rpc_map, &id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+
+    hg_core_rpc_info->priority = (uint8_t) priority;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_registered_get_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t *priority_p)
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(cls, priority_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to priority");
+
+    hg_core_rpc_info = hg_core_map_lookup(&private_class->rpc_map, &id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+
+    *priority_p = (hg_priority_t) hg_core_rpc_info->priority;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_addr_lookup1(hg_core_context_t *context, hg_core_cb_t callback,
@@ -7033,6 +9946,69 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_get_retry_after(hg_core_handle_t handle, unsigned int *retry_ms_p)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_CORE_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core handle");
+    HG_CHECK_SUBSYS_ERROR(rpc, retry_ms_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to retry-after hint");
+
+    *retry_ms_p = ((struct hg_core_private_handle *) handle)->retry_ms;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_set_timeout(hg_core_handle_t handle, unsigned int timeout_ms)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_CORE_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core handle");
+
+    ((struct hg_core_private_handle *) handle)->timeout_ms = timeout_ms;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_set_hedge(hg_core_handle_t handle, hg_core_addr_t addr)
+{
+    struct hg_core_private_handle *hg_core_handle =
+        (struct hg_core_private_handle *) handle;
+    struct hg_core_private_addr *hg_core_addr =
+        (struct hg_core_private_addr *) addr;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_CORE_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core handle");
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        hg_core_addr != NULL && hg_core_addr->core_addr.is_self, error, ret,
+        HG_INVALID_ARG, "Cannot send duplicate requests to self");
+
+    if (hg_core_addr != NULL)
+        hg_atomic_incr32(&hg_core_addr->ref_count);
+    hg_core_addr_free(hg_core_handle->hedge_addr);
+    hg_core_handle->hedge_addr = hg_core_addr;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 #ifdef HG_HAS_MULTI_PROGRESS
 hg_return_t
@@ -7183,6 +10159,8 @@ HG_Core_event_ready(hg_core_context_t *context)
 {
     struct hg_core_private_context *private_context =
         (struct hg_core_private_context *) context;
+    const struct hg_core_rails *hg_core_rails;
+    unsigned int i;
 
     HG_CHECK_SUBSYS_ERROR_NORET(
         poll, context == NULL, error, "NULL HG core context");
@@ -7195,6 +10173,11 @@ HG_Core_event_ready(hg_core_context_t *context)
             context->core_class->na_sm_class, context->na_sm_context))
         return true;
 #endif
+    hg_core_rails = &HG_CORE_CONTEXT_CLASS(private_context)->rails;
+    for (i = 0; i < hg_core_rails->count; i++)
+        if (!NA_Poll_try_wait(hg_core_rails->rails[i].na_class,
+                private_context->na_rail_contexts[i]))
+            return true;
     if (!NA_Poll_try_wait(context->core_class->na_class, context->na_context))
         return true;
     return hg_core_event_ready_loopback(private_context);
@@ -7212,6 +10195,11 @@ HG_Core_event_progress(hg_core_context_t *context, unsigned int *count_p)
     HG_CHECK_SUBSYS_ERROR(poll, context == NULL, error, ret, HG_INVALID_ARG,
         "NULL HG core context");
 
+    hg_core_timer_process((struct hg_core_private_context *) context);
+    hg_core_coalesce_process((struct hg_core_private_context *) context, false);
+    hg_core_credit_process((struct hg_core_private_context *) context);
+    hg_core_reply_process((struct hg_core_private_context *) context);
+
     ret = hg_core_progress((struct hg_core_private_context *) context, count_p);
     HG_CHECK_SUBSYS_HG_ERROR(
         poll, error, ret, "Could not progress context (%p)", (void *) context);
@@ -575,6 +575,38 @@ HG_PUBLIC hg_return_t
 HG_Core_registered_disabled_response(
     hg_core_class_t *hg_core_class, hg_id_t id, uint8_t *disabled_p);
 
+/**
+ * Set priority for a given RPC ID. Completions of RPCs that have a high
+ * priority (both the execution of the RPC callback on the target and the
+ * forward callback on the origin) are triggered ahead of completions of
+ * default priority, which are otherwise triggered in order. To prevent
+ * starvation, default priority completions are still regularly triggered
+ * when high priority completions remain. By default, all RPCs have a default
+ * priority.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param id [IN]               registered function ID
+ * \param priority [IN]         RPC priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_registered_set_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t priority);
+
+/**
+ * Get priority for a given RPC ID.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param id [IN]               registered function ID
+ * \param priority_p [OUT]      pointer to RPC priority
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_registered_get_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t *priority_p);
+
 /**
  * Lookup an addr from a peer address/name. Addresses need to be
  * freed by calling HG_Core_addr_free(). After completion, user callback is
@@ -986,6 +1018,51 @@ HG_Core_respond(hg_core_handle_t handle, hg_core_cb_t callback, void *arg,
 HG_PUBLIC hg_return_t
 HG_Core_cancel(hg_core_handle_t handle);
 
+/**
+ * Get the retry-after hint returned by the target along with an HG_BUSY
+ * response, i.e., when the target was at capacity and did not process the
+ * request. Only valid after completion of HG_Core_forward().
+ *
+ * \param handle [IN]           HG handle
+ * \param retry_ms_p [OUT]      pointer to hint in ms (0 if none)
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_get_retry_after(hg_core_handle_t handle, unsigned int *retry_ms_p);
+
+/**
+ * Set a deadline of timeout_ms relative to each subsequent call to
+ * HG_Core_forward() on that handle. Past that deadline, the forward is
+ * canceled and completes with HG_TIMEOUT. The remaining time is passed to the
+ * target, which answers the request with HG_TIMEOUT without processing it if
+ * it expires before it gets processed.
+ *
+ * \param handle [IN]           HG handle
+ * \param timeout_ms [IN]       timeout in ms (0 to disable)
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_set_timeout(hg_core_handle_t handle, unsigned int timeout_ms);
+
+/**
+ * Set an alternate target to which a duplicate of the request is sent if no
+ * response was received after a delay, which is derived from the forward
+ * latencies observed on the handle's context (see hedge_percentile). The
+ * first successful response completes the forward and the other request is
+ * canceled. Requests carrying extra input data are never duplicated, and the
+ * RPC must therefore be safe to execute twice.
+ *
+ * \param handle [IN]           HG handle
+ * \param addr [IN]             alternate address (HG_CORE_ADDR_NULL to
+ *                              disable)
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_set_hedge(hg_core_handle_t handle, hg_core_addr_t addr);
+
 /**
  * (Deprecated in favor of HG_Core_event_progress())
  * Try to progress RPC execution for at most timeout until timeout is reached or
@@ -1115,6 +1192,7 @@ struct hg_core_rpc_info {
     void (*free_callback)(void *); /* User data free callback */
     hg_id_t id;                    /* RPC ID */
     uint8_t no_response;           /* RPC response not expected */
+    uint8_t priority;              /* RPC priority (hg_priority_t) */
 };
 
 /* HG core handle */
@@ -41,17 +41,6 @@
 #define hg_core_header_proc_int8_t_dec(x)                                      \
     (int8_t) hg_core_header_proc_uint8_t_dec((uint8_t) x)
 
-/* Update checksum */
-#ifdef HG_HAS_CHECKSUMS
-#    define HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type)              \
-        do {                                                                   \
-            if (hg_header->checksum != MCHECKSUM_OBJECT_NULL)                  \
-                mchecksum_update(hg_header->checksum, &data, sizeof(type));    \
-        } while (0)
-#else
-#    define HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type)
-#endif
-
 /* Proc type */
 #define HG_CORE_HEADER_PROC_TYPE(buf_ptr, data, type, op)                      \
     do {                                                                       \
@@ -66,13 +55,6 @@
         buf_ptr = (char *) buf_ptr + sizeof(type);                             \
     } while (0)
 
-/* Proc */
-#define HG_CORE_HEADER_PROC(hg_header, buf_ptr, data, type, op)                \
-    do {                                                                       \
-        HG_CORE_HEADER_PROC_TYPE(buf_ptr, data, type, op);                     \
-        HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type);                 \
-    } while (0)
-
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -190,23 +172,28 @@ hg_core_header_request_proc(hg_proc_op_t op, void *buf, size_t buf_size,
 #endif
 
     /* HG byte */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->hg, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->hg, uint8_t, op);
 
     /* Protocol */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->protocol, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->protocol, uint8_t, op);
 
     /* RPC ID */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->id, uint64_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->id, uint64_t, op);
 
     /* Flags */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->flags, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->flags, uint8_t, op);
 
     /* Cookie */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->cookie, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->cookie, uint8_t, op);
+
+    /* Timeout */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->timeout_ms, uint32_t, op);
 
 #ifdef HG_HAS_CHECKSUMS
     if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL) {
-        /* Checksum of header */
+        /* Checksum of header, encoded fields are checksummed in one pass */
+        mchecksum_update(hg_core_header->checksum, buf,
+            (size_t) ((char *) buf_ptr - (char *) buf));
         mchecksum_get(hg_core_header->checksum, &header->hash.header,
             sizeof(uint16_t), MCHECKSUM_FINALIZE);
 
@@ -252,17 +239,25 @@ hg_core_header_response_proc(hg_proc_op_t op, void *buf, size_t buf_size,
 #endif
 
     /* Return code */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->ret_code, int8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->ret_code, int8_t, op);
 
     /* Flags */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->flags, uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->flags, uint8_t, op);
 
     /* Cookie */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->cookie, uint16_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->cookie, uint16_t, op);
+
+    /* Retry-after hint */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->retry_ms, uint32_t, op);
+
+    /* Credits */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->credits, uint16_t, op);
 
 #ifdef HG_HAS_CHECKSUMS
     if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL) {
-        /* Checksum of header */
+        /* Checksum of header, encoded fields are checksummed in one pass */
+        mchecksum_update(hg_core_header->checksum, buf,
+            (size_t) ((char *) buf_ptr - (char *) buf));
         mchecksum_get(hg_core_header->checksum, &header->hash.header,
             sizeof(uint16_t), MCHECKSUM_FINALIZE);
 
@@ -288,6 +283,32 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_core_header_batch_proc(hg_proc_op_t op, void *buf, size_t buf_size,
+    struct hg_core_header_batch *header)
+{
+    void *buf_ptr = buf;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, buf_size < sizeof(struct hg_core_header_batch),
+        error, ret, HG_OVERFLOW, "Invalid buffer size");
+
+    /* Tag */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->tag, uint32_t, op);
+
+    /* Size */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->size, uint16_t, op);
+
+    /* Pad */
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->pad, uint16_t, op);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 hg_core_header_request_verify(const struct hg_core_header *hg_core_header)
@@ -26,37 +26,51 @@ HG_PACKED(struct hg_core_header_request {
     uint64_t id;                    /* RPC request identifier */
     uint8_t flags;                  /* Flags */
     uint8_t cookie;                 /* Cookie */
+    uint32_t timeout_ms;            /* Time left before deadline (0 if none) */
     union hg_core_header_hash hash; /* Hash */
-    /* 128 bits here */
+    /* 160 bits here */
 });
 
 HG_PACKED(struct hg_core_header_response {
     int8_t ret_code;                /* Return code */
     uint8_t flags;                  /* Flags */
     uint16_t cookie;                /* Cookie */
-    uint64_t pad;                   /* Pad */
+    uint32_t retry_ms;              /* Retry-after hint (HG_BUSY) */
+    uint16_t credits;               /* Credits granted to origin */
+    uint16_t pad;                   /* Pad */
     union hg_core_header_hash hash; /* Hash */
     /* 128 bits here */
 });
 #else
 HG_PACKED(struct hg_core_header_request {
-    uint8_t hg;       /* Mercury identifier */
-    uint8_t protocol; /* Version number */
-    uint64_t id;      /* RPC request identifier */
-    uint8_t flags;    /* Flags */
-    uint8_t cookie;   /* Cookie */
-    /* 96 bits here */
+    uint8_t hg;          /* Mercury identifier */
+    uint8_t protocol;    /* Version number */
+    uint64_t id;         /* RPC request identifier */
+    uint8_t flags;       /* Flags */
+    uint8_t cookie;      /* Cookie */
+    uint32_t timeout_ms; /* Time left before deadline (0 if none) */
+    /* 128 bits here */
 });
 
 HG_PACKED(struct hg_core_header_response {
-    int8_t ret_code; /* Return code */
-    uint8_t flags;   /* Flags */
-    uint16_t cookie; /* Cookie */
-    uint64_t pad;    /* Pad */
+    int8_t ret_code;   /* Return code */
+    uint8_t flags;     /* Flags */
+    uint16_t cookie;   /* Cookie */
+    uint32_t retry_ms; /* Retry-after hint (HG_BUSY) */
+    uint16_t credits;  /* Credits granted to origin */
+    uint16_t pad;      /* Pad */
     /* 96 bits here */
 });
 #endif
 
+/* Header of each message packed into a batch */
+HG_PACKED(struct hg_core_header_batch {
+    uint32_t tag;  /* Tag of request */
+    uint16_t size; /* Size of message that follows */
+    uint16_t pad;  /* Pad */
+    /* 64 bits here */
+});
+
 /* Common header struct request/response */
 struct hg_core_header {
     union {
@@ -76,10 +90,17 @@ struct hg_core_header {
  *
  *
  * Request:
- * mercury byte / protocol version number / rpc id / flags / cookie / checksum
+ * mercury byte / protocol version number / rpc id / flags / cookie / timeout /
+ * checksum
  *
  * Response:
- * flags / return code / cookie / checksum
+ * flags / return code / cookie / retry-after hint / credits / checksum
+ *
+ * Batch (request header followed by batch entries):
+ * tag / size / message (request header and data)
+ *
+ * Batch response (response header followed by batch entries):
+ * tag / size / message (response header and data)
  */
 
 /*****************/
@@ -90,7 +111,7 @@ struct hg_core_header {
 #define HG_CORE_IDENTIFIER (('H' << 1) | ('G')) /* 0xD7 */
 
 /* Mercury protocol version number */
-#define HG_CORE_PROTOCOL_VERSION 0x05
+#define HG_CORE_PROTOCOL_VERSION 0x08
 
 /*********************/
 /* Public Prototypes */
@@ -104,6 +125,8 @@ static HG_INLINE size_t
 hg_core_header_request_get_size(void);
 static HG_INLINE size_t
 hg_core_header_response_get_size(void);
+static HG_INLINE size_t
+hg_core_header_batch_get_size(void);
 
 /**
  * Get size reserved for request header (separate user data stored in payload).
@@ -127,6 +150,17 @@ hg_core_header_response_get_size(void)
     return sizeof(struct hg_core_header_response);
 }
 
+/**
+ * Get size reserved for the header of each message packed into a batch.
+ *
+ * \return Non-negative size value
+ */
+static HG_INLINE size_t
+hg_core_header_batch_get_size(void)
+{
+    return sizeof(struct hg_core_header_batch);
+}
+
 /**
  * Initialize RPC request header.
  *
@@ -213,6 +247,20 @@ HG_PRIVATE hg_return_t
 hg_core_header_response_proc(hg_proc_op_t op, void *buf, size_t buf_size,
     struct hg_core_header *hg_core_header);
 
+/**
+ * Process header of message packed into a batch.
+ *
+ * \param op [IN]               operation type: HG_ENCODE / HG_DECODE
+ * \param buf [IN/OUT]          buffer
+ * \param buf_size [IN]         buffer size
+ * \param header [IN/OUT]       pointer to batch header structure
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PRIVATE hg_return_t
+hg_core_header_batch_proc(hg_proc_op_t op, void *buf, size_t buf_size,
+    struct hg_core_header_batch *header);
+
 /**
  * Verify private information from request header.
  *
@@ -26,6 +26,12 @@ typedef enum hg_checksum_level {
                                 headers) */
 } hg_checksum_level_t;
 
+/* RPC priorities */
+typedef enum hg_priority {
+    HG_PRIORITY_DEFAULT, /*!< completions triggered in order (default) */
+    HG_PRIORITY_HIGH     /*!< completions triggered ahead of default ones */
+} hg_priority_t;
+
 /**
  * HG init info struct
  * NB. should be initialized using HG_INIT_INFO_INITIALIZER
@@ -117,6 +123,75 @@ struct hg_init_info {
      * multi_recv_op_max.
      * Default value is: 0 (never copy) */
     unsigned int multi_recv_copy_threshold;
+
+    /* Controls when we should start copying data in an effort to release
+     * multi-recv buffers, based on memory usage rather than on a buffer count.
+     * Copy will occur once multi-recv buffers that have been consumed but are
+     * still held by RPC handles add up to more than multi_recv_copy_watermark
+     * bytes. When set, this value supersedes multi_recv_copy_threshold.
+     * Default value is: 0 (use multi_recv_copy_threshold) */
+    size_t multi_recv_copy_watermark;
+
+    /* Controls admission of incoming RPCs. Once rpc_active_max RPCs are being
+     * processed on a given context, new requests are answered with HG_BUSY
+     * without running their handler, and the handle pool stops growing.
+     * Default value is: 0 (no limit) */
+    unsigned int rpc_active_max;
+
+    /* Retry-after hint (in ms) returned to clients along with HG_BUSY, see
+     * HG_Core_get_retry_after().
+     * Default value is: 0 (no hint) */
+    unsigned int busy_retry_ms;
+
+    /* Controls the number of forwards that can be in flight to a given target
+     * address. Forwards beyond that window are queued locally and posted in
+     * order as responses come back. Targets that set rpc_active_max may
+     * shrink the window through the credits they return with responses.
+     * Default value is: 0 (no limit) */
+    unsigned int rpc_credit_max;
+
+    /* Controls the delay after which a duplicate of a forward is sent to the
+     * alternate address set with HG_Set_hedge(). The delay is the given
+     * percentile of latencies observed for hedged forwards on that context.
+     * Default value is: 95 */
+    unsigned int hedge_percentile;
+
+    /* Controls coalescing of small forwards. Forwards to the same target
+     * whose encoded request does not exceed that size are packed together
+     * into a single message, each forward still receives its own response.
+     * Forwards that have a timeout or an alternate address set are sent on
+     * their own.
+     * Default value is: 0 (no coalescing) */
+    unsigned int rpc_coalesce_size;
+
+    /* Controls how long coalesced forwards may wait for other forwards to the
+     * same target before they are sent, if the message does not fill up
+     * before. A value of 0 sends them on the next progress call.
+     * Default value is: 0 */
+    unsigned int rpc_coalesce_ms;
+
+    /* Controls coalescing of the responses to coalesced forwards. When set on
+     * the origin, the target sends back together the responses to requests
+     * of a same batch that are ready within the same progress pass. Responses
+     * that are ready later are still sent on their own.
+     * Default is: false */
+    bool rpc_coalesce_responses;
+
+    /* Comma-separated list of NA info strings (e.g., "ofi+tcp://eth1,
+     * ofi+tcp://eth2") used to initialize additional NA classes, or rails,
+     * that bulk transfers can go through. Rails only carry bulk data, RPCs
+     * remain on the main NA class. Rails are matched by position between
+     * peers, which must therefore list them in the same order.
+     * Default is: NULL (no additional rail) */
+    const char *bulk_rails;
+
+    /* Controls striping of bulk transfers across the main NA class and bulk
+     * rails. A transfer is split into contiguous stripes of at least that
+     * size, one per rail. Transfers that are too small to be striped go
+     * through a single rail, preferably one that is local to the NUMA node
+     * of the context (see HG_Context_create_id_numa()).
+     * Default value is: 0 (64 KiB) */
+    size_t bulk_stripe_size;
 };
 
 /* Error return codes:
@@ -229,7 +304,11 @@ struct hg_diag_counters {
         .no_bulk_eager = false, .no_loopback = false, .stats = false,          \
         .no_multi_recv = false, .release_input_early = false,                  \
         .no_overflow = false, .multi_recv_op_max = 0,                          \
-        .multi_recv_copy_threshold = 0                                         \
+        .multi_recv_copy_threshold = 0, .multi_recv_copy_watermark = 0,        \
+        .rpc_active_max = 0, .busy_retry_ms = 0, .rpc_credit_max = 0,          \
+        .hedge_percentile = 0, .rpc_coalesce_size = 0, .rpc_coalesce_ms = 0,   \
+        .rpc_coalesce_responses = false, .bulk_rails = NULL,                   \
+        .bulk_stripe_size = 0                                                  \
     }
 
 #endif /* MERCURY_CORE_TYPES_H */
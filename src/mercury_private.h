@@ -17,6 +17,25 @@
 /*************************************/
 
 /* Previous versions of init info to keep compatiblity with older versions */
+struct hg_init_info_2_4 {
+    struct na_init_info_4_0 na_init_info;
+    na_class_t *na_class;
+    uint32_t request_post_init;
+    int32_t request_post_incr;
+    uint8_t auto_sm;
+    const char *sm_info_string;
+    hg_checksum_level_t checksum_level;
+    uint8_t no_bulk_eager;
+    uint8_t no_loopback;
+    uint8_t stats;
+    uint8_t no_multi_recv;
+    uint8_t release_input_early;
+    enum na_traffic_class traffic_class;
+    bool no_overflow;
+    unsigned int multi_recv_op_max;
+    unsigned int multi_recv_copy_threshold;
+};
+
 struct hg_init_info_2_3 {
     struct na_init_info_4_0 na_init_info;
     na_class_t *na_class;
@@ -67,6 +86,26 @@ struct hg_completion_entry {
 };
 
 struct hg_bulk_op_pool;
+struct hg_bulk_pool;
+struct hg_core_multi_recv_pack;
+
+/* Max number of bulk rails in addition to the main NA class */
+#define HG_CORE_RAIL_MAX (4)
+
+/* Additional NA class used for bulk transfers */
+struct hg_core_rail {
+    na_class_t *na_class;  /* NA class */
+    na_addr_t *self_addr;  /* Self address */
+    size_t self_addr_size; /* Serialize size of self address */
+    int numa_node;         /* NUMA node of NIC (-1 if unknown) */
+};
+
+/* Bulk rails of a class */
+struct hg_core_rails {
+    struct hg_core_rail rails[HG_CORE_RAIL_MAX]; /* Additional rails */
+    hg_size_t stripe_size;                       /* Min size of a stripe */
+    unsigned int count;                          /* Number of rails */
+};
 
 /*****************/
 /* Public Macros */
@@ -102,6 +141,9 @@ extern "C" {
  * Duplicate init info for ABI compatibility.
  */
 static HG_INLINE void
+hg_init_info_dup_2_4(
+    struct hg_init_info *new_info, const struct hg_init_info_2_4 *old_info);
+static HG_INLINE void
 hg_init_info_dup_2_3(
     struct hg_init_info *new_info, const struct hg_init_info_2_3 *old_info);
 static HG_INLINE void
@@ -120,12 +162,84 @@ hg_core_bulk_incr(hg_core_class_t *hg_core_class);
 HG_PRIVATE void
 hg_core_bulk_decr(hg_core_class_t *hg_core_class);
 
+/**
+ * Get bulk handle pool.
+ */
+HG_PRIVATE struct hg_bulk_pool *
+hg_core_class_get_bulk_pool(hg_core_class_t *hg_core_class);
+
 /**
  * Get bulk op pool.
  */
 HG_PRIVATE struct hg_bulk_op_pool *
 hg_core_context_get_bulk_op_pool(struct hg_core_context *core_context);
 
+/**
+ * Get bulk rails.
+ */
+HG_PRIVATE const struct hg_core_rails *
+hg_core_class_get_rails(hg_core_class_t *hg_core_class);
+
+/**
+ * Get NA context of bulk rail.
+ */
+HG_PRIVATE na_context_t *
+hg_core_context_get_na_rail(
+    struct hg_core_context *core_context, unsigned int rail);
+
+/**
+ * Get rail that small bulk transfers go through (0 being the main NA class).
+ */
+HG_PRIVATE unsigned int
+hg_core_context_get_rail(struct hg_core_context *core_context);
+
+/**
+ * Set NUMA node of context and prefer rails that are local to it.
+ */
+HG_PRIVATE void
+hg_core_context_set_numa_node(
+    struct hg_core_context *core_context, int numa_node);
+
+/**
+ * Get size of multi-recv buffers that can hold request_count messages of
+ * msg_size bytes, bounded by the max unexpected message size.
+ */
+HG_PRIVATE size_t
+hg_core_multi_recv_buf_size(
+    size_t request_count, size_t msg_size, size_t unexpected_msg_size);
+
+/**
+ * Check whether a multi-recv buffer of buf_size should be resized to
+ * new_buf_size before it is reposted.
+ */
+HG_PRIVATE bool
+hg_core_multi_recv_buf_resize(size_t buf_size, size_t new_buf_size);
+
+/**
+ * Add message size to moving average of multi-recv message sizes.
+ */
+HG_PRIVATE size_t
+hg_core_multi_recv_msg_size_avg(size_t msg_size_avg, size_t msg_size);
+
+/**
+ * Create buffer that payloads copied out of multi-recv buffers are packed
+ * into. Buffer is freed once it is released along with every payload.
+ */
+HG_PRIVATE struct hg_core_multi_recv_pack *
+hg_core_multi_recv_pack_create(size_t size);
+
+/**
+ * Get room for a payload of size bytes, NULL if pack buffer is full.
+ */
+HG_PRIVATE void *
+hg_core_multi_recv_pack_get(struct hg_core_multi_recv_pack *pack, size_t size);
+
+/**
+ * Release pack buffer or one of its payloads.
+ */
+HG_PRIVATE void
+hg_core_multi_recv_pack_release(struct hg_core_multi_recv_pack *pack);
+
 /**
  * Add entry to completion queue.
  */
@@ -152,6 +266,52 @@ hg_bulk_op_pool_create(hg_core_context_t *core_context, unsigned int init_count,
 HG_PRIVATE void
 hg_bulk_op_pool_destroy(struct hg_bulk_op_pool *hg_bulk_op_pool);
 
+/**
+ * Create pool of bulk handles.
+ */
+HG_PRIVATE hg_return_t
+hg_bulk_pool_create(
+    unsigned int max_count, struct hg_bulk_pool **hg_bulk_pool_p);
+
+/**
+ * Destroy pool of bulk handles.
+ */
+HG_PRIVATE void
+hg_bulk_pool_destroy(struct hg_bulk_pool *hg_bulk_pool);
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_init_info_dup_2_4(
+    struct hg_init_info *new_info, const struct hg_init_info_2_4 *old_info)
+{
+    *new_info = (struct hg_init_info){.na_init_info = old_info->na_init_info,
+        .na_class = old_info->na_class,
+        .request_post_init = old_info->request_post_init,
+        .request_post_incr = old_info->request_post_incr,
+        .auto_sm = old_info->auto_sm,
+        .sm_info_string = old_info->sm_info_string,
+        .checksum_level = old_info->checksum_level,
+        .no_bulk_eager = old_info->no_bulk_eager,
+        .no_loopback = old_info->no_loopback,
+        .stats = old_info->stats,
+        .no_multi_recv = old_info->no_multi_recv,
+        .release_input_early = old_info->release_input_early,
+        .traffic_class = old_info->traffic_class,
+        .no_overflow = old_info->no_overflow,
+        .multi_recv_op_max = old_info->multi_recv_op_max,
+        .multi_recv_copy_threshold = old_info->multi_recv_copy_threshold,
+        .multi_recv_copy_watermark = 0,
+        .rpc_active_max = 0,
+        .busy_retry_ms = 0,
+        .rpc_credit_max = 0,
+        .hedge_percentile = 0,
+        .rpc_coalesce_size = 0,
+        .rpc_coalesce_ms = 0,
+        .rpc_coalesce_responses = false,
+        .bulk_rails = NULL,
+        .bulk_stripe_size = 0};
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE void
 hg_init_info_dup_2_3(
@@ -172,7 +332,17 @@ hg_init_info_dup_2_3(
         .traffic_class = NA_TC_UNSPEC,
         .no_overflow = false,
         .multi_recv_op_max = 0,
-        .multi_recv_copy_threshold = 0};
+        .multi_recv_copy_threshold = 0,
+        .multi_recv_copy_watermark = 0,
+        .rpc_active_max = 0,
+        .busy_retry_ms = 0,
+        .rpc_credit_max = 0,
+        .hedge_percentile = 0,
+        .rpc_coalesce_size = 0,
+        .rpc_coalesce_ms = 0,
+        .rpc_coalesce_responses = false,
+        .bulk_rails = NULL,
+        .bulk_stripe_size = 0};
 }
 
 /*---------------------------------------------------------------------------*/
@@ -195,7 +365,17 @@ hg_init_info_dup_2_2(
         .traffic_class = NA_TC_UNSPEC,
         .no_overflow = false,
         .multi_recv_op_max = 0,
-        .multi_recv_copy_threshold = 0};
+        .multi_recv_copy_threshold = 0,
+        .multi_recv_copy_watermark = 0,
+        .rpc_active_max = 0,
+        .busy_retry_ms = 0,
+        .rpc_credit_max = 0,
+        .hedge_percentile = 0,
+        .rpc_coalesce_size = 0,
+        .rpc_coalesce_ms = 0,
+        .rpc_coalesce_responses = false,
+        .bulk_rails = NULL,
+        .bulk_stripe_size = 0};
 }
 
 #ifdef __cplusplus
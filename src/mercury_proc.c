@@ -10,6 +10,7 @@
 #include "mercury_mem.h"
 
 #ifdef HG_HAS_CHECKSUMS
+#    include "mercury_crc32c.h"
 #    include <mchecksum.h>
 #endif
 #include <stdlib.h>
@@ -50,19 +51,24 @@ hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc_p)
     hg_proc->hg_class = hg_class;
 
 #ifdef HG_HAS_CHECKSUMS
+    hg_proc->hash = hash;
+
     /* Map enum to string */
     switch (hash) {
         case HG_CRC16:
             hash_method = "crc16";
             break;
         case HG_CRC32:
-            hash_method = "crc32c";
+            /* CRC32C is computed natively */
+            hash_method = NULL;
+            hg_proc->checksum_size = sizeof(uint32_t);
             break;
         case HG_CRC64:
             hash_method = "crc64";
             break;
         default:
             hash_method = NULL;
+            hg_proc->hash = HG_NOHASH;
             break;
     }
 
@@ -72,6 +78,9 @@ hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc_p)
             "Could not initialize checksum");
 
         hg_proc->checksum_size = mchecksum_get_size(hg_proc->checksum);
+    }
+
+    if (hg_proc->checksum_size > 0) {
         hg_proc->checksum_hash = (char *) malloc(hg_proc->checksum_size);
         HG_CHECK_SUBSYS_ERROR(proc, hg_proc->checksum_hash == NULL, error, ret,
             HG_NOMEM, "Could not allocate space for checksum hash");
@@ -206,8 +215,10 @@ hg_proc_reset(hg_proc_t proc, void *buf, hg_size_t buf_size, hg_proc_op_t op)
         int rc = mchecksum_reset(hg_proc->checksum);
         HG_CHECK_SUBSYS_ERROR(proc, rc != 0, error, ret, HG_CHECKSUM_ERROR,
             "Could not reset checksum");
-        memset(hg_proc->checksum_hash, 0, hg_proc->checksum_size);
     }
+    hg_proc->crc32c = HG_CRC32C_INIT;
+    if (hg_proc->checksum_hash != NULL)
+        memset(hg_proc->checksum_hash, 0, hg_proc->checksum_size);
 #endif
 
     return HG_SUCCESS;
@@ -320,13 +331,9 @@ hg_proc_restore_ptr(hg_proc_t proc, void *data, hg_size_t data_size)
     HG_CHECK_SUBSYS_ERROR(proc, ((struct hg_proc *) proc)->op == HG_FREE, error,
         ret, HG_INVALID_ARG, "Cannot restore_ptr on HG_FREE");
 
-#ifdef HG_HAS_CHECKSUMS
-    hg_proc_checksum_update(proc, data, data_size);
-#else
-    /* Silent warning */
+    /* Data was written in place, checksum is updated on flush */
     (void) data;
     (void) data_size;
-#endif
 
     return HG_SUCCESS;
 
@@ -361,20 +368,36 @@ hg_proc_flush(hg_proc_t proc)
     hg_return_t ret;
 #ifdef HG_HAS_CHECKSUMS
     struct hg_proc *hg_proc = (struct hg_proc *) proc;
-    int rc;
+    hg_size_t size_used;
 #endif
 
     HG_CHECK_SUBSYS_ERROR(proc, proc == HG_PROC_NULL, error, ret,
         HG_INVALID_ARG, "Proc is not initialized");
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_proc->checksum == MCHECKSUM_OBJECT_NULL)
+    if (hg_proc->hash == HG_NOHASH || hg_proc->op == HG_FREE)
         return HG_SUCCESS;
 
-    rc = mchecksum_get(hg_proc->checksum, hg_proc->checksum_hash,
-        hg_proc->checksum_size, MCHECKSUM_FINALIZE);
-    HG_CHECK_SUBSYS_ERROR(
-        proc, rc != 0, error, ret, HG_CHECKSUM_ERROR, "Could not get checksum");
+    /* Checksum everything that was processed in one pass, current buffer
+     * always starts at the beginning of the payload (extra buffer has a copy
+     * of what was in proc_buf) */
+    size_used = hg_proc_get_size_used(proc);
+
+    if (hg_proc->hash == HG_CRC32) {
+        hg_proc->crc32c = hg_crc32c(
+            hg_proc->crc32c, hg_proc->current_buf->buf, (size_t) size_used);
+        memcpy(hg_proc->checksum_hash, &hg_proc->crc32c, sizeof(uint32_t));
+    } else {
+        int rc = mchecksum_update(
+            hg_proc->checksum, hg_proc->current_buf->buf, size_used);
+        HG_CHECK_SUBSYS_ERROR(proc, rc != 0, error, ret, HG_CHECKSUM_ERROR,
+            "Could not update checksum");
+
+        rc = mchecksum_get(hg_proc->checksum, hg_proc->checksum_hash,
+            hg_proc->checksum_size, MCHECKSUM_FINALIZE);
+        HG_CHECK_SUBSYS_ERROR(proc, rc != 0, error, ret, HG_CHECKSUM_ERROR,
+            "Could not get checksum");
+    }
 #endif
 
     return HG_SUCCESS;
@@ -391,6 +414,11 @@ hg_proc_checksum_update(hg_proc_t proc, void *data, hg_size_t data_size)
     struct hg_proc *hg_proc = (struct hg_proc *) proc;
     int rc;
 
+    if (hg_proc->hash == HG_CRC32) {
+        hg_proc->crc32c = hg_crc32c(hg_proc->crc32c, data, (size_t) data_size);
+        return;
+    }
+
     if (hg_proc->checksum == MCHECKSUM_OBJECT_NULL)
         return;
 
@@ -98,14 +98,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
         ((struct hg_proc *) proc)->current_buf->size_left -= size;             \
     } while (0)
 
-/* Update checksum */
-#ifdef HG_HAS_CHECKSUMS
-#    define HG_PROC_CHECKSUM_UPDATE(proc, data, size)                          \
-        hg_proc_checksum_update(proc, data, size)
-#else
-#    define HG_PROC_CHECKSUM_UPDATE(proc, data, size)
-#endif
-
 /* Base proc function */
 #ifdef HG_HAS_XDR
 #    define HG_PROC_TYPE(proc, type, data, label, ret)                         \
@@ -118,7 +110,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
             }                                                                  \
                                                                                \
             HG_PROC_UPDATE(proc, RNDUP(sizeof(type)));                         \
-            HG_PROC_CHECKSUM_UPDATE(proc, data, sizeof(type));                 \
         } while (0)
 #else
 #    define HG_PROC_TYPE(proc, type, data, label, ret)                         \
@@ -139,7 +130,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
                                                                                \
             /* Update proc pointers etc */                                     \
             HG_PROC_UPDATE(proc, sizeof(type));                                \
-            HG_PROC_CHECKSUM_UPDATE(proc, data, sizeof(type));                 \
         } while (0)
 #endif
 
@@ -156,7 +146,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
             }                                                                  \
                                                                                \
             HG_PROC_UPDATE(proc, RNDUP(size));                                 \
-            HG_PROC_CHECKSUM_UPDATE(proc, data, size);                         \
         } while (0)
 #else
 #    define HG_PROC_BYTES(proc, data, size, label, ret)                        \
@@ -177,7 +166,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
                                                                                \
             /* Update proc pointers etc */                                     \
             HG_PROC_UPDATE(proc, size);                                        \
-            HG_PROC_CHECKSUM_UPDATE(proc, data, size);                         \
         } while (0)
 #endif
 
@@ -420,6 +408,9 @@ hg_proc_set_extra_buf_is_mine(hg_proc_t proc, uint8_t mine);
 /**
  * Flush the proc after data has been encoded or decoded and finalize
  * internal checksum if checksum of data processed was initially requested.
+ * The checksum is computed in a single pass over the bytes of the proc buffer
+ * that were processed, using hardware CRC32C instructions for HG_CRC32 when
+ * the CPU supports them.
  *
  * \param proc [IN]             abstract processor object
  *
@@ -581,7 +572,8 @@ hg_proc_bytes(hg_proc_t proc, void *data, hg_size_t data_size);
 #define hg_proc_memcpy hg_proc_raw
 #define hg_proc_raw    hg_proc_bytes
 
-/* Update checksum */
+/* Update checksum with data that is not part of the proc buffer (data
+ * encoded into the proc buffer is checksummed by hg_proc_flush()) */
 #ifdef HG_HAS_CHECKSUMS
 HG_PUBLIC void
 hg_proc_checksum_update(hg_proc_t proc, void *data, hg_size_t data_size);
@@ -610,9 +602,11 @@ struct hg_proc {
     hg_class_t *hg_class; /* HG class */
     struct hg_proc_buf *current_buf;
 #ifdef HG_HAS_CHECKSUMS
-    struct mchecksum_object *checksum; /* Checksum */
+    struct mchecksum_object *checksum; /* Checksum (CRC16/CRC64) */
     void *checksum_hash;               /* Base checksum buf */
     size_t checksum_size;              /* Checksum size */
+    hg_proc_hash_t hash;               /* Hash method */
+    uint32_t crc32c;                   /* Running CRC32C value */
 #endif
     hg_proc_op_t op;
     uint8_t flags;
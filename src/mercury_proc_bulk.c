@@ -57,6 +57,11 @@ hg_proc_hg_bulk_t(hg_proc_t proc, void *data)
                 flags |= HG_BULK_SM;
 #endif
 
+            /* Serialize size depends on memory handles, register first */
+            ret = hg_bulk_register_serialize(*bulk_ptr, flags);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                proc, error, ret, "Could not register bulk handle");
+
             /* Try to make everything fit in an eager buffer */
             if (hg_proc_get_flags(proc) & HG_PROC_BULK_EAGER) {
                 HG_LOG_SUBSYS_DEBUG(proc, "Proc size left is %" PRIu64 " bytes",
@@ -50,8 +50,9 @@ struct hg_bulk_attr {
  * Bulk transfer operators.
  */
 typedef enum hg_bulk_op {
-    HG_BULK_PUSH, /*!< push data to origin */
-    HG_BULK_PULL  /*!< pull data from origin */
+    HG_BULK_PUSH,             /*!< push data to origin */
+    HG_BULK_PULL,             /*!< pull data from origin */
+    HG_BULK_CRC32C = (1 << 2) /*!< OR'ed with op to checksum data (CRC32C) */
 } hg_bulk_op_t;
 
 /* Callback info structs */
@@ -72,6 +73,7 @@ struct hg_cb_info_bulk {
     hg_bulk_t local_handle;  /* HG Bulk local handle */
     hg_bulk_op_t op;         /* Operation type */
     hg_size_t size;          /* Total size transferred */
+    uint32_t crc32c;         /* CRC32C of data (if HG_BULK_CRC32C was set) */
 };
 
 struct hg_cb_info {
@@ -105,4 +107,8 @@ typedef hg_return_t (*hg_proc_cb_t)(hg_proc_t proc, void *data);
 #define HG_OP_ID_NULL   ((hg_op_id_t) 0)
 #define HG_OP_ID_IGNORE ((hg_op_id_t *) 1)
 
+/* NUMA node placement of context resources */
+#define HG_NUMA_NODE_ANY (-1) /* No placement */
+#define HG_NUMA_NODE_NIC (-2) /* Node closest to the network interface */
+
 #endif /* MERCURY_TYPES_H */
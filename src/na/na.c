@@ -6,6 +6,9 @@
  */
 
 #include "na_plugin.h"
+#ifndef _WIN32
+#    include "na_loc.h"
+#endif
 
 #include "mercury_atomic_queue.h"
 #include "mercury_mem.h"
@@ -870,6 +873,9 @@ NA_Initialize_opt2(const char *info_string, bool listen, unsigned int version,
     NA_CHECK_SUBSYS_ERROR(cls, na_private_class->na_class.ops == NULL, error,
         ret, NA_INVALID_ARG, "NULL NA class ops");
 
+    /* Plugins that know where their NIC is located may set it */
+    na_private_class->na_class.numa_node = -1;
+
     NA_CHECK_SUBSYS_ERROR(cls,
         na_private_class->na_class.ops->initialize == NULL, error, ret,
         NA_OPNOTSUPPORTED, "initialize plugin callback is not defined");
@@ -952,6 +958,19 @@ NA_Set_log_level(const char *level)
     hg_log_set_subsys_level(NA_SUBSYS_NAME_STRING, hg_log_name_to_level(level));
 }
 
+/*---------------------------------------------------------------------------*/
+na_return_t
+NA_Get_numa_node_cpus(int numa_node, hg_cpu_set_t *cpu_mask)
+{
+#ifdef _WIN32
+    return (hg_thread_numa_node_cpus(numa_node, cpu_mask) == HG_UTIL_SUCCESS)
+               ? NA_SUCCESS
+               : NA_OPNOTSUPPORTED;
+#else
+    return na_loc_get_numa_node_cpus(numa_node, cpu_mask);
+#endif
+}
+
 /*---------------------------------------------------------------------------*/
 na_context_t *
 NA_Context_create(na_class_t *na_class)
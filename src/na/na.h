@@ -10,6 +10,8 @@
 
 #include "na_types.h"
 
+#include "mercury_thread.h"
+
 /*************************************/
 /* Public Type and Struct Definition */
 /*************************************/
@@ -182,6 +184,29 @@ NA_Get_class_protocol(const na_class_t *na_class) NA_WARN_UNUSED_RESULT;
 static NA_INLINE bool
 NA_Is_listening(const na_class_t *na_class) NA_WARN_UNUSED_RESULT;
 
+/**
+ * Return the NUMA node that is closest to the network interface used by
+ * the NA class.
+ *
+ * \param na_class [IN]         pointer to NA class
+ *
+ * \return NUMA node index or -1 if unknown
+ */
+static NA_INLINE int
+NA_Get_numa_node(const na_class_t *na_class) NA_WARN_UNUSED_RESULT;
+
+/**
+ * Get the mask of CPUs that belong to a NUMA node. hwloc is used when NA was
+ * built with hwloc support, the system's NUMA information otherwise.
+ *
+ * \param numa_node [IN]        NUMA node index
+ * \param cpu_mask [OUT]        pointer to cpu mask
+ *
+ * \return NA_SUCCESS or corresponding NA error code
+ */
+NA_PUBLIC na_return_t
+NA_Get_numa_node_cpus(int numa_node, hg_cpu_set_t *cpu_mask);
+
 /**
  * Create a new context.
  *
@@ -999,6 +1024,7 @@ struct na_class {
     char *protocol_name;            /* Name of protocol */
     uint8_t progress_mode;          /* NA progress mode */
     bool listen;                    /* Listen for connections */
+    int numa_node;                  /* NUMA node of NIC (-1 if unknown) */
 };
 
 /* NA context definition */
@@ -1144,6 +1170,13 @@ NA_Is_listening(const na_class_t *na_class)
     return na_class->listen;
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE int
+NA_Get_numa_node(const na_class_t *na_class)
+{
+    return na_class->numa_node;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE bool
 NA_Addr_is_self(na_class_t *na_class, na_addr_t *addr)
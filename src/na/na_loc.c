@@ -5,12 +5,17 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#    define _GNU_SOURCE
+#endif
 #include "na_loc.h"
 #include "na_error.h"
 
 #ifdef NA_HAS_HWLOC
 #    include <hwloc.h>
 #endif
+#include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -151,3 +156,91 @@ na_loc_check_pcidev(const struct na_loc_info *na_loc_info,
 error:
     return false;
 }
+
+/*---------------------------------------------------------------------------*/
+int
+na_loc_get_pcidev_numa_node(unsigned int domain_id, unsigned int bus_id,
+    unsigned int device_id, unsigned int function_id)
+{
+    char path[64];
+    FILE *file;
+    int numa_node = -1;
+
+    snprintf(path, sizeof(path),
+        "/sys/bus/pci/devices/%04x:%02x:%02x.%x/numa_node", domain_id, bus_id,
+        device_id, function_id);
+
+    file = fopen(path, "r");
+    if (file == NULL) {
+        NA_LOG_SUBSYS_DEBUG(
+            cls, "Could not open %s (%s)", path, strerror(errno));
+        return -1;
+    }
+    if (fscanf(file, "%d", &numa_node) != 1)
+        numa_node = -1;
+    fclose(file);
+
+    return numa_node;
+}
+
+/*---------------------------------------------------------------------------*/
+na_return_t
+na_loc_get_numa_node_cpus(int numa_node, hg_cpu_set_t *cpu_mask)
+{
+#if defined(NA_HAS_HWLOC) && !defined(__APPLE__)
+    hwloc_topology_t topology = NULL;
+    hwloc_obj_t obj = NULL;
+    unsigned int cpu;
+    na_return_t ret;
+    int rc;
+
+    NA_CHECK_SUBSYS_ERROR(cls, numa_node < 0, error, ret, NA_INVALID_ARG,
+        "Invalid NUMA node %d", numa_node);
+
+    /* Topology without I/O devices is enough to find the CPUs of a node */
+    rc = hwloc_topology_init(&topology);
+    NA_CHECK_SUBSYS_ERROR(cls, rc != 0, error, ret, NA_PROTOCOL_ERROR,
+        "hwloc_topology_init() failed");
+
+    rc = hwloc_topology_load(topology);
+    NA_CHECK_SUBSYS_ERROR(cls, rc != 0, error, ret, NA_PROTOCOL_ERROR,
+        "hwloc_topology_load() failed");
+
+    while ((obj = hwloc_get_next_obj_by_type(
+                topology, HWLOC_OBJ_NUMANODE, obj)) != NULL)
+        if (obj->os_index == (unsigned int) numa_node)
+            break;
+    NA_CHECK_SUBSYS_ERROR(cls, obj == NULL || obj->cpuset == NULL, error, ret,
+        NA_NOENTRY, "Could not find NUMA node %d", numa_node);
+    NA_CHECK_SUBSYS_ERROR(cls, hwloc_bitmap_iszero(obj->cpuset), error, ret,
+        NA_NOENTRY, "NUMA node %d has no CPUs", numa_node);
+
+    CPU_ZERO(cpu_mask);
+    hwloc_bitmap_foreach_begin(cpu, obj->cpuset)
+    {
+        if (cpu < CPU_SETSIZE)
+            CPU_SET(cpu, cpu_mask);
+    }
+    hwloc_bitmap_foreach_end();
+
+    hwloc_topology_destroy(topology);
+
+    return NA_SUCCESS;
+
+error:
+    if (topology)
+        hwloc_topology_destroy(topology);
+
+    return ret;
+#else
+    int rc = hg_thread_numa_node_cpus(numa_node, cpu_mask);
+
+    NA_CHECK_SUBSYS_ERROR_NORET(cls, rc != HG_UTIL_SUCCESS, error,
+        "Could not get CPUs of NUMA node %d", numa_node);
+
+    return NA_SUCCESS;
+
+error:
+    return NA_NOENTRY;
+#endif
+}
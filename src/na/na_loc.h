@@ -10,6 +10,8 @@
 
 #include "na_types.h"
 
+#include "mercury_thread.h"
+
 /*************************************/
 /* Public Type and Struct Definition */
 /*************************************/
@@ -62,6 +64,31 @@ na_loc_check_pcidev(const struct na_loc_info *na_loc_info,
     unsigned int domain_id, unsigned int bus_id, unsigned int device_id,
     unsigned int function_id);
 
+/**
+ * Get the NUMA node that a PCI device is attached to.
+ *
+ * \param domain_id [IN]        PCI domain
+ * \param bus_id [IN]           PCI bus
+ * \param device_id [IN]        PCI device
+ * \param function_id [IN]      PCI function
+ *
+ * \return NUMA node index or -1 if unknown
+ */
+NA_PLUGIN_VISIBILITY int
+na_loc_get_pcidev_numa_node(unsigned int domain_id, unsigned int bus_id,
+    unsigned int device_id, unsigned int function_id);
+
+/**
+ * Get the mask of CPUs that belong to a NUMA node, using hwloc when available.
+ *
+ * \param numa_node [IN]        NUMA node index
+ * \param cpu_mask [OUT]        cpu mask
+ *
+ * \return NA_SUCCESS or corresponding NA error code
+ */
+NA_PLUGIN_VISIBILITY na_return_t
+na_loc_get_numa_node_cpus(int numa_node, hg_cpu_set_t *cpu_mask);
+
 #ifdef __cplusplus
 }
 #endif
@@ -312,8 +312,17 @@ static unsigned long const na_ofi_prov_flags[] = {NA_OFI_PROV_TYPES};
 #define NA_OFI_TAG_MASK       ((uint64_t) 0x0FFFFFFFF)
 #define NA_OFI_UNEXPECTED_TAG (NA_OFI_TAG_MASK + 1)
 
-/* Number of CQ event provided for fi_cq_read() */
+/* Number of CQ event provided for fi_cq_read() (batch size adapts between
+ * NA_OFI_CQ_EVENT_NUM and NA_OFI_CQ_EVENT_MAX) */
 #define NA_OFI_CQ_EVENT_NUM (16)
+#define NA_OFI_CQ_EVENT_MAX (64)
+
+/* Default max number of CQ events processed per poll */
+#define NA_OFI_CQ_POLL_BUDGET (256)
+
+/* Size of per-context FI source address cache (must be a power of 2) */
+#define NA_OFI_SRC_ADDR_CACHE_SIZE (64)
+
 /**
  * CQ default provider sizes:
  * - tcp: 1024
@@ -528,13 +537,16 @@ struct na_ofi_addr_key {
     uint64_t val; /* Keep a 64-bit value for now to simplify hashing */
 };
 
-/* Address */
+/* Address (the refcount is shared by all contexts, it is a single atomic
+ * that source lookups increment without lock, there is no per-context count
+ * as release would then need to gather counts across contexts) */
 struct na_ofi_addr {
     struct na_ofi_addr_key addr_key; /* Address key               */
     STAILQ_ENTRY(na_ofi_addr) entry; /* Entry in addr pool        */
     struct na_ofi_class *class;      /* Class                     */
     fi_addr_t fi_addr;               /* FI address                */
     fi_addr_t fi_auth_key;           /* FI auth key               */
+    hg_atomic_int64_t cache_fi_addr; /* FI addr of src addr cache */
     hg_atomic_int32_t refcount;      /* Reference counter         */
 };
 
@@ -682,7 +694,12 @@ struct na_ofi_context {
     struct fid_ep *fi_rx;                  /* Receive context handle        */
     struct na_ofi_eq *eq;                  /* Event queues                  */
     hg_atomic_int32_t multi_op_count;      /* Number of multi-events ops    */
+    hg_atomic_int32_t cq_batch;            /* Current CQ read batch size    */
     uint8_t idx;                           /* Context index                 */
+#ifdef NA_OFI_HAS_ADDR_POOL
+    /* Source addresses of recent unexpected messages, indexed by FI addr */
+    hg_atomic_int64_t src_addr_cache[NA_OFI_SRC_ADDR_CACHE_SIZE];
+#endif
 };
 
 /* Endpoint */
@@ -817,9 +834,10 @@ struct na_ofi_class {
         struct fid_ep *, const struct na_ofi_msg_info *, void *);
     na_return_t (*msg_recv_unexpected)(
         struct fid_ep *, const struct na_ofi_msg_info *, void *);
-    na_return_t (*cq_poll)(
-        struct na_ofi_class *, struct na_ofi_context *, unsigned int *);
+    na_return_t (*cq_poll)(struct na_ofi_class *, struct na_ofi_context *,
+        unsigned int, unsigned int *);
     unsigned long opt_features;    /* Optional feature flags   */
+    unsigned int cq_poll_budget;   /* Max CQ events per poll   */
     hg_atomic_int32_t n_contexts;  /* Number of context        */
     unsigned int op_retry_timeout; /* Retry timeout            */
     unsigned int op_retry_period;  /* Time elapsed until next retry */
@@ -1539,18 +1557,34 @@ na_ofi_cq_can_poll_multi(
     struct na_ofi_op_queue *multi_op_queue, unsigned int *count_p);
 
 /**
- * Poll from CQ (FI_SOURCE not supported).
+ * Get size of next CQ read, capped by remaining budget.
+ */
+static NA_INLINE unsigned int
+na_ofi_cq_batch_get(
+    struct na_ofi_context *na_ofi_context, unsigned int remaining);
+
+/**
+ * Adapt CQ read batch size to the number of events last read.
+ */
+static NA_INLINE void
+na_ofi_cq_batch_update(struct na_ofi_context *na_ofi_context,
+    unsigned int batch, unsigned int count);
+
+/**
+ * Poll from CQ (FI_SOURCE not supported), up to max_count events.
  */
 static na_return_t
 na_ofi_cq_poll_no_source(struct na_ofi_class *na_ofi_class,
-    struct na_ofi_context *na_ofi_context, unsigned int *count_p);
+    struct na_ofi_context *na_ofi_context, unsigned int max_count,
+    unsigned int *count_p);
 
 /**
- * Poll from CQ (FI_SOURCE supported).
+ * Poll from CQ (FI_SOURCE supported), up to max_count events.
  */
 static na_return_t
 na_ofi_cq_poll_fi_source(struct na_ofi_class *na_ofi_class,
-    struct na_ofi_context *na_ofi_context, unsigned int *count_p);
+    struct na_ofi_context *na_ofi_context, unsigned int max_count,
+    unsigned int *count_p);
 
 /**
  * Read from CQ (FI_SOURCE not supported).
@@ -1579,15 +1613,33 @@ na_ofi_cq_readerr(struct fid_cq *cq, struct fi_cq_tagged_entry *cq_event,
  */
 static na_return_t
 na_ofi_cq_process_src_addr(struct na_ofi_class *na_ofi_class,
-    fi_addr_t src_addr, struct na_ofi_src_err *src_err,
-    struct na_ofi_addr **na_ofi_addr_p);
+    struct na_ofi_context *na_ofi_context, fi_addr_t src_addr,
+    struct na_ofi_src_err *src_err, struct na_ofi_addr **na_ofi_addr_p);
 
 /**
  * Retrieve source address of unexpected messages (FI_SOURCE supported).
  */
 static na_return_t
 na_ofi_cq_process_fi_src_addr(struct na_ofi_class *na_ofi_class,
-    fi_addr_t src_addr, struct na_ofi_addr **na_ofi_addr_p);
+    struct na_ofi_context *na_ofi_context, fi_addr_t src_addr,
+    struct na_ofi_addr **na_ofi_addr_p);
+
+#ifdef NA_OFI_HAS_ADDR_POOL
+/**
+ * Lookup FI addr in context source address cache and take a reference to
+ * the address if found.
+ */
+static struct na_ofi_addr *
+na_ofi_src_addr_cache_lookup(
+    struct na_ofi_context *na_ofi_context, fi_addr_t fi_addr);
+
+/**
+ * Insert address into context source address cache.
+ */
+static NA_INLINE void
+na_ofi_src_addr_cache_insert(
+    struct na_ofi_context *na_ofi_context, struct na_ofi_addr *na_ofi_addr);
+#endif
 
 /**
  * Retrieve source address of unexpected messages (FI_SOURCE_ERR supported).
@@ -3508,8 +3560,11 @@ na_ofi_getinfo(enum na_ofi_prov_type prov_type, const struct na_ofi_info *info,
         hints->caps |= na_ofi_prov_extra_caps[prov_type];
 #if FI_VERSION_GE(FI_COMPILE_VERSION, FI_VERSION(1, 20))
         /* Starting with libfabric 1.20, the cxi provider enhanced scalability
-         * of FI_SOURCE and supports FI_AV_USER_ID. */
-        if (prov_type == NA_OFI_PROV_CXI)
+         * of FI_SOURCE and supports FI_AV_USER_ID. Other providers using
+         * FI_SOURCE are also asked for FI_AV_USER_ID so that the source
+         * address of unexpected messages can be directly retrieved from CQ
+         * entries, this is dropped below if not supported. */
+        if (hints->caps & FI_SOURCE)
             hints->caps |= FI_AV_USER_ID;
 #else
         /* With older versions of Slingshot, disable FI_SOURCE. */
@@ -3569,6 +3624,16 @@ na_ofi_getinfo(enum na_ofi_prov_type prov_type, const struct na_ofi_info *info,
 
     /* Retrieve list of all providers supported with above requirement hints */
     rc = fi_getinfo(NA_OFI_VERSION, node, service, flags, hints, fi_info_p);
+#if FI_VERSION_GE(FI_COMPILE_VERSION, FI_VERSION(1, 20))
+    if (rc == -FI_ENODATA && (hints->caps & FI_AV_USER_ID) &&
+        prov_type != NA_OFI_PROV_CXI) {
+        NA_LOG_SUBSYS_DEBUG(cls,
+            "FI_AV_USER_ID not supported by %s, falling back to FI addr map",
+            hints->fabric_attr->prov_name);
+        hints->caps &= ~FI_AV_USER_ID;
+        rc = fi_getinfo(NA_OFI_VERSION, node, service, flags, hints, fi_info_p);
+    }
+#endif
     NA_CHECK_SUBSYS_ERROR(cls, rc != 0, cleanup, ret, na_ofi_errno_to_na(-rc),
         "fi_getinfo(%s) failed, rc: %d (%s)", hints->fabric_attr->prov_name, rc,
         fi_strerror(-rc));
@@ -4135,6 +4200,14 @@ na_ofi_class_env_config(struct na_ofi_class *na_ofi_class)
         "NA_OFI_OP_RETRY_PERIOD (%u) > NA_OFI_OP_RETRY_TIMEOUT(%u)",
         na_ofi_class->op_retry_period, na_ofi_class->op_retry_timeout);
 
+    /* Max number of CQ events processed per poll */
+    if ((env = getenv("NA_OFI_CQ_POLL_BUDGET")) != NULL) {
+        na_ofi_class->cq_poll_budget = (unsigned int) atoi(env);
+    } else
+        na_ofi_class->cq_poll_budget = NA_OFI_CQ_POLL_BUDGET;
+    NA_CHECK_SUBSYS_ERROR(cls, na_ofi_class->cq_poll_budget == 0, error, ret,
+        NA_INVALID_ARG, "NA_OFI_CQ_POLL_BUDGET must be > 0");
+
     return NA_SUCCESS;
 
 error:
@@ -5634,15 +5707,18 @@ static void
 na_ofi_addr_reset(
     struct na_ofi_addr *na_ofi_addr, struct na_ofi_addr_key *addr_key)
 {
-    /* One refcount for the caller to hold until addr_free */
-    hg_atomic_init32(&na_ofi_addr->refcount, 1);
-
     /* Set FI addrs to invalid values */
     na_ofi_addr->fi_addr = FI_ADDR_NOTAVAIL;
     na_ofi_addr->fi_auth_key = FI_ADDR_NOTAVAIL;
+    hg_atomic_set64(&na_ofi_addr->cache_fi_addr, (int64_t) FI_ADDR_NOTAVAIL);
 
     /* Keep copy of the key */
     na_ofi_addr->addr_key = *addr_key;
+
+    /* One refcount for the caller to hold until addr_free, taken last and
+     * without overwriting the count as source address cache lookups may
+     * take references as soon as it is non-zero */
+    hg_atomic_incr32(&na_ofi_addr->refcount);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -5713,7 +5789,11 @@ na_ofi_mem_alloc(struct na_ofi_class *na_ofi_class, size_t size,
     int rc;
 
 #if !defined(_WIN32) && !defined(__APPLE__)
-    page_size = (size_t) hg_mem_get_hugepage_size();
+    /* If huge pages were globally enabled (HG_MEM_HUGEPAGES), let
+     * hg_mem_reg_alloc() select them */
+    page_size = (hg_mem_get_reg_page_size() > hg_mem_get_page_size())
+                    ? 0
+                    : (size_t) hg_mem_get_hugepage_size();
     if (page_size > 0 && size >= page_size) {
         /* Allocate a multiple of page size (TODO use extra space) */
         alloc_size = ((size % page_size) == 0)
@@ -5734,13 +5814,12 @@ na_ofi_mem_alloc(struct na_ofi_class *na_ofi_class, size_t size,
         page_size = (size_t) hg_mem_get_page_size();
         alloc_size = size;
 
-        mem_ptr = hg_mem_aligned_alloc(page_size, size);
+        mem_ptr = hg_mem_reg_alloc(page_size, size);
         NA_CHECK_SUBSYS_ERROR_NORET(mem, mem_ptr == NULL, error,
             "Could not allocate %d bytes", (int) size);
 
-        NA_LOG_SUBSYS_DEBUG(mem,
-            "Allocated %zu bytes using aligned alloc at address %p", alloc_size,
-            mem_ptr);
+        NA_LOG_SUBSYS_DEBUG(mem, "Allocated %zu bytes at address %p",
+            alloc_size, mem_ptr);
 #if !defined(_WIN32) && !defined(__APPLE__)
     }
 #endif
@@ -5761,7 +5840,7 @@ error_free:
     if (*flags_p & NA_OFI_ALLOC_HUGE) {
         (void) hg_mem_huge_free(mem_ptr, alloc_size);
     } else
-        hg_mem_aligned_free(mem_ptr);
+        hg_mem_reg_free(mem_ptr, alloc_size);
 error:
     return NULL;
 }
@@ -5784,7 +5863,7 @@ out:
     if (flags & NA_OFI_ALLOC_HUGE) {
         (void) hg_mem_huge_free(mem_ptr, alloc_size);
     } else
-        hg_mem_aligned_free(mem_ptr);
+        hg_mem_reg_free(mem_ptr, alloc_size);
     return;
 }
 
@@ -6347,51 +6426,92 @@ na_ofi_cq_can_poll_multi(
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE unsigned int
+na_ofi_cq_batch_get(
+    struct na_ofi_context *na_ofi_context, unsigned int remaining)
+{
+    unsigned int batch =
+        (unsigned int) hg_atomic_get32(&na_ofi_context->cq_batch);
+
+    return MIN(batch, remaining);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_ofi_cq_batch_update(struct na_ofi_context *na_ofi_context,
+    unsigned int batch, unsigned int count)
+{
+    int32_t cq_batch = hg_atomic_get32(&na_ofi_context->cq_batch);
+
+    /* Grow if CQ could have returned more, shrink if it was mostly empty */
+    if (count == batch && cq_batch < NA_OFI_CQ_EVENT_MAX)
+        hg_atomic_set32(&na_ofi_context->cq_batch, cq_batch * 2);
+    else if (count < batch / 4 && cq_batch > NA_OFI_CQ_EVENT_NUM)
+        hg_atomic_set32(&na_ofi_context->cq_batch, cq_batch / 2);
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ofi_cq_poll_no_source(struct na_ofi_class *na_ofi_class,
-    struct na_ofi_context *na_ofi_context, unsigned int *count_p)
+    struct na_ofi_context *na_ofi_context, unsigned int max_count,
+    unsigned int *count_p)
 {
-    struct fi_cq_tagged_entry cq_events[NA_OFI_CQ_EVENT_NUM];
-    unsigned int i, count = 0;
-    bool err_avail = false;
+    struct fi_cq_tagged_entry cq_events[NA_OFI_CQ_EVENT_MAX];
+    unsigned int i, batch, count, total = 0;
+    bool err_avail;
     na_return_t ret;
 
-    ret = na_ofi_cq_read(na_ofi_context->eq->fi_cq, cq_events,
-        NA_OFI_CQ_EVENT_NUM, &count, &err_avail);
-    NA_CHECK_SUBSYS_NA_ERROR(
-        poll, error, ret, "Could not read events from context CQ");
+    /* Keep reading until CQ is drained or budget is exhausted */
+    do {
+        batch = na_ofi_cq_batch_get(na_ofi_context, max_count - total);
+        count = 0;
+        err_avail = false;
 
-    if (unlikely(err_avail)) {
-        ret = na_ofi_cq_readerr(na_ofi_context->eq->fi_cq, NULL, NULL, NULL);
+        ret = na_ofi_cq_read(
+            na_ofi_context->eq->fi_cq, cq_events, batch, &count, &err_avail);
         NA_CHECK_SUBSYS_NA_ERROR(
-            poll, error, ret, "Could not read error events from context CQ");
-    }
+            poll, error, ret, "Could not read events from context CQ");
 
-    for (i = 0; i < count; i++) {
-        struct na_ofi_op_id *na_ofi_op_id =
-            container_of(cq_events[i].op_context, struct na_ofi_op_id, fi_ctx);
-        struct na_ofi_addr *na_ofi_addr = NULL;
+        if (unlikely(err_avail)) {
+            ret = na_ofi_cq_readerr(
+                na_ofi_context->eq->fi_cq, NULL, NULL, NULL);
+            NA_CHECK_SUBSYS_NA_ERROR(poll, error, ret,
+                "Could not read error events from context CQ");
+        }
 
-        NA_CHECK_SUBSYS_ERROR(op, na_ofi_op_id == NULL, error, ret,
-            NA_INVALID_ARG, "Invalid operation ID");
+        for (i = 0; i < count; i++) {
+            struct na_ofi_op_id *na_ofi_op_id = container_of(
+                cq_events[i].op_context, struct na_ofi_op_id, fi_ctx);
+            struct na_ofi_addr *na_ofi_addr = NULL;
 
-        if (na_ofi_op_id->type == NA_CB_RECV_UNEXPECTED ||
-            na_ofi_op_id->type == NA_CB_MULTI_RECV_UNEXPECTED) {
-            ret = na_ofi_cq_process_raw_src_addr(na_ofi_class,
-                (na_ofi_op_id->type == NA_CB_MULTI_RECV_UNEXPECTED)
-                    ? cq_events[i].buf
-                    : na_ofi_op_id->info.msg.buf.ptr,
-                cq_events[i].len, &na_ofi_addr);
+            NA_CHECK_SUBSYS_ERROR(op, na_ofi_op_id == NULL, error, ret,
+                NA_INVALID_ARG, "Invalid operation ID");
+
+            if (na_ofi_op_id->type == NA_CB_RECV_UNEXPECTED ||
+                na_ofi_op_id->type == NA_CB_MULTI_RECV_UNEXPECTED) {
+                ret = na_ofi_cq_process_raw_src_addr(na_ofi_class,
+                    (na_ofi_op_id->type == NA_CB_MULTI_RECV_UNEXPECTED)
+                        ? cq_events[i].buf
+                        : na_ofi_op_id->info.msg.buf.ptr,
+                    cq_events[i].len, &na_ofi_addr);
+                NA_CHECK_SUBSYS_NA_ERROR(
+                    msg, error, ret, "Could not process raw src addr");
+            }
+
+            ret = na_ofi_cq_process_event(
+                na_ofi_class, &cq_events[i], na_ofi_addr);
             NA_CHECK_SUBSYS_NA_ERROR(
-                msg, error, ret, "Could not process raw src addr");
+                poll, error, ret, "Could not process event");
         }
 
-        ret = na_ofi_cq_process_event(na_ofi_class, &cq_events[i], na_ofi_addr);
-        NA_CHECK_SUBSYS_NA_ERROR(poll, error, ret, "Could not process event");
-    }
+        total += count;
+        if (unlikely(err_avail))
+            break;
+        na_ofi_cq_batch_update(na_ofi_context, batch, count);
+    } while (count == batch && total < max_count);
 
-    *count_p = count;
+    *count_p = total;
 
     return NA_SUCCESS;
 
@@ -6402,50 +6522,65 @@ error:
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ofi_cq_poll_fi_source(struct na_ofi_class *na_ofi_class,
-    struct na_ofi_context *na_ofi_context, unsigned int *count_p)
+    struct na_ofi_context *na_ofi_context, unsigned int max_count,
+    unsigned int *count_p)
 {
-    struct fi_cq_tagged_entry cq_events[NA_OFI_CQ_EVENT_NUM];
-    fi_addr_t src_addrs[NA_OFI_CQ_EVENT_NUM];
+    struct fi_cq_tagged_entry cq_events[NA_OFI_CQ_EVENT_MAX];
+    fi_addr_t src_addrs[NA_OFI_CQ_EVENT_MAX];
     struct na_ofi_src_err src_err;
     struct na_ofi_src_err *src_err_p = NULL;
-    unsigned int i, count = 0;
-    bool err_avail = false;
+    unsigned int i, batch, count, total = 0;
+    bool err_avail;
     na_return_t ret;
 
-    ret = na_ofi_cq_readfrom(na_ofi_context->eq->fi_cq, cq_events,
-        NA_OFI_CQ_EVENT_NUM, src_addrs, &count, &err_avail);
-    NA_CHECK_SUBSYS_NA_ERROR(
-        poll, error, ret, "Could not read events from context CQ");
+    /* Keep reading until CQ is drained or budget is exhausted */
+    do {
+        batch = na_ofi_cq_batch_get(na_ofi_context, max_count - total);
+        count = 0;
+        err_avail = false;
 
-    if (unlikely(err_avail)) {
-        ret = na_ofi_cq_readerr(
-            na_ofi_context->eq->fi_cq, &cq_events[0], &src_err, &count);
+        ret = na_ofi_cq_readfrom(na_ofi_context->eq->fi_cq, cq_events, batch,
+            src_addrs, &count, &err_avail);
         NA_CHECK_SUBSYS_NA_ERROR(
-            poll, error, ret, "Could not read error events from context CQ");
-        src_err_p = &src_err;
-    }
+            poll, error, ret, "Could not read events from context CQ");
+
+        if (unlikely(err_avail)) {
+            ret = na_ofi_cq_readerr(
+                na_ofi_context->eq->fi_cq, &cq_events[0], &src_err, &count);
+            NA_CHECK_SUBSYS_NA_ERROR(poll, error, ret,
+                "Could not read error events from context CQ");
+            src_err_p = &src_err;
+        }
 
-    for (i = 0; i < count; i++) {
-        struct na_ofi_op_id *na_ofi_op_id =
-            container_of(cq_events[i].op_context, struct na_ofi_op_id, fi_ctx);
-        struct na_ofi_addr *na_ofi_addr = NULL;
+        for (i = 0; i < count; i++) {
+            struct na_ofi_op_id *na_ofi_op_id = container_of(
+                cq_events[i].op_context, struct na_ofi_op_id, fi_ctx);
+            struct na_ofi_addr *na_ofi_addr = NULL;
 
-        NA_CHECK_SUBSYS_ERROR(op, na_ofi_op_id == NULL, error, ret,
-            NA_INVALID_ARG, "Invalid operation ID");
+            NA_CHECK_SUBSYS_ERROR(op, na_ofi_op_id == NULL, error, ret,
+                NA_INVALID_ARG, "Invalid operation ID");
 
-        if (na_ofi_op_id->type == NA_CB_RECV_UNEXPECTED ||
-            na_ofi_op_id->type == NA_CB_MULTI_RECV_UNEXPECTED) {
-            ret = na_ofi_cq_process_src_addr(
-                na_ofi_class, src_addrs[i], src_err_p, &na_ofi_addr);
+            if (na_ofi_op_id->type == NA_CB_RECV_UNEXPECTED ||
+                na_ofi_op_id->type == NA_CB_MULTI_RECV_UNEXPECTED) {
+                ret = na_ofi_cq_process_src_addr(na_ofi_class, na_ofi_context,
+                    src_addrs[i], src_err_p, &na_ofi_addr);
+                NA_CHECK_SUBSYS_NA_ERROR(
+                    poll, error, ret, "Could not process src addr");
+            }
+
+            ret = na_ofi_cq_process_event(
+                na_ofi_class, &cq_events[i], na_ofi_addr);
             NA_CHECK_SUBSYS_NA_ERROR(
-                poll, error, ret, "Could not process src addr");
+                poll, error, ret, "Could not process event");
         }
 
-        ret = na_ofi_cq_process_event(na_ofi_class, &cq_events[i], na_ofi_addr);
-        NA_CHECK_SUBSYS_NA_ERROR(poll, error, ret, "Could not process event");
-    }
+        total += count;
+        if (unlikely(err_avail))
+            break;
+        na_ofi_cq_batch_update(na_ofi_context, batch, count);
+    } while (count == batch && total < max_count);
 
-    *count_p = count;
+    *count_p = total;
 
     return NA_SUCCESS;
 
@@ -6635,8 +6770,8 @@ out:
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ofi_cq_process_src_addr(struct na_ofi_class *na_ofi_class,
-    fi_addr_t src_addr, struct na_ofi_src_err *src_err,
-    struct na_ofi_addr **na_ofi_addr_p)
+    struct na_ofi_context *na_ofi_context, fi_addr_t src_addr,
+    struct na_ofi_src_err *src_err, struct na_ofi_addr **na_ofi_addr_p)
 {
     struct na_ofi_addr *na_ofi_addr = NULL;
     na_return_t ret;
@@ -6646,8 +6781,8 @@ na_ofi_cq_process_src_addr(struct na_ofi_class *na_ofi_class,
         NA_CHECK_SUBSYS_NA_ERROR(
             msg, error, ret, "Could not process FI src error addr");
     } else {
-        ret =
-            na_ofi_cq_process_fi_src_addr(na_ofi_class, src_addr, &na_ofi_addr);
+        ret = na_ofi_cq_process_fi_src_addr(
+            na_ofi_class, na_ofi_context, src_addr, &na_ofi_addr);
         NA_CHECK_SUBSYS_NA_ERROR(
             msg, error, ret, "Could not process FI src addr");
     }
@@ -6663,7 +6798,8 @@ error:
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ofi_cq_process_fi_src_addr(struct na_ofi_class *na_ofi_class,
-    fi_addr_t src_addr, struct na_ofi_addr **na_ofi_addr_p)
+    struct na_ofi_context *na_ofi_context, fi_addr_t src_addr,
+    struct na_ofi_addr **na_ofi_addr_p)
 {
     struct na_ofi_addr *na_ofi_addr = NULL;
     na_return_t ret;
@@ -6677,16 +6813,35 @@ na_ofi_cq_process_fi_src_addr(struct na_ofi_class *na_ofi_class,
     NA_LOG_SUBSYS_DEBUG(
         addr, "Retrieving address for FI addr %" PRIu64, src_addr);
 
-    /* Bypass lookup if FI_AV_USER_ID is used */
-    na_ofi_addr = (na_ofi_class->domain->av_user_id)
-                      ? (struct na_ofi_addr *) src_addr
-                      : na_ofi_fi_addr_map_lookup(
-                            &na_ofi_class->domain->addr_map, &src_addr);
+    /* Bypass lookup if FI_AV_USER_ID is used, only the shared refcount of
+     * the address is incremented */
+    if (na_ofi_class->domain->av_user_id) {
+        na_ofi_addr = (struct na_ofi_addr *) src_addr;
+        na_ofi_addr_ref_incr(na_ofi_addr);
+        goto done;
+    }
+
+#ifdef NA_OFI_HAS_ADDR_POOL
+    /* Avoid taking the map lock for senders seen recently */
+    na_ofi_addr = na_ofi_src_addr_cache_lookup(na_ofi_context, src_addr);
+    if (na_ofi_addr != NULL)
+        goto done;
+#else
+    (void) na_ofi_context;
+#endif
+
+    na_ofi_addr =
+        na_ofi_fi_addr_map_lookup(&na_ofi_class->domain->addr_map, &src_addr);
     NA_CHECK_SUBSYS_ERROR(addr, na_ofi_addr == NULL, error, ret, NA_NOENTRY,
         "No entry found for previously inserted src addr");
 
     na_ofi_addr_ref_incr(na_ofi_addr);
 
+#ifdef NA_OFI_HAS_ADDR_POOL
+    na_ofi_src_addr_cache_insert(na_ofi_context, na_ofi_addr);
+#endif
+
+done:
     *na_ofi_addr_p = na_ofi_addr;
 
     return NA_SUCCESS;
@@ -6695,6 +6850,53 @@ error:
     return ret;
 }
 
+#ifdef NA_OFI_HAS_ADDR_POOL
+/*---------------------------------------------------------------------------*/
+static struct na_ofi_addr *
+na_ofi_src_addr_cache_lookup(
+    struct na_ofi_context *na_ofi_context, fi_addr_t fi_addr)
+{
+    struct na_ofi_addr *na_ofi_addr =
+        (struct na_ofi_addr *) (uintptr_t) hg_atomic_get64(
+            &na_ofi_context
+                 ->src_addr_cache[fi_addr & (NA_OFI_SRC_ADDR_CACHE_SIZE - 1)]);
+    int32_t refcount;
+
+    if (na_ofi_addr == NULL)
+        return NULL;
+
+    /* Addresses are recycled through the addr pool and not freed until the
+     * class is, only take a reference if the address is still in use */
+    do {
+        refcount = hg_atomic_get32(&na_ofi_addr->refcount);
+        if (refcount == 0)
+            return NULL;
+    } while (!hg_atomic_cas32(&na_ofi_addr->refcount, refcount, refcount + 1));
+
+    /* Address may have been released and re-used for another peer, the
+     * cached FI addr is reset before the address can be used again */
+    if ((fi_addr_t) hg_atomic_get64(&na_ofi_addr->cache_fi_addr) != fi_addr) {
+        na_ofi_addr_ref_decr(na_ofi_addr);
+        return NULL;
+    }
+
+    return na_ofi_addr;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_ofi_src_addr_cache_insert(
+    struct na_ofi_context *na_ofi_context, struct na_ofi_addr *na_ofi_addr)
+{
+    hg_atomic_set64(
+        &na_ofi_addr->cache_fi_addr, (int64_t) na_ofi_addr->fi_addr);
+    hg_atomic_set64(
+        &na_ofi_context->src_addr_cache[na_ofi_addr->fi_addr &
+                                        (NA_OFI_SRC_ADDR_CACHE_SIZE - 1)],
+        (int64_t) (uintptr_t) na_ofi_addr);
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ofi_cq_process_fi_src_err(struct na_ofi_class *na_ofi_class,
@@ -7665,6 +7867,19 @@ na_ofi_initialize(
     NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not verify info for %s",
         na_ofi_prov_name[prov_type]);
 
+#ifndef _WIN32
+    /* Record NUMA node of NIC */
+    if (na_ofi_class->fi_info->nic && na_ofi_class->fi_info->nic->bus_attr &&
+        na_ofi_class->fi_info->nic->bus_attr->bus_type == FI_BUS_PCI) {
+        const struct fi_pci_attr *pci =
+            &na_ofi_class->fi_info->nic->bus_attr->attr.pci;
+        na_class->numa_node = na_loc_get_pcidev_numa_node(
+            pci->domain_id, pci->bus_id, pci->device_id, pci->function_id);
+        NA_LOG_SUBSYS_DEBUG(cls, "NIC is attached to NUMA node %d",
+            na_class->numa_node);
+    }
+#endif
+
     /* Set/check optional features */
     if ((na_ofi_prov_extra_caps[prov_type] & FI_MULTI_RECV) &&
         (na_ofi_class->msg_recv_unexpected == na_ofi_msg_recv)) {
@@ -7831,6 +8046,7 @@ na_ofi_context_create(na_class_t *na_class, void **context_p, uint8_t id)
     NA_CHECK_SUBSYS_ERROR(ctx, na_ofi_context == NULL, error, ret, NA_NOMEM,
         "Could not allocate na_ofi_context");
     na_ofi_context->idx = id;
+    hg_atomic_init32(&na_ofi_context->cq_batch, NA_OFI_CQ_EVENT_NUM);
 
     /* If not using SEP, just point to class' endpoint */
     if (!na_ofi_class->use_sep) {
@@ -9107,17 +9323,20 @@ na_ofi_poll(na_class_t *na_class, na_context_t *context, unsigned int *count_p)
 {
     struct na_ofi_class *na_ofi_class = NA_OFI_CLASS(na_class);
     struct na_ofi_context *na_ofi_context = NA_OFI_CONTEXT(context);
-    unsigned int count = 0;
+    unsigned int count = 0, max_count = na_ofi_class->cq_poll_budget;
     na_return_t ret;
 
     /* If we can't hold more than NA_OFI_CQ_EVENT_NUM entries do not attempt
      * to read from CQ until NA_Trigger() has been called */
-    if ((hg_atomic_get32(&na_ofi_context->multi_op_count) > 0) &&
-        !na_ofi_cq_can_poll_multi(&na_ofi_context->multi_op_queue, count_p))
-        return NA_SUCCESS;
+    if (hg_atomic_get32(&na_ofi_context->multi_op_count) > 0) {
+        if (!na_ofi_cq_can_poll_multi(&na_ofi_context->multi_op_queue, count_p))
+            return NA_SUCCESS;
+        max_count = NA_OFI_CQ_EVENT_NUM;
+    }
 
     /* Read from CQ and process events */
-    ret = na_ofi_class->cq_poll(na_ofi_class, na_ofi_context, &count);
+    ret = na_ofi_class->cq_poll(
+        na_ofi_class, na_ofi_context, max_count, &count);
     NA_CHECK_SUBSYS_NA_ERROR(poll, error, ret, "Could not poll context CQ");
 
     /* Attempt to process retries */
@@ -110,6 +110,12 @@
 #define NA_SM_CONTEXT(context)                                                 \
     ((struct na_sm_context *) (context->plugin_context))
 
+/* Local queue locks (skipped if endpoint is single-threaded) */
+#define NA_SM_QUEUE_LOCK(__queue)                                              \
+    na_sm_queue_lock(&(__queue)->lock, (__queue)->thread_single)
+#define NA_SM_QUEUE_UNLOCK(__queue)                                            \
+    na_sm_queue_unlock(&(__queue)->lock, (__queue)->thread_single)
+
 /* Reset op ID */
 #define NA_SM_OP_RESET(__op, __context, __cb_type, __cb, __arg, __addr)        \
     do {                                                                       \
@@ -144,11 +150,15 @@
 
 /* Retrive endpoint key name */
 #define NA_SM_SCAN_URI(str, addr_key_p)                                        \
-    sscanf(str, "%d-%" SCNu8, &(addr_key_p)->pid, &(addr_key_p)->id)
+    sscanf(str, "%d-%" SCNu8 "-%" SCNu8, &(addr_key_p)->pid,                   \
+        &(addr_key_p)->id, &(addr_key_p)->ctx_id)
 
-/* Generate endpoint key name */
+/* Generate endpoint key name (context ID is only appended if non-zero) */
 #define NA_SM_PRINT_URI(str, size, addr_key)                                   \
-    snprintf(str, size, "%d-%" PRIu8, addr_key.pid, addr_key.id)
+    ((addr_key.ctx_id == 0)                                                    \
+            ? snprintf(str, size, "%d-%" PRIu8, addr_key.pid, addr_key.id)     \
+            : snprintf(str, size, "%d-%" PRIu8 "-%" PRIu8, addr_key.pid,       \
+                  addr_key.id, addr_key.ctx_id))
 
 /* Generate SHM file name */
 #define NA_SM_PRINT_SHM_NAME(str, size, uri)                                   \
@@ -213,6 +223,8 @@ struct na_sm_msg_queue {
     hg_atomic_int32_t cons_tail;
     unsigned int cons_size;
     unsigned int cons_mask;
+    /* Set while consumer is blocked waiting for notifications */
+    NA_ALIGNED(hg_atomic_int32_t cons_sleeping, HG_MEM_CACHE_LINE_SIZE);
     NA_ALIGNED(hg_atomic_int64_t ring[NA_SM_NUM_BUFS], HG_MEM_CACHE_LINE_SIZE);
 };
 
@@ -232,7 +244,7 @@ NA_PACKED(union na_sm_cmd_hdr {
         unsigned int id : 8;       /* ID */
         unsigned int pair_idx : 8; /* Index reserved */
         unsigned int type : 8;     /* Cmd type */
-        unsigned int pad : 8;      /* 8 bits left */
+        unsigned int ctx_id : 8;   /* Context ID */
     } hdr;
     uint64_t val;
 });
@@ -255,13 +267,15 @@ struct na_sm_cmd_queue {
 
 /* Address key */
 struct na_sm_addr_key {
-    pid_t pid;  /* PID */
-    uint8_t id; /* SM ID */
+    pid_t pid;      /* PID */
+    uint8_t id;     /* SM ID */
+    uint8_t ctx_id; /* Context ID */
 };
 
 /* Shared region */
 struct na_sm_region {
     struct na_sm_addr_key addr_key;  /* Region IDs */
+    uint8_t context_max;             /* Contexts with their own endpoint */
     struct na_sm_copy_buf copy_bufs; /* Pool of msg buffers */
     NA_ALIGNED(struct na_sm_queue_pair queue_pairs[NA_SM_MAX_PEERS],
         NA_SM_PAGE_SIZE);                          /* Msg queue pairs */
@@ -350,6 +364,7 @@ struct na_sm_unexpected_info {
 struct na_sm_unexpected_msg_queue {
     STAILQ_HEAD(, na_sm_unexpected_info) queue;
     hg_thread_spin_t lock;
+    bool thread_single;
 };
 
 /* RMA op */
@@ -368,12 +383,14 @@ struct na_sm_op_id {
     na_context_t *context;          /* NA context associated    */
     struct na_sm_addr *addr;        /* Address associated       */
     hg_atomic_int32_t status;       /* Operation status         */
+    bool thread_single;             /* No concurrent access     */
 };
 
 /* Op ID queue */
 struct na_sm_op_queue {
     TAILQ_HEAD(, na_sm_op_id) queue;
     hg_thread_spin_t lock;
+    bool thread_single;
 };
 
 /* Endpoint */
@@ -387,16 +404,21 @@ struct na_sm_endpoint {
     struct na_sm_addr_list poll_addr_list;     /* List of addresses to poll */
     struct na_sm_addr *source_addr;            /* Source addr */
     hg_poll_set_t *poll_set;                   /* Poll set */
+    unsigned int poll_flags;                   /* Poll set creation flags */
     int sock;                                  /* Sock fd */
     enum na_sm_poll_type sock_poll_type;       /* Sock poll type */
     hg_atomic_int32_t nofile;                  /* Number of opened fds */
+    hg_atomic_int32_t sleeping;                /* Rx queues are armed */
     uint32_t nofile_max;                       /* Max number of fds */
-    bool listen;                               /* Listen on sock */
+    uint8_t context_max; /* Contexts with their own endpoint */
+    bool listen;         /* Listen on sock */
+    bool thread_single;  /* NA_THREAD_MODE_SINGLE */
 };
 
 /* Private context */
 struct na_sm_context {
-    struct hg_poll_event events[NA_SM_MAX_EVENTS];
+    struct hg_poll_event events[NA_SM_MAX_EVENTS]; /* Poll events */
+    struct na_sm_endpoint *endpoint; /* Class or context endpoint */
 };
 
 /* Private data */
@@ -524,7 +546,8 @@ na_sm_region_close(const char *uri, struct na_sm_region *region);
  * Retrieve address key from region.
  */
 static na_return_t
-na_sm_region_get_addr_key(const char *uri, struct na_sm_addr_key *addr_key_p);
+na_sm_region_get_addr_key(const char *uri, struct na_sm_addr_key *addr_key_p,
+    uint8_t *context_max_p);
 
 /**
  * Open UNIX domain socket.
@@ -596,11 +619,14 @@ static na_return_t
 na_sm_poll_deregister(hg_poll_set_t *poll_set, int fd);
 
 /**
- * Open shared-memory endpoint.
+ * Open shared-memory endpoint. Endpoints opened for contexts share the PID/ID
+ * of the class endpoint and are distinguished by their context ID.
  */
 static na_return_t
 na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
-    bool listen, bool no_wait, uint32_t nofile_max);
+    const struct na_sm_addr_key *addr_key, uint8_t context_max, bool listen,
+    bool no_wait, unsigned int poll_flags, bool thread_single,
+    uint32_t nofile_max);
 
 /**
  * Close shared-memory endpoint.
@@ -680,6 +706,13 @@ na_sm_addr_resolve(struct na_sm_addr *na_sm_addr);
 static na_return_t
 na_sm_addr_release(struct na_sm_addr *na_sm_addr);
 
+/**
+ * Get address to use from endpoint to reach context ID of remote address.
+ */
+static na_return_t
+na_sm_addr_route(struct na_sm_endpoint *na_sm_endpoint,
+    struct na_sm_addr *na_sm_addr, uint8_t id, struct na_sm_addr **route_p);
+
 /**
  * Send events as ancillary data.
  */
@@ -699,10 +732,9 @@ na_sm_addr_event_recv(int sock, union na_sm_cmd_hdr *cmd_hdr, int *tx_notify,
  * Send msg.
  */
 static na_return_t
-na_sm_msg_send(struct na_sm_class *na_sm_class, na_context_t *context,
-    na_cb_type_t cb_type, na_cb_t callback, void *arg, const void *buf,
-    size_t buf_size, struct na_sm_addr *na_sm_addr, na_tag_t tag,
-    struct na_sm_op_id *na_sm_op_id);
+na_sm_msg_send(na_context_t *context, na_cb_type_t cb_type, na_cb_t callback,
+    void *arg, const void *buf, size_t buf_size, struct na_sm_addr *na_sm_addr,
+    uint8_t dest_id, na_tag_t tag, struct na_sm_op_id *na_sm_op_id);
 
 /**
  * Post msg.
@@ -742,8 +774,8 @@ na_sm_buf_copy_from(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int index,
  * RMA op.
  */
 static na_return_t
-na_sm_rma(struct na_sm_class *na_sm_class, na_context_t *context,
-    na_cb_type_t cb_type, na_cb_t callback, void *arg,
+na_sm_rma(na_context_t *context, na_cb_type_t cb_type, na_cb_t callback,
+    void *arg,
     na_sm_process_vm_op_t process_vm_op,
     struct na_sm_mem_handle *na_sm_mem_handle_local, na_offset_t local_offset,
     struct na_sm_mem_handle *na_sm_mem_handle_remote, na_offset_t remote_offset,
@@ -803,6 +835,26 @@ na_sm_progress_wait(na_context_t *context,
 static na_return_t
 na_sm_progress(struct na_sm_endpoint *na_sm_endpoint, unsigned int *count_p);
 
+/**
+ * Progress all rx queues without waiting.
+ */
+static na_return_t
+na_sm_progress_rx_queues(
+    struct na_sm_endpoint *na_sm_endpoint, unsigned int *count_p);
+
+/**
+ * Mark rx queues as sleeping before blocking so that senders notify us.
+ * Returns false if a message is already pending.
+ */
+static bool
+na_sm_endpoint_sleep(struct na_sm_endpoint *na_sm_endpoint);
+
+/**
+ * Clear sleeping state of rx queues after wakeup.
+ */
+static void
+na_sm_endpoint_wake(struct na_sm_endpoint *na_sm_endpoint);
+
 /**
  * Progress on endpoint sock.
  */
@@ -868,7 +920,7 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint);
  */
 static NA_INLINE void
 na_sm_op_retry(
-    struct na_sm_class *na_sm_class, struct na_sm_op_id *na_sm_op_id);
+    struct na_sm_endpoint *na_sm_endpoint, struct na_sm_op_id *na_sm_op_id);
 
 /**
  * Complete operation.
@@ -876,11 +928,37 @@ na_sm_op_retry(
 static NA_INLINE void
 na_sm_complete(struct na_sm_op_id *na_sm_op_id, na_return_t cb_ret);
 
+/**
+ * Lock local queue, unless only a single thread can access it.
+ */
+static NA_INLINE void
+na_sm_queue_lock(hg_thread_spin_t *lock, bool thread_single)
+    HG_LOCK_ACQUIRE(*lock) HG_LOCK_NO_THREAD_SAFETY_ANALYSIS;
+
+/**
+ * Unlock local queue, unless only a single thread can access it.
+ */
+static NA_INLINE void
+na_sm_queue_unlock(hg_thread_spin_t *lock, bool thread_single)
+    HG_LOCK_RELEASE(*lock) HG_LOCK_NO_THREAD_SAFETY_ANALYSIS;
+
+/**
+ * Set op status bits (plain load/store if single-threaded).
+ */
+static NA_INLINE void
+na_sm_op_status_or(struct na_sm_op_id *na_sm_op_id, int32_t bits);
+
+/**
+ * Clear op status bits (plain load/store if single-threaded).
+ */
+static NA_INLINE void
+na_sm_op_status_and(struct na_sm_op_id *na_sm_op_id, int32_t bits);
+
 /**
  * Signal internal completion.
  */
 static NA_INLINE void
-na_sm_complete_signal(struct na_sm_class *na_sm_class);
+na_sm_complete_signal(struct na_sm_endpoint *na_sm_endpoint);
 
 /**
  * Release memory.
@@ -1415,6 +1493,7 @@ na_sm_msg_queue_init(struct na_sm_msg_queue *na_sm_queue)
     hg_atomic_init32(&na_sm_queue->cons_head, 0);
     hg_atomic_init32(&na_sm_queue->prod_tail, 0);
     hg_atomic_init32(&na_sm_queue->cons_tail, 0);
+    hg_atomic_init32(&na_sm_queue->cons_sleeping, 0);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1592,7 +1671,8 @@ na_sm_addr_key_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
     struct na_sm_addr_key *addr_key1 = (struct na_sm_addr_key *) key1,
                           *addr_key2 = (struct na_sm_addr_key *) key2;
 
-    return (addr_key1->pid == addr_key2->pid && addr_key1->id == addr_key2->id);
+    return (addr_key1->pid == addr_key2->pid && addr_key1->id == addr_key2->id &&
+            addr_key1->ctx_id == addr_key2->ctx_id);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1611,11 +1691,12 @@ na_sm_string_to_addr(
         "Malformed address string (%s)", str);
     strncpy(uri, uri_start + strlen(delim), size - 1);
 
-    /* Get PID / ID from name */
+    /* Get PID / ID (and optional context ID) from name */
+    addr_key_p->ctx_id = 0;
     rc = NA_SM_SCAN_URI(uri, addr_key_p);
-    if (rc != 2) {
+    if (rc < 2) {
         /* Try to retrieve address key from region */
-        ret = na_sm_region_get_addr_key(uri, addr_key_p);
+        ret = na_sm_region_get_addr_key(uri, addr_key_p, NULL);
         NA_CHECK_SUBSYS_NA_ERROR(addr, done, ret,
             "Could not retrieve address key from URI (%s)", uri);
     }
@@ -1705,7 +1786,8 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_region_get_addr_key(const char *uri, struct na_sm_addr_key *addr_key_p)
+na_sm_region_get_addr_key(const char *uri, struct na_sm_addr_key *addr_key_p,
+    uint8_t *context_max_p)
 {
     char filename[NA_SM_MAX_FILENAME];
     struct na_sm_region *na_sm_region = NULL;
@@ -1725,7 +1807,10 @@ na_sm_region_get_addr_key(const char *uri, struct na_sm_addr_key *addr_key_p)
         "Could not map SM region (%s)", filename);
 
     /* Copy addr_key */
-    *addr_key_p = na_sm_region->addr_key;
+    if (addr_key_p)
+        *addr_key_p = na_sm_region->addr_key;
+    if (context_max_p)
+        *context_max_p = na_sm_region->context_max;
 
     /* Close SHM object */
     ret = na_sm_shm_unmap(NULL, na_sm_region, sizeof(struct na_sm_region));
@@ -2117,10 +2202,11 @@ done:
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
-    bool listen, bool no_wait, uint32_t nofile_max)
+    const struct na_sm_addr_key *addr_key_p, uint8_t context_max, bool listen,
+    bool no_wait, unsigned int poll_flags, bool thread_single,
+    uint32_t nofile_max)
 {
-    static hg_atomic_int32_t sm_id_g = HG_ATOMIC_VAR_INIT(0);
-    struct na_sm_addr_key addr_key = {0, 0};
+    struct na_sm_addr_key addr_key = *addr_key_p;
     struct na_sm_region *shared_region = NULL;
     char uri[NA_SM_MAX_FILENAME], *uri_p = NULL;
     uint8_t queue_pair_idx = 0;
@@ -2129,35 +2215,35 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     int tx_notify = -1, rx_notify = -1;
     na_return_t ret = NA_SUCCESS, err_ret;
 
-    /* Get PID */
-    addr_key.pid = getpid();
-
-    /* Generate new SM ID (TODO fix that to avoid reaching limit) */
-    addr_key.id = ((unsigned int) (hg_atomic_incr32(&sm_id_g) - 1)) & 0xff;
-    NA_CHECK_SUBSYS_ERROR(fatal, addr_key.id > UINT8_MAX, error, ret,
-        NA_OVERFLOW, "Reached maximum number of SM instances for this process");
-
     /* Save listen state */
     na_sm_endpoint->listen = listen;
+    na_sm_endpoint->context_max = context_max;
+    na_sm_endpoint->thread_single = thread_single;
+    na_sm_endpoint->poll_flags = poll_flags;
 
-    NA_LOG_SUBSYS_DEBUG(cls, "Opening new endpoint for PID=%d, ID=%u",
-        addr_key.pid, addr_key.id);
+    NA_LOG_SUBSYS_DEBUG(cls, "Opening new endpoint for PID=%d, ID=%u, CTX=%u",
+        addr_key.pid, addr_key.id, addr_key.ctx_id);
 
     /* Initialize queues */
     STAILQ_INIT(&na_sm_endpoint->unexpected_msg_queue.queue);
     hg_thread_spin_init(&na_sm_endpoint->unexpected_msg_queue.lock);
+    na_sm_endpoint->unexpected_msg_queue.thread_single = thread_single;
 
     TAILQ_INIT(&na_sm_endpoint->unexpected_op_queue.queue);
     hg_thread_spin_init(&na_sm_endpoint->unexpected_op_queue.lock);
+    na_sm_endpoint->unexpected_op_queue.thread_single = thread_single;
 
     TAILQ_INIT(&na_sm_endpoint->expected_op_queue.queue);
     hg_thread_spin_init(&na_sm_endpoint->expected_op_queue.lock);
+    na_sm_endpoint->expected_op_queue.thread_single = thread_single;
 
     TAILQ_INIT(&na_sm_endpoint->retry_op_queue.queue);
     hg_thread_spin_init(&na_sm_endpoint->retry_op_queue.lock);
+    na_sm_endpoint->retry_op_queue.thread_single = thread_single;
 
     /* Initialize number of fds */
     hg_atomic_init32(&na_sm_endpoint->nofile, 0);
+    hg_atomic_init32(&na_sm_endpoint->sleeping, 0);
     na_sm_endpoint->nofile_max = nofile_max;
 
     /* Initialize poll addr list */
@@ -2172,8 +2258,8 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     hg_thread_rwlock_init(&na_sm_endpoint->addr_map.lock);
 
     if (listen) {
-        /* Create URI */
-        if (name) {
+        /* Create URI (context endpoints always derive it from their key) */
+        if (name && addr_key.ctx_id == 0) {
             NA_LOG_SUBSYS_DEBUG(
                 cls, "Using passed endpoint name as URI %s", name);
 
@@ -2201,6 +2287,7 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
 
         /* Keep addr key in shared-region in case URI does not have PID/ID */
         shared_region->addr_key = addr_key;
+        shared_region->context_max = context_max;
 
         /* Reserve queue pair for loopback */
         ret = na_sm_queue_pair_reserve(shared_region, &queue_pair_idx);
@@ -2211,7 +2298,7 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
 
     if (!no_wait) {
         /* Create poll set to wait for events */
-        na_sm_endpoint->poll_set = hg_poll_create();
+        na_sm_endpoint->poll_set = hg_poll_create_opt(poll_flags);
         NA_CHECK_SUBSYS_ERROR(cls, na_sm_endpoint->poll_set == NULL, error, ret,
             na_sm_errno_to_na(errno), "Cannot create poll set");
         hg_atomic_incr32(&na_sm_endpoint->nofile);
@@ -2694,7 +2781,11 @@ na_sm_addr_destroy(struct na_sm_addr *na_sm_addr)
 static NA_INLINE void
 na_sm_addr_ref_incr(struct na_sm_addr *na_sm_addr)
 {
-    hg_atomic_incr32(&na_sm_addr->refcount);
+    if (na_sm_addr->endpoint->thread_single)
+        hg_atomic_set32(
+            &na_sm_addr->refcount, hg_atomic_get32(&na_sm_addr->refcount) + 1);
+    else
+        hg_atomic_incr32(&na_sm_addr->refcount);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2702,8 +2793,15 @@ static void
 na_sm_addr_ref_decr(struct na_sm_addr *na_sm_addr)
 {
     struct na_sm_endpoint *na_sm_endpoint = na_sm_addr->endpoint;
-    int32_t refcount = hg_atomic_decr32(&na_sm_addr->refcount);
-    bool resolved = hg_atomic_get32(&na_sm_addr->status) & NA_SM_ADDR_RESOLVED;
+    int32_t refcount;
+    bool resolved;
+
+    if (na_sm_endpoint->thread_single) {
+        refcount = hg_atomic_get32(&na_sm_addr->refcount) - 1;
+        hg_atomic_set32(&na_sm_addr->refcount, refcount);
+    } else
+        refcount = hg_atomic_decr32(&na_sm_addr->refcount);
+    resolved = hg_atomic_get32(&na_sm_addr->status) & NA_SM_ADDR_RESOLVED;
 
     if (refcount > 0 && !(refcount == 1 && !resolved))
         /* Cannot free yet unless this address was not resolved */
@@ -2765,7 +2863,8 @@ na_sm_addr_resolve(struct na_sm_addr *na_sm_addr)
     cmd_hdr = (union na_sm_cmd_hdr){.hdr.type = NA_SM_RESERVED,
         .hdr.pid = (unsigned int) na_sm_endpoint->source_addr->addr_key.pid,
         .hdr.id = na_sm_endpoint->source_addr->addr_key.id & 0xff,
-        .hdr.pair_idx = na_sm_addr->queue_pair_idx & 0xff};
+        .hdr.pair_idx = na_sm_addr->queue_pair_idx & 0xff,
+        .hdr.ctx_id = na_sm_endpoint->source_addr->addr_key.ctx_id & 0xff};
 
     NA_LOG_SUBSYS_DEBUG(addr, "Pushing cmd with %d for %d/%u/%u val=%" PRIu64,
         cmd_hdr.hdr.type, cmd_hdr.hdr.pid, cmd_hdr.hdr.id, cmd_hdr.hdr.pair_idx,
@@ -2885,7 +2984,9 @@ na_sm_addr_release(struct na_sm_addr *na_sm_addr)
         cmd_hdr = (union na_sm_cmd_hdr){.hdr.type = NA_SM_RELEASED,
             .hdr.pid = (unsigned int) na_sm_endpoint->source_addr->addr_key.pid,
             .hdr.id = na_sm_endpoint->source_addr->addr_key.id & 0xff,
-            .hdr.pair_idx = na_sm_addr->queue_pair_idx & 0xff};
+            .hdr.pair_idx = na_sm_addr->queue_pair_idx & 0xff,
+            .hdr.ctx_id =
+                na_sm_endpoint->source_addr->addr_key.ctx_id & 0xff};
 
         if (na_sm_endpoint->poll_set) {
             /* Send events to remote process (silence error as this is best
@@ -2940,6 +3041,85 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_addr_route(struct na_sm_endpoint *na_sm_endpoint,
+    struct na_sm_addr *na_sm_addr, uint8_t id, struct na_sm_addr **route_p)
+{
+    struct na_sm_addr *source_addr = na_sm_endpoint->source_addr;
+    struct na_sm_addr_key addr_key = na_sm_addr->addr_key,
+                          remote_key = na_sm_addr->addr_key;
+    struct na_sm_addr *route_addr;
+    char uri[NA_SM_MAX_FILENAME];
+    bool self_class;
+    na_return_t ret;
+    int rc;
+
+    /* Unexpected addresses are bound to the queue pair that was reserved by
+     * the remote context, always go through it. Otherwise keep the address
+     * if it was already created by that endpoint for that context. */
+    if (na_sm_addr->unexpected || (na_sm_addr->endpoint == na_sm_endpoint &&
+                                      na_sm_addr->addr_key.ctx_id == id)) {
+        *route_p = na_sm_addr;
+        return NA_SUCCESS;
+    }
+    addr_key.ctx_id = id;
+
+    /* Contexts that do not have their own endpoint are served by the class
+     * endpoint, remote ones are checked once when the route is created */
+    remote_key.ctx_id = 0;
+    self_class = (remote_key.pid == source_addr->addr_key.pid &&
+                  remote_key.id == source_addr->addr_key.id);
+    if (self_class) {
+        if (id < na_sm_endpoint->context_max)
+            remote_key.ctx_id = id;
+        if (remote_key.ctx_id == source_addr->addr_key.ctx_id) {
+            *route_p = source_addr;
+            return NA_SUCCESS;
+        }
+    }
+
+    route_addr = na_sm_addr_map_lookup(&na_sm_endpoint->addr_map, &addr_key);
+    if (route_addr == NULL) {
+        if (id > 0 && !self_class) {
+            uint8_t context_max = 0;
+
+            rc = NA_SM_PRINT_URI(uri, NA_SM_MAX_FILENAME, remote_key);
+            NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || rc > NA_SM_MAX_FILENAME,
+                error, ret, NA_OVERFLOW, "NA_SM_PRINT_URI() failed, rc: %d",
+                rc);
+
+            ret = na_sm_region_get_addr_key(uri, NULL, &context_max);
+            NA_CHECK_SUBSYS_NA_ERROR(addr, error, ret,
+                "Could not retrieve context count from URI (%s)", uri);
+            if (id < context_max)
+                remote_key.ctx_id = id;
+        }
+
+        NA_LOG_SUBSYS_DEBUG(addr,
+            "Creating route to PID=%d, ID=%u, CTX=%u through CTX=%u",
+            addr_key.pid, addr_key.id, id, remote_key.ctx_id);
+
+        /* Connection is keyed by requested context ID but opened to the
+         * remote endpoint that serves it */
+        rc = NA_SM_PRINT_URI(uri, NA_SM_MAX_FILENAME, remote_key);
+        NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || rc > NA_SM_MAX_FILENAME, error,
+            ret, NA_OVERFLOW, "NA_SM_PRINT_URI() failed, rc: %d", rc);
+
+        ret = na_sm_addr_map_insert(na_sm_endpoint, &na_sm_endpoint->addr_map,
+            uri, &addr_key, &route_addr);
+        NA_CHECK_SUBSYS_ERROR(addr, ret != NA_SUCCESS && ret != NA_EXIST,
+            error, ret, ret, "Could not insert new address");
+    }
+
+    *route_p = route_addr;
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_sm_addr_event_send(int sock, const char *dest_name,
@@ -3078,11 +3258,11 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_msg_send(struct na_sm_class *na_sm_class, na_context_t *context,
-    na_cb_type_t cb_type, na_cb_t callback, void *arg, const void *buf,
-    size_t buf_size, struct na_sm_addr *na_sm_addr, na_tag_t tag,
-    struct na_sm_op_id *na_sm_op_id)
+na_sm_msg_send(na_context_t *context, na_cb_type_t cb_type, na_cb_t callback,
+    void *arg, const void *buf, size_t buf_size, struct na_sm_addr *na_sm_addr,
+    uint8_t dest_id, na_tag_t tag, struct na_sm_op_id *na_sm_op_id)
 {
+    struct na_sm_endpoint *na_sm_endpoint = NA_SM_CONTEXT(context)->endpoint;
     na_return_t ret;
 
     NA_CHECK_SUBSYS_ERROR(msg, buf_size > NA_SM_COPY_BUF_SIZE, error, ret,
@@ -3096,6 +3276,11 @@ na_sm_msg_send(struct na_sm_class *na_sm_class, na_context_t *context,
         ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
         na_cb_type_to_string(na_sm_op_id->completion_data.callback_info.type));
 
+    /* Pick queue pair that goes from this context to the target context */
+    ret = na_sm_addr_route(na_sm_endpoint, na_sm_addr, dest_id, &na_sm_addr);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        addr, error, ret, "Could not route address to context %u", dest_id);
+
     NA_SM_OP_RESET(na_sm_op_id, context, cb_type, callback, arg, na_sm_addr);
 
     /* TODO we assume that buf remains valid (safe because we pre-allocate
@@ -3104,15 +3289,15 @@ na_sm_msg_send(struct na_sm_class *na_sm_class, na_context_t *context,
         .buf.const_ptr = buf, .buf_size = buf_size, .tag = tag};
 
     ret = na_sm_msg_send_post(
-        &na_sm_class->endpoint, cb_type, buf, buf_size, na_sm_addr, tag);
+        na_sm_endpoint, cb_type, buf, buf_size, na_sm_addr, tag);
     if (ret == NA_SUCCESS) {
         /* Immediate completion, add directly to completion queue. */
         na_sm_complete(na_sm_op_id, NA_SUCCESS);
 
         /* Notify local completion */
-        na_sm_complete_signal(na_sm_class);
+        na_sm_complete_signal(na_sm_endpoint);
     } else if (ret == NA_AGAIN) {
-        na_sm_op_retry(na_sm_class, na_sm_op_id);
+        na_sm_op_retry(na_sm_endpoint, na_sm_op_id);
         return NA_SUCCESS;
     } else
         NA_CHECK_SUBSYS_NA_ERROR(msg, release, ret, "Could not post msg");
@@ -3172,6 +3357,13 @@ na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint, na_cb_type_t cb_type,
     NA_CHECK_SUBSYS_ERROR(
         msg, rc == false, release, ret, NA_AGAIN, "Full queue");
 
+    /* Only notify if receiver is sleeping, clearing the flag ensures that a
+     * single notification is sent per wait. The push followed by this CAS
+     * pairs with the arming followed by the queue check that the receiver
+     * does in na_sm_endpoint_sleep(), so that no wakeup can be lost. */
+    if (!hg_atomic_cas32(&na_sm_addr->tx_queue->cons_sleeping, 1, 0))
+        return NA_SUCCESS;
+
     /* Notify remote if notifications are enabled */
     if (na_sm_addr == na_sm_endpoint->source_addr &&
         na_sm_addr->rx_notify > 0) {
@@ -3263,8 +3455,8 @@ na_sm_buf_copy_from(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int index,
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_rma(struct na_sm_class *na_sm_class, na_context_t *context,
-    na_cb_type_t cb_type, na_cb_t callback, void *arg,
+na_sm_rma(na_context_t *context, na_cb_type_t cb_type, na_cb_t callback,
+    void *arg,
     na_sm_process_vm_op_t process_vm_op,
     struct na_sm_mem_handle *na_sm_mem_handle_local, na_offset_t local_offset,
     struct na_sm_mem_handle *na_sm_mem_handle_remote, na_offset_t remote_offset,
@@ -3384,7 +3576,7 @@ na_sm_rma(struct na_sm_class *na_sm_class, na_context_t *context,
     na_sm_complete(na_sm_op_id, NA_SUCCESS);
 
     /* Notify local completion */
-    na_sm_complete_signal(na_sm_class);
+    na_sm_complete_signal(NA_SM_CONTEXT(context)->endpoint);
 
     return NA_SUCCESS;
 
@@ -3633,11 +3825,17 @@ na_sm_progress_wait(na_context_t *context,
     na_return_t ret;
     int rc;
 
+    /* Senders only notify sleeping queues, do not block if a message is
+     * already there */
+    if (timeout > 0 && !na_sm_endpoint_sleep(na_sm_endpoint))
+        timeout = 0;
+
     /* Just wait on a single event, anything greater may increase
      * latency, and slow down progress, we will not wait next round
      * if something is still in the queues */
     rc = hg_poll_wait(
         na_sm_endpoint->poll_set, timeout, NA_SM_MAX_EVENTS, events, &nevents);
+    na_sm_endpoint_wake(na_sm_endpoint);
     NA_CHECK_SUBSYS_ERROR(poll, rc != HG_UTIL_SUCCESS, error, ret,
         na_sm_errno_to_na(errno), "hg_poll_wait() failed");
 
@@ -3691,6 +3889,13 @@ na_sm_progress_wait(na_context_t *context,
         count += (unsigned int) (progressed_rx | progressed_notify);
     }
 
+    /* Messages sent while we were not sleeping were not notified */
+    if (count == 0) {
+        ret = na_sm_progress_rx_queues(na_sm_endpoint, &count);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            poll, error, ret, "Could not progress rx queues");
+    }
+
     *count_p = count;
 
     return NA_SUCCESS;
@@ -3702,13 +3907,40 @@ error:
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_sm_progress(struct na_sm_endpoint *na_sm_endpoint, unsigned int *count_p)
+{
+    unsigned int count = 0;
+    na_return_t ret = NA_SUCCESS;
+
+    /* Check whether something is in one of the rx queues */
+    ret = na_sm_progress_rx_queues(na_sm_endpoint, &count);
+    NA_CHECK_SUBSYS_NA_ERROR(poll, done, ret, "Could not progress rx queues");
+
+    /* Look for message in cmd queue (if listening) */
+    if (na_sm_endpoint->source_addr->shared_region) {
+        bool progressed_cmd = false;
+
+        ret = na_sm_progress_cmd_queue(na_sm_endpoint, &progressed_cmd);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            poll, done, ret, "Could not progress cmd queue");
+        count += (unsigned int) progressed_cmd;
+    }
+
+    *count_p = count;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_progress_rx_queues(
+    struct na_sm_endpoint *na_sm_endpoint, unsigned int *count_p)
 {
     struct na_sm_addr_list *poll_addr_list = &na_sm_endpoint->poll_addr_list;
     struct na_sm_addr *poll_addr;
     unsigned int count = 0;
     na_return_t ret = NA_SUCCESS;
 
-    /* Check whether something is in one of the rx queues */
     hg_thread_spin_lock(&poll_addr_list->lock);
     LIST_FOREACH (poll_addr, &poll_addr_list->list, entry) {
         bool progressed_rx = false;
@@ -3725,20 +3957,57 @@ na_sm_progress(struct na_sm_endpoint *na_sm_endpoint, unsigned int *count_p)
     }
     hg_thread_spin_unlock(&poll_addr_list->lock);
 
-    /* Look for message in cmd queue (if listening) */
-    if (na_sm_endpoint->source_addr->shared_region) {
-        bool progressed_cmd = false;
+    *count_p += count;
 
-        ret = na_sm_progress_cmd_queue(na_sm_endpoint, &progressed_cmd);
-        NA_CHECK_SUBSYS_NA_ERROR(
-            poll, done, ret, "Could not progress cmd queue");
-        count += (unsigned int) progressed_cmd;
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+na_sm_endpoint_sleep(struct na_sm_endpoint *na_sm_endpoint)
+{
+    struct na_sm_addr_list *poll_addr_list = &na_sm_endpoint->poll_addr_list;
+    struct na_sm_addr *poll_addr;
+    bool arm = (na_sm_endpoint->poll_set != NULL), empty = true;
+
+    /* Nothing to arm if notifications are not used */
+    if (arm)
+        hg_atomic_set32(&na_sm_endpoint->sleeping, 1);
+
+    /* Arm first, then check, senders push first, then check the flag */
+    hg_thread_spin_lock(&poll_addr_list->lock);
+    LIST_FOREACH (poll_addr, &poll_addr_list->list, entry) {
+        if (arm)
+            hg_atomic_or32(&poll_addr->rx_queue->cons_sleeping, 1);
+        if (!na_sm_msg_queue_is_empty(poll_addr->rx_queue)) {
+            empty = false;
+            break;
+        }
     }
+    hg_thread_spin_unlock(&poll_addr_list->lock);
 
-    *count_p = count;
+    if (!empty)
+        na_sm_endpoint_wake(na_sm_endpoint);
 
-done:
-    return ret;
+    return empty;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_endpoint_wake(struct na_sm_endpoint *na_sm_endpoint)
+{
+    struct na_sm_addr_list *poll_addr_list = &na_sm_endpoint->poll_addr_list;
+    struct na_sm_addr *poll_addr;
+
+    /* Nothing to do if queues were not armed */
+    if (!hg_atomic_cas32(&na_sm_endpoint->sleeping, 1, 0))
+        return;
+
+    hg_thread_spin_lock(&poll_addr_list->lock);
+    LIST_FOREACH (poll_addr, &poll_addr_list->list, entry)
+        hg_atomic_set32(&poll_addr->rx_queue->cons_sleeping, 0);
+    hg_thread_spin_unlock(&poll_addr_list->lock);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -3807,8 +4076,9 @@ na_sm_process_cmd(struct na_sm_endpoint *na_sm_endpoint,
     switch (cmd_hdr.hdr.type) {
         case NA_SM_RESERVED: {
             struct na_sm_addr *na_sm_addr = NULL;
-            struct na_sm_addr_key addr_key = {
-                .pid = (pid_t) cmd_hdr.hdr.pid, .id = cmd_hdr.hdr.id};
+            struct na_sm_addr_key addr_key = {.pid = (pid_t) cmd_hdr.hdr.pid,
+                .id = cmd_hdr.hdr.id,
+                .ctx_id = cmd_hdr.hdr.ctx_id};
 
             /* Allocate source address */
             ret = na_sm_addr_create(
@@ -3866,7 +4136,8 @@ na_sm_process_cmd(struct na_sm_endpoint *na_sm_endpoint,
                 na_sm_addr, &na_sm_endpoint->poll_addr_list.list, entry) {
                 if ((na_sm_addr->queue_pair_idx == cmd_hdr.hdr.pair_idx) &&
                     (na_sm_addr->addr_key.pid == (pid_t) cmd_hdr.hdr.pid) &&
-                    (na_sm_addr->addr_key.id == cmd_hdr.hdr.id)) {
+                    (na_sm_addr->addr_key.id == cmd_hdr.hdr.id) &&
+                    (na_sm_addr->addr_key.ctx_id == cmd_hdr.hdr.ctx_id)) {
                     found = true;
                     break;
                 }
@@ -3982,13 +4253,13 @@ na_sm_process_unexpected(struct na_sm_op_queue *unexpected_op_queue,
     NA_LOG_SUBSYS_DEBUG(msg, "Processing unexpected msg");
 
     /* Pop op ID from queue */
-    hg_thread_spin_lock(&unexpected_op_queue->lock);
+    NA_SM_QUEUE_LOCK(unexpected_op_queue);
     na_sm_op_id = TAILQ_FIRST(&unexpected_op_queue->queue);
     if (likely(na_sm_op_id)) {
         TAILQ_REMOVE(&unexpected_op_queue->queue, na_sm_op_id, entry);
-        hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
+        na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_QUEUED);
     }
-    hg_thread_spin_unlock(&unexpected_op_queue->lock);
+    NA_SM_QUEUE_UNLOCK(unexpected_op_queue);
 
     if (likely(na_sm_op_id)) {
         /* Fill info */
@@ -4048,10 +4319,10 @@ na_sm_process_unexpected(struct na_sm_op_queue *unexpected_op_queue,
 
         /* Otherwise push the unexpected message into our unexpected queue so
          * that we can treat it later when a recv_unexpected is posted */
-        hg_thread_spin_lock(&unexpected_msg_queue->lock);
+        NA_SM_QUEUE_LOCK(unexpected_msg_queue);
         STAILQ_INSERT_TAIL(
             &unexpected_msg_queue->queue, na_sm_unexpected_info, entry);
-        hg_thread_spin_unlock(&unexpected_msg_queue->lock);
+        NA_SM_QUEUE_UNLOCK(unexpected_msg_queue);
     }
 
 done:
@@ -4072,16 +4343,16 @@ na_sm_process_expected(struct na_sm_op_queue *expected_op_queue,
     NA_LOG_SUBSYS_DEBUG(msg, "Processing expected msg");
 
     /* Try to match addr/tag */
-    hg_thread_spin_lock(&expected_op_queue->lock);
+    NA_SM_QUEUE_LOCK(expected_op_queue);
     TAILQ_FOREACH (na_sm_op_id, &expected_op_queue->queue, entry) {
         if (na_sm_op_id->addr == poll_addr &&
             na_sm_op_id->info.msg.tag == msg_hdr.hdr.tag) {
             TAILQ_REMOVE(&expected_op_queue->queue, na_sm_op_id, entry);
-            hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
+            na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_QUEUED);
             break;
         }
     }
-    hg_thread_spin_unlock(&expected_op_queue->lock);
+    NA_SM_QUEUE_UNLOCK(expected_op_queue);
 
     /* If a message arrives without any OP ID being posted, drop it */
     if (na_sm_op_id == NULL) {
@@ -4122,16 +4393,16 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint)
     na_return_t ret = NA_SUCCESS;
 
     do {
-        hg_thread_spin_lock(&op_queue->lock);
+        NA_SM_QUEUE_LOCK(op_queue);
         na_sm_op_id = TAILQ_FIRST(&op_queue->queue);
         if (!na_sm_op_id) {
-            hg_thread_spin_unlock(&op_queue->lock);
+            NA_SM_QUEUE_UNLOCK(op_queue);
             /* Queue is empty */
             break;
         }
         /* We won't try to cancel an op that's being retried */
-        hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_RETRYING);
-        hg_thread_spin_unlock(&op_queue->lock);
+        na_sm_op_status_or(na_sm_op_id, NA_SM_OP_RETRYING);
+        NA_SM_QUEUE_UNLOCK(op_queue);
 
         NA_LOG_SUBSYS_DEBUG(op, "Attempting to retry %p", (void *) na_sm_op_id);
 
@@ -4142,12 +4413,12 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint)
             na_sm_op_id->addr, na_sm_op_id->info.msg.tag);
         if (ret == NA_SUCCESS) {
             /* Succeeded, cannot cancel anymore */
-            hg_thread_spin_lock(&op_queue->lock);
-            hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_RETRYING);
+            NA_SM_QUEUE_LOCK(op_queue);
+            na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_RETRYING);
 
             TAILQ_REMOVE(&op_queue->queue, na_sm_op_id, entry);
-            hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
-            hg_thread_spin_unlock(&op_queue->lock);
+            na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_QUEUED);
+            NA_SM_QUEUE_UNLOCK(op_queue);
 
             /* Immediate completion, add directly to completion queue. */
             na_sm_complete(na_sm_op_id, NA_SUCCESS);
@@ -4155,15 +4426,15 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint)
             bool canceled = false;
 
             /* Check if it was canceled in the meantime */
-            hg_thread_spin_lock(&op_queue->lock);
-            hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_RETRYING);
+            NA_SM_QUEUE_LOCK(op_queue);
+            na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_RETRYING);
 
             if (hg_atomic_get32(&na_sm_op_id->status) & NA_SM_OP_CANCELED) {
                 TAILQ_REMOVE(&op_queue->queue, na_sm_op_id, entry);
-                hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
+                na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_QUEUED);
                 canceled = true;
             }
-            hg_thread_spin_unlock(&op_queue->lock);
+            NA_SM_QUEUE_UNLOCK(op_queue);
 
             if (canceled)
                 na_sm_complete(na_sm_op_id, NA_CANCELED);
@@ -4171,13 +4442,13 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint)
         } else {
             NA_LOG_SUBSYS_ERROR(msg, "Could not post msg send operation");
             /* Force internal completion in error mode */
-            hg_thread_spin_lock(&op_queue->lock);
-            hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_RETRYING);
-            hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_ERRORED);
+            NA_SM_QUEUE_LOCK(op_queue);
+            na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_RETRYING);
+            na_sm_op_status_or(na_sm_op_id, NA_SM_OP_ERRORED);
 
             TAILQ_REMOVE(&op_queue->queue, na_sm_op_id, entry);
-            hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
-            hg_thread_spin_unlock(&op_queue->lock);
+            na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_QUEUED);
+            NA_SM_QUEUE_UNLOCK(op_queue);
 
             na_sm_complete(na_sm_op_id, ret);
             break; /* Better to return early ? */
@@ -4189,19 +4460,19 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint)
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE void
-na_sm_op_retry(struct na_sm_class *na_sm_class, struct na_sm_op_id *na_sm_op_id)
+na_sm_op_retry(
+    struct na_sm_endpoint *na_sm_endpoint, struct na_sm_op_id *na_sm_op_id)
 {
-    struct na_sm_op_queue *retry_op_queue =
-        &na_sm_class->endpoint.retry_op_queue;
+    struct na_sm_op_queue *retry_op_queue = &na_sm_endpoint->retry_op_queue;
 
     NA_LOG_SUBSYS_DEBUG(op, "Pushing %p for retry (%s)", (void *) na_sm_op_id,
         na_cb_type_to_string(na_sm_op_id->completion_data.callback_info.type));
 
     /* Push op ID to retry queue */
-    hg_thread_spin_lock(&retry_op_queue->lock);
+    NA_SM_QUEUE_LOCK(retry_op_queue);
     TAILQ_INSERT_TAIL(&retry_op_queue->queue, na_sm_op_id, entry);
-    hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_QUEUED);
-    hg_thread_spin_unlock(&retry_op_queue->lock);
+    na_sm_op_status_or(na_sm_op_id, NA_SM_OP_QUEUED);
+    NA_SM_QUEUE_UNLOCK(retry_op_queue);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4209,7 +4480,7 @@ static NA_INLINE void
 na_sm_complete(struct na_sm_op_id *na_sm_op_id, na_return_t cb_ret)
 {
     /* Mark op id as completed before checking for cancelation */
-    hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_COMPLETED);
+    na_sm_op_status_or(na_sm_op_id, NA_SM_OP_COMPLETED);
 
     /* Set callback ret */
     na_sm_op_id->completion_data.callback_info.ret = cb_ret;
@@ -4220,10 +4491,50 @@ na_sm_complete(struct na_sm_op_id *na_sm_op_id, na_return_t cb_ret)
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE void
-na_sm_complete_signal(struct na_sm_class *na_sm_class)
+na_sm_queue_lock(hg_thread_spin_t *lock, bool thread_single)
+    HG_LOCK_NO_THREAD_SAFETY_ANALYSIS
+{
+    if (!thread_single)
+        hg_thread_spin_lock(lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_sm_queue_unlock(hg_thread_spin_t *lock, bool thread_single)
+    HG_LOCK_NO_THREAD_SAFETY_ANALYSIS
+{
+    if (!thread_single)
+        hg_thread_spin_unlock(lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_sm_op_status_or(struct na_sm_op_id *na_sm_op_id, int32_t bits)
+{
+    if (na_sm_op_id->thread_single)
+        hg_atomic_set32(
+            &na_sm_op_id->status, hg_atomic_get32(&na_sm_op_id->status) | bits);
+    else
+        hg_atomic_or32(&na_sm_op_id->status, bits);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_sm_op_status_and(struct na_sm_op_id *na_sm_op_id, int32_t bits)
+{
+    if (na_sm_op_id->thread_single)
+        hg_atomic_set32(
+            &na_sm_op_id->status, hg_atomic_get32(&na_sm_op_id->status) & bits);
+    else
+        hg_atomic_and32(&na_sm_op_id->status, bits);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_sm_complete_signal(struct na_sm_endpoint *na_sm_endpoint)
 {
-    if (na_sm_class->endpoint.source_addr->tx_notify > 0) {
-        int rc = hg_event_set(na_sm_class->endpoint.source_addr->tx_notify);
+    if (na_sm_endpoint->source_addr->tx_notify > 0) {
+        int rc = hg_event_set(na_sm_endpoint->source_addr->tx_notify);
         NA_CHECK_SUBSYS_ERROR_DONE(
             op, rc != HG_UTIL_SUCCESS, "Could not signal completion");
     }
@@ -4290,8 +4601,10 @@ static na_return_t
 na_sm_initialize(
     na_class_t *na_class, const struct na_info *na_info, bool listen)
 {
+    static hg_atomic_int32_t sm_id_g = HG_ATOMIC_VAR_INIT(0);
     const struct na_init_info *na_init_info = &na_info->na_init_info;
     struct na_sm_class *na_sm_class = NULL;
+    struct na_sm_addr_key addr_key = {.pid = getpid(), .id = 0, .ctx_id = 0};
     struct rlimit rlimit;
     na_return_t ret;
     int rc;
@@ -4317,11 +4630,21 @@ na_sm_initialize(
 #else
     na_sm_class->iov_max = 1;
 #endif
-    na_sm_class->context_max = na_init_info->max_contexts;
+    /* Contexts other than 0 only get their own endpoint if more than one
+     * context was requested, otherwise they share the class endpoint */
+    na_sm_class->context_max =
+        (na_init_info->max_contexts > 1) ? na_init_info->max_contexts : 1;
+
+    /* Generate new SM ID (TODO fix that to avoid reaching limit) */
+    addr_key.id = ((unsigned int) (hg_atomic_incr32(&sm_id_g) - 1)) & 0xff;
 
     /* Open endpoint */
     ret = na_sm_endpoint_open(&na_sm_class->endpoint, na_info->host_name,
-        listen, na_init_info->progress_mode & NA_NO_BLOCK,
+        &addr_key, na_sm_class->context_max, listen,
+        na_init_info->progress_mode & NA_NO_BLOCK,
+        (na_init_info->progress_mode & NA_POLL_IO_URING) ? HG_POLL_IO_URING : 0,
+        (na_init_info->thread_mode & NA_THREAD_MODE_SINGLE) ==
+            NA_THREAD_MODE_SINGLE,
         (uint32_t) rlimit.rlim_cur);
     NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not open endpoint");
 
@@ -4359,26 +4682,79 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_context_create(
-    na_class_t NA_UNUSED *na_class, void **context_p, uint8_t NA_UNUSED id)
+na_sm_context_create(na_class_t *na_class, void **context_p, uint8_t id)
 {
-    na_return_t ret = NA_SUCCESS;
+    struct na_sm_class *na_sm_class = NA_SM_CLASS(na_class);
+    struct na_sm_endpoint *class_endpoint = &na_sm_class->endpoint;
+    struct na_sm_context *na_sm_context = NULL;
+    struct na_sm_addr_key addr_key;
+    na_return_t ret;
 
-    *context_p = malloc(sizeof(struct na_sm_context));
-    NA_CHECK_SUBSYS_ERROR(ctx, *context_p == NULL, done, ret, NA_NOMEM,
+    na_sm_context =
+        (struct na_sm_context *) calloc(1, sizeof(struct na_sm_context));
+    NA_CHECK_SUBSYS_ERROR(ctx, na_sm_context == NULL, error, ret, NA_NOMEM,
         "Could not allocate SM private context");
 
-done:
+    /* If only one context is used, just point to class' endpoint */
+    if (id == 0 || na_sm_class->context_max == 1) {
+        na_sm_context->endpoint = class_endpoint;
+        *context_p = (void *) na_sm_context;
+
+        return NA_SUCCESS;
+    }
+
+    NA_CHECK_SUBSYS_ERROR(fatal, id >= na_sm_class->context_max, error, ret,
+        NA_OPNOTSUPPORTED, "context id %" PRIu8 ", max_contexts %" PRIu8, id,
+        na_sm_class->context_max);
+
+    na_sm_context->endpoint =
+        (struct na_sm_endpoint *) calloc(1, sizeof(struct na_sm_endpoint));
+    NA_CHECK_SUBSYS_ERROR(ctx, na_sm_context->endpoint == NULL, error, ret,
+        NA_NOMEM, "Could not allocate SM context endpoint");
+
+    /* Each context gets its own region, queue pairs and op queues */
+    addr_key = class_endpoint->source_addr->addr_key;
+    addr_key.ctx_id = id;
+    ret = na_sm_endpoint_open(na_sm_context->endpoint, NULL, &addr_key,
+        na_sm_class->context_max, class_endpoint->listen,
+        class_endpoint->poll_set == NULL, class_endpoint->poll_flags,
+        class_endpoint->thread_single,
+        class_endpoint->nofile_max);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        ctx, error, ret, "Could not open endpoint for context %" PRIu8, id);
+
+    *context_p = (void *) na_sm_context;
+
+    return NA_SUCCESS;
+
+error:
+    if (na_sm_context) {
+        free(na_sm_context->endpoint);
+        free(na_sm_context);
+    }
+
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_context_destroy(na_class_t NA_UNUSED *na_class, void *context)
+na_sm_context_destroy(na_class_t *na_class, void *context)
 {
-    free(context);
+    struct na_sm_context *na_sm_context = (struct na_sm_context *) context;
+    na_return_t ret;
+
+    if (na_sm_context->endpoint != &NA_SM_CLASS(na_class)->endpoint) {
+        ret = na_sm_endpoint_close(na_sm_context->endpoint);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            ctx, error, ret, "Could not close context endpoint");
+        free(na_sm_context->endpoint);
+    }
+    free(na_sm_context);
 
     return NA_SUCCESS;
+
+error:
+    return ret;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4411,6 +4787,7 @@ na_sm_op_create(na_class_t *na_class, unsigned long NA_UNUSED flags)
     memset(na_sm_op_id, 0, sizeof(struct na_sm_op_id));
 
     na_sm_op_id->na_class = na_class;
+    na_sm_op_id->thread_single = NA_SM_CLASS(na_class)->endpoint.thread_single;
 
     /* Completed by default */
     hg_atomic_init32(&na_sm_op_id->status, NA_SM_OP_COMPLETED);
@@ -4669,24 +5046,25 @@ na_sm_msg_get_max_tag(const na_class_t NA_UNUSED *na_class)
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_msg_send_unexpected(na_class_t *na_class, na_context_t *context,
+na_sm_msg_send_unexpected(na_class_t NA_UNUSED *na_class, na_context_t *context,
     na_cb_t callback, void *arg, const void *buf, size_t buf_size,
-    void NA_UNUSED *plugin_data, na_addr_t *dest_addr,
-    uint8_t NA_UNUSED dest_id, na_tag_t tag, na_op_id_t *op_id)
+    void NA_UNUSED *plugin_data, na_addr_t *dest_addr, uint8_t dest_id,
+    na_tag_t tag, na_op_id_t *op_id)
 {
-    return na_sm_msg_send(NA_SM_CLASS(na_class), context, NA_CB_SEND_UNEXPECTED,
-        callback, arg, buf, buf_size, (struct na_sm_addr *) dest_addr, tag,
+    return na_sm_msg_send(context, NA_CB_SEND_UNEXPECTED, callback, arg, buf,
+        buf_size, (struct na_sm_addr *) dest_addr, dest_id, tag,
         (struct na_sm_op_id *) op_id);
 }
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
-    na_cb_t callback, void *arg, void *buf, size_t buf_size,
-    void NA_UNUSED *plugin_data, na_op_id_t *op_id)
+na_sm_msg_recv_unexpected(na_class_t NA_UNUSED *na_class,
+    na_context_t *context, na_cb_t callback, void *arg, void *buf,
+    size_t buf_size, void NA_UNUSED *plugin_data, na_op_id_t *op_id)
 {
+    struct na_sm_endpoint *na_sm_endpoint = NA_SM_CONTEXT(context)->endpoint;
     struct na_sm_unexpected_msg_queue *unexpected_msg_queue =
-        &NA_SM_CLASS(na_class)->endpoint.unexpected_msg_queue;
+        &na_sm_endpoint->unexpected_msg_queue;
     struct na_sm_unexpected_info *na_sm_unexpected_info;
     struct na_sm_op_id *na_sm_op_id = (struct na_sm_op_id *) op_id;
     na_return_t ret;
@@ -4709,11 +5087,11 @@ na_sm_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
         (struct na_sm_msg_info){.buf.ptr = buf, .buf_size = buf_size, .tag = 0};
 
     /* Look for an unexpected message already received */
-    hg_thread_spin_lock(&unexpected_msg_queue->lock);
+    NA_SM_QUEUE_LOCK(unexpected_msg_queue);
     na_sm_unexpected_info = STAILQ_FIRST(&unexpected_msg_queue->queue);
     if (na_sm_unexpected_info != NULL)
         STAILQ_REMOVE_HEAD(&unexpected_msg_queue->queue, entry);
-    hg_thread_spin_unlock(&unexpected_msg_queue->lock);
+    NA_SM_QUEUE_UNLOCK(unexpected_msg_queue);
 
     if (unlikely(na_sm_unexpected_info)) {
         /* Fill unexpected info */
@@ -4734,16 +5112,16 @@ na_sm_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
         na_sm_complete(na_sm_op_id, NA_SUCCESS);
 
         /* Notify local completion */
-        na_sm_complete_signal(NA_SM_CLASS(na_class));
+        na_sm_complete_signal(na_sm_endpoint);
     } else {
         struct na_sm_op_queue *unexpected_op_queue =
-            &NA_SM_CLASS(na_class)->endpoint.unexpected_op_queue;
+            &na_sm_endpoint->unexpected_op_queue;
 
         /* Nothing has been received yet so add op_id to progress queue */
-        hg_thread_spin_lock(&unexpected_op_queue->lock);
+        NA_SM_QUEUE_LOCK(unexpected_op_queue);
         TAILQ_INSERT_TAIL(&unexpected_op_queue->queue, na_sm_op_id, entry);
-        hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_QUEUED);
-        hg_thread_spin_unlock(&unexpected_op_queue->lock);
+        na_sm_op_status_or(na_sm_op_id, NA_SM_OP_QUEUED);
+        NA_SM_QUEUE_UNLOCK(unexpected_op_queue);
     }
 
     return NA_SUCCESS;
@@ -4759,25 +5137,24 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_msg_send_expected(na_class_t *na_class, na_context_t *context,
+na_sm_msg_send_expected(na_class_t NA_UNUSED *na_class, na_context_t *context,
     na_cb_t callback, void *arg, const void *buf, size_t buf_size,
-    void NA_UNUSED *plugin_data, na_addr_t *dest_addr,
-    uint8_t NA_UNUSED dest_id, na_tag_t tag, na_op_id_t *op_id)
+    void NA_UNUSED *plugin_data, na_addr_t *dest_addr, uint8_t dest_id,
+    na_tag_t tag, na_op_id_t *op_id)
 {
-    return na_sm_msg_send(NA_SM_CLASS(na_class), context, NA_CB_SEND_EXPECTED,
-        callback, arg, buf, buf_size, (struct na_sm_addr *) dest_addr, tag,
+    return na_sm_msg_send(context, NA_CB_SEND_EXPECTED, callback, arg, buf,
+        buf_size, (struct na_sm_addr *) dest_addr, dest_id, tag,
         (struct na_sm_op_id *) op_id);
 }
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_msg_recv_expected(na_class_t *na_class, na_context_t *context,
+na_sm_msg_recv_expected(na_class_t NA_UNUSED *na_class, na_context_t *context,
     na_cb_t callback, void *arg, void *buf, size_t buf_size,
-    void NA_UNUSED *plugin_data, na_addr_t *source_addr,
-    uint8_t NA_UNUSED source_id, na_tag_t tag, na_op_id_t *op_id)
+    void NA_UNUSED *plugin_data, na_addr_t *source_addr, uint8_t source_id,
+    na_tag_t tag, na_op_id_t *op_id)
 {
-    struct na_sm_op_queue *expected_op_queue =
-        &NA_SM_CLASS(na_class)->endpoint.expected_op_queue;
+    struct na_sm_op_queue *expected_op_queue;
     struct na_sm_op_id *na_sm_op_id = (struct na_sm_op_id *) op_id;
     struct na_sm_addr *na_sm_addr = (struct na_sm_addr *) source_addr;
     na_return_t ret;
@@ -4793,6 +5170,14 @@ na_sm_msg_recv_expected(na_class_t *na_class, na_context_t *context,
         ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
         na_cb_type_to_string(na_sm_op_id->completion_data.callback_info.type));
 
+    /* Message will arrive on the queue pair used to send to source context,
+     * the op must be queued on the endpoint that polls it */
+    ret = na_sm_addr_route(NA_SM_CONTEXT(context)->endpoint, na_sm_addr,
+        source_id, &na_sm_addr);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        addr, error, ret, "Could not route address to context %u", source_id);
+    expected_op_queue = &na_sm_addr->endpoint->expected_op_queue;
+
     NA_SM_OP_RESET(
         na_sm_op_id, context, NA_CB_RECV_EXPECTED, callback, arg, na_sm_addr);
 
@@ -4804,10 +5189,10 @@ na_sm_msg_recv_expected(na_class_t *na_class, na_context_t *context,
     /* Expected messages must always be pre-posted, therefore a message should
      * never arrive before that call returns (not completes), simply add
      * op_id to queue */
-    hg_thread_spin_lock(&expected_op_queue->lock);
+    NA_SM_QUEUE_LOCK(expected_op_queue);
     TAILQ_INSERT_TAIL(&expected_op_queue->queue, na_sm_op_id, entry);
-    hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_QUEUED);
-    hg_thread_spin_unlock(&expected_op_queue->lock);
+    na_sm_op_status_or(na_sm_op_id, NA_SM_OP_QUEUED);
+    NA_SM_QUEUE_UNLOCK(expected_op_queue);
 
     return NA_SUCCESS;
 
@@ -5008,14 +5393,13 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE na_return_t
-na_sm_put(na_class_t *na_class, na_context_t *context, na_cb_t callback,
-    void *arg, na_mem_handle_t *local_mem_handle, na_offset_t local_offset,
-    na_mem_handle_t *remote_mem_handle, na_offset_t remote_offset,
-    size_t length, na_addr_t *remote_addr, uint8_t NA_UNUSED remote_id,
-    na_op_id_t *op_id)
+na_sm_put(na_class_t NA_UNUSED *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, na_mem_handle_t *local_mem_handle,
+    na_offset_t local_offset, na_mem_handle_t *remote_mem_handle,
+    na_offset_t remote_offset, size_t length, na_addr_t *remote_addr,
+    uint8_t NA_UNUSED remote_id, na_op_id_t *op_id)
 {
-    return na_sm_rma(NA_SM_CLASS(na_class), context, NA_CB_PUT, callback, arg,
-        na_sm_process_vm_writev, (struct na_sm_mem_handle *) local_mem_handle,
+    return na_sm_rma(context, NA_CB_PUT, callback, arg, na_sm_process_vm_writev, (struct na_sm_mem_handle *) local_mem_handle,
         local_offset, (struct na_sm_mem_handle *) remote_mem_handle,
         remote_offset, length, (struct na_sm_addr *) remote_addr,
         (struct na_sm_op_id *) op_id);
@@ -5023,14 +5407,13 @@ na_sm_put(na_class_t *na_class, na_context_t *context, na_cb_t callback,
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE na_return_t
-na_sm_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
-    void *arg, na_mem_handle_t *local_mem_handle, na_offset_t local_offset,
-    na_mem_handle_t *remote_mem_handle, na_offset_t remote_offset,
-    size_t length, na_addr_t *remote_addr, uint8_t NA_UNUSED remote_id,
-    na_op_id_t *op_id)
+na_sm_get(na_class_t NA_UNUSED *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, na_mem_handle_t *local_mem_handle,
+    na_offset_t local_offset, na_mem_handle_t *remote_mem_handle,
+    na_offset_t remote_offset, size_t length, na_addr_t *remote_addr,
+    uint8_t NA_UNUSED remote_id, na_op_id_t *op_id)
 {
-    return na_sm_rma(NA_SM_CLASS(na_class), context, NA_CB_GET, callback, arg,
-        na_sm_process_vm_readv, (struct na_sm_mem_handle *) local_mem_handle,
+    return na_sm_rma(context, NA_CB_GET, callback, arg, na_sm_process_vm_readv, (struct na_sm_mem_handle *) local_mem_handle,
         local_offset, (struct na_sm_mem_handle *) remote_mem_handle,
         remote_offset, length, (struct na_sm_addr *) remote_addr,
         (struct na_sm_op_id *) op_id);
@@ -5038,12 +5421,13 @@ na_sm_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE int
-na_sm_poll_get_fd(na_class_t *na_class, na_context_t NA_UNUSED *context)
+na_sm_poll_get_fd(na_class_t NA_UNUSED *na_class, na_context_t *context)
 {
+    struct na_sm_endpoint *na_sm_endpoint = NA_SM_CONTEXT(context)->endpoint;
     int fd = -1;
 
-    if (NA_SM_CLASS(na_class)->endpoint.poll_set) {
-        fd = hg_poll_get_fd(NA_SM_CLASS(na_class)->endpoint.poll_set);
+    if (na_sm_endpoint->poll_set) {
+        fd = hg_poll_get_fd(na_sm_endpoint->poll_set);
         NA_CHECK_SUBSYS_ERROR_NORET(
             poll, fd == -1, done, "Could not get poll fd from poll set");
     }
@@ -5054,37 +5438,35 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE bool
-na_sm_poll_try_wait(na_class_t *na_class, na_context_t NA_UNUSED *context)
+na_sm_poll_try_wait(na_class_t NA_UNUSED *na_class, na_context_t *context)
 {
-    struct na_sm_endpoint *na_sm_endpoint = &NA_SM_CLASS(na_class)->endpoint;
-    struct na_sm_addr *na_sm_addr;
+    struct na_sm_endpoint *na_sm_endpoint = NA_SM_CONTEXT(context)->endpoint;
     bool empty = false;
 
-    /* Check whether something is in one of the rx queues */
-    hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
-    LIST_FOREACH (na_sm_addr, &na_sm_endpoint->poll_addr_list.list, entry) {
-        if (!na_sm_msg_queue_is_empty(na_sm_addr->rx_queue)) {
-            hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
-            return false;
-        }
-    }
-    hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
-
     /* Check whether something is in the retry queue */
-    hg_thread_spin_lock(&na_sm_endpoint->retry_op_queue.lock);
+    NA_SM_QUEUE_LOCK(&na_sm_endpoint->retry_op_queue);
     empty = TAILQ_EMPTY(&na_sm_endpoint->retry_op_queue.queue);
-    hg_thread_spin_unlock(&na_sm_endpoint->retry_op_queue.lock);
+    NA_SM_QUEUE_UNLOCK(&na_sm_endpoint->retry_op_queue);
     if (!empty)
         return false;
 
-    return true;
+    /* Caller blocks on the poll fd without calling hg_poll_wait() */
+    if (na_sm_endpoint->poll_set &&
+        hg_poll_rearm(na_sm_endpoint->poll_set) != HG_UTIL_SUCCESS)
+        return false;
+
+    /* Check whether something is in one of the rx queues, caller is going to
+     * block on the poll fd so ask senders to notify us (cleared on next
+     * progress call) */
+    return na_sm_endpoint_sleep(na_sm_endpoint);
 }
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_poll(na_class_t *na_class, na_context_t *context, unsigned int *count_p)
+na_sm_poll(
+    na_class_t NA_UNUSED *na_class, na_context_t *context, unsigned int *count_p)
 {
-    struct na_sm_endpoint *na_sm_endpoint = &NA_SM_CLASS(na_class)->endpoint;
+    struct na_sm_endpoint *na_sm_endpoint = NA_SM_CONTEXT(context)->endpoint;
     unsigned int count = 0;
     na_return_t ret;
 
@@ -5101,7 +5483,7 @@ na_sm_poll(na_class_t *na_class, na_context_t *context, unsigned int *count_p)
     }
 
     /* Process retries */
-    ret = na_sm_process_retries(&NA_SM_CLASS(na_class)->endpoint);
+    ret = na_sm_process_retries(na_sm_endpoint);
     NA_CHECK_SUBSYS_NA_ERROR(
         poll, error, ret, "Could not process retried msgs");
 
@@ -5116,10 +5498,10 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_poll_wait(na_class_t *na_class, na_context_t *context,
+na_sm_poll_wait(na_class_t NA_UNUSED *na_class, na_context_t *context,
     unsigned int timeout_ms, unsigned int *count_p)
 {
-    struct na_sm_endpoint *na_sm_endpoint = &NA_SM_CLASS(na_class)->endpoint;
+    struct na_sm_endpoint *na_sm_endpoint = NA_SM_CONTEXT(context)->endpoint;
     hg_time_t deadline, now = hg_time_from_ms(0);
     na_return_t ret;
 
@@ -5144,7 +5526,7 @@ na_sm_poll_wait(na_class_t *na_class, na_context_t *context,
         }
 
         /* Process retries */
-        ret = na_sm_process_retries(&NA_SM_CLASS(na_class)->endpoint);
+        ret = na_sm_process_retries(na_sm_endpoint);
         NA_CHECK_SUBSYS_NA_ERROR(
             poll, error, ret, "Could not process retried msgs");
 
@@ -5167,8 +5549,9 @@ error:
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_sm_cancel(
-    na_class_t *na_class, na_context_t NA_UNUSED *context, na_op_id_t *op_id)
+    na_class_t NA_UNUSED *na_class, na_context_t *context, na_op_id_t *op_id)
 {
+    struct na_sm_endpoint *na_sm_endpoint = NA_SM_CONTEXT(context)->endpoint;
     struct na_sm_op_id *na_sm_op_id = (struct na_sm_op_id *) op_id;
     struct na_sm_op_queue *op_queue = NULL;
     int32_t status;
@@ -5187,16 +5570,16 @@ na_sm_cancel(
     switch (na_sm_op_id->completion_data.callback_info.type) {
         case NA_CB_RECV_UNEXPECTED:
             /* Must remove op_id from unexpected op queue */
-            op_queue = &NA_SM_CLASS(na_class)->endpoint.unexpected_op_queue;
+            op_queue = &na_sm_endpoint->unexpected_op_queue;
             break;
         case NA_CB_RECV_EXPECTED:
-            /* Must remove op_id from unexpected op queue */
-            op_queue = &NA_SM_CLASS(na_class)->endpoint.expected_op_queue;
+            /* Must remove op_id from queue of endpoint polling its address */
+            op_queue = &na_sm_op_id->addr->endpoint->expected_op_queue;
             break;
         case NA_CB_SEND_UNEXPECTED:
         case NA_CB_SEND_EXPECTED:
             /* Must remove op_id from retry op queue */
-            op_queue = &NA_SM_CLASS(na_class)->endpoint.retry_op_queue;
+            op_queue = &na_sm_endpoint->retry_op_queue;
             break;
         case NA_CB_PUT:
         case NA_CB_GET:
@@ -5208,29 +5591,30 @@ na_sm_cancel(
                 na_sm_op_id->completion_data.callback_info.type);
     }
 
-    /* Remove op id from queue it is on */
+    /* Remove op id from queue it is on (cancel is called from the progressing
+     * thread in single-threaded mode, as any other operation) */
     if (op_queue) {
         bool canceled = false;
 
-        hg_thread_spin_lock(&op_queue->lock);
+        NA_SM_QUEUE_LOCK(op_queue);
         if (hg_atomic_get32(&na_sm_op_id->status) & NA_SM_OP_QUEUED) {
-            hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_CANCELED);
+            na_sm_op_status_or(na_sm_op_id, NA_SM_OP_CANCELED);
 
             /* If being retried by process_retries() in the meantime, we'll just
              * let it cancel there */
             if (!(hg_atomic_get32(&na_sm_op_id->status) & NA_SM_OP_RETRYING)) {
                 TAILQ_REMOVE(&op_queue->queue, na_sm_op_id, entry);
-                hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
+                na_sm_op_status_and(na_sm_op_id, ~NA_SM_OP_QUEUED);
                 canceled = true;
             }
         }
-        hg_thread_spin_unlock(&op_queue->lock);
+        NA_SM_QUEUE_UNLOCK(op_queue);
 
         /* Cancel op id */
         if (canceled) {
             na_sm_complete(na_sm_op_id, NA_CANCELED);
 
-            na_sm_complete_signal(NA_SM_CLASS(na_class));
+            na_sm_complete_signal(na_sm_endpoint);
         }
     }
 
@@ -250,8 +250,9 @@ typedef void (*na_cb_t)(const struct na_cb_info *callback_info);
 #define NA_MEM_READWRITE  0x03
 
 /* Progress modes */
-#define NA_NO_BLOCK 0x01 /*!< no blocking progress */
-#define NA_NO_RETRY 0x02 /*!< no retry of operations in progress */
+#define NA_NO_BLOCK      0x01 /*!< no blocking progress */
+#define NA_NO_RETRY      0x02 /*!< no retry of operations in progress */
+#define NA_POLL_IO_URING 0x04 /*!< plugin waits with io_uring if supported */
 
 /* Thread modes (default is thread-safe) */
 #define NA_THREAD_MODE_SINGLE_CLS                                              \
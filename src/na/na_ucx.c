@@ -53,6 +53,19 @@
 #define NA_UCX_MEM_CHUNK_COUNT (256)
 #define NA_UCX_MEM_BLOCK_COUNT (2)
 
+/* Max number of segments per memory handle (each segment has its own rkey
+ * and adds to the serialized size of the handle) */
+#define NA_UCX_MEM_SEGMENT_MAX (16)
+
+/* Number of IOV entries that do not require allocation for RMA */
+#define NA_UCX_IOV_STATIC_MAX (8)
+
+/* Multi-recv completion queue size (must be a power of 2) */
+#define NA_UCX_OP_MULTI_CQ_SIZE (256)
+
+/* Alignment of messages copied into multi-recv buffers */
+#define NA_UCX_MULTI_RECV_ALIGN (8)
+
 /* Addr status bits */
 #define NA_UCX_ADDR_RESOLVED (1 << 0)
 
@@ -130,14 +143,17 @@
 struct na_ucx_addr {
     STAILQ_ENTRY(na_ucx_addr) entry;   /* Entry in addr pool */
     struct sockaddr_storage ss_addr;   /* Sock addr */
-    ucs_sock_addr_t addr_key;          /* Address key */
-    struct na_ucx_class *na_ucx_class; /* NA UCX class */
-    ucp_address_t *worker_addr;        /* Worker addr */
-    size_t worker_addr_len;            /* Worker addr len */
-    bool worker_addr_alloc;            /* Worker addr was allocated by us */
-    ucp_ep_h ucp_ep;                   /* Currently only one EP per address */
-    hg_atomic_int32_t refcount;        /* Reference counter */
-    hg_atomic_int32_t status;          /* Connection state */
+    ucs_sock_addr_t addr_key;            /* Address key */
+    struct na_ucx_class *na_ucx_class;   /* NA UCX class */
+    struct na_ucx_worker *na_ucx_worker; /* Worker the EP belongs to */
+    ucp_address_t *worker_addr;          /* Worker addr */
+    size_t worker_addr_len;              /* Worker addr len */
+    bool worker_addr_alloc;              /* Worker addr was allocated by us */
+    ucp_ep_h ucp_ep;                     /* Currently only one EP per address */
+    hg_atomic_int32_t refcount;          /* Reference counter */
+    hg_atomic_int32_t status;            /* Connection state */
+    uint8_t id;                          /* Remote context ID */
+    bool routable; /* Listener address that can be routed to other contexts */
 };
 
 /* Map (used to cache addresses) */
@@ -151,10 +167,28 @@ struct na_ucx_map {
 NA_PACKED(struct na_ucx_mem_desc {
     uint64_t base;          /* Base address */
     uint64_t len;           /* Size of region */
-    uint64_t rkey_buf_size; /* Cached rkey buf size */
+    uint64_t rkey_buf_size; /* Cached rkey buf size (all segments) */
+    uint64_t iovcnt;        /* Segment count */
     uint8_t flags;          /* Flag of operation access */
 });
 
+/* Segment descriptor (only serialized when there is more than one) */
+NA_PACKED(struct na_ucx_mem_seg_desc {
+    uint64_t base;          /* Base address */
+    uint64_t len;           /* Size of segment */
+    uint64_t rkey_buf_size; /* Packed rkey size */
+});
+
+/* Memory segment */
+struct na_ucx_mem_seg {
+    struct na_ucx_mem_seg_desc desc; /* Segment descriptor */
+    union {
+        ucp_mem_h mem;   /* UCP mem handle */
+        ucp_rkey_h rkey; /* UCP rkey handle */
+    } ucp_mr;
+    void *rkey_buf; /* Packed rkey buf */
+};
+
 /* Handle type */
 enum na_ucx_mem_handle_type {
     NA_UCX_MEM_HANDLE_LOCAL,
@@ -165,13 +199,11 @@ enum na_ucx_mem_handle_type {
 /* Memory handle */
 struct na_ucx_mem_handle {
     struct na_ucx_mem_desc desc;        /* Memory descriptor */
+    struct na_ucx_mem_seg seg;          /* Storage for single segment */
+    struct na_ucx_mem_seg *segs;        /* Segments (points to seg if one) */
     hg_thread_mutex_t rkey_unpack_lock; /* Unpack lock */
-    union {
-        ucp_mem_h mem;   /* UCP mem handle */
-        ucp_rkey_h rkey; /* UCP rkey handle */
-    } ucp_mr;
-    void *rkey_buf;         /* Cached rkey buf */
-    hg_atomic_int32_t type; /* Handle type (local / remote) */
+    struct na_ucx_worker *rkey_worker;  /* Worker rkeys were unpacked for */
+    hg_atomic_int32_t type;             /* Handle type (local / remote) */
 };
 
 /* Msg info */
@@ -181,25 +213,40 @@ struct na_ucx_msg_info {
         void *ptr;
     } buf;
     size_t buf_size;
+    size_t buf_offset; /* Space already consumed (multi-recv) */
     ucp_tag_t tag;
 };
 
 /* UCP RMA op (put/get) */
-typedef na_return_t (*na_ucp_rma_op_t)(ucp_ep_h ep, void *buf, size_t buf_size,
-    uint64_t remote_addr, ucp_rkey_h rkey, void *request);
+typedef na_return_t (*na_ucp_rma_op_t)(ucp_ep_h ep, void *buf, size_t count,
+    ucp_datatype_t datatype, uint64_t remote_addr, ucp_rkey_h rkey,
+    void *request, void *user_data);
 
 /* RMA info */
 struct na_ucx_rma_info {
-    na_ucp_rma_op_t ucp_rma_op;
-    void *buf;
-    size_t buf_size;
-    uint64_t remote_addr;
-    ucp_rkey_h remote_key;
+    union {
+        ucp_dt_iov_t s[NA_UCX_IOV_STATIC_MAX]; /* Static local segments */
+        ucp_dt_iov_t *d;                       /* Allocated local segments */
+    } local_iov_storage;
+    ucp_dt_iov_t *local_iov;   /* Local segments (non-contiguous transfers) */
+    hg_atomic_int32_t pending; /* Sub-operations left to complete */
+    hg_atomic_int32_t ret;     /* First error returned by sub-operations */
+    bool sub_ops; /* One UCP request per remote segment was posted */
+};
+
+/* Multi-event completion data */
+struct na_ucx_completion_multi {
+    struct na_cb_completion_data *data;
+    hg_atomic_int32_t head;
+    hg_atomic_int32_t tail;
+    int32_t mask;
+    uint32_t size;
 };
 
 /* Operation ID */
 struct na_ucx_op_id {
-    struct na_cb_completion_data completion_data; /* Completion data    */
+    struct na_cb_completion_data completion_data;    /* Completion data  */
+    struct na_ucx_completion_multi completion_multi; /* Multi-event data */
     union {
         struct na_ucx_msg_info msg;
         struct na_ucx_rma_info rma;
@@ -208,6 +255,7 @@ struct na_ucx_op_id {
     na_context_t *context;           /* NA context associated    */
     struct na_ucx_addr *addr;        /* Address associated       */
     hg_atomic_int32_t status;        /* Operation status         */
+    bool multi_event;                /* Generates multiple events */
 };
 
 /* Addr pool */
@@ -238,24 +286,40 @@ struct na_ucx_op_queue {
     hg_thread_spin_t lock;
 };
 
-/* UCX class */
-struct na_ucx_class {
+/* UCX worker (class worker or context worker) */
+struct na_ucx_worker {
     struct na_ucx_unexpected_msg_queue
         unexpected_msg_queue;                   /* Unexpected msg queue */
     struct na_ucx_map addr_map;                 /* Address map */
     struct na_ucx_op_queue unexpected_op_queue; /* Unexpected op queue */
-    struct na_ucx_addr_pool addr_pool;          /* Addr pool */
-    ucp_context_h ucp_context;                  /* UCP context */
-    ucp_worker_h ucp_worker;                    /* Shared UCP worker */
-    ucp_listener_h ucp_listener;   /* Listener handle if listening */
-    struct na_ucx_addr *self_addr; /* Self address */
-    struct hg_mem_pool *mem_pool;  /* Msg buf pool */
-    size_t ucp_request_size;       /* Size of UCP requests */
-    char *protocol_name;           /* Protocol used */
-    size_t unexpected_size_max;    /* Max unexpected size */
-    size_t expected_size_max;      /* Max expected size */
-    hg_atomic_int32_t ncontexts;   /* Number of contexts */
-    bool no_wait;                  /* Wait disabled */
+    struct na_ucx_op_queue multi_op_queue;      /* Multi-recv op queue */
+    hg_atomic_int32_t multi_op_count;           /* Number of multi-recv ops */
+    struct na_ucx_class *na_ucx_class;          /* NA UCX class */
+    ucp_worker_h ucp_worker;                    /* UCP worker */
+    ucp_listener_h ucp_listener; /* Listener handle if listening */
+    uint8_t id;                  /* Context ID */
+};
+
+/* UCX context */
+struct na_ucx_context {
+    struct na_ucx_worker *na_ucx_worker; /* Class or context worker */
+};
+
+/* UCX class */
+struct na_ucx_class {
+    struct na_ucx_worker worker;         /* Class worker (context 0) */
+    struct na_ucx_addr_pool addr_pool;   /* Addr pool */
+    ucp_context_h ucp_context;           /* UCP context */
+    struct na_ucx_addr *self_addr;       /* Self address */
+    struct hg_mem_pool *mem_pool;        /* Msg buf pool */
+    size_t ucp_request_size;             /* Size of UCP requests */
+    char *protocol_name;                 /* Protocol used */
+    size_t unexpected_size_max;          /* Max unexpected size */
+    size_t expected_size_max;            /* Max expected size */
+    hg_atomic_int32_t ncontexts;         /* Number of contexts */
+    ucs_thread_mode_t worker_thread_mode; /* Thread mode of workers */
+    uint8_t context_max;                 /* Max number of contexts */
+    bool no_wait;                        /* Wait disabled */
 };
 
 /* Datatype used for printing info */
@@ -495,7 +559,7 @@ na_ucp_am_send_cb(
  */
 static void
 na_ucp_am_recv(
-    struct na_ucx_class *na_ucx_class, struct na_ucx_op_id *na_ucx_op_id);
+    struct na_ucx_worker *na_ucx_worker, struct na_ucx_op_id *na_ucx_op_id);
 
 /**
  * Recv active message callback.
@@ -532,18 +596,20 @@ na_ucp_msg_recv_cb(void *request, ucs_status_t status,
     const ucp_tag_recv_info_t *info, void *user_data);
 
 /**
- * RMA put.
+ * RMA put. If request is NULL, the request is allocated by UCP and the
+ * operation is tracked as a sub-operation of user_data.
  */
 static na_return_t
-na_ucp_put(ucp_ep_h ep, void *buf, size_t buf_size, uint64_t remote_addr,
-    ucp_rkey_h rkey, void *request);
+na_ucp_put(ucp_ep_h ep, void *buf, size_t count, ucp_datatype_t datatype,
+    uint64_t remote_addr, ucp_rkey_h rkey, void *request, void *user_data);
 
 /**
- * RMA get.
+ * RMA get. If request is NULL, the request is allocated by UCP and the
+ * operation is tracked as a sub-operation of user_data.
  */
 static na_return_t
-na_ucp_get(ucp_ep_h ep, void *buf, size_t buf_size, uint64_t remote_addr,
-    ucp_rkey_h rkey, void *request);
+na_ucp_get(ucp_ep_h ep, void *buf, size_t count, ucp_datatype_t datatype,
+    uint64_t remote_addr, ucp_rkey_h rkey, void *request, void *user_data);
 
 /**
  * RMA callback.
@@ -551,6 +617,12 @@ na_ucp_get(ucp_ep_h ep, void *buf, size_t buf_size, uint64_t remote_addr,
 static void
 na_ucp_rma_cb(void *request, ucs_status_t status, void *user_data);
 
+/**
+ * RMA sub-operation callback.
+ */
+static void
+na_ucp_rma_sub_cb(void *request, ucs_status_t status, void *user_data);
+
 /*---------------------------------------------------------------------------*/
 /* NA UCX helpers                                                            */
 /*---------------------------------------------------------------------------*/
@@ -567,6 +639,27 @@ na_ucx_class_alloc(void);
 static void
 na_ucx_class_free(struct na_ucx_class *na_ucx_class);
 
+/**
+ * Open worker, its address map and its unexpected queues.
+ */
+static na_return_t
+na_ucx_worker_open(struct na_ucx_class *na_ucx_class, uint8_t id,
+    struct na_ucx_worker *na_ucx_worker);
+
+/**
+ * Close worker and free remaining addresses.
+ */
+static void
+na_ucx_worker_close(struct na_ucx_worker *na_ucx_worker);
+
+/**
+ * Add offset to the port of a sockaddr. Context N of a listening class
+ * listens on the port of context 0 + N.
+ */
+static na_return_t
+na_ucx_sockaddr_offset_port(
+    struct sockaddr_storage *ss_addr, int offset, socklen_t *addrlen_p);
+
 /**
  * Parse hostname info.
  */
@@ -598,16 +691,15 @@ na_ucx_addr_map_lookup(
  * Insert new addr using addr_key (if it does not already exist).
  */
 static na_return_t
-na_ucx_addr_map_insert(struct na_ucx_class *na_ucx_class,
-    struct na_ucx_map *na_ucx_map, ucs_sock_addr_t *addr_key,
-    ucp_conn_request_h conn_request, struct na_ucx_addr **na_ucx_addr_p);
+na_ucx_addr_map_insert(struct na_ucx_worker *na_ucx_worker,
+    ucs_sock_addr_t *addr_key, ucp_conn_request_h conn_request, uint8_t id,
+    struct na_ucx_addr **na_ucx_addr_p);
 
 /**
  * Update addr with new EP information.
  */
 static na_return_t
-na_ucx_addr_map_update(struct na_ucx_class *na_ucx_class,
-    struct na_ucx_map *na_ucx_map, struct na_ucx_addr *na_ucx_addr);
+na_ucx_addr_map_update(struct na_ucx_addr *na_ucx_addr);
 
 /**
  * Remove addr from map using addr_key.
@@ -670,8 +762,8 @@ na_ucx_addr_reset(struct na_ucx_addr *na_ucx_addr, ucs_sock_addr_t *addr_key);
  * Create address.
  */
 static na_return_t
-na_ucx_addr_create(struct na_ucx_class *na_ucx_class, ucs_sock_addr_t *addr_key,
-    struct na_ucx_addr **na_ucx_addr_p);
+na_ucx_addr_create(struct na_ucx_worker *na_ucx_worker,
+    ucs_sock_addr_t *addr_key, struct na_ucx_addr **na_ucx_addr_p);
 
 /**
  * Increment ref count.
@@ -685,6 +777,17 @@ na_ucx_addr_ref_incr(struct na_ucx_addr *na_ucx_addr);
 static NA_INLINE void
 na_ucx_addr_ref_decr(struct na_ucx_addr *na_ucx_addr);
 
+/**
+ * Return the address that reaches context id of the remote from this worker.
+ * Addresses that were looked up are connected again from this worker to the
+ * listener of the remote context and cached in the worker's address map,
+ * other addresses are returned as is.
+ */
+static na_return_t
+na_ucx_addr_route(struct na_ucx_worker *na_ucx_worker,
+    struct na_ucx_addr *na_ucx_addr, uint8_t id,
+    struct na_ucx_addr **routed_addr_p);
+
 /**
  * Allocate unexpected info.
  */
@@ -702,19 +805,45 @@ na_ucx_unexpected_info_free(
  * Post RMA operation.
  */
 static na_return_t
-na_ucx_rma(struct na_ucx_class *na_ucx_class, na_context_t *context,
-    na_cb_type_t cb_type, na_cb_t callback, void *arg,
-    struct na_ucx_mem_handle *local_mem_handle, na_offset_t local_offset,
-    struct na_ucx_mem_handle *remote_mem_handle, na_offset_t remote_offset,
-    size_t length, struct na_ucx_addr *na_ucx_addr,
-    struct na_ucx_op_id *na_ucx_op_id);
+na_ucx_rma(na_context_t *context, na_cb_type_t cb_type, na_cb_t callback,
+    void *arg, struct na_ucx_mem_handle *local_mem_handle,
+    na_offset_t local_offset, struct na_ucx_mem_handle *remote_mem_handle,
+    na_offset_t remote_offset, size_t length, struct na_ucx_addr *na_ucx_addr,
+    uint8_t remote_id, struct na_ucx_op_id *na_ucx_op_id);
 
 /**
- * Resolve RMA remote key.
+ * Resolve RMA remote keys of all segments.
  */
 static na_return_t
-na_ucx_rma_key_resolve(ucp_ep_h ep, struct na_ucx_mem_handle *na_ucx_mem_handle,
-    ucp_rkey_h *rkey_p);
+na_ucx_rma_key_resolve(struct na_ucx_addr *na_ucx_addr,
+    struct na_ucx_mem_handle *na_ucx_mem_handle);
+
+/**
+ * Get segment index and offset within that segment from handle offset.
+ */
+static NA_INLINE void
+na_ucx_mem_seg_get_index_offset(const struct na_ucx_mem_seg *segs,
+    size_t iovcnt, na_offset_t offset, size_t *seg_index_p,
+    na_offset_t *seg_offset_p);
+
+/**
+ * Get number of segments spanned by len bytes starting at index/offset.
+ */
+static NA_INLINE size_t
+na_ucx_mem_seg_get_count(const struct na_ucx_mem_seg *segs, size_t iovcnt,
+    size_t seg_index, na_offset_t seg_offset, size_t len);
+
+/**
+ * Release local IOV of RMA operation.
+ */
+static NA_INLINE void
+na_ucx_rma_iov_free(struct na_ucx_rma_info *na_ucx_rma_info);
+
+/**
+ * Free segments of memory handle.
+ */
+static void
+na_ucx_mem_segs_free(struct na_ucx_mem_handle *na_ucx_mem_handle);
 
 /**
  * Complete UCX operation.
@@ -728,6 +857,56 @@ na_ucx_complete(struct na_ucx_op_id *na_ucx_op_id, na_return_t cb_ret);
 static NA_INLINE void
 na_ucx_release(void *arg);
 
+/**
+ * Copy an unexpected message into the first posted multi-recv buffer and
+ * complete one event of that operation. Returns false if no buffer could
+ * take the message.
+ */
+static bool
+na_ucx_multi_recv_deliver(struct na_ucx_worker *na_ucx_worker,
+    const void *data, size_t length, ucp_tag_t tag,
+    struct na_ucx_addr *source_addr);
+
+/**
+ * Move messages left in the unexpected msg queue into multi-recv buffers.
+ */
+static void
+na_ucx_multi_recv_drain(struct na_ucx_worker *na_ucx_worker);
+
+/**
+ * Complete one event of a multi-event operation.
+ */
+static void
+na_ucx_complete_multi(struct na_ucx_op_id *na_ucx_op_id,
+    struct na_cb_completion_data *completion_data, bool complete,
+    na_return_t cb_ret);
+
+/**
+ * Release completion data of multi-event operation.
+ */
+static NA_INLINE void
+na_ucx_release_multi(void *arg);
+
+/**
+ * Allocate/free completion data ring of multi-event operation.
+ */
+static na_return_t
+na_ucx_completion_multi_init(
+    struct na_ucx_completion_multi *completion_multi, unsigned int count);
+
+static void
+na_ucx_completion_multi_destroy(
+    struct na_ucx_completion_multi *completion_multi);
+
+/**
+ * Push/pop completion data of multi-event operation.
+ */
+static struct na_cb_completion_data *
+na_ucx_completion_multi_push(struct na_ucx_completion_multi *completion_multi);
+
+static void
+na_ucx_completion_multi_pop(struct na_ucx_completion_multi *completion_multi);
+
 /********************/
 /* Plugin callbacks */
 /********************/
@@ -750,6 +929,18 @@ na_ucx_initialize(
 static na_return_t
 na_ucx_finalize(na_class_t *na_class);
 
+/* has_opt_feature */
+static bool
+na_ucx_has_opt_feature(na_class_t *na_class, unsigned long flags);
+
+/* context_create */
+static na_return_t
+na_ucx_context_create(na_class_t *na_class, void **context_p, uint8_t id);
+
+/* context_destroy */
+static na_return_t
+na_ucx_context_destroy(na_class_t *na_class, void *context);
+
 /* op_create */
 static na_op_id_t *
 na_ucx_op_create(na_class_t *na_class, unsigned long flags);
@@ -835,6 +1026,12 @@ na_ucx_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
     na_cb_t callback, void *arg, void *buf, size_t buf_size, void *plugin_data,
     na_op_id_t *op_id);
 
+/* msg_multi_recv_unexpected */
+static na_return_t
+na_ucx_msg_multi_recv_unexpected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, void *buf, size_t buf_size, void *plugin_data,
+    na_op_id_t *op_id);
+
 /* msg_send_expected */
 static na_return_t
 na_ucx_msg_send_expected(na_class_t *na_class, na_context_t *context,
@@ -853,6 +1050,11 @@ static na_return_t
 na_ucx_mem_handle_create(na_class_t *na_class, void *buf, size_t buf_size,
     unsigned long flags, na_mem_handle_t **mem_handle_p);
 
+static na_return_t
+na_ucx_mem_handle_create_segments(na_class_t *na_class,
+    struct na_segment *segments, size_t segment_count, unsigned long flags,
+    na_mem_handle_t **mem_handle_p);
+
 static void
 na_ucx_mem_handle_free(na_class_t *na_class, na_mem_handle_t *mem_handle);
 
@@ -922,9 +1124,9 @@ NA_PLUGIN const struct na_class_ops NA_PLUGIN_OPS(ucx) = {
     na_ucx_initialize,                    /* initialize */
     na_ucx_finalize,                      /* finalize */
     NULL,                                 /* cleanup */
-    NULL,                                 /* has_opt_feature */
-    NULL,                                 /* context_create */
-    NULL,                                 /* context_destroy */
+    na_ucx_has_opt_feature,               /* has_opt_feature */
+    na_ucx_context_create,                /* context_create */
+    na_ucx_context_destroy,               /* context_destroy */
     na_ucx_op_create,                     /* op_create */
     na_ucx_op_destroy,                    /* op_destroy */
     na_ucx_addr_lookup,                   /* addr_lookup */
@@ -948,12 +1150,12 @@ NA_PLUGIN const struct na_class_ops NA_PLUGIN_OPS(ucx) = {
     NULL,                                 /* msg_init_unexpected */
     na_ucx_msg_send_unexpected,           /* msg_send_unexpected */
     na_ucx_msg_recv_unexpected,           /* msg_recv_unexpected */
-    NULL,                                 /* msg_multi_recv_unexpected */
+    na_ucx_msg_multi_recv_unexpected,     /* msg_multi_recv_unexpected */
     NULL,                                 /* msg_init_expected */
     na_ucx_msg_send_expected,             /* msg_send_expected */
     na_ucx_msg_recv_expected,             /* msg_recv_expected */
     na_ucx_mem_handle_create,             /* mem_handle_create */
-    NULL,                                 /* mem_handle_create_segment */
+    na_ucx_mem_handle_create_segments,    /* mem_handle_create_segment */
     na_ucx_mem_handle_free,               /* mem_handle_free */
     na_ucx_mem_handle_get_max_segments,   /* mem_handle_get_max_segments */
     na_ucx_mem_register,                  /* mem_register */
@@ -1669,7 +1871,7 @@ na_ucp_listener_destroy(ucp_listener_h listener)
 static void
 na_ucp_listener_conn_cb(ucp_conn_request_h conn_request, void *arg)
 {
-    struct na_ucx_class *na_ucx_class = (struct na_ucx_class *) arg;
+    struct na_ucx_worker *na_ucx_worker = (struct na_ucx_worker *) arg;
     ucp_conn_request_attr_t conn_request_attrs = {
         .field_mask = UCP_CONN_REQUEST_ATTR_FIELD_CLIENT_ADDR};
     struct na_ucx_addr *na_ucx_addr = NULL;
@@ -1690,13 +1892,13 @@ na_ucp_listener_conn_cb(ucp_conn_request_h conn_request, void *arg)
     addr_key = (ucs_sock_addr_t){
         .addr = (const struct sockaddr *) &conn_request_attrs.client_address,
         .addrlen = sizeof(conn_request_attrs.client_address)};
-    na_ucx_addr = na_ucx_addr_map_lookup(&na_ucx_class->addr_map, &addr_key);
+    na_ucx_addr = na_ucx_addr_map_lookup(&na_ucx_worker->addr_map, &addr_key);
     NA_CHECK_SUBSYS_ERROR_NORET(addr, na_ucx_addr != NULL, error,
         "An entry is already present for this address");
 
     /* Insert new entry and create new address */
-    na_ret = na_ucx_addr_map_insert(na_ucx_class, &na_ucx_class->addr_map,
-        &addr_key, conn_request, &na_ucx_addr);
+    na_ret = na_ucx_addr_map_insert(
+        na_ucx_worker, &addr_key, conn_request, 0, &na_ucx_addr);
     NA_CHECK_SUBSYS_NA_ERROR(
         addr, error, na_ret, "Could not insert new address");
 
@@ -2010,10 +2212,10 @@ done:
 /*---------------------------------------------------------------------------*/
 static void
 na_ucp_am_recv(
-    struct na_ucx_class *na_ucx_class, struct na_ucx_op_id *na_ucx_op_id)
+    struct na_ucx_worker *na_ucx_worker, struct na_ucx_op_id *na_ucx_op_id)
 {
     struct na_ucx_unexpected_msg_queue *unexpected_msg_queue =
-        &na_ucx_class->unexpected_msg_queue;
+        &na_ucx_worker->unexpected_msg_queue;
     struct na_ucx_unexpected_info *na_ucx_unexpected_info;
 
     /* Look for an unexpected message already received */
@@ -2025,7 +2227,7 @@ na_ucp_am_recv(
 
     if (likely(na_ucx_unexpected_info == NULL)) {
         struct na_ucx_op_queue *unexpected_op_queue =
-            &na_ucx_class->unexpected_op_queue;
+            &na_ucx_worker->unexpected_op_queue;
 
         /* Nothing has been received yet so add op_id to progress queue */
         hg_thread_spin_lock(&unexpected_op_queue->lock);
@@ -2050,7 +2252,7 @@ na_ucp_am_recv(
         if (!na_ucx_unexpected_info->data_alloc &&
             na_ucx_unexpected_info->length > 0) {
             ucp_am_data_release(
-                na_ucx_class->ucp_worker, na_ucx_unexpected_info->data);
+                na_ucx_worker->ucp_worker, na_ucx_unexpected_info->data);
         }
         na_ucx_unexpected_info_free(na_ucx_unexpected_info);
 
@@ -2063,9 +2265,9 @@ static ucs_status_t
 na_ucp_am_recv_cb(void *arg, const void *header, size_t header_length,
     void *data, size_t length, const ucp_am_recv_param_t *param)
 {
-    struct na_ucx_class *na_ucx_class = (struct na_ucx_class *) arg;
+    struct na_ucx_worker *na_ucx_worker = (struct na_ucx_worker *) arg;
     struct na_ucx_op_queue *unexpected_op_queue =
-        &na_ucx_class->unexpected_op_queue;
+        &na_ucx_worker->unexpected_op_queue;
     struct na_ucx_op_id *na_ucx_op_id = NULL;
     struct na_ucx_addr *source_addr = NULL;
     ucp_tag_t tag;
@@ -2085,11 +2287,17 @@ na_ucp_am_recv_cb(void *arg, const void *header, size_t header_length,
 
     /* Look up addr */
     source_addr =
-        na_ucx_addr_ep_lookup(&na_ucx_class->addr_map, param->reply_ep);
+        na_ucx_addr_ep_lookup(&na_ucx_worker->addr_map, param->reply_ep);
     NA_CHECK_SUBSYS_ERROR(addr, source_addr == NULL, error, ret,
         UCS_ERR_INVALID_PARAM,
         "No entry found for previously inserted src addr");
 
+    /* Copy into multi-recv buffer if any was posted */
+    if (hg_atomic_get32(&na_ucx_worker->multi_op_count) > 0 &&
+        na_ucx_multi_recv_deliver(
+            na_ucx_worker, data, length, tag, source_addr))
+        return UCS_OK;
+
     /* Pop op ID from queue */
     hg_thread_spin_lock(&unexpected_op_queue->lock);
     na_ucx_op_id = TAILQ_FIRST(&unexpected_op_queue->queue);
@@ -2116,7 +2324,7 @@ na_ucp_am_recv_cb(void *arg, const void *header, size_t header_length,
         return UCS_OK;
     } else {
         struct na_ucx_unexpected_msg_queue *unexpected_msg_queue =
-            &na_ucx_class->unexpected_msg_queue;
+            &na_ucx_worker->unexpected_msg_queue;
         struct na_ucx_unexpected_info *na_ucx_unexpected_info = NULL;
         bool data_alloc = !(param->recv_attr & UCP_AM_RECV_ATTR_FLAG_DATA);
 
@@ -2295,23 +2503,27 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucp_put(ucp_ep_h ep, void *buf, size_t buf_size, uint64_t remote_addr,
-    ucp_rkey_h rkey, void *request)
+na_ucp_put(ucp_ep_h ep, void *buf, size_t count, ucp_datatype_t datatype,
+    uint64_t remote_addr, ucp_rkey_h rkey, void *request, void *user_data)
 {
     const ucp_request_param_t rma_params = {
-        .op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_REQUEST,
-        .cb = {.send = na_ucp_rma_cb},
-        .request = request};
+        .op_attr_mask =
+            UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_DATATYPE |
+            ((request) ? UCP_OP_ATTR_FIELD_REQUEST : UCP_OP_ATTR_FIELD_USER_DATA),
+        .cb = {.send = (request) ? na_ucp_rma_cb : na_ucp_rma_sub_cb},
+        .datatype = datatype,
+        .request = request,
+        .user_data = user_data};
     ucs_status_ptr_t status_ptr;
     na_return_t ret;
 
-    status_ptr = ucp_put_nbx(ep, buf, buf_size, remote_addr, rkey, &rma_params);
+    status_ptr = ucp_put_nbx(ep, buf, count, remote_addr, rkey, &rma_params);
     if (status_ptr == NULL) {
         /* Check for immediate completion */
         NA_LOG_SUBSYS_DEBUG(rma, "ucp_put_nbx() completed immediately");
 
         /* Directly execute callback */
-        na_ucp_rma_cb(request, UCS_OK, NULL);
+        rma_params.cb.send(request, UCS_OK, user_data);
     } else
         NA_CHECK_SUBSYS_ERROR(rma, UCS_PTR_IS_ERR(status_ptr), error, ret,
             na_ucs_status_to_na(UCS_PTR_STATUS(status_ptr)),
@@ -2328,23 +2540,27 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucp_get(ucp_ep_h ep, void *buf, size_t buf_size, uint64_t remote_addr,
-    ucp_rkey_h rkey, void *request)
+na_ucp_get(ucp_ep_h ep, void *buf, size_t count, ucp_datatype_t datatype,
+    uint64_t remote_addr, ucp_rkey_h rkey, void *request, void *user_data)
 {
     const ucp_request_param_t rma_params = {
-        .op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_REQUEST,
-        .cb = {.send = na_ucp_rma_cb},
-        .request = request};
+        .op_attr_mask =
+            UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_DATATYPE |
+            ((request) ? UCP_OP_ATTR_FIELD_REQUEST : UCP_OP_ATTR_FIELD_USER_DATA),
+        .cb = {.send = (request) ? na_ucp_rma_cb : na_ucp_rma_sub_cb},
+        .datatype = datatype,
+        .request = request,
+        .user_data = user_data};
     ucs_status_ptr_t status_ptr;
     na_return_t ret;
 
-    status_ptr = ucp_get_nbx(ep, buf, buf_size, remote_addr, rkey, &rma_params);
+    status_ptr = ucp_get_nbx(ep, buf, count, remote_addr, rkey, &rma_params);
     if (status_ptr == NULL) {
         /* Check for immediate completion */
         NA_LOG_SUBSYS_DEBUG(rma, "ucp_get_nbx() completed immediately");
 
         /* Directly execute callback */
-        na_ucp_rma_cb(request, UCS_OK, NULL);
+        rma_params.cb.send(request, UCS_OK, user_data);
     } else
         NA_CHECK_SUBSYS_ERROR(rma, UCS_PTR_IS_ERR(status_ptr), error, ret,
             na_ucs_status_to_na(UCS_PTR_STATUS(status_ptr)),
@@ -2378,9 +2594,43 @@ na_ucp_rma_cb(void *request, ucs_status_t status, void NA_UNUSED *user_data)
             "na_ucp_rma_cb() failed (%s)", ucs_status_string(status));
 
 done:
+    na_ucx_rma_iov_free(&na_ucx_op_id->info.rma);
     na_ucx_complete(na_ucx_op_id, cb_ret);
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+na_ucp_rma_sub_cb(void *request, ucs_status_t status, void *user_data)
+{
+    struct na_ucx_op_id *na_ucx_op_id = (struct na_ucx_op_id *) user_data;
+    struct na_ucx_rma_info *na_ucx_rma_info = &na_ucx_op_id->info.rma;
+
+    NA_LOG_SUBSYS_DEBUG(
+        rma, "ucp_put/get_nbx() completed (%s)", ucs_status_string(status));
+
+    /* Request was allocated by UCP (NULL if completed immediately) */
+    if (request != NULL)
+        ucp_request_free(request);
+
+    /* Only keep first error */
+    if (status != UCS_OK) {
+        na_return_t cb_ret = (status == UCS_ERR_CANCELED)
+                                 ? NA_CANCELED
+                                 : na_ucs_status_to_na(status);
+
+        NA_LOG_SUBSYS_ERROR(
+            rma, "na_ucp_rma_sub_cb() failed (%s)", ucs_status_string(status));
+        hg_atomic_cas32(
+            &na_ucx_rma_info->ret, (int32_t) NA_SUCCESS, (int32_t) cb_ret);
+    }
+
+    if (hg_atomic_decr32(&na_ucx_rma_info->pending) == 0) {
+        na_ucx_rma_iov_free(na_ucx_rma_info);
+        na_ucx_complete(
+            na_ucx_op_id, (na_return_t) hg_atomic_get32(&na_ucx_rma_info->ret));
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 static struct na_ucx_class *
 na_ucx_class_alloc(void)
@@ -2392,41 +2642,12 @@ na_ucx_class_alloc(void)
     NA_CHECK_SUBSYS_ERROR_NORET(cls, na_ucx_class == NULL, error,
         "Could not allocate NA private data class");
 
-    /* Init table lock */
-    rc = hg_thread_rwlock_init(&na_ucx_class->addr_map.lock);
-    NA_CHECK_SUBSYS_ERROR_NORET(
-        cls, rc != HG_UTIL_SUCCESS, error, "hg_thread_rwlock_init() failed");
-
-    /* Initialize unexpected op queue */
-    rc = hg_thread_spin_init(&na_ucx_class->unexpected_op_queue.lock);
-    NA_CHECK_SUBSYS_ERROR_NORET(
-        cls, rc != HG_UTIL_SUCCESS, error, "hg_thread_spin_init() failed");
-    TAILQ_INIT(&na_ucx_class->unexpected_op_queue.queue);
-
-    /* Initialize unexpected msg queue */
-    rc = hg_thread_spin_init(&na_ucx_class->unexpected_msg_queue.lock);
-    NA_CHECK_SUBSYS_ERROR_NORET(
-        cls, rc != HG_UTIL_SUCCESS, error, "hg_thread_spin_init() failed");
-    STAILQ_INIT(&na_ucx_class->unexpected_msg_queue.queue);
-
     /* Initialize addr pool */
     rc = hg_thread_spin_init(&na_ucx_class->addr_pool.lock);
     NA_CHECK_SUBSYS_ERROR_NORET(
         cls, rc != HG_UTIL_SUCCESS, error, "hg_thread_spin_init() failed");
     STAILQ_INIT(&na_ucx_class->addr_pool.queue);
 
-    /* Create address map */
-    na_ucx_class->addr_map.key_map =
-        hg_hash_table_new(na_ucx_addr_key_hash, na_ucx_addr_key_equal);
-    NA_CHECK_SUBSYS_ERROR_NORET(cls, na_ucx_class->addr_map.key_map == NULL,
-        error, "Could not allocate key map");
-
-    /* Create connection map */
-    na_ucx_class->addr_map.ep_map =
-        hg_hash_table_new(na_ucx_addr_ep_hash, na_ucx_addr_ep_equal);
-    NA_CHECK_SUBSYS_ERROR_NORET(cls, na_ucx_class->addr_map.ep_map == NULL,
-        error, "Could not allocate EP handle map");
-
     return na_ucx_class;
 
 error:
@@ -2446,27 +2667,157 @@ na_ucx_class_free(struct na_ucx_class *na_ucx_class)
 
     if (na_ucx_class->self_addr)
         na_ucx_addr_destroy(na_ucx_class->self_addr);
-    if (na_ucx_class->ucp_listener)
-        na_ucp_listener_destroy(na_ucx_class->ucp_listener);
-    if (na_ucx_class->ucp_worker)
-        na_ucp_worker_destroy(na_ucx_class->ucp_worker);
+    if (na_ucx_class->worker.na_ucx_class)
+        na_ucx_worker_close(&na_ucx_class->worker);
     if (na_ucx_class->ucp_context)
         na_ucp_context_destroy(na_ucx_class->ucp_context);
 
-    if (na_ucx_class->addr_map.key_map)
-        hg_hash_table_free(na_ucx_class->addr_map.key_map);
-    if (na_ucx_class->addr_map.ep_map)
-        hg_hash_table_free(na_ucx_class->addr_map.ep_map);
-    (void) hg_thread_rwlock_destroy(&na_ucx_class->addr_map.lock);
-
-    (void) hg_thread_spin_destroy(&na_ucx_class->unexpected_op_queue.lock);
-    (void) hg_thread_spin_destroy(&na_ucx_class->unexpected_msg_queue.lock);
     (void) hg_thread_spin_destroy(&na_ucx_class->addr_pool.lock);
 
     free(na_ucx_class->protocol_name);
     free(na_ucx_class);
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_worker_open(struct na_ucx_class *na_ucx_class, uint8_t id,
+    struct na_ucx_worker *na_ucx_worker)
+{
+    na_return_t ret;
+    int rc;
+
+    na_ucx_worker->na_ucx_class = na_ucx_class;
+    na_ucx_worker->id = id;
+
+    /* Init table lock */
+    rc = hg_thread_rwlock_init(&na_ucx_worker->addr_map.lock);
+    NA_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error, ret, NA_NOMEM,
+        "hg_thread_rwlock_init() failed");
+
+    /* Initialize unexpected op queue */
+    rc = hg_thread_spin_init(&na_ucx_worker->unexpected_op_queue.lock);
+    NA_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error, ret, NA_NOMEM,
+        "hg_thread_spin_init() failed");
+    TAILQ_INIT(&na_ucx_worker->unexpected_op_queue.queue);
+
+    /* Initialize multi-recv op queue */
+    rc = hg_thread_spin_init(&na_ucx_worker->multi_op_queue.lock);
+    NA_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error, ret, NA_NOMEM,
+        "hg_thread_spin_init() failed");
+    TAILQ_INIT(&na_ucx_worker->multi_op_queue.queue);
+    hg_atomic_init32(&na_ucx_worker->multi_op_count, 0);
+
+    /* Initialize unexpected msg queue */
+    rc = hg_thread_spin_init(&na_ucx_worker->unexpected_msg_queue.lock);
+    NA_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error, ret, NA_NOMEM,
+        "hg_thread_spin_init() failed");
+    STAILQ_INIT(&na_ucx_worker->unexpected_msg_queue.queue);
+
+    /* Create address map */
+    na_ucx_worker->addr_map.key_map =
+        hg_hash_table_new(na_ucx_addr_key_hash, na_ucx_addr_key_equal);
+    NA_CHECK_SUBSYS_ERROR(cls, na_ucx_worker->addr_map.key_map == NULL, error,
+        ret, NA_NOMEM, "Could not allocate key map");
+
+    /* Create connection map */
+    na_ucx_worker->addr_map.ep_map =
+        hg_hash_table_new(na_ucx_addr_ep_hash, na_ucx_addr_ep_equal);
+    NA_CHECK_SUBSYS_ERROR(cls, na_ucx_worker->addr_map.ep_map == NULL, error,
+        ret, NA_NOMEM, "Could not allocate EP handle map");
+
+    /* Create worker */
+    ret = na_ucp_worker_create(na_ucx_class->ucp_context,
+        na_ucx_class->worker_thread_mode, &na_ucx_worker->ucp_worker);
+    NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not create UCX worker");
+
+    /* Set AM handler for unexpected messages */
+    ret = na_ucp_set_am_handler(
+        na_ucx_worker->ucp_worker, na_ucp_am_recv_cb, (void *) na_ucx_worker);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        cls, error, ret, "Could not set handler for receiving active messages");
+
+    return NA_SUCCESS;
+
+error:
+    na_ucx_worker_close(na_ucx_worker);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_ucx_worker_close(struct na_ucx_worker *na_ucx_worker)
+{
+    /* Listener must be closed before EPs so that no new address is inserted */
+    if (na_ucx_worker->ucp_listener) {
+        na_ucp_listener_destroy(na_ucx_worker->ucp_listener);
+        na_ucx_worker->ucp_listener = NULL;
+    }
+
+    /* Iterate over remaining addresses and free them */
+    if (na_ucx_worker->addr_map.key_map) {
+        hg_hash_table_iter_t addr_table_iter;
+
+        hg_hash_table_iterate(na_ucx_worker->addr_map.key_map, &addr_table_iter);
+        while (hg_hash_table_iter_has_more(&addr_table_iter)) {
+            struct na_ucx_addr *na_ucx_addr =
+                (struct na_ucx_addr *) hg_hash_table_iter_next(
+                    &addr_table_iter);
+            na_ucx_addr_destroy(na_ucx_addr);
+        }
+    }
+
+    if (na_ucx_worker->ucp_worker) {
+        na_ucp_worker_destroy(na_ucx_worker->ucp_worker);
+        na_ucx_worker->ucp_worker = NULL;
+    }
+
+    if (na_ucx_worker->addr_map.key_map) {
+        hg_hash_table_free(na_ucx_worker->addr_map.key_map);
+        na_ucx_worker->addr_map.key_map = NULL;
+    }
+    if (na_ucx_worker->addr_map.ep_map) {
+        hg_hash_table_free(na_ucx_worker->addr_map.ep_map);
+        na_ucx_worker->addr_map.ep_map = NULL;
+    }
+    (void) hg_thread_rwlock_destroy(&na_ucx_worker->addr_map.lock);
+
+    (void) hg_thread_spin_destroy(&na_ucx_worker->unexpected_op_queue.lock);
+    (void) hg_thread_spin_destroy(&na_ucx_worker->multi_op_queue.lock);
+    (void) hg_thread_spin_destroy(&na_ucx_worker->unexpected_msg_queue.lock);
+
+    na_ucx_worker->na_ucx_class = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_sockaddr_offset_port(
+    struct sockaddr_storage *ss_addr, int offset, socklen_t *addrlen_p)
+{
+    na_return_t ret;
+
+    if (ss_addr->ss_family == AF_INET) {
+        struct sockaddr_in *sin = (struct sockaddr_in *) ss_addr;
+
+        sin->sin_port = htons((uint16_t) (ntohs(sin->sin_port) + offset));
+        if (addrlen_p != NULL)
+            *addrlen_p = (socklen_t) sizeof(*sin);
+    } else if (ss_addr->ss_family == AF_INET6) {
+        struct sockaddr_in6 *sin6 = (struct sockaddr_in6 *) ss_addr;
+
+        sin6->sin6_port = htons((uint16_t) (ntohs(sin6->sin6_port) + offset));
+        if (addrlen_p != NULL)
+            *addrlen_p = (socklen_t) sizeof(*sin6);
+    } else
+        NA_GOTO_SUBSYS_ERROR(addr, error, ret, NA_PROTONOSUPPORT,
+            "unsupported address family");
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ucx_parse_hostname_info(const char *hostname_info, const char *subnet_info,
@@ -2595,10 +2946,11 @@ na_ucx_addr_map_lookup(struct na_ucx_map *na_ucx_map, ucs_sock_addr_t *addr_key)
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucx_addr_map_insert(struct na_ucx_class *na_ucx_class,
-    struct na_ucx_map *na_ucx_map, ucs_sock_addr_t *addr_key,
-    ucp_conn_request_h conn_request, struct na_ucx_addr **na_ucx_addr_p)
+na_ucx_addr_map_insert(struct na_ucx_worker *na_ucx_worker,
+    ucs_sock_addr_t *addr_key, ucp_conn_request_h conn_request, uint8_t id,
+    struct na_ucx_addr **na_ucx_addr_p)
 {
+    struct na_ucx_map *na_ucx_map = &na_ucx_worker->addr_map;
     struct na_ucx_addr *na_ucx_addr = NULL;
     na_return_t ret = NA_SUCCESS;
     int rc;
@@ -2614,24 +2966,28 @@ na_ucx_addr_map_insert(struct na_ucx_class *na_ucx_class,
     }
 
     /* Allocate address */
-    ret = na_ucx_addr_create(na_ucx_class, addr_key, &na_ucx_addr);
+    ret = na_ucx_addr_create(na_ucx_worker, addr_key, &na_ucx_addr);
     NA_CHECK_SUBSYS_NA_ERROR(
         addr, error, ret, "Could not allocate NA UCX addr");
 
     if (conn_request) {
         /* Accept connection */
-        ret = na_ucp_accept(na_ucx_class->ucp_worker, conn_request,
+        ret = na_ucp_accept(na_ucx_worker->ucp_worker, conn_request,
             na_ucp_ep_error_cb, (void *) na_ucx_addr, &na_ucx_addr->ucp_ep);
         NA_CHECK_SUBSYS_NA_ERROR(
             addr, error, ret, "Could not accept connection request");
     } else {
         /* Create new endpoint */
-        ret = na_ucp_connect(na_ucx_class->ucp_worker,
-            na_ucx_class->self_addr->addr_key.addr, na_ucx_addr->addr_key.addr,
-            na_ucx_addr->addr_key.addrlen, na_ucp_ep_error_cb,
-            (void *) na_ucx_addr, &na_ucx_addr->ucp_ep);
+        ret = na_ucp_connect(na_ucx_worker->ucp_worker,
+            na_ucx_worker->na_ucx_class->self_addr->addr_key.addr,
+            na_ucx_addr->addr_key.addr, na_ucx_addr->addr_key.addrlen,
+            na_ucp_ep_error_cb, (void *) na_ucx_addr, &na_ucx_addr->ucp_ep);
         NA_CHECK_SUBSYS_NA_ERROR(
             addr, error, ret, "Could not connect UCP endpoint");
+
+        /* We connected to a listener, context id of remote is known */
+        na_ucx_addr->id = id;
+        na_ucx_addr->routable = true;
     }
     NA_LOG_SUBSYS_DEBUG(addr, "UCP ep for addr %p is %p", (void *) na_ucx_addr,
         (void *) na_ucx_addr->ucp_ep);
@@ -2669,9 +3025,10 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucx_addr_map_update(struct na_ucx_class *na_ucx_class,
-    struct na_ucx_map *na_ucx_map, struct na_ucx_addr *na_ucx_addr)
+na_ucx_addr_map_update(struct na_ucx_addr *na_ucx_addr)
 {
+    struct na_ucx_worker *na_ucx_worker = na_ucx_addr->na_ucx_worker;
+    struct na_ucx_map *na_ucx_map = &na_ucx_worker->addr_map;
     na_return_t ret = NA_SUCCESS;
     int rc;
 
@@ -2695,10 +3052,10 @@ na_ucx_addr_map_update(struct na_ucx_class *na_ucx_class,
     na_ucx_addr->ucp_ep = NULL;
 
     /* Create new endpoint */
-    ret = na_ucp_connect(na_ucx_class->ucp_worker,
-        na_ucx_class->self_addr->addr_key.addr, na_ucx_addr->addr_key.addr,
-        na_ucx_addr->addr_key.addrlen, na_ucp_ep_error_cb, (void *) na_ucx_addr,
-        &na_ucx_addr->ucp_ep);
+    ret = na_ucp_connect(na_ucx_worker->ucp_worker,
+        na_ucx_worker->na_ucx_class->self_addr->addr_key.addr,
+        na_ucx_addr->addr_key.addr, na_ucx_addr->addr_key.addrlen,
+        na_ucp_ep_error_cb, (void *) na_ucx_addr, &na_ucx_addr->ucp_ep);
     NA_CHECK_SUBSYS_NA_ERROR(
         addr, unlock, ret, "Could not connect UCP endpoint");
 
@@ -2844,7 +3201,10 @@ na_ucx_addr_release(struct na_ucx_addr *na_ucx_addr)
         NA_UCX_PRINT_ADDR_KEY_INFO("Removing address", &na_ucx_addr->addr_key);
 
         na_ucx_addr_map_remove(
-            &na_ucx_addr->na_ucx_class->addr_map, &na_ucx_addr->addr_key);
+            &na_ucx_addr->na_ucx_worker->addr_map, &na_ucx_addr->addr_key);
+
+        /* Worker may be closed before a pooled address is destroyed */
+        na_ucx_addr->addr_key = (ucs_sock_addr_t){.addr = NULL, .addrlen = 0};
     }
 
     if (na_ucx_addr->ucp_ep != NULL) {
@@ -2859,7 +3219,7 @@ na_ucx_addr_release(struct na_ucx_addr *na_ucx_addr)
         if (na_ucx_addr->worker_addr_alloc)
             free(na_ucx_addr->worker_addr);
         else
-            ucp_worker_release_address(na_ucx_addr->na_ucx_class->ucp_worker,
+            ucp_worker_release_address(na_ucx_addr->na_ucx_worker->ucp_worker,
                 na_ucx_addr->worker_addr);
         na_ucx_addr->worker_addr = NULL;
         na_ucx_addr->worker_addr_len = 0;
@@ -2871,6 +3231,8 @@ static void
 na_ucx_addr_reset(struct na_ucx_addr *na_ucx_addr, ucs_sock_addr_t *addr_key)
 {
     na_ucx_addr->ucp_ep = NULL;
+    na_ucx_addr->id = 0;
+    na_ucx_addr->routable = false;
     hg_atomic_init32(&na_ucx_addr->refcount, 1);
     hg_atomic_init32(&na_ucx_addr->status, 0);
 
@@ -2889,9 +3251,10 @@ na_ucx_addr_reset(struct na_ucx_addr *na_ucx_addr, ucs_sock_addr_t *addr_key)
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucx_addr_create(struct na_ucx_class *na_ucx_class, ucs_sock_addr_t *addr_key,
-    struct na_ucx_addr **na_ucx_addr_p)
+na_ucx_addr_create(struct na_ucx_worker *na_ucx_worker,
+    ucs_sock_addr_t *addr_key, struct na_ucx_addr **na_ucx_addr_p)
 {
+    struct na_ucx_class *na_ucx_class = na_ucx_worker->na_ucx_class;
     struct na_ucx_addr *na_ucx_addr;
     na_return_t ret;
 
@@ -2908,6 +3271,7 @@ na_ucx_addr_create(struct na_ucx_class *na_ucx_class, ucs_sock_addr_t *addr_key,
         "Could not allocate NA UCX addr");
 
     na_ucx_addr_reset(na_ucx_addr, addr_key);
+    na_ucx_addr->na_ucx_worker = na_ucx_worker;
     NA_LOG_SUBSYS_DEBUG(addr, "Created address %p", (void *) na_ucx_addr);
 
     *na_ucx_addr_p = na_ucx_addr;
@@ -2954,6 +3318,52 @@ na_ucx_addr_ref_decr(struct na_ucx_addr *na_ucx_addr)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_addr_route(struct na_ucx_worker *na_ucx_worker,
+    struct na_ucx_addr *na_ucx_addr, uint8_t id,
+    struct na_ucx_addr **routed_addr_p)
+{
+    struct na_ucx_addr *routed_addr;
+    struct sockaddr_storage ss_addr;
+    ucs_sock_addr_t addr_key;
+    na_return_t ret;
+
+    /* Accepted and deserialized addresses can only be reached through the EP
+     * that was created for them */
+    if (!na_ucx_addr->routable ||
+        (na_ucx_addr->na_ucx_worker == na_ucx_worker && na_ucx_addr->id == id)) {
+        *routed_addr_p = na_ucx_addr;
+        return NA_SUCCESS;
+    }
+
+    /* Listener of remote context id */
+    memcpy(&ss_addr, na_ucx_addr->addr_key.addr, na_ucx_addr->addr_key.addrlen);
+    ret = na_ucx_sockaddr_offset_port(
+        &ss_addr, (int) id - (int) na_ucx_addr->id, NULL);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        addr, error, ret, "Could not get address of remote context");
+    addr_key = (ucs_sock_addr_t){.addr = (const struct sockaddr *) &ss_addr,
+        .addrlen = na_ucx_addr->addr_key.addrlen};
+
+    routed_addr = na_ucx_addr_map_lookup(&na_ucx_worker->addr_map, &addr_key);
+    if (routed_addr == NULL) {
+        NA_UCX_PRINT_ADDR_KEY_INFO("Routing to new address", &addr_key);
+
+        ret = na_ucx_addr_map_insert(
+            na_ucx_worker, &addr_key, NULL, id, &routed_addr);
+        NA_CHECK_SUBSYS_ERROR(addr, ret != NA_SUCCESS && ret != NA_EXIST,
+            error, ret, ret, "Could not insert new address");
+    }
+
+    *routed_addr_p = routed_addr;
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static struct na_ucx_unexpected_info *
 na_ucx_unexpected_info_alloc(void *data, size_t data_alloc_size)
@@ -2996,13 +3406,19 @@ na_ucx_unexpected_info_free(
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucx_rma(struct na_ucx_class NA_UNUSED *na_ucx_class, na_context_t *context,
-    na_cb_type_t cb_type, na_cb_t callback, void *arg,
-    struct na_ucx_mem_handle *local_mem_handle, na_offset_t local_offset,
-    struct na_ucx_mem_handle *remote_mem_handle, na_offset_t remote_offset,
-    size_t length, struct na_ucx_addr *na_ucx_addr,
-    struct na_ucx_op_id *na_ucx_op_id)
+na_ucx_rma(na_context_t *context, na_cb_type_t cb_type, na_cb_t callback,
+    void *arg, struct na_ucx_mem_handle *local_mem_handle,
+    na_offset_t local_offset, struct na_ucx_mem_handle *remote_mem_handle,
+    na_offset_t remote_offset, size_t length, struct na_ucx_addr *na_ucx_addr,
+    uint8_t remote_id, struct na_ucx_op_id *na_ucx_op_id)
 {
+    na_ucp_rma_op_t ucp_rma_op = (cb_type == NA_CB_PUT) ? na_ucp_put
+                                                        : na_ucp_get;
+    struct na_ucx_rma_info *na_ucx_rma_info;
+    const struct na_ucx_mem_seg *local_segs, *remote_segs;
+    size_t local_iovcnt, remote_iovcnt, local_seg_index, remote_seg_index,
+        local_seg_count, remote_seg_count, iov_index = 0, remaining;
+    na_offset_t local_seg_offset, remote_seg_offset;
     na_return_t ret;
 
     /* Check op_id */
@@ -3013,70 +3429,197 @@ na_ucx_rma(struct na_ucx_class NA_UNUSED *na_ucx_class, na_context_t *context,
         ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
         na_cb_type_to_string(na_ucx_op_id->completion_data.callback_info.type));
 
+    /* Use EP of this context to reach remote context */
+    ret = na_ucx_addr_route(NA_UCX_CONTEXT(context)->na_ucx_worker,
+        na_ucx_addr, remote_id, &na_ucx_addr);
+    NA_CHECK_SUBSYS_NA_ERROR(rma, error, ret, "Could not route address");
+
     NA_UCX_OP_RESET(na_ucx_op_id, context, cb_type, callback, arg, na_ucx_addr);
 
-    na_ucx_op_id->info.rma.ucp_rma_op =
-        (cb_type == NA_CB_PUT) ? na_ucp_put : na_ucp_get;
-    na_ucx_op_id->info.rma.buf =
-        (char *) local_mem_handle->desc.base + local_offset;
-    na_ucx_op_id->info.rma.remote_addr =
-        remote_mem_handle->desc.base + remote_offset;
-    na_ucx_op_id->info.rma.buf_size = length;
-    na_ucx_op_id->info.rma.remote_key = NULL;
+    na_ucx_rma_info = &na_ucx_op_id->info.rma;
+    na_ucx_rma_info->local_iov = NULL;
+    na_ucx_rma_info->sub_ops = false;
+    hg_atomic_set32(&na_ucx_rma_info->pending, 0);
+    hg_atomic_set32(&na_ucx_rma_info->ret, (int32_t) NA_SUCCESS);
 
     /* There is no need to have a fully resolved address to start an RMA.
      * This is only necessary for two-sided communication. */
 
     /* TODO UCX requires the remote key to be bound to the origin, do we need a
      * new API? */
-    ret = na_ucx_rma_key_resolve(na_ucx_addr->ucp_ep, remote_mem_handle,
-        &na_ucx_op_id->info.rma.remote_key);
+    ret = na_ucx_rma_key_resolve(na_ucx_addr, remote_mem_handle);
     NA_CHECK_SUBSYS_NA_ERROR(rma, release, ret, "Could not resolve remote key");
 
-    /* Post RMA op */
-    ret = na_ucx_op_id->info.rma.ucp_rma_op(na_ucx_addr->ucp_ep,
-        na_ucx_op_id->info.rma.buf, na_ucx_op_id->info.rma.buf_size,
-        na_ucx_op_id->info.rma.remote_addr, na_ucx_op_id->info.rma.remote_key,
-        na_ucx_op_id);
-    NA_CHECK_SUBSYS_NA_ERROR(rma, release, ret, "Could not post rma operation");
-
-    return NA_SUCCESS;
-
-release:
-    NA_UCX_OP_RELEASE(na_ucx_op_id);
-
-error:
-    return ret;
-}
-
-/*---------------------------------------------------------------------------*/
-static na_return_t
-na_ucx_rma_key_resolve(ucp_ep_h ep, struct na_ucx_mem_handle *na_ucx_mem_handle,
-    ucp_rkey_h *rkey_p)
-{
-    na_return_t ret;
+    local_segs = local_mem_handle->segs;
+    local_iovcnt = (size_t) local_mem_handle->desc.iovcnt;
+    remote_segs = remote_mem_handle->segs;
+    remote_iovcnt = (size_t) remote_mem_handle->desc.iovcnt;
+
+    /* Translate handle offsets to segment index / offset */
+    na_ucx_mem_seg_get_index_offset(
+        local_segs, local_iovcnt, local_offset, &local_seg_index,
+        &local_seg_offset);
+    local_seg_count = na_ucx_mem_seg_get_count(local_segs, local_iovcnt,
+        local_seg_index, local_seg_offset, length);
+    na_ucx_mem_seg_get_index_offset(remote_segs, remote_iovcnt, remote_offset,
+        &remote_seg_index, &remote_seg_offset);
+    remote_seg_count = na_ucx_mem_seg_get_count(remote_segs, remote_iovcnt,
+        remote_seg_index, remote_seg_offset, length);
+
+    /* Contiguous on both sides, post single request */
+    if (local_seg_count == 1 && remote_seg_count == 1) {
+        ret = ucp_rma_op(na_ucx_addr->ucp_ep,
+            (char *) local_segs[local_seg_index].desc.base + local_seg_offset,
+            length, ucp_dt_make_contig(1),
+            remote_segs[remote_seg_index].desc.base + remote_seg_offset,
+            remote_segs[remote_seg_index].ucp_mr.rkey, na_ucx_op_id, NULL);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            rma, release, ret, "Could not post rma operation");
 
-    if (hg_atomic_get32(&na_ucx_mem_handle->type) ==
-        NA_UCX_MEM_HANDLE_REMOTE_UNPACKED) {
-        *rkey_p = na_ucx_mem_handle->ucp_mr.rkey;
         return NA_SUCCESS;
     }
 
-    hg_thread_mutex_lock(&na_ucx_mem_handle->rkey_unpack_lock);
+    /* Local pieces can be split at most once more per remote segment */
+    if (local_seg_count + remote_seg_count - 1 > NA_UCX_IOV_STATIC_MAX) {
+        na_ucx_rma_info->local_iov_storage.d = (ucp_dt_iov_t *) malloc(
+            (local_seg_count + remote_seg_count - 1) * sizeof(ucp_dt_iov_t));
+        NA_CHECK_SUBSYS_ERROR(rma, na_ucx_rma_info->local_iov_storage.d == NULL,
+            release, ret, NA_NOMEM, "Could not allocate iov array");
+        na_ucx_rma_info->local_iov = na_ucx_rma_info->local_iov_storage.d;
+    } else
+        na_ucx_rma_info->local_iov = na_ucx_rma_info->local_iov_storage.s;
+
+    /* One request per remote segment, hold an extra reference until all
+     * requests are posted so that the op cannot complete early */
+    if (remote_seg_count > 1) {
+        na_ucx_rma_info->sub_ops = true;
+        hg_atomic_set32(&na_ucx_rma_info->pending, 1);
+    }
+
+    for (remaining = length; remaining > 0;
+         remote_seg_index++, remote_seg_offset = 0) {
+        size_t remote_len =
+            MIN(remaining, (size_t) (remote_segs[remote_seg_index].desc.len -
+                                     remote_seg_offset));
+        ucp_dt_iov_t *iov = &na_ucx_rma_info->local_iov[iov_index];
+        size_t iov_len = 0, iov_count = 0;
+
+        if (remote_len == 0)
+            continue;
+
+        /* Gather local pieces that map to this remote segment */
+        while (iov_len < remote_len) {
+            size_t local_len = MIN(remote_len - iov_len,
+                (size_t) (local_segs[local_seg_index].desc.len -
+                          local_seg_offset));
+
+            if (local_len > 0) {
+                iov[iov_count].buffer =
+                    (char *) local_segs[local_seg_index].desc.base +
+                    local_seg_offset;
+                iov[iov_count].length = local_len;
+                iov_count++;
+                iov_len += local_len;
+                local_seg_offset += local_len;
+            }
+            if (local_seg_offset == local_segs[local_seg_index].desc.len) {
+                local_seg_index++;
+                local_seg_offset = 0;
+            }
+        }
+        iov_index += iov_count;
+
+        if (na_ucx_rma_info->sub_ops)
+            hg_atomic_incr32(&na_ucx_rma_info->pending);
+
+        ret = ucp_rma_op(na_ucx_addr->ucp_ep,
+            (iov_count == 1) ? iov[0].buffer : (void *) iov,
+            (iov_count == 1) ? iov[0].length : iov_count,
+            (iov_count == 1) ? ucp_dt_make_contig(1) : ucp_dt_make_iov(),
+            remote_segs[remote_seg_index].desc.base + remote_seg_offset,
+            remote_segs[remote_seg_index].ucp_mr.rkey,
+            (na_ucx_rma_info->sub_ops) ? NULL : na_ucx_op_id,
+            (na_ucx_rma_info->sub_ops) ? na_ucx_op_id : NULL);
+        if (ret != NA_SUCCESS) {
+            /* Nothing was posted yet, fail the whole operation */
+            NA_CHECK_SUBSYS_ERROR(rma,
+                !na_ucx_rma_info->sub_ops || remaining == length, release_iov,
+                ret, ret, "Could not post rma operation");
+
+            /* Let posted requests complete and report error on completion */
+            NA_LOG_SUBSYS_ERROR(rma, "Could not post rma sub-operation");
+            hg_atomic_decr32(&na_ucx_rma_info->pending);
+            hg_atomic_cas32(
+                &na_ucx_rma_info->ret, (int32_t) NA_SUCCESS, (int32_t) ret);
+            break;
+        }
+
+        remaining -= remote_len;
+    }
+
+    /* Release extra reference */
+    if (na_ucx_rma_info->sub_ops &&
+        hg_atomic_decr32(&na_ucx_rma_info->pending) == 0) {
+        na_ucx_rma_iov_free(na_ucx_rma_info);
+        na_ucx_complete(
+            na_ucx_op_id, (na_return_t) hg_atomic_get32(&na_ucx_rma_info->ret));
+    }
+
+    return NA_SUCCESS;
+
+release_iov:
+    na_ucx_rma_iov_free(na_ucx_rma_info);
+release:
+    NA_UCX_OP_RELEASE(na_ucx_op_id);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_rma_key_resolve(struct na_ucx_addr *na_ucx_addr,
+    struct na_ucx_mem_handle *na_ucx_mem_handle)
+{
+    size_t i;
+    na_return_t ret;
+
+    if (hg_atomic_get32(&na_ucx_mem_handle->type) ==
+            NA_UCX_MEM_HANDLE_REMOTE_UNPACKED &&
+        na_ucx_mem_handle->rkey_worker == na_ucx_addr->na_ucx_worker)
+        return NA_SUCCESS;
+
+    hg_thread_mutex_lock(&na_ucx_mem_handle->rkey_unpack_lock);
 
     switch (hg_atomic_get32(&na_ucx_mem_handle->type)) {
-        case NA_UCX_MEM_HANDLE_REMOTE_PACKED: {
-            ucs_status_t status = ucp_ep_rkey_unpack(ep,
-                na_ucx_mem_handle->rkey_buf, &na_ucx_mem_handle->ucp_mr.rkey);
-            NA_CHECK_SUBSYS_ERROR(mem, status != UCS_OK, error, ret,
-                na_ucs_status_to_na(status), "ucp_ep_rkey_unpack() failed (%s)",
-                ucs_status_string(status));
+        case NA_UCX_MEM_HANDLE_REMOTE_PACKED:
+            for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++) {
+                struct na_ucx_mem_seg *seg = &na_ucx_mem_handle->segs[i];
+                ucs_status_t status = ucp_ep_rkey_unpack(
+                    na_ucx_addr->ucp_ep, seg->rkey_buf, &seg->ucp_mr.rkey);
+                if (status != UCS_OK) {
+                    /* Destroy rkeys that were already unpacked */
+                    while (i-- > 0) {
+                        ucp_rkey_destroy(na_ucx_mem_handle->segs[i].ucp_mr.rkey);
+                        na_ucx_mem_handle->segs[i].ucp_mr.rkey = NULL;
+                    }
+                    NA_GOTO_SUBSYS_ERROR(mem, error, ret,
+                        na_ucs_status_to_na(status),
+                        "ucp_ep_rkey_unpack() failed (%s)",
+                        ucs_status_string(status));
+                }
+            }
             /* Handle is now unpacked */
+            na_ucx_mem_handle->rkey_worker = na_ucx_addr->na_ucx_worker;
             hg_atomic_set32(
                 &na_ucx_mem_handle->type, NA_UCX_MEM_HANDLE_REMOTE_UNPACKED);
             break;
-        }
         case NA_UCX_MEM_HANDLE_REMOTE_UNPACKED:
+            /* Unpacked rkeys are bound to the worker of the EP */
+            NA_CHECK_SUBSYS_ERROR(mem,
+                na_ucx_mem_handle->rkey_worker != na_ucx_addr->na_ucx_worker,
+                error, ret, NA_OPNOTSUPPORTED,
+                "Remote key was already unpacked by another context");
             break;
         case NA_UCX_MEM_HANDLE_LOCAL:
         default:
@@ -3084,7 +3627,6 @@ na_ucx_rma_key_resolve(ucp_ep_h ep, struct na_ucx_mem_handle *na_ucx_mem_handle,
                 mem, error, ret, NA_INVALID_ARG, "Invalid memory handle type");
     }
 
-    *rkey_p = na_ucx_mem_handle->ucp_mr.rkey;
     hg_thread_mutex_unlock(&na_ucx_mem_handle->rkey_unpack_lock);
 
     return NA_SUCCESS;
@@ -3094,6 +3636,58 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_ucx_mem_seg_get_index_offset(const struct na_ucx_mem_seg *segs,
+    size_t iovcnt, na_offset_t offset, size_t *seg_index_p,
+    na_offset_t *seg_offset_p)
+{
+    na_offset_t new_seg_offset = offset, next_offset = 0;
+    size_t i, new_seg_index = 0;
+
+    /* Get start index and handle offset */
+    for (i = 0; i < iovcnt; i++) {
+        next_offset += segs[i].desc.len;
+
+        if (offset < next_offset) {
+            new_seg_index = i;
+            break;
+        }
+        new_seg_offset -= segs[i].desc.len;
+    }
+
+    *seg_index_p = new_seg_index;
+    *seg_offset_p = new_seg_offset;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_ucx_mem_seg_get_count(const struct na_ucx_mem_seg *segs, size_t iovcnt,
+    size_t seg_index, na_offset_t seg_offset, size_t len)
+{
+    size_t remaining_len =
+        len - MIN(len, (size_t) (segs[seg_index].desc.len - seg_offset));
+    size_t i, index;
+
+    for (i = 1, index = seg_index + 1; remaining_len > 0 && index < iovcnt;
+         i++, index++) {
+        /* Decrease remaining len from the len of data */
+        remaining_len -= MIN(remaining_len, (size_t) segs[index].desc.len);
+    }
+
+    return i;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_ucx_rma_iov_free(struct na_ucx_rma_info *na_ucx_rma_info)
+{
+    if (na_ucx_rma_info->local_iov != NULL &&
+        na_ucx_rma_info->local_iov != na_ucx_rma_info->local_iov_storage.s)
+        free(na_ucx_rma_info->local_iov_storage.d);
+    na_ucx_rma_info->local_iov = NULL;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE void
 na_ucx_complete(struct na_ucx_op_id *na_ucx_op_id, na_return_t cb_ret)
@@ -3125,6 +3719,214 @@ na_ucx_release(void *arg)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static bool
+na_ucx_multi_recv_deliver(struct na_ucx_worker *na_ucx_worker,
+    const void *data, size_t length, ucp_tag_t tag,
+    struct na_ucx_addr *source_addr)
+{
+    struct na_ucx_op_queue *multi_op_queue = &na_ucx_worker->multi_op_queue;
+    struct na_cb_completion_data *completion_data = NULL;
+    struct na_ucx_op_id *na_ucx_op_id;
+    void *actual_buf = NULL;
+    bool last = false;
+
+    hg_thread_spin_lock(&multi_op_queue->lock);
+    na_ucx_op_id = TAILQ_FIRST(&multi_op_queue->queue);
+    if (na_ucx_op_id != NULL) {
+        struct na_ucx_msg_info *msg_info = &na_ucx_op_id->info.msg;
+        size_t size_left = msg_info->buf_size - msg_info->buf_offset;
+
+        NA_CHECK_SUBSYS_ERROR_NORET(msg, length > size_left, unlock,
+            "Unexpected msg size too large for multi-recv buffer (%zu bytes "
+            "left, got %zu)",
+            size_left, length);
+
+        /* Events are completed in order from a fixed size ring */
+        completion_data =
+            na_ucx_completion_multi_push(&na_ucx_op_id->completion_multi);
+        if (completion_data == NULL) {
+            NA_LOG_SUBSYS_WARNING(perf, "Multi-recv completion queue is full");
+            goto unlock;
+        }
+
+        actual_buf = (char *) msg_info->buf.ptr + msg_info->buf_offset;
+        memcpy(actual_buf, data, length);
+        msg_info->buf_offset +=
+            MIN(size_left, (length + NA_UCX_MULTI_RECV_ALIGN - 1) &
+                               ~((size_t) NA_UCX_MULTI_RECV_ALIGN - 1));
+
+        /* Buffer is consumed once it can no longer fit a message */
+        last = (msg_info->buf_size - msg_info->buf_offset) <
+               na_ucx_worker->na_ucx_class->unexpected_size_max;
+        if (last) {
+            TAILQ_REMOVE(&multi_op_queue->queue, na_ucx_op_id, entry);
+            hg_atomic_and32(&na_ucx_op_id->status, ~NA_UCX_OP_QUEUED);
+            hg_atomic_decr32(&na_ucx_worker->multi_op_count);
+        }
+    }
+unlock:
+    hg_thread_spin_unlock(&multi_op_queue->lock);
+
+    if (completion_data == NULL)
+        return false;
+
+    *completion_data = na_ucx_op_id->completion_data;
+    completion_data->callback_info.info.multi_recv_unexpected =
+        (struct na_cb_info_multi_recv_unexpected){.actual_buf = actual_buf,
+            .actual_buf_size = length,
+            .source = (na_addr_t *) source_addr,
+            .tag = (na_tag_t) tag,
+            .last = last};
+    na_ucx_addr_ref_incr(source_addr);
+
+    na_ucx_complete_multi(na_ucx_op_id, completion_data, last, NA_SUCCESS);
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_ucx_multi_recv_drain(struct na_ucx_worker *na_ucx_worker)
+{
+    struct na_ucx_unexpected_msg_queue *unexpected_msg_queue =
+        &na_ucx_worker->unexpected_msg_queue;
+
+    while (hg_atomic_get32(&na_ucx_worker->multi_op_count) > 0) {
+        struct na_ucx_unexpected_info *na_ucx_unexpected_info;
+        bool delivered;
+
+        hg_thread_spin_lock(&unexpected_msg_queue->lock);
+        na_ucx_unexpected_info = STAILQ_FIRST(&unexpected_msg_queue->queue);
+        if (na_ucx_unexpected_info != NULL)
+            STAILQ_REMOVE_HEAD(&unexpected_msg_queue->queue, entry);
+        hg_thread_spin_unlock(&unexpected_msg_queue->lock);
+
+        if (na_ucx_unexpected_info == NULL)
+            break;
+
+        delivered = na_ucx_multi_recv_deliver(na_ucx_worker,
+            na_ucx_unexpected_info->data, na_ucx_unexpected_info->length,
+            na_ucx_unexpected_info->tag, na_ucx_unexpected_info->na_ucx_addr);
+        if (!delivered) {
+            /* Put it back and retry later */
+            hg_thread_spin_lock(&unexpected_msg_queue->lock);
+            STAILQ_INSERT_HEAD(
+                &unexpected_msg_queue->queue, na_ucx_unexpected_info, entry);
+            hg_thread_spin_unlock(&unexpected_msg_queue->lock);
+            break;
+        }
+
+        /* Deliver took its own reference to the source */
+        na_ucx_addr_ref_decr(na_ucx_unexpected_info->na_ucx_addr);
+
+        /* Release AM buffer if returned UCS_INPROGRESS */
+        if (!na_ucx_unexpected_info->data_alloc &&
+            na_ucx_unexpected_info->length > 0)
+            ucp_am_data_release(
+                na_ucx_worker->ucp_worker, na_ucx_unexpected_info->data);
+        na_ucx_unexpected_info_free(na_ucx_unexpected_info);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_ucx_complete_multi(struct na_ucx_op_id *na_ucx_op_id,
+    struct na_cb_completion_data *completion_data, bool complete,
+    na_return_t cb_ret)
+{
+    /* Mark op id as completed on last event (independent of cb_ret) */
+    if (complete)
+        hg_atomic_or32(&na_ucx_op_id->status, NA_UCX_OP_COMPLETED);
+
+    /* Set callback ret */
+    completion_data->callback_info.ret = cb_ret;
+    completion_data->plugin_callback = na_ucx_release_multi;
+    completion_data->plugin_callback_args = na_ucx_op_id;
+
+    /* Add OP to NA completion queue */
+    na_cb_completion_add(na_ucx_op_id->context, completion_data);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_ucx_release_multi(void *arg)
+{
+    struct na_ucx_op_id *na_ucx_op_id = (struct na_ucx_op_id *) arg;
+
+    na_ucx_completion_multi_pop(&na_ucx_op_id->completion_multi);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_completion_multi_init(
+    struct na_ucx_completion_multi *completion_multi, unsigned int count)
+{
+    na_return_t ret;
+
+    completion_multi->data = (struct na_cb_completion_data *) calloc(
+        count, sizeof(struct na_cb_completion_data));
+    NA_CHECK_SUBSYS_ERROR(op, completion_multi->data == NULL, error, ret,
+        NA_NOMEM, "Could not allocate %u completion data entries", count);
+    completion_multi->size = count;
+    completion_multi->mask = (int32_t) (count - 1);
+    hg_atomic_init32(&completion_multi->head, 0);
+    hg_atomic_init32(&completion_multi->tail, 0);
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_ucx_completion_multi_destroy(
+    struct na_ucx_completion_multi *completion_multi)
+{
+    free(completion_multi->data);
+    completion_multi->data = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct na_cb_completion_data *
+na_ucx_completion_multi_push(struct na_ucx_completion_multi *completion_multi)
+{
+    struct na_cb_completion_data *completion_data;
+    int32_t head, next, tail;
+
+    head = hg_atomic_get32(&completion_multi->head);
+    next = (head + 1) & completion_multi->mask;
+    tail = hg_atomic_get32(&completion_multi->tail);
+
+    if (next == tail)
+        /* Full */
+        return NULL;
+
+    completion_data = &completion_multi->data[head];
+
+    hg_atomic_set32(&completion_multi->head, next);
+
+    return completion_data;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_ucx_completion_multi_pop(struct na_ucx_completion_multi *completion_multi)
+{
+    int32_t head, next, tail;
+
+    head = hg_atomic_get32(&completion_multi->head);
+    tail = hg_atomic_get32(&completion_multi->tail);
+
+    if (head == tail)
+        /* Empty */
+        return;
+
+    next = (tail + 1) & completion_multi->mask;
+    hg_atomic_set32(&completion_multi->tail, next);
+}
+
 /********************/
 /* Plugin callbacks */
 /********************/
@@ -3226,6 +4028,7 @@ na_ucx_initialize(
     ucs_sock_addr_t addr_key = {.addr = NULL, .addrlen = 0};
     ucp_config_t *config = NULL;
     bool no_wait = false;
+    uint8_t context_max = 1;
     size_t unexpected_size_max = 0, expected_size_max = 0;
     ucs_thread_mode_t context_thread_mode, worker_thread_mode;
     na_return_t ret;
@@ -3241,8 +4044,8 @@ na_ucx_initialize(
     if (na_init_info->progress_mode & NA_NO_BLOCK)
         no_wait = true;
     /* Max contexts */
-    // if (na_init_info->max_contexts)
-    //     context_max = na_init_info->max_contexts;
+    if (na_init_info->max_contexts)
+        context_max = na_init_info->max_contexts;
     /* Sizes */
     if (na_init_info->max_unexpected_size)
         unexpected_size_max = na_init_info->max_unexpected_size;
@@ -3304,6 +4107,10 @@ na_ucx_initialize(
     /* Set wait mode */
     na_ucx_class->no_wait = no_wait;
 
+    /* Each context above 0 gets its own worker */
+    na_ucx_class->context_max = context_max;
+    na_ucx_class->worker_thread_mode = worker_thread_mode;
+
     /* TODO may need to query UCX */
     na_ucx_class->unexpected_size_max =
         unexpected_size_max ? unexpected_size_max : NA_UCX_MSG_SIZE_MAX;
@@ -3325,22 +4132,15 @@ na_ucx_initialize(
     free(net_device);
     net_device = NULL;
 
-    /* Create single worker */
-    ret = na_ucp_worker_create(na_ucx_class->ucp_context, worker_thread_mode,
-        &na_ucx_class->ucp_worker);
-    NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not create UCX worker");
-
-    /* Set AM handler for unexpected messages */
-    ret = na_ucp_set_am_handler(
-        na_ucx_class->ucp_worker, na_ucp_am_recv_cb, (void *) na_ucx_class);
-    NA_CHECK_SUBSYS_NA_ERROR(
-        cls, error, ret, "Could not set handler for receiving active messages");
+    /* Create class worker (also used by context 0) */
+    ret = na_ucx_worker_open(na_ucx_class, 0, &na_ucx_class->worker);
+    NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not open class worker");
 
     /* Create listener if we're listening */
     if (listen) {
-        ret = na_ucp_listener_create(na_ucx_class->ucp_worker, src_sockaddr,
-            src_addrlen, (void *) na_ucx_class, &na_ucx_class->ucp_listener,
-            &ucp_listener_ss_addr);
+        ret = na_ucp_listener_create(na_ucx_class->worker.ucp_worker,
+            src_sockaddr, src_addrlen, (void *) &na_ucx_class->worker,
+            &na_ucx_class->worker.ucp_listener, &ucp_listener_ss_addr);
         NA_CHECK_SUBSYS_NA_ERROR(
             cls, error, ret, "Could not create UCX listener");
 
@@ -3360,11 +4160,12 @@ na_ucx_initialize(
 #endif
 
     /* Create self address */
-    ret = na_ucx_addr_create(na_ucx_class, &addr_key, &na_ucx_class->self_addr);
+    ret = na_ucx_addr_create(
+        &na_ucx_class->worker, &addr_key, &na_ucx_class->self_addr);
     NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not create self address");
 
     /* Attach worker address */
-    ret = na_ucp_worker_get_address(na_ucx_class->ucp_worker,
+    ret = na_ucp_worker_get_address(na_ucx_class->worker.ucp_worker,
         &na_ucx_class->self_addr->worker_addr,
         &na_ucx_class->self_addr->worker_addr_len);
     NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not get worker address");
@@ -3404,7 +4205,6 @@ static na_return_t
 na_ucx_finalize(na_class_t *na_class)
 {
     struct na_ucx_class *na_ucx_class = NA_UCX_CLASS(na_class);
-    hg_hash_table_iter_t addr_table_iter;
     na_return_t ret = NA_SUCCESS;
 
     if (na_ucx_class == NULL)
@@ -3414,14 +4214,6 @@ na_ucx_finalize(na_class_t *na_class)
         done, ret, NA_BUSY, "Contexts were not destroyed (%d remaining)",
         hg_atomic_get32(&na_ucx_class->ncontexts));
 
-    /* Iterate over remaining addresses and free them */
-    hg_hash_table_iterate(na_ucx_class->addr_map.key_map, &addr_table_iter);
-    while (hg_hash_table_iter_has_more(&addr_table_iter)) {
-        struct na_ucx_addr *na_ucx_addr =
-            (struct na_ucx_addr *) hg_hash_table_iter_next(&addr_table_iter);
-        na_ucx_addr_destroy(na_ucx_addr);
-    }
-
 #ifdef NA_UCX_HAS_ADDR_POOL
     /* Free address pool */
     while (!STAILQ_EMPTY(&na_ucx_class->addr_pool.queue)) {
@@ -3439,9 +4231,125 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static bool
+na_ucx_has_opt_feature(na_class_t NA_UNUSED *na_class, unsigned long flags)
+{
+    /* Multi-recv is emulated by copying AM data into posted buffers */
+    return flags & NA_OPT_MULTI_RECV;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_context_create(na_class_t *na_class, void **context_p, uint8_t id)
+{
+    struct na_ucx_class *na_ucx_class = NA_UCX_CLASS(na_class);
+    struct na_ucx_context *na_ucx_context = NULL;
+    struct na_ucx_worker *na_ucx_worker = NULL;
+    na_return_t ret;
+
+    na_ucx_context =
+        (struct na_ucx_context *) calloc(1, sizeof(*na_ucx_context));
+    NA_CHECK_SUBSYS_ERROR(ctx, na_ucx_context == NULL, error, ret, NA_NOMEM,
+        "Could not allocate na_ucx_context");
+
+    /* Context 0 and single context classes share the class worker */
+    if (id == 0 || na_ucx_class->context_max == 1) {
+        na_ucx_context->na_ucx_worker = &na_ucx_class->worker;
+    } else {
+        NA_CHECK_SUBSYS_ERROR(fatal, id >= na_ucx_class->context_max, error,
+            ret, NA_OPNOTSUPPORTED,
+            "Context ID (%" PRIu8 ") must be lower than context max (%" PRIu8
+            ")",
+            id, na_ucx_class->context_max);
+
+        na_ucx_worker =
+            (struct na_ucx_worker *) calloc(1, sizeof(*na_ucx_worker));
+        NA_CHECK_SUBSYS_ERROR(ctx, na_ucx_worker == NULL, error, ret, NA_NOMEM,
+            "Could not allocate na_ucx_worker");
+
+        ret = na_ucx_worker_open(na_ucx_class, id, na_ucx_worker);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            ctx, error, ret, "Could not open worker for context %" PRIu8, id);
+
+        /* Remote peers reach context id on listener port + id */
+        if (na_ucx_class->worker.ucp_listener != NULL) {
+            struct sockaddr_storage ss_addr, listener_ss_addr;
+            socklen_t addrlen;
+
+            memcpy(&ss_addr, &na_ucx_class->self_addr->ss_addr,
+                sizeof(ss_addr));
+            ret = na_ucx_sockaddr_offset_port(&ss_addr, (int) id, &addrlen);
+            NA_CHECK_SUBSYS_NA_ERROR(
+                ctx, error, ret, "Could not get listener address");
+
+            ret = na_ucp_listener_create(na_ucx_worker->ucp_worker,
+                (const struct sockaddr *) &ss_addr, addrlen,
+                (void *) na_ucx_worker, &na_ucx_worker->ucp_listener,
+                &listener_ss_addr);
+            NA_CHECK_SUBSYS_NA_ERROR(ctx, error, ret,
+                "Could not create UCX listener for context %" PRIu8, id);
+        }
+
+        na_ucx_context->na_ucx_worker = na_ucx_worker;
+    }
+
+    hg_atomic_incr32(&na_ucx_class->ncontexts);
+
+    *context_p = (void *) na_ucx_context;
+
+    return NA_SUCCESS;
+
+error:
+    if (na_ucx_worker != NULL) {
+        if (na_ucx_worker->na_ucx_class != NULL)
+            na_ucx_worker_close(na_ucx_worker);
+        free(na_ucx_worker);
+    }
+    free(na_ucx_context);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_context_destroy(na_class_t *na_class, void *context)
+{
+    struct na_ucx_class *na_ucx_class = NA_UCX_CLASS(na_class);
+    struct na_ucx_context *na_ucx_context = (struct na_ucx_context *) context;
+    struct na_ucx_worker *na_ucx_worker = na_ucx_context->na_ucx_worker;
+    na_return_t ret = NA_SUCCESS;
+
+    if (na_ucx_worker != &na_ucx_class->worker) {
+        bool empty;
+
+        /* Check that unexpected op queue is empty */
+        hg_thread_spin_lock(&na_ucx_worker->unexpected_op_queue.lock);
+        empty = TAILQ_EMPTY(&na_ucx_worker->unexpected_op_queue.queue);
+        hg_thread_spin_unlock(&na_ucx_worker->unexpected_op_queue.lock);
+        NA_CHECK_SUBSYS_ERROR(ctx, empty == false, out, ret, NA_BUSY,
+            "Unexpected op queue should be empty");
+
+        /* Check that multi-recv op queue is empty */
+        NA_CHECK_SUBSYS_ERROR(ctx,
+            hg_atomic_get32(&na_ucx_worker->multi_op_count) > 0, out, ret,
+            NA_BUSY, "Multi-recv op queue should be empty");
+
+        na_ucx_worker_close(na_ucx_worker);
+        free(na_ucx_worker);
+    }
+
+    hg_atomic_decr32(&na_ucx_class->ncontexts);
+
+    free(na_ucx_context);
+
+out:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_op_id_t *
-na_ucx_op_create(na_class_t *na_class, unsigned long NA_UNUSED flags)
+na_ucx_op_create(na_class_t *na_class, unsigned long flags)
 {
     struct na_ucx_op_id *na_ucx_op_id = NULL;
 
@@ -3454,23 +4362,53 @@ na_ucx_op_create(na_class_t *na_class, unsigned long NA_UNUSED flags)
 
     memset(na_ucx_op_id, 0, sizeof(struct na_ucx_op_id));
 
+    if (flags & NA_OP_MULTI) {
+        na_return_t ret;
+
+        ret = na_ucx_completion_multi_init(
+            &na_ucx_op_id->completion_multi, NA_UCX_OP_MULTI_CQ_SIZE);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            op, error, ret, "Could not allocate multi-operation queue");
+        na_ucx_op_id->multi_event = true;
+    }
+
     /* Completed by default */
     hg_atomic_init32(&na_ucx_op_id->status, NA_UCX_OP_COMPLETED);
 
 out:
     return (na_op_id_t *) na_ucx_op_id;
+
+error:
+    hg_mem_header_free(NA_UCX_CLASS(na_class)->ucp_request_size,
+        alignof(struct na_ucx_op_id), na_ucx_op_id);
+    return NULL;
 }
 
 /*---------------------------------------------------------------------------*/
 static void
-na_ucx_op_destroy(na_class_t NA_UNUSED *na_class, na_op_id_t *op_id)
+na_ucx_op_destroy(na_class_t *na_class, na_op_id_t *op_id)
 {
     struct na_ucx_op_id *na_ucx_op_id = (struct na_ucx_op_id *) op_id;
 
-    NA_CHECK_SUBSYS_WARNING(op,
-        !(hg_atomic_get32(&na_ucx_op_id->status) & NA_UCX_OP_COMPLETED),
-        "Attempting to use OP ID that was not completed (%s)",
-        na_cb_type_to_string(na_ucx_op_id->completion_data.callback_info.type));
+    if (na_ucx_op_id->multi_event) {
+        /* Multi-events may not be fully completed when they are destroyed */
+        if (hg_atomic_get32(&na_ucx_op_id->status) & NA_UCX_OP_QUEUED) {
+            struct na_ucx_worker *na_ucx_worker =
+                NA_UCX_CONTEXT(na_ucx_op_id->context)->na_ucx_worker;
+
+            hg_thread_spin_lock(&na_ucx_worker->multi_op_queue.lock);
+            TAILQ_REMOVE(
+                &na_ucx_worker->multi_op_queue.queue, na_ucx_op_id, entry);
+            hg_atomic_decr32(&na_ucx_worker->multi_op_count);
+            hg_thread_spin_unlock(&na_ucx_worker->multi_op_queue.lock);
+        }
+        na_ucx_completion_multi_destroy(&na_ucx_op_id->completion_multi);
+    } else
+        NA_CHECK_SUBSYS_WARNING(op,
+            !(hg_atomic_get32(&na_ucx_op_id->status) & NA_UCX_OP_COMPLETED),
+            "Attempting to use OP ID that was not completed (%s)",
+            na_cb_type_to_string(
+                na_ucx_op_id->completion_data.callback_info.type));
 
     hg_mem_header_free(NA_UCX_CLASS(na_class)->ucp_request_size,
         alignof(struct na_ucx_op_id), na_ucx_op_id);
@@ -3518,7 +4456,8 @@ na_ucx_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p)
     /* Lookup address from table */
     addr_key = (ucs_sock_addr_t){
         .addr = hostname_res->ai_addr, .addrlen = hostname_res->ai_addrlen};
-    na_ucx_addr = na_ucx_addr_map_lookup(&na_ucx_class->addr_map, &addr_key);
+    na_ucx_addr =
+        na_ucx_addr_map_lookup(&na_ucx_class->worker.addr_map, &addr_key);
 
     if (!na_ucx_addr) {
         na_return_t na_ret;
@@ -3527,8 +4466,8 @@ na_ucx_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p)
             addr, "Inserting new address (%s:%s)", host_string, serv_string);
 
         /* Insert new entry and create new address if needed */
-        na_ret = na_ucx_addr_map_insert(na_ucx_class, &na_ucx_class->addr_map,
-            &addr_key, NULL, &na_ucx_addr);
+        na_ret = na_ucx_addr_map_insert(
+            &na_ucx_class->worker, &addr_key, NULL, 0, &na_ucx_addr);
         freeaddrinfo(hostname_res);
         NA_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS && na_ret != NA_EXIST,
             error, ret, na_ret, "Could not insert new address");
@@ -3693,7 +4632,7 @@ na_ucx_addr_deserialize(
     memcpy(worker_addr, buf_ptr, worker_addr_len);
 
     /* Create new address */
-    ret = na_ucx_addr_create(na_ucx_class, NULL, &na_ucx_addr);
+    ret = na_ucx_addr_create(&na_ucx_class->worker, NULL, &na_ucx_addr);
     NA_CHECK_SUBSYS_NA_ERROR(addr, error, ret, "Could not create address");
 
     /* Attach worker address */
@@ -3702,7 +4641,7 @@ na_ucx_addr_deserialize(
     na_ucx_addr->worker_addr_alloc = true;
 
     /* Create EP */
-    ret = na_ucp_connect_worker(na_ucx_class->ucp_worker, worker_addr,
+    ret = na_ucp_connect_worker(na_ucx_class->worker.ucp_worker, worker_addr,
         na_ucp_ep_error_cb, na_ucx_addr, &na_ucx_addr->ucp_ep);
     NA_CHECK_SUBSYS_NA_ERROR(
         addr, error, ret, "Could not connect to remote worker");
@@ -3745,11 +4684,21 @@ na_ucx_msg_get_max_tag(const na_class_t NA_UNUSED *na_class)
 
 /*---------------------------------------------------------------------------*/
 static void *
-na_ucx_msg_buf_alloc(na_class_t *na_class, size_t size,
-    unsigned long NA_UNUSED flags, void **plugin_data_p)
+na_ucx_msg_buf_alloc(
+    na_class_t *na_class, size_t size, unsigned long flags, void **plugin_data_p)
 {
     void *mem_ptr;
 
+    /* Multi-recv buffers are only filled by copy and do not need to be
+     * registered, they are also too large for the memory pool */
+    if (flags & NA_MULTI_RECV) {
+        mem_ptr = hg_mem_aligned_alloc(hg_mem_get_page_size(), size);
+        NA_CHECK_SUBSYS_ERROR_NORET(mem, mem_ptr == NULL, done,
+            "Could not allocate %zu bytes", size);
+        *plugin_data_p = NULL;
+        goto done;
+    }
+
 #ifdef NA_UCX_HAS_MEM_POOL
     mem_ptr = hg_mem_pool_alloc(
         NA_UCX_CLASS(na_class)->mem_pool, size, plugin_data_p);
@@ -3770,6 +4719,12 @@ done:
 static void
 na_ucx_msg_buf_free(na_class_t *na_class, void *buf, void *plugin_data)
 {
+    /* Multi-recv buffers have no registration handle */
+    if (plugin_data == NULL) {
+        hg_mem_aligned_free(buf);
+        return;
+    }
+
 #ifdef NA_UCX_HAS_MEM_POOL
     hg_mem_pool_free(NA_UCX_CLASS(na_class)->mem_pool, buf, plugin_data);
 #else
@@ -3784,7 +4739,7 @@ static na_return_t
 na_ucx_msg_send_unexpected(na_class_t NA_UNUSED *na_class,
     na_context_t *context, na_cb_t callback, void *arg, const void *buf,
     size_t buf_size, void NA_UNUSED *plugin_data, na_addr_t *dest_addr,
-    uint8_t NA_UNUSED dest_id, na_tag_t tag, na_op_id_t *op_id)
+    uint8_t dest_id, na_tag_t tag, na_op_id_t *op_id)
 {
     struct na_ucx_addr *na_ucx_addr = (struct na_ucx_addr *) dest_addr;
     struct na_ucx_op_id *na_ucx_op_id = (struct na_ucx_op_id *) op_id;
@@ -3798,12 +4753,14 @@ na_ucx_msg_send_unexpected(na_class_t NA_UNUSED *na_class,
         ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
         na_cb_type_to_string(na_ucx_op_id->completion_data.callback_info.type));
 
+    /* Use EP of this context to reach remote context */
+    ret = na_ucx_addr_route(NA_UCX_CONTEXT(context)->na_ucx_worker,
+        na_ucx_addr, dest_id, &na_ucx_addr);
+    NA_CHECK_SUBSYS_NA_ERROR(msg, error, ret, "Could not route address");
+
     /* Check addr to ensure the EP for that addr is still valid */
     if (!(hg_atomic_get32(&na_ucx_addr->status) & NA_UCX_ADDR_RESOLVED)) {
-        struct na_ucx_class *na_ucx_class = NA_UCX_CLASS(na_class);
-
-        ret = na_ucx_addr_map_update(
-            na_ucx_class, &na_ucx_class->addr_map, na_ucx_addr);
+        ret = na_ucx_addr_map_update(na_ucx_addr);
         NA_CHECK_SUBSYS_NA_ERROR(
             addr, error, ret, "Could not update NA UCX address");
     }
@@ -3832,9 +4789,9 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucx_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
-    na_cb_t callback, void *arg, void *buf, size_t buf_size,
-    void NA_UNUSED *plugin_data, na_op_id_t *op_id)
+na_ucx_msg_recv_unexpected(na_class_t NA_UNUSED *na_class,
+    na_context_t *context, na_cb_t callback, void *arg, void *buf,
+    size_t buf_size, void NA_UNUSED *plugin_data, na_op_id_t *op_id)
 {
     struct na_ucx_op_id *na_ucx_op_id = (struct na_ucx_op_id *) op_id;
     na_return_t ret;
@@ -3854,7 +4811,58 @@ na_ucx_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
     na_ucx_op_id->info.msg = (struct na_ucx_msg_info){
         .buf.ptr = buf, .buf_size = buf_size, .tag = (ucp_tag_t) 0};
 
-    na_ucp_am_recv(NA_UCX_CLASS(na_class), na_ucx_op_id);
+    na_ucp_am_recv(NA_UCX_CONTEXT(context)->na_ucx_worker, na_ucx_op_id);
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_msg_multi_recv_unexpected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, void *buf, size_t buf_size,
+    void NA_UNUSED *plugin_data, na_op_id_t *op_id)
+{
+    struct na_ucx_worker *na_ucx_worker = NA_UCX_CONTEXT(context)->na_ucx_worker;
+    struct na_ucx_op_id *na_ucx_op_id = (struct na_ucx_op_id *) op_id;
+    na_return_t ret;
+
+    /* Check op_id */
+    NA_CHECK_SUBSYS_ERROR(op, na_ucx_op_id == NULL, error, ret, NA_INVALID_ARG,
+        "Invalid operation ID");
+    NA_CHECK_SUBSYS_ERROR(op, !na_ucx_op_id->multi_event, error, ret,
+        NA_INVALID_ARG, "Operation ID was not created with NA_OP_MULTI");
+    NA_CHECK_SUBSYS_ERROR(op,
+        !(hg_atomic_get32(&na_ucx_op_id->status) & NA_UCX_OP_COMPLETED), error,
+        ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
+        na_cb_type_to_string(na_ucx_op_id->completion_data.callback_info.type));
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size < NA_UCX_CLASS(na_class)->unexpected_size_max, error, ret,
+        NA_INVALID_ARG,
+        "Multi-recv buffer size (%zu) is smaller than max unexpected size "
+        "(%zu)",
+        buf_size, NA_UCX_CLASS(na_class)->unexpected_size_max);
+
+    NA_UCX_OP_RESET(
+        na_ucx_op_id, context, NA_CB_MULTI_RECV_UNEXPECTED, callback, arg, NULL);
+
+    /* We assume buf remains valid (safe because we pre-allocate buffers) */
+    na_ucx_op_id->info.msg = (struct na_ucx_msg_info){.buf.ptr = buf,
+        .buf_size = buf_size,
+        .buf_offset = 0,
+        .tag = (ucp_tag_t) 0};
+
+    /* Messages are copied into the buffer from the AM handler */
+    hg_thread_spin_lock(&na_ucx_worker->multi_op_queue.lock);
+    TAILQ_INSERT_TAIL(&na_ucx_worker->multi_op_queue.queue, na_ucx_op_id, entry);
+    hg_atomic_or32(&na_ucx_op_id->status, NA_UCX_OP_QUEUED);
+    hg_atomic_incr32(&na_ucx_worker->multi_op_count);
+    hg_thread_spin_unlock(&na_ucx_worker->multi_op_queue.lock);
+
+    /* Consume messages that arrived before the buffer was posted */
+    na_ucx_multi_recv_drain(na_ucx_worker);
 
     return NA_SUCCESS;
 
@@ -3867,7 +4875,7 @@ static na_return_t
 na_ucx_msg_send_expected(na_class_t NA_UNUSED *na_class, na_context_t *context,
     na_cb_t callback, void *arg, const void *buf, size_t buf_size,
     void NA_UNUSED *plugin_data, na_addr_t *dest_addr,
-    uint8_t NA_UNUSED dest_id, na_tag_t tag, na_op_id_t *op_id)
+    uint8_t dest_id, na_tag_t tag, na_op_id_t *op_id)
 {
     struct na_ucx_addr *na_ucx_addr = (struct na_ucx_addr *) dest_addr;
     struct na_ucx_op_id *na_ucx_op_id = (struct na_ucx_op_id *) op_id;
@@ -3881,12 +4889,14 @@ na_ucx_msg_send_expected(na_class_t NA_UNUSED *na_class, na_context_t *context,
         ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
         na_cb_type_to_string(na_ucx_op_id->completion_data.callback_info.type));
 
+    /* Use EP of this context to reach remote context */
+    ret = na_ucx_addr_route(NA_UCX_CONTEXT(context)->na_ucx_worker,
+        na_ucx_addr, dest_id, &na_ucx_addr);
+    NA_CHECK_SUBSYS_NA_ERROR(msg, error, ret, "Could not route address");
+
     /* Check addr to ensure the EP for that addr is still valid */
     if (!(hg_atomic_get32(&na_ucx_addr->status) & NA_UCX_ADDR_RESOLVED)) {
-        struct na_ucx_class *na_ucx_class = NA_UCX_CLASS(na_class);
-
-        ret = na_ucx_addr_map_update(
-            na_ucx_class, &na_ucx_class->addr_map, na_ucx_addr);
+        ret = na_ucx_addr_map_update(na_ucx_addr);
         NA_CHECK_SUBSYS_NA_ERROR(
             addr, error, ret, "Could not update NA UCX address");
     }
@@ -3915,9 +4925,9 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucx_msg_recv_expected(na_class_t *na_class, na_context_t *context,
-    na_cb_t callback, void *arg, void *buf, size_t buf_size,
-    void NA_UNUSED *plugin_data, na_addr_t *source_addr,
+na_ucx_msg_recv_expected(na_class_t NA_UNUSED *na_class,
+    na_context_t *context, na_cb_t callback, void *arg, void *buf,
+    size_t buf_size, void NA_UNUSED *plugin_data, na_addr_t *source_addr,
     uint8_t NA_UNUSED source_id, na_tag_t tag, na_op_id_t *op_id)
 {
     struct na_ucx_addr *na_ucx_addr = (struct na_ucx_addr *) source_addr;
@@ -3939,8 +4949,8 @@ na_ucx_msg_recv_expected(na_class_t *na_class, na_context_t *context,
     na_ucx_op_id->info.msg = (struct na_ucx_msg_info){
         .buf.ptr = buf, .buf_size = buf_size, .tag = (ucp_tag_t) tag};
 
-    ret = na_ucp_msg_recv(NA_UCX_CLASS(na_class)->ucp_worker, buf, buf_size,
-        (ucp_tag_t) tag, na_ucx_op_id);
+    ret = na_ucp_msg_recv(NA_UCX_CONTEXT(context)->na_ucx_worker->ucp_worker,
+        buf, buf_size, (ucp_tag_t) tag, na_ucx_op_id);
     NA_CHECK_SUBSYS_NA_ERROR(
         msg, release, ret, "Could not post expected msg recv");
 
@@ -3970,6 +4980,58 @@ na_ucx_mem_handle_create(na_class_t NA_UNUSED *na_class, void *buf,
     na_ucx_mem_handle->desc.base = (uint64_t) buf;
     na_ucx_mem_handle->desc.flags = flags & 0xff;
     na_ucx_mem_handle->desc.len = (uint64_t) buf_size;
+    na_ucx_mem_handle->desc.iovcnt = 1;
+    na_ucx_mem_handle->seg.desc.base = na_ucx_mem_handle->desc.base;
+    na_ucx_mem_handle->seg.desc.len = na_ucx_mem_handle->desc.len;
+    na_ucx_mem_handle->segs = &na_ucx_mem_handle->seg;
+    hg_atomic_init32(&na_ucx_mem_handle->type, NA_UCX_MEM_HANDLE_LOCAL);
+    hg_thread_mutex_init(&na_ucx_mem_handle->rkey_unpack_lock);
+
+    *mem_handle_p = (na_mem_handle_t *) na_ucx_mem_handle;
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_mem_handle_create_segments(na_class_t NA_UNUSED *na_class,
+    struct na_segment *segments, size_t segment_count, unsigned long flags,
+    na_mem_handle_t **mem_handle_p)
+{
+    struct na_ucx_mem_handle *na_ucx_mem_handle = NULL;
+    na_return_t ret;
+    size_t i;
+
+    NA_CHECK_SUBSYS_WARNING(mem, segment_count == 1, "Segment count is 1");
+
+    /* Each segment carries its own rkey, keep serialized handles small */
+    NA_CHECK_SUBSYS_ERROR(fatal, segment_count > NA_UCX_MEM_SEGMENT_MAX, error,
+        ret, NA_INVALID_ARG, "Segment count exceeds limit (%d)",
+        NA_UCX_MEM_SEGMENT_MAX);
+
+    /* Allocate memory handle */
+    na_ucx_mem_handle = (struct na_ucx_mem_handle *) calloc(
+        1, sizeof(struct na_ucx_mem_handle));
+    NA_CHECK_SUBSYS_ERROR(mem, na_ucx_mem_handle == NULL, error, ret, NA_NOMEM,
+        "Could not allocate NA UCX memory handle");
+
+    /* Allocate segments */
+    na_ucx_mem_handle->segs = (struct na_ucx_mem_seg *) calloc(
+        segment_count, sizeof(struct na_ucx_mem_seg));
+    NA_CHECK_SUBSYS_ERROR(mem, na_ucx_mem_handle->segs == NULL, error, ret,
+        NA_NOMEM, "Could not allocate segment array");
+
+    for (i = 0; i < segment_count; i++) {
+        na_ucx_mem_handle->segs[i].desc.base = (uint64_t) segments[i].base;
+        na_ucx_mem_handle->segs[i].desc.len = (uint64_t) segments[i].len;
+        na_ucx_mem_handle->desc.len += (uint64_t) segments[i].len;
+    }
+    na_ucx_mem_handle->desc.base = na_ucx_mem_handle->segs[0].desc.base;
+    na_ucx_mem_handle->desc.iovcnt = (uint64_t) segment_count;
+    na_ucx_mem_handle->desc.flags = flags & 0xff;
     hg_atomic_init32(&na_ucx_mem_handle->type, NA_UCX_MEM_HANDLE_LOCAL);
     hg_thread_mutex_init(&na_ucx_mem_handle->rkey_unpack_lock);
 
@@ -3978,6 +5040,10 @@ na_ucx_mem_handle_create(na_class_t NA_UNUSED *na_class, void *buf,
     return NA_SUCCESS;
 
 error:
+    if (na_ucx_mem_handle) {
+        free(na_ucx_mem_handle->segs);
+        free(na_ucx_mem_handle);
+    }
     return ret;
 }
 
@@ -3988,31 +5054,44 @@ na_ucx_mem_handle_free(
 {
     struct na_ucx_mem_handle *na_ucx_mem_handle =
         (struct na_ucx_mem_handle *) mem_handle;
+    size_t i;
 
     switch (hg_atomic_get32(&na_ucx_mem_handle->type)) {
         case NA_UCX_MEM_HANDLE_LOCAL:
             /* nothing to do here */
             break;
         case NA_UCX_MEM_HANDLE_REMOTE_UNPACKED:
-            ucp_rkey_destroy(na_ucx_mem_handle->ucp_mr.rkey);
+            for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++)
+                ucp_rkey_destroy(na_ucx_mem_handle->segs[i].ucp_mr.rkey);
             NA_FALLTHROUGH;
         case NA_UCX_MEM_HANDLE_REMOTE_PACKED:
-            free(na_ucx_mem_handle->rkey_buf);
+            for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++)
+                free(na_ucx_mem_handle->segs[i].rkey_buf);
             break;
         default:
             NA_LOG_SUBSYS_ERROR(mem, "Invalid memory handle type");
             break;
     }
 
+    na_ucx_mem_segs_free(na_ucx_mem_handle);
     hg_thread_mutex_destroy(&na_ucx_mem_handle->rkey_unpack_lock);
     free(na_ucx_mem_handle);
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+na_ucx_mem_segs_free(struct na_ucx_mem_handle *na_ucx_mem_handle)
+{
+    if (na_ucx_mem_handle->segs != &na_ucx_mem_handle->seg)
+        free(na_ucx_mem_handle->segs);
+    na_ucx_mem_handle->segs = NULL;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE size_t
 na_ucx_mem_handle_get_max_segments(const na_class_t NA_UNUSED *na_class)
 {
-    return 1;
+    return NA_UCX_MEM_SEGMENT_MAX;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4025,12 +5104,10 @@ na_ucx_mem_register(na_class_t *na_class, na_mem_handle_t *mem_handle,
     ucp_mem_map_params_t mem_map_params = {
         .field_mask =
             UCP_MEM_MAP_PARAM_FIELD_ADDRESS | UCP_MEM_MAP_PARAM_FIELD_LENGTH |
-            UCP_MEM_MAP_PARAM_FIELD_PROT | UCP_MEM_MAP_PARAM_FIELD_MEMORY_TYPE,
-        .address = (void *) na_ucx_mem_handle->desc.base,
-        .length = (size_t) na_ucx_mem_handle->desc.len};
-    size_t rkey_buf_size;
+            UCP_MEM_MAP_PARAM_FIELD_PROT | UCP_MEM_MAP_PARAM_FIELD_MEMORY_TYPE};
     ucs_status_t status;
     na_return_t ret;
+    size_t i = 0;
 
     NA_CHECK_SUBSYS_ERROR(mem,
         hg_atomic_get32(&na_ucx_mem_handle->type) != NA_UCX_MEM_HANDLE_LOCAL,
@@ -4079,25 +5156,50 @@ na_ucx_mem_register(na_class_t *na_class, na_mem_handle_t *mem_handle,
             break;
     }
 
-    /* Register memory */
-    status = ucp_mem_map(NA_UCX_CLASS(na_class)->ucp_context, &mem_map_params,
-        &na_ucx_mem_handle->ucp_mr.mem);
-    NA_CHECK_SUBSYS_ERROR(mem, status != UCS_OK, error, ret,
-        na_ucs_status_to_na(status), "ucp_mem_map() failed (%s)",
-        ucs_status_string(status));
+    /* Register each segment separately */
+    na_ucx_mem_handle->desc.rkey_buf_size = 0;
+    for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++) {
+        struct na_ucx_mem_seg *seg = &na_ucx_mem_handle->segs[i];
+        size_t rkey_buf_size;
 
-    /* Keep a copy of the rkey to share with the remote */
-    /* TODO that could have been a good candidate for publish */
-    status = ucp_rkey_pack(NA_UCX_CLASS(na_class)->ucp_context,
-        na_ucx_mem_handle->ucp_mr.mem, &na_ucx_mem_handle->rkey_buf,
-        &rkey_buf_size);
-    NA_CHECK_SUBSYS_ERROR(mem, status != UCS_OK, error, ret,
-        na_ucs_status_to_na(status), "ucp_rkey_pack() failed (%s)",
-        ucs_status_string(status));
-    na_ucx_mem_handle->desc.rkey_buf_size = (uint64_t) rkey_buf_size;
+        mem_map_params.address = (void *) seg->desc.base;
+        mem_map_params.length = (size_t) seg->desc.len;
+
+        /* Register memory */
+        status = ucp_mem_map(NA_UCX_CLASS(na_class)->ucp_context,
+            &mem_map_params, &seg->ucp_mr.mem);
+        NA_CHECK_SUBSYS_ERROR(mem, status != UCS_OK, unmap, ret,
+            na_ucs_status_to_na(status), "ucp_mem_map() failed (%s)",
+            ucs_status_string(status));
+
+        /* Keep a copy of the rkey to share with the remote */
+        /* TODO that could have been a good candidate for publish */
+        status = ucp_rkey_pack(NA_UCX_CLASS(na_class)->ucp_context,
+            seg->ucp_mr.mem, &seg->rkey_buf, &rkey_buf_size);
+        if (status != UCS_OK) {
+            ucp_mem_unmap(NA_UCX_CLASS(na_class)->ucp_context, seg->ucp_mr.mem);
+            seg->ucp_mr.mem = NULL;
+            NA_GOTO_SUBSYS_ERROR(mem, unmap, ret, na_ucs_status_to_na(status),
+                "ucp_rkey_pack() failed (%s)", ucs_status_string(status));
+        }
+        seg->desc.rkey_buf_size = (uint64_t) rkey_buf_size;
+        na_ucx_mem_handle->desc.rkey_buf_size += (uint64_t) rkey_buf_size;
+    }
 
     return NA_SUCCESS;
 
+unmap:
+    /* Unregister segments that were already registered */
+    while (i-- > 0) {
+        struct na_ucx_mem_seg *seg = &na_ucx_mem_handle->segs[i];
+
+        ucp_rkey_buffer_release(seg->rkey_buf);
+        seg->rkey_buf = NULL;
+        ucp_mem_unmap(NA_UCX_CLASS(na_class)->ucp_context, seg->ucp_mr.mem);
+        seg->ucp_mr.mem = NULL;
+    }
+    na_ucx_mem_handle->desc.rkey_buf_size = 0;
+
 error:
     return ret;
 }
@@ -4110,23 +5212,28 @@ na_ucx_mem_deregister(na_class_t *na_class, na_mem_handle_t *mem_handle)
         (struct na_ucx_mem_handle *) mem_handle;
     ucs_status_t status;
     na_return_t ret;
+    size_t i;
 
     NA_CHECK_SUBSYS_ERROR(mem,
         hg_atomic_get32(&na_ucx_mem_handle->type) != NA_UCX_MEM_HANDLE_LOCAL,
         error, ret, NA_OPNOTSUPPORTED,
         "cannot unregister memory on remote handle");
 
-    /* Deregister memory */
-    status = ucp_mem_unmap(
-        NA_UCX_CLASS(na_class)->ucp_context, na_ucx_mem_handle->ucp_mr.mem);
-    NA_CHECK_SUBSYS_ERROR(mem, status != UCS_OK, error, ret,
-        na_ucs_status_to_na(status), "ucp_mem_unmap() failed (%s)",
-        ucs_status_string(status));
-    na_ucx_mem_handle->ucp_mr.mem = NULL;
+    for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++) {
+        struct na_ucx_mem_seg *seg = &na_ucx_mem_handle->segs[i];
 
-    /* TODO that could have been a good candidate for unpublish */
-    ucp_rkey_buffer_release(na_ucx_mem_handle->rkey_buf);
-    na_ucx_mem_handle->rkey_buf = NULL;
+        /* Deregister memory */
+        status =
+            ucp_mem_unmap(NA_UCX_CLASS(na_class)->ucp_context, seg->ucp_mr.mem);
+        NA_CHECK_SUBSYS_ERROR(mem, status != UCS_OK, error, ret,
+            na_ucs_status_to_na(status), "ucp_mem_unmap() failed (%s)",
+            ucs_status_string(status));
+        seg->ucp_mr.mem = NULL;
+
+        /* TODO that could have been a good candidate for unpublish */
+        ucp_rkey_buffer_release(seg->rkey_buf);
+        seg->rkey_buf = NULL;
+    }
 
     return NA_SUCCESS;
 
@@ -4141,8 +5248,12 @@ na_ucx_mem_handle_get_serialize_size(
 {
     struct na_ucx_mem_handle *na_ucx_mem_handle =
         (struct na_ucx_mem_handle *) mem_handle;
+    size_t seg_desc_size = (na_ucx_mem_handle->desc.iovcnt > 1)
+                               ? na_ucx_mem_handle->desc.iovcnt *
+                                     sizeof(struct na_ucx_mem_seg_desc)
+                               : 0;
 
-    return sizeof(na_ucx_mem_handle->desc) +
+    return sizeof(na_ucx_mem_handle->desc) + seg_desc_size +
            na_ucx_mem_handle->desc.rkey_buf_size;
 }
 
@@ -4156,14 +5267,29 @@ na_ucx_mem_handle_serialize(na_class_t NA_UNUSED *na_class, void *buf,
     char *buf_ptr = (char *) buf;
     size_t buf_size_left = buf_size;
     na_return_t ret;
+    size_t i;
 
     /* Descriptor info */
     NA_ENCODE(error, ret, buf_ptr, buf_size_left, &na_ucx_mem_handle->desc,
         struct na_ucx_mem_desc);
 
-    /* Encode rkey */
-    memcpy(buf_ptr, na_ucx_mem_handle->rkey_buf,
-        na_ucx_mem_handle->desc.rkey_buf_size);
+    /* Segment descriptors */
+    if (na_ucx_mem_handle->desc.iovcnt > 1) {
+        for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++)
+            NA_ENCODE(error, ret, buf_ptr, buf_size_left,
+                &na_ucx_mem_handle->segs[i].desc, struct na_ucx_mem_seg_desc);
+    }
+
+    /* Encode rkeys */
+    NA_CHECK_SUBSYS_ERROR(mem,
+        buf_size_left < na_ucx_mem_handle->desc.rkey_buf_size, error, ret,
+        NA_OVERFLOW, "Insufficient size left to copy rkey buffer");
+    for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++) {
+        const struct na_ucx_mem_seg *seg = &na_ucx_mem_handle->segs[i];
+
+        memcpy(buf_ptr, seg->rkey_buf, seg->desc.rkey_buf_size);
+        buf_ptr += seg->desc.rkey_buf_size;
+    }
 
     return NA_SUCCESS;
 
@@ -4179,71 +5305,114 @@ na_ucx_mem_handle_deserialize(na_class_t NA_UNUSED *na_class,
     struct na_ucx_mem_handle *na_ucx_mem_handle = NULL;
     const char *buf_ptr = (const char *) buf;
     size_t buf_size_left = buf_size;
+    uint64_t rkey_buf_size = 0;
     na_return_t ret;
+    size_t i;
 
-    na_ucx_mem_handle =
-        (struct na_ucx_mem_handle *) malloc(sizeof(struct na_ucx_mem_handle));
+    na_ucx_mem_handle = (struct na_ucx_mem_handle *) calloc(
+        1, sizeof(struct na_ucx_mem_handle));
     NA_CHECK_SUBSYS_ERROR(mem, na_ucx_mem_handle == NULL, error, ret, NA_NOMEM,
         "Could not allocate NA UCX memory handle");
-    na_ucx_mem_handle->rkey_buf = NULL;
-    na_ucx_mem_handle->ucp_mr.rkey = NULL;
     hg_atomic_init32(&na_ucx_mem_handle->type, NA_UCX_MEM_HANDLE_REMOTE_PACKED);
     hg_thread_mutex_init(&na_ucx_mem_handle->rkey_unpack_lock);
 
     /* Descriptor info */
     NA_DECODE(error, ret, buf_ptr, buf_size_left, &na_ucx_mem_handle->desc,
         struct na_ucx_mem_desc);
+    NA_CHECK_SUBSYS_ERROR(mem,
+        na_ucx_mem_handle->desc.iovcnt == 0 ||
+            na_ucx_mem_handle->desc.iovcnt > NA_UCX_MEM_SEGMENT_MAX,
+        error, ret, NA_PROTOCOL_ERROR, "Invalid segment count (%" PRIu64 ")",
+        na_ucx_mem_handle->desc.iovcnt);
+
+    /* Segment descriptors */
+    if (na_ucx_mem_handle->desc.iovcnt > 1) {
+        na_ucx_mem_handle->segs = (struct na_ucx_mem_seg *) calloc(
+            (size_t) na_ucx_mem_handle->desc.iovcnt,
+            sizeof(struct na_ucx_mem_seg));
+        NA_CHECK_SUBSYS_ERROR(mem, na_ucx_mem_handle->segs == NULL, error, ret,
+            NA_NOMEM, "Could not allocate segment array");
+
+        for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++) {
+            NA_DECODE(error, ret, buf_ptr, buf_size_left,
+                &na_ucx_mem_handle->segs[i].desc, struct na_ucx_mem_seg_desc);
+            rkey_buf_size += na_ucx_mem_handle->segs[i].desc.rkey_buf_size;
+        }
+        NA_CHECK_SUBSYS_ERROR(mem,
+            rkey_buf_size != na_ucx_mem_handle->desc.rkey_buf_size, error, ret,
+            NA_PROTOCOL_ERROR, "Inconsistent rkey buffer size");
+    } else {
+        na_ucx_mem_handle->seg.desc.base = na_ucx_mem_handle->desc.base;
+        na_ucx_mem_handle->seg.desc.len = na_ucx_mem_handle->desc.len;
+        na_ucx_mem_handle->seg.desc.rkey_buf_size =
+            na_ucx_mem_handle->desc.rkey_buf_size;
+        na_ucx_mem_handle->segs = &na_ucx_mem_handle->seg;
+    }
 
-    /* Packed rkey */
-    na_ucx_mem_handle->rkey_buf = malloc(na_ucx_mem_handle->desc.rkey_buf_size);
-    NA_CHECK_SUBSYS_ERROR(mem, na_ucx_mem_handle->rkey_buf == NULL, error, ret,
-        NA_NOMEM, "Could not allocate rkey buffer");
-
+    /* Packed rkeys */
     NA_CHECK_SUBSYS_ERROR(mem,
         buf_size_left < na_ucx_mem_handle->desc.rkey_buf_size, error, ret,
         NA_OVERFLOW, "Insufficient size left to copy rkey buffer");
-    memcpy(na_ucx_mem_handle->rkey_buf, buf_ptr,
-        na_ucx_mem_handle->desc.rkey_buf_size);
+    for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++) {
+        struct na_ucx_mem_seg *seg = &na_ucx_mem_handle->segs[i];
+
+        seg->rkey_buf = malloc(seg->desc.rkey_buf_size);
+        NA_CHECK_SUBSYS_ERROR(mem, seg->rkey_buf == NULL, error, ret, NA_NOMEM,
+            "Could not allocate rkey buffer");
+        memcpy(seg->rkey_buf, buf_ptr, seg->desc.rkey_buf_size);
+        buf_ptr += seg->desc.rkey_buf_size;
+    }
 
     *mem_handle_p = (na_mem_handle_t *) na_ucx_mem_handle;
 
     return NA_SUCCESS;
 
 error:
+    if (na_ucx_mem_handle) {
+        if (na_ucx_mem_handle->segs != NULL) {
+            for (i = 0; i < na_ucx_mem_handle->desc.iovcnt; i++)
+                free(na_ucx_mem_handle->segs[i].rkey_buf);
+            na_ucx_mem_segs_free(na_ucx_mem_handle);
+        }
+        hg_thread_mutex_destroy(&na_ucx_mem_handle->rkey_unpack_lock);
+        free(na_ucx_mem_handle);
+    }
     return ret;
 }
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucx_put(na_class_t *na_class, na_context_t *context, na_cb_t callback,
-    void *arg, na_mem_handle_t *local_mem_handle, na_offset_t local_offset,
-    na_mem_handle_t *remote_mem_handle, na_offset_t remote_offset,
-    size_t length, na_addr_t *remote_addr, uint8_t NA_UNUSED remote_id,
-    na_op_id_t *op_id)
+na_ucx_put(na_class_t NA_UNUSED *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, na_mem_handle_t *local_mem_handle,
+    na_offset_t local_offset, na_mem_handle_t *remote_mem_handle,
+    na_offset_t remote_offset, size_t length, na_addr_t *remote_addr,
+    uint8_t remote_id, na_op_id_t *op_id)
 {
-    return na_ucx_rma(NA_UCX_CLASS(na_class), context, NA_CB_PUT, callback, arg,
+    return na_ucx_rma(context, NA_CB_PUT, callback, arg,
         (struct na_ucx_mem_handle *) local_mem_handle, local_offset,
         (struct na_ucx_mem_handle *) remote_mem_handle, remote_offset, length,
-        (struct na_ucx_addr *) remote_addr, (struct na_ucx_op_id *) op_id);
+        (struct na_ucx_addr *) remote_addr, remote_id,
+        (struct na_ucx_op_id *) op_id);
 }
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ucx_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
-    void *arg, na_mem_handle_t *local_mem_handle, na_offset_t local_offset,
-    na_mem_handle_t *remote_mem_handle, na_offset_t remote_offset,
-    size_t length, na_addr_t *remote_addr, uint8_t NA_UNUSED remote_id,
-    na_op_id_t *op_id)
+na_ucx_get(na_class_t NA_UNUSED *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, na_mem_handle_t *local_mem_handle,
+    na_offset_t local_offset, na_mem_handle_t *remote_mem_handle,
+    na_offset_t remote_offset, size_t length, na_addr_t *remote_addr,
+    uint8_t remote_id, na_op_id_t *op_id)
 {
-    return na_ucx_rma(NA_UCX_CLASS(na_class), context, NA_CB_GET, callback, arg,
+    return na_ucx_rma(context, NA_CB_GET, callback, arg,
         (struct na_ucx_mem_handle *) local_mem_handle, local_offset,
         (struct na_ucx_mem_handle *) remote_mem_handle, remote_offset, length,
-        (struct na_ucx_addr *) remote_addr, (struct na_ucx_op_id *) op_id);
+        (struct na_ucx_addr *) remote_addr, remote_id,
+        (struct na_ucx_op_id *) op_id);
 }
 
 /*---------------------------------------------------------------------------*/
 static int
-na_ucx_poll_get_fd(na_class_t *na_class, na_context_t NA_UNUSED *context)
+na_ucx_poll_get_fd(na_class_t *na_class, na_context_t *context)
 {
     struct na_ucx_class *na_ucx_class = NA_UCX_CLASS(na_class);
     ucs_status_t status;
@@ -4252,7 +5421,8 @@ na_ucx_poll_get_fd(na_class_t *na_class, na_context_t NA_UNUSED *context)
     if (na_ucx_class->no_wait)
         return -1;
 
-    status = ucp_worker_get_efd(na_ucx_class->ucp_worker, &fd);
+    status = ucp_worker_get_efd(
+        NA_UCX_CONTEXT(context)->na_ucx_worker->ucp_worker, &fd);
     NA_CHECK_SUBSYS_ERROR(poll, status != UCS_OK, error, fd, -1,
         "ucp_worker_get_efd() failed (%s)", ucs_status_string(status));
 
@@ -4264,7 +5434,7 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE bool
-na_ucx_poll_try_wait(na_class_t *na_class, na_context_t NA_UNUSED *context)
+na_ucx_poll_try_wait(na_class_t *na_class, na_context_t *context)
 {
     struct na_ucx_class *na_ucx_class = NA_UCX_CLASS(na_class);
     ucs_status_t status;
@@ -4272,7 +5442,7 @@ na_ucx_poll_try_wait(na_class_t *na_class, na_context_t NA_UNUSED *context)
     if (na_ucx_class->no_wait)
         return false;
 
-    status = ucp_worker_arm(na_ucx_class->ucp_worker);
+    status = ucp_worker_arm(NA_UCX_CONTEXT(context)->na_ucx_worker->ucp_worker);
     if (status == UCS_ERR_BUSY) {
         /* Events have already arrived */
         return false;
@@ -4287,11 +5457,17 @@ na_ucx_poll_try_wait(na_class_t *na_class, na_context_t NA_UNUSED *context)
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE na_return_t
-na_ucx_poll(na_class_t *na_class, na_context_t NA_UNUSED *context,
+na_ucx_poll(na_class_t NA_UNUSED *na_class, na_context_t *context,
     unsigned int *count_p)
 {
-    unsigned int count =
-        ucp_worker_progress(NA_UCX_CLASS(na_class)->ucp_worker);
+    struct na_ucx_worker *na_ucx_worker = NA_UCX_CONTEXT(context)->na_ucx_worker;
+    unsigned int count = ucp_worker_progress(na_ucx_worker->ucp_worker);
+
+    /* Messages may have been queued while multi-recv events were pending */
+    if (hg_atomic_get32(&na_ucx_worker->multi_op_count) > 0 &&
+        !STAILQ_EMPTY(&na_ucx_worker->unexpected_msg_queue.queue))
+        na_ucx_multi_recv_drain(na_ucx_worker);
+
     if (count_p != NULL)
         *count_p = count;
 
@@ -4301,8 +5477,9 @@ na_ucx_poll(na_class_t *na_class, na_context_t NA_UNUSED *context,
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ucx_cancel(
-    na_class_t *na_class, na_context_t NA_UNUSED *context, na_op_id_t *op_id)
+    na_class_t NA_UNUSED *na_class, na_context_t *context, na_op_id_t *op_id)
 {
+    struct na_ucx_worker *na_ucx_worker = NA_UCX_CONTEXT(context)->na_ucx_worker;
     struct na_ucx_op_id *na_ucx_op_id = (struct na_ucx_op_id *) op_id;
     na_cb_type_t cb_type;
     int32_t status;
@@ -4323,8 +5500,7 @@ na_ucx_cancel(
     /* Check if op_id is in unexpected op queue */
     if ((cb_type == NA_CB_RECV_UNEXPECTED) &&
         (hg_atomic_get32(&na_ucx_op_id->status) & NA_UCX_OP_QUEUED)) {
-        struct na_ucx_op_queue *op_queue =
-            &NA_UCX_CLASS(na_class)->unexpected_op_queue;
+        struct na_ucx_op_queue *op_queue = &na_ucx_worker->unexpected_op_queue;
         bool canceled = false;
 
         /* If dequeued by process_retries() in the meantime, we'll just let it
@@ -4341,11 +5517,42 @@ na_ucx_cancel(
 
         if (canceled)
             na_ucx_complete(na_ucx_op_id, NA_CANCELED);
+    } else if (cb_type == NA_CB_MULTI_RECV_UNEXPECTED) {
+        struct na_ucx_op_queue *op_queue = &na_ucx_worker->multi_op_queue;
+        struct na_cb_completion_data *completion_data = NULL;
+
+        hg_thread_spin_lock(&op_queue->lock);
+        if (hg_atomic_get32(&na_ucx_op_id->status) & NA_UCX_OP_QUEUED) {
+            completion_data =
+                na_ucx_completion_multi_push(&na_ucx_op_id->completion_multi);
+            if (completion_data != NULL) {
+                TAILQ_REMOVE(&op_queue->queue, na_ucx_op_id, entry);
+                hg_atomic_and32(&na_ucx_op_id->status, ~NA_UCX_OP_QUEUED);
+                hg_atomic_or32(&na_ucx_op_id->status, NA_UCX_OP_CANCELED);
+                hg_atomic_decr32(&na_ucx_worker->multi_op_count);
+            }
+        }
+        hg_thread_spin_unlock(&op_queue->lock);
+
+        if (completion_data != NULL) {
+            *completion_data = na_ucx_op_id->completion_data;
+            na_ucx_complete_multi(
+                na_ucx_op_id, completion_data, true, NA_CANCELED);
+        } else
+            hg_atomic_and32(&na_ucx_op_id->status, ~NA_UCX_OP_CANCELING);
+    } else if ((cb_type == NA_CB_PUT || cb_type == NA_CB_GET) &&
+               na_ucx_op_id->info.rma.sub_ops) {
+        /* Sub-operation requests are owned by UCP and cannot be canceled
+         * individually, let them complete */
+        hg_atomic_and32(&na_ucx_op_id->status, ~NA_UCX_OP_CANCELING);
     } else {
+        /* Requests posted on an EP belong to the worker of that EP */
+        if (cb_type != NA_CB_RECV_EXPECTED && na_ucx_op_id->addr != NULL)
+            na_ucx_worker = na_ucx_op_id->addr->na_ucx_worker;
+
         /* Do best effort to cancel the operation */
         hg_atomic_or32(&na_ucx_op_id->status, NA_UCX_OP_CANCELED);
-        ucp_request_cancel(
-            NA_UCX_CLASS(na_class)->ucp_worker, (void *) na_ucx_op_id);
+        ucp_request_cancel(na_ucx_worker->ucp_worker, (void *) na_ucx_op_id);
     }
 
     return NA_SUCCESS;
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022-2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_CRC32C_H
+#define MERCURY_CRC32C_H
+
+#include "mercury_util_config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/* Initial CRC32C value */
+#define HG_CRC32C_INIT (0)
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Update a CRC32C (Castagnoli) checksum with len bytes of buf. Hardware
+ * instructions (SSE4.2 or ARMv8 CRC) are used when the CPU supports them,
+ * this is detected once at load time unless the HG_CRC32C_NO_ACCEL
+ * environment variable is set. Calls can be chained by passing the value
+ * returned by a previous call, starting from HG_CRC32C_INIT.
+ *
+ * \param crc [IN]              current checksum value
+ * \param buf [IN]              pointer to data
+ * \param len [IN]              data size
+ *
+ * \return updated checksum value
+ */
+HG_UTIL_PUBLIC uint32_t
+hg_crc32c(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * Copy len bytes from src to dst and update a CRC32C checksum with the copied
+ * data in the same pass. Buffers must not overlap.
+ *
+ * \param crc [IN]              current checksum value
+ * \param dst [OUT]             pointer to destination
+ * \param src [IN]              pointer to source
+ * \param len [IN]              data size
+ *
+ * \return updated checksum value
+ */
+HG_UTIL_PUBLIC uint32_t
+hg_crc32c_copy(uint32_t crc, void *dst, const void *src, size_t len);
+
+/**
+ * Combine two CRC32C checksums, crc1 being the checksum of a first block of
+ * data and crc2 the checksum of the len2 bytes that follow it. This allows
+ * blocks to be checksummed independently (e.g., as they complete) and merged
+ * in order afterwards.
+ *
+ * \param crc1 [IN]             checksum of first block
+ * \param crc2 [IN]             checksum of second block
+ * \param len2 [IN]             size of second block
+ *
+ * \return checksum of both blocks
+ */
+HG_UTIL_PUBLIC uint32_t
+hg_crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2);
+
+/**
+ * Check whether hg_crc32c() uses hardware instructions.
+ *
+ * \return true if accelerated, false otherwise
+ */
+HG_UTIL_PUBLIC bool
+hg_crc32c_is_accelerated(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_CRC32C_H */
@@ -24,6 +24,33 @@
 #endif
 #include <stdlib.h>
 
+/****************/
+/* Local Macros */
+/****************/
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+#    ifndef MAP_HUGE_SHIFT
+#        define MAP_HUGE_SHIFT 26
+#    endif
+#    ifndef MAP_HUGE_2MB
+#        define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#    endif
+#    ifndef MAP_HUGE_1GB
+#        define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#    endif
+#endif
+
+/* Huge pages are not used by hg_mem_reg_alloc() */
+#define HG_MEM_REG_NO_HUGE (-1)
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Get page size and mmap() flags used for registered memory */
+static long
+hg_mem_get_reg_config(int *mmap_flags_p);
+
 /*---------------------------------------------------------------------------*/
 long
 hg_mem_get_page_size(void)
@@ -159,6 +186,162 @@ hg_mem_aligned_free(void *mem_ptr)
 #endif
 }
 
+/*---------------------------------------------------------------------------*/
+static long
+hg_mem_get_reg_config(int *mmap_flags_p)
+{
+    static hg_atomic_int64_t atomic_page_size = HG_ATOMIC_VAR_INIT(0);
+    static hg_atomic_int32_t atomic_mmap_flags =
+        HG_ATOMIC_VAR_INIT(HG_MEM_REG_NO_HUGE);
+    long page_size = (long) hg_atomic_get64(&atomic_page_size);
+    int mmap_flags = HG_MEM_REG_NO_HUGE;
+#if !defined(_WIN32) && !defined(__APPLE__)
+    const char *env;
+#endif
+
+    if (page_size != 0) {
+        *mmap_flags_p = (int) hg_atomic_get32(&atomic_mmap_flags);
+        return page_size;
+    }
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+    env = getenv("HG_MEM_HUGEPAGES");
+    if (env != NULL && *env != '\0' && strcmp(env, "0") != 0) {
+        if (strcmp(env, "thp") == 0) {
+            page_size = hg_mem_get_hugepage_size();
+            mmap_flags = 0;
+        } else if (strcmp(env, "1G") == 0 || strcmp(env, "1GB") == 0) {
+            page_size = 1L << 30;
+            mmap_flags = MAP_HUGETLB | MAP_HUGE_1GB;
+        } else if (strcmp(env, "2M") == 0 || strcmp(env, "2MB") == 0) {
+            page_size = 1L << 21;
+            mmap_flags = MAP_HUGETLB | MAP_HUGE_2MB;
+        } else {
+            page_size = hg_mem_get_hugepage_size();
+            mmap_flags = MAP_HUGETLB;
+        }
+        if (page_size <= 0) {
+            HG_UTIL_LOG_WARNING("Could not get huge page size, huge pages "
+                                "will not be used");
+            mmap_flags = HG_MEM_REG_NO_HUGE;
+        }
+    }
+#endif
+    if (mmap_flags == HG_MEM_REG_NO_HUGE)
+        page_size = hg_mem_get_page_size();
+
+    hg_atomic_set32(&atomic_mmap_flags, mmap_flags);
+    hg_atomic_set64(&atomic_page_size, page_size);
+    *mmap_flags_p = mmap_flags;
+
+    return page_size;
+}
+
+/*---------------------------------------------------------------------------*/
+long
+hg_mem_get_reg_page_size(void)
+{
+    int mmap_flags;
+
+    return hg_mem_get_reg_config(&mmap_flags);
+}
+
+/*---------------------------------------------------------------------------*/
+void *
+hg_mem_reg_alloc(size_t alignment, size_t size)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+    return hg_mem_aligned_alloc(alignment, size);
+#else
+    int mmap_flags;
+    size_t page_size = (size_t) hg_mem_get_reg_config(&mmap_flags);
+    size_t alloc_size, map_size, head, tail;
+    char *map_ptr = MAP_FAILED, *mem_ptr;
+
+    if (mmap_flags == HG_MEM_REG_NO_HUGE || size < page_size)
+        return hg_mem_aligned_alloc(alignment, size);
+
+    /* Map enough to be able to trim the mapping to the requested alignment */
+    alloc_size = (size + page_size - 1) & ~(page_size - 1);
+    if (alignment < page_size)
+        alignment = page_size;
+
+    if (mmap_flags != 0) {
+        /* Over-map address space only and map exactly alloc_size bytes of
+         * huge pages at the aligned address, so that no more huge pages than
+         * needed are reserved when the alignment exceeds the huge page size */
+        map_size = alloc_size + alignment - (size_t) hg_mem_get_page_size();
+        map_ptr = mmap(NULL, map_size, PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        HG_UTIL_CHECK_ERROR_NORET(map_ptr == MAP_FAILED, error,
+            "mmap() failed (%s)", strerror(errno));
+        mem_ptr = (char *) (((uintptr_t) map_ptr + alignment - 1) &
+                            ~((uintptr_t) alignment - 1));
+        if (mmap(mem_ptr, alloc_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | mmap_flags, -1,
+                0) == MAP_FAILED) {
+            HG_UTIL_LOG_WARNING("mmap() of %zu bytes using huge pages failed "
+                                "(%s), using transparent huge pages",
+                alloc_size, strerror(errno));
+            (void) munmap(map_ptr, map_size);
+            map_ptr = MAP_FAILED;
+        }
+    }
+    if (map_ptr == MAP_FAILED) {
+        map_size = alloc_size + alignment - (size_t) hg_mem_get_page_size();
+        map_ptr = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        HG_UTIL_CHECK_ERROR_NORET(map_ptr == MAP_FAILED, error,
+            "mmap() failed (%s)", strerror(errno));
+    }
+
+    /* Trim mapping */
+    mem_ptr = (char *) (((uintptr_t) map_ptr + alignment - 1) &
+                        ~((uintptr_t) alignment - 1));
+    head = (size_t) (mem_ptr - map_ptr);
+    tail = map_size - head - alloc_size;
+    if (head > 0)
+        (void) munmap(map_ptr, head);
+    if (tail > 0)
+        (void) munmap(mem_ptr + alloc_size, tail);
+
+    /* Ask for transparent huge pages, no-op on explicit huge pages */
+    if (madvise(mem_ptr, alloc_size, MADV_HUGEPAGE) != 0)
+        HG_UTIL_LOG_DEBUG("madvise() failed (%s)", strerror(errno));
+
+    return mem_ptr;
+
+error:
+    return NULL;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_mem_reg_free(void *mem_ptr, size_t size)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+    (void) size;
+    hg_mem_aligned_free(mem_ptr);
+#else
+    int mmap_flags;
+    size_t page_size = (size_t) hg_mem_get_reg_config(&mmap_flags);
+    int rc;
+
+    if (mmap_flags == HG_MEM_REG_NO_HUGE || size < page_size) {
+        hg_mem_aligned_free(mem_ptr);
+        return;
+    }
+
+    rc = munmap(mem_ptr, (size + page_size - 1) & ~(page_size - 1));
+    HG_UTIL_CHECK_ERROR_NORET(
+        rc != 0, done, "munmap() failed (%s)", strerror(errno));
+
+done:
+    return;
+#endif
+}
+
 /*---------------------------------------------------------------------------*/
 void *
 hg_mem_header_alloc(size_t header_size, size_t alignment, size_t size)
@@ -86,6 +86,42 @@ hg_mem_huge_alloc(size_t size);
 HG_UTIL_PUBLIC int
 hg_mem_huge_free(void *mem_ptr, size_t size);
 
+/**
+ * Get the page size used by hg_mem_reg_alloc() for large allocations. This is
+ * the huge page size selected through the HG_MEM_HUGEPAGES environment
+ * variable, or the system page size if huge pages were not enabled.
+ *
+ * \return page size on success or 0 on failure
+ */
+HG_UTIL_PUBLIC long
+hg_mem_get_reg_page_size(void);
+
+/**
+ * Allocate size bytes of memory that is meant to be registered with a network
+ * interface, the memory address will be a multiple of alignment, which must
+ * be a power of two. When HG_MEM_HUGEPAGES is set to "2M", "1G" or any other
+ * non-zero value (system default huge page size), allocations of at least one
+ * huge page are backed by explicit huge pages, or by transparent huge pages if
+ * none are available; "thp" only uses transparent huge pages. Other
+ * allocations are equivalent to hg_mem_aligned_alloc().
+ *
+ * \param alignment [IN]        alignment size
+ * \param size [IN]             total requested size
+ *
+ * \return a pointer to the allocated memory, or NULL in case of failure
+ */
+HG_UTIL_PUBLIC void *
+hg_mem_reg_alloc(size_t alignment, size_t size);
+
+/**
+ * Free memory allocated from hg_mem_reg_alloc().
+ *
+ * \param mem_ptr [IN]          pointer to allocated memory
+ * \param size [IN]             requested size
+ */
+HG_UTIL_PUBLIC void
+hg_mem_reg_free(void *mem_ptr, size_t size);
+
 /**
  * Allocate a buffer with a `size`-bytes, `alignment`-aligned payload
  * preceded by a `header_size` header, padding the allocation with up
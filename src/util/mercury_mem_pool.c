@@ -7,8 +7,10 @@
 
 #include "mercury_mem_pool.h"
 
+#include "mercury_atomic_queue.h"
 #include "mercury_mem.h"
 #include "mercury_queue.h"
+#include "mercury_thread.h"
 #include "mercury_thread_condition.h"
 #include "mercury_thread_mutex.h"
 #include "mercury_thread_spin.h"
@@ -21,56 +23,62 @@
 /* Local Macros */
 /****************/
 
-/**
- * container_of - cast a member of a structure done to the containing structure
- * \ptr:        the pointer to the member.
- * \type:       the type of the container struct this is embedded in.
- * \member:     the name of the member within the struct.
- *
- */
-#if !defined(container_of)
-#    define container_of(ptr, type, member)                                    \
-        ((type *) ((char *) ptr - offsetof(type, member)))
-#endif
+/* Number of chunks that can be cached per thread (must be even) */
+#define HG_MEM_POOL_CACHE_SIZE (32)
+
+/* Number of chunks moved at once between a thread cache and the blocks */
+#define HG_MEM_POOL_CACHE_BATCH (HG_MEM_POOL_CACHE_SIZE / 2)
+
+/* Get block that a chunk belongs to (blocks are aligned to block_align) */
+#define HG_MEM_POOL_BLOCK(pool, ptr)                                           \
+    ((struct hg_mem_pool_block *) ((uintptr_t) (ptr) &                         \
+                                   ~((uintptr_t) (pool)->block_align - 1)))
 
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
 
 /**
- * Memory chunk (points to actual data).
+ * Memory block. Each block has a fixed chunk size, the underlying memory
+ * buffer is registered. Free chunks are kept in a lock-free queue so that
+ * they can be returned without locking.
  */
-struct hg_mem_pool_chunk {
-    STAILQ_ENTRY(hg_mem_pool_chunk) entry; /* Entry in chunk_list */
-    char *chunk;                           /* Must be last        */
+struct hg_mem_pool_block {
+    STAILQ_ENTRY(hg_mem_pool_block) entry; /* Entry in block list  */
+    struct hg_atomic_queue *chunks;        /* Free chunks          */
+    void *mr_handle;                       /* Pointer to MR handle */
+    size_t size;                           /* Block size           */
 };
 
 /**
- * Memory block. Each block has a fixed chunk size, the underlying memory
- * buffer is registered.
+ * Per-thread chunk cache. Only accessed by the thread that owns it.
  */
-struct hg_mem_pool_block {
-    STAILQ_HEAD(, hg_mem_pool_chunk) chunks; /* Chunk list           */
-    STAILQ_ENTRY(hg_mem_pool_block) entry;   /* Entry in block list  */
-    void *mr_handle;                         /* Pointer to MR handle */
-    hg_thread_spin_t chunk_lock;             /* Chunk list lock      */
+struct hg_mem_pool_cache {
+    LIST_ENTRY(hg_mem_pool_cache) entry;  /* Entry in cache list */
+    unsigned int count;                   /* Number of chunks    */
+    void *chunks[HG_MEM_POOL_CACHE_SIZE]; /* Cached chunks       */
 };
 
 /**
  * Memory pool. A pool is composed of multiple blocks.
  */
 struct hg_mem_pool {
-    hg_thread_mutex_t extend_mutex;                /* Extend mutex    */
-    hg_thread_cond_t extend_cond;                  /* Extend cond     */
-    STAILQ_HEAD(, hg_mem_pool_block) blocks;       /* Block list      */
-    hg_mem_pool_register_func_t register_func;     /* Register func   */
-    hg_mem_pool_deregister_func_t deregister_func; /* Deregister func */
-    unsigned long flags;                           /* Optional flags */
-    void *arg;                                     /* Func args       */
-    size_t chunk_size;                             /* Chunk size      */
-    size_t chunk_count;                            /* Chunk count     */
-    int extending;                                 /* Extending pool  */
-    hg_thread_spin_t block_lock;                   /* Block list lock */
+    LIST_ENTRY(hg_mem_pool) entry;                 /* Entry in pools   */
+    hg_thread_mutex_t extend_mutex;                /* Extend mutex     */
+    hg_thread_cond_t extend_cond;                  /* Extend cond      */
+    STAILQ_HEAD(, hg_mem_pool_block) blocks;       /* Block list       */
+    LIST_HEAD(, hg_mem_pool_cache) caches;         /* Thread caches    */
+    hg_mem_pool_register_func_t register_func;     /* Register func    */
+    hg_mem_pool_deregister_func_t deregister_func; /* Deregister func  */
+    unsigned long flags;                           /* Optional flags   */
+    void *arg;                                     /* Func args        */
+    size_t chunk_size;                             /* Chunk size       */
+    size_t chunk_count;                            /* Chunk count      */
+    size_t block_size;                             /* Block size       */
+    size_t block_align;                            /* Block alignment  */
+    hg_thread_key_t cache_key;                     /* Thread cache key */
+    int extending;                                 /* Extending pool   */
+    hg_thread_spin_t block_lock;                   /* Block list lock  */
 };
 
 /********************/
@@ -80,6 +88,7 @@ struct hg_mem_pool {
 /* Allocate new pool block */
 static struct hg_mem_pool_block *
 hg_mem_pool_block_alloc(size_t chunk_size, size_t chunk_count,
+    size_t block_size, size_t block_align,
     hg_mem_pool_register_func_t register_func, unsigned long flags, void *arg);
 
 /* Free pool block */
@@ -87,10 +96,43 @@ static void
 hg_mem_pool_block_free(struct hg_mem_pool_block *hg_mem_pool_block,
     hg_mem_pool_deregister_func_t deregister_func, void *arg);
 
+/* Get chunks from pool blocks, extend pool if needed */
+static unsigned int
+hg_mem_pool_blocks_get(
+    struct hg_mem_pool *hg_mem_pool, void **chunks, unsigned int max);
+
+/* Return chunks to the blocks they belong to */
+static void
+hg_mem_pool_blocks_put(
+    struct hg_mem_pool *hg_mem_pool, void **chunks, unsigned int count);
+
+/* Get calling thread's cache */
+static HG_UTIL_INLINE struct hg_mem_pool_cache *
+hg_mem_pool_cache_get(struct hg_mem_pool *hg_mem_pool);
+
+/* Create cache for calling thread */
+static struct hg_mem_pool_cache *
+hg_mem_pool_cache_create(struct hg_mem_pool *hg_mem_pool);
+
+#ifndef _WIN32
+/* Release thread cache on thread exit if its pool was not destroyed */
+static void
+hg_mem_pool_cache_release(void *arg);
+#endif
+
 /*******************/
 /* Local Variables */
 /*******************/
 
+/* Pools that are alive (exiting threads may run their cache destructor after
+ * the pool of that cache was destroyed) */
+static LIST_HEAD(, hg_mem_pool) hg_mem_pool_list_g =
+    LIST_HEAD_INITIALIZER(hg_mem_pool_list_g);
+
+/* Lock of pool list and of the cache list of each pool */
+static hg_thread_mutex_t hg_mem_pool_cache_mutex_g =
+    HG_THREAD_MUTEX_INITIALIZER;
+
 /*---------------------------------------------------------------------------*/
 
 struct hg_mem_pool *
@@ -99,12 +141,14 @@ hg_mem_pool_create(size_t chunk_size, size_t chunk_count, size_t block_count,
     hg_mem_pool_deregister_func_t deregister_func, void *arg)
 {
     struct hg_mem_pool *hg_mem_pool = NULL;
-    size_t i;
+    size_t block_size, reg_page_size, i;
+    int rc;
 
     hg_mem_pool = (struct hg_mem_pool *) malloc(sizeof(struct hg_mem_pool));
     HG_UTIL_CHECK_ERROR_NORET(
         hg_mem_pool == NULL, done, "Could not allocate memory pool");
     STAILQ_INIT(&hg_mem_pool->blocks);
+    LIST_INIT(&hg_mem_pool->caches);
     hg_mem_pool->register_func = register_func;
     hg_mem_pool->deregister_func = deregister_func;
     hg_mem_pool->flags = flags;
@@ -116,10 +160,50 @@ hg_mem_pool_create(size_t chunk_size, size_t chunk_count, size_t block_count,
     hg_thread_spin_init(&hg_mem_pool->block_lock);
     hg_mem_pool->extending = 0;
 
+    /* Size of block struct + number of chunks x chunk_size. When huge pages
+     * are used for registered memory, round blocks that are at least half a
+     * huge page up to whole huge pages and fill them with chunks */
+    block_size = sizeof(struct hg_mem_pool_block) + chunk_count * chunk_size;
+    reg_page_size = (size_t) hg_mem_get_reg_page_size();
+    if (reg_page_size > (size_t) hg_mem_get_page_size() &&
+        block_size >= reg_page_size / 2 && chunk_size > 0) {
+        block_size = (block_size + reg_page_size - 1) & ~(reg_page_size - 1);
+        chunk_count =
+            (block_size - sizeof(struct hg_mem_pool_block)) / chunk_size;
+        hg_mem_pool->chunk_count = chunk_count;
+    }
+    hg_mem_pool->block_size = block_size;
+
+    /* Align blocks on a power of 2 at least as large as the block so that
+     * the block of a chunk can be retrieved from its address */
+    hg_mem_pool->block_align = (size_t) hg_mem_get_page_size();
+    while (hg_mem_pool->block_align < block_size)
+        hg_mem_pool->block_align <<= 1;
+
+    /* Thread caches are flushed on thread exit when supported */
+#ifdef _WIN32
+    rc = hg_thread_key_create(&hg_mem_pool->cache_key);
+#else
+    rc = pthread_key_create(&hg_mem_pool->cache_key, hg_mem_pool_cache_release);
+#endif
+    if (rc != 0) {
+        hg_thread_mutex_destroy(&hg_mem_pool->extend_mutex);
+        hg_thread_cond_destroy(&hg_mem_pool->extend_cond);
+        hg_thread_spin_destroy(&hg_mem_pool->block_lock);
+        free(hg_mem_pool);
+        HG_UTIL_GOTO_ERROR(
+            done, hg_mem_pool, NULL, "Could not create thread cache key");
+    }
+
+    hg_thread_mutex_lock(&hg_mem_pool_cache_mutex_g);
+    LIST_INSERT_HEAD(&hg_mem_pool_list_g, hg_mem_pool, entry);
+    hg_thread_mutex_unlock(&hg_mem_pool_cache_mutex_g);
+
     /* Allocate single block */
     for (i = 0; i < block_count; i++) {
-        struct hg_mem_pool_block *hg_mem_pool_block = hg_mem_pool_block_alloc(
-            chunk_size, chunk_count, register_func, flags, arg);
+        struct hg_mem_pool_block *hg_mem_pool_block =
+            hg_mem_pool_block_alloc(chunk_size, chunk_count, block_size,
+                hg_mem_pool->block_align, register_func, flags, arg);
         HG_UTIL_CHECK_ERROR_NORET(hg_mem_pool_block == NULL, error,
             "Could not allocate block of %zu bytes", chunk_size * chunk_count);
         STAILQ_INSERT_TAIL(&hg_mem_pool->blocks, hg_mem_pool_block, entry);
@@ -140,6 +224,20 @@ hg_mem_pool_destroy(struct hg_mem_pool *hg_mem_pool)
     if (!hg_mem_pool)
         return;
 
+    /* Caches of threads that are still alive are released here, chunks that
+     * they hold are freed along with their blocks. Once the pool is no longer
+     * listed, destructors of exiting threads leave their cache alone */
+    hg_thread_mutex_lock(&hg_mem_pool_cache_mutex_g);
+    LIST_REMOVE(hg_mem_pool, entry);
+    while (!LIST_EMPTY(&hg_mem_pool->caches)) {
+        struct hg_mem_pool_cache *hg_mem_pool_cache =
+            LIST_FIRST(&hg_mem_pool->caches);
+        LIST_REMOVE(hg_mem_pool_cache, entry);
+        free(hg_mem_pool_cache);
+    }
+    hg_thread_mutex_unlock(&hg_mem_pool_cache_mutex_g);
+    (void) hg_thread_key_delete(hg_mem_pool->cache_key);
+
     while (!STAILQ_EMPTY(&hg_mem_pool->blocks)) {
         struct hg_mem_pool_block *hg_mem_pool_block =
             STAILQ_FIRST(&hg_mem_pool->blocks);
@@ -156,49 +254,60 @@ hg_mem_pool_destroy(struct hg_mem_pool *hg_mem_pool)
 /*---------------------------------------------------------------------------*/
 static struct hg_mem_pool_block *
 hg_mem_pool_block_alloc(size_t chunk_size, size_t chunk_count,
+    size_t block_size, size_t block_align,
     hg_mem_pool_register_func_t register_func, unsigned long flags, void *arg)
 {
     struct hg_mem_pool_block *hg_mem_pool_block = NULL;
-    size_t page_size = (size_t) hg_mem_get_page_size();
+    struct hg_atomic_queue *chunks = NULL;
     void *mem_ptr = NULL, *mr_handle = NULL;
-    size_t block_size, i;
     size_t block_header = sizeof(struct hg_mem_pool_block);
-    size_t chunk_header = offsetof(struct hg_mem_pool_chunk, chunk);
+    unsigned int queue_size = 1;
+    size_t i;
 
-    /* Size of block struct + number of chunks x (chunk_size + size of entry) */
-    block_size = block_header + chunk_count * (chunk_header + chunk_size);
+    /* Free chunk queue must be able to hold all the chunks (an atomic queue of
+     * size n holds at most n - 1 entries) */
+    while (queue_size < chunk_count + 1)
+        queue_size <<= 1;
+    chunks = hg_atomic_queue_alloc(queue_size);
+    HG_UTIL_CHECK_ERROR_NORET(
+        chunks == NULL, done, "Could not allocate chunk queue");
 
     /* Allocate backend buffer */
-    mem_ptr = hg_mem_aligned_alloc(page_size, block_size);
-    HG_UTIL_CHECK_ERROR_NORET(
-        mem_ptr == NULL, done, "Could not allocate %zu bytes", block_size);
+    mem_ptr = hg_mem_reg_alloc(block_align, block_size);
+    if (unlikely(mem_ptr == NULL)) {
+        hg_atomic_queue_free(chunks);
+        HG_UTIL_GOTO_ERROR(
+            done, mem_ptr, NULL, "Could not allocate %zu bytes", block_size);
+    }
     memset(mem_ptr, 0, block_size);
 
+    /* Assign chunks and insert them to free queue */
+    for (i = 0; i < chunk_count; i++) {
+        int rc = hg_atomic_queue_push(
+            chunks, (char *) mem_ptr + block_header + i * chunk_size);
+        if (unlikely(rc != HG_UTIL_SUCCESS)) {
+            hg_mem_reg_free(mem_ptr, block_size);
+            hg_atomic_queue_free(chunks);
+            HG_UTIL_GOTO_ERROR(done, mem_ptr, NULL,
+                "Could not push chunk %zu to free queue", i);
+        }
+    }
+
     /* Register memory if registration function is provided */
     if (register_func) {
         int rc = register_func(mem_ptr, block_size, flags, &mr_handle, arg);
         if (unlikely(rc != HG_UTIL_SUCCESS)) {
-            hg_mem_aligned_free(mem_ptr);
+            hg_mem_reg_free(mem_ptr, block_size);
+            hg_atomic_queue_free(chunks);
             HG_UTIL_GOTO_ERROR(done, mem_ptr, NULL, "register_func() failed");
         }
     }
 
     /* Map allocated memory to block */
     hg_mem_pool_block = (struct hg_mem_pool_block *) mem_ptr;
-
-    STAILQ_INIT(&hg_mem_pool_block->chunks);
-    hg_thread_spin_init(&hg_mem_pool_block->chunk_lock);
+    hg_mem_pool_block->chunks = chunks;
     hg_mem_pool_block->mr_handle = mr_handle;
-
-    /* Assign chunks and insert them to free list */
-    for (i = 0; i < chunk_count; i++) {
-        struct hg_mem_pool_chunk *hg_mem_pool_chunk =
-            (struct hg_mem_pool_chunk *) ((char *) hg_mem_pool_block +
-                                          block_header +
-                                          i * (chunk_header + chunk_size));
-        STAILQ_INSERT_TAIL(
-            &hg_mem_pool_block->chunks, hg_mem_pool_chunk, entry);
-    }
+    hg_mem_pool_block->size = block_size;
 
 done:
     return hg_mem_pool_block;
@@ -220,41 +329,36 @@ hg_mem_pool_block_free(struct hg_mem_pool_block *hg_mem_pool_block,
     }
 
 done:
-    hg_thread_spin_destroy(&hg_mem_pool_block->chunk_lock);
-    hg_mem_aligned_free((void *) hg_mem_pool_block);
+    hg_atomic_queue_free(hg_mem_pool_block->chunks);
+    hg_mem_reg_free((void *) hg_mem_pool_block, hg_mem_pool_block->size);
     return;
 }
 
 /*---------------------------------------------------------------------------*/
-void *
-hg_mem_pool_alloc(
-    struct hg_mem_pool *hg_mem_pool, size_t size, void **mr_handle)
+static unsigned int
+hg_mem_pool_blocks_get(
+    struct hg_mem_pool *hg_mem_pool, void **chunks, unsigned int max)
 {
     struct hg_mem_pool_block *hg_mem_pool_block;
-    struct hg_mem_pool_chunk *hg_mem_pool_chunk = NULL;
-    void *mem_ptr = NULL;
-
-    HG_UTIL_CHECK_ERROR(size > hg_mem_pool->chunk_size, done, mem_ptr, NULL,
-        "Chunk size is too small for requested size");
-    HG_UTIL_CHECK_ERROR(!mr_handle && hg_mem_pool->register_func, done, mem_ptr,
-        NULL, "MR handle is NULL");
+    unsigned int count = 0;
 
     do {
-        int found = 0;
-
-        /* Check whether we can get a block from one of the pools */
+        /* Check whether we can get chunks from one of the blocks */
         hg_thread_spin_lock(&hg_mem_pool->block_lock);
         STAILQ_FOREACH (hg_mem_pool_block, &hg_mem_pool->blocks, entry) {
-            hg_thread_spin_lock(&hg_mem_pool_block->chunk_lock);
-            found = !STAILQ_EMPTY(&hg_mem_pool_block->chunks);
-            hg_thread_spin_unlock(&hg_mem_pool_block->chunk_lock);
-            if (found)
+            while (count < max) {
+                void *chunk = hg_atomic_queue_pop_mc(hg_mem_pool_block->chunks);
+                if (chunk == NULL)
+                    break;
+                chunks[count++] = chunk;
+            }
+            if (count == max)
                 break;
         }
         hg_thread_spin_unlock(&hg_mem_pool->block_lock);
 
-        /* If not, allocate and register a new pool */
-        if (!found) {
+        /* If not, allocate and register a new block */
+        if (count == 0) {
             /* Let other threads sleep while the pool is being extended */
             hg_thread_mutex_lock(&hg_mem_pool->extend_mutex);
             if (hg_mem_pool->extending) {
@@ -267,34 +371,146 @@ hg_mem_pool_alloc(
             hg_thread_mutex_unlock(&hg_mem_pool->extend_mutex);
 
             hg_mem_pool_block = hg_mem_pool_block_alloc(hg_mem_pool->chunk_size,
-                hg_mem_pool->chunk_count, hg_mem_pool->register_func,
+                hg_mem_pool->chunk_count, hg_mem_pool->block_size,
+                hg_mem_pool->block_align, hg_mem_pool->register_func,
                 hg_mem_pool->flags, hg_mem_pool->arg);
-            HG_UTIL_CHECK_ERROR(hg_mem_pool_block == NULL, done, mem_ptr, NULL,
-                "Could not allocate block of %zu bytes",
-                hg_mem_pool->chunk_size * hg_mem_pool->chunk_count);
-
-            hg_thread_spin_lock(&hg_mem_pool->block_lock);
-            STAILQ_INSERT_TAIL(&hg_mem_pool->blocks, hg_mem_pool_block, entry);
-            hg_thread_spin_unlock(&hg_mem_pool->block_lock);
+            if (hg_mem_pool_block != NULL) {
+                hg_thread_spin_lock(&hg_mem_pool->block_lock);
+                STAILQ_INSERT_TAIL(
+                    &hg_mem_pool->blocks, hg_mem_pool_block, entry);
+                hg_thread_spin_unlock(&hg_mem_pool->block_lock);
+            }
 
             hg_thread_mutex_lock(&hg_mem_pool->extend_mutex);
             hg_mem_pool->extending = 0;
             hg_thread_cond_broadcast(&hg_mem_pool->extend_cond);
             hg_thread_mutex_unlock(&hg_mem_pool->extend_mutex);
-        }
 
-        /* Try to pick a node from one of the available pools */
-        hg_thread_spin_lock(&hg_mem_pool_block->chunk_lock);
-        if (!STAILQ_EMPTY(&hg_mem_pool_block->chunks)) {
-            hg_mem_pool_chunk = STAILQ_FIRST(&hg_mem_pool_block->chunks);
-            STAILQ_REMOVE_HEAD(&hg_mem_pool_block->chunks, entry);
+            HG_UTIL_CHECK_ERROR(hg_mem_pool_block == NULL, done, count, 0,
+                "Could not allocate block of %zu bytes",
+                hg_mem_pool->chunk_size * hg_mem_pool->chunk_count);
         }
-        hg_thread_spin_unlock(&hg_mem_pool_block->chunk_lock);
-    } while (!hg_mem_pool_chunk);
+    } while (count == 0);
+
+done:
+    return count;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_mem_pool_blocks_put(
+    struct hg_mem_pool *hg_mem_pool, void **chunks, unsigned int count)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        struct hg_mem_pool_block *hg_mem_pool_block =
+            HG_MEM_POOL_BLOCK(hg_mem_pool, chunks[i]);
+        int rc = hg_atomic_queue_push(hg_mem_pool_block->chunks, chunks[i]);
+        HG_UTIL_CHECK_ERROR_DONE(rc != HG_UTIL_SUCCESS,
+            "Could not return chunk %p to its block", chunks[i]);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE struct hg_mem_pool_cache *
+hg_mem_pool_cache_get(struct hg_mem_pool *hg_mem_pool)
+{
+    struct hg_mem_pool_cache *hg_mem_pool_cache =
+        (struct hg_mem_pool_cache *) hg_thread_getspecific(
+            hg_mem_pool->cache_key);
+
+    return likely(hg_mem_pool_cache != NULL)
+               ? hg_mem_pool_cache
+               : hg_mem_pool_cache_create(hg_mem_pool);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_mem_pool_cache *
+hg_mem_pool_cache_create(struct hg_mem_pool *hg_mem_pool)
+{
+    struct hg_mem_pool_cache *hg_mem_pool_cache;
+    int rc;
+
+    hg_mem_pool_cache =
+        (struct hg_mem_pool_cache *) malloc(sizeof(struct hg_mem_pool_cache));
+    HG_UTIL_CHECK_ERROR_NORET(
+        hg_mem_pool_cache == NULL, done, "Could not allocate thread cache");
+    hg_mem_pool_cache->count = 0;
+
+    rc = hg_thread_setspecific(hg_mem_pool->cache_key, hg_mem_pool_cache);
+    if (unlikely(rc != HG_UTIL_SUCCESS)) {
+        free(hg_mem_pool_cache);
+        HG_UTIL_GOTO_ERROR(
+            done, hg_mem_pool_cache, NULL, "Could not set thread cache");
+    }
+
+    hg_thread_mutex_lock(&hg_mem_pool_cache_mutex_g);
+    LIST_INSERT_HEAD(&hg_mem_pool->caches, hg_mem_pool_cache, entry);
+    hg_thread_mutex_unlock(&hg_mem_pool_cache_mutex_g);
+
+done:
+    return hg_mem_pool_cache;
+}
+
+/*---------------------------------------------------------------------------*/
+#ifndef _WIN32
+static void
+hg_mem_pool_cache_release(void *arg)
+{
+    struct hg_mem_pool_cache *hg_mem_pool_cache =
+        (struct hg_mem_pool_cache *) arg;
+    struct hg_mem_pool *hg_mem_pool;
+
+    /* Cache was freed if its pool was destroyed while the thread was exiting,
+     * only look at it if a live pool still lists it */
+    hg_thread_mutex_lock(&hg_mem_pool_cache_mutex_g);
+    LIST_FOREACH (hg_mem_pool, &hg_mem_pool_list_g, entry) {
+        struct hg_mem_pool_cache *cache;
+
+        LIST_FOREACH (cache, &hg_mem_pool->caches, entry)
+            if (cache == hg_mem_pool_cache)
+                break;
+        if (cache != NULL)
+            break;
+    }
+    if (hg_mem_pool != NULL) {
+        hg_mem_pool_blocks_put(
+            hg_mem_pool, hg_mem_pool_cache->chunks, hg_mem_pool_cache->count);
+        LIST_REMOVE(hg_mem_pool_cache, entry);
+        free(hg_mem_pool_cache);
+    }
+    hg_thread_mutex_unlock(&hg_mem_pool_cache_mutex_g);
+}
+#endif
 
-    mem_ptr = &hg_mem_pool_chunk->chunk;
-    if (mr_handle && hg_mem_pool_block)
-        *mr_handle = hg_mem_pool_block->mr_handle;
+/*---------------------------------------------------------------------------*/
+void *
+hg_mem_pool_alloc(
+    struct hg_mem_pool *hg_mem_pool, size_t size, void **mr_handle)
+{
+    struct hg_mem_pool_cache *hg_mem_pool_cache;
+    void *mem_ptr = NULL;
+
+    HG_UTIL_CHECK_ERROR(size > hg_mem_pool->chunk_size, done, mem_ptr, NULL,
+        "Chunk size is too small for requested size");
+    HG_UTIL_CHECK_ERROR(!mr_handle && hg_mem_pool->register_func, done, mem_ptr,
+        NULL, "MR handle is NULL");
+
+    hg_mem_pool_cache = hg_mem_pool_cache_get(hg_mem_pool);
+    if (likely(hg_mem_pool_cache != NULL)) {
+        /* Refill thread cache from blocks if empty */
+        if (unlikely(hg_mem_pool_cache->count == 0))
+            hg_mem_pool_cache->count = hg_mem_pool_blocks_get(hg_mem_pool,
+                hg_mem_pool_cache->chunks, HG_MEM_POOL_CACHE_BATCH);
+        if (likely(hg_mem_pool_cache->count > 0))
+            mem_ptr = hg_mem_pool_cache->chunks[--hg_mem_pool_cache->count];
+    } else
+        (void) hg_mem_pool_blocks_get(hg_mem_pool, &mem_ptr, 1);
+    HG_UTIL_CHECK_ERROR_NORET(mem_ptr == NULL, done, "Could not get chunk");
+
+    if (mr_handle)
+        *mr_handle = HG_MEM_POOL_BLOCK(hg_mem_pool, mem_ptr)->mr_handle;
 
 done:
     return mem_ptr;
@@ -305,32 +521,25 @@ void
 hg_mem_pool_free(
     struct hg_mem_pool *hg_mem_pool, void *mem_ptr, void *mr_handle)
 {
-    struct hg_mem_pool_block *hg_mem_pool_block;
-    int found = 0;
+    struct hg_mem_pool_cache *hg_mem_pool_cache;
+
+    (void) mr_handle;
 
     if (!mem_ptr)
         return;
 
-    /* Put the node back to the pool */
-    hg_thread_spin_lock(&hg_mem_pool->block_lock);
-    STAILQ_FOREACH (hg_mem_pool_block, &hg_mem_pool->blocks, entry) {
-        /* If MR handle is NULL, it does not really matter which pool we push
-         * the node back to.
-         */
-        if (hg_mem_pool_block->mr_handle == mr_handle) {
-            struct hg_mem_pool_chunk *hg_mem_pool_chunk =
-                container_of(mem_ptr, struct hg_mem_pool_chunk, chunk);
-            hg_thread_spin_lock(&hg_mem_pool_block->chunk_lock);
-            STAILQ_INSERT_TAIL(
-                &hg_mem_pool_block->chunks, hg_mem_pool_chunk, entry);
-            hg_thread_spin_unlock(&hg_mem_pool_block->chunk_lock);
-            found = 1;
-            break;
+    hg_mem_pool_cache = hg_mem_pool_cache_get(hg_mem_pool);
+    if (likely(hg_mem_pool_cache != NULL)) {
+        /* Return half of the thread cache to the blocks if full */
+        if (unlikely(hg_mem_pool_cache->count == HG_MEM_POOL_CACHE_SIZE)) {
+            hg_mem_pool_cache->count -= HG_MEM_POOL_CACHE_BATCH;
+            hg_mem_pool_blocks_put(hg_mem_pool,
+                &hg_mem_pool_cache->chunks[hg_mem_pool_cache->count],
+                HG_MEM_POOL_CACHE_BATCH);
         }
-    }
-    hg_thread_spin_unlock(&hg_mem_pool->block_lock);
-
-    HG_UTIL_CHECK_WARNING(found != 1, "Memory block was not found");
+        hg_mem_pool_cache->chunks[hg_mem_pool_cache->count++] = mem_ptr;
+    } else
+        hg_mem_pool_blocks_put(hg_mem_pool, &mem_ptr, 1);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -338,13 +547,8 @@ size_t
 hg_mem_pool_chunk_offset(
     struct hg_mem_pool *hg_mem_pool, void *mem_ptr, void *mr_handle)
 {
-    struct hg_mem_pool_block *hg_mem_pool_block;
-
-    hg_thread_spin_lock(&hg_mem_pool->block_lock);
-    STAILQ_FOREACH (hg_mem_pool_block, &hg_mem_pool->blocks, entry)
-        if (hg_mem_pool_block->mr_handle == mr_handle)
-            break;
-    hg_thread_spin_unlock(&hg_mem_pool->block_lock);
+    (void) mr_handle;
 
-    return (size_t) ((char *) mem_ptr - (char *) hg_mem_pool_block);
+    return (size_t) ((char *) mem_ptr -
+                     (char *) HG_MEM_POOL_BLOCK(hg_mem_pool, mem_ptr));
 }
@@ -71,7 +71,10 @@ hg_mem_pool_create(size_t chunk_size, size_t chunk_count, size_t block_count,
     hg_mem_pool_deregister_func_t deregister_func, void *arg);
 
 /**
- * Destroy a memory pool.
+ * Destroy a memory pool. Chunks cached by threads that are still alive are
+ * released. Threads that used the pool must not exit concurrently with this
+ * call, they would otherwise release their cache into a pool being
+ * destroyed.
  *
  * \param hg_mem_pool [IN/OUT]  pointer to memory pool
  *
@@ -94,7 +97,9 @@ hg_mem_pool_alloc(
     struct hg_mem_pool *hg_mem_pool, size_t size, void **mr_handle);
 
 /**
- * Release memory at address \mem_ptr.
+ * Release memory at address \mem_ptr. Memory is first returned to a cache
+ * local to the calling thread and can be released by a different thread
+ * than the one that allocated it.
  *
  * \param hg_mem_pool [IN/OUT]  pointer to memory pool
  * \param mem_ptr [IN]          pointer to memory
@@ -107,7 +112,7 @@ hg_mem_pool_free(
 
 /**
  * Retrieve chunk offset relative to the address used for registering
- * the memory block it belongs to.
+ * the memory block it belongs to. This is a constant-time operation.
  *
  * \param hg_mem_pool [IN/OUT]  pointer to memory pool
  * \param mem_ptr [IN]          pointer to memory
@@ -21,6 +21,12 @@
 #    include <unistd.h>
 #    if defined(HG_UTIL_HAS_SYSEPOLL_H)
 #        include <sys/epoll.h>
+#        if defined(HG_UTIL_HAS_IO_URING)
+#            include <linux/io_uring.h>
+#            include <poll.h>
+#            include <sys/mman.h>
+#            include <sys/syscall.h>
+#        endif
 #    elif defined(HG_UTIL_HAS_SYSEVENT_H)
 #        include <sys/event.h>
 #        include <sys/time.h>
@@ -36,10 +42,67 @@
 #define HG_POLL_INIT_NEVENTS 32
 #define HG_POLL_MAX_EVENTS   4096
 
+#if defined(HG_UTIL_HAS_IO_URING)
+/* Number of SQ entries (CQ has twice as many) */
+#    define HG_POLL_URING_ENTRIES (256)
+
+/* Features required */
+#    define HG_POLL_URING_FEATURES                                             \
+        (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG)
+
+/* User data of poll remove requests (completions are ignored) */
+#    define HG_POLL_URING_REMOVE (UINT64_MAX)
+
+/* User data of poll requests (generation is used to discard completions of
+ * removed fds whose slot has been re-used) */
+#    define HG_POLL_URING_DATA(gen, slot)                                      \
+        (((uint64_t) (gen) << 32) | (uint64_t) (slot))
+#    define HG_POLL_URING_GEN(data)  ((uint32_t) ((data) >> 32))
+#    define HG_POLL_URING_SLOT(data) ((uint32_t) ((data) &0xffffffff))
+
+/* Ring indices are shared with the kernel */
+#    define HG_POLL_URING_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#    define HG_POLL_URING_STORE(ptr, val)                                      \
+        __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#endif
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
 
+#if defined(HG_UTIL_HAS_IO_URING)
+/* Fd registered with io_uring */
+struct hg_poll_uring_fd {
+    hg_poll_data_t data; /* User data */
+    uint32_t mask;       /* Poll mask */
+    uint32_t gen;        /* Generation of slot */
+    int fd;              /* File descriptor (-1 if slot is free) */
+};
+
+/* io_uring instance */
+struct hg_poll_uring {
+    struct hg_poll_uring_fd *fds; /* Registered fds */
+    uint64_t *rearm;              /* Requests to re-arm on next wait */
+    struct io_uring_sqe *sqes;    /* Mapped SQ entries */
+    struct io_uring_cqe *cqes;    /* Mapped CQ entries */
+    void *ring_ptr;               /* Mapped SQ and CQ rings */
+    size_t ring_size;             /* Size of mapped rings */
+    size_t sqes_size;             /* Size of mapped SQ entries */
+    unsigned int *sq_head;        /* SQ head (kernel) */
+    unsigned int *sq_tail;        /* SQ tail */
+    unsigned int *sq_flags;       /* SQ flags (kernel) */
+    unsigned int *sq_array;       /* SQ index array */
+    unsigned int *cq_head;        /* CQ head */
+    unsigned int *cq_tail;        /* CQ tail (kernel) */
+    unsigned int sq_mask;         /* SQ mask */
+    unsigned int cq_mask;         /* CQ mask */
+    unsigned int sq_local_tail;   /* SQ tail not yet made visible */
+    unsigned int sq_pending;      /* Number of SQEs not yet submitted */
+    unsigned int rearm_count;     /* Number of requests to re-arm */
+    unsigned int max_fds;         /* Size of fds and rearm arrays */
+};
+#endif
+
 struct hg_poll_set {
     hg_thread_mutex_t lock;
 #if defined(_WIN32)
@@ -47,6 +110,9 @@ struct hg_poll_set {
     HANDLE *events; /* placeholder */
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H)
     struct epoll_event *events;
+#    if defined(HG_UTIL_HAS_IO_URING)
+    struct hg_poll_uring *uring; /* NULL if epoll is used */
+#    endif
 #elif defined(HG_UTIL_HAS_SYSEVENT_H)
     struct kevent *events;
 #else
@@ -62,6 +128,66 @@ struct hg_poll_set {
 /* Local Prototypes */
 /********************/
 
+#if defined(HG_UTIL_HAS_IO_URING)
+/**
+ * Create io_uring instance if supported by the kernel.
+ */
+static struct hg_poll_uring *
+hg_poll_uring_create(int *fd_p);
+
+/**
+ * Destroy io_uring instance (ring fd is closed separately).
+ */
+static void
+hg_poll_uring_destroy(struct hg_poll_uring *uring);
+
+/**
+ * Get a new SQE, submitting pending ones if the SQ is full.
+ */
+static struct io_uring_sqe *
+hg_poll_uring_get_sqe(int fd, struct hg_poll_uring *uring);
+
+/**
+ * Submit pending SQEs.
+ */
+static int
+hg_poll_uring_submit(int fd, struct hg_poll_uring *uring);
+
+/**
+ * Post single-shot poll request for slot.
+ */
+static int
+hg_poll_uring_arm(int fd, struct hg_poll_uring *uring, uint32_t slot);
+
+/**
+ * Re-arm and submit poll requests that completed during the previous wait.
+ */
+static int
+hg_poll_uring_rearm(int fd, struct hg_poll_uring *uring);
+
+/**
+ * Add fd to io_uring poll set.
+ */
+static int
+hg_poll_uring_add(
+    hg_poll_set_t *poll_set, int fd, const struct hg_poll_event *event);
+
+/**
+ * Remove fd from io_uring poll set.
+ */
+static int
+hg_poll_uring_remove(hg_poll_set_t *poll_set, int fd);
+
+/**
+ * Wait on io_uring poll set, completions are reaped without entering the
+ * kernel if some are already available.
+ */
+static int
+hg_poll_uring_wait(hg_poll_set_t *poll_set, unsigned int timeout,
+    unsigned int max_events, struct hg_poll_event *events,
+    unsigned int *actual_events);
+#endif
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -69,6 +195,13 @@ struct hg_poll_set {
 /*---------------------------------------------------------------------------*/
 hg_poll_set_t *
 hg_poll_create(void)
+{
+    return hg_poll_create_opt(0);
+}
+
+/*---------------------------------------------------------------------------*/
+hg_poll_set_t *
+hg_poll_create_opt(unsigned int flags)
 {
     struct hg_poll_set *hg_poll_set = NULL;
 
@@ -89,7 +222,17 @@ hg_poll_create(void)
 #if defined(_WIN32)
     /* TODO */
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H)
+#    if defined(HG_UTIL_HAS_IO_URING)
+    /* Use io_uring if requested and supported, fall back to epoll */
+    hg_poll_set->uring = (flags & HG_POLL_IO_URING)
+                             ? hg_poll_uring_create(&hg_poll_set->fd)
+                             : NULL;
+    if (hg_poll_set->uring == NULL)
+        hg_poll_set->fd = epoll_create1(0);
+#    else
+    (void) flags;
     hg_poll_set->fd = epoll_create1(0);
+#    endif
     HG_UTIL_CHECK_ERROR_NORET(hg_poll_set->fd == -1, error,
         "epoll_create1() failed (%s)", strerror(errno));
 #elif defined(HG_UTIL_HAS_SYSEVENT_H)
@@ -140,6 +283,10 @@ hg_poll_destroy(hg_poll_set_t *poll_set)
 #if defined(_WIN32)
     /* TODO */
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H) || defined(HG_UTIL_HAS_SYSEVENT_H)
+#    if defined(HG_UTIL_HAS_IO_URING)
+    if (poll_set->uring != NULL)
+        hg_poll_uring_destroy(poll_set->uring);
+#    endif
     /* Close poll descriptor */
     rc = close(poll_set->fd);
     HG_UTIL_CHECK_ERROR(rc == -1, done, ret, HG_UTIL_FAIL,
@@ -174,6 +321,25 @@ hg_poll_get_fd(const hg_poll_set_t *poll_set)
 #endif
 }
 
+/*---------------------------------------------------------------------------*/
+int
+hg_poll_rearm(hg_poll_set_t *poll_set)
+{
+    int ret = HG_UTIL_SUCCESS;
+
+#if defined(HG_UTIL_HAS_IO_URING)
+    if (poll_set->uring != NULL) {
+        hg_thread_mutex_lock(&poll_set->lock);
+        ret = hg_poll_uring_rearm(poll_set->fd, poll_set->uring);
+        hg_thread_mutex_unlock(&poll_set->lock);
+    }
+#else
+    (void) poll_set;
+#endif
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 int
 hg_poll_add(hg_poll_set_t *poll_set, int fd, struct hg_poll_event *event)
@@ -195,6 +361,11 @@ hg_poll_add(hg_poll_set_t *poll_set, int fd, struct hg_poll_event *event)
 #endif
     int ret = HG_UTIL_SUCCESS;
 
+#if defined(HG_UTIL_HAS_IO_URING)
+    if (poll_set->uring != NULL)
+        return hg_poll_uring_add(poll_set, fd, event);
+#endif
+
     HG_UTIL_LOG_DEBUG("Adding fd=%d to poll set (fd=%d)", fd, poll_set->fd);
 
 #if defined(_WIN32)
@@ -292,6 +463,11 @@ hg_poll_remove(hg_poll_set_t *poll_set, int fd)
 #endif
     int ret = HG_UTIL_SUCCESS;
 
+#if defined(HG_UTIL_HAS_IO_URING)
+    if (poll_set->uring != NULL)
+        return hg_poll_uring_remove(poll_set, fd);
+#endif
+
     HG_UTIL_LOG_DEBUG("Removing fd=%d from poll set (fd=%d)", fd, poll_set->fd);
 
 #if defined(_WIN32)
@@ -355,6 +531,12 @@ hg_poll_wait(hg_poll_set_t *poll_set, unsigned int timeout,
     HG_UTIL_GOTO_ERROR(done, ret, HG_UTIL_FAIL, "Not implemented");
     (void) i;
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H)
+#    if defined(HG_UTIL_HAS_IO_URING)
+    if (poll_set->uring != NULL)
+        return hg_poll_uring_wait(
+            poll_set, timeout, max_events, events, actual_events);
+#    endif
+
     nfds = epoll_wait(
         poll_set->fd, poll_set->events, max_poll_events, (int) timeout);
     HG_UTIL_CHECK_ERROR(nfds == -1 && errno != EINTR, done, ret, HG_UTIL_FAIL,
@@ -523,3 +705,435 @@ unlock:
     return ret;
 #endif
 }
+
+#if defined(HG_UTIL_HAS_IO_URING)
+/*---------------------------------------------------------------------------*/
+static struct hg_poll_uring *
+hg_poll_uring_create(int *fd_p)
+{
+    struct io_uring_params params;
+    struct hg_poll_uring *uring = NULL;
+    void *ring_ptr = MAP_FAILED, *sqes = MAP_FAILED;
+    size_t ring_size, sqes_size;
+    int fd = -1;
+
+    memset(&params, 0, sizeof(params));
+    fd = (int) syscall(__NR_io_uring_setup, HG_POLL_URING_ENTRIES, &params);
+    if (fd == -1) {
+        HG_UTIL_LOG_DEBUG(
+            "io_uring_setup() failed (%s), using epoll", strerror(errno));
+        goto error;
+    }
+    if ((params.features & HG_POLL_URING_FEATURES) != HG_POLL_URING_FEATURES) {
+        HG_UTIL_LOG_DEBUG("io_uring features not supported (0x%x), using epoll",
+            params.features);
+        goto error;
+    }
+
+    /* SQ and CQ rings share a single mapping */
+    ring_size = MAX(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+    ring_ptr = mmap(NULL, ring_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    HG_UTIL_CHECK_ERROR_NORET(ring_ptr == MAP_FAILED, error,
+        "mmap() of io_uring rings failed (%s)", strerror(errno));
+
+    sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes = mmap(NULL, sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    HG_UTIL_CHECK_ERROR_NORET(sqes == MAP_FAILED, error,
+        "mmap() of io_uring SQEs failed (%s)", strerror(errno));
+
+    uring = calloc(1, sizeof(*uring));
+    HG_UTIL_CHECK_ERROR_NORET(
+        uring == NULL, error, "calloc() failed (%s)", strerror(errno));
+
+    uring->ring_ptr = ring_ptr;
+    uring->ring_size = ring_size;
+    uring->sqes = (struct io_uring_sqe *) sqes;
+    uring->sqes_size = sqes_size;
+    uring->sq_head = (unsigned int *) ((char *) ring_ptr + params.sq_off.head);
+    uring->sq_tail = (unsigned int *) ((char *) ring_ptr + params.sq_off.tail);
+    uring->sq_flags =
+        (unsigned int *) ((char *) ring_ptr + params.sq_off.flags);
+    uring->sq_array =
+        (unsigned int *) ((char *) ring_ptr + params.sq_off.array);
+    uring->sq_mask =
+        *(unsigned int *) ((char *) ring_ptr + params.sq_off.ring_mask);
+    uring->sq_local_tail = *uring->sq_tail;
+    uring->cq_head = (unsigned int *) ((char *) ring_ptr + params.cq_off.head);
+    uring->cq_tail = (unsigned int *) ((char *) ring_ptr + params.cq_off.tail);
+    uring->cq_mask =
+        *(unsigned int *) ((char *) ring_ptr + params.cq_off.ring_mask);
+    uring->cqes =
+        (struct io_uring_cqe *) ((char *) ring_ptr + params.cq_off.cqes);
+
+    HG_UTIL_LOG_DEBUG("Using io_uring for poll set (fd=%d, %u SQEs, %u CQEs)",
+        fd, params.sq_entries, params.cq_entries);
+
+    *fd_p = fd;
+
+    return uring;
+
+error:
+    if (sqes != MAP_FAILED)
+        (void) munmap(sqes, sqes_size);
+    if (ring_ptr != MAP_FAILED)
+        (void) munmap(ring_ptr, ring_size);
+    if (fd != -1)
+        (void) close(fd);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_poll_uring_destroy(struct hg_poll_uring *uring)
+{
+    (void) munmap(uring->sqes, uring->sqes_size);
+    (void) munmap(uring->ring_ptr, uring->ring_size);
+    free(uring->fds);
+    free(uring->rearm);
+    free(uring);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct io_uring_sqe *
+hg_poll_uring_get_sqe(int fd, struct hg_poll_uring *uring)
+{
+    struct io_uring_sqe *sqe;
+    unsigned int index;
+
+    /* Make room if SQ is full */
+    if (uring->sq_local_tail - HG_POLL_URING_LOAD(uring->sq_head) >
+        uring->sq_mask) {
+        if (hg_poll_uring_submit(fd, uring) != HG_UTIL_SUCCESS ||
+            uring->sq_local_tail - HG_POLL_URING_LOAD(uring->sq_head) >
+                uring->sq_mask)
+            return NULL;
+    }
+
+    index = uring->sq_local_tail & uring->sq_mask;
+    sqe = &uring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    uring->sq_array[index] = index;
+    uring->sq_local_tail++;
+    uring->sq_pending++;
+
+    return sqe;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_submit(int fd, struct hg_poll_uring *uring)
+{
+    int ret = HG_UTIL_SUCCESS;
+    int rc;
+
+    if (uring->sq_pending == 0)
+        return HG_UTIL_SUCCESS;
+
+    HG_POLL_URING_STORE(uring->sq_tail, uring->sq_local_tail);
+
+    do {
+        rc = (int) syscall(
+            __NR_io_uring_enter, fd, uring->sq_pending, 0, 0, NULL, 0);
+    } while (rc == -1 && errno == EINTR);
+    HG_UTIL_CHECK_ERROR(rc == -1, done, ret, HG_UTIL_FAIL,
+        "io_uring_enter() failed (%s)", strerror(errno));
+
+    uring->sq_pending -= (unsigned int) rc;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_arm(int fd, struct hg_poll_uring *uring, uint32_t slot)
+{
+    struct hg_poll_uring_fd *entry = &uring->fds[slot];
+    struct io_uring_sqe *sqe;
+    uint32_t mask = entry->mask;
+    int ret = HG_UTIL_SUCCESS;
+
+    sqe = hg_poll_uring_get_sqe(fd, uring);
+    HG_UTIL_CHECK_ERROR(
+        sqe == NULL, done, ret, HG_UTIL_FAIL, "Could not get io_uring SQE");
+
+#    if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    /* Poll mask is word-reversed on big-endian */
+    mask = (mask << 16) | (mask >> 16);
+#    endif
+
+    /* Multishot requests are edge-triggered, single-shot requests complete
+     * right away if the fd is still ready when re-armed, as with epoll */
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = entry->fd;
+    sqe->poll32_events = mask;
+    sqe->user_data = HG_POLL_URING_DATA(entry->gen, slot);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_rearm(int fd, struct hg_poll_uring *uring)
+{
+    int ret = HG_UTIL_SUCCESS;
+    unsigned int i;
+
+    for (i = 0; i < uring->rearm_count; i++) {
+        uint32_t slot = HG_POLL_URING_SLOT(uring->rearm[i]);
+
+        /* Skip fds removed in the meantime */
+        if (uring->fds[slot].fd == -1 ||
+            uring->fds[slot].gen != HG_POLL_URING_GEN(uring->rearm[i]))
+            continue;
+
+        ret = hg_poll_uring_arm(fd, uring, slot);
+        HG_UTIL_CHECK_ERROR_NORET(
+            ret != HG_UTIL_SUCCESS, done, "Could not re-arm poll request");
+    }
+
+    ret = hg_poll_uring_submit(fd, uring);
+
+done:
+    uring->rearm_count = 0;
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_add(
+    hg_poll_set_t *poll_set, int fd, const struct hg_poll_event *event)
+{
+    struct hg_poll_uring *uring = poll_set->uring;
+    struct hg_poll_uring_fd *entry;
+    uint32_t mask = 0, slot;
+    int ret = HG_UTIL_SUCCESS;
+
+    HG_UTIL_LOG_DEBUG(
+        "Adding fd=%d to io_uring poll set (fd=%d)", fd, poll_set->fd);
+
+    /* Translate flags */
+    if (event->events & HG_POLLIN)
+        mask |= POLLIN;
+    if (event->events & HG_POLLOUT)
+        mask |= POLLOUT;
+
+    hg_thread_mutex_lock(&poll_set->lock);
+
+    /* Look for a free slot, grow array if there is none */
+    for (slot = 0; slot < uring->max_fds; slot++)
+        if (uring->fds[slot].fd == -1)
+            break;
+    if (slot == uring->max_fds) {
+        unsigned int max_fds =
+            (uring->max_fds > 0) ? uring->max_fds * 2 : HG_POLL_INIT_NEVENTS;
+        struct hg_poll_uring_fd *fds;
+        uint64_t *rearm;
+        unsigned int i;
+
+        HG_UTIL_CHECK_ERROR(max_fds > HG_POLL_MAX_EVENTS, unlock, ret,
+            HG_UTIL_FAIL, "reached max number of events for this poll set (%d)",
+            uring->max_fds);
+
+        /* Each fd has at most one request to re-arm */
+        rearm = realloc(uring->rearm, sizeof(*rearm) * max_fds);
+        HG_UTIL_CHECK_ERROR(rearm == NULL, unlock, ret, HG_UTIL_FAIL,
+            "realloc() failed (%s)", strerror(errno));
+        uring->rearm = rearm;
+
+        fds = realloc(uring->fds, sizeof(*fds) * max_fds);
+        HG_UTIL_CHECK_ERROR(fds == NULL, unlock, ret, HG_UTIL_FAIL,
+            "realloc() failed (%s)", strerror(errno));
+
+        for (i = uring->max_fds; i < max_fds; i++) {
+            fds[i].fd = -1;
+            fds[i].gen = 0;
+        }
+        uring->fds = fds;
+        uring->max_fds = max_fds;
+    }
+
+    entry = &uring->fds[slot];
+    entry->fd = fd;
+    entry->mask = mask;
+    entry->data = event->data;
+
+    /* Poll request is re-armed after each completion until fd is removed */
+    ret = hg_poll_uring_arm(poll_set->fd, uring, slot);
+    if (ret == HG_UTIL_SUCCESS)
+        ret = hg_poll_uring_submit(poll_set->fd, uring);
+    if (ret != HG_UTIL_SUCCESS) {
+        entry->fd = -1;
+        entry->gen++;
+        goto unlock;
+    }
+
+    poll_set->nfds++;
+
+unlock:
+    hg_thread_mutex_unlock(&poll_set->lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_remove(hg_poll_set_t *poll_set, int fd)
+{
+    struct hg_poll_uring *uring = poll_set->uring;
+    struct hg_poll_uring_fd *entry;
+    struct io_uring_sqe *sqe;
+    uint32_t slot;
+    int ret = HG_UTIL_SUCCESS;
+
+    HG_UTIL_LOG_DEBUG(
+        "Removing fd=%d from io_uring poll set (fd=%d)", fd, poll_set->fd);
+
+    hg_thread_mutex_lock(&poll_set->lock);
+
+    for (slot = 0; slot < uring->max_fds; slot++)
+        if (uring->fds[slot].fd == fd)
+            break;
+    HG_UTIL_CHECK_ERROR(slot == uring->max_fds, unlock, ret, HG_UTIL_FAIL,
+        "Could not find fd in poll_set");
+    entry = &uring->fds[slot];
+
+    sqe = hg_poll_uring_get_sqe(poll_set->fd, uring);
+    HG_UTIL_CHECK_ERROR(
+        sqe == NULL, unlock, ret, HG_UTIL_FAIL, "Could not get io_uring SQE");
+
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = HG_POLL_URING_DATA(entry->gen, slot);
+    sqe->user_data = HG_POLL_URING_REMOVE;
+
+    /* Completions still in flight for that slot are discarded */
+    entry->fd = -1;
+    entry->gen++;
+    poll_set->nfds--;
+
+    ret = hg_poll_uring_submit(poll_set->fd, uring);
+
+unlock:
+    hg_thread_mutex_unlock(&poll_set->lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_wait(hg_poll_set_t *poll_set, unsigned int timeout,
+    unsigned int max_events, struct hg_poll_event *events,
+    unsigned int *actual_events)
+{
+    struct hg_poll_uring *uring = poll_set->uring;
+    unsigned int head, tail, nevents = 0;
+    int ret = HG_UTIL_SUCCESS;
+    int rc;
+
+    /* Re-arm requests that completed during the previous wait, fds that are
+     * still ready complete again right away, as with epoll */
+    hg_thread_mutex_lock(&poll_set->lock);
+    rc = hg_poll_uring_rearm(poll_set->fd, uring);
+    hg_thread_mutex_unlock(&poll_set->lock);
+    HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, done, ret, HG_UTIL_FAIL,
+        "Could not re-arm poll requests");
+
+    if (HG_POLL_URING_LOAD(uring->cq_tail) == *uring->cq_head &&
+        (timeout != 0 ||
+            (HG_POLL_URING_LOAD(uring->sq_flags) & IORING_SQ_CQ_OVERFLOW))) {
+        struct __kernel_timespec ts = {.tv_sec = (long long) (timeout / 1000),
+            .tv_nsec = (long long) (timeout % 1000) * 1000000LL};
+        struct io_uring_getevents_arg arg = {
+            .sigmask = 0, .sigmask_sz = 0, .pad = 0, .ts = 0};
+
+        /* Negative timeout (as int) blocks indefinitely, as with epoll */
+        if ((int) timeout >= 0)
+            arg.ts = (uint64_t) (uintptr_t) &ts;
+
+        /* Waiting with a zero timeout only flushes overflowed completions */
+        rc = (int) syscall(__NR_io_uring_enter, poll_set->fd, 0,
+            (timeout != 0) ? 1 : 0,
+            IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        HG_UTIL_CHECK_ERROR(rc == -1 && errno != EINTR && errno != ETIME &&
+                                errno != EBUSY,
+            done, ret, HG_UTIL_FAIL, "io_uring_enter() failed (%s)",
+            strerror(errno));
+
+        /* Handle signal interrupts */
+        if (unlikely(rc == -1 && errno == EINTR)) {
+            events[0].events |= HG_POLLINTR;
+            *actual_events = 1;
+
+            /* Reset errno */
+            errno = 0;
+
+            return HG_UTIL_SUCCESS;
+        }
+    }
+
+    hg_thread_mutex_lock(&poll_set->lock);
+
+    head = *uring->cq_head;
+    tail = HG_POLL_URING_LOAD(uring->cq_tail);
+    while (head != tail && nevents < max_events) {
+        const struct io_uring_cqe *cqe = &uring->cqes[head & uring->cq_mask];
+        struct hg_poll_uring_fd *entry;
+        uint32_t slot = HG_POLL_URING_SLOT(cqe->user_data);
+        uint32_t mask;
+
+        head++;
+
+        /* Discard remove requests and completions of removed fds */
+        if (cqe->user_data == HG_POLL_URING_REMOVE || slot >= uring->max_fds)
+            continue;
+        entry = &uring->fds[slot];
+        if (entry->fd == -1 ||
+            entry->gen != HG_POLL_URING_GEN(cqe->user_data))
+            continue;
+
+        events[nevents].events = 0;
+        events[nevents].data = entry->data;
+
+        if (cqe->res < 0) {
+            HG_UTIL_LOG_ERROR("Poll request on fd=%d failed (%s)", entry->fd,
+                strerror(-cqe->res));
+            events[nevents].events |= HG_POLLERR;
+            nevents++;
+            continue;
+        }
+
+        /* Request is single-shot, re-arm it once event has been handled */
+        uring->rearm[uring->rearm_count++] = cqe->user_data;
+
+        mask = (uint32_t) cqe->res;
+        if (mask & POLLIN)
+            events[nevents].events |= HG_POLLIN;
+
+        if (mask & POLLOUT)
+            events[nevents].events |= HG_POLLOUT;
+
+        /* Don't change the if/else order */
+        if (mask & POLLERR)
+            events[nevents].events |= HG_POLLERR;
+        else if (mask & (POLLHUP | EPOLLRDHUP)) /* same value as POLLRDHUP */
+            events[nevents].events |= HG_POLLHUP;
+
+        nevents++;
+    }
+    HG_POLL_URING_STORE(uring->cq_head, head);
+
+    hg_thread_mutex_unlock(&poll_set->lock);
+
+    *actual_events = nevents;
+
+done:
+    return ret;
+}
+#endif
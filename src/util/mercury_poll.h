@@ -41,6 +41,11 @@ struct hg_poll_event {
 #define HG_POLLHUP  (1 << 3) /* Hung up. */
 #define HG_POLLINTR (1 << 4) /* Interrupted. */
 
+/**
+ * Poll set creation flags.
+ */
+#define HG_POLL_IO_URING (1 << 0) /* Use io_uring if supported. */
+
 /*********************/
 /* Public Prototypes */
 /*********************/
@@ -57,6 +62,18 @@ extern "C" {
 HG_UTIL_PUBLIC hg_poll_set_t *
 hg_poll_create(void);
 
+/**
+ * Create a new poll set with creation flags. When HG_POLL_IO_URING is set,
+ * io_uring is used if the library was built with MERCURY_ENABLE_IO_URING and
+ * the kernel supports it, epoll is used otherwise.
+ *
+ * \param flags [IN]            creation flags
+ *
+ * \return Pointer to poll set or NULL in case of failure
+ */
+HG_UTIL_PUBLIC hg_poll_set_t *
+hg_poll_create_opt(unsigned int flags);
+
 /**
  * Destroy a poll set.
  *
@@ -77,6 +94,19 @@ hg_poll_destroy(hg_poll_set_t *poll_set);
 HG_UTIL_PUBLIC int
 hg_poll_get_fd(const hg_poll_set_t *poll_set);
 
+/**
+ * Post poll requests that must be active before blocking on the file
+ * descriptor returned by hg_poll_get_fd(). io_uring poll requests are only
+ * re-armed when the next wait starts, this must be called by callers that
+ * block on that file descriptor instead of calling hg_poll_wait().
+ *
+ * \param poll_set [IN/OUT]     pointer to poll set
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_poll_rearm(hg_poll_set_t *poll_set);
+
 /**
  * Add file descriptor to poll set.
  *
@@ -8,7 +8,10 @@
 #include "mercury_thread.h"
 
 #if !defined(_WIN32) && !defined(__APPLE__)
+#    include <ctype.h>
 #    include <sched.h>
+#    include <stdio.h>
+#    include <stdlib.h>
 #endif
 
 /*---------------------------------------------------------------------------*/
@@ -162,3 +165,73 @@ hg_thread_setaffinity(hg_thread_t thread, const hg_cpu_set_t *cpu_mask)
     return HG_UTIL_SUCCESS;
 #endif
 }
+
+/*---------------------------------------------------------------------------*/
+int
+hg_thread_cpulist_parse(const char *cpulist, hg_cpu_set_t *cpu_mask)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+    (void) cpulist;
+    (void) cpu_mask;
+    return HG_UTIL_FAIL;
+#else
+    const char *p = cpulist;
+    char *end;
+    unsigned long first, last;
+
+    /* cpulist is a comma-separated list of CPUs or ranges, e.g. "0-7,16-23" */
+    CPU_ZERO(cpu_mask);
+    for (;;) {
+        if (!isdigit((unsigned char) *p))
+            return HG_UTIL_FAIL;
+        first = last = strtoul(p, &end, 10);
+        if (*end == '-') {
+            p = end + 1;
+            if (!isdigit((unsigned char) *p))
+                return HG_UTIL_FAIL;
+            last = strtoul(p, &end, 10);
+            if (last < first)
+                return HG_UTIL_FAIL;
+        }
+        for (; first <= last && first < CPU_SETSIZE; first++)
+            CPU_SET((int) first, cpu_mask);
+        p = end;
+        if (*p != ',')
+            break;
+        p++;
+    }
+
+    /* sysfs lists end with a newline */
+    if (*p == '\n')
+        p++;
+
+    return (*p == '\0') ? HG_UTIL_SUCCESS : HG_UTIL_FAIL;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_thread_numa_node_cpus(int numa_node, hg_cpu_set_t *cpu_mask)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+    (void) numa_node;
+    (void) cpu_mask;
+    return HG_UTIL_FAIL;
+#else
+    char path[64], cpulist[4096];
+    FILE *file;
+    int ret = HG_UTIL_FAIL;
+
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+        numa_node);
+    file = fopen(path, "r");
+    if (file == NULL)
+        return HG_UTIL_FAIL;
+
+    if (fgets(cpulist, (int) sizeof(cpulist), file) != NULL)
+        ret = hg_thread_cpulist_parse(cpulist, cpu_mask);
+    fclose(file);
+
+    return ret;
+#endif
+}
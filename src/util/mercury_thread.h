@@ -185,6 +185,30 @@ hg_thread_getaffinity(hg_thread_t thread, hg_cpu_set_t *cpu_mask);
 HG_UTIL_PUBLIC int
 hg_thread_setaffinity(hg_thread_t thread, const hg_cpu_set_t *cpu_mask);
 
+/**
+ * Parse a list of CPUs in the format of Linux cpulist files, i.e., a
+ * comma-separated list of CPUs or ranges of CPUs such as "0-7,16-23", with an
+ * optional trailing newline.
+ *
+ * \param cpulist [IN]          list of CPUs
+ * \param cpu_mask [OUT]        cpu mask
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_thread_cpulist_parse(const char *cpulist, hg_cpu_set_t *cpu_mask);
+
+/**
+ * Get the mask of CPUs that belong to a NUMA node from sysfs.
+ *
+ * \param numa_node [IN]        NUMA node index
+ * \param cpu_mask [OUT]        cpu mask
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_thread_numa_node_cpus(int numa_node, hg_cpu_set_t *cpu_mask);
+
 /*---------------------------------------------------------------------------*/
 static HG_UTIL_INLINE hg_thread_t
 hg_thread_self(void)